@@ -24,8 +24,11 @@ THE SOFTWARE.
 
 #include <map>
 #include <string>
+#include <vector>
 #include <stdio.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
 
 #include <AL/al.h>
 #include <AL/alc.h>
@@ -37,6 +40,7 @@ THE SOFTWARE.
 #endif
 
 #include "SimpleAudioEngine.h"
+#include "SimpleAudioEngineOpenAL.h"
 #include "cocos2d.h"
 USING_NS_CC;
 
@@ -46,13 +50,33 @@ namespace CocosDenshion
 {
 	struct soundData {
 		ALuint buffer;
-		ALuint source;
-		bool   isLooped;
 	};
 
 	typedef map<string, soundData *> EffectsMap;
 	EffectsMap s_effects;
 
+	// A source of the voice pool, shared by all the effects
+	struct effectVoice {
+		ALuint       source;
+		ALuint       buffer;
+		unsigned int handle;	// 0 when the voice is free
+		unsigned int order;		// play order, used to steal the oldest voice
+		int          priority;
+	};
+
+	typedef vector<effectVoice> EffectVoices;
+	static EffectVoices s_voices;
+
+	// the handle of a voice stores its index in the low bits
+	static const unsigned int kVoiceIndexBits  = 8;
+	static const unsigned int kVoiceIndexMask  = (1 << kVoiceIndexBits) - 1;
+	static const unsigned int kMaxVoicesLimit  = kVoiceIndexMask + 1;
+
+	static unsigned int s_maxVoices            = 32;
+	static unsigned int s_playCounter          = 0;
+	static unsigned int s_stolenVoices         = 0;
+	static unsigned int s_droppedVoices        = 0;
+
 	typedef enum {
 		PLAYING,
 		STOPPED,
@@ -65,11 +89,17 @@ namespace CocosDenshion
 	struct backgroundMusicData {
 		ALuint buffer;
 		ALuint source;
+#ifndef DISABLE_VORBIS
+		// OGG files are not decoded up front, only their headers are parsed
+		bool           streamed;
+		OggVorbis_File ogg;
+#endif
 	};
 	typedef map<string, backgroundMusicData *> BackgroundMusicsMap;
 	BackgroundMusicsMap s_backgroundMusics;
 
 	static ALuint s_backgroundSource = AL_NONE;
+	static backgroundMusicData *s_backgroundMusic = NULL;
 
 	static SimpleAudioEngine  *s_engine = 0;
 
@@ -106,21 +136,337 @@ namespace CocosDenshion
 		return err;
 	}
 
+#ifndef DISABLE_VORBIS
+
+	//
+	// OGG background music streaming
+	//
+	// The music is decoded on a thread into a small ring of AL buffers
+	// queued on a single source, so the memory used by a track doesn't
+	// depend on its length.
+	//
+	static const int  kStreamBufferCount   = 4;
+	static const int  kStreamPrimeBuffers  = 2;		// decoded before the music starts
+	static const int  kStreamBufferSize    = 64 * 1024;
+	static const long kStreamPollInterval  = 20;	// milliseconds
+
+	struct musicStream {
+		ALuint          source;
+		ALuint          buffers[kStreamBufferCount];
+		vector<ALuint>  freeBuffers;
+		OggVorbis_File *file;
+		ALenum          format;
+		long            rate;
+		bool            loop;
+		bool            active;
+		bool            endOfFile;
+		bool            quit;
+		pthread_t       thread;
+		pthread_mutex_t mutex;
+		pthread_cond_t  condition;
+		char            pcm[kStreamBufferSize];
+	};
+
+	static musicStream *s_stream = NULL;
+
+	// Decodes the next chunk of the music into a buffer and queues it.
+	static bool queueStreamBuffer(ALuint buffer)
+	{
+		int  size = 0;
+		int  section;
+		bool rewound = false;
+
+		while (size < kStreamBufferSize)
+		{
+			long result = ov_read(s_stream->file, s_stream->pcm + size, kStreamBufferSize - size, 0, 2, 1, &section);
+			if (result > 0)
+			{
+				size += result;
+				rewound = false;
+			}
+			else if (result == 0)
+			{
+				// keep filling the same buffer from the start so the loop has no gap
+				if (s_stream->loop && !rewound && ov_raw_seek(s_stream->file, 0) == 0)
+				{
+					rewound = true;
+					continue;
+				}
+
+				s_stream->endOfFile = true;
+				break;
+			}
+			else if (result != OV_HOLE)
+			{
+				fprintf(stderr, "OGG stream problem (%ld)\n", result);
+				s_stream->endOfFile = true;
+				break;
+			}
+		}
+
+		if (size == 0)
+			return false;
+
+		alBufferData(buffer, s_stream->format, s_stream->pcm, size, s_stream->rate);
+		alSourceQueueBuffers(s_stream->source, 1, &buffer);
+		return checkALError("queueStreamBuffer:alSourceQueueBuffers") == AL_NO_ERROR;
+	}
+
+	static void queueFreeStreamBuffers(int count)
+	{
+		while (count-- > 0 && !s_stream->freeBuffers.empty() && !s_stream->endOfFile)
+		{
+			if (!queueStreamBuffer(s_stream->freeBuffers.back()))
+				break;
+			s_stream->freeBuffers.pop_back();
+		}
+	}
+
+	static void unqueueProcessedStreamBuffers()
+	{
+		ALint processed = 0;
+		alGetSourcei(s_stream->source, AL_BUFFERS_PROCESSED, &processed);
+		while (processed-- > 0)
+		{
+			ALuint buffer;
+			alSourceUnqueueBuffers(s_stream->source, 1, &buffer);
+			s_stream->freeBuffers.push_back(buffer);
+		}
+		checkALError("unqueueProcessedStreamBuffers:alSourceUnqueueBuffers");
+	}
+
+	// Refills the processed buffers, called with the stream mutex locked.
+	static void serviceStream()
+	{
+		unqueueProcessedStreamBuffers();
+		queueFreeStreamBuffers(kStreamBufferCount);
+
+		ALint state;
+		alGetSourcei(s_stream->source, AL_SOURCE_STATE, &state);
+		if (state == AL_STOPPED)
+		{
+			// the source may have stopped after the buffers were unqueued
+			unqueueProcessedStreamBuffers();
+			queueFreeStreamBuffers(kStreamBufferCount);
+
+			ALint queued = 0;
+			alGetSourcei(s_stream->source, AL_BUFFERS_QUEUED, &queued);
+			if (queued > 0)
+			{
+				// the decoder was too slow, resume
+				alSourcePlay(s_stream->source);
+				checkALError("serviceStream:alSourcePlay");
+			}
+			else
+			{
+				// end of the music
+				s_stream->active = false;
+			}
+		}
+	}
+
+	static void* streamThread(void *data)
+	{
+		pthread_mutex_lock(&s_stream->mutex);
+
+		while (!s_stream->quit)
+		{
+			if (s_stream->active)
+			{
+				serviceStream();
+
+				struct timeval now;
+				struct timespec timeout;
+				gettimeofday(&now, NULL);
+				long nsec = now.tv_usec * 1000 + kStreamPollInterval * 1000000;
+				timeout.tv_sec = now.tv_sec + nsec / 1000000000;
+				timeout.tv_nsec = nsec % 1000000000;
+				pthread_cond_timedwait(&s_stream->condition, &s_stream->mutex, &timeout);
+			}
+			else
+			{
+				pthread_cond_wait(&s_stream->condition, &s_stream->mutex);
+			}
+		}
+
+		pthread_mutex_unlock(&s_stream->mutex);
+		return NULL;
+	}
+
+	static bool createStream()
+	{
+		if (s_stream)
+			return true;
+
+		checkALError("createStream:init");
+
+		musicStream *stream = new musicStream();
+		alGenSources(1, &stream->source);
+		if (checkALError("createStream:alGenSources") != AL_NO_ERROR)
+		{
+			delete stream;
+			return false;
+		}
+
+		alGenBuffers(kStreamBufferCount, stream->buffers);
+		if (checkALError("createStream:alGenBuffers") != AL_NO_ERROR)
+		{
+			alDeleteSources(1, &stream->source);
+			delete stream;
+			return false;
+		}
+
+		stream->freeBuffers.assign(stream->buffers, stream->buffers + kStreamBufferCount);
+		stream->file = NULL;
+		stream->loop = false;
+		stream->active = false;
+		stream->endOfFile = false;
+		stream->quit = false;
+		pthread_mutex_init(&stream->mutex, NULL);
+		pthread_cond_init(&stream->condition, NULL);
+
+		s_stream = stream;
+		pthread_create(&s_stream->thread, NULL, streamThread, NULL);
+		return true;
+	}
+
+	static void destroyStream()
+	{
+		if (!s_stream)
+			return;
+
+		pthread_mutex_lock(&s_stream->mutex);
+		s_stream->quit = true;
+		pthread_cond_signal(&s_stream->condition);
+		pthread_mutex_unlock(&s_stream->mutex);
+		pthread_join(s_stream->thread, NULL);
+
+		alSourceStop(s_stream->source);
+		alSourcei(s_stream->source, AL_BUFFER, AL_NONE);
+		alDeleteSources(1, &s_stream->source);
+		alDeleteBuffers(kStreamBufferCount, s_stream->buffers);
+		checkALError("destroyStream:alDeleteBuffers");
+
+		pthread_mutex_destroy(&s_stream->mutex);
+		pthread_cond_destroy(&s_stream->condition);
+		delete s_stream;
+		s_stream = NULL;
+	}
+
+	// Stops the source and takes back all the buffers, called with the stream mutex locked.
+	static void resetStream()
+	{
+		s_stream->active = false;
+		alSourceStop(s_stream->source);
+		// detaching the buffer of a stopped source empties its queue
+		alSourcei(s_stream->source, AL_BUFFER, AL_NONE);
+		checkALError("resetStream:alSourcei");
+		s_stream->freeBuffers.assign(s_stream->buffers, s_stream->buffers + kStreamBufferCount);
+	}
+
+	// Plays the stream file from the start, called with the stream mutex locked.
+	static void restartStream()
+	{
+		resetStream();
+
+		if (ov_raw_seek(s_stream->file, 0) != 0)
+		{
+			fprintf(stderr, "Could not rewind OGG stream\n");
+			return;
+		}
+		s_stream->endOfFile = false;
+
+		// only decode what is needed to start, the thread decodes the rest
+		queueFreeStreamBuffers(kStreamPrimeBuffers);
+		alSourcePlay(s_stream->source);
+		checkALError("restartStream:alSourcePlay");
+
+		s_stream->active = true;
+		pthread_cond_signal(&s_stream->condition);
+	}
+
+	static bool isStreamSource(ALuint source)
+	{
+		return s_stream && source != AL_NONE && source == s_stream->source;
+	}
+
+	static void playStream(backgroundMusicData *data, bool bLoop)
+	{
+		if (!createStream())
+			return;
+
+		vorbis_info *info = ov_info(&data->ogg, -1);
+
+		pthread_mutex_lock(&s_stream->mutex);
+		s_stream->file = &data->ogg;
+		s_stream->format = info->channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+		s_stream->rate = info->rate;
+		s_stream->loop = bLoop;
+		restartStream();
+		pthread_mutex_unlock(&s_stream->mutex);
+
+		s_backgroundSource = s_stream->source;
+	}
+
+#endif // DISABLE_VORBIS
+
+	// The stream thread touches the background source, lock it before using the source.
+	static void lockBackground()
+	{
+#ifndef DISABLE_VORBIS
+		if (isStreamSource(s_backgroundSource))
+			pthread_mutex_lock(&s_stream->mutex);
+#endif
+	}
+
+	static void unlockBackground()
+	{
+#ifndef DISABLE_VORBIS
+		if (isStreamSource(s_backgroundSource))
+			pthread_mutex_unlock(&s_stream->mutex);
+#endif
+	}
+
+	static void releaseBackgroundMusicData(backgroundMusicData *data)
+	{
+#ifndef DISABLE_VORBIS
+		if (data->streamed)
+		{
+			ov_clear(&data->ogg);
+			delete data;
+			return;
+		}
+#endif
+		alSourceStop(data->source);
+		checkALError("releaseBackgroundMusicData:alSourceStop");
+		alDeleteSources(1, &data->source);
+		checkALError("releaseBackgroundMusicData:alDeleteSources");
+		alDeleteBuffers(1, &data->buffer);
+		checkALError("releaseBackgroundMusicData:alDeleteBuffers");
+		delete data;
+	}
+
     static void stopBackground(bool bReleaseData)
     {
-		alSourceStop(s_backgroundSource);
+#ifndef DISABLE_VORBIS
+		if (isStreamSource(s_backgroundSource))
+		{
+			pthread_mutex_lock(&s_stream->mutex);
+			resetStream();
+			s_stream->file = NULL;
+			pthread_mutex_unlock(&s_stream->mutex);
+		}
+		else
+#endif
+			alSourceStop(s_backgroundSource);
 
 		if (bReleaseData)
 		{
 			for (BackgroundMusicsMap::iterator it = s_backgroundMusics.begin(); it != s_backgroundMusics.end(); ++it)
 			{
-				if (it->second->source == s_backgroundSource)
+				if (it->second == s_backgroundMusic)
 				{
-					alDeleteBuffers(1, &it->second->buffer);
-					checkALError("stopBackground:alDeleteBuffers");
-					alDeleteSources(1, &it->second->source);
-					checkALError("stopBackground:alDeleteSources");
-					delete it->second;
+					releaseBackgroundMusicData(it->second);
 					s_backgroundMusics.erase(it);
 					break;
 				}
@@ -128,6 +474,7 @@ namespace CocosDenshion
 		}
 
 		s_backgroundSource = AL_NONE;
+		s_backgroundMusic = NULL;
     }
 
     static void setBackgroundVolume(float volume)
@@ -135,6 +482,117 @@ namespace CocosDenshion
     	alSourcef(s_backgroundSource, AL_GAIN, volume);
     }
 
+	//
+	// voice pool
+	//
+	static void releaseVoice(effectVoice& voice)
+	{
+		alSourceStop(voice.source);
+		checkALError("releaseVoice:alSourceStop");
+		alSourcei(voice.source, AL_BUFFER, AL_NONE);
+		checkALError("releaseVoice:alSourcei");
+		voice.buffer = AL_NONE;
+		voice.handle = 0;
+	}
+
+	// Returns true if the voice is playing or paused, frees it when its sound is over.
+	static bool isVoiceBusy(effectVoice& voice)
+	{
+		if (voice.handle == 0)
+			return false;
+
+		ALint state;
+		alGetSourcei(voice.source, AL_SOURCE_STATE, &state);
+		if (state == AL_PLAYING || state == AL_PAUSED)
+			return true;
+
+		voice.handle = 0;
+		return false;
+	}
+
+	static effectVoice* voiceForHandle(unsigned int nSoundId)
+	{
+		if (nSoundId == 0)
+			return NULL;
+
+		unsigned int index = nSoundId & kVoiceIndexMask;
+		if (index >= s_voices.size() || s_voices[index].handle != nSoundId)
+			return NULL;
+
+		return &s_voices[index];
+	}
+
+	// Returns the index of a voice for a sound of the given priority, or -1 if the sound must be dropped.
+	static int acquireVoice(int priority)
+	{
+		for (unsigned int i = 0; i < s_voices.size(); ++i)
+		{
+			if (!isVoiceBusy(s_voices[i]))
+				return i;
+		}
+
+		if (s_voices.size() < s_maxVoices)
+		{
+			effectVoice voice;
+			alGenSources(1, &voice.source);
+			if (checkALError("acquireVoice:alGenSources") == AL_NO_ERROR)
+			{
+				voice.buffer = AL_NONE;
+				voice.handle = 0;
+				voice.order = 0;
+				voice.priority = 0;
+				s_voices.push_back(voice);
+				return s_voices.size() - 1;
+			}
+			// the driver is out of sources, steal one of ours
+		}
+
+		int victim = -1;
+		for (unsigned int i = 0; i < s_voices.size(); ++i)
+		{
+			const effectVoice& voice = s_voices[i];
+			if (voice.priority > priority)
+				continue;
+
+			if (victim < 0
+				|| voice.priority < s_voices[victim].priority
+				|| (voice.priority == s_voices[victim].priority && (int)(voice.order - s_voices[victim].order) < 0))
+			{
+				victim = i;
+			}
+		}
+
+		if (victim < 0)
+		{
+			++s_droppedVoices;
+			return -1;
+		}
+
+		releaseVoice(s_voices[victim]);
+		++s_stolenVoices;
+		return victim;
+	}
+
+	static void releaseVoicesOfBuffer(ALuint buffer)
+	{
+		for (EffectVoices::iterator it = s_voices.begin(); it != s_voices.end(); ++it)
+		{
+			if (it->buffer == buffer)
+				releaseVoice(*it);
+		}
+	}
+
+	static void deleteVoices(unsigned int count)
+	{
+		while (s_voices.size() > count)
+		{
+			releaseVoice(s_voices.back());
+			alDeleteSources(1, &s_voices.back().source);
+			checkALError("deleteVoices:alDeleteSources");
+			s_voices.pop_back();
+		}
+	}
+
 	SimpleAudioEngine::SimpleAudioEngine()
 	{
 		alutInit(0, 0);
@@ -158,16 +616,14 @@ namespace CocosDenshion
 	{
 		checkALError("end:init");
 
-		// clear all the sounds
+		// clear all the voices and the sounds
+		deleteVoices(0);
+
 	    EffectsMap::const_iterator end = s_effects.end();
 	    for (EffectsMap::iterator it = s_effects.begin(); it != end; it++)
 	    {
-	        alSourceStop(it->second->source);
-	        checkALError("end:alSourceStop");
 			alDeleteBuffers(1, &it->second->buffer);
 			checkALError("end:alDeleteBuffers");
-			alDeleteSources(1, &it->second->source);
-			checkALError("end:alDeleteSources");
 			delete it->second;
 	    }
 	    s_effects.clear();
@@ -175,15 +631,13 @@ namespace CocosDenshion
 		// and the background too
 		stopBackground(true);
 
+#ifndef DISABLE_VORBIS
+		destroyStream();
+#endif
+
 		for (BackgroundMusicsMap::iterator it = s_backgroundMusics.begin(); it != s_backgroundMusics.end(); ++it)
 		{
-			alSourceStop(it->second->source);
-			checkALError("end:alSourceStop");
-			alDeleteBuffers(1, &it->second->buffer);
-			checkALError("end:alDeleteBuffers");
-			alDeleteSources(1, &it->second->source);
-			checkALError("end:alDeleteSources");
-			delete it->second;
+			releaseBackgroundMusicData(it->second);
 		}
 		s_backgroundMusics.clear();
 	}
@@ -294,16 +748,28 @@ namespace CocosDenshion
     	BackgroundMusicsMap::const_iterator it = s_backgroundMusics.find(fullPath);
 		if (it == s_backgroundMusics.end())
 		{
-			ALuint buffer = AL_NONE;
 #ifndef DISABLE_VORBIS			
 			if (isOGGFile(fullPath.data()))
 			{
-				buffer = createBufferFromOGG(fullPath.data());
+				// only open the file and parse its headers, the music is decoded while it plays
+				backgroundMusicData* data = new backgroundMusicData();
+				if (ov_fopen(fullPath.c_str(), &data->ogg) < 0)
+				{
+					ov_clear(&data->ogg);
+					delete data;
+					fprintf(stderr, "Could not open OGG file %s\n", fullPath.c_str());
+					return;
+				}
+
+				data->buffer = AL_NONE;
+				data->source = AL_NONE;
+				data->streamed = true;
+				s_backgroundMusics.insert(BackgroundMusicsMap::value_type(fullPath, data));
+				return;
 			}
-			else
 #endif			
-				buffer = alutCreateBufferFromFile(fullPath.data());
-			
+
+			ALuint buffer = alutCreateBufferFromFile(fullPath.data());
 
 			checkALError("preloadBackgroundMusic:createBuffer");
 
@@ -324,6 +790,9 @@ namespace CocosDenshion
 			backgroundMusicData* data = new backgroundMusicData();
 			data->buffer = buffer;
 			data->source = source;
+#ifndef DISABLE_VORBIS
+			data->streamed = false;
+#endif
 			s_backgroundMusics.insert(BackgroundMusicsMap::value_type(fullPath, data));
 		}
 	}
@@ -345,8 +814,18 @@ namespace CocosDenshion
 
 		if (it != s_backgroundMusics.end())
 		{
-			s_backgroundSource = it->second->source;
+			s_backgroundMusic = it->second;
+#ifndef DISABLE_VORBIS
+			if (s_backgroundMusic->streamed)
+			{
+				playStream(s_backgroundMusic, bLoop);
+				setBackgroundVolume(s_volume);
+				return;
+			}
+#endif
+			s_backgroundSource = s_backgroundMusic->source;
 			alSourcei(s_backgroundSource, AL_LOOPING, bLoop ? AL_TRUE : AL_FALSE);
+			setBackgroundVolume(s_volume);
 			alSourcePlay(s_backgroundSource);
 			checkALError("playBackgroundMusic:alSourcePlay");
 		}
@@ -359,24 +838,39 @@ namespace CocosDenshion
 
 	void SimpleAudioEngine::pauseBackgroundMusic()
 	{
+		lockBackground();
 		ALint state;
 		alGetSourcei(s_backgroundSource, AL_SOURCE_STATE, &state);
 		if (state == AL_PLAYING)
 			alSourcePause(s_backgroundSource);
 		checkALError("pauseBackgroundMusic:alSourcePause");
+		unlockBackground();
 	}
 
 	void SimpleAudioEngine::resumeBackgroundMusic()
 	{
+		lockBackground();
 		ALint state;
 		alGetSourcei(s_backgroundSource, AL_SOURCE_STATE, &state);
 		if (state == AL_PAUSED)
 			alSourcePlay(s_backgroundSource);
 		checkALError("resumeBackgroundMusic:alSourcePlay");
+		unlockBackground();
 	} 
 
 	void SimpleAudioEngine::rewindBackgroundMusic()
 	{
+#ifndef DISABLE_VORBIS
+		if (isStreamSource(s_backgroundSource))
+		{
+			// seek the decoder, the queued buffers hold data of the old position
+			pthread_mutex_lock(&s_stream->mutex);
+			if (s_stream->file)
+				restartStream();
+			pthread_mutex_unlock(&s_stream->mutex);
+			return;
+		}
+#endif
 		alSourceRewind(s_backgroundSource);
 		checkALError("rewindBackgroundMusic:alSourceRewind");
 	}
@@ -421,10 +915,9 @@ namespace CocosDenshion
 	{
 		if (volume != s_effectVolume)
 		{
-			EffectsMap::const_iterator end = s_effects.end();
-			for (EffectsMap::const_iterator it = s_effects.begin(); it != end; it++)
+			for (EffectVoices::iterator it = s_voices.begin(); it != s_voices.end(); ++it)
 			{
-				alSourcef(it->second->source, AL_GAIN, volume);
+				alSourcef(it->source, AL_GAIN, volume);
 			}
 
 			s_effectVolume = volume;
@@ -432,6 +925,11 @@ namespace CocosDenshion
 	}
 
 	unsigned int SimpleAudioEngine::playEffect(const char* pszFilePath, bool bLoop)
+	{
+		return playEffectWithPriority(pszFilePath, bLoop, kEffectDefaultPriority);
+	}
+
+	unsigned int playEffectWithPriority(const char* pszFilePath, bool bLoop, int priority)
 	{
 		// Changing file path to full path
     	std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(pszFilePath);
@@ -440,30 +938,53 @@ namespace CocosDenshion
 
 		if (iter == s_effects.end())
 		{
-			preloadEffect(fullPath.c_str());
+			SimpleAudioEngine::sharedEngine()->preloadEffect(fullPath.c_str());
 
 			// let's try again
 			iter = s_effects.find(fullPath);
 			if (iter == s_effects.end())
 			{
 				fprintf(stderr, "could not find play sound %s\n", fullPath.c_str());
-				return -1;
+				return 0;
 			}
 		}
 
+		int index = acquireVoice(priority);
+		if (index < 0)
+		{
+			return 0;
+		}
+
+		effectVoice& voice = s_voices[index];
+
+		// the play order makes the handle unique, skip the values that would give a 0 handle
+		if (((++s_playCounter) << kVoiceIndexBits) == 0)
+			++s_playCounter;
+
+		voice.buffer = iter->second->buffer;
+		voice.order = s_playCounter;
+		voice.priority = priority;
+		voice.handle = (s_playCounter << kVoiceIndexBits) | index;
+
 		checkALError("playEffect:init");
-		iter->second->isLooped = bLoop;
-		alSourcei(iter->second->source, AL_LOOPING, iter->second->isLooped ? AL_TRUE : AL_FALSE);
-		alSourcePlay(iter->second->source);
-		checkALError("playEffect:alSourcePlay");
+		alSourcei(voice.source, AL_BUFFER, voice.buffer);
+		alSourcei(voice.source, AL_LOOPING, bLoop ? AL_TRUE : AL_FALSE);
+		alSourcef(voice.source, AL_GAIN, s_effectVolume);
+		alSourcePlay(voice.source);
+		if (checkALError("playEffect:alSourcePlay") != AL_NO_ERROR)
+		{
+			releaseVoice(voice);
+			return 0;
+		}
 
-		return iter->second->source;
+		return voice.handle;
 	}
 
 	void SimpleAudioEngine::stopEffect(unsigned int nSoundId)
 	{
-		alSourceStop(nSoundId);
-		checkALError("stopEffect:alSourceStop");
+		effectVoice *voice = voiceForHandle(nSoundId);
+		if (voice)
+			releaseVoice(*voice);
 	}
 
 	void SimpleAudioEngine::preloadEffect(const char* pszFilePath)
@@ -477,8 +998,6 @@ namespace CocosDenshion
 		if (iter == s_effects.end())
 		{
 			ALuint 		buffer;
-			ALuint 		source;
-			soundData  *data = new soundData;
 			string 	    path = fullPath;
 
 			checkALError("preloadEffect:init");
@@ -501,20 +1020,9 @@ namespace CocosDenshion
 				return;
 			}
 
-			alGenSources(1, &source);
-
-			if (checkALError("preloadEffect:alGenSources") != AL_NO_ERROR)
-			{
-				alDeleteBuffers(1, &buffer);
-				return;
-			}
-
-			alSourcei(source, AL_BUFFER, buffer);
-			checkALError("preloadEffect:alSourcei");
-
-			data->isLooped = false;
+			// no source is bound here, the effect is played by a voice of the pool
+			soundData *data = new soundData;
 			data->buffer = buffer;
-			data->source = source;
 
 			s_effects.insert(EffectsMap::value_type(fullPath, data));
 		}
@@ -531,11 +1039,8 @@ namespace CocosDenshion
 	    {
 			checkALError("unloadEffect:init");
 
-	        alSourceStop(iter->second->source);
-	        checkALError("unloadEffect:alSourceStop");
-
-			alDeleteSources(1, &iter->second->source);
-			checkALError("unloadEffect:DeletSources");
+			// a buffer can't be deleted while a source uses it
+			releaseVoicesOfBuffer(iter->second->buffer);
 
 			alDeleteBuffers(1, &iter->second->buffer);
 			checkALError("unloadEffect:alDeleteBuffers");
@@ -547,60 +1052,110 @@ namespace CocosDenshion
 
 	void SimpleAudioEngine::pauseEffect(unsigned int nSoundId)
 	{
-		ALint state;
-		alGetSourcei(nSoundId, AL_SOURCE_STATE, &state);
-		if (state == AL_PLAYING)
-			alSourcePause(nSoundId);
-		checkALError("pauseEffect:alSourcePause");
+		effectVoice *voice = voiceForHandle(nSoundId);
+		if (voice && isVoiceBusy(*voice))
+		{
+			alSourcePause(voice->source);
+			checkALError("pauseEffect:alSourcePause");
+		}
 	}
 
 	void SimpleAudioEngine::pauseAllEffects()
 	{
-		EffectsMap::iterator iter = s_effects.begin();
 		ALint state;
-		while (iter != s_effects.end())
+		for (EffectVoices::iterator it = s_voices.begin(); it != s_voices.end(); ++it)
 	    {
-			alGetSourcei(iter->second->source, AL_SOURCE_STATE, &state);
+			if (it->handle == 0)
+				continue;
+
+			alGetSourcei(it->source, AL_SOURCE_STATE, &state);
 			if (state == AL_PLAYING)
-				alSourcePause(iter->second->source);
+				alSourcePause(it->source);
 			checkALError("pauseAllEffects:alSourcePause");
-			++iter;
 	    }
 	}
 
 	void SimpleAudioEngine::resumeEffect(unsigned int nSoundId)
 	{
+		effectVoice *voice = voiceForHandle(nSoundId);
+		if (!voice)
+			return;
+
 		ALint state;
-		alGetSourcei(nSoundId, AL_SOURCE_STATE, &state);
+		alGetSourcei(voice->source, AL_SOURCE_STATE, &state);
 		if (state == AL_PAUSED)
-			alSourcePlay(nSoundId);
+			alSourcePlay(voice->source);
 		checkALError("resumeEffect:alSourcePlay");
 	}
 
 	void SimpleAudioEngine::resumeAllEffects()
 	{
-		EffectsMap::iterator iter = s_effects.begin();
 		ALint state;
-		while (iter != s_effects.end())
+		for (EffectVoices::iterator it = s_voices.begin(); it != s_voices.end(); ++it)
 	    {
-			alGetSourcei(iter->second->source, AL_SOURCE_STATE, &state);
+			if (it->handle == 0)
+				continue;
+
+			alGetSourcei(it->source, AL_SOURCE_STATE, &state);
 			if (state == AL_PAUSED)
-				alSourcePlay(iter->second->source);
+				alSourcePlay(it->source);
 			checkALError("resumeAllEffects:alSourcePlay");
-			++iter;
 	    }
 	}
 
     void SimpleAudioEngine::stopAllEffects()
     {
-		EffectsMap::iterator iter = s_effects.begin();
-
-		if (iter != s_effects.end())
+		checkALError("stopAllEffects:init");
+		for (EffectVoices::iterator it = s_voices.begin(); it != s_voices.end(); ++it)
 	    {
-			checkALError("stopAllEffects:init");
-	        alSourceStop(iter->second->source);
-			checkALError("stopAllEffects:alSourceStop");
+			if (it->handle != 0)
+				releaseVoice(*it);
 	    }
     }
 
+	//
+	// voice pool settings and counters
+	//
+	void setMaxEffectVoices(unsigned int count)
+	{
+		if (count < 1)
+			count = 1;
+		else if (count > kMaxVoicesLimit)
+			count = kMaxVoicesLimit;
+
+		s_maxVoices = count;
+		deleteVoices(count);
+	}
+
+	unsigned int getMaxEffectVoices()
+	{
+		return s_maxVoices;
+	}
+
+	bool isEffectPlaying(unsigned int nSoundId)
+	{
+		effectVoice *voice = voiceForHandle(nSoundId);
+		return voice && isVoiceBusy(*voice);
+	}
+
+	void getEffectVoiceStats(EffectVoiceStats *stats)
+	{
+		stats->active = 0;
+		for (EffectVoices::iterator it = s_voices.begin(); it != s_voices.end(); ++it)
+		{
+			if (isVoiceBusy(*it))
+				++stats->active;
+		}
+
+		stats->allocated = s_voices.size();
+		stats->stolen = s_stolenVoices;
+		stats->dropped = s_droppedVoices;
+	}
+
+	void resetEffectVoiceStats()
+	{
+		s_stolenVoices = 0;
+		s_droppedVoices = 0;
+	}
+
 }
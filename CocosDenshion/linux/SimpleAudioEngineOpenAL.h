@@ -0,0 +1,85 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef _SIMPLE_AUDIO_ENGINE_OPENAL_H_
+#define _SIMPLE_AUDIO_ENGINE_OPENAL_H_
+
+#include "Export.h"
+
+/**
+ Extensions of the OpenAL implementation of SimpleAudioEngine (linux only).
+
+ Sound effects are played by a fixed pool of OpenAL sources ("voices")
+ shared by all the preloaded effects, so the same effect can be heard
+ several times at once and the number of preloaded effects is not limited
+ by the number of sources of the driver.
+
+ When all voices are busy, the voice with the lowest priority is stolen,
+ the oldest one among voices of the same priority. If all busy voices have
+ a higher priority than the new sound, the new sound is dropped.
+
+ The ids returned by playEffect identify one playing instance. They stay
+ valid until the instance ends or its voice is stolen, after that they are
+ silently ignored.
+ */
+namespace CocosDenshion {
+
+/** Voice pool counters. */
+struct EffectVoiceStats
+{
+    /** Voices currently playing or paused. */
+    unsigned int active;
+    /** Number of voices allocated in the pool. */
+    unsigned int allocated;
+    /** Sounds interrupted to play a new sound since the last reset. */
+    unsigned int stolen;
+    /** Sounds that could not be played because all voices had a higher priority. */
+    unsigned int dropped;
+};
+
+/** Priority of the sounds played with SimpleAudioEngine::playEffect. */
+static const int kEffectDefaultPriority = 0;
+
+/** @brief Sets the maximum number of voices of the pool. Default is 32.
+    Voices are created on demand, fewer voices may be available if the driver runs out of sources.
+    Lowering the limit stops the sounds of the voices above it.
+ */
+EXPORT_DLL void setMaxEffectVoices(unsigned int count);
+EXPORT_DLL unsigned int getMaxEffectVoices();
+
+/** @brief Plays an effect with a priority used by the voice stealing policy.
+    @return the id of the playing instance, or 0 if the sound was dropped or could not be loaded.
+ */
+EXPORT_DLL unsigned int playEffectWithPriority(const char* pszFilePath, bool bLoop, int priority);
+
+/** @brief Returns true if the instance is still playing or paused. */
+EXPORT_DLL bool isEffectPlaying(unsigned int nSoundId);
+
+EXPORT_DLL void getEffectVoiceStats(EffectVoiceStats *stats);
+/** @brief Resets the stolen and dropped counters. */
+EXPORT_DLL void resetEffectVoiceStats();
+
+} // end of namespace CocosDenshion
+
+#endif // _SIMPLE_AUDIO_ENGINE_OPENAL_H_
@@ -81,6 +81,7 @@ platform/CCImageCommonWebp.cpp \
 platform/CCSAXParser.cpp \
 platform/CCThread.cpp \
 platform/CCFileUtils.cpp \
+platform/CCFileView.cpp \
 platform/platform.cpp \
 platform/CCEGLViewProtocol.cpp \
 platform/android/CCDevice.cpp \
@@ -120,8 +121,10 @@ support/ccUtils.cpp \
 support/CCVertex.cpp \
 support/data_support/ccCArray.cpp \
 support/image_support/TGAlib.cpp \
+support/image_support/CCImageEncoder.cpp \
 support/tinyxml2/tinyxml2.cpp \
 support/zip_support/ZipUtils.cpp \
+support/zip_support/ccLZ4.cpp \
 support/zip_support/ioapi.cpp \
 support/zip_support/unzip.cpp \
 support/component/CCComponent.cpp \
@@ -48,6 +48,8 @@ CCConfiguration::CCConfiguration(void)
 , _supportsBGRA8888(false)
 , _supportsDiscardFramebuffer(false)
 , _supportsShareableVAO(false)
+, _supportsPixelBufferObject(false)
+, _supportsProgramBinary(false)
 , _maxSamplesAllowed(0)
 , _maxTextureUnits(0)
 , _glExtensions(NULL)
@@ -139,6 +141,23 @@ void CCConfiguration::gatherGPUInfo()
 
     _supportsShareableVAO = checkForGLExtension("vertex_array_object");
 	_valueDict->setObject( CCBool::create(_supportsShareableVAO), "gl.supports_vertex_array_object");
+
+    // OpenGL ES 2.0 can't map buffers for reading, even with GL_NV_pixel_buffer_object
+#ifdef GL_PIXEL_PACK_BUFFER
+    _supportsPixelBufferObject = checkForGLExtension("pixel_buffer_object");
+#endif
+	_valueDict->setObject( CCBool::create(_supportsPixelBufferObject), "gl.supports_pixel_buffer_object");
+
+    // some drivers expose the extension without any binary format
+#ifdef CC_GL_PROGRAM_BINARY_LENGTH
+    GLint binaryFormats = 0;
+    if (checkForGLExtension("get_program_binary"))
+    {
+        glGetIntegerv(CC_GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+    }
+    _supportsProgramBinary = binaryFormats > 0;
+#endif
+	_valueDict->setObject( CCBool::create(_supportsProgramBinary), "gl.supports_program_binary");
     
     CHECK_GL_ERROR_DEBUG();
 }
@@ -217,6 +236,16 @@ bool CCConfiguration::supportsShareableVAO(void) const
 	return _supportsShareableVAO;
 }
 
+bool CCConfiguration::supportsPixelBufferObject(void) const
+{
+	return _supportsPixelBufferObject;
+}
+
+bool CCConfiguration::supportsProgramBinary(void) const
+{
+	return _supportsProgramBinary;
+}
+
 //
 // generic getters for properties
 //
@@ -101,6 +101,16 @@ public:
      */
 	bool supportsShareableVAO(void) const;
 
+    /** Whether or not pixel buffer objects can be used to read back framebuffers asynchronously.
+     @since v3.0
+     */
+	bool supportsPixelBufferObject(void) const;
+
+    /** Whether or not linked programs can be saved and loaded as binaries (GL_ARB/OES_get_program_binary).
+     @since v3.0
+     */
+	bool supportsProgramBinary(void) const;
+
     /** returns whether or not an OpenGL is supported */
     bool checkForGLExtension(const std::string &searchName) const;
 
@@ -146,6 +156,8 @@ protected:
     bool            _supportsBGRA8888;
     bool            _supportsDiscardFramebuffer;
     bool            _supportsShareableVAO;
+    bool            _supportsPixelBufferObject;
+    bool            _supportsProgramBinary;
     GLint           _maxSamplesAllowed;
     GLint           _maxTextureUnits;
     char *          _glExtensions;
@@ -117,6 +117,8 @@ bool CCDirector::init(void)
 
     _notificationNode = NULL;
 
+    _fixedDeltaTime = 0.0f;
+
     _scenesStack = new CCArray();
     _scenesStack->init();
 
@@ -129,8 +131,12 @@ bool CCDirector::init(void)
     _FPSLabel = NULL;
     _SPFLabel = NULL;
     _drawsLabel = NULL;
+    _glStatesLabel = NULL;
+    _frameTimesLabel = NULL;
+    resetFrameTimeHistogram();
+    memset(&_glStateStats, 0, sizeof(_glStateStats));
     _totalFrames = _frames = 0;
-    _FPS = new char[10];
+    _FPS = new char[32];
     _lastUpdate = new struct cc_timeval();
 
     // paused ?
@@ -178,6 +184,8 @@ CCDirector::~CCDirector(void)
     CC_SAFE_RELEASE(_FPSLabel);
     CC_SAFE_RELEASE(_SPFLabel);
     CC_SAFE_RELEASE(_drawsLabel);
+    CC_SAFE_RELEASE(_glStatesLabel);
+    CC_SAFE_RELEASE(_frameTimesLabel);
     
     CC_SAFE_RELEASE(_runningScene);
     CC_SAFE_RELEASE(_notificationNode);
@@ -294,6 +302,11 @@ void CCDirector::drawScene(void)
         showStats();
     }
 
+    ccDrawFlush();
+
+    _glStateStats = g_glStateStats;
+    memset(&g_glStateStats, 0, sizeof(g_glStateStats));
+
     kmGLPopMatrix();
 
     _totalFrames++;
@@ -329,8 +342,14 @@ void CCDirector::calculateDeltaTime(void)
     }
     else
     {
-        _deltaTime = (now.tv_sec - _lastUpdate->tv_sec) + (now.tv_usec - _lastUpdate->tv_usec) / 1000000.0f;
-        _deltaTime = MAX(0, _deltaTime);
+        float frameTime = (now.tv_sec - _lastUpdate->tv_sec) + (now.tv_usec - _lastUpdate->tv_usec) / 1000000.0f;
+        frameTime = MAX(0, frameTime);
+
+        unsigned int bucket = (unsigned int)(frameTime / kCCFrameTimeHistogramResolution);
+        ++_frameTimeHistogram[MIN(bucket, (unsigned int)kCCFrameTimeHistogramBuckets - 1)];
+        ++_frameTimeCount;
+
+        _deltaTime = _fixedDeltaTime > 0 ? _fixedDeltaTime : frameTime;
     }
 
 #ifdef DEBUG
@@ -392,6 +411,39 @@ void CCDirector::setNextDeltaTimeZero(bool bNextDeltaTimeZero)
     _nextDeltaTimeZero = bNextDeltaTimeZero;
 }
 
+float CCDirector::getFrameTimePercentile(float percentile) const
+{
+    if (_frameTimeCount == 0)
+    {
+        return 0;
+    }
+
+    // nearest rank, the frames of a bucket are assumed to be in its middle
+    unsigned int rank = (unsigned int)ceilf(clampf(percentile, 0, 100) / 100 * _frameTimeCount);
+    rank = MAX(rank, 1);
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < kCCFrameTimeHistogramBuckets; ++i)
+    {
+        count += _frameTimeHistogram[i];
+        if (count >= rank)
+        {
+            return (i + 0.5f) * kCCFrameTimeHistogramResolution;
+        }
+    }
+    return kCCFrameTimeHistogramBuckets * kCCFrameTimeHistogramResolution;
+}
+
+void CCDirector::resetFrameTimeHistogram(void)
+{
+    memset(_frameTimeHistogram, 0, sizeof(_frameTimeHistogram));
+    _frameTimeCount = 0;
+}
+
+void CCDirector::setFixedDeltaTime(float dt)
+{
+    _fixedDeltaTime = MAX(0, dt);
+}
+
 void CCDirector::setProjection(ccDirectorProjection kProjection)
 {
     CCSize size = _winSizeInPoints;
@@ -706,6 +758,8 @@ void CCDirector::purgeDirector()
     CC_SAFE_RELEASE_NULL(_FPSLabel);
     CC_SAFE_RELEASE_NULL(_SPFLabel);
     CC_SAFE_RELEASE_NULL(_drawsLabel);
+    CC_SAFE_RELEASE_NULL(_glStatesLabel);
+    CC_SAFE_RELEASE_NULL(_frameTimesLabel);
 
     // purge bitmap cache
     CCLabelBMFont::purgeCachedData();
@@ -813,7 +867,7 @@ void CCDirector::showStats(void)
     
     if (_displayStats)
     {
-        if (_FPSLabel && _SPFLabel && _drawsLabel)
+        if (_FPSLabel && _SPFLabel && _drawsLabel && _glStatesLabel && _frameTimesLabel)
         {
             if (_accumDt > CC_DIRECTOR_STATS_INTERVAL)
             {
@@ -829,8 +883,21 @@ void CCDirector::showStats(void)
                 
                 sprintf(_FPS, "%4lu", (unsigned long)g_uNumberOfDraws);
                 _drawsLabel->setString(_FPS);
+
+                sprintf(_FPS, "%u/%u", _glStateStats.stateChanges + _glStateStats.uniformUploads,
+                        _glStateStats.redundantStateChanges + _glStateStats.redundantUniformUploads);
+                _glStatesLabel->setString(_FPS);
+
+                sprintf(_FPS, "%.1f/%.1f/%.1f", getFrameTimePercentile(50) * 1000,
+                        getFrameTimePercentile(95) * 1000, getFrameTimePercentile(99) * 1000);
+                _frameTimesLabel->setString(_FPS);
+
+                // each update shows the frames since the previous one
+                resetFrameTimeHistogram();
             }
             
+            _frameTimesLabel->visit();
+            _glStatesLabel->visit();
             _drawsLabel->visit();
             _FPSLabel->visit();
             _SPFLabel->visit();
@@ -866,6 +933,8 @@ void CCDirector::createStatsLabel()
         CC_SAFE_RELEASE_NULL(_FPSLabel);
         CC_SAFE_RELEASE_NULL(_SPFLabel);
         CC_SAFE_RELEASE_NULL(_drawsLabel);
+        CC_SAFE_RELEASE_NULL(_glStatesLabel);
+        CC_SAFE_RELEASE_NULL(_frameTimesLabel);
         textureCache->removeTextureForKey("cc_fps_images");
         CCFileUtils::sharedFileUtils()->purgeCachedEntries();
     }
@@ -916,8 +985,20 @@ void CCDirector::createStatsLabel()
     _drawsLabel->initWithString("000", texture, 12, 32, '.');
     _drawsLabel->setScale(factor);
 
+    _glStatesLabel = new CCLabelAtlas();
+    _glStatesLabel->setIgnoreContentScaleFactor(true);
+    _glStatesLabel->initWithString("000/000", texture, 12, 32, '.');
+    _glStatesLabel->setScale(factor);
+
+    _frameTimesLabel = new CCLabelAtlas();
+    _frameTimesLabel->setIgnoreContentScaleFactor(true);
+    _frameTimesLabel->initWithString("00.0/00.0/00.0", texture, 12, 32, '.');
+    _frameTimesLabel->setScale(factor);
+
     CCTexture2D::setDefaultAlphaPixelFormat(currentFormat);
 
+    _frameTimesLabel->setPosition(ccpAdd(ccp(0, 68*factor), CC_DIRECTOR_STATS_POSITION));
+    _glStatesLabel->setPosition(ccpAdd(ccp(0, 51*factor), CC_DIRECTOR_STATS_POSITION));
     _drawsLabel->setPosition(ccpAdd(ccp(0, 34*factor), CC_DIRECTOR_STATS_POSITION));
     _SPFLabel->setPosition(ccpAdd(ccp(0, 17*factor), CC_DIRECTOR_STATS_POSITION));
     _FPSLabel->setPosition(CC_DIRECTOR_STATS_POSITION);
@@ -36,10 +36,20 @@ THE SOFTWARE.
 #include "kazmath/mat4.h"
 #include "label_nodes/CCLabelAtlas.h"
 #include "ccTypeInfo.h"
+#include "shaders/ccGLStateCache.h"
 
 
 NS_CC_BEGIN
 
+/** Resolution of the frame time histogram of the director, in seconds.
+ @since v3.0
+ */
+#define kCCFrameTimeHistogramResolution 0.0001f
+/** Number of buckets of the frame time histogram, longer frames are counted in the last one.
+ @since v3.0
+ */
+#define kCCFrameTimeHistogramBuckets 1000
+
 /**
  * @addtogroup base_nodes
  * @{
@@ -133,11 +143,35 @@ public:
     inline bool isNextDeltaTimeZero(void) { return _nextDeltaTimeZero; }
     void setNextDeltaTimeZero(bool bNextDeltaTimeZero);
 
+    /** Uses the same delta time for every frame instead of the measured one, 0 to measure it again.
+     Benchmarks use it so that every run plays the same frames, however long they take.
+     @since v3.0
+     */
+    inline float getFixedDeltaTime(void) { return _fixedDeltaTime; }
+    void setFixedDeltaTime(float dt);
+
     /** Whether or not the Director is paused */
     inline bool isPaused(void) { return _paused; }
 
     /** How many frames were called since the director started */
     inline unsigned int getTotalFrames(void) { return _totalFrames; }
+
+    /** GL state changes and uniform uploads done and avoided during the last frame.
+     The stats label shows the changes done and the redundant ones avoided.
+     @since v3.0
+     */
+    inline const ccGLStateStats& getGLStateStats(void) const { return _glStateStats; }
+
+    /** Percentile, from 0 to 100, of the times between the frames since the last resetFrameTimeHistogram, in seconds.
+     The stats show the 50th, 95th and 99th percentiles, in milliseconds, and reset the histogram at each update.
+     Frames longer than the histogram count as kCCFrameTimeHistogramBuckets * kCCFrameTimeHistogramResolution.
+     @since v3.0
+     */
+    float getFrameTimePercentile(float percentile) const;
+    /** Number of frames in the histogram */
+    inline unsigned int getFrameTimeCount(void) const { return _frameTimeCount; }
+    /** Forgets the previous frame times, for instance when a scene starts. */
+    void resetFrameTimeHistogram(void);
     
     /** Sets an OpenGL projection
      @since v0.8.2
@@ -382,6 +416,15 @@ protected:
     CCLabelAtlas *_FPSLabel;
     CCLabelAtlas *_SPFLabel;
     CCLabelAtlas *_drawsLabel;
+    CCLabelAtlas *_glStatesLabel;
+    CCLabelAtlas *_frameTimesLabel;
+
+    /* frame times histogram */
+    unsigned int _frameTimeHistogram[kCCFrameTimeHistogramBuckets];
+    unsigned int _frameTimeCount;
+
+    /* GL state counters of the last frame */
+    ccGLStateStats _glStateStats;
     
     /** Whether or not the Director is paused */
     bool _paused;
@@ -409,6 +452,9 @@ protected:
 
     /* whether or not the next delta time will be zero */
     bool _nextDeltaTimeZero;
+
+    /* delta time of every frame if not 0 */
+    float _fixedDeltaTime;
     
     /* projection used */
     ccDirectorProjection _projection;
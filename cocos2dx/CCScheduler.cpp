@@ -81,6 +81,7 @@ CCTimer::CCTimer()
 , _interval(0.0f)
 , _selector(NULL)
 , _scriptHandler(0)
+, _scheduler(NULL)
 {
 }
 
@@ -162,7 +163,7 @@ void CCTimer::update(float dt)
 
                 if (_scriptHandler)
                 {
-                    CCScriptEngineManager::sharedManager()->getScriptEngine()->executeSchedule(_scriptHandler, _elapsed);
+                    executeScriptHandler(_elapsed);
                 }
                 _elapsed = 0;
             }
@@ -181,7 +182,7 @@ void CCTimer::update(float dt)
 
                     if (_scriptHandler)
                     {
-                        CCScriptEngineManager::sharedManager()->getScriptEngine()->executeSchedule(_scriptHandler, _elapsed);
+                        executeScriptHandler(_elapsed);
                     }
 
                     _elapsed = _elapsed - _delay;
@@ -200,7 +201,7 @@ void CCTimer::update(float dt)
 
                     if (_scriptHandler)
                     {
-                        CCScriptEngineManager::sharedManager()->getScriptEngine()->executeSchedule(_scriptHandler, _elapsed);
+                        executeScriptHandler(_elapsed);
                     }
 
                     _elapsed = 0;
@@ -217,6 +218,14 @@ void CCTimer::update(float dt)
     }
 }
 
+void CCTimer::executeScriptHandler(float dt)
+{
+    if (! _scheduler || ! _scheduler->queueScriptSchedule(_scriptHandler, dt, this))
+    {
+        CCScriptEngineManager::sharedManager()->getScriptEngine()->executeSchedule(_scriptHandler, dt);
+    }
+}
+
 float CCTimer::getInterval() const
 {
     return _interval;
@@ -245,6 +254,7 @@ CCScheduler::CCScheduler(void)
 , _currentTargetSalvaged(false)
 , _updateHashLocked(false)
 , _scriptHandlerEntries(NULL)
+, _scriptBatchingEnabled(false)
 {
 
 }
@@ -524,6 +534,8 @@ void CCScheduler::unscheduleUpdateForTarget(const CCObject *pTarget)
     HASH_FIND_INT(_hashForUpdates, &pTarget, pElement);
     if (pElement)
     {
+        cancelScriptSchedules(pTarget);
+
         if (_updateHashLocked)
         {
             pElement->entry->markedForDeletion = true;
@@ -628,6 +640,7 @@ void CCScheduler::unscheduleAllForTarget(CCObject *pTarget)
 unsigned int CCScheduler::scheduleScriptFunc(unsigned int nHandler, float fInterval, bool bPaused)
 {
     CCSchedulerScriptHandlerEntry* pEntry = CCSchedulerScriptHandlerEntry::create(nHandler, fInterval, bPaused);
+    pEntry->getTimer()->setScheduler(this);
     if (!_scriptHandlerEntries)
     {
         _scriptHandlerEntries = CCArray::createWithCapacity(20);
@@ -645,11 +658,51 @@ void CCScheduler::unscheduleScriptEntry(unsigned int uScheduleScriptEntryID)
         if (pEntry->getEntryId() == (int)uScheduleScriptEntryID)
         {
             pEntry->markedForDeletion();
+            cancelScriptSchedules(pEntry->getTimer());
             break;
         }
     }
 }
 
+void CCScheduler::setScriptBatchingEnabled(bool bEnabled)
+{
+    if (! bEnabled)
+    {
+        flushScriptSchedules();
+    }
+
+    _scriptBatchingEnabled = bEnabled;
+}
+
+bool CCScheduler::queueScriptSchedule(int nHandler, float dt, CCObject *pTarget)
+{
+    // only queue while updating, the queue is flushed before update() returns
+    if (! _scriptBatchingEnabled || ! _updateHashLocked)
+    {
+        return false;
+    }
+
+    return CCScriptEngineManager::sharedManager()->getScriptEngine()->queueSchedule(nHandler, dt, pTarget);
+}
+
+void CCScheduler::flushScriptSchedules()
+{
+    CCScriptEngineProtocol *pEngine = CCScriptEngineManager::sharedManager()->getScriptEngine();
+    if (_scriptBatchingEnabled && pEngine)
+    {
+        pEngine->flushSchedules();
+    }
+}
+
+void CCScheduler::cancelScriptSchedules(const CCObject *pTarget)
+{
+    CCScriptEngineProtocol *pEngine = CCScriptEngineManager::sharedManager()->getScriptEngine();
+    if (_scriptBatchingEnabled && pEngine)
+    {
+        pEngine->cancelSchedules(pTarget);
+    }
+}
+
 void CCScheduler::resumeTarget(CCObject *pTarget)
 {
     CCAssert(pTarget != NULL, "");
@@ -691,6 +744,7 @@ void CCScheduler::pauseTarget(CCObject *pTarget)
     {
         CCAssert(pElementUpdate->entry != NULL, "");
         pElementUpdate->entry->paused = true;
+        cancelScriptSchedules(pTarget);
     }
 }
 
@@ -800,6 +854,7 @@ void CCScheduler::update(float dt)
             pEntry->target->update(dt);
         }
     }
+    flushScriptSchedules();
 
     // updates with priority == 0
     DL_FOREACH_SAFE(_updates0List, pEntry, pTmp)
@@ -809,6 +864,7 @@ void CCScheduler::update(float dt)
             pEntry->target->update(dt);
         }
     }
+    flushScriptSchedules();
 
     // updates with priority > 0
     DL_FOREACH_SAFE(_updatesPosList, pEntry, pTmp)
@@ -818,6 +874,7 @@ void CCScheduler::update(float dt)
             pEntry->target->update(dt);
         }
     }
+    flushScriptSchedules();
 
     // Iterate over all the custom selectors
     for (tHashTimerEntry *elt = _hashForTimers; elt != NULL; )
@@ -873,6 +930,7 @@ void CCScheduler::update(float dt)
                 pEntry->getTimer()->update(dt);
             }
         }
+        flushScriptSchedules();
     }
 
     // delete all updates that are marked for deletion
@@ -44,6 +44,7 @@ NS_CC_BEGIN
 #define kCCPriorityNonSystemMin (kCCPrioritySystem+1)
 
 class CCSet;
+class CCScheduler;
 //
 // CCTimer
 //
@@ -85,7 +86,14 @@ public:
     
     inline int getScriptHandler() { return _scriptHandler; };
 
+    /** Sets the scheduler updating the timer, which queues its script callbacks. Not retained.
+     @since v3.0
+     */
+    inline void setScheduler(CCScheduler *pScheduler) { _scheduler = pScheduler; }
+
 protected:
+    void executeScriptHandler(float dt);
+
     CCObject *_target;
     float _elapsed;
     bool _runForever;
@@ -97,6 +105,7 @@ protected:
     SEL_SCHEDULE _selector;
     
     int _scriptHandler;
+    CCScheduler *_scheduler;
 };
 
 //
@@ -200,6 +209,23 @@ public:
     /** Unschedule a script entry. */
     void unscheduleScriptEntry(unsigned int uScheduleScriptEntryID);
 
+    /** Enables the batched dispatch of the script callbacks. Disabled by default.
+     When enabled, the script update callbacks of the nodes and the script entries are not
+     called one by one: they are queued and the script engine runs each priority group
+     (priority < 0, == 0, > 0 and the script entries) in a single call.
+     Unscheduling or pausing a target cancels its queued callback, even during the dispatch.
+     Pausing a target from a script callback doesn't stop callbacks already dispatched in the same group.
+     @since v3.0
+     */
+    void setScriptBatchingEnabled(bool bEnabled);
+    inline bool isScriptBatchingEnabled(void) { return _scriptBatchingEnabled; }
+
+    /** Queues a script schedule callback when the batched dispatch is enabled and the scheduler is updating.
+     @return false if the callback must be executed right away.
+     @since v3.0
+     */
+    bool queueScriptSchedule(int nHandler, float dt, CCObject *pTarget);
+
     /** Pauses the target.
      All scheduled selectors/update for a given target won't be 'ticked' until the target is resumed.
      If the target is not present, nothing happens.
@@ -246,6 +272,10 @@ private:
     void priorityIn(struct _listEntry **ppList, CCObject *pTarget, int nPriority, bool bPaused);
     void appendIn(struct _listEntry **ppList, CCObject *pTarget, bool bPaused);
 
+    // batched script dispatch
+    void flushScriptSchedules();
+    void cancelScriptSchedules(const CCObject *pTarget);
+
 protected:
     float _timeScale;
 
@@ -264,6 +294,7 @@ protected:
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
     bool _updateHashLocked;
     CCArray* _scriptHandlerEntries;
+    bool _scriptBatchingEnabled;
 };
 
 // end of global group
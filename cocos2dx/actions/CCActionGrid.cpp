@@ -162,6 +162,18 @@ void CCGrid3DAction::setVertex(const CCPoint& position, const ccVertex3F& vertex
     g->setVertex(position, vertex);
 }
 
+ccVertex3F* CCGrid3DAction::getVertices(void)
+{
+    CCGrid3D *g = (CCGrid3D*)_target->getGrid();
+    return g->getVertices();
+}
+
+const ccVertex3F* CCGrid3DAction::getOriginalVertices(void)
+{
+    CCGrid3D *g = (CCGrid3D*)_target->getGrid();
+    return g->getOriginalVertices();
+}
+
 // implementation of TiledGrid3DAction
 
 CCGridBase* CCTiledGrid3DAction::getGrid(void)
@@ -187,6 +199,18 @@ void CCTiledGrid3DAction::setTile(const CCPoint& pos, const ccQuad3& coords)
     return g->setTile(pos, coords);
 }
 
+ccQuad3* CCTiledGrid3DAction::getTiles(void)
+{
+    CCTiledGrid3D *g = (CCTiledGrid3D*)_target->getGrid();
+    return g->getTiles();
+}
+
+const ccQuad3* CCTiledGrid3DAction::getOriginalTiles(void)
+{
+    CCTiledGrid3D *g = (CCTiledGrid3D*)_target->getGrid();
+    return g->getOriginalTiles();
+}
+
 CCTiledGrid3DAction* CCTiledGrid3DAction::create(float duration, const CCSize& gridSize)
 {
     CCTiledGrid3DAction* pRet = new CCTiledGrid3DAction();
@@ -79,6 +79,14 @@ public:
     ccVertex3F originalVertex(const CCPoint& position);
     /** sets a new vertex to a certain position of the grid */
     void setVertex(const CCPoint& position, const ccVertex3F& vertex);
+    /** returns all the vertices of the grid, see CCGrid3D::getVertices
+     @since v3.0
+     */
+    ccVertex3F* getVertices(void);
+    /** returns all the non-transformed vertices of the grid
+     @since v3.0
+     */
+    const ccVertex3F* getOriginalVertices(void);
 
 public:
     /** creates the action with size and duration */
@@ -95,6 +103,14 @@ public:
     ccQuad3 originalTile(const CCPoint& position);
     /** sets a new tile to a certain position of the grid */
     void setTile(const CCPoint& position, const ccQuad3& coords);
+    /** returns all the tiles of the grid, see CCTiledGrid3D::getTiles
+     @since v3.0
+     */
+    ccQuad3* getTiles(void);
+    /** returns all the non-transformed tiles of the grid
+     @since v3.0
+     */
+    const ccQuad3* getOriginalTiles(void);
 
     /** returns the grid */
     virtual CCGridBase* getGrid(void);
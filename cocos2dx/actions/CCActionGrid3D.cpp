@@ -90,16 +90,17 @@ CCObject* CCWaves3D::copyWithZone(CCZone *pZone)
 
 void CCWaves3D::update(float time)
 {
-    int i, j;
-    for (i = 0; i < _gridSize.width + 1; ++i)
+    const ccVertex3F *original = getOriginalVertices();
+    ccVertex3F *vertices = getVertices();
+    int count = (_gridSize.width + 1) * (_gridSize.height + 1);
+    float phase = (float)M_PI * time * _waves * 2;
+    float amplitude = _amplitude * _amplitudeRate;
+
+    for (int i = 0; i < count; ++i)
     {
-        for (j = 0; j < _gridSize.height + 1; ++j)
-        {
-            ccVertex3F v = originalVertex(ccp(i ,j));
-            v.z += (sinf((float)M_PI * time * _waves * 2 + (v.y+v.x) * 0.01f) * _amplitude * _amplitudeRate);
-            //CCLOG("v.z offset is %f\n", (sinf((float)M_PI * time * _waves * 2 + (v.y+v.x) * .01f) * _amplitude * _amplitudeRate));
-            setVertex(ccp(i, j), v);
-        }
+        ccVertex3F v = original[i];
+        v.z += sinf(phase + (v.y+v.x) * 0.01f) * amplitude;
+        vertices[i] = v;
     }
 }
 
@@ -413,38 +414,32 @@ void CCLens3D::update(float time)
     CC_UNUSED_PARAM(time);
     if (_dirty)
     {
-        int i, j;
-        
-        for (i = 0; i < _gridSize.width + 1; ++i)
+        const ccVertex3F *original = getOriginalVertices();
+        ccVertex3F *vertices = getVertices();
+        int count = (_gridSize.width + 1) * (_gridSize.height + 1);
+        float sign = _concave ? -1.0f : 1.0f;
+
+        for (int i = 0; i < count; ++i)
         {
-            for (j = 0; j < _gridSize.height + 1; ++j)
+            ccVertex3F v = original[i];
+            float r = ccpLength(ccp(_position.x - v.x, _position.y - v.y));
+
+            // the center itself doesn't move
+            if (r < _radius && r > 0)
             {
-                ccVertex3F v = originalVertex(ccp(i, j));
-                CCPoint vect = ccpSub(_position, ccp(v.x, v.y));
-                float r = ccpLength(vect);
-                
-                if (r < _radius)
+                r = _radius - r;
+                float pre_log = r / _radius;
+                if ( pre_log == 0 ) 
                 {
-                    r = _radius - r;
-                    float pre_log = r / _radius;
-                    if ( pre_log == 0 ) 
-                    {
-                        pre_log = 0.001f;
-                    }
-
-                    float l = logf(pre_log) * _lensEffect;
-                    float new_r = expf( l ) * _radius;
-                    
-                    if (ccpLength(vect) > 0)
-                    {
-                        vect = ccpNormalize(vect);
-                        CCPoint new_vect = ccpMult(vect, new_r);
-                        v.z += (_concave ? -1.0f : 1.0f) * ccpLength(new_vect) * _lensEffect;
-                    }
+                    pre_log = 0.001f;
                 }
-                
-                setVertex(ccp(i, j), v);
+
+                float l = logf(pre_log) * _lensEffect;
+                float new_r = expf( l ) * _radius;
+                v.z += sign * new_r * _lensEffect;
             }
+
+            vertices[i] = v;
         }
         
         _dirty = false;
@@ -518,25 +513,31 @@ CCObject* CCRipple3D::copyWithZone(CCZone *pZone)
 
 void CCRipple3D::update(float time)
 {
-    int i, j;
+    const ccVertex3F *original = getOriginalVertices();
+    ccVertex3F *vertices = getVertices();
+    int count = (_gridSize.width + 1) * (_gridSize.height + 1);
+    float phase = time*(float)M_PI * _waves * 2;
+    float amplitude = _amplitude * _amplitudeRate;
+    float radius = _radius;
+    float radiusSq = radius * radius;
+    CCPoint position = _position;
 
-    for (i = 0; i < (_gridSize.width+1); ++i)
+    for (int i = 0; i < count; ++i)
     {
-        for (j = 0; j < (_gridSize.height+1); ++j)
+        ccVertex3F v = original[i];
+        float dx = position.x - v.x;
+        float dy = position.y - v.y;
+        float rSq = dx * dx + dy * dy;
+
+        // only the vertices inside the ripple pay for the square root and the sine
+        if (rSq < radiusSq)
         {
-            ccVertex3F v = originalVertex(ccp(i, j));
-            CCPoint vect = ccpSub(_position, ccp(v.x,v.y));
-            float r = ccpLength(vect);
-            
-            if (r < _radius)
-            {
-                r = _radius - r;
-                float rate = powf(r / _radius, 2);
-                v.z += (sinf( time*(float)M_PI * _waves * 2 + r * 0.1f) * _amplitude * _amplitudeRate * rate);
-            }
-            
-            setVertex(ccp(i, j), v);
+            float r = radius - sqrtf(rSq);
+            float rate = (r / radius) * (r / radius);
+            v.z += sinf(phase + r * 0.1f) * amplitude * rate;
         }
+
+        vertices[i] = v;
     }
 }
 
@@ -600,22 +601,21 @@ CCObject* CCShaky3D::copyWithZone(CCZone *pZone)
 void CCShaky3D::update(float time)
 {
     CC_UNUSED_PARAM(time);
-    int i, j;
+    const ccVertex3F *original = getOriginalVertices();
+    ccVertex3F *vertices = getVertices();
+    int count = (_gridSize.width + 1) * (_gridSize.height + 1);
 
-    for (i = 0; i < (_gridSize.width+1); ++i)
+    for (int i = 0; i < count; ++i)
     {
-        for (j = 0; j < (_gridSize.height+1); ++j)
+        ccVertex3F v = original[i];
+        v.x += (rand() % (_randrange*2)) - _randrange;
+        v.y += (rand() % (_randrange*2)) - _randrange;
+        if (_shakeZ)
         {
-            ccVertex3F v = originalVertex(ccp(i ,j));
-            v.x += (rand() % (_randrange*2)) - _randrange;
-            v.y += (rand() % (_randrange*2)) - _randrange;
-            if (_shakeZ)
-            {
-                v.z += (rand() % (_randrange*2)) - _randrange;
-            }
-            
-            setVertex(ccp(i, j), v);
+            v.z += (rand() % (_randrange*2)) - _randrange;
         }
+
+        vertices[i] = v;
     }
 }
 
@@ -679,16 +679,23 @@ CCObject* CCLiquid::copyWithZone(CCZone *pZone)
 
 void CCLiquid::update(float time)
 {
-    int i, j;
+    const ccVertex3F *original = getOriginalVertices();
+    ccVertex3F *vertices = getVertices();
+    int columns = _gridSize.width;
+    int rows = _gridSize.height;
+    float phase = time * (float)M_PI * _waves * 2;
+    float amplitude = _amplitude * _amplitudeRate;
 
-    for (i = 1; i < _gridSize.width; ++i)
+    // the border of the grid doesn't move
+    for (int i = 1; i < columns; ++i)
     {
-        for (j = 1; j < _gridSize.height; ++j)
+        int column = i * (rows + 1);
+        for (int j = 1; j < rows; ++j)
         {
-            ccVertex3F v = originalVertex(ccp(i, j));
-            v.x = (v.x + (sinf(time * (float)M_PI * _waves * 2 + v.x * .01f) * _amplitude * _amplitudeRate));
-            v.y = (v.y + (sinf(time * (float)M_PI * _waves * 2 + v.y * .01f) * _amplitude * _amplitudeRate));
-            setVertex(ccp(i, j), v);
+            ccVertex3F v = original[column + j];
+            v.x = (v.x + (sinf(phase + v.x * .01f) * amplitude));
+            v.y = (v.y + (sinf(phase + v.y * .01f) * amplitude));
+            vertices[column + j] = v;
         }
     }
 }
@@ -755,26 +762,27 @@ CCObject* CCWaves::copyWithZone(CCZone *pZone)
 
 void CCWaves::update(float time)
 {
-    int i, j;
+    const ccVertex3F *original = getOriginalVertices();
+    ccVertex3F *vertices = getVertices();
+    int count = (_gridSize.width + 1) * (_gridSize.height + 1);
+    float phase = time * (float)M_PI * _waves * 2;
+    float amplitude = _amplitude * _amplitudeRate;
 
-    for (i = 0; i < _gridSize.width + 1; ++i)
+    for (int i = 0; i < count; ++i)
     {
-        for (j = 0; j < _gridSize.height + 1; ++j)
-        {
-            ccVertex3F v = originalVertex(ccp(i, j));
+        ccVertex3F v = original[i];
 
-            if (_vertical)
-            {
-                v.x = (v.x + (sinf(time * (float)M_PI * _waves * 2 + v.y * .01f) * _amplitude * _amplitudeRate));
-            }
-
-            if (_horizontal)
-            {
-                v.y = (v.y + (sinf(time * (float)M_PI * _waves * 2 + v.x * .01f) * _amplitude * _amplitudeRate));
-            }
+        if (_vertical)
+        {
+            v.x = (v.x + (sinf(phase + v.y * .01f) * amplitude));
+        }
 
-            setVertex(ccp(i, j), v);
+        if (_horizontal)
+        {
+            v.y = (v.y + (sinf(phase + v.x * .01f) * amplitude));
         }
+
+        vertices[i] = v;
     }
 }
 
@@ -845,29 +853,35 @@ CCObject* CCTwirl::copyWithZone(CCZone *pZone)
 
 void CCTwirl::update(float time)
 {
-    int i, j;
+    const ccVertex3F *original = getOriginalVertices();
+    ccVertex3F *vertices = getVertices();
+    int columns = _gridSize.width + 1;
+    int rows = _gridSize.height + 1;
     CCPoint    c = _position;
-    
-    for (i = 0; i < (_gridSize.width+1); ++i)
+
+    float amp = 0.1f * _amplitude * _amplitudeRate;
+    float twist = cosf( (float)M_PI/2.0f + time * (float)M_PI * _twirls * 2 ) * amp;
+
+    for (int i = 0, k = 0; i < columns; ++i)
     {
-        for (j = 0; j < (_gridSize.height+1); ++j)
+        float avgX = i - (_gridSize.width/2.0f);
+        for (int j = 0; j < rows; ++j, ++k)
         {
-            ccVertex3F v = originalVertex(ccp(i ,j));
-            
-            CCPoint    avg = ccp(i-(_gridSize.width/2.0f), j-(_gridSize.height/2.0f));
-            float r = ccpLength(avg);
-            
-            float amp = 0.1f * _amplitude * _amplitudeRate;
-            float a = r * cosf( (float)M_PI/2.0f + time * (float)M_PI * _twirls * 2 ) * amp;
-            
-            CCPoint d = ccp(
-                sinf(a) * (v.y-c.y) + cosf(a) * (v.x-c.x),
-                cosf(a) * (v.y-c.y) - sinf(a) * (v.x-c.x));
-            
-            v.x = c.x + d.x;
-            v.y = c.y + d.y;
-
-            setVertex(ccp(i ,j), v);
+            ccVertex3F v = original[k];
+
+            float avgY = j - (_gridSize.height/2.0f);
+            float r = sqrtf(avgX * avgX + avgY * avgY);
+            float a = r * twist;
+            float sinA = sinf(a);
+            float cosA = cosf(a);
+
+            float dx = sinA * (v.y-c.y) + cosA * (v.x-c.x);
+            float dy = cosA * (v.y-c.y) - sinA * (v.x-c.x);
+
+            v.x = c.x + dx;
+            v.y = c.y + dy;
+
+            vertices[k] = v;
         }
     }
 }
@@ -63,49 +63,49 @@ void CCPageTurn3D::update(float time)
     float sinTheta = sinf(theta);
     float cosTheta = cosf(theta);
     
-    for (int i = 0; i <= _gridSize.width; ++i)
+    const ccVertex3F *original = getOriginalVertices();
+    ccVertex3F *vertices = getVertices();
+    int count = (_gridSize.width + 1) * (_gridSize.height + 1);
+
+    for (int i = 0; i < count; ++i)
     {
-        for (int j = 0; j <= _gridSize.height; ++j)
+        // Get original vertex
+        ccVertex3F p = original[i];
+        
+        float R = sqrtf((p.x * p.x) + ((p.y - ay) * (p.y - ay)));
+        float r = R * sinTheta;
+        float alpha = asinf( p.x / R );
+        float beta = alpha / sinTheta;
+        float cosBeta = cosf( beta );
+        
+        // If beta > PI then we've wrapped around the cone
+        // Reduce the radius to stop these points interfering with others
+        if (beta <= M_PI)
+        {
+            p.x = ( r * sinf(beta));
+        }
+        else
         {
-            // Get original vertex
-            ccVertex3F p = originalVertex(ccp(i ,j));
-            
-            float R = sqrtf((p.x * p.x) + ((p.y - ay) * (p.y - ay)));
-            float r = R * sinTheta;
-            float alpha = asinf( p.x / R );
-            float beta = alpha / sinTheta;
-            float cosBeta = cosf( beta );
-            
-            // If beta > PI then we've wrapped around the cone
-            // Reduce the radius to stop these points interfering with others
-            if (beta <= M_PI)
-            {
-                p.x = ( r * sinf(beta));
-            }
-            else
-            {
-                // Force X = 0 to stop wrapped
-                // points
-                p.x = 0;
-            }
+            // Force X = 0 to stop wrapped
+            // points
+            p.x = 0;
+        }
 
-            p.y = ( R + ay - ( r * (1 - cosBeta) * sinTheta));
+        p.y = ( R + ay - ( r * (1 - cosBeta) * sinTheta));
 
-            // We scale z here to avoid the animation being
-            // too much bigger than the screen due to perspective transform
-            p.z = (r * ( 1 - cosBeta ) * cosTheta) / 7;// "100" didn't work for
+        // We scale z here to avoid the animation being
+        // too much bigger than the screen due to perspective transform
+        p.z = (r * ( 1 - cosBeta ) * cosTheta) / 7;// "100" didn't work for
 
-            //    Stop z coord from dropping beneath underlying page in a transition
-            // issue #751
-            if( p.z < 0.5f )
-            {
-                p.z = 0.5f;
-            }
-            
-            // Set new coords
-            setVertex(ccp(i, j), p);
-            
+        //    Stop z coord from dropping beneath underlying page in a transition
+        // issue #751
+        if( p.z < 0.5f )
+        {
+            p.z = 0.5f;
         }
+        
+        // Set new coords
+        vertices[i] = p;
     }
 }
 
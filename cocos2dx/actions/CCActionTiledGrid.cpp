@@ -99,36 +99,35 @@ CCObject* CCShakyTiles3D::copyWithZone(CCZone *pZone)
 void CCShakyTiles3D::update(float time)
 {
     CC_UNUSED_PARAM(time);
-    int i, j;
+    const ccQuad3 *original = getOriginalTiles();
+    ccQuad3 *tiles = getTiles();
+    int count = _gridSize.width * _gridSize.height;
 
-    for (i = 0; i < _gridSize.width; ++i)
+    for (int i = 0; i < count; ++i)
     {
-        for (j = 0; j < _gridSize.height; ++j)
-        {
-            ccQuad3 coords = originalTile(ccp(i, j));
+        ccQuad3 coords = original[i];
 
-            // X
-            coords.bl.x += ( rand() % (_randrange*2) ) - _randrange;
-            coords.br.x += ( rand() % (_randrange*2) ) - _randrange;
-            coords.tl.x += ( rand() % (_randrange*2) ) - _randrange;
-            coords.tr.x += ( rand() % (_randrange*2) ) - _randrange;
+        // X
+        coords.bl.x += ( rand() % (_randrange*2) ) - _randrange;
+        coords.br.x += ( rand() % (_randrange*2) ) - _randrange;
+        coords.tl.x += ( rand() % (_randrange*2) ) - _randrange;
+        coords.tr.x += ( rand() % (_randrange*2) ) - _randrange;
 
-            // Y
-            coords.bl.y += ( rand() % (_randrange*2) ) - _randrange;
-            coords.br.y += ( rand() % (_randrange*2) ) - _randrange;
-            coords.tl.y += ( rand() % (_randrange*2) ) - _randrange;
-            coords.tr.y += ( rand() % (_randrange*2) ) - _randrange;
+        // Y
+        coords.bl.y += ( rand() % (_randrange*2) ) - _randrange;
+        coords.br.y += ( rand() % (_randrange*2) ) - _randrange;
+        coords.tl.y += ( rand() % (_randrange*2) ) - _randrange;
+        coords.tr.y += ( rand() % (_randrange*2) ) - _randrange;
 
-            if (_shakeZ)
-            {
-                coords.bl.z += ( rand() % (_randrange*2) ) - _randrange;
-                coords.br.z += ( rand() % (_randrange*2) ) - _randrange;
-                coords.tl.z += ( rand() % (_randrange*2) ) - _randrange;
-                coords.tr.z += ( rand() % (_randrange*2) ) - _randrange;
-            }
-                        
-            setTile(ccp(i, j), coords);
+        if (_shakeZ)
+        {
+            coords.bl.z += ( rand() % (_randrange*2) ) - _randrange;
+            coords.br.z += ( rand() % (_randrange*2) ) - _randrange;
+            coords.tl.z += ( rand() % (_randrange*2) ) - _randrange;
+            coords.tr.z += ( rand() % (_randrange*2) ) - _randrange;
         }
+
+        tiles[i] = coords;
     }
 }
 
@@ -193,38 +192,38 @@ CCObject* CCShatteredTiles3D::copyWithZone(CCZone *pZone)
 void CCShatteredTiles3D::update(float time)
 {
     CC_UNUSED_PARAM(time);
-    int i, j;
 
     if (_once == false)
     {
-        for (i = 0; i < _gridSize.width; ++i)
+        const ccQuad3 *original = getOriginalTiles();
+        ccQuad3 *tiles = getTiles();
+        int count = _gridSize.width * _gridSize.height;
+
+        for (int i = 0; i < count; ++i)
         {
-            for (j = 0; j < _gridSize.height; ++j)
+            ccQuad3 coords = original[i];
+
+            // X
+            coords.bl.x += ( rand() % (_randrange*2) ) - _randrange;
+            coords.br.x += ( rand() % (_randrange*2) ) - _randrange;
+            coords.tl.x += ( rand() % (_randrange*2) ) - _randrange;
+            coords.tr.x += ( rand() % (_randrange*2) ) - _randrange;
+
+            // Y
+            coords.bl.y += ( rand() % (_randrange*2) ) - _randrange;
+            coords.br.y += ( rand() % (_randrange*2) ) - _randrange;
+            coords.tl.y += ( rand() % (_randrange*2) ) - _randrange;
+            coords.tr.y += ( rand() % (_randrange*2) ) - _randrange;
+
+            if (_shatterZ) 
             {
-                ccQuad3 coords = originalTile(ccp(i ,j));
-                
-                // X
-                coords.bl.x += ( rand() % (_randrange*2) ) - _randrange;
-                coords.br.x += ( rand() % (_randrange*2) ) - _randrange;
-                coords.tl.x += ( rand() % (_randrange*2) ) - _randrange;
-                coords.tr.x += ( rand() % (_randrange*2) ) - _randrange;
-                
-                // Y
-                coords.bl.y += ( rand() % (_randrange*2) ) - _randrange;
-                coords.br.y += ( rand() % (_randrange*2) ) - _randrange;
-                coords.tl.y += ( rand() % (_randrange*2) ) - _randrange;
-                coords.tr.y += ( rand() % (_randrange*2) ) - _randrange;
-
-                if (_shatterZ) 
-                {
-                    coords.bl.z += ( rand() % (_randrange*2) ) - _randrange;
-                    coords.br.z += ( rand() % (_randrange*2) ) - _randrange;                
-                    coords.tl.z += ( rand() % (_randrange*2) ) - _randrange;
-                    coords.tr.z += ( rand() % (_randrange*2) ) - _randrange;
-                }
-                
-                setTile(ccp(i, j), coords);
+                coords.bl.z += ( rand() % (_randrange*2) ) - _randrange;
+                coords.br.z += ( rand() % (_randrange*2) ) - _randrange;
+                coords.tl.z += ( rand() % (_randrange*2) ) - _randrange;
+                coords.tr.z += ( rand() % (_randrange*2) ) - _randrange;
             }
+
+            tiles[i] = coords;
         }
         
         _once = true;
@@ -796,22 +795,22 @@ CCObject* CCWavesTiles3D::copyWithZone(CCZone *pZone)
 
 void CCWavesTiles3D::update(float time)
 {
-    int i, j;
+    const ccQuad3 *original = getOriginalTiles();
+    ccQuad3 *tiles = getTiles();
+    int count = _gridSize.width * _gridSize.height;
+    float phase = time * (float)M_PI  *_waves * 2;
+    float amplitude = _amplitude * _amplitudeRate;
 
-    for( i = 0; i < _gridSize.width; i++ )
+    for (int i = 0; i < count; ++i)
     {
-        for( j = 0; j < _gridSize.height; j++ )
-        {
-            ccQuad3 coords = originalTile(ccp(i, j));
+        ccQuad3 coords = original[i];
 
-            coords.bl.z = (sinf(time * (float)M_PI  *_waves * 2 + 
-                (coords.bl.y+coords.bl.x) * .01f) * _amplitude * _amplitudeRate );
-            coords.br.z    = coords.bl.z;
-            coords.tl.z = coords.bl.z;
-            coords.tr.z = coords.bl.z;
+        coords.bl.z = sinf(phase + (coords.bl.y+coords.bl.x) * .01f) * amplitude;
+        coords.br.z    = coords.bl.z;
+        coords.tl.z = coords.bl.z;
+        coords.tr.z = coords.bl.z;
 
-            setTile(ccp(i, j), coords);
-        }
+        tiles[i] = coords;
     }
 }
 
@@ -878,11 +877,15 @@ void CCJumpTiles3D::update(float time)
     float sinz =  (sinf((float)M_PI * time * _jumps * 2) * _amplitude * _amplitudeRate );
     float sinz2 = (sinf((float)M_PI * (time * _jumps * 2 + 1)) * _amplitude * _amplitudeRate );
 
+    const ccQuad3 *original = getOriginalTiles();
+    ccQuad3 *tiles = getTiles();
+
     for( i = 0; i < _gridSize.width; i++ )
     {
         for( j = 0; j < _gridSize.height; j++ )
         {
-            ccQuad3 coords = originalTile(ccp(i, j));
+            int idx = i * _gridSize.height + j;
+            ccQuad3 coords = original[idx];
 
             if ( ((i+j) % 2) == 0 )
             {
@@ -899,7 +902,7 @@ void CCJumpTiles3D::update(float time)
                 coords.tr.z += sinz2;
             }
 
-            setTile(ccp(i, j), coords);
+            tiles[idx] = coords;
         }
     }
 }
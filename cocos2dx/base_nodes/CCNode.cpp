@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "actions/CCActionManager.h"
 #include "script_support/CCScriptSupport.h"
 #include "shaders/CCGLProgram.h"
+#include "draw_nodes/CCDrawingPrimitives.h"
 // externals
 #include "kazmath/GL/matrix.h"
 #include "support/component/CCComponent.h"
@@ -51,6 +52,7 @@ NS_CC_BEGIN
 
 // XXX: Yes, nodes might have a sort problem once every 15 days if the game runs at 60 FPS and each frame sprites are reordered.
 static int s_globalOrderOfArrival = 1;
+static unsigned int s_transformEpoch = 1;
 
 CCNode::CCNode(void)
 : _rotationX(0.0f)
@@ -83,6 +85,7 @@ CCNode::CCNode(void)
 , _running(false)
 , _transformDirty(true)
 , _inverseDirty(true)
+, _transformStamp(0)
 , _additionalTransformDirty(false)
 , _visible(true)
 , _ignoreAnchorPointForPosition(false)
@@ -431,6 +434,7 @@ CCNode * CCNode::getParent()
 void CCNode::setParent(CCNode * var)
 {
     _parent = var;
+    _transformStamp = s_transformEpoch;
 }
 
 /// isRelativeAnchorPoint getter
@@ -838,6 +842,8 @@ void CCNode::visit()
         }
         // self draw
         this->draw();
+        // the primitives drawn by this node must not end up above its children
+        ccDrawFlush();
 
         for( ; i < arrayData->num; i++ )
         {
@@ -851,6 +857,7 @@ void CCNode::visit()
     else
     {
         this->draw();
+        ccDrawFlush();
     }
 
     // reset for next frame
@@ -1118,7 +1125,7 @@ void CCNode::pauseSchedulerAndActions()
 // override me
 void CCNode::update(float fDelta)
 {
-    if (_updateScriptHandler)
+    if (_updateScriptHandler && ! _scheduler->queueScriptSchedule(_updateScriptHandler, fDelta, this))
     {
         CCScriptEngineManager::sharedManager()->getScriptEngine()->executeSchedule(_updateScriptHandler, fDelta, this);
     }
@@ -1200,6 +1207,7 @@ CCAffineTransform CCNode::nodeToParentTransform(void)
         }
 
         _transformDirty = false;
+        _transformStamp = s_transformEpoch;
     }
 
     return _transform;
@@ -1237,6 +1245,23 @@ CCAffineTransform CCNode::worldToNodeTransform(void)
     return CCAffineTransformInvert(this->nodeToWorldTransform());
 }
 
+unsigned int CCNode::newTransformEpoch()
+{
+    return ++s_transformEpoch;
+}
+
+bool CCNode::isTransformChangedSince(unsigned int epoch)
+{
+    for (CCNode *p = this; p != NULL; p = p->_parent)
+    {
+        if (p->_transformDirty || p->_transformStamp >= epoch)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 CCPoint CCNode::convertToNodeSpace(const CCPoint& worldPoint)
 {
     CCPoint ret = CCPointApplyAffineTransform(worldPoint, worldToNodeTransform());
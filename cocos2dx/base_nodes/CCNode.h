@@ -1214,6 +1214,24 @@ public:
      */
     virtual CCAffineTransform worldToNodeTransform(void);
 
+    /**
+     * Starts a new transform epoch and returns it.
+     *
+     * Caches of world transforms save the epoch returned after computing them, they stay valid
+     * as long as isTransformChangedSince returns false for that epoch.
+     * @since v3.0
+     */
+    static unsigned int newTransformEpoch();
+
+    /**
+     * Returns true if the transform or the parent of the node or of one of its ancestors
+     * changed since an epoch returned by newTransformEpoch.
+     *
+     * @note Only the changes made through the transform setters of CCNode are seen.
+     * @since v3.0
+     */
+    bool isTransformChangedSince(unsigned int epoch);
+
     /// @} end of Transformations
     
     
@@ -1392,6 +1410,7 @@ protected:
     
     bool _transformDirty;             ///< transform dirty flag
     bool _inverseDirty;               ///< transform dirty flag
+    unsigned int _transformStamp;     ///< transform epoch of the last change of the transform or of the parent
     bool _additionalTransformDirty;   ///< The flag to check whether the additional transform is dirty
     bool _visible;                    ///< is this node visible
     
@@ -3,6 +3,12 @@
 
 NS_CC_BEGIN
 
+CCData::CCData()
+: _bytes(NULL)
+, _size(0)
+{
+}
+
 CCData::CCData(unsigned char *pBytes, const unsigned long nSize)
 {
     _size = nSize;
@@ -30,7 +30,9 @@ public:
     /* override functions */
     virtual void acceptVisitor(CCDataVisitor &visitor) { visitor.visit(this); }
 
-private:
+protected:
+    CCData();
+
     unsigned char* _bytes;
     unsigned long _size;
 };
@@ -26,44 +26,184 @@
 #include "CCString.h"
 #include "CCInteger.h"
 #include "platform/CCFileUtils.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
 
 using namespace std;
 
 NS_CC_BEGIN
 
 // -----------------------------------------------------------------------
-// CCDictElement
+// Interned keys
 
-CCDictElement::CCDictElement(const char* pszKey, CCObject* pObject)
+namespace {
+
+/** One copy of a string key shared by all the dictionaries, the chars follow the header. */
+struct InternedKey
 {
-    CCAssert(pszKey && strlen(pszKey) > 0, "Invalid key value.");
-    _intKey = 0;
-    const char* pStart = pszKey;
-    
-    int len = strlen(pszKey);
-    if (len > MAX_KEY_LEN )
+    unsigned int hash;
+    unsigned int length;
+    unsigned int refCount;
+};
+
+inline InternedKey* internedKeyOf(const char* pszKey)
+{
+    return (InternedKey*)pszKey - 1;
+}
+
+inline const char* charsOf(InternedKey* key)
+{
+    return (const char*)(key + 1);
+}
+
+// FNV-1a
+unsigned int hashStrKey(const char* key, unsigned int length)
+{
+    unsigned int hash = 2166136261u;
+    for (unsigned int i = 0; i < length; ++i)
     {
-        char* pEnd = (char*)&pszKey[len-1];
-        pStart = pEnd - (MAX_KEY_LEN-1);
+        hash ^= (unsigned char)key[i];
+        hash *= 16777619u;
     }
-    
-    strcpy(_strKey, pStart);
-    
-    _object = pObject;
-    memset(&hh, 0, sizeof(hh));
+    return hash;
+}
+
+unsigned int hashIntKey(intptr_t key)
+{
+    unsigned long long x = (unsigned long long)key;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (unsigned int)x;
+}
+
+// Dictionaries may be filled by loading threads, so the pool is locked.
+pthread_mutex_t s_keyPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+InternedKey** s_keySlots = NULL;
+unsigned int s_keySlotCount = 0;
+unsigned int s_keyCount = 0;
+
+void insertKeySlot(InternedKey** slots, unsigned int slotCount, InternedKey* key)
+{
+    unsigned int mask = slotCount - 1;
+    unsigned int i = key->hash & mask;
+    while (slots[i])
+    {
+        i = (i + 1) & mask;
+    }
+    slots[i] = key;
+}
+
+const char* internKey(const char* key, unsigned int length, unsigned int hash)
+{
+    pthread_mutex_lock(&s_keyPoolMutex);
+
+    unsigned int mask = s_keySlotCount - 1;
+    if (s_keySlotCount)
+    {
+        for (unsigned int i = hash & mask; s_keySlots[i]; i = (i + 1) & mask)
+        {
+            InternedKey* interned = s_keySlots[i];
+            if (interned->hash == hash && interned->length == length && memcmp(charsOf(interned), key, length) == 0)
+            {
+                ++interned->refCount;
+                pthread_mutex_unlock(&s_keyPoolMutex);
+                return charsOf(interned);
+            }
+        }
+    }
+
+    if ((s_keyCount + 1) * 4 > s_keySlotCount * 3)
+    {
+        unsigned int slotCount = s_keySlotCount ? s_keySlotCount * 2 : 256;
+        InternedKey** slots = (InternedKey**)calloc(slotCount, sizeof(InternedKey*));
+        for (unsigned int i = 0; i < s_keySlotCount; ++i)
+        {
+            if (s_keySlots[i])
+            {
+                insertKeySlot(slots, slotCount, s_keySlots[i]);
+            }
+        }
+        free(s_keySlots);
+        s_keySlots = slots;
+        s_keySlotCount = slotCount;
+    }
+
+    InternedKey* interned = (InternedKey*)malloc(sizeof(InternedKey) + length + 1);
+    interned->hash = hash;
+    interned->length = length;
+    interned->refCount = 1;
+    char* chars = (char*)(interned + 1);
+    memcpy(chars, key, length);
+    chars[length] = '\0';
+    insertKeySlot(s_keySlots, s_keySlotCount, interned);
+    ++s_keyCount;
+
+    pthread_mutex_unlock(&s_keyPoolMutex);
+    return chars;
+}
+
+void releaseKey(const char* pszKey)
+{
+    InternedKey* interned = internedKeyOf(pszKey);
+
+    pthread_mutex_lock(&s_keyPoolMutex);
+    if (--interned->refCount == 0)
+    {
+        unsigned int mask = s_keySlotCount - 1;
+        unsigned int i = interned->hash & mask;
+        while (s_keySlots[i] != interned)
+        {
+            i = (i + 1) & mask;
+        }
+        // backward shift deletion, the following keys of the cluster move up when it doesn't
+        // put them before their home slot
+        for (unsigned int j = (i + 1) & mask; s_keySlots[j]; j = (j + 1) & mask)
+        {
+            unsigned int home = s_keySlots[j]->hash & mask;
+            if (((j - home) & mask) >= ((j - i) & mask))
+            {
+                s_keySlots[i] = s_keySlots[j];
+                i = j;
+            }
+        }
+        s_keySlots[i] = NULL;
+        --s_keyCount;
+        free(interned);
+    }
+    pthread_mutex_unlock(&s_keyPoolMutex);
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------
+// CCDictElement
+
+CCDictElement::CCDictElement(const char* pszKey, CCObject* pObject)
+: _strKey(pszKey)
+, _intKey(0)
+, _object(pObject)
+, _prev(NULL)
+, _next(NULL)
+{
 }
 
 CCDictElement::CCDictElement(intptr_t iKey, CCObject* pObject)
+: _strKey(NULL)
+, _intKey(iKey)
+, _object(pObject)
+, _prev(NULL)
+, _next(NULL)
 {
-    _strKey[0] = '\0';
-    _intKey = iKey;
-    _object = pObject;
-    memset(&hh, 0, sizeof(hh));
 }
 
 CCDictElement::~CCDictElement()
 {
-
+    if (_strKey)
+    {
+        releaseKey(_strKey);
+    }
 }
 
 // -----------------------------------------------------------------------
@@ -71,6 +211,10 @@ CCDictElement::~CCDictElement()
 
 CCDictionary::CCDictionary()
 : _elements(NULL)
+, _lastElement(NULL)
+, _slots(NULL)
+, _slotCount(0)
+, _count(0)
 , _dictType(kCCDictUnknown)
 {
 
@@ -83,7 +227,7 @@ CCDictionary::~CCDictionary()
 
 unsigned int CCDictionary::count()
 {
-    return HASH_COUNT(_elements);
+    return _count;
 }
 
 CCArray* CCDictionary::allKeys()
@@ -93,10 +237,10 @@ CCArray* CCDictionary::allKeys()
 
     CCArray* pArray = CCArray::createWithCapacity(iKeyCount);
 
-    CCDictElement *pElement, *tmp;
+    CCDictElement* pElement = NULL;
     if (_dictType == kCCDictStr)
     {
-        HASH_ITER(hh, _elements, pElement, tmp) 
+        CCDICT_FOREACH(this, pElement)
         {
             CCString* pOneKey = new CCString(pElement->_strKey);
             pArray->addObject(pOneKey);
@@ -105,7 +249,7 @@ CCArray* CCDictionary::allKeys()
     }
     else if (_dictType == kCCDictInt)
     {
-        HASH_ITER(hh, _elements, pElement, tmp) 
+        CCDICT_FOREACH(this, pElement)
         {
             CCInteger* pOneKey = new CCInteger(pElement->_intKey);
             pArray->addObject(pOneKey);
@@ -122,11 +266,11 @@ CCArray* CCDictionary::allKeysForObject(CCObject* object)
     if (iKeyCount <= 0) return NULL;
     CCArray* pArray = CCArray::create();
 
-    CCDictElement *pElement, *tmp;
+    CCDictElement* pElement = NULL;
 
     if (_dictType == kCCDictStr)
     {
-        HASH_ITER(hh, _elements, pElement, tmp) 
+        CCDICT_FOREACH(this, pElement)
         {
             if (object == pElement->_object)
             {
@@ -138,7 +282,7 @@ CCArray* CCDictionary::allKeysForObject(CCObject* object)
     }
     else if (_dictType == kCCDictInt)
     {
-        HASH_ITER(hh, _elements, pElement, tmp) 
+        CCDICT_FOREACH(this, pElement)
         {
             if (object == pElement->_object)
             {
@@ -151,7 +295,106 @@ CCArray* CCDictionary::allKeysForObject(CCObject* object)
     return pArray;
 }
 
+CCDictElement* CCDictionary::findElement(const char* key, unsigned int length, unsigned int hash) const
+{
+    if (_count == 0)
+    {
+        return NULL;
+    }
+
+    unsigned int mask = _slotCount - 1;
+    for (unsigned int i = hash & mask; _slots[i]; i = (i + 1) & mask)
+    {
+        const char* pszKey = _slots[i]->_strKey;
+        InternedKey* interned = internedKeyOf(pszKey);
+        if (interned->hash == hash && interned->length == length && memcmp(pszKey, key, length) == 0)
+        {
+            return _slots[i];
+        }
+    }
+    return NULL;
+}
+
+CCDictElement* CCDictionary::findElement(intptr_t key) const
+{
+    if (_count == 0)
+    {
+        return NULL;
+    }
+
+    unsigned int mask = _slotCount - 1;
+    for (unsigned int i = hashIntKey(key) & mask; _slots[i]; i = (i + 1) & mask)
+    {
+        if (_slots[i]->_intKey == key)
+        {
+            return _slots[i];
+        }
+    }
+    return NULL;
+}
+
+unsigned int CCDictionary::hashOfElement(const CCDictElement* pElement)
+{
+    return pElement->_strKey ? internedKeyOf(pElement->_strKey)->hash : hashIntKey(pElement->_intKey);
+}
+
+void CCDictionary::resizeSlots(unsigned int slotCount)
+{
+    CCDictElement** slots = (CCDictElement**)calloc(slotCount, sizeof(CCDictElement*));
+    unsigned int mask = slotCount - 1;
+    for (unsigned int j = 0; j < _slotCount; ++j)
+    {
+        CCDictElement* pElement = _slots[j];
+        if (pElement)
+        {
+            unsigned int i = hashOfElement(pElement) & mask;
+            while (slots[i])
+            {
+                i = (i + 1) & mask;
+            }
+            slots[i] = pElement;
+        }
+    }
+    free(_slots);
+    _slots = slots;
+    _slotCount = slotCount;
+}
+
+void CCDictionary::addElement(CCDictElement* pElement, unsigned int hash)
+{
+    // keep the table at most 3/4 full
+    if ((_count + 1) * 4 > _slotCount * 3)
+    {
+        resizeSlots(_slotCount ? _slotCount * 2 : 8);
+    }
+
+    unsigned int mask = _slotCount - 1;
+    unsigned int i = hash & mask;
+    while (_slots[i])
+    {
+        i = (i + 1) & mask;
+    }
+    _slots[i] = pElement;
+    ++_count;
+
+    pElement->_prev = _lastElement;
+    if (_lastElement)
+    {
+        _lastElement->_next = pElement;
+    }
+    else
+    {
+        _elements = pElement;
+    }
+    _lastElement = pElement;
+}
+
 CCObject* CCDictionary::objectForKey(const std::string& key)
+{
+    return objectForKey(key.c_str(), key.length());
+}
+
+CCObject* CCDictionary::objectForKey(const char* key, unsigned int length)
 {
     // if dictionary wasn't initialized, return NULL directly.
     if (_dictType == kCCDictUnknown) return NULL;
@@ -159,14 +402,8 @@ CCObject* CCDictionary::objectForKey(const std::string& key)
     // This method uses string as key, therefore we should make sure that the key type of this CCDictionary is string.
     CCAssert(_dictType == kCCDictStr, "this dictionary does not use string as key.");
 
-    CCObject* pRetObject = NULL;
-    CCDictElement *pElement = NULL;
-    HASH_FIND_STR(_elements, key.c_str(), pElement);
-    if (pElement != NULL)
-    {
-        pRetObject = pElement->_object;
-    }
-    return pRetObject;
+    CCDictElement *pElement = findElement(key, length, hashStrKey(key, length));
+    return pElement ? pElement->_object : NULL;
 }
 
 CCObject* CCDictionary::objectForKey(intptr_t key)
@@ -177,19 +414,13 @@ CCObject* CCDictionary::objectForKey(intptr_t key)
     // This method uses integer as key, therefore we should make sure that the key type of this CCDictionary is integer.
     CCAssert(_dictType == kCCDictInt, "this dictionary does not use integer as key.");
 
-    CCObject* pRetObject = NULL;
-    CCDictElement *pElement = NULL;
-    HASH_FIND_PTR(_elements, &key, pElement);
-    if (pElement != NULL)
-    {
-        pRetObject = pElement->_object;
-    }
-    return pRetObject;
+    CCDictElement *pElement = findElement(key);
+    return pElement ? pElement->_object : NULL;
 }
 
 const CCString* CCDictionary::valueForKey(const std::string& key)
 {
-    CCString* pStr = dynamic_cast<CCString*>(objectForKey(key));
+    CCString* pStr = dynamic_cast<CCString*>(objectForKey(key.c_str(), key.length()));
     if (pStr == NULL)
     {
         pStr = CCString::create("");
@@ -209,7 +440,12 @@ const CCString* CCDictionary::valueForKey(intptr_t key)
 
 void CCDictionary::setObject(CCObject* pObject, const std::string& key)
 {
-    CCAssert(key.length() > 0 && pObject != NULL, "Invalid Argument!");
+    setObject(pObject, key.c_str(), key.length());
+}
+
+void CCDictionary::setObject(CCObject* pObject, const char* key, unsigned int length)
+{
+    CCAssert(length > 0 && pObject != NULL, "Invalid Argument!");
     if (_dictType == kCCDictUnknown)
     {
         _dictType = kCCDictStr;
@@ -217,18 +453,19 @@ void CCDictionary::setObject(CCObject* pObject, const std::string& key)
 
     CCAssert(_dictType == kCCDictStr, "this dictionary doesn't use string as key.");
 
-    CCDictElement *pElement = NULL;
-    HASH_FIND_STR(_elements, key.c_str(), pElement);
+    unsigned int hash = hashStrKey(key, length);
+    CCDictElement *pElement = findElement(key, length, hash);
     if (pElement == NULL)
     {
-        setObjectUnSafe(pObject, key);
+        pObject->retain();
+        addElement(new CCDictElement(internKey(key, length, hash), pObject), hash);
     }
     else if (pElement->_object != pObject)
     {
+        // the element keeps its place, the old object may release this dictionary
         CCObject* pTmpObj = pElement->_object;
-        pTmpObj->retain();
-        removeObjectForElememt(pElement);
-        setObjectUnSafe(pObject, key);
+        pObject->retain();
+        pElement->_object = pObject;
         pTmpObj->release();
     }
 }
@@ -243,21 +480,19 @@ void CCDictionary::setObject(CCObject* pObject, intptr_t key)
 
     CCAssert(_dictType == kCCDictInt, "this dictionary doesn't use integer as key.");
 
-    CCDictElement *pElement = NULL;
-    HASH_FIND_PTR(_elements, &key, pElement);
+    CCDictElement *pElement = findElement(key);
     if (pElement == NULL)
     {
-        setObjectUnSafe(pObject, key);
+        pObject->retain();
+        addElement(new CCDictElement(key, pObject), hashIntKey(key));
     }
     else if (pElement->_object != pObject)
     {
         CCObject* pTmpObj = pElement->_object;
-        pTmpObj->retain();
-        removeObjectForElememt(pElement);
-        setObjectUnSafe(pObject, key);
+        pObject->retain();
+        pElement->_object = pObject;
         pTmpObj->release();
     }
-
 }
 
 void CCDictionary::removeObjectForKey(const std::string& key)
@@ -269,9 +504,7 @@ void CCDictionary::removeObjectForKey(const std::string& key)
     
     CCAssert(_dictType == kCCDictStr, "this dictionary doesn't use string as its key");
     CCAssert(key.length() > 0, "Invalid Argument!");
-    CCDictElement *pElement = NULL;
-    HASH_FIND_STR(_elements, key.c_str(), pElement);
-    removeObjectForElememt(pElement);
+    removeObjectForElememt(findElement(key.c_str(), key.length(), hashStrKey(key.c_str(), key.length())));
 }
 
 void CCDictionary::removeObjectForKey(intptr_t key)
@@ -282,23 +515,7 @@ void CCDictionary::removeObjectForKey(intptr_t key)
     }
     
     CCAssert(_dictType == kCCDictInt, "this dictionary doesn't use integer as its key");
-    CCDictElement *pElement = NULL;
-    HASH_FIND_PTR(_elements, &key, pElement);
-    removeObjectForElememt(pElement);
-}
-
-void CCDictionary::setObjectUnSafe(CCObject* pObject, const std::string& key)
-{
-    pObject->retain();
-    CCDictElement* pElement = new CCDictElement(key.c_str(), pObject);
-    HASH_ADD_STR(_elements, _strKey, pElement);
-}
-
-void CCDictionary::setObjectUnSafe(CCObject* pObject, const intptr_t key)
-{
-    pObject->retain();
-    CCDictElement* pElement = new CCDictElement(key, pObject);
-    HASH_ADD_PTR(_elements, _intKey, pElement);
+    removeObjectForElememt(findElement(key));
 }
 
 void CCDictionary::removeObjectsForKeys(CCArray* pKeyArray)
@@ -313,23 +530,68 @@ void CCDictionary::removeObjectsForKeys(CCArray* pKeyArray)
 
 void CCDictionary::removeObjectForElememt(CCDictElement* pElement)
 {
-    if (pElement != NULL)
+    if (pElement == NULL)
     {
-        HASH_DEL(_elements, pElement);
-        pElement->_object->release();
-        CC_SAFE_DELETE(pElement);
+        return;
+    }
+
+    unsigned int mask = _slotCount - 1;
+    unsigned int i = hashOfElement(pElement) & mask;
+    while (_slots[i] != pElement)
+    {
+        i = (i + 1) & mask;
     }
+    // backward shift deletion, see releaseKey
+    for (unsigned int j = (i + 1) & mask; _slots[j]; j = (j + 1) & mask)
+    {
+        unsigned int home = hashOfElement(_slots[j]) & mask;
+        if (((j - home) & mask) >= ((j - i) & mask))
+        {
+            _slots[i] = _slots[j];
+            i = j;
+        }
+    }
+    _slots[i] = NULL;
+    --_count;
+
+    if (pElement->_prev)
+    {
+        pElement->_prev->_next = pElement->_next;
+    }
+    else
+    {
+        _elements = pElement->_next;
+    }
+    if (pElement->_next)
+    {
+        pElement->_next->_prev = pElement->_prev;
+    }
+    else
+    {
+        _lastElement = pElement->_prev;
+    }
+
+    pElement->_object->release();
+    CC_SAFE_DELETE(pElement);
 }
 
 void CCDictionary::removeAllObjects()
 {
-    CCDictElement *pElement, *tmp;
-    HASH_ITER(hh, _elements, pElement, tmp) 
+    // unlink everything first, releasing an object may use this dictionary
+    CCDictElement* pElement = _elements;
+    _elements = NULL;
+    _lastElement = NULL;
+    _count = 0;
+    free(_slots);
+    _slots = NULL;
+    _slotCount = 0;
+
+    while (pElement)
     {
-        HASH_DEL(_elements, pElement);
+        CCDictElement* pNext = pElement->_next;
         pElement->_object->release();
-        CC_SAFE_DELETE(pElement);
-
+        delete pElement;
+        pElement = pNext;
     }
 }
 
@@ -355,7 +617,7 @@ CCObject* CCDictionary::copyWithZone(CCZone* pZone)
         CCDICT_FOREACH(this, pElement)
         {
             pTmpObj = pElement->getObject()->copy();
-            pNewDict->setObject(pTmpObj, pElement->getStrKey());
+            pNewDict->setObject(pTmpObj, pElement->_strKey, internedKeyOf(pElement->_strKey)->length);
             pTmpObj->release();
         }
     }
@@ -370,20 +632,23 @@ CCObject* CCDictionary::randomObject()
         return NULL;
     }
     
-    CCObject* key = allKeys()->randomObject();
-    
-    if (_dictType == kCCDictInt)
+    if (_count == 0)
     {
-        return objectForKey(((CCInteger*)key)->getValue());
+        return NULL;
     }
-    else if (_dictType == kCCDictStr)
+
+    unsigned int index = (unsigned int)(CCRANDOM_0_1() * _count);
+    if (index >= _count)
     {
-        return objectForKey(((CCString*)key)->getCString());
+        index = _count - 1;
     }
-    else
+
+    CCDictElement* pElement = _elements;
+    while (index-- > 0)
     {
-        return NULL;
+        pElement = pElement->_next;
     }
+    return pElement->_object;
 }
 
 CCDictionary* CCDictionary::create()
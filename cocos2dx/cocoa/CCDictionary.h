@@ -25,7 +25,6 @@ THE SOFTWARE.
 #ifndef __CCDICTIONARY_H__
 #define __CCDICTIONARY_H__
 
-#include "support/data_support/uthash.h"
 #include "CCObject.h"
 #include "CCArray.h"
 #include "CCString.h"
@@ -65,7 +64,7 @@ private:
     /**
      *  Constructor of CCDictElement. It's only for internal usage. CCDictionary is its friend class.
      *  
-     *  @param  pszKey    The string key of this element.
+     *  @param  pszKey    The interned string key of this element.
      *  @param  pObject   The object of this element.
      */
     CCDictElement(const char* pszKey, CCObject* pObject);
@@ -95,7 +94,7 @@ public:
      */
     inline const char* getStrKey() const
     {
-        CCAssert(_strKey[0] != '\0', "Should not call this function for integer dictionary");
+        CCAssert(_strKey != NULL, "Should not call this function for integer dictionary");
         return _strKey;
     }
 
@@ -108,7 +107,7 @@ public:
      */
     inline intptr_t getIntKey() const
     {
-        CCAssert(_strKey[0] == '\0', "Should not call this function for string dictionary");
+        CCAssert(_strKey == NULL, "Should not call this function for string dictionary");
         return _intKey;
     }
     
@@ -120,27 +119,29 @@ public:
     inline CCObject* getObject() const { return _object; }
 
 private:
-    // The max length of string key.
-    #define   MAX_KEY_LEN   256
-    // char array is needed for HASH_ADD_STR in UT_HASH.
-    // So it's a pain that all elements will allocate 256 bytes for this array.
-    char      _strKey[MAX_KEY_LEN];     // hash key of string type
-    intptr_t  _intKey;       // hash key of integer type
-    CCObject* _object;    // hash value
+    // String keys are interned: the elements of all the dictionaries share one copy of
+    // every key, which also holds its length and hash.
+    const char* _strKey;    // key of string type, NULL for integer keys
+    intptr_t  _intKey;      // key of integer type
+    CCObject* _object;      // value
 public:
-    UT_hash_handle hh;      // makes this class hashable
+    // Links of the list of the elements in insertion order, used by CCDICT_FOREACH.
+    CCDictElement* _prev;
+    CCDictElement* _next;
     friend class CCDictionary; // declare CCDictionary as friend class
 };
 
 /** The macro for traversing dictionary
  *  
  *  @note It's faster than getting all keys and traversing keys to get objects by objectForKey.
- *        It's also safe to remove elements while traversing.
+ *        It's also safe to remove the current element while traversing.
  */
 #define CCDICT_FOREACH(__dict__, __el__) \
     CCDictElement* pTmp##__dict__##__el__ = NULL; \
     if (__dict__) \
-    HASH_ITER(hh, (__dict__)->_elements, __el__, pTmp##__dict__##__el__)
+    for (__el__ = (__dict__)->_elements, pTmp##__dict__##__el__ = __el__ ? __el__->_next : NULL; \
+         __el__ != NULL; \
+         __el__ = pTmp##__dict__##__el__, pTmp##__dict__##__el__ = __el__ ? __el__->_next : NULL)
 
 
 
@@ -167,6 +168,8 @@ public:
  *  CCLog("{ key3: %d }", pInteger->getValue());
  *  @endcode
  *
+ *  The elements are found through an open addressing hash table. String keys are interned
+ *  and keep their hash, so an element costs a few tens of bytes plus one shared copy of its key.
  */
 
 class CC_DLL CCDictionary : public CCObject
@@ -222,6 +225,13 @@ public:
      *  @see objectForKey(intptr_t)
      */
     CCObject* objectForKey(const std::string& key);
+
+    /**
+     *  Get the object according to a string key of the given length, which doesn't need to be null terminated.
+     *  @see objectForKey(const std::string&)
+     *  @since v3.0
+     */
+    CCObject* objectForKey(const char* key, unsigned int length);
     
     /**
      *  Get the object according to the specified integer key.
@@ -242,7 +252,7 @@ public:
      *  @see valueForKey(intptr_t)
      */
     const CCString* valueForKey(const std::string& key);
-    
+
     /** Get the value according to the specified integer key.
      *
      *  @note Be careful to use this function since it assumes the objects in the dictionary are CCString pointer.
@@ -265,6 +275,12 @@ public:
      *  @see setObject(CCObject*, intptr_t)
      */
     void setObject(CCObject* pObject, const std::string& key);
+
+    /** Insert an object to dictionary, and match it with a string key of the given length.
+     *  @see setObject(CCObject*, const std::string&)
+     *  @since v3.0
+     */
+    void setObject(CCObject* pObject, const char* key, unsigned int length);
     
     /** Insert an object to dictionary, and match it with the specified string key.
      *
@@ -387,20 +403,26 @@ public:
     virtual void acceptVisitor(CCDataVisitor &visitor);
 
 private:
-    /** 
-     *  For internal usage, invoked by setObject.
-     */
-    void setObjectUnSafe(CCObject* pObject, const std::string& key);
-    void setObjectUnSafe(CCObject* pObject, const intptr_t key);
-    
+    CCDictElement* findElement(const char* key, unsigned int length, unsigned int hash) const;
+    CCDictElement* findElement(intptr_t key) const;
+    /** Links a new element, which must not be in the dictionary yet. */
+    void addElement(CCDictElement* pElement, unsigned int hash);
+    void resizeSlots(unsigned int slotCount);
+    static unsigned int hashOfElement(const CCDictElement* pElement);
+
 public:
     /**
-     *  All the elements in dictionary.
+     *  The first element in insertion order.
      * 
-     *  @note For internal usage, we need to declare this member variable as public since it's used in UT_HASH.
+     *  @note For internal usage, we need to declare this member variable as public since it's used by CCDICT_FOREACH.
      */
     CCDictElement* _elements;
 private:
+    CCDictElement* _lastElement;
+    /** Open addressing table with linear probing, its size is a power of 2. */
+    CCDictElement** _slots;
+    unsigned int _slotCount;
+    unsigned int _count;
     
     /** The support type of dictionary, it's confirmed when setObject is invoked. */
     enum CCDictType
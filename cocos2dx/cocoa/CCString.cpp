@@ -1,5 +1,6 @@
 #include "CCString.h"
 #include "platform/CCFileUtils.h"
+#include "platform/CCFileView.h"
 #include "ccMacros.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -191,12 +192,13 @@ CCString* CCString::createWithFormat(const char* format, ...)
 
 CCString* CCString::createWithContentsOfFile(const char* pszFileName)
 {
-    unsigned long size = 0;
-    unsigned char* pData = 0;
     CCString* pRet = NULL;
-    pData = CCFileUtils::sharedFileUtils()->getFileData(pszFileName, "rb", &size);
-    pRet = CCString::createWithData(pData, size);
-    CC_SAFE_DELETE_ARRAY(pData);
+    CCFileView* pView = CCFileUtils::sharedFileUtils()->openFileView(pszFileName);
+    if (pView)
+    {
+        pRet = CCString::createWithData(pView->getBytes(), pView->getSize());
+        pView->release();
+    }
     return pRet;
 }
 
@@ -45,63 +45,69 @@ THE SOFTWARE.
 #include "shaders/CCGLProgram.h"
 #include "actions/CCActionCatmullRom.h"
 #include "support/CCPointExtension.h"
+#include "kazmath/GL/matrix.h"
 #include <string.h>
+#include <stddef.h>
 #include <cmath>
+#include <vector>
 
 NS_CC_BEGIN
 #ifndef M_PI
     #define M_PI       3.14159265358979323846
 #endif
 
+//
+// The primitives are not drawn right away: their vertices are transformed to
+// clip space with the current matrices and appended to a buffer with their
+// color, and the buffer is drawn by ccDrawFlush(). Consecutive primitives of
+// the same kind, line width and point size are drawn by a single draw call.
+//
+
+typedef struct _ccPrimitiveVertex
+{
+    GLfloat x, y, z, w;
+    ccColor4B color;
+} ccPrimitiveVertex;
+
+typedef struct _ccPrimitiveRun
+{
+    GLenum mode;
+    GLint first;
+    GLsizei count;
+    GLfloat lineWidth;
+    GLfloat pointSize;
+} ccPrimitiveRun;
+
 static bool s_bInitialized = false;
 static CCGLProgram* s_pShader = NULL;
-static int s_nColorLocation = -1;
+static int s_nMVPLocation = -1;
 static ccColor4F s_tColor = {1.0f,1.0f,1.0f,1.0f};
 static int s_nPointSizeLocation = -1;
 static GLfloat s_fPointSize = 1.0f;
 
-#ifdef EMSCRIPTEN
-static GLuint s_bufferObject = 0;
-static GLuint s_bufferSize = 0;
-
-static void setGLBufferData(void *buf, GLuint bufSize)
-{
-    if(s_bufferSize < bufSize)
-    {
-        if(s_bufferObject)
-        {
-            glDeleteBuffers(1, &s_bufferObject);
-        }
-        glGenBuffers(1, &s_bufferObject);
-        s_bufferSize = bufSize;
-
-        glBindBuffer(GL_ARRAY_BUFFER, s_bufferObject);
-        glBufferData(GL_ARRAY_BUFFER, bufSize, buf, GL_DYNAMIC_DRAW);
-    }
-    else
-    {
-        glBindBuffer(GL_ARRAY_BUFFER, s_bufferObject);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, bufSize, buf);
-    }
-}
-
-#endif // EMSCRIPTEN
+static GLuint s_uVBO = 0;
+static std::vector<ccPrimitiveVertex> s_vertices;
+static std::vector<ccPrimitiveRun> s_runs;
+static kmMat4 s_tMVP;
+static bool s_bFlushing = false;
 
 static void lazy_init( void )
 {
     if( ! s_bInitialized ) {
 
         //
-        // Position and 1 color passed as a uniform (to simulate glColor4ub )
+        // Position and color, point size passed as a uniform
         //
-        s_pShader = CCShaderCache::sharedShaderCache()->programForKey(kCCShader_Position_uColor);
+        s_pShader = CCShaderCache::sharedShaderCache()->programForKey(kCCShader_PositionColor_uPointSize);
         s_pShader->retain();
         
-        s_nColorLocation = glGetUniformLocation( s_pShader->getProgram(), "u_color");
+        s_nMVPLocation = glGetUniformLocation( s_pShader->getProgram(), kCCUniformMVPMatrix_s);
     CHECK_GL_ERROR_DEBUG();
         s_nPointSizeLocation = glGetUniformLocation( s_pShader->getProgram(), "u_pointSize");
     CHECK_GL_ERROR_DEBUG();
 
+        glGenBuffers(1, &s_uVBO);
+
         s_bInitialized = true;
     }
 }
@@ -109,121 +115,193 @@ static void lazy_init( void )
 // When switching from backround to foreground on android, we want the params to be initialized again
 void ccDrawInit()
 {
-    lazy_init();
+    // the GL objects died with the previous context, the shaders are not reloaded yet:
+    // initialize again on the next draw
+    CC_SAFE_RELEASE_NULL(s_pShader);
+    s_uVBO = 0;
+    s_vertices.clear();
+    s_runs.clear();
+    s_bInitialized = false;
 }
 
 void ccDrawFree()
 {
+    if (s_uVBO)
+    {
+        glDeleteBuffers(1, &s_uVBO);
+        s_uVBO = 0;
+    }
+    s_vertices.clear();
+    s_runs.clear();
 	CC_SAFE_RELEASE_NULL(s_pShader);
 	s_bInitialized = false;
 }
 
-void ccDrawPoint( const CCPoint& point )
+void ccDrawFlush()
 {
-    lazy_init();
+    if (s_vertices.empty() || s_bFlushing)
+    {
+        return;
+    }
+
+    // the state changes below would flush again
+    s_bFlushing = true;
 
-    ccVertex2F p;
-    p.x = point.x;
-    p.y = point.y;
+    // the vertices are already in clip space
+    kmMat4 identity;
+    kmMat4Identity(&identity);
 
-    ccGLEnableVertexAttribs( kCCVertexAttribFlag_Position );
+    ccGLEnableVertexAttribs( kCCVertexAttribFlag_Position | kCCVertexAttribFlag_Color );
     s_pShader->use();
-    s_pShader->setUniformsForBuiltins();
+    s_pShader->setUniformLocationWithMatrix4fv(s_nMVPLocation, identity.mat, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, s_uVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(ccPrimitiveVertex) * s_vertices.size(), &s_vertices[0], GL_STREAM_DRAW);
+    glVertexAttribPointer(kCCVertexAttrib_Position, 4, GL_FLOAT, GL_FALSE, sizeof(ccPrimitiveVertex), (GLvoid*) offsetof(ccPrimitiveVertex, x));
+    glVertexAttribPointer(kCCVertexAttrib_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ccPrimitiveVertex), (GLvoid*) offsetof(ccPrimitiveVertex, color));
+
+    // the width of the lines drawn by GL, see ccGLLineWidth
+    GLfloat currentLineWidth = ccGLGetLineWidth();
+    GLfloat lineWidth = currentLineWidth;
+    for (std::vector<ccPrimitiveRun>::const_iterator it = s_runs.begin(); it != s_runs.end(); ++it)
+    {
+        if (it->mode == GL_LINES)
+        {
+            if (it->lineWidth != lineWidth)
+            {
+                lineWidth = it->lineWidth;
+                glLineWidth(lineWidth);
+            }
+        }
+        else if (it->mode == GL_POINTS)
+        {
+            s_pShader->setUniformLocationWith1f(s_nPointSizeLocation, it->pointSize);
+        }
 
-    s_pShader->setUniformLocationWith4fv(s_nColorLocation, (GLfloat*) &s_tColor.r, 1);
-    s_pShader->setUniformLocationWith1f(s_nPointSizeLocation, s_fPointSize);
+        glDrawArrays(it->mode, it->first, it->count);
+        CC_INCREMENT_GL_DRAWS(1);
+    }
 
-#ifdef EMSCRIPTEN
-    setGLBufferData(&p, 8);
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, &p);
-#endif // EMSCRIPTEN
+    if (lineWidth != currentLineWidth)
+    {
+        glLineWidth(currentLineWidth);
+    }
 
-    glDrawArrays(GL_POINTS, 0, 1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    CHECK_GL_ERROR_DEBUG();
 
-    CC_INCREMENT_GL_DRAWS(1);
+    s_vertices.clear();
+    s_runs.clear();
+    s_bFlushing = false;
 }
 
-void ccDrawPoints( const CCPoint *points, unsigned int numberOfPoints )
+// Reserves the vertices of a primitive, they must be set with setVertex
+static ccPrimitiveVertex* beginPrimitive(GLenum mode, unsigned int numberOfVertices)
 {
     lazy_init();
 
-    ccGLEnableVertexAttribs( kCCVertexAttribFlag_Position );
-    s_pShader->use();
-    s_pShader->setUniformsForBuiltins();
-    s_pShader->setUniformLocationWith4fv(s_nColorLocation, (GLfloat*) &s_tColor.r, 1);
-    s_pShader->setUniformLocationWith1f(s_nPointSizeLocation, s_fPointSize);
+    GLfloat lineWidth = 0.0f;
+    GLfloat pointSize = 0.0f;
+    if (mode == GL_LINES)
+    {
+        lineWidth = ccGLGetLineWidth();
+    }
+    else if (mode == GL_POINTS)
+    {
+        pointSize = s_fPointSize;
+    }
 
-    // XXX: Mac OpenGL error. arrays can't go out of scope before draw is executed
-    ccVertex2F* newPoints = new ccVertex2F[numberOfPoints];
+    ccPrimitiveRun* run = s_runs.empty() ? NULL : &s_runs.back();
+    if (!run || run->mode != mode || run->lineWidth != lineWidth || run->pointSize != pointSize)
+    {
+        ccPrimitiveRun newRun = { mode, (GLint) s_vertices.size(), 0, lineWidth, pointSize };
+        s_runs.push_back(newRun);
+        run = &s_runs.back();
+    }
+    run->count += numberOfVertices;
 
-    // iPhone and 32-bit machines optimization
-    if( sizeof(CCPoint) == sizeof(ccVertex2F) )
+    kmMat4 projection, modelview;
+    kmGLGetMatrix(KM_GL_PROJECTION, &projection);
+    kmGLGetMatrix(KM_GL_MODELVIEW, &modelview);
+    kmMat4Multiply(&s_tMVP, &projection, &modelview);
+
+    size_t first = s_vertices.size();
+    s_vertices.resize(first + numberOfVertices);
+    return &s_vertices[first];
+}
+
+static inline void setVertex(ccPrimitiveVertex* vertex, GLfloat x, GLfloat y, const ccColor4B& color)
+{
+    const kmScalar* m = s_tMVP.mat;
+    vertex->x = m[0] * x + m[4] * y + m[12];
+    vertex->y = m[1] * x + m[5] * y + m[13];
+    vertex->z = m[2] * x + m[6] * y + m[14];
+    vertex->w = m[3] * x + m[7] * y + m[15];
+    vertex->color = color;
+}
+
+// Appends a line strip as separate segments, so strips can share a draw call
+template <typename T>
+static void appendLineStrip(const T* points, unsigned int numberOfPoints, bool closePolygon)
+{
+    if (numberOfPoints < 2)
     {
-#ifdef EMSCRIPTEN
-        setGLBufferData((void*) points, numberOfPoints * sizeof(CCPoint));
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, points);
-#endif // EMSCRIPTEN
+        return;
     }
-    else
+
+    unsigned int numberOfLines = closePolygon ? numberOfPoints : numberOfPoints - 1;
+    ccPrimitiveVertex* vertex = beginPrimitive(GL_LINES, numberOfLines * 2);
+    ccColor4B color = ccc4BFromccc4F(s_tColor);
+
+    for (unsigned int i = 0; i < numberOfLines; i++)
     {
-        // Mac on 64-bit
-        for( unsigned int i=0; i<numberOfPoints;i++) {
-            newPoints[i].x = points[i].x;
-            newPoints[i].y = points[i].y;
-        }
-#ifdef EMSCRIPTEN
-        // Suspect Emscripten won't be emitting 64-bit code for a while yet,
-        // but want to make sure this continues to work even if they do.
-        setGLBufferData(newPoints, numberOfPoints * sizeof(ccVertex2F));
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, newPoints);
-#endif // EMSCRIPTEN
+        const T& from = points[i];
+        const T& to = points[(i + 1) % numberOfPoints];
+        setVertex(vertex++, from.x, from.y, color);
+        setVertex(vertex++, to.x, to.y, color);
     }
+}
 
-    glDrawArrays(GL_POINTS, 0, (GLsizei) numberOfPoints);
+void ccDrawPoint( const CCPoint& point )
+{
+    ccPrimitiveVertex* vertex = beginPrimitive(GL_POINTS, 1);
+    setVertex(vertex, point.x, point.y, ccc4BFromccc4F(s_tColor));
+}
 
-    CC_SAFE_DELETE_ARRAY(newPoints);
+void ccDrawPoints( const CCPoint *points, unsigned int numberOfPoints )
+{
+    if (numberOfPoints == 0)
+    {
+        return;
+    }
 
-    CC_INCREMENT_GL_DRAWS(1);
+    ccPrimitiveVertex* vertex = beginPrimitive(GL_POINTS, numberOfPoints);
+    ccColor4B color = ccc4BFromccc4F(s_tColor);
+    for (unsigned int i = 0; i < numberOfPoints; i++)
+    {
+        setVertex(vertex++, points[i].x, points[i].y, color);
+    }
 }
 
 
 void ccDrawLine( const CCPoint& origin, const CCPoint& destination )
 {
-    lazy_init();
-
-    ccVertex2F vertices[2] = {
-        {origin.x, origin.y},
-        {destination.x, destination.y}
-    };
-
-    s_pShader->use();
-    s_pShader->setUniformsForBuiltins();
-    s_pShader->setUniformLocationWith4fv(s_nColorLocation, (GLfloat*) &s_tColor.r, 1);
-
-    ccGLEnableVertexAttribs( kCCVertexAttribFlag_Position );
-#ifdef EMSCRIPTEN
-    setGLBufferData(vertices, 16);
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, vertices);
-#endif // EMSCRIPTEN
-    glDrawArrays(GL_LINES, 0, 2);
-
-    CC_INCREMENT_GL_DRAWS(1);
+    ccPrimitiveVertex* vertex = beginPrimitive(GL_LINES, 2);
+    ccColor4B color = ccc4BFromccc4F(s_tColor);
+    setVertex(vertex, origin.x, origin.y, color);
+    setVertex(vertex + 1, destination.x, destination.y, color);
 }
 
 void ccDrawRect( CCPoint origin, CCPoint destination )
 {
-    ccDrawLine(CCPointMake(origin.x, origin.y), CCPointMake(destination.x, origin.y));
-    ccDrawLine(CCPointMake(destination.x, origin.y), CCPointMake(destination.x, destination.y));
-    ccDrawLine(CCPointMake(destination.x, destination.y), CCPointMake(origin.x, destination.y));
-    ccDrawLine(CCPointMake(origin.x, destination.y), CCPointMake(origin.x, origin.y));
+    CCPoint vertices[] = {
+        origin,
+        ccp(destination.x, origin.y),
+        destination,
+        ccp(origin.x, destination.y)
+    };
+
+    appendLineStrip(vertices, 4, true);
 }
 
 void ccDrawSolidRect( CCPoint origin, CCPoint destination, ccColor4F color )
@@ -240,142 +318,50 @@ void ccDrawSolidRect( CCPoint origin, CCPoint destination, ccColor4F color )
 
 void ccDrawPoly( const CCPoint *poli, unsigned int numberOfPoints, bool closePolygon )
 {
-    lazy_init();
-
-    s_pShader->use();
-    s_pShader->setUniformsForBuiltins();
-    s_pShader->setUniformLocationWith4fv(s_nColorLocation, (GLfloat*) &s_tColor.r, 1);
-
-    ccGLEnableVertexAttribs( kCCVertexAttribFlag_Position );
-
-    // iPhone and 32-bit machines optimization
-    if( sizeof(CCPoint) == sizeof(ccVertex2F) )
-    {
-#ifdef EMSCRIPTEN
-        setGLBufferData((void*) poli, numberOfPoints * sizeof(CCPoint));
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, poli);
-#endif // EMSCRIPTEN
-
-        if( closePolygon )
-            glDrawArrays(GL_LINE_LOOP, 0, (GLsizei) numberOfPoints);
-        else
-            glDrawArrays(GL_LINE_STRIP, 0, (GLsizei) numberOfPoints);
-    }
-    else
-    {
-        // Mac on 64-bit
-        // XXX: Mac OpenGL error. arrays can't go out of scope before draw is executed
-        ccVertex2F* newPoli = new ccVertex2F[numberOfPoints];
-        for( unsigned int i=0; i<numberOfPoints;i++) {
-            newPoli[i].x = poli[i].x;
-            newPoli[i].y = poli[i].y;
-        }
-#ifdef EMSCRIPTEN
-        setGLBufferData(newPoli, numberOfPoints * sizeof(ccVertex2F));
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, newPoli);
-#endif // EMSCRIPTEN
-
-        if( closePolygon )
-            glDrawArrays(GL_LINE_LOOP, 0, (GLsizei) numberOfPoints);
-        else
-            glDrawArrays(GL_LINE_STRIP, 0, (GLsizei) numberOfPoints);
-
-        CC_SAFE_DELETE_ARRAY(newPoli);
-    }
-
-    CC_INCREMENT_GL_DRAWS(1);
+    appendLineStrip(poli, numberOfPoints, closePolygon);
 }
 
 void ccDrawSolidPoly( const CCPoint *poli, unsigned int numberOfPoints, ccColor4F color )
 {
-    lazy_init();
-
-    s_pShader->use();
-    s_pShader->setUniformsForBuiltins();
-    s_pShader->setUniformLocationWith4fv(s_nColorLocation, (GLfloat*) &color.r, 1);
-
-    ccGLEnableVertexAttribs( kCCVertexAttribFlag_Position );
-
-    // XXX: Mac OpenGL error. arrays can't go out of scope before draw is executed
-    ccVertex2F* newPoli = new ccVertex2F[numberOfPoints];
-
-    // iPhone and 32-bit machines optimization
-    if( sizeof(CCPoint) == sizeof(ccVertex2F) )
+    if (numberOfPoints < 3)
     {
-#ifdef EMSCRIPTEN
-        setGLBufferData((void*) poli, numberOfPoints * sizeof(CCPoint));
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, poli);
-#endif // EMSCRIPTEN
+        return;
     }
-    else
+
+    // the triangle fan becomes a list of triangles
+    ccPrimitiveVertex* vertex = beginPrimitive(GL_TRIANGLES, (numberOfPoints - 2) * 3);
+    ccColor4B color4B = ccc4BFromccc4F(color);
+    for (unsigned int i = 1; i + 1 < numberOfPoints; i++)
     {
-        // Mac on 64-bit
-        for( unsigned int i=0; i<numberOfPoints;i++)
-        {
-            newPoli[i] = vertex2( poli[i].x, poli[i].y );
-        }
-#ifdef EMSCRIPTEN
-        setGLBufferData(newPoli, numberOfPoints * sizeof(ccVertex2F));
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-        glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, newPoli);
-#endif // EMSCRIPTEN
-    }    
-
-    glDrawArrays(GL_TRIANGLE_FAN, 0, (GLsizei) numberOfPoints);
-
-    CC_SAFE_DELETE_ARRAY(newPoli);
-    CC_INCREMENT_GL_DRAWS(1);
+        setVertex(vertex++, poli[0].x, poli[0].y, color4B);
+        setVertex(vertex++, poli[i].x, poli[i].y, color4B);
+        setVertex(vertex++, poli[i + 1].x, poli[i + 1].y, color4B);
+    }
 }
 
 void ccDrawCircle( const CCPoint& center, float radius, float angle, unsigned int segments, bool drawLineToCenter, float scaleX, float scaleY)
 {
-    lazy_init();
-
     int additionalSegment = 1;
     if (drawLineToCenter)
         additionalSegment++;
 
     const float coef = 2.0f * (float)M_PI/segments;
 
-    GLfloat *vertices = (GLfloat*)calloc( sizeof(GLfloat)*2*(segments+2), 1);
+    ccVertex2F *vertices = (ccVertex2F*)calloc( sizeof(ccVertex2F)*(segments+2), 1);
     if( ! vertices )
         return;
 
     for(unsigned int i = 0;i <= segments; i++) {
         float rads = i*coef;
-        GLfloat j = radius * cosf(rads + angle) * scaleX + center.x;
-        GLfloat k = radius * sinf(rads + angle) * scaleY + center.y;
-
-        vertices[i*2] = j;
-        vertices[i*2+1] = k;
+        vertices[i].x = radius * cosf(rads + angle) * scaleX + center.x;
+        vertices[i].y = radius * sinf(rads + angle) * scaleY + center.y;
     }
-    vertices[(segments+1)*2] = center.x;
-    vertices[(segments+1)*2+1] = center.y;
+    vertices[segments+1].x = center.x;
+    vertices[segments+1].y = center.y;
 
-    s_pShader->use();
-    s_pShader->setUniformsForBuiltins();
-    s_pShader->setUniformLocationWith4fv(s_nColorLocation, (GLfloat*) &s_tColor.r, 1);
-
-    ccGLEnableVertexAttribs( kCCVertexAttribFlag_Position );
-
-#ifdef EMSCRIPTEN
-    setGLBufferData(vertices, sizeof(GLfloat)*2*(segments+2));
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, vertices);
-#endif // EMSCRIPTEN
-    glDrawArrays(GL_LINE_STRIP, 0, (GLsizei) segments+additionalSegment);
+    appendLineStrip(vertices, segments+additionalSegment, false);
 
     free( vertices );
-
-    CC_INCREMENT_GL_DRAWS(1);
 }
 
 void CC_DLL ccDrawCircle( const CCPoint& center, float radius, float angle, unsigned int segments, bool drawLineToCenter)
@@ -385,8 +371,6 @@ void CC_DLL ccDrawCircle( const CCPoint& center, float radius, float angle, unsi
 
 void ccDrawQuadBezier(const CCPoint& origin, const CCPoint& control, const CCPoint& destination, unsigned int segments)
 {
-    lazy_init();
-
     ccVertex2F* vertices = new ccVertex2F[segments + 1];
 
     float t = 0.0f;
@@ -399,22 +383,9 @@ void ccDrawQuadBezier(const CCPoint& origin, const CCPoint& control, const CCPoi
     vertices[segments].x = destination.x;
     vertices[segments].y = destination.y;
 
-    s_pShader->use();
-    s_pShader->setUniformsForBuiltins();
-    s_pShader->setUniformLocationWith4fv(s_nColorLocation, (GLfloat*) &s_tColor.r, 1);
-
-    ccGLEnableVertexAttribs( kCCVertexAttribFlag_Position );
-
-#ifdef EMSCRIPTEN
-    setGLBufferData(vertices, (segments + 1) * sizeof(ccVertex2F));
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, vertices);
-#endif // EMSCRIPTEN
-    glDrawArrays(GL_LINE_STRIP, 0, (GLsizei) segments + 1);
-    CC_SAFE_DELETE_ARRAY(vertices);
+    appendLineStrip(vertices, segments + 1, false);
 
-    CC_INCREMENT_GL_DRAWS(1);
+    CC_SAFE_DELETE_ARRAY(vertices);
 }
 
 void ccDrawCatmullRom( CCPointArray *points, unsigned int segments )
@@ -424,8 +395,6 @@ void ccDrawCatmullRom( CCPointArray *points, unsigned int segments )
 
 void ccDrawCardinalSpline( CCPointArray *config, float tension,  unsigned int segments )
 {
-    lazy_init();
-
     ccVertex2F* vertices = new ccVertex2F[segments + 1];
 
     unsigned int p;
@@ -456,28 +425,13 @@ void ccDrawCardinalSpline( CCPointArray *config, float tension,  unsigned int se
         vertices[i].y = newPos.y;
     }
 
-    s_pShader->use();
-    s_pShader->setUniformsForBuiltins();
-    s_pShader->setUniformLocationWith4fv(s_nColorLocation, (GLfloat*)&s_tColor.r, 1);
-
-    ccGLEnableVertexAttribs( kCCVertexAttribFlag_Position );
-
-#ifdef EMSCRIPTEN
-    setGLBufferData(vertices, (segments + 1) * sizeof(ccVertex2F));
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, vertices);
-#endif // EMSCRIPTEN
-    glDrawArrays(GL_LINE_STRIP, 0, (GLsizei) segments + 1);
+    appendLineStrip(vertices, segments + 1, false);
 
     CC_SAFE_DELETE_ARRAY(vertices);
-    CC_INCREMENT_GL_DRAWS(1);
 }
 
 void ccDrawCubicBezier(const CCPoint& origin, const CCPoint& control1, const CCPoint& control2, const CCPoint& destination, unsigned int segments)
 {
-    lazy_init();
-
     ccVertex2F* vertices = new ccVertex2F[segments + 1];
 
     float t = 0;
@@ -490,22 +444,9 @@ void ccDrawCubicBezier(const CCPoint& origin, const CCPoint& control1, const CCP
     vertices[segments].x = destination.x;
     vertices[segments].y = destination.y;
 
-    s_pShader->use();
-    s_pShader->setUniformsForBuiltins();
-    s_pShader->setUniformLocationWith4fv(s_nColorLocation, (GLfloat*) &s_tColor.r, 1);
-
-    ccGLEnableVertexAttribs( kCCVertexAttribFlag_Position );
-
-#ifdef EMSCRIPTEN
-    setGLBufferData(vertices, (segments + 1) * sizeof(ccVertex2F));
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, 0);
-#else
-    glVertexAttribPointer(kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, 0, vertices);
-#endif // EMSCRIPTEN
-    glDrawArrays(GL_LINE_STRIP, 0, (GLsizei) segments + 1);
-    CC_SAFE_DELETE_ARRAY(vertices);
+    appendLineStrip(vertices, segments + 1, false);
 
-    CC_INCREMENT_GL_DRAWS(1);
+    CC_SAFE_DELETE_ARRAY(vertices);
 }
 
 void ccDrawColor4F( GLfloat r, GLfloat g, GLfloat b, GLfloat a )
@@ -60,9 +60,17 @@ THE SOFTWARE.
  You can change the color, point size, width by calling:
  - ccDrawColor4B(), ccDrawColor4F()
  - ccPointSize()
- - glLineWidth()
+ - ccGLLineWidth()
+
+ Each primitive is drawn with the line width of the state cache when it was appended, a width set
+ directly with glLineWidth() isn't seen while CC_ENABLE_GL_STATE_CACHE is enabled.
  
- @warning These functions draws the Line, Point, Polygon, immediately. They aren't batched. If you are going to make a game that depends on these primitives, I suggest creating a batch. Instead you should use CCDrawNode
+ The primitives are batched: they are appended to a buffer and drawn by ccDrawFlush(), which is called
+ after the draw() of every node, before a different shader program, blend function or vertex attributes are
+ set through ccGLStateCache, and when the render target changes. Call ccDrawFlush() yourself before issuing
+ other GL commands after drawing primitives in the same draw().
+
+ @warning If you are going to make a game that depends on these primitives, I suggest using CCDrawNode instead
  
  */
 
@@ -81,6 +89,11 @@ void CC_DLL ccDrawInit();
 /** Frees allocated resources by the drawing primitives */
 void CC_DLL ccDrawFree();
 
+/** Draws the primitives appended since the last flush.
+ @since v3.0
+ */
+void CC_DLL ccDrawFlush();
+
 /** draws a point given x and y coordinate measured in points */
 void CC_DLL ccDrawPoint( const CCPoint& point );
 
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "ccMacros.h"
 #include "textures/CCTexture2D.h"
 #include "platform/platform.h"
+#include "draw_nodes/CCDrawingPrimitives.h"
 
 NS_CC_BEGIN
 
@@ -63,6 +64,9 @@ void CCGrabber::beforeRender(CCTexture2D *pTexture)
 {
     CC_UNUSED_PARAM(pTexture);
 
+    // the pending primitives belong to the previous render target
+    ccDrawFlush();
+
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_oldFBO);
     glBindFramebuffer(GL_FRAMEBUFFER, _FBO);
     
@@ -85,6 +89,8 @@ void CCGrabber::afterRender(cocos2d::CCTexture2D *pTexture)
 {
     CC_UNUSED_PARAM(pTexture);
 
+    ccDrawFlush();
+
     glBindFramebuffer(GL_FRAMEBUFFER, _oldFBO);
 //  glColorMask(true, true, true, true);    // #631
     
@@ -33,10 +33,64 @@ THE SOFTWARE.
 #include "CCGL.h"
 #include "support/CCPointExtension.h"
 #include "support/TransformUtils.h"
+#include "support/CCNotificationCenter.h"
+#include "CCEventType.h"
 #include "kazmath/kazmath.h"
 #include "kazmath/GL/matrix.h"
 
 NS_CC_BEGIN
+
+// Grids keep their vertices in three buffer objects: the positions, which are streamed
+// whenever an effect changed them, and the texture coordinates and indices, which only
+// change in calculateVertexPoints.
+
+static void setupGridBuffers(GLuint *buffers, const GLvoid *vertices, GLsizeiptr verticesSize,
+                             const GLvoid *texCoordinates, GLsizeiptr texCoordinatesSize,
+                             const GLushort *indices, GLsizeiptr indicesSize)
+{
+    if (! buffers[0])
+    {
+        glGenBuffers(3, buffers);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    glBufferData(GL_ARRAY_BUFFER, verticesSize, vertices, GL_STREAM_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[1]);
+    glBufferData(GL_ARRAY_BUFFER, texCoordinatesSize, texCoordinates, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // don't change the element buffer of a bound VAO
+    ccGLBindVAO(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[2]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesSize, indices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    CHECK_GL_ERROR_DEBUG();
+}
+
+static void drawGridBuffers(const GLuint *buffers, const GLvoid *vertices, GLsizeiptr verticesSize, bool upload,
+                            GLsizei indexCount)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    if (upload)
+    {
+        // a new store instead of glBufferSubData, the previous one may still be in use by the GPU
+        glBufferData(GL_ARRAY_BUFFER, verticesSize, vertices, GL_STREAM_DRAW);
+    }
+    glVertexAttribPointer(kCCVertexAttrib_Position, 3, GL_FLOAT, GL_FALSE, 0, 0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[1]);
+    glVertexAttribPointer(kCCVertexAttrib_TexCoords, 2, GL_FLOAT, GL_FALSE, 0, 0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[2]);
+    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, 0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    CHECK_GL_ERROR_DEBUG();
+}
 // implementation of CCGridBase
 
 CCGridBase* CCGridBase::create(const CCSize& gridSize)
@@ -300,8 +354,14 @@ CCGrid3D::CCGrid3D()
     , _vertices(NULL)
     , _originalVertices(NULL)
     , _indices(NULL)
+    , _dirty(false)
 {
+    memset(_buffersVBO, 0, sizeof(_buffersVBO));
 
+    CCNotificationCenter::sharedNotificationCenter()->addObserver(this,
+                                                                  callfuncO_selector(CCGrid3D::listenBackToForeground),
+                                                                  EVNET_COME_TO_FOREGROUND,
+                                                                  NULL);
 }
 
 CCGrid3D::~CCGrid3D(void)
@@ -310,6 +370,9 @@ CCGrid3D::~CCGrid3D(void)
     CC_SAFE_FREE(_vertices);
     CC_SAFE_FREE(_indices);
     CC_SAFE_FREE(_originalVertices);
+    glDeleteBuffers(3, _buffersVBO);
+
+    CCNotificationCenter::sharedNotificationCenter()->removeObserver(this, EVNET_COME_TO_FOREGROUND);
 }
 
 void CCGrid3D::blit(void)
@@ -320,33 +383,29 @@ void CCGrid3D::blit(void)
     _shaderProgram->use();
     _shaderProgram->setUniformsForBuiltins();;
 
-    //
-    // Attributes
-    //
-#ifdef EMSCRIPTEN
-    // Size calculations from calculateVertexPoints().
-    unsigned int numOfPoints = (_gridSize.width+1) * (_gridSize.height+1);
+    drawGridBuffers(_buffersVBO, _vertices, getVertexCount() * sizeof(ccVertex3F), _dirty, (GLsizei) n*6);
+    _dirty = false;
 
-    // position
-    setGLBufferData(_vertices, numOfPoints * sizeof(ccVertex3F), 0);
-    glVertexAttribPointer(kCCVertexAttrib_Position, 3, GL_FLOAT, GL_FALSE, 0, 0);
-
-    // texCoords
-    setGLBufferData(_texCoordinates, numOfPoints * sizeof(ccVertex2F), 1);
-    glVertexAttribPointer(kCCVertexAttrib_TexCoords, 2, GL_FLOAT, GL_FALSE, 0, 0);
+    CC_INCREMENT_GL_DRAWS(1);
+}
 
-    setGLIndexData(_indices, n * 12, 0);
-    glDrawElements(GL_TRIANGLES, (GLsizei) n*6, GL_UNSIGNED_SHORT, 0);
-#else
-    // position
-    glVertexAttribPointer(kCCVertexAttrib_Position, 3, GL_FLOAT, GL_FALSE, 0, _vertices);
+void CCGrid3D::setupVBO(void)
+{
+    unsigned int numOfPoints = getVertexCount();
 
-    // texCoords
-    glVertexAttribPointer(kCCVertexAttrib_TexCoords, 2, GL_FLOAT, GL_FALSE, 0, _texCoordinates);
+    setupGridBuffers(_buffersVBO, _vertices, numOfPoints * sizeof(ccVertex3F), _texCoordinates, numOfPoints * sizeof(ccVertex2F),
+                     _indices, _gridSize.width * _gridSize.height * sizeof(GLushort) * 6);
+    _dirty = false;
+}
 
-    glDrawElements(GL_TRIANGLES, (GLsizei) n*6, GL_UNSIGNED_SHORT, _indices);
-#endif // EMSCRIPTEN
-    CC_INCREMENT_GL_DRAWS(1);
+void CCGrid3D::listenBackToForeground(CCObject *obj)
+{
+    // the buffers died with the previous context
+    memset(_buffersVBO, 0, sizeof(_buffersVBO));
+    if (_vertices)
+    {
+        setupVBO();
+    }
 }
 
 void CCGrid3D::calculateVertexPoints(void)
@@ -362,6 +421,7 @@ void CCGrid3D::calculateVertexPoints(void)
     CC_SAFE_FREE(_indices);
 
     unsigned int numOfPoints = (_gridSize.width+1) * (_gridSize.height+1);
+    CCAssert(numOfPoints <= 65536, "CCGrid3D: too many vertices for 16 bit indices");
 
     _vertices = malloc(numOfPoints * sizeof(ccVertex3F));
     _originalVertices = malloc(numOfPoints * sizeof(ccVertex3F));
@@ -423,6 +483,8 @@ void CCGrid3D::calculateVertexPoints(void)
     }
 
     memcpy(_originalVertices, _vertices, (_gridSize.width+1) * (_gridSize.height+1) * sizeof(ccVertex3F));
+
+    setupVBO();
 }
 
 ccVertex3F CCGrid3D::vertex(const CCPoint& pos)
@@ -457,6 +519,13 @@ void CCGrid3D::setVertex(const CCPoint& pos, const ccVertex3F& vertex)
     vertArray[index] = vertex.x;
     vertArray[index+1] = vertex.y;
     vertArray[index+2] = vertex.z;
+    _dirty = true;
+}
+
+ccVertex3F* CCGrid3D::getVertices(void)
+{
+    _dirty = true;
+    return (ccVertex3F*)_vertices;
 }
 
 void CCGrid3D::reuse(void)
@@ -475,8 +544,14 @@ CCTiledGrid3D::CCTiledGrid3D()
     , _vertices(NULL)
     , _originalVertices(NULL)
     , _indices(NULL)
+    , _dirty(false)
 {
+    memset(_buffersVBO, 0, sizeof(_buffersVBO));
 
+    CCNotificationCenter::sharedNotificationCenter()->addObserver(this,
+                                                                  callfuncO_selector(CCTiledGrid3D::listenBackToForeground),
+                                                                  EVNET_COME_TO_FOREGROUND,
+                                                                  NULL);
 }
 
 CCTiledGrid3D::~CCTiledGrid3D(void)
@@ -485,6 +560,9 @@ CCTiledGrid3D::~CCTiledGrid3D(void)
     CC_SAFE_FREE(_vertices);
     CC_SAFE_FREE(_originalVertices);
     CC_SAFE_FREE(_indices);
+    glDeleteBuffers(3, _buffersVBO);
+
+    CCNotificationCenter::sharedNotificationCenter()->removeObserver(this, EVNET_COME_TO_FOREGROUND);
 }
 
 CCTiledGrid3D* CCTiledGrid3D::create(const CCSize& gridSize, CCTexture2D *pTexture, bool bFlipped)
@@ -539,31 +617,30 @@ void CCTiledGrid3D::blit(void)
     // Attributes
     //
     ccGLEnableVertexAttribs( kCCVertexAttribFlag_Position | kCCVertexAttribFlag_TexCoords );
-#ifdef EMSCRIPTEN
-    int numQuads = _gridSize.width * _gridSize.height;
-
-    // position
-    setGLBufferData(_vertices, (numQuads*4*sizeof(ccVertex3F)), 0);
-    glVertexAttribPointer(kCCVertexAttrib_Position, 3, GL_FLOAT, GL_FALSE, 0, 0);
 
-    // texCoords
-    setGLBufferData(_texCoordinates, (numQuads*4*sizeof(ccVertex2F)), 1);
-    glVertexAttribPointer(kCCVertexAttrib_TexCoords, 2, GL_FLOAT, GL_FALSE, 0, 0);
-
-    setGLIndexData(_indices, n * 12, 0);
-    glDrawElements(GL_TRIANGLES, (GLsizei) n*6, GL_UNSIGNED_SHORT, 0);
-#else
-    // position
-    glVertexAttribPointer(kCCVertexAttrib_Position, 3, GL_FLOAT, GL_FALSE, 0, _vertices);
+    drawGridBuffers(_buffersVBO, _vertices, n * sizeof(ccQuad3), _dirty, (GLsizei)n*6);
+    _dirty = false;
 
-    // texCoords
-    glVertexAttribPointer(kCCVertexAttrib_TexCoords, 2, GL_FLOAT, GL_FALSE, 0, _texCoordinates);
+    CC_INCREMENT_GL_DRAWS(1);
+}
 
-    glDrawElements(GL_TRIANGLES, (GLsizei)n*6, GL_UNSIGNED_SHORT, _indices);
-#endif // EMSCRIPTEN
+void CCTiledGrid3D::setupVBO(void)
+{
+    int numQuads = _gridSize.width * _gridSize.height;
 
+    setupGridBuffers(_buffersVBO, _vertices, numQuads*4*sizeof(ccVertex3F), _texCoordinates, numQuads*4*sizeof(ccVertex2F),
+                     _indices, numQuads*6*sizeof(GLushort));
+    _dirty = false;
+}
 
-    CC_INCREMENT_GL_DRAWS(1);
+void CCTiledGrid3D::listenBackToForeground(CCObject *obj)
+{
+    // the buffers died with the previous context
+    memset(_buffersVBO, 0, sizeof(_buffersVBO));
+    if (_vertices)
+    {
+        setupVBO();
+    }
 }
 
 void CCTiledGrid3D::calculateVertexPoints(void)
@@ -573,6 +650,7 @@ void CCTiledGrid3D::calculateVertexPoints(void)
     float imageH = _texture->getContentSizeInPixels().height;
     
     int numQuads = _gridSize.width * _gridSize.height;
+    CCAssert(numQuads * 4 <= 65536, "CCTiledGrid3D: too many vertices for 16 bit indices");
     CC_SAFE_FREE(_vertices);
     CC_SAFE_FREE(_originalVertices);
     CC_SAFE_FREE(_texCoordinates);
@@ -643,6 +721,8 @@ void CCTiledGrid3D::calculateVertexPoints(void)
     }
     
     memcpy(_originalVertices, _vertices, numQuads * 12 * sizeof(GLfloat));
+
+    setupVBO();
 }
 
 void CCTiledGrid3D::setTile(const CCPoint& pos, const ccQuad3& coords)
@@ -651,6 +731,13 @@ void CCTiledGrid3D::setTile(const CCPoint& pos, const ccQuad3& coords)
     int idx = (_gridSize.height * pos.x + pos.y) * 4 * 3;
     float *vertArray = (float*)_vertices;
     memcpy(&vertArray[idx], &coords, sizeof(ccQuad3));
+    _dirty = true;
+}
+
+ccQuad3* CCTiledGrid3D::getTiles(void)
+{
+    _dirty = true;
+    return (ccQuad3*)_vertices;
 }
 
 ccQuad3 CCTiledGrid3D::originalTile(const CCPoint& pos)
@@ -32,9 +32,6 @@ THE SOFTWARE.
 #include "textures/CCTexture2D.h"
 #include "CCDirector.h"
 #include "kazmath/mat4.h"
-#ifdef EMSCRIPTEN
-#include "base_nodes/CCGLBufferedNode.h"
-#endif // EMSCRIPTEN
 
 NS_CC_BEGIN
 
@@ -108,9 +105,6 @@ protected:
  CCGrid3D is a 3D grid implementation. Each vertex has 3 dimensions: x,y,z
  */
 class CC_DLL CCGrid3D : public CCGridBase
-#ifdef EMSCRIPTEN
-, public CCGLBufferedNode
-#endif // EMSCRIPTEN
 {
 public:
     CCGrid3D();
@@ -123,10 +117,28 @@ public:
     /** sets a new vertex at a given position */
     void setVertex(const CCPoint& pos, const ccVertex3F& vertex);
 
+    /** returns the vertices, column by column: the vertex (x, y) is at x * (gridSize.height + 1) + y.
+     Effects that move the whole grid write them directly instead of calling setVertex.
+     The vertices are uploaded again on the next blit.
+     @since v3.0
+     */
+    ccVertex3F* getVertices(void);
+    /** returns the original (non-transformed) vertices, in the same order as getVertices
+     @since v3.0
+     */
+    inline const ccVertex3F* getOriginalVertices(void) { return (const ccVertex3F*)_originalVertices; }
+    /** number of vertices: (gridSize.width + 1) * (gridSize.height + 1)
+     @since v3.0
+     */
+    inline unsigned int getVertexCount(void) { return (unsigned int)((_gridSize.width + 1) * (_gridSize.height + 1)); }
+
     virtual void blit(void);
     virtual void reuse(void);
     virtual void calculateVertexPoints(void);
 
+    /** recreates the vertex buffers when the GL context was lost */
+    void listenBackToForeground(CCObject *obj);
+
 public:
     /** create one Grid */
     static CCGrid3D* create(const CCSize& gridSize, CCTexture2D *pTexture, bool bFlipped);
@@ -134,10 +146,16 @@ public:
     static CCGrid3D* create(const CCSize& gridSize);
     
 protected:
+    void setupVBO(void);
+
     GLvoid *_texCoordinates;
     GLvoid *_vertices;
     GLvoid *_originalVertices;
     GLushort *_indices;
+    // positions, texture coordinates and indices
+    GLuint _buffersVBO[3];
+    // the positions changed since they were uploaded
+    bool _dirty;
 };
 
 /**
@@ -145,9 +163,6 @@ protected:
  the tiles can be separated from the grid.
 */
 class CC_DLL CCTiledGrid3D : public CCGridBase
-#ifdef EMSCRIPTEN
-, public CCGLBufferedNode
-#endif // EMSCRIPTEN
 {
 public:
     CCTiledGrid3D();
@@ -160,10 +175,28 @@ public:
     /** sets a new tile */
     void setTile(const CCPoint& pos, const ccQuad3& coords);
 
+    /** returns the tiles, column by column: the tile (x, y) is at x * gridSize.height + y.
+     Effects that move the whole grid write them directly instead of calling setTile.
+     The tiles are uploaded again on the next blit.
+     @since v3.0
+     */
+    ccQuad3* getTiles(void);
+    /** returns the original (untransformed) tiles, in the same order as getTiles
+     @since v3.0
+     */
+    inline const ccQuad3* getOriginalTiles(void) { return (const ccQuad3*)_originalVertices; }
+    /** number of tiles: gridSize.width * gridSize.height
+     @since v3.0
+     */
+    inline unsigned int getTileCount(void) { return (unsigned int)(_gridSize.width * _gridSize.height); }
+
     virtual void blit(void);
     virtual void reuse(void);
     virtual void calculateVertexPoints(void);
 
+    /** recreates the vertex buffers when the GL context was lost */
+    void listenBackToForeground(CCObject *obj);
+
 public:
 
     /** create one Grid */
@@ -172,10 +205,16 @@ public:
     static CCTiledGrid3D* create(const CCSize& gridSize);
     
 protected:
+    void setupVBO(void);
+
     GLvoid *_texCoordinates;
     GLvoid *_vertices;
     GLvoid *_originalVertices;
     GLushort *_indices;
+    // positions, texture coordinates and indices
+    GLuint _buffersVBO[3];
+    // the positions changed since they were uploaded
+    bool _dirty;
 };
 
 // end of effects group
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #ifndef __CCTYPES_H__
 #define __CCTYPES_H__
 
+#include <stddef.h>
 #include <string>
 #include "cocoa/CCGeometry.h"
 #include "CCGL.h"
@@ -127,6 +127,7 @@ THE SOFTWARE.
 #include "platform/CCDevice.h"
 #include "platform/CCCommon.h"
 #include "platform/CCFileUtils.h"
+#include "platform/CCFileView.h"
 #include "platform/CCImage.h"
 #include "platform/CCSAXParser.h"
 #include "platform/CCThread.h"
@@ -240,6 +241,7 @@ THE SOFTWARE.
 #include "support/CCProfiling.h"
 #include "support/user_default/CCUserDefault.h"
 #include "support/CCVertex.h"
+#include "support/image_support/CCImageEncoder.h"
 #include "support/tinyxml2/tinyxml2.h"
 
 // text_input_node
@@ -53,6 +53,10 @@ void CC_DLL kmGLRotatef(float angle, float x, float y, float z);
 void CC_DLL kmGLScalef(float x, float y, float z);
 void CC_DLL kmGLGetMatrix(kmGLEnum mode, kmMat4* pOut);
 
+/* Revision of the current matrix of a stack: it changes every time the matrix may have changed,
+   so the users of a matrix can skip the work when it is the same. Never 0. */
+unsigned int CC_DLL kmGLGetMatrixRevision(kmGLEnum mode);
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,6 +37,26 @@ km_mat4_stack* current_stack = NULL;
 
 static unsigned char initialized = 0;
 
+static unsigned int revision_counter = 0;
+static unsigned int modelview_revision = 0;
+static unsigned int projection_revision = 0;
+static unsigned int texture_revision = 0;
+static unsigned int* current_revision = NULL;
+
+static unsigned int nextRevision()
+{
+    if (++revision_counter == 0) {
+        ++revision_counter;
+    }
+    return revision_counter;
+}
+
+//Called whenever the top of the current stack is modified
+static void touchCurrentMatrix()
+{
+    *current_revision = nextRevision();
+}
+
 void lazyInitialize()
 {
 
@@ -56,6 +76,11 @@ void lazyInitialize()
         current_stack = &modelview_matrix_stack;
         initialized = 1;
 
+        modelview_revision = nextRevision();
+        projection_revision = nextRevision();
+        texture_revision = nextRevision();
+        current_revision = &modelview_revision;
+
         kmMat4Identity(&identity);
 
         //Make sure that each stack has the identity matrix
@@ -73,12 +98,15 @@ void kmGLMatrixMode(kmGLEnum mode)
     {
         case KM_GL_MODELVIEW:
             current_stack = &modelview_matrix_stack;
+            current_revision = &modelview_revision;
         break;
         case KM_GL_PROJECTION:
             current_stack = &projection_matrix_stack;
+            current_revision = &projection_revision;
         break;
         case KM_GL_TEXTURE:
             current_stack = &texture_matrix_stack;
+            current_revision = &texture_revision;
         break;
         default:
             assert(0 && "Invalid matrix mode specified"); //TODO: Proper error handling
@@ -102,6 +130,7 @@ void kmGLPopMatrix(void)
     assert(initialized && "Cannot Pop empty matrix stack");
     //No need to lazy initialize, you shouldn't be popping first anyway!
     km_mat4_stack_pop(current_stack, NULL);
+    touchCurrentMatrix();
 }
 
 void kmGLLoadIdentity()
@@ -109,6 +138,7 @@ void kmGLLoadIdentity()
     lazyInitialize();
 
     kmMat4Identity(current_stack->top); //Replace the top matrix with the identity matrix
+    touchCurrentMatrix();
 }
 
 void kmGLFreeAll()
@@ -122,18 +152,21 @@ void kmGLFreeAll()
     initialized = 0; //Set to uninitialized
 
     current_stack = NULL; //Set the current stack to point nowhere
+    current_revision = NULL;
 }
 
 void kmGLMultMatrix(const kmMat4* pIn)
 {
     lazyInitialize();
     kmMat4Multiply(current_stack->top, current_stack->top, pIn);
+    touchCurrentMatrix();
 }
 
 void kmGLLoadMatrix(const kmMat4* pIn)
 {
     lazyInitialize();
     kmMat4Assign(current_stack->top, pIn);
+    touchCurrentMatrix();
 }
 
 void kmGLGetMatrix(kmGLEnum mode, kmMat4* pOut)
@@ -166,6 +199,7 @@ void kmGLTranslatef(float x, float y, float z)
 
     //Multiply the rotation matrix by the current matrix
     kmMat4Multiply(current_stack->top, current_stack->top, &translation);
+    touchCurrentMatrix();
 }
 
 void kmGLRotatef(float angle, float x, float y, float z)
@@ -181,6 +215,7 @@ void kmGLRotatef(float angle, float x, float y, float z)
 
     //Multiply the rotation matrix by the current matrix
     kmMat4Multiply(current_stack->top, current_stack->top, &rotation);
+    touchCurrentMatrix();
 }
 
 void kmGLScalef(float x, float y, float z)
@@ -188,4 +223,24 @@ void kmGLScalef(float x, float y, float z)
     kmMat4 scaling;
     kmMat4Scaling(&scaling, x, y, z);
     kmMat4Multiply(current_stack->top, current_stack->top, &scaling);
+    touchCurrentMatrix();
+}
+
+unsigned int kmGLGetMatrixRevision(kmGLEnum mode)
+{
+    lazyInitialize();
+
+    switch(mode)
+    {
+        case KM_GL_MODELVIEW:
+            return modelview_revision;
+        case KM_GL_PROJECTION:
+            return projection_revision;
+        case KM_GL_TEXTURE:
+            return texture_revision;
+        default:
+            assert(0 && "Invalid matrix mode specified");
+        break;
+    }
+    return 0;
 }
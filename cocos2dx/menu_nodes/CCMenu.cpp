@@ -602,17 +602,18 @@ void CCMenu::alignItemsInRowsWithArray(CCArray* columnArray)
 
 CCMenuItem* CCMenu::itemForTouch(CCTouch *touch)
 {
-    CCPoint touchLocation = touch->getLocation();
-
     if (_children && _children->count() > 0)
     {
+        // convert the touch to the space of the menu once, then use the cached inverse transforms of the items
+        CCPoint touchLocation = convertToNodeSpace(touch->getLocation());
+
         CCObject* pObject = NULL;
         CCARRAY_FOREACH(_children, pObject)
         {
             CCMenuItem* pChild = dynamic_cast<CCMenuItem*>(pObject);
             if (pChild && pChild->isVisible() && pChild->isEnabled())
             {
-                CCPoint local = pChild->convertToNodeSpace(touchLocation);
+                CCPoint local = CCPointApplyAffineTransform(touchLocation, pChild->parentToNodeTransform());
                 CCRect r = pChild->rect();
                 r.origin = CCPointZero;
 
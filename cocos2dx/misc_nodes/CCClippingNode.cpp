@@ -257,6 +257,8 @@ void CCClippingNode::visit()
     // draw a fullscreen solid rectangle to clear the stencil buffer
     //ccDrawSolidRect(CCPointZero, ccpFromSize([[CCDirector sharedDirector] winSize]), ccc4f(1, 1, 1, 1));
     ccDrawSolidRect(CCPointZero, ccpFromSize(CCDirector::sharedDirector()->getWinSize()), ccc4f(1, 1, 1, 1));
+    // the primitives are batched: draw it now, with the stencil op set above
+    ccDrawFlush();
     
     ///////////////////////////////////
     // DRAW CLIPPING STENCIL
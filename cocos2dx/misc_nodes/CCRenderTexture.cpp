@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "CCConfiguration.h"
 #include "misc_nodes/CCRenderTexture.h"
 #include "CCDirector.h"
+#include "CCScheduler.h"
 #include "platform/platform.h"
 #include "platform/CCImage.h"
 #include "shaders/CCGLProgram.h"
@@ -38,8 +39,12 @@ THE SOFTWARE.
 #include "support/CCNotificationCenter.h"
 #include "CCEventType.h"
 #include "effects/CCGrid.h"
+#include "draw_nodes/CCDrawingPrimitives.h"
 // extern
 #include "kazmath/GL/matrix.h"
+#include <pthread.h>
+#include <vector>
+#include <deque>
 
 NS_CC_BEGIN
 
@@ -361,6 +366,9 @@ bool CCRenderTexture::initWithWidthAndHeight(int w, int h, CCTexture2DPixelForma
 
 void CCRenderTexture::begin()
 {
+    // the pending primitives belong to the previous render target
+    ccDrawFlush();
+
     kmGLMatrixMode(KM_GL_PROJECTION);
 	kmGLPushMatrix();
 	kmGLMatrixMode(KM_GL_MODELVIEW);
@@ -462,6 +470,8 @@ void CCRenderTexture::beginWithClear(float r, float g, float b, float a, float d
 void CCRenderTexture::end()
 {
     CCDirector *director = CCDirector::sharedDirector();
+
+    ccDrawFlush();
     
     glBindFramebuffer(GL_FRAMEBUFFER, _oldFBO);
 
@@ -702,4 +712,371 @@ CCImage* CCRenderTexture::newCCImage(bool flipImage)
     return pImage;
 }
 
+// asynchronous readback
+
+// Frames between the readback into a pixel buffer object and its mapping, so the GPU has
+// finished rendering and copying the pixels when they are mapped.
+#define CC_RENDER_TEXTURE_READBACK_DELAY 2
+// Pixel buffer objects kept for the next readbacks
+#define CC_RENDER_TEXTURE_MAX_FREE_BUFFERS 4
+
+struct ReadbackJob
+{
+    // pixel buffer object, 0 when the pixels were read synchronously
+    GLuint buffer;
+    unsigned int readyFrame;
+    int width;
+    int height;
+    // bottom-up rows: mapped buffer, or owned copy if buffer is 0
+    GLubyte *pixels;
+    bool flipImage;
+    std::string fullPath;
+    CCImageEncoder::Options options;
+    ccRenderTextureSaveCallback saveCallback;
+    ccRenderTextureImageCallback imageCallback;
+    CCImage *image;
+    bool succeeded;
+};
+
+/* Maps the pixel buffer objects and dispatches the callbacks on the main thread,
+ flips and encodes the images on a worker thread. */
+class CCRenderTextureReadback : public CCObject
+{
+public:
+    static CCRenderTextureReadback* sharedReadback();
+
+    void add(ReadbackJob *job);
+    virtual void update(float dt);
+
+    GLuint newBuffer();
+
+private:
+    CCRenderTextureReadback();
+
+    void submit(ReadbackJob *job);
+    void process(ReadbackJob *job);
+    static void* workerThread(void *data);
+
+    // main thread only
+    std::deque<ReadbackJob*> _pendingJobs;
+    std::vector<GLuint> _freeBuffers;
+    unsigned int _outstandingJobs;
+    bool _scheduled;
+    bool _threadStarted;
+
+    // shared with the worker thread
+    std::deque<ReadbackJob*> _workerJobs;
+    std::vector<ReadbackJob*> _doneJobs;
+    std::vector<GLuint> _releasedBuffers;
+    pthread_mutex_t _mutex;
+    pthread_cond_t _condition;
+    pthread_t _thread;
+};
+
+static CCRenderTextureReadback *s_pSharedReadback = NULL;
+
+CCRenderTextureReadback* CCRenderTextureReadback::sharedReadback()
+{
+    if (! s_pSharedReadback)
+    {
+        s_pSharedReadback = new CCRenderTextureReadback();
+    }
+    return s_pSharedReadback;
+}
+
+CCRenderTextureReadback::CCRenderTextureReadback()
+: _outstandingJobs(0)
+, _scheduled(false)
+, _threadStarted(false)
+{
+    pthread_mutex_init(&_mutex, NULL);
+    pthread_cond_init(&_condition, NULL);
+}
+
+GLuint CCRenderTextureReadback::newBuffer()
+{
+    GLuint buffer = 0;
+    if (! _freeBuffers.empty())
+    {
+        buffer = _freeBuffers.back();
+        _freeBuffers.pop_back();
+    }
+    else
+    {
+        glGenBuffers(1, &buffer);
+    }
+    return buffer;
+}
+
+void CCRenderTextureReadback::add(ReadbackJob *job)
+{
+    ++_outstandingJobs;
+    if (job->buffer)
+    {
+        _pendingJobs.push_back(job);
+    }
+    else if (job->pixels)
+    {
+        submit(job);
+    }
+    else
+    {
+        // nothing to read, report the failure in the next update
+        pthread_mutex_lock(&_mutex);
+        _doneJobs.push_back(job);
+        pthread_mutex_unlock(&_mutex);
+    }
+
+    if (! _scheduled)
+    {
+        CCDirector::sharedDirector()->getScheduler()->scheduleUpdateForTarget(this, 0, false);
+        _scheduled = true;
+    }
+}
+
+void CCRenderTextureReadback::submit(ReadbackJob *job)
+{
+    pthread_mutex_lock(&_mutex);
+    if (! _threadStarted)
+    {
+        // the thread lives as long as the application, like the one of CCTextureCache::addImageAsync
+        pthread_create(&_thread, NULL, workerThread, this);
+        pthread_detach(_thread);
+        _threadStarted = true;
+    }
+    _workerJobs.push_back(job);
+    pthread_cond_signal(&_condition);
+    pthread_mutex_unlock(&_mutex);
+}
+
+void CCRenderTextureReadback::update(float dt)
+{
+    std::vector<GLuint> releasedBuffers;
+    std::vector<ReadbackJob*> doneJobs;
+
+    pthread_mutex_lock(&_mutex);
+    releasedBuffers.swap(_releasedBuffers);
+    doneJobs.swap(_doneJobs);
+    pthread_mutex_unlock(&_mutex);
+
+#ifdef GL_PIXEL_PACK_BUFFER
+    // the worker thread copied the pixels out of these buffers
+    for (std::vector<GLuint>::iterator it = releasedBuffers.begin(); it != releasedBuffers.end(); ++it)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, *it);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        if (_freeBuffers.size() < CC_RENDER_TEXTURE_MAX_FREE_BUFFERS)
+        {
+            _freeBuffers.push_back(*it);
+        }
+        else
+        {
+            glDeleteBuffers(1, &*it);
+        }
+    }
+
+    unsigned int frame = CCDirector::sharedDirector()->getTotalFrames();
+    while (! _pendingJobs.empty() && (int)(frame - _pendingJobs.front()->readyFrame) >= 0)
+    {
+        ReadbackJob *job = _pendingJobs.front();
+        _pendingJobs.pop_front();
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, job->buffer);
+        job->pixels = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+        if (job->pixels)
+        {
+            submit(job);
+        }
+        else
+        {
+            CCLOG("cocos2d: CCRenderTexture: failed to map the readback buffer");
+            glDeleteBuffers(1, &job->buffer);
+            job->buffer = 0;
+            doneJobs.push_back(job);
+        }
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif
+
+    for (std::vector<ReadbackJob*>::iterator it = doneJobs.begin(); it != doneJobs.end(); ++it)
+    {
+        ReadbackJob *job = *it;
+        if (job->imageCallback)
+        {
+            job->imageCallback(job->image);
+        }
+        else
+        {
+            CC_SAFE_DELETE(job->image);
+            if (job->saveCallback)
+            {
+                job->saveCallback(job->succeeded, job->fullPath);
+            }
+        }
+        delete job;
+        --_outstandingJobs;
+    }
+
+    if (_outstandingJobs == 0)
+    {
+        CCDirector::sharedDirector()->getScheduler()->unscheduleUpdateForTarget(this);
+        _scheduled = false;
+    }
+}
+
+void* CCRenderTextureReadback::workerThread(void *data)
+{
+    CCRenderTextureReadback *readback = (CCRenderTextureReadback*)data;
+
+    pthread_mutex_lock(&readback->_mutex);
+    while (true)
+    {
+        if (readback->_workerJobs.empty())
+        {
+            pthread_cond_wait(&readback->_condition, &readback->_mutex);
+            continue;
+        }
+
+        ReadbackJob *job = readback->_workerJobs.front();
+        readback->_workerJobs.pop_front();
+        pthread_mutex_unlock(&readback->_mutex);
+
+        readback->process(job);
+
+        pthread_mutex_lock(&readback->_mutex);
+        readback->_doneJobs.push_back(job);
+    }
+
+    return NULL;
+}
+
+void CCRenderTextureReadback::process(ReadbackJob *job)
+{
+    int rowSize = job->width * 4;
+    int dataLen = rowSize * job->height;
+    GLubyte *pixels = new GLubyte[dataLen];
+
+    if (job->flipImage)
+    {
+        for (int i = 0; i < job->height; ++i)
+        {
+            memcpy(&pixels[i * rowSize], &job->pixels[(job->height - i - 1) * rowSize], rowSize);
+        }
+    }
+    else
+    {
+        memcpy(pixels, job->pixels, dataLen);
+    }
+
+    // only the main thread can unmap the buffer
+    if (job->buffer)
+    {
+        pthread_mutex_lock(&_mutex);
+        _releasedBuffers.push_back(job->buffer);
+        pthread_mutex_unlock(&_mutex);
+    }
+    else
+    {
+        delete[] job->pixels;
+    }
+    job->pixels = NULL;
+
+    if (job->fullPath.empty())
+    {
+        job->image = new CCImage();
+        job->succeeded = job->image->initWithImageData(pixels, dataLen, CCImage::kFmtRawData, job->width, job->height, 8);
+        if (! job->succeeded)
+        {
+            CC_SAFE_DELETE(job->image);
+        }
+    }
+    else
+    {
+        job->succeeded = CCImageEncoder::sharedEncoder()->encodeToFile(pixels, job->width, job->height, true,
+                                                                       job->options, job->fullPath.c_str());
+    }
+    delete[] pixels;
+}
+
+void CCRenderTexture::newCCImageAsync(const ccRenderTextureImageCallback& callback, bool flipImage)
+{
+    CCAssert(callback, "the callback can't be empty");
+    readPixelsAsync(flipImage, "", CCImageEncoder::Options(), ccRenderTextureSaveCallback(), callback);
+}
+
+void CCRenderTexture::saveToFileAsync(const char *name, tCCImageFormat format, const ccRenderTextureSaveCallback& callback)
+{
+    CCAssert(format == kCCImageFormatJPEG || format == kCCImageFormatPNG,
+             "the image can only be saved as JPG or PNG format");
+
+    CCImageEncoder::Options options;
+    options.format = format == kCCImageFormatPNG ? CCImage::kFmtPng : CCImage::kFmtJpg;
+    saveToFileAsync(name, options, callback);
+}
+
+void CCRenderTexture::saveToFileAsync(const char *name, const CCImageEncoder::Options& options, const ccRenderTextureSaveCallback& callback)
+{
+    std::string fullpath = CCFileUtils::sharedFileUtils()->getWritablePath() + name;
+    readPixelsAsync(true, fullpath, options, callback, ccRenderTextureImageCallback());
+}
+
+void CCRenderTexture::readPixelsAsync(bool flipImage, const std::string& fullPath, const CCImageEncoder::Options& options,
+                                      const ccRenderTextureSaveCallback& saveCallback, const ccRenderTextureImageCallback& imageCallback)
+{
+    CCAssert(_pixelFormat == kCCTexture2DPixelFormat_RGBA8888, "only RGBA8888 can be saved as image");
+
+    ReadbackJob *job = new ReadbackJob();
+    job->buffer = 0;
+    job->readyFrame = CCDirector::sharedDirector()->getTotalFrames() + CC_RENDER_TEXTURE_READBACK_DELAY;
+    job->width = 0;
+    job->height = 0;
+    job->pixels = NULL;
+    job->flipImage = flipImage;
+    job->fullPath = fullPath;
+    job->options = options;
+    job->saveCallback = saveCallback;
+    job->imageCallback = imageCallback;
+    job->image = NULL;
+    job->succeeded = false;
+
+    CCRenderTextureReadback *readback = CCRenderTextureReadback::sharedReadback();
+
+    if (_texture)
+    {
+        const CCSize& s = _texture->getContentSizeInPixels();
+        job->width = (int)s.width;
+        job->height = (int)s.height;
+        GLsizeiptr dataLen = job->width * job->height * 4;
+
+        // what was drawn into the texture but is still batched must be part of the readback
+        ccDrawFlush();
+
+        GLint oldFBO = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &oldFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, _FBO);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+#ifdef GL_PIXEL_PACK_BUFFER
+        if (CCConfiguration::sharedConfiguration()->supportsPixelBufferObject())
+        {
+            job->buffer = readback->newBuffer();
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, job->buffer);
+            glBufferData(GL_PIXEL_PACK_BUFFER, dataLen, NULL, GL_STREAM_READ);
+            glReadPixels(0, 0, job->width, job->height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+        else
+#endif
+        {
+            job->pixels = new GLubyte[dataLen];
+            glReadPixels(0, 0, job->width, job->height, GL_RGBA, GL_UNSIGNED_BYTE, job->pixels);
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, oldFBO);
+        CHECK_GL_ERROR_DEBUG();
+    }
+
+    readback->add(job);
+}
+
 NS_CC_END
@@ -28,6 +28,9 @@ THE SOFTWARE.
 #include "base_nodes/CCNode.h"
 #include "sprite_nodes/CCSprite.h"
 #include "kazmath/mat4.h"
+#include "support/image_support/CCImageEncoder.h"
+#include <functional>
+#include <string>
 
 NS_CC_BEGIN
 
@@ -41,6 +44,18 @@ typedef enum eImageFormat
     kCCImageFormatJPEG      = 0,
     kCCImageFormatPNG       = 1,
 } tCCImageFormat;
+
+/** Completion callback of CCRenderTexture::saveToFileAsync: whether the file was written and its full path.
+ @since v3.0
+ */
+typedef std::function<void(bool, const std::string&)> ccRenderTextureSaveCallback;
+
+/** Completion callback of CCRenderTexture::newCCImageAsync. The image is NULL if the readback failed,
+ otherwise the callback owns it and is responsible for deleting it.
+ @since v3.0
+ */
+typedef std::function<void(CCImage*)> ccRenderTextureImageCallback;
+
 /**
 @brief CCRenderTexture is a generic rendering target. To render things into it,
 simply construct a render target, call begin on it, call visit on any cocos
@@ -124,6 +139,26 @@ public:
         Returns YES if the operation is successful.
      */
     bool saveToFile(const char *name, tCCImageFormat format);
+
+    /** Asynchronous version of newCCImage.
+     The pixels are read back into a pixel buffer object when supported and mapped a couple of frames
+     later, so the GPU is not stalled; the flip and the image creation happen on a worker thread.
+     The contents are captured when this method is called; the callback is invoked on the main thread.
+     @since v3.0
+     */
+    void newCCImageAsync(const ccRenderTextureImageCallback& callback, bool flipImage = true);
+
+    /** Asynchronous version of saveToFile. The PNG or JPEG encoding happens on a worker thread and
+     the callback, which may be empty, is invoked on the main thread once the file is written.
+     @since v3.0
+     */
+    void saveToFileAsync(const char *name, tCCImageFormat format, const ccRenderTextureSaveCallback& callback);
+
+    /** Asynchronous version of saveToFile with the compression settings of the encoder,
+     e.g. CCImageEncoder::Options::fast() for debug dumps.
+     @since v3.0
+     */
+    void saveToFileAsync(const char *name, const CCImageEncoder::Options& options, const ccRenderTextureSaveCallback& callback);
     
     /** Listen "come to background" message, and save render texture.
      It only has effect on Android.
@@ -159,6 +194,8 @@ public:
 
 private:
     void beginWithClear(float r, float g, float b, float a, float depthValue, int stencilValue, GLbitfield flags);
+    void readPixelsAsync(bool flipImage, const std::string& fullPath, const CCImageEncoder::Options& options,
+                         const ccRenderTextureSaveCallback& saveCallback, const ccRenderTextureImageCallback& imageCallback);
 
 protected:
     GLuint       _FBO;
@@ -23,12 +23,15 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "CCFileUtils.h"
+#include "CCFileView.h"
 #include "CCDirector.h"
 #include "cocoa/CCDictionary.h"
 #include "cocoa/CCString.h"
 #include "CCSAXParser.h"
 #include "support/tinyxml2/tinyxml2.h"
-#include "support/zip_support/unzip.h"
+#include "support/zip_support/ZipUtils.h"
+#include "support/ccUTF8.h"
+#include <pthread.h>
 #include <stack>
 
 using namespace std;
@@ -86,9 +89,10 @@ public:
     {
     }
 
-    CCDictionary* dictionaryWithContentsOfFile(const char *pFileName)
+    /** Parses the xml in place, the data is modified. */
+    CCObject* objectWithContentsOfData(CCSAXResult resultType, char* pData, unsigned int uSize)
     {
-        _resultType = SAX_RESULT_DICT;
+        _resultType = resultType;
         CCSAXParser parser;
 
         if (false == parser.init("UTF-8"))
@@ -97,22 +101,11 @@ public:
         }
         parser.setDelegator(this);
 
-        parser.parse(pFileName);
-        return _rootDict;
-    }
-
-    CCArray* arrayWithContentsOfFile(const char* pFileName)
-    {
-        _resultType = SAX_RESULT_ARRAY;
-        CCSAXParser parser;
-
-        if (false == parser.init("UTF-8"))
+        parser.parseInSitu(pData, uSize);
+        if (resultType == SAX_RESULT_DICT)
         {
-            return NULL;
+            return _rootDict;
         }
-        parser.setDelegator(this);
-
-        parser.parse(pFileName);
         return _array;
     }
 
@@ -120,8 +113,7 @@ public:
     {
         CC_UNUSED_PARAM(ctx);
         CC_UNUSED_PARAM(atts);
-        std::string sName((char*)name);
-        if( sName == "dict" )
+        if( strcmp(name, "dict") == 0 )
         {
             _curDict = new CCDictionary();
             if(_resultType == SAX_RESULT_DICT && _rootDict == NULL)
@@ -157,23 +149,23 @@ public:
             _stateStack.push(_state);
             _dictStack.push(_curDict);
         }
-        else if(sName == "key")
+        else if(strcmp(name, "key") == 0)
         {
             _state = SAX_KEY;
         }
-        else if(sName == "integer")
+        else if(strcmp(name, "integer") == 0)
         {
             _state = SAX_INT;
         }
-        else if(sName == "real")
+        else if(strcmp(name, "real") == 0)
         {
             _state = SAX_REAL;
         }
-        else if(sName == "string")
+        else if(strcmp(name, "string") == 0)
         {
             _state = SAX_STRING;
         }
-        else if (sName == "array")
+        else if (strcmp(name, "array") == 0)
         {
             _state = SAX_ARRAY;
             _array = new CCArray();
@@ -213,8 +205,7 @@ public:
     {
         CC_UNUSED_PARAM(ctx);
         CCSAXState curState = _stateStack.empty() ? SAX_DICT : _stateStack.top();
-        std::string sName((char*)name);
-        if( sName == "dict" )
+        if( strcmp(name, "dict") == 0 )
         {
             _stateStack.pop();
             _dictStack.pop();
@@ -223,7 +214,7 @@ public:
                 _curDict = _dictStack.top();
             }
         }
-        else if (sName == "array")
+        else if (strcmp(name, "array") == 0)
         {
             _stateStack.pop();
             _arrayStack.pop();
@@ -232,7 +223,7 @@ public:
                 _array = _arrayStack.top();
             }
         }
-        else if (sName == "true")
+        else if (strcmp(name, "true") == 0)
         {
             CCString *str = new CCString("1");
             if (SAX_ARRAY == curState)
@@ -245,7 +236,7 @@ public:
             }
             str->release();
         }
-        else if (sName == "false")
+        else if (strcmp(name, "false") == 0)
         {
             CCString *str = new CCString("0");
             if (SAX_ARRAY == curState)
@@ -258,7 +249,7 @@ public:
             }
             str->release();
         }
-        else if (sName == "string" || sName == "integer" || sName == "real")
+        else if (strcmp(name, "string") == 0 || strcmp(name, "integer") == 0 || strcmp(name, "real") == 0)
         {
             CCString* pStrValue = new CCString(_curValue);
 
@@ -287,12 +278,11 @@ public:
         }
 
         CCSAXState curState = _stateStack.empty() ? SAX_DICT : _stateStack.top();
-        CCString *pText = new CCString(std::string((char*)ch,0,len));
 
         switch(_state)
         {
         case SAX_KEY:
-            _curKey = pText->getCString();
+            _curKey.assign(ch, len);
             break;
         case SAX_INT:
         case SAX_REAL:
@@ -303,28 +293,374 @@ public:
                     CCAssert(!_curKey.empty(), "key not found : <integer/real>");
                 }
                 
-                _curValue.append(pText->getCString());
+                _curValue.append(ch, len);
             }
             break;
         default:
             break;
         }
-        pText->release();
     }
 };
 
+/** Reads the binary property lists ("bplist00") written by Xcode and plutil, into the same objects
+ as CCDictMaker: numbers and booleans become CCStrings, dates and data are skipped.
+ */
+class CCBinaryPlistReader
+{
+public:
+    CCBinaryPlistReader(const unsigned char* data, unsigned long size)
+        : _data(data),
+          _size(size),
+          _offsetSize(0),
+          _refSize(0),
+          _objectCount(0),
+          _offsetTable(0),
+          _error(false)
+    {
+    }
+
+    static bool isBinaryPlist(const unsigned char* data, unsigned long size)
+    {
+        return size >= 8 && memcmp(data, "bplist00", 8) == 0;
+    }
+
+    /** Returns the retained top object, or NULL if the file is malformed. */
+    CCObject* readTopObject()
+    {
+        // trailer: 6 unused bytes, offset size, reference size, object count, top object, offset table
+        if (! isBinaryPlist(_data, _size) || _size < 8 + 32)
+        {
+            return NULL;
+        }
+        const unsigned char* trailer = _data + _size - 32;
+        _offsetSize = trailer[6];
+        _refSize = trailer[7];
+        _objectCount = readUInt(trailer + 8, 8);
+        unsigned long long topObject = readUInt(trailer + 16, 8);
+        _offsetTable = readUInt(trailer + 24, 8);
+        if (_offsetSize < 1 || _offsetSize > 8 || _refSize < 1 || _refSize > 8
+            || topObject >= _objectCount || _offsetTable < 8 || _offsetTable > _size - 32
+            || _objectCount > (_size - 32 - _offsetTable) / _offsetSize)
+        {
+            return NULL;
+        }
+
+        CCObject* pRet = readObject(topObject, 0);
+        if (_error)
+        {
+            CC_SAFE_RELEASE_NULL(pRet);
+        }
+        return pRet;
+    }
+
+private:
+    static unsigned long long readUInt(const unsigned char* p, unsigned int size)
+    {
+        unsigned long long value = 0;
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            value = (value << 8) | p[i];
+        }
+        return value;
+    }
+
+    // pointer to the bytes of an object, checked against the end of the objects
+    const unsigned char* bytesAt(unsigned long long offset, unsigned long long length)
+    {
+        if (offset > _offsetTable || length > _offsetTable - offset)
+        {
+            _error = true;
+            return NULL;
+        }
+        return _data + offset;
+    }
+
+    // reads the count of the object at offset, which is followed by an integer when it is 0xf
+    bool readCount(unsigned long long offset, unsigned long long* count, unsigned long long* start)
+    {
+        const unsigned char* p = bytesAt(offset, 1);
+        if (p == NULL)
+        {
+            return false;
+        }
+        if ((*p & 0x0f) != 0x0f)
+        {
+            *count = *p & 0x0f;
+            *start = offset + 1;
+            return true;
+        }
+        p = bytesAt(offset + 1, 1);
+        if (p == NULL || (*p & 0xf0) != 0x10 || (*p & 0x0f) > 3)
+        {
+            _error = true;
+            return false;
+        }
+        unsigned int size = 1 << (*p & 0x0f);
+        p = bytesAt(offset + 2, size);
+        if (p == NULL)
+        {
+            return false;
+        }
+        *count = readUInt(p, size);
+        *start = offset + 2 + size;
+        return true;
+    }
+
+    // reads the reference at index of a list starting at offset
+    bool readRef(unsigned long long offset, unsigned long long index, unsigned long long* ref)
+    {
+        const unsigned char* p = bytesAt(offset + index * _refSize, _refSize);
+        if (p == NULL)
+        {
+            return false;
+        }
+        *ref = readUInt(p, _refSize);
+        return true;
+    }
+
+    static CCString* createNumberString(double value)
+    {
+        // the shortest representation that reads back as the same number, like the xml plists
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.15g", value);
+        if (strtod(buffer, NULL) != value)
+        {
+            snprintf(buffer, sizeof(buffer), "%.17g", value);
+        }
+        return new CCString(buffer);
+    }
+
+    /** Returns the retained object, NULL for the skipped types and on errors. */
+    CCObject* readObject(unsigned long long ref, int depth)
+    {
+        // limits the recursion of malformed files, which may contain cycles
+        if (ref >= _objectCount || depth > 256)
+        {
+            _error = true;
+            return NULL;
+        }
+        unsigned long long offset = readUInt(_data + _offsetTable + ref * _offsetSize, _offsetSize);
+        const unsigned char* p = bytesAt(offset, 1);
+        if (p == NULL)
+        {
+            return NULL;
+        }
+
+        unsigned char marker = *p;
+        unsigned long long count = 0;
+        unsigned long long start = 0;
+        switch (marker & 0xf0)
+        {
+        case 0x00:
+            if (marker == 0x08 || marker == 0x09)
+            {
+                return new CCString(marker == 0x09 ? "1" : "0");
+            }
+            // null and fill
+            return NULL;
+        case 0x10:
+            {
+                unsigned int size = 1 << (marker & 0x0f);
+                if (size > 16 || (p = bytesAt(offset + 1, size)) == NULL)
+                {
+                    _error = true;
+                    return NULL;
+                }
+                // 16 bytes integers hold 64 bits values
+                long long value = (long long)readUInt(p + (size > 8 ? size - 8 : 0), size > 8 ? 8 : size);
+                char buffer[32];
+                snprintf(buffer, sizeof(buffer), "%lld", value);
+                return new CCString(buffer);
+            }
+        case 0x20:
+            {
+                unsigned int size = 1 << (marker & 0x0f);
+                if ((size != 4 && size != 8) || (p = bytesAt(offset + 1, size)) == NULL)
+                {
+                    _error = true;
+                    return NULL;
+                }
+                unsigned long long bits = readUInt(p, size);
+                if (size == 4)
+                {
+                    unsigned int floatBits = (unsigned int)bits;
+                    float value;
+                    memcpy(&value, &floatBits, sizeof(value));
+                    return createNumberString(value);
+                }
+                double value;
+                memcpy(&value, &bits, sizeof(value));
+                return createNumberString(value);
+            }
+        case 0x50:
+            if (! readCount(offset, &count, &start) || (p = bytesAt(start, count)) == NULL)
+            {
+                return NULL;
+            }
+            return new CCString(std::string((const char*)p, (size_t)count));
+        case 0x60:
+            {
+                if (! readCount(offset, &count, &start) || count > _size || (p = bytesAt(start, count * 2)) == NULL)
+                {
+                    return NULL;
+                }
+                std::vector<unsigned short> utf16((size_t)count + 1, 0);
+                for (unsigned long long i = 0; i < count; ++i)
+                {
+                    utf16[i] = (unsigned short)readUInt(p + i * 2, 2);
+                }
+                char* utf8 = cc_utf16_to_utf8(&utf16[0], (long)count, NULL, NULL);
+                if (utf8 == NULL)
+                {
+                    _error = true;
+                    return NULL;
+                }
+                CCString* pRet = new CCString(utf8);
+                free(utf8);
+                return pRet;
+            }
+        case 0xa0:
+        case 0xc0:
+            {
+                // arrays and sets
+                if (! readCount(offset, &count, &start) || count > _size || bytesAt(start, count * _refSize) == NULL)
+                {
+                    return NULL;
+                }
+                CCArray* pArray = new CCArray((unsigned int)count);
+                for (unsigned long long i = 0; i < count && ! _error; ++i)
+                {
+                    unsigned long long itemRef;
+                    if (readRef(start, i, &itemRef))
+                    {
+                        CCObject* pItem = readObject(itemRef, depth + 1);
+                        if (pItem)
+                        {
+                            pArray->addObject(pItem);
+                            pItem->release();
+                        }
+                    }
+                }
+                return pArray;
+            }
+        case 0xd0:
+            {
+                // the keys, then the values
+                if (! readCount(offset, &count, &start) || count > _size || bytesAt(start, count * 2 * _refSize) == NULL)
+                {
+                    return NULL;
+                }
+                CCDictionary* pDict = new CCDictionary();
+                for (unsigned long long i = 0; i < count && ! _error; ++i)
+                {
+                    unsigned long long keyRef;
+                    unsigned long long valueRef;
+                    if (! readRef(start, i, &keyRef) || ! readRef(start, count + i, &valueRef))
+                    {
+                        break;
+                    }
+                    CCObject* pKey = readObject(keyRef, depth + 1);
+                    CCString* pKeyString = dynamic_cast<CCString*>(pKey);
+                    if (pKeyString == NULL)
+                    {
+                        CC_SAFE_RELEASE(pKey);
+                        _error = true;
+                        break;
+                    }
+                    CCObject* pValue = readObject(valueRef, depth + 1);
+                    if (pValue)
+                    {
+                        pDict->setObject(pValue, pKeyString->getCString());
+                        pValue->release();
+                    }
+                    pKey->release();
+                }
+                return pDict;
+            }
+        default:
+            // dates, data and uids
+            return NULL;
+        }
+    }
+
+    const unsigned char* _data;
+    unsigned long _size;
+    unsigned int _offsetSize;
+    unsigned int _refSize;
+    unsigned long long _objectCount;
+    unsigned long long _offsetTable;
+    bool _error;
+};
+
+/** Reads a binary plist, or parses a xml plist in place. */
+static CCObject* createObjectWithFileView(CCFileView* pView, CCSAXResult resultType)
+{
+    CCObject* pObject = NULL;
+    if (CCBinaryPlistReader::isBinaryPlist(pView->getBytes(), pView->getSize()))
+    {
+        CCBinaryPlistReader reader(pView->getBytes(), pView->getSize());
+        pObject = reader.readTopObject();
+        if (pObject == NULL)
+        {
+            CCLOG("cocos2d: CCFileUtils: malformed binary plist");
+        }
+    }
+    else if (pView->getSize() > 0)
+    {
+        // the view is private, so it can be parsed in place
+        CCDictMaker tMaker;
+        pObject = tMaker.objectWithContentsOfData(resultType, (char*)pView->getBytes(), pView->getSize());
+    }
+    return pObject;
+}
+
+/** Opens the file once, whatever its format. */
+static CCObject* createObjectWithContentsOfFile(const std::string& fullPath, CCSAXResult resultType)
+{
+    CCFileView* pView = CCFileUtils::sharedFileUtils()->openFileView(fullPath.c_str());
+    if (pView == NULL)
+    {
+        return NULL;
+    }
+
+    CCObject* pObject = createObjectWithFileView(pView, resultType);
+    pView->release();
+    return pObject;
+}
+
+CCDictionary* CCFileUtils::createCCDictionaryWithFileView(CCFileView* pView)
+{
+    CCObject* pObject = createObjectWithFileView(pView, SAX_RESULT_DICT);
+    CCDictionary* pDict = dynamic_cast<CCDictionary*>(pObject);
+    if (pDict == NULL)
+    {
+        CC_SAFE_RELEASE(pObject);
+    }
+    return pDict;
+}
+
 CCDictionary* CCFileUtils::createCCDictionaryWithContentsOfFile(const std::string& filename)
 {
     std::string fullPath = fullPathForFilename(filename.c_str());
-    CCDictMaker tMaker;
-    return tMaker.dictionaryWithContentsOfFile(fullPath.c_str());
+    CCObject* pObject = createObjectWithContentsOfFile(fullPath, SAX_RESULT_DICT);
+    CCDictionary* pDict = dynamic_cast<CCDictionary*>(pObject);
+    if (pDict == NULL)
+    {
+        CC_SAFE_RELEASE(pObject);
+    }
+    return pDict;
 }
 
 CCArray* CCFileUtils::createCCArrayWithContentsOfFile(const std::string& filename)
 {
     std::string fullPath = fullPathForFilename(filename.c_str());
-    CCDictMaker tMaker;
-    return tMaker.arrayWithContentsOfFile(fullPath.c_str());
+    CCObject* pObject = createObjectWithContentsOfFile(fullPath, SAX_RESULT_ARRAY);
+    CCArray* pArray = dynamic_cast<CCArray*>(pObject);
+    if (pArray == NULL)
+    {
+        CC_SAFE_RELEASE(pObject);
+    }
+    return pArray;
 }
 
 /*
@@ -449,6 +785,7 @@ NS_CC_BEGIN
 
 /* The subclass CCFileUtilsIOS and CCFileUtilsMac should override these two method. */
 CCDictionary* CCFileUtils::createCCDictionaryWithContentsOfFile(const std::string& filename) {return NULL;}
+CCDictionary* CCFileUtils::createCCDictionaryWithFileView(CCFileView* pView) {return NULL;}
 bool CCFileUtils::writeToFile(cocos2d::CCDictionary *dict, const std::string &fullPath) {return NULL;}
 CCArray* CCFileUtils::createCCArrayWithContentsOfFile(const std::string& filename) {return NULL;}
 
@@ -457,6 +794,54 @@ CCArray* CCFileUtils::createCCArrayWithContentsOfFile(const std::string& filenam
 
 CCFileUtils* CCFileUtils::s_sharedFileUtils = NULL;
 
+// guards _zipArchives and the reference counts of the archives, which are used by several threads
+static pthread_mutex_t s_zipArchivesMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static ZipArchive* retainZipArchive(std::map<std::string, ZipArchive*>& archives, const char* pszZipFilePath)
+{
+    pthread_mutex_lock(&s_zipArchivesMutex);
+    std::map<std::string, ZipArchive*>::iterator it = archives.find(pszZipFilePath);
+    if (it != archives.end())
+    {
+        ZipArchive* pArchive = it->second;
+        pArchive->retain();
+        pthread_mutex_unlock(&s_zipArchivesMutex);
+        return pArchive;
+    }
+    pthread_mutex_unlock(&s_zipArchivesMutex);
+
+    // the central directory is parsed without the lock, so other archives stay available
+    ZipArchive* pArchive = new ZipArchive();
+    if (! pArchive->initWithFile(pszZipFilePath))
+    {
+        pArchive->release();
+        return NULL;
+    }
+
+    pthread_mutex_lock(&s_zipArchivesMutex);
+    it = archives.find(pszZipFilePath);
+    if (it != archives.end())
+    {
+        // another thread opened it meanwhile
+        pArchive->release();
+        pArchive = it->second;
+    }
+    else
+    {
+        archives[pszZipFilePath] = pArchive;
+    }
+    pArchive->retain();
+    pthread_mutex_unlock(&s_zipArchivesMutex);
+    return pArchive;
+}
+
+static void releaseZipArchive(ZipArchive* pArchive)
+{
+    pthread_mutex_lock(&s_zipArchivesMutex);
+    pArchive->release();
+    pthread_mutex_unlock(&s_zipArchivesMutex);
+}
+
 void CCFileUtils::purgeFileUtils()
 {
     CC_SAFE_DELETE(s_sharedFileUtils);
@@ -470,6 +855,10 @@ CCFileUtils::CCFileUtils()
 CCFileUtils::~CCFileUtils()
 {
     CC_SAFE_RELEASE(_filenameLookupDict);
+    for (std::map<std::string, ZipArchive*>::iterator it = _zipArchives.begin(); it != _zipArchives.end(); ++it)
+    {
+        it->second->release();
+    }
 }
 
 bool CCFileUtils::init()
@@ -482,6 +871,14 @@ bool CCFileUtils::init()
 void CCFileUtils::purgeCachedEntries()
 {
     _fullPathCache.clear();
+
+    pthread_mutex_lock(&s_zipArchivesMutex);
+    for (std::map<std::string, ZipArchive*>::iterator it = _zipArchives.begin(); it != _zipArchives.end(); ++it)
+    {
+        it->second->release();
+    }
+    _zipArchives.clear();
+    pthread_mutex_unlock(&s_zipArchivesMutex);
 }
 
 unsigned char* CCFileUtils::getFileData(const char* pszFileName, const char* pszMode, unsigned long * pSize)
@@ -514,10 +911,56 @@ unsigned char* CCFileUtils::getFileData(const char* pszFileName, const char* psz
     return pBuffer;
 }
 
+CCFileView* CCFileUtils::openFileView(const char* pszFileName)
+{
+    CCAssert(pszFileName != NULL, "Invalid parameters.");
+    std::string fullPath = fullPathForFilename(pszFileName);
+
+    CCFileView* pView = openMappedFileView(fullPath);
+    if (pView)
+    {
+        return pView;
+    }
+
+    pView = new CCFileView();
+    unsigned long size = 0;
+    unsigned char* pBuffer = getFileData(fullPath.c_str(), "rb", &size);
+    if (pBuffer && pView->initWithBuffer(pBuffer, size))
+    {
+        return pView;
+    }
+
+    CC_SAFE_DELETE_ARRAY(pBuffer);
+    pView->release();
+    return NULL;
+}
+
+CCFileView* CCFileUtils::openMappedFileView(const std::string& fullPath)
+{
+    CC_UNUSED_PARAM(fullPath);
+    return NULL;
+}
+
+CCFileView* CCFileUtils::mapFileView(const std::string& fullPath, const std::type_info& fileDataClass)
+{
+    if (typeid(*this) != fileDataClass)
+    {
+        return NULL;
+    }
+
+    CCFileView* pView = new CCFileView();
+    if (pView->initWithMappedFile(fullPath.c_str()))
+    {
+        return pView;
+    }
+    pView->release();
+    return NULL;
+}
+
 unsigned char* CCFileUtils::getFileDataFromZip(const char* pszZipFilePath, const char* pszFileName, unsigned long * pSize)
 {
     unsigned char * pBuffer = NULL;
-    unzFile pFile = NULL;
+    ZipArchive* pArchive = NULL;
     *pSize = 0;
 
     do 
@@ -525,34 +968,43 @@ unsigned char* CCFileUtils::getFileDataFromZip(const char* pszZipFilePath, const
         CC_BREAK_IF(!pszZipFilePath || !pszFileName);
         CC_BREAK_IF(strlen(pszZipFilePath) == 0);
 
-        pFile = unzOpen(pszZipFilePath);
-        CC_BREAK_IF(!pFile);
+        pArchive = retainZipArchive(_zipArchives, pszZipFilePath);
+        CC_BREAK_IF(!pArchive);
+
+        // the archive is read outside of the lock, by several threads at once
+        pBuffer = pArchive->getFileData(pszFileName, pSize);
+    } while (0);
+
+    if (pArchive)
+    {
+        releaseZipArchive(pArchive);
+    }
 
-        int nRet = unzLocateFile(pFile, pszFileName, 1);
-        CC_BREAK_IF(UNZ_OK != nRet);
+    return pBuffer;
+}
 
-        char szFilePathA[260];
-        unz_file_info FileInfo;
-        nRet = unzGetCurrentFileInfo(pFile, &FileInfo, szFilePathA, sizeof(szFilePathA), NULL, 0, NULL, 0);
-        CC_BREAK_IF(UNZ_OK != nRet);
+CCFileView* CCFileUtils::openFileViewFromZip(const char* pszZipFilePath, const char* pszFileName)
+{
+    CCFileView* pView = NULL;
+    ZipArchive* pArchive = NULL;
 
-        nRet = unzOpenCurrentFile(pFile);
-        CC_BREAK_IF(UNZ_OK != nRet);
+    do 
+    {
+        CC_BREAK_IF(!pszZipFilePath || !pszFileName);
+        CC_BREAK_IF(strlen(pszZipFilePath) == 0);
 
-        pBuffer = new unsigned char[FileInfo.uncompressed_size];
-        int CC_UNUSED nSize = unzReadCurrentFile(pFile, pBuffer, FileInfo.uncompressed_size);
-        CCAssert(nSize == 0 || nSize == (int)FileInfo.uncompressed_size, "the file size is wrong");
+        pArchive = retainZipArchive(_zipArchives, pszZipFilePath);
+        CC_BREAK_IF(!pArchive);
 
-        *pSize = FileInfo.uncompressed_size;
-        unzCloseCurrentFile(pFile);
+        pView = pArchive->openFileView(pszFileName);
     } while (0);
 
-    if (pFile)
+    if (pArchive)
     {
-        unzClose(pFile);
+        releaseZipArchive(pArchive);
     }
 
-    return pBuffer;
+    return pView;
 }
 
 std::string CCFileUtils::getNewFilename(const char* pszFileName)
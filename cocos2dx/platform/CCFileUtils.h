@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include <string>
 #include <vector>
 #include <map>
+#include <typeinfo>
 #include "CCPlatformMacros.h"
 #include "ccTypes.h"
 #include "ccTypeInfo.h"
@@ -35,6 +36,8 @@ NS_CC_BEGIN
 
 class CCDictionary;
 class CCArray;
+class CCFileView;
+class ZipArchive;
 /**
  * @addtogroup platform
  * @{
@@ -45,6 +48,7 @@ class CC_DLL CCFileUtils : public TypeInfo
 {
     friend class CCArray;
     friend class CCDictionary;
+    friend class CCSpriteFrameCache;
 public:
     /**
      *  Returns an unique ID for this class.
@@ -72,7 +76,7 @@ public:
     virtual ~CCFileUtils();
     
     /**
-     *  Purges the file searching cache.
+     *  Purges the file searching cache and closes the zip files opened by getFileDataFromZip.
      *
      *  @note It should be invoked after the resources were updated.
      *        For instance, in the CocosPlayer sample, every time you run application from CocosBuilder,
@@ -89,12 +93,16 @@ public:
      *  @param[out] pSize If the file read operation succeeds, it will be the data size, otherwise 0.
      *  @return Upon success, a pointer to the data is returned, otherwise NULL.
      *  @warning Recall: you are responsible for calling delete[] on any Non-NULL pointer returned.
+     *  @note openFileView reads the files with it too, unless the platform class maps them: see openMappedFileView.
      */
     virtual unsigned char* getFileData(const char* pszFileName, const char* pszMode, unsigned long * pSize);
 
     /**
      *  Gets resource file data from a zip file.
      *
+     *  The zip file stays open, with its file list, until purgeCachedEntries() is called, so reading many files
+     *  of the same zip file is fast. It may be called from any thread.
+     *
      *  @param[in]  pszFileName The resource file name which contains the relative path of the zip file.
      *  @param[out] pSize If the file read operation succeeds, it will be the data size, otherwise 0.
      *  @return Upon success, a pointer to the data is returned, otherwise NULL.
@@ -102,6 +110,29 @@ public:
      */
     virtual unsigned char* getFileDataFromZip(const char* pszZipFilePath, const char* pszFileName, unsigned long * pSize);
 
+    /**
+     *  Opens a view of a file of a zip file, see getFileDataFromZip and ZipArchive::openFileView.
+     *
+     *  @warning The view is not autoreleased: call release() on any Non-NULL pointer returned.
+     *  @since v3.0
+     */
+    virtual CCFileView* openFileViewFromZip(const char* pszZipFilePath, const char* pszFileName);
+
+    /**
+     *  Opens a view of a resource file, mapped in memory where the platform allows it.
+     *
+     *  Parsers should prefer it to getFileData, which always copies the file in a new buffer.
+     *  The file is mapped by openMappedFileView, the files it doesn't map are read with getFileData.
+     *  The bytes may be modified, the changes are private to the view and never written to the file.
+     *
+     *  @param[in]  pszFileName The resource file name which contains the path.
+     *  @return Upon success, the view, otherwise NULL.
+     *  @warning The view is not autoreleased, so it can be used by other threads: call release() on any
+     *           Non-NULL pointer returned.
+     *  @since v3.0
+     */
+    virtual CCFileView* openFileView(const char* pszFileName);
+
     
     /** Returns the fullpath for a given filename.
      
@@ -300,6 +331,26 @@ protected:
      */
     CCFileUtils();
     
+    /**
+     *  Maps a file in memory for openFileView, returns NULL if it isn't mapped, then getFileData reads it.
+     *  It returns NULL by default. The platform classes reading the files straight from disk override it
+     *  with mapFileView, so a class derived from them which overrides getFileData is still used.
+     *
+     *  @param fullPath The full path of the file.
+     *  @since v3.0
+     */
+    virtual CCFileView* openMappedFileView(const std::string& fullPath);
+
+    /**
+     *  Maps a file in memory if this object is exactly of the class fileDataClass, otherwise returns NULL:
+     *  a class derived from it may override getFileData, and openFileView must read the files with it then.
+     *
+     *  @param fullPath The full path of the file.
+     *  @param fileDataClass The class calling it, whose getFileData reads the files from disk.
+     *  @since v3.0
+     */
+    CCFileView* mapFileView(const std::string& fullPath, const std::type_info& fileDataClass);
+    
     /**
      *  Initializes the instance of CCFileUtils. It will set _searchPathArray and _searchResolutionsOrderArray to default values.
      *
@@ -346,6 +397,14 @@ protected:
      */
     virtual CCDictionary* createCCDictionaryWithContentsOfFile(const std::string& filename);
     
+    /**
+     *  Creates a dictionary by the contents of a plist file opened with openFileView, so callers which
+     *  check the contents of a file first don't read it again. A xml plist is parsed in place.
+     *  @note This method is used internally.
+     *  @since v3.0
+     */
+    virtual CCDictionary* createCCDictionaryWithFileView(CCFileView* pView);
+    
     /**
      *  Write a dictionary to a plist file.
      *  @note This method is used internally.
@@ -393,6 +452,11 @@ protected:
      *  This variable is used for improving the performance of file search.
      */
     std::map<std::string, std::string> _fullPathCache;
+
+    /**
+     *  The zip files opened by getFileDataFromZip, by path.
+     */
+    std::map<std::string, ZipArchive*> _zipArchives;
     
     /**
      *  The singleton pointer of CCFileUtils.
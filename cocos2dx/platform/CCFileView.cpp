@@ -0,0 +1,128 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCFileView.h"
+#include "ccMacros.h"
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+NS_CC_BEGIN
+
+CCFileView::CCFileView()
+: _mapAddress(NULL)
+, _mapLength(0)
+, _mapped(false)
+{
+}
+
+CCFileView::~CCFileView()
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX
+    if (_mapped)
+    {
+        munmap(_mapAddress, _mapLength);
+        // not owned, don't let CCData delete it
+        _bytes = NULL;
+    }
+#endif
+}
+
+bool CCFileView::initWithMappedFile(const char* fullPath)
+{
+    CCAssert(_bytes == NULL, "CCFileView: already initialized");
+#if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX
+    int fd = open(fullPath, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    bool ret = fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0
+        && initWithMappedRange(fd, 0, info.st_size);
+    // the mapping keeps its own reference to the file
+    close(fd);
+    return ret;
+#else
+    CC_UNUSED_PARAM(fullPath);
+    return false;
+#endif
+}
+
+bool CCFileView::initWithMappedRange(int fd, unsigned long long offset, unsigned long size)
+{
+    CCAssert(_bytes == NULL, "CCFileView: already initialized");
+#if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX
+    if (size == 0)
+    {
+        return false;
+    }
+
+    static const unsigned long long pageSize = sysconf(_SC_PAGESIZE);
+    unsigned long long start = offset - offset % pageSize;
+    unsigned long length = (unsigned long)(offset - start) + size;
+
+    void* address = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, start);
+    if (address == MAP_FAILED)
+    {
+        return false;
+    }
+
+    // files are mostly parsed from start to end
+    madvise(address, length, MADV_SEQUENTIAL);
+
+    _mapAddress = address;
+    _mapLength = length;
+    _bytes = (unsigned char*)address + (offset - start);
+    _size = size;
+    _mapped = true;
+    return true;
+#else
+    CC_UNUSED_PARAM(fd);
+    CC_UNUSED_PARAM(offset);
+    CC_UNUSED_PARAM(size);
+    return false;
+#endif
+}
+
+bool CCFileView::initWithBuffer(unsigned char* buffer, unsigned long size)
+{
+    CCAssert(_bytes == NULL, "CCFileView: already initialized");
+    _bytes = buffer;
+    _size = size;
+    _mapped = false;
+    return true;
+}
+
+bool CCFileView::isMapped() const
+{
+    return _mapped;
+}
+
+NS_CC_END
@@ -0,0 +1,79 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CC_FILEVIEW_H__
+#define __CC_FILEVIEW_H__
+
+#include "cocoa/CCData.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/** @brief Contents of a file, returned by CCFileUtils::openFileView.
+
+ On linux the file is mapped in memory, its pages are loaded on demand by the kernel and shared with
+ the page cache, so no copy of the file is made. On the other platforms, and for files which can't
+ be mapped (for instance inside the apk on android), the view owns a buffer holding the whole file.
+
+ The file is mapped with PROT_READ | PROT_WRITE and MAP_PRIVATE, so the bytes may be modified, for
+ instance by the parsers working in place: the writes are copy on write, private to the view, and
+ never reach the file.
+ The bytes are not NUL terminated.
+ @since v3.0
+ */
+class CC_DLL CCFileView : public CCData
+{
+public:
+    CCFileView();
+    virtual ~CCFileView();
+
+    /** Maps a file in memory. Fails on the platforms without mmap and for empty files. */
+    bool initWithMappedFile(const char* fullPath);
+    /** Maps a part of an open file in memory, for instance an entry of an archive. The descriptor may
+     be closed once the view is initialized. Fails on the platforms without mmap.
+     */
+    bool initWithMappedRange(int fd, unsigned long long offset, unsigned long size);
+    /** Takes the ownership of a buffer allocated with new[]. */
+    bool initWithBuffer(unsigned char* buffer, unsigned long size);
+
+    /** Whether the bytes are mapped from the file rather than owned. */
+    bool isMapped() const;
+
+private:
+    // the mapping starts on a page boundary, before the bytes
+    void* _mapAddress;
+    unsigned long _mapLength;
+    bool _mapped;
+};
+
+// end of platform group
+/// @}
+
+NS_CC_END
+
+#endif // __CC_FILEVIEW_H__
@@ -30,6 +30,8 @@ THE SOFTWARE.
 #include "CCCommon.h"
 #include "CCStdC.h"
 #include "CCFileUtils.h"
+#include "CCFileView.h"
+#include "support/image_support/CCImageEncoder.h"
 #include "png.h"
 #include "jpeglib.h"
 #include "tiffio.h"
@@ -119,14 +121,13 @@ bool CCImage::initWithImageFile(const char * strPath, EImageFormat eImgFmt/* = e
 
     SDL_FreeSurface(iSurf);
 #else
-    unsigned long nSize = 0;
     std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(strPath);
-    unsigned char* pBuffer = CCFileUtils::sharedFileUtils()->getFileData(fullPath.c_str(), "rb", &nSize);
-    if (pBuffer != NULL && nSize > 0)
+    CCFileView* pView = CCFileUtils::sharedFileUtils()->openFileView(fullPath.c_str());
+    if (pView != NULL && pView->getSize() > 0)
     {
-        bRet = initWithImageData(pBuffer, nSize, eImgFmt);
+        bRet = initWithImageData(pView->getBytes(), pView->getSize(), eImgFmt);
     }
-    CC_SAFE_DELETE_ARRAY(pBuffer);
+    CC_SAFE_RELEASE(pView);
 #endif // EMSCRIPTEN
 
     return bRet;
@@ -135,13 +136,12 @@ bool CCImage::initWithImageFile(const char * strPath, EImageFormat eImgFmt/* = e
 bool CCImage::initWithImageFileThreadSafe(const char *fullpath, EImageFormat imageType)
 {
     bool bRet = false;
-    unsigned long nSize = 0;
-    unsigned char *pBuffer = CCFileUtils::sharedFileUtils()->getFileData(fullpath, "rb", &nSize);
-    if (pBuffer != NULL && nSize > 0)
+    CCFileView* pView = CCFileUtils::sharedFileUtils()->openFileView(fullpath);
+    if (pView != NULL && pView->getSize() > 0)
     {
-        bRet = initWithImageData(pBuffer, nSize, imageType);
+        bRet = initWithImageData(pView->getBytes(), pView->getSize(), imageType);
     }
-    CC_SAFE_DELETE_ARRAY(pBuffer);
+    CC_SAFE_RELEASE(pView);
     return bRet;
 }
 
@@ -744,220 +744,16 @@ bool CCImage::saveToFile(const char *pszFilePath, bool bIsToRGB)
 
 bool CCImage::_saveImageToPNG(const char * pszFilePath, bool bIsToRGB)
 {
-    bool bRet = false;
-    do 
-    {
-        CC_BREAK_IF(NULL == pszFilePath);
-
-        FILE *fp;
-        png_structp png_ptr;
-        png_infop info_ptr;
-        png_colorp palette;
-        png_bytep *row_pointers;
-
-        fp = fopen(pszFilePath, "wb");
-        CC_BREAK_IF(NULL == fp);
-
-        png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-
-        if (NULL == png_ptr)
-        {
-            fclose(fp);
-            break;
-        }
-
-        info_ptr = png_create_info_struct(png_ptr);
-        if (NULL == info_ptr)
-        {
-            fclose(fp);
-            png_destroy_write_struct(&png_ptr, NULL);
-            break;
-        }
-#if (CC_TARGET_PLATFORM != CC_PLATFORM_BADA && CC_TARGET_PLATFORM != CC_PLATFORM_NACL)
-        if (setjmp(png_jmpbuf(png_ptr)))
-        {
-            fclose(fp);
-            png_destroy_write_struct(&png_ptr, &info_ptr);
-            break;
-        }
-#endif
-        png_init_io(png_ptr, fp);
-
-        if (!bIsToRGB && _hasAlpha)
-        {
-            png_set_IHDR(png_ptr, info_ptr, _width, _height, 8, PNG_COLOR_TYPE_RGB_ALPHA,
-                PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
-        } 
-        else
-        {
-            png_set_IHDR(png_ptr, info_ptr, _width, _height, 8, PNG_COLOR_TYPE_RGB,
-                PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
-        }
-
-        palette = (png_colorp)png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof (png_color));
-        png_set_PLTE(png_ptr, info_ptr, palette, PNG_MAX_PALETTE_LENGTH);
-
-        png_write_info(png_ptr, info_ptr);
-
-        png_set_packing(png_ptr);
-
-        row_pointers = (png_bytep *)malloc(_height * sizeof(png_bytep));
-        if(row_pointers == NULL)
-        {
-            fclose(fp);
-            png_destroy_write_struct(&png_ptr, &info_ptr);
-            break;
-        }
-
-        if (!_hasAlpha)
-        {
-            for (int i = 0; i < (int)_height; i++)
-            {
-                row_pointers[i] = (png_bytep)_data + i * _width * 3;
-            }
-
-            png_write_image(png_ptr, row_pointers);
-
-            free(row_pointers);
-            row_pointers = NULL;
-        }
-        else
-        {
-            if (bIsToRGB)
-            {
-                unsigned char *pTempData = new unsigned char[_width * _height * 3];
-                if (NULL == pTempData)
-                {
-                    fclose(fp);
-                    png_destroy_write_struct(&png_ptr, &info_ptr);
-                    break;
-                }
-
-                for (int i = 0; i < _height; ++i)
-                {
-                    for (int j = 0; j < _width; ++j)
-                    {
-                        pTempData[(i * _width + j) * 3] = _data[(i * _width + j) * 4];
-                        pTempData[(i * _width + j) * 3 + 1] = _data[(i * _width + j) * 4 + 1];
-                        pTempData[(i * _width + j) * 3 + 2] = _data[(i * _width + j) * 4 + 2];
-                    }
-                }
-
-                for (int i = 0; i < (int)_height; i++)
-                {
-                    row_pointers[i] = (png_bytep)pTempData + i * _width * 3;
-                }
-
-                png_write_image(png_ptr, row_pointers);
-
-                free(row_pointers);
-                row_pointers = NULL;
-
-                CC_SAFE_DELETE_ARRAY(pTempData);
-            } 
-            else
-            {
-                for (int i = 0; i < (int)_height; i++)
-                {
-                    row_pointers[i] = (png_bytep)_data + i * _width * 4;
-                }
-
-                png_write_image(png_ptr, row_pointers);
-
-                free(row_pointers);
-                row_pointers = NULL;
-            }
-        }
-
-        png_write_end(png_ptr, info_ptr);
-
-        png_free(png_ptr, palette);
-        palette = NULL;
-
-        png_destroy_write_struct(&png_ptr, &info_ptr);
-
-        fclose(fp);
-
-        bRet = true;
-    } while (0);
-    return bRet;
+    CCImageEncoder::Options options;
+    options.keepAlpha = !bIsToRGB;
+    return CCImageEncoder::sharedEncoder()->encodeToFile(this, options, pszFilePath);
 }
+
 bool CCImage::_saveImageToJPG(const char * pszFilePath)
 {
-    bool bRet = false;
-    do 
-    {
-        CC_BREAK_IF(NULL == pszFilePath);
-
-        struct jpeg_compress_struct cinfo;
-        struct jpeg_error_mgr jerr;
-        FILE * outfile;                 /* target file */
-        JSAMPROW row_pointer[1];        /* pointer to JSAMPLE row[s] */
-        int     row_stride;          /* physical row width in image buffer */
-
-        cinfo.err = jpeg_std_error(&jerr);
-        /* Now we can initialize the JPEG compression object. */
-        jpeg_create_compress(&cinfo);
-
-        CC_BREAK_IF((outfile = fopen(pszFilePath, "wb")) == NULL);
-        
-        jpeg_stdio_dest(&cinfo, outfile);
-
-        cinfo.image_width = _width;    /* image width and height, in pixels */
-        cinfo.image_height = _height;
-        cinfo.input_components = 3;       /* # of color components per pixel */
-        cinfo.in_color_space = JCS_RGB;       /* colorspace of input image */
-
-        jpeg_set_defaults(&cinfo);
-
-        jpeg_start_compress(&cinfo, TRUE);
-
-        row_stride = _width * 3; /* JSAMPLEs per row in image_buffer */
-
-        if (_hasAlpha)
-        {
-            unsigned char *pTempData = new unsigned char[_width * _height * 3];
-            if (NULL == pTempData)
-            {
-                jpeg_finish_compress(&cinfo);
-                jpeg_destroy_compress(&cinfo);
-                fclose(outfile);
-                break;
-            }
-
-            for (int i = 0; i < _height; ++i)
-            {
-                for (int j = 0; j < _width; ++j)
-
-                {
-                    pTempData[(i * _width + j) * 3] = _data[(i * _width + j) * 4];
-                    pTempData[(i * _width + j) * 3 + 1] = _data[(i * _width + j) * 4 + 1];
-                    pTempData[(i * _width + j) * 3 + 2] = _data[(i * _width + j) * 4 + 2];
-                }
-            }
-
-            while (cinfo.next_scanline < cinfo.image_height) {
-                row_pointer[0] = & pTempData[cinfo.next_scanline * row_stride];
-                (void) jpeg_write_scanlines(&cinfo, row_pointer, 1);
-            }
-
-            CC_SAFE_DELETE_ARRAY(pTempData);
-        } 
-        else
-        {
-            while (cinfo.next_scanline < cinfo.image_height) {
-                row_pointer[0] = & _data[cinfo.next_scanline * row_stride];
-                (void) jpeg_write_scanlines(&cinfo, row_pointer, 1);
-            }
-        }
-
-        jpeg_finish_compress(&cinfo);
-        fclose(outfile);
-        jpeg_destroy_compress(&cinfo);
-        
-        bRet = true;
-    } while (0);
-    return bRet;
+    CCImageEncoder::Options options;
+    options.format = kFmtJpg;
+    return CCImageEncoder::sharedEncoder()->encodeToFile(this, options, pszFilePath);
 }
 
 NS_CC_END
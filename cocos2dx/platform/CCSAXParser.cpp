@@ -23,72 +23,220 @@
  ****************************************************************************/
 
 #include "CCSAXParser.h"
-#include "cocoa/CCDictionary.h"
 #include "CCFileUtils.h"
-#include "support/tinyxml2/tinyxml2.h"
-
-#include <vector> // because its based on windows 8 build :P
+#include "CCFileView.h"
+#include <string.h>
 
 NS_CC_BEGIN
 
-class XmlSaxHander : public tinyxml2::XMLVisitor
+static inline bool isXMLSpace(char c)
 {
-public:
-	XmlSaxHander():_ccsaxParserImp(0){};
-	
-	virtual bool VisitEnter( const tinyxml2::XMLElement& element, const tinyxml2::XMLAttribute* firstAttribute );
-	virtual bool VisitExit( const tinyxml2::XMLElement& element );
-	virtual bool Visit( const tinyxml2::XMLText& text );
-	virtual bool Visit( const tinyxml2::XMLUnknown&){ return true; }
-
-	void setCCSAXParserImp(CCSAXParser* parser)
-	{
-		_ccsaxParserImp = parser;
-	}
-
-private:
-	CCSAXParser *_ccsaxParserImp;
-};
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
 
+static char* findString(char* p, char* end, const char* s, size_t length)
+{
+    while (p + length <= end)
+    {
+        p = (char*)memchr(p, s[0], end - p - length + 1);
+        if (p == NULL)
+        {
+            return NULL;
+        }
+        if (memcmp(p, s, length) == 0)
+        {
+            return p;
+        }
+        ++p;
+    }
+    return NULL;
+}
 
-bool XmlSaxHander::VisitEnter( const tinyxml2::XMLElement& element, const tinyxml2::XMLAttribute* firstAttribute )
+// end of a start tag, skipping the '>' of the attribute values
+static char* findTagEnd(char* p, char* end)
 {
-	//CCLog(" VisitEnter %s",element.Value());
+    char quote = 0;
+    for (; p < end; ++p)
+    {
+        if (quote)
+        {
+            if (*p == quote)
+            {
+                quote = 0;
+            }
+        }
+        else if (*p == '"' || *p == '\'')
+        {
+            quote = *p;
+        }
+        else if (*p == '>')
+        {
+            return p;
+        }
+    }
+    return NULL;
+}
 
-	std::vector<const char*> attsVector;
-	for( const tinyxml2::XMLAttribute* attrib = firstAttribute; attrib; attrib = attrib->Next() )
-	{
-		//CCLog("%s", attrib->Name());
-		attsVector.push_back(attrib->Name());
-		//CCLog("%s",attrib->Value());
-		attsVector.push_back(attrib->Value());
-	}
-    
-    // nullptr is used in c++11
-	//attsVector.push_back(nullptr);
-    attsVector.push_back(NULL);
+// end of a DOCTYPE declaration, which may hold an internal subset between brackets
+static char* findDeclarationEnd(char* p, char* end)
+{
+    int brackets = 0;
+    for (; p < end; ++p)
+    {
+        if (*p == '[')
+        {
+            ++brackets;
+        }
+        else if (*p == ']')
+        {
+            --brackets;
+        }
+        else if (*p == '>' && brackets <= 0)
+        {
+            return p;
+        }
+    }
+    return NULL;
+}
 
-	CCSAXParser::startElement(_ccsaxParserImp, (const CC_XML_CHAR *)element.Value(), (const CC_XML_CHAR **)(&attsVector[0]));
-	return true;
+static int encodeUTF8(unsigned long code, char* out)
+{
+    if (code < 0x80)
+    {
+        out[0] = (char)code;
+        return 1;
+    }
+    if (code < 0x800)
+    {
+        out[0] = (char)(0xc0 | (code >> 6));
+        out[1] = (char)(0x80 | (code & 0x3f));
+        return 2;
+    }
+    if (code < 0x10000)
+    {
+        out[0] = (char)(0xe0 | (code >> 12));
+        out[1] = (char)(0x80 | ((code >> 6) & 0x3f));
+        out[2] = (char)(0x80 | (code & 0x3f));
+        return 3;
+    }
+    out[0] = (char)(0xf0 | (code >> 18));
+    out[1] = (char)(0x80 | ((code >> 12) & 0x3f));
+    out[2] = (char)(0x80 | ((code >> 6) & 0x3f));
+    out[3] = (char)(0x80 | (code & 0x3f));
+    return 4;
 }
-bool XmlSaxHander::VisitExit( const tinyxml2::XMLElement& element )
+
+// decodes the entity between '&' and ';', returns the number of bytes written or 0 if it is unknown
+static int decodeEntity(const char* name, const char* nameEnd, char* out)
 {
-	//CCLog("VisitExit %s",element.Value());
+    static const struct { const char* name; size_t length; char value; } s_entities[] = {
+        { "lt", 2, '<' }, { "gt", 2, '>' }, { "amp", 3, '&' }, { "quot", 4, '"' }, { "apos", 4, '\'' },
+    };
+
+    size_t length = nameEnd - name;
+    if (length >= 2 && name[0] == '#')
+    {
+        unsigned long code = 0;
+        bool hexadecimal = name[1] == 'x';
+        const char* p = hexadecimal ? name + 2 : name + 1;
+        if (p == nameEnd)
+        {
+            return 0;
+        }
+        for (; p < nameEnd; ++p)
+        {
+            char c = *p;
+            unsigned long digit;
+            if (c >= '0' && c <= '9')
+            {
+                digit = c - '0';
+            }
+            else if (hexadecimal && c >= 'a' && c <= 'f')
+            {
+                digit = c - 'a' + 10;
+            }
+            else if (hexadecimal && c >= 'A' && c <= 'F')
+            {
+                digit = c - 'A' + 10;
+            }
+            else
+            {
+                return 0;
+            }
+            code = code * (hexadecimal ? 16 : 10) + digit;
+            if (code > 0x10ffff)
+            {
+                return 0;
+            }
+        }
+        return code == 0 ? 0 : encodeUTF8(code, out);
+    }
 
-	CCSAXParser::endElement(_ccsaxParserImp, (const CC_XML_CHAR *)element.Value());
-	return true;
+    for (unsigned int i = 0; i < sizeof(s_entities) / sizeof(s_entities[0]); ++i)
+    {
+        if (length == s_entities[i].length && memcmp(name, s_entities[i].name, length) == 0)
+        {
+            *out = s_entities[i].value;
+            return 1;
+        }
+    }
+    return 0;
 }
 
-bool XmlSaxHander::Visit( const tinyxml2::XMLText& text )
+// decodes the entities and normalizes the newlines in place, returns the new length
+static int decodeText(char* text, int length)
 {
-	//CCLog("Visit %s",text.Value());
-	CCSAXParser::textHandler(_ccsaxParserImp, (const CC_XML_CHAR *)text.Value(), strlen(text.Value()));
-	return true;
+    char* r = text;
+    char* end = text + length;
+    while (r < end && *r != '&' && *r != '\r')
+    {
+        ++r;
+    }
+    if (r == end)
+    {
+        return length;
+    }
+
+    // the decoded text is never longer
+    char* w = r;
+    while (r < end)
+    {
+        if (*r == '\r')
+        {
+            *w++ = '\n';
+            if (++r < end && *r == '\n')
+            {
+                ++r;
+            }
+        }
+        else if (*r == '&')
+        {
+            // the longest entity is "&#x10ffff;"
+            char* semicolon = (char*)memchr(r, ';', end - r < 12 ? end - r : 12);
+            int written = semicolon ? decodeEntity(r + 1, semicolon, w) : 0;
+            if (written > 0)
+            {
+                w += written;
+                r = semicolon + 1;
+            }
+            else
+            {
+                // unknown entities are kept as they are
+                *w++ = *r++;
+            }
+        }
+        else
+        {
+            *w++ = *r++;
+        }
+    }
+    return w - text;
 }
 
 CCSAXParser::CCSAXParser()
+: _delegator(NULL)
+, _error(false)
 {
-    _delegator = NULL;
 }
 
 CCSAXParser::~CCSAXParser(void)
@@ -104,27 +252,317 @@ bool CCSAXParser::init(const char *pszEncoding)
 
 bool CCSAXParser::parse(const char* pXMLData, unsigned int uDataLength)
 {
-	tinyxml2::XMLDocument tinyDoc;
-	tinyDoc.Parse(pXMLData, uDataLength);
-	XmlSaxHander printer;
-	printer.setCCSAXParserImp(this);
-	
-	return tinyDoc.Accept( &printer );	
+    std::vector<char> buffer(pXMLData, pXMLData + uDataLength);
+    return parseInSitu(buffer.empty() ? NULL : &buffer[0], uDataLength);
 }
 
 bool CCSAXParser::parse(const char *pszFile)
 {
     bool bRet = false;
-    unsigned long size = 0;
-    char* pBuffer = (char*)CCFileUtils::sharedFileUtils()->getFileData(pszFile, "rt", &size);
-    if (pBuffer != NULL && size > 0)
+    // the view is private, so it can be parsed in place
+    CCFileView* pView = CCFileUtils::sharedFileUtils()->openFileView(pszFile);
+    if (pView != NULL && pView->getSize() > 0)
     {
-        bRet = parse(pBuffer, size);
+        bRet = parseInSitu((char*)pView->getBytes(), pView->getSize());
     }
-    CC_SAFE_DELETE_ARRAY(pBuffer);
+    CC_SAFE_RELEASE(pView);
     return bRet;
 }
 
+bool CCSAXParser::parseInSitu(char* pXMLData, unsigned int uDataLength)
+{
+    reset();
+    bool bRet = tokenize(pXMLData, uDataLength, true) >= 0 && _openElementOffsets.empty();
+    reset();
+    return bRet;
+}
+
+bool CCSAXParser::feed(const char* pChunk, unsigned int uChunkLength)
+{
+    if (_error)
+    {
+        return false;
+    }
+
+    // every token ends with a '>', except the texts which end with a '<': without them, the
+    // pending token can't be complete and is not tokenized again
+    bool incomplete = ! _pending.empty()
+        && memchr(pChunk, '<', uChunkLength) == NULL && memchr(pChunk, '>', uChunkLength) == NULL;
+    _pending.insert(_pending.end(), pChunk, pChunk + uChunkLength);
+    if (incomplete || _pending.empty())
+    {
+        return true;
+    }
+
+    int consumed = tokenize(&_pending[0], _pending.size(), false);
+    if (consumed < 0)
+    {
+        _error = true;
+        return false;
+    }
+    _pending.erase(_pending.begin(), _pending.begin() + consumed);
+    return true;
+}
+
+bool CCSAXParser::finish()
+{
+    bool bRet = ! _error;
+    if (bRet && ! _pending.empty())
+    {
+        bRet = tokenize(&_pending[0], _pending.size(), true) >= 0;
+    }
+    bRet = bRet && _openElementOffsets.empty();
+    reset();
+    return bRet;
+}
+
+void CCSAXParser::reset()
+{
+    _openElements.clear();
+    _openElementOffsets.clear();
+    _pending.clear();
+    _error = false;
+}
+
+int CCSAXParser::tokenize(char* data, unsigned int length, bool isLast)
+{
+    char* p = data;
+    char* end = data + length;
+    while (p < end)
+    {
+        if (*p != '<')
+        {
+            char* textEnd = (char*)memchr(p, '<', end - p);
+            if (textEnd == NULL)
+            {
+                if (! isLast)
+                {
+                    break;
+                }
+                // only whitespace may follow the root element
+                textEnd = end;
+            }
+            else
+            {
+                handleText(p, textEnd);
+            }
+            p = textEnd;
+            continue;
+        }
+
+        // long enough to tell a comment from a CDATA section and a declaration
+        if (end - p < 9 && ! isLast)
+        {
+            break;
+        }
+
+        char* tokenEnd = NULL;
+        if (end - p < 2)
+        {
+            return -1;
+        }
+        else if (p[1] == '?')
+        {
+            tokenEnd = findString(p + 2, end, "?>", 2);
+            if (tokenEnd)
+            {
+                tokenEnd += 1;
+            }
+        }
+        else if (p[1] == '!')
+        {
+            if (end - p >= 4 && memcmp(p, "<!--", 4) == 0)
+            {
+                tokenEnd = findString(p + 4, end, "-->", 3);
+                if (tokenEnd)
+                {
+                    tokenEnd += 2;
+                }
+            }
+            else if (end - p >= 9 && memcmp(p, "<![CDATA[", 9) == 0)
+            {
+                tokenEnd = findString(p + 9, end, "]]>", 3);
+                if (tokenEnd)
+                {
+                    if (! _openElementOffsets.empty())
+                    {
+                        *tokenEnd = '\0';
+                        _delegator->textHandler(this, p + 9, tokenEnd - (p + 9));
+                    }
+                    tokenEnd += 2;
+                }
+            }
+            else
+            {
+                tokenEnd = findDeclarationEnd(p + 2, end);
+            }
+        }
+        else if (p[1] == '/')
+        {
+            tokenEnd = (char*)memchr(p + 2, '>', end - p - 2);
+            if (tokenEnd && ! parseEndTag(p + 2, tokenEnd))
+            {
+                return -1;
+            }
+        }
+        else
+        {
+            tokenEnd = findTagEnd(p + 1, end);
+            if (tokenEnd && ! parseStartTag(p + 1, tokenEnd))
+            {
+                return -1;
+            }
+        }
+
+        if (tokenEnd == NULL)
+        {
+            if (isLast)
+            {
+                return -1;
+            }
+            break;
+        }
+        p = tokenEnd + 1;
+    }
+    return p - data;
+}
+
+bool CCSAXParser::parseStartTag(char* p, char* tagEnd)
+{
+    bool selfClosing = tagEnd > p && tagEnd[-1] == '/';
+    char* contentEnd = selfClosing ? tagEnd - 1 : tagEnd;
+
+    char* name = p;
+    while (p < contentEnd && ! isXMLSpace(*p))
+    {
+        ++p;
+    }
+    char* nameEnd = p;
+    if (nameEnd == name)
+    {
+        return false;
+    }
+
+    _attributes.clear();
+    for (;;)
+    {
+        while (p < contentEnd && isXMLSpace(*p))
+        {
+            ++p;
+        }
+        if (p == contentEnd)
+        {
+            break;
+        }
+
+        char* attributeName = p;
+        while (p < contentEnd && *p != '=' && ! isXMLSpace(*p))
+        {
+            ++p;
+        }
+        char* attributeNameEnd = p;
+        while (p < contentEnd && isXMLSpace(*p))
+        {
+            ++p;
+        }
+        if (p == contentEnd || *p != '=' || attributeNameEnd == attributeName)
+        {
+            return false;
+        }
+        ++p;
+        while (p < contentEnd && isXMLSpace(*p))
+        {
+            ++p;
+        }
+        if (p == contentEnd || (*p != '"' && *p != '\''))
+        {
+            return false;
+        }
+
+        char* value = p + 1;
+        char* valueEnd = (char*)memchr(value, *p, contentEnd - value);
+        if (valueEnd == NULL)
+        {
+            return false;
+        }
+        p = valueEnd + 1;
+
+        *attributeNameEnd = '\0';
+        value[decodeText(value, valueEnd - value)] = '\0';
+        _attributes.push_back(attributeName);
+        _attributes.push_back(value);
+    }
+    _attributes.push_back(NULL);
+    *nameEnd = '\0';
+
+    _delegator->startElement(this, name, &_attributes[0]);
+    if (selfClosing)
+    {
+        _delegator->endElement(this, name);
+    }
+    else
+    {
+        _openElementOffsets.push_back(_openElements.size());
+        _openElements.insert(_openElements.end(), name, nameEnd + 1);
+    }
+    return true;
+}
+
+bool CCSAXParser::parseEndTag(char* p, char* tagEnd)
+{
+    char* name = p;
+    while (p < tagEnd && ! isXMLSpace(*p))
+    {
+        ++p;
+    }
+    char* nameEnd = p;
+    while (p < tagEnd && isXMLSpace(*p))
+    {
+        ++p;
+    }
+    if (p != tagEnd || _openElementOffsets.empty())
+    {
+        return false;
+    }
+
+    unsigned int offset = _openElementOffsets.back();
+    *nameEnd = '\0';
+    if (strcmp(&_openElements[offset], name) != 0)
+    {
+        return false;
+    }
+    _openElementOffsets.pop_back();
+    _openElements.resize(offset);
+
+    _delegator->endElement(this, name);
+    return true;
+}
+
+void CCSAXParser::handleText(char* text, char* textEnd)
+{
+    if (_openElementOffsets.empty())
+    {
+        return;
+    }
+
+    char* p = text;
+    while (p < textEnd && isXMLSpace(*p))
+    {
+        ++p;
+    }
+    if (p == textEnd)
+    {
+        return;
+    }
+
+    // the text is followed by a '<', NUL terminate it during the call
+    int length = decodeText(text, textEnd - text);
+    char end = text[length];
+    text[length] = '\0';
+    _delegator->textHandler(this, text, length);
+    text[length] = end;
+}
+
 void CCSAXParser::startElement(void *ctx, const CC_XML_CHAR *name, const CC_XML_CHAR **atts)
 {
     ((CCSAXParser*)(ctx))->_delegator->startElement(ctx, (char*)name, (const char**)atts);
@@ -144,5 +582,3 @@ void CCSAXParser::setDelegator(CCSAXDelegator* pDelegator)
 }
 
 NS_CC_END
-
-
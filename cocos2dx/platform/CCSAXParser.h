@@ -26,6 +26,7 @@
 
 #include "CCPlatformConfig.h"
 #include "CCCommon.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -44,6 +45,15 @@ public:
     virtual void textHandler(void *ctx, const char *s, int len) = 0;
 };
 
+/** @brief Calls a CCSAXDelegator for the elements and texts of an XML document.
+
+ The document is tokenized in place, without building a tree: the names, attribute values and
+ texts passed to the delegator point into the parsed buffer, which is modified to terminate them
+ and to decode the entities. They are only valid during the callback.
+
+ Texts made only of whitespace are skipped. Comments, processing instructions and DOCTYPE
+ declarations are ignored, CDATA sections are passed as texts.
+ */
 class CC_DLL CCSAXParser
 {
     CCSAXDelegator*    _delegator;
@@ -53,13 +63,50 @@ public:
     ~CCSAXParser(void);
 
     bool init(const char *pszEncoding);
+    /** Parses a copy of the data. */
     bool parse(const char* pXMLData, unsigned int uDataLength);
+    /** Parses a file in place, in the private view returned by CCFileUtils::openFileView. */
     bool parse(const char *pszFile);
+    /** Parses a complete document in place, the data is modified.
+     @since v3.0
+     */
+    bool parseInSitu(char* pXMLData, unsigned int uDataLength);
+
+    /** Parses the next chunk of a streamed document. The delegator is called for every complete
+     token, the incomplete end of the chunk is kept until the next one.
+     @return false if the document is malformed
+     @since v3.0
+     */
+    bool feed(const char* pChunk, unsigned int uChunkLength);
+    /** Ends a streamed document and resets the parser for the next one.
+     @return false if the document is malformed or incomplete
+     @since v3.0
+     */
+    bool finish();
+
     void setDelegator(CCSAXDelegator* pDelegator);
 
     static void startElement(void *ctx, const CC_XML_CHAR *name, const CC_XML_CHAR **atts);
     static void endElement(void *ctx, const CC_XML_CHAR *name);
     static void textHandler(void *ctx, const CC_XML_CHAR *name, int len);
+
+private:
+    void reset();
+    /** Calls the delegator for the complete tokens of data, all of them if isLast is true.
+     Returns the number of bytes consumed, or -1 if the data is malformed.
+     */
+    int tokenize(char* data, unsigned int length, bool isLast);
+    bool parseStartTag(char* p, char* tagEnd);
+    bool parseEndTag(char* p, char* tagEnd);
+    void handleText(char* text, char* textEnd);
+
+    // names of the open elements, each followed by a NUL
+    std::vector<char> _openElements;
+    std::vector<unsigned int> _openElementOffsets;
+    std::vector<const char*> _attributes;
+    // streamed data not tokenized yet
+    std::vector<char> _pending;
+    bool _error;
 };
 
 // end of platform group
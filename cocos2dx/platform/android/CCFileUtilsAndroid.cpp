@@ -159,6 +159,16 @@ unsigned char* CCFileUtilsAndroid::getFileData(const char* pszFileName, const ch
     return pData;
 }
 
+CCFileView* CCFileUtilsAndroid::openMappedFileView(const std::string& fullPath)
+{
+    // the relative paths are read from the apk by getFileData
+    if (fullPath.empty() || fullPath[0] != '/')
+    {
+        return NULL;
+    }
+    return mapFileView(fullPath, typeid(CCFileUtilsAndroid));
+}
+
 string CCFileUtilsAndroid::getWritablePath()
 {
     // Fix for Nexus 10 (Android 4.2 multi-user environment)
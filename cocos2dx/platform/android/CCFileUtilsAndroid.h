@@ -52,6 +52,9 @@ public:
     virtual std::string getWritablePath();
     virtual bool isFileExist(const std::string& strFilePath);
     virtual bool isAbsolutePath(const std::string& strPath);
+
+protected:
+    virtual CCFileView* openMappedFileView(const std::string& fullPath);
 };
 
 // end of platform group
@@ -49,6 +49,7 @@ public:
     virtual std::string getFullPathForDirectoryAndFilename(const std::string& strDirectory, const std::string& strFilename);
     
     virtual CCDictionary* createCCDictionaryWithContentsOfFile(const std::string& filename);
+    virtual CCDictionary* createCCDictionaryWithFileView(CCFileView* pView);
     virtual bool writeToFile(CCDictionary *dict, const std::string& fullPath);
     
     virtual CCArray* createCCArrayWithContentsOfFile(const std::string& filename);
@@ -7,8 +7,13 @@
 #include "CCApplication.h"
 #include <unistd.h>
 #include <sys/time.h>
+#include <time.h>
+#include <errno.h>
+#include <stdio.h>
 #include <string>
+#include <algorithm>
 #include "CCDirector.h"
+#include "CCEGLView.h"
 #include "platform/CCFileUtils.h"
 
 NS_CC_BEGIN
@@ -17,16 +22,33 @@ NS_CC_BEGIN
 // sharedApplication pointer
 CCApplication * CCApplication::sm_pSharedApplication = 0;
 
-static long getCurrentMillSecond() {
-	long lLastTime;
-	struct timeval stCurrentTime;
+static const long long kNanosecondsPerSecond = 1000000000LL;
 
-	gettimeofday(&stCurrentTime,NULL);
-	lLastTime = stCurrentTime.tv_sec*1000+stCurrentTime.tv_usec*0.001; //millseconds
-	return lLastTime;
+// frames measured before the adaptive frame rate changes the frame interval
+static const unsigned int kAdaptiveWindowFrames = 60;
+// the frame interval is at most this many animation intervals
+static const unsigned int kMaxFrameIntervalMultiplier = 4;
+
+static long long getMonotonicNanoseconds() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * kNanosecondsPerSecond + now.tv_nsec;
+}
+
+static double getMonotonicMillisecond() {
+	return getMonotonicNanoseconds() / 1000000.0;
 }
 
 CCApplication::CCApplication()
+: _animationInterval(kNanosecondsPerSecond / 60)
+, _spinTime(kNanosecondsPerSecond / 500)
+, _adaptiveFrameRate(false)
+, _frameIntervalMultiplier(1)
+, _windowFrames(0)
+, _windowLateFrames(0)
+, _windowWorkTime(0)
+, _benchmarkFrames(0)
+, _benchmarkWarmupFrames(60)
 {
 	CC_ASSERT(! sm_pSharedApplication);
 	sm_pSharedApplication = this;
@@ -36,7 +58,6 @@ CCApplication::~CCApplication()
 {
 	CC_ASSERT(this == sm_pSharedApplication);
 	sm_pSharedApplication = NULL;
-	_animationInterval = 1.0f/60.0f*1000.0f;
 }
 
 int CCApplication::run()
@@ -47,23 +68,247 @@ int CCApplication::run()
 		return 0;
 	}
 
+	if (_benchmarkFrames > 0)
+	{
+		return runBenchmark();
+	}
 
+	// Every frame has a deadline, one frame interval after the previous one, so the
+	// time lost oversleeping is taken from the next frame instead of accumulating.
+	long long deadline = getMonotonicNanoseconds() + getFrameIntervalNanoseconds();
 	for (;;) {
-		long iLastTime = getCurrentMillSecond();
+		long long frameStart = getMonotonicNanoseconds();
 		CCDirector::sharedDirector()->mainLoop();
-		long iCurTime = getCurrentMillSecond();
-		if (iCurTime-iLastTime<_animationInterval){
-			usleep((_animationInterval - iCurTime+iLastTime)*1000);
+		long long now = getMonotonicNanoseconds();
+
+		long long frameInterval = getFrameIntervalNanoseconds();
+		bool late = now > deadline;
+		if (_adaptiveFrameRate)
+		{
+			adaptFrameInterval(now - frameStart, late);
 		}
 
+		if (now - deadline > frameInterval)
+		{
+			// too late to catch up, start a new schedule rather than rushing the next frames
+			deadline = now;
+		}
+		else
+		{
+			waitUntil(deadline);
+		}
+
+		// the next frame uses the interval chosen by the adaptive frame rate
+		deadline += getFrameIntervalNanoseconds();
 	}
 	return -1;
 }
 
+void CCApplication::waitUntil(long long deadline)
+{
+	// sleep until shortly before the deadline, the scheduler may wake us up late,
+	// then spin for the remaining time
+	long long wakeUp = deadline - _spinTime;
+	if (getMonotonicNanoseconds() < wakeUp)
+	{
+		struct timespec time;
+		time.tv_sec = wakeUp / kNanosecondsPerSecond;
+		time.tv_nsec = wakeUp % kNanosecondsPerSecond;
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, NULL) == EINTR)
+		{
+		}
+	}
+
+	while (getMonotonicNanoseconds() < deadline)
+	{
+	}
+}
+
+void CCApplication::adaptFrameInterval(long long workTime, bool late)
+{
+	++_windowFrames;
+	_windowWorkTime += workTime;
+	if (late)
+	{
+		++_windowLateFrames;
+	}
+
+	if (_windowFrames < kAdaptiveWindowFrames)
+	{
+		return;
+	}
+
+	long long averageWorkTime = _windowWorkTime / _windowFrames;
+	unsigned int multiplier = _frameIntervalMultiplier;
+	if (_windowLateFrames > _windowFrames / 10 && multiplier < kMaxFrameIntervalMultiplier)
+	{
+		// more than 10% of the frames missed their deadline: 60 fps becomes 30, then 20 and 15
+		++multiplier;
+	}
+	else if (multiplier > 1 && averageWorkTime < _animationInterval * (multiplier - 1) * 7 / 10)
+	{
+		// the faster rate would leave a 30% margin
+		--multiplier;
+	}
+
+	if (multiplier != _frameIntervalMultiplier)
+	{
+		_frameIntervalMultiplier = multiplier;
+		CCLOG("cocos2d: adaptive frame rate: %.1f fps", kNanosecondsPerSecond / (double)getFrameIntervalNanoseconds());
+	}
+
+	_windowFrames = 0;
+	_windowLateFrames = 0;
+	_windowWorkTime = 0;
+}
+
+long long CCApplication::getFrameIntervalNanoseconds() const
+{
+	return _animationInterval * _frameIntervalMultiplier;
+}
+
+double CCApplication::getFrameInterval() const
+{
+	return getFrameIntervalNanoseconds() / (double)kNanosecondsPerSecond;
+}
+
+void CCApplication::setAdaptiveFrameRate(bool enabled)
+{
+	_adaptiveFrameRate = enabled;
+	_frameIntervalMultiplier = 1;
+	_windowFrames = 0;
+	_windowLateFrames = 0;
+	_windowWorkTime = 0;
+}
+
+bool CCApplication::isAdaptiveFrameRate() const
+{
+	return _adaptiveFrameRate;
+}
+
+void CCApplication::setSpinTime(double seconds)
+{
+	_spinTime = (long long)(MAX(0, seconds) * kNanosecondsPerSecond);
+}
+
+double CCApplication::getSpinTime() const
+{
+	return _spinTime / (double)kNanosecondsPerSecond;
+}
+
+int CCApplication::runBenchmark()
+{
+	CCDirector *director = CCDirector::sharedDirector();
+	director->setFixedDeltaTime(director->getAnimationInterval());
+
+	for (unsigned int i = 0; i < _benchmarkWarmupFrames; ++i)
+	{
+		director->mainLoop();
+	}
+
+	std::vector<double> frameTimes(_benchmarkFrames);
+	double start = getMonotonicMillisecond();
+	double frameStart = start;
+	for (unsigned int i = 0; i < _benchmarkFrames; ++i)
+	{
+		director->mainLoop();
+		double frameEnd = getMonotonicMillisecond();
+		frameTimes[i] = frameEnd - frameStart;
+		frameStart = frameEnd;
+	}
+	double total = frameStart - start;
+
+	// nearest rank percentiles
+	std::sort(frameTimes.begin(), frameTimes.end());
+	const double ranks[] = { 0.5, 0.9, 0.95, 0.99 };
+	double percentiles[4];
+	for (int i = 0; i < 4; ++i)
+	{
+		size_t rank = (size_t)(ranks[i] * frameTimes.size() + 0.999999);
+		percentiles[i] = frameTimes[MAX(rank, (size_t)1) - 1];
+	}
+	double mean = total / frameTimes.size();
+
+	CCLog("benchmark: %u frames in %.1f ms, %.1f fps", _benchmarkFrames, total, 1000.0 * frameTimes.size() / total);
+	CCLog("benchmark: frame time (ms) mean %.3f min %.3f p50 %.3f p90 %.3f p95 %.3f p99 %.3f max %.3f",
+		mean, frameTimes.front(), percentiles[0], percentiles[1], percentiles[2], percentiles[3], frameTimes.back());
+
+	int ret = 0;
+	if (!_benchmarkOutput.empty())
+	{
+		FILE *file = fopen(_benchmarkOutput.c_str(), "w");
+		if (file)
+		{
+			fprintf(file, "{\"frames\": %u, \"total_ms\": %.3f, \"mean_ms\": %.3f, \"min_ms\": %.3f, "
+				"\"p50_ms\": %.3f, \"p90_ms\": %.3f, \"p95_ms\": %.3f, \"p99_ms\": %.3f, \"max_ms\": %.3f}\n",
+				_benchmarkFrames, total, mean, frameTimes.front(),
+				percentiles[0], percentiles[1], percentiles[2], percentiles[3], frameTimes.back());
+			fclose(file);
+		}
+		else
+		{
+			CCLog("benchmark: can't write %s", _benchmarkOutput.c_str());
+			ret = 1;
+		}
+	}
+
+	director->setFixedDeltaTime(0);
+	return ret;
+}
+
+void CCApplication::parseCommandLine(int argc, char **argv)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string argument = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (argument == "--headless")
+		{
+			CCEGLView::sharedOpenGLView()->setBackend(kCCEGLViewBackendOffscreen);
+		}
+		else if (argument == "--null-renderer")
+		{
+			CCEGLView::sharedOpenGLView()->setBackend(kCCEGLViewBackendNull);
+		}
+		else if (argument == "--benchmark" && hasValue)
+		{
+			_benchmarkFrames = (unsigned int)atoi(argv[++i]);
+		}
+		else if (argument == "--warmup" && hasValue)
+		{
+			_benchmarkWarmupFrames = (unsigned int)atoi(argv[++i]);
+		}
+		else if (argument == "--benchmark-output" && hasValue)
+		{
+			_benchmarkOutput = argv[++i];
+		}
+		else
+		{
+			_arguments.push_back(argument);
+		}
+	}
+}
+
+const std::vector<std::string>& CCApplication::getArguments() const
+{
+	return _arguments;
+}
+
+void CCApplication::setBenchmarkFrames(unsigned int frames, unsigned int warmupFrames)
+{
+	_benchmarkFrames = frames;
+	_benchmarkWarmupFrames = warmupFrames;
+}
+
+void CCApplication::setBenchmarkOutput(const std::string& path)
+{
+	_benchmarkOutput = path;
+}
+
 void CCApplication::setAnimationInterval(double interval)
 {
-	//TODO do something else
-	_animationInterval = interval*1000.0f;
+	_animationInterval = (long long)(interval * kNanosecondsPerSecond);
 }
 
 void CCApplication::setResourceRootPath(const std::string& rootResDir)
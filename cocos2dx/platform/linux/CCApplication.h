@@ -11,6 +11,7 @@
 #include "platform/CCCommon.h"
 #include "platform/CCApplicationProtocol.h"
 #include <string>
+#include <vector>
 
 NS_CC_BEGIN
 class CCRect;
@@ -27,11 +28,57 @@ public:
 	 */
 	void setAnimationInterval(double interval);
 
+	/**
+	 @brief Lowers the frame rate when the frames can't be rendered in time: a 60 fps animation
+	 interval then runs at 30, 20 or 15 fps, and goes back up when the frames become fast enough.
+	 Disabled by default.
+	 @since v3.0
+	 */
+	void setAdaptiveFrameRate(bool enabled);
+	bool isAdaptiveFrameRate() const;
+
+	/**
+	 @brief Time between two frames in seconds, the animation interval or a multiple of it with the
+	 adaptive frame rate.
+	 @since v3.0
+	 */
+	double getFrameInterval() const;
+
+	/**
+	 @brief Time before the start of a frame during which the main loop spins instead of sleeping,
+	 to start the frame on time despite the wake up latency of the scheduler. 2 ms by default.
+	 @since v3.0
+	 */
+	void setSpinTime(double seconds);
+	double getSpinTime() const;
+
 	/**
 	 @brief	Run the message loop.
 	 */
 	int run();
 
+	/**
+	 @brief Parses the options of the linux backend, before run() and CCEGLView::setFrameSize():
+	   --headless               renders offscreen, without a window
+	   --null-renderer          plays the frames offscreen without drawing them
+	   --benchmark FRAMES       plays FRAMES frames as fast as possible, logs their times and quits
+	   --warmup FRAMES          frames played before the measured ones, 60 by default
+	   --benchmark-output FILE  also writes the results of the benchmark to FILE, in JSON
+	 The other arguments are kept for the application, see getArguments().
+	 @since v3.0
+	 */
+	void parseCommandLine(int argc, char **argv);
+	const std::vector<std::string>& getArguments() const;
+
+	/**
+	 @brief Makes run() play a number of frames as fast as possible, log the percentiles of
+	 their times and quit; 0 runs the application normally. The frames use a fixed delta time,
+	 the animation interval, so that every run plays the same frames.
+	 @since v3.0
+	 */
+	void setBenchmarkFrames(unsigned int frames, unsigned int warmupFrames = 60);
+	void setBenchmarkOutput(const std::string& path);
+
 	/**
 	 @brief	Get current applicaiton instance.
 	 @return Current application instance pointer.
@@ -58,8 +105,23 @@ public:
      */
     virtual TargetPlatform getTargetPlatform();
 protected:
-    long       _animationInterval;  //micro second
+    int runBenchmark();
+    void waitUntil(long long deadline);
+    void adaptFrameInterval(long long workTime, bool late);
+    long long getFrameIntervalNanoseconds() const;
+
+    long long  _animationInterval;  // nanoseconds
+    long long  _spinTime;           // nanoseconds
+    bool       _adaptiveFrameRate;
+    unsigned int _frameIntervalMultiplier;
+    unsigned int _windowFrames;
+    unsigned int _windowLateFrames;
+    long long  _windowWorkTime;
     std::string _resourceRootPath;
+    std::vector<std::string> _arguments;
+    unsigned int _benchmarkFrames;
+    unsigned int _benchmarkWarmupFrames;
+    std::string _benchmarkOutput;
     
 	static CCApplication * sm_pSharedApplication;
 };
@@ -16,6 +16,80 @@
 #ifdef KEYBOARD_SUPPORT
 #include "keyboard_dispatcher/CCKeyboardDispatcher.h"
 #endif
+#include <dlfcn.h>
+#include <string.h>
+
+// the real functions, the null backend replaces the pointers of CCGL.h
+#undef glDrawArrays
+#undef glDrawElements
+#undef glClear
+
+CC_PFNGLDRAWARRAYSPROC ccglDrawArrays = glDrawArrays;
+CC_PFNGLDRAWELEMENTSPROC ccglDrawElements = glDrawElements;
+CC_PFNGLCLEARPROC ccglClear = glClear;
+
+static void nullDrawArrays(GLenum mode, GLint first, GLsizei count) {}
+static void nullDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices) {}
+static void nullClear(GLbitfield mask) {}
+
+// EGL is loaded at runtime, only the offscreen backends need it
+#define CC_EGL_NONE                         0x3038
+#define CC_EGL_EXTENSIONS                   0x3055
+#define CC_EGL_SURFACE_TYPE                 0x3033
+#define CC_EGL_PBUFFER_BIT                  0x0001
+#define CC_EGL_RENDERABLE_TYPE              0x3040
+#define CC_EGL_OPENGL_BIT                   0x0008
+#define CC_EGL_RED_SIZE                     0x3024
+#define CC_EGL_GREEN_SIZE                   0x3023
+#define CC_EGL_BLUE_SIZE                    0x3022
+#define CC_EGL_ALPHA_SIZE                   0x3021
+#define CC_EGL_DEPTH_SIZE                   0x3025
+#define CC_EGL_STENCIL_SIZE                 0x3026
+#define CC_EGL_WIDTH                        0x3057
+#define CC_EGL_HEIGHT                       0x3056
+#define CC_EGL_OPENGL_API                   0x30A2
+#define CC_EGL_PLATFORM_SURFACELESS_MESA    0x31DD
+
+static struct
+{
+    void *library;
+    void *display;
+    void *surface;
+    void *context;
+
+    void* (*getProcAddress)(const char *name);
+    const char* (*queryString)(void *display, int name);
+    void* (*getDisplay)(void *nativeDisplay);
+    unsigned int (*initialize)(void *display, int *major, int *minor);
+    unsigned int (*chooseConfig)(void *display, const int *attributes, void **configs, int size, int *count);
+    unsigned int (*bindAPI)(unsigned int api);
+    void* (*createPbufferSurface)(void *display, void *config, const int *attributes);
+    void* (*createContext)(void *display, void *config, void *shareContext, const int *attributes);
+    unsigned int (*makeCurrent)(void *display, void *draw, void *read, void *context);
+    unsigned int (*destroySurface)(void *display, void *surface);
+    unsigned int (*destroyContext)(void *display, void *context);
+    unsigned int (*terminate)(void *display);
+    int (*getError)(void);
+} s_egl;
+
+static void* getProcAddress(const char *name)
+{
+    if (s_egl.context)
+    {
+        return s_egl.getProcAddress(name);
+    }
+    return glfwGetProcAddress(name);
+}
+
+static bool isExtensionSupported(const char *name)
+{
+    if (s_egl.context)
+    {
+        const char *extensions = (const char*)glGetString(GL_EXTENSIONS);
+        return extensions && strstr(extensions, name);
+    }
+    return glfwExtensionSupported(name) != GL_FALSE;
+}
 
 PFNGLGENFRAMEBUFFERSEXTPROC glGenFramebuffersEXT = NULL;
 PFNGLDELETEFRAMEBUFFERSEXTPROC glDeleteFramebuffersEXT = NULL;
@@ -31,7 +105,7 @@ PFNGLBUFFERSUBDATAARBPROC glBufferSubDataARB = NULL;
 PFNGLDELETEBUFFERSARBPROC glDeleteBuffersARB = NULL;
 
 bool initExtensions() {
-#define LOAD_EXTENSION_FUNCTION(TYPE, FN)  FN = (TYPE)glfwGetProcAddress(#FN);
+#define LOAD_EXTENSION_FUNCTION(TYPE, FN)  FN = (TYPE)getProcAddress(#FN);
 	bool bRet = false;
 	do {
 
@@ -39,7 +113,7 @@ bool initExtensions() {
 //		printf(p);
 
 		/* Supports frame buffer? */
-		if (glfwExtensionSupported("GL_EXT_framebuffer_object") != GL_FALSE)
+		if (isExtensionSupported("GL_EXT_framebuffer_object"))
 		{
 
 			/* Loads frame buffer extension functions */
@@ -60,7 +134,7 @@ bool initExtensions() {
 			break;
 		}
 
-		if (glfwExtensionSupported("GL_ARB_vertex_buffer_object") != GL_FALSE) {
+		if (isExtensionSupported("GL_ARB_vertex_buffer_object")) {
 			LOAD_EXTENSION_FUNCTION(PFNGLGENBUFFERSARBPROC, glGenBuffersARB);
 			LOAD_EXTENSION_FUNCTION(PFNGLBINDBUFFERARBPROC, glBindBufferARB);
 			LOAD_EXTENSION_FUNCTION(PFNGLBUFFERDATAARBPROC, glBufferDataARB);
@@ -81,6 +155,7 @@ NS_CC_BEGIN
 CCEGLView::CCEGLView()
 : bIsInit(false)
 , _frameZoomFactor(1.0f)
+, _backend(kCCEGLViewBackendWindow)
 {
 }
 
@@ -183,6 +258,32 @@ void CCEGLView::setFrameSize(float width, float height)
 	//check
 	CCAssert(width!=0&&height!=0, "invalid window's size equal 0");
 
+	if (_backend != kCCEGLViewBackendWindow)
+	{
+		if (!initOffscreen((int)width, (int)height))
+		{
+			CCAssert(0, "fail to create the offscreen context");
+			return;
+		}
+
+		CCEGLViewProtocol::setFrameSize(width, height);
+		bIsInit = true;
+
+		eResult = initExtensions();
+		if (!eResult) {
+			CCAssert(0, "fail to init the extensions of opengl");
+		}
+		initGL();
+
+		if (_backend == kCCEGLViewBackendNull)
+		{
+			ccglDrawArrays = nullDrawArrays;
+			ccglDrawElements = nullDrawElements;
+			ccglClear = nullClear;
+		}
+		return;
+	}
+
 	//Inits GLFW
 	eResult = glfwInit() != GL_FALSE;
 
@@ -268,7 +369,10 @@ void CCEGLView::setFrameSize(float width, float height)
 void CCEGLView::setFrameZoomFactor(float fZoomFactor)
 {
     _frameZoomFactor = fZoomFactor;
-    glfwSetWindowSize(_screenSize.width * fZoomFactor, _screenSize.height * fZoomFactor);
+    if (_backend == kCCEGLViewBackendWindow)
+    {
+        glfwSetWindowSize(_screenSize.width * fZoomFactor, _screenSize.height * fZoomFactor);
+    }
     CCDirector::sharedDirector()->setProjection(CCDirector::sharedDirector()->getProjection());
 }
 
@@ -277,6 +381,17 @@ float CCEGLView::getFrameZoomFactor()
     return _frameZoomFactor;
 }
 
+void CCEGLView::setBackend(ccEGLViewBackend backend)
+{
+    CCAssert(!bIsInit, "the backend must be set before setFrameSize");
+    _backend = backend;
+}
+
+ccEGLViewBackend CCEGLView::getBackend() const
+{
+    return _backend;
+}
+
 void CCEGLView::setViewPortInPoints(float x , float y , float w , float h)
 {
     glViewport((GLint)(x * _scaleX * _frameZoomFactor+ _viewPortRect.origin.x * _frameZoomFactor),
@@ -301,16 +416,31 @@ bool CCEGLView::isOpenGLReady()
 
 void CCEGLView::end()
 {
-	/* Exits from GLFW */
-	glfwTerminate();
+	if (_backend == kCCEGLViewBackendWindow)
+	{
+		/* Exits from GLFW */
+		glfwTerminate();
+	}
+	else
+	{
+		destroyGL();
+	}
 	delete this;
 	exit(0);
 }
 
 void CCEGLView::swapBuffers() {
 	if (bIsInit) {
-		/* Swap buffers */
-		glfwSwapBuffers();
+		if (_backend == kCCEGLViewBackendWindow)
+		{
+			/* Swap buffers */
+			glfwSwapBuffers();
+		}
+		else if (_backend == kCCEGLViewBackendOffscreen)
+		{
+			// nothing to present, wait for the frame to be rendered so that it is measured
+			glFinish();
+		}
 	}
 }
 
@@ -321,6 +451,13 @@ void CCEGLView::setIMEKeyboardState(bool bOpen) {
 bool CCEGLView::initGL()
 {
     GLenum GlewInitResult = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // glewInit also loads the GLX extensions, which don't exist without a window
+    if (GlewInitResult == GLEW_ERROR_NO_GLX_DISPLAY && _backend != kCCEGLViewBackendWindow)
+    {
+        GlewInitResult = GLEW_OK;
+    }
+#endif
     if (GLEW_OK != GlewInitResult) 
     {
         fprintf(stderr,"ERROR: %s\n",glewGetErrorString(GlewInitResult));
@@ -353,14 +490,120 @@ bool CCEGLView::initGL()
 
 void CCEGLView::destroyGL()
 {
-	/*
-    if (_DC != NULL && _RC != NULL)
+    if (s_egl.display)
+    {
+        s_egl.makeCurrent(s_egl.display, NULL, NULL, NULL);
+        if (s_egl.context)
+        {
+            s_egl.destroyContext(s_egl.display, s_egl.context);
+        }
+        if (s_egl.surface)
+        {
+            s_egl.destroySurface(s_egl.display, s_egl.surface);
+        }
+        s_egl.terminate(s_egl.display);
+    }
+    if (s_egl.library)
+    {
+        dlclose(s_egl.library);
+    }
+    memset(&s_egl, 0, sizeof(s_egl));
+}
+
+bool CCEGLView::initOffscreen(int width, int height)
+{
+    s_egl.library = dlopen("libEGL.so.1", RTLD_NOW | RTLD_GLOBAL);
+    if (!s_egl.library)
+    {
+        CCLOG("cocos2d: can't load libEGL: %s", dlerror());
+        return false;
+    }
+
+#define LOAD_EGL_FUNCTION(FN, NAME) \
+    *(void**)&s_egl.FN = dlsym(s_egl.library, NAME); \
+    if (!s_egl.FN) { CCLOG("cocos2d: %s not found in libEGL", NAME); destroyGL(); return false; }
+
+    LOAD_EGL_FUNCTION(getProcAddress, "eglGetProcAddress");
+    LOAD_EGL_FUNCTION(queryString, "eglQueryString");
+    LOAD_EGL_FUNCTION(getDisplay, "eglGetDisplay");
+    LOAD_EGL_FUNCTION(initialize, "eglInitialize");
+    LOAD_EGL_FUNCTION(chooseConfig, "eglChooseConfig");
+    LOAD_EGL_FUNCTION(bindAPI, "eglBindAPI");
+    LOAD_EGL_FUNCTION(createPbufferSurface, "eglCreatePbufferSurface");
+    LOAD_EGL_FUNCTION(createContext, "eglCreateContext");
+    LOAD_EGL_FUNCTION(makeCurrent, "eglMakeCurrent");
+    LOAD_EGL_FUNCTION(destroySurface, "eglDestroySurface");
+    LOAD_EGL_FUNCTION(destroyContext, "eglDestroyContext");
+    LOAD_EGL_FUNCTION(terminate, "eglTerminate");
+    LOAD_EGL_FUNCTION(getError, "eglGetError");
+#undef LOAD_EGL_FUNCTION
+
+    // the surfaceless platform of Mesa doesn't need a display server
+    const char *clientExtensions = s_egl.queryString(NULL, CC_EGL_EXTENSIONS);
+    if (clientExtensions && strstr(clientExtensions, "EGL_MESA_platform_surfaceless"))
+    {
+        typedef void* (*GetPlatformDisplayFunction)(unsigned int platform, void *nativeDisplay, const int *attributes);
+        GetPlatformDisplayFunction getPlatformDisplay = (GetPlatformDisplayFunction)s_egl.getProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay)
+        {
+            s_egl.display = getPlatformDisplay(CC_EGL_PLATFORM_SURFACELESS_MESA, NULL, NULL);
+        }
+    }
+    if (!s_egl.display)
+    {
+        s_egl.display = s_egl.getDisplay(NULL);
+    }
+
+    int major = 0, minor = 0;
+    if (!s_egl.display || !s_egl.initialize(s_egl.display, &major, &minor))
+    {
+        CCLOG("cocos2d: can't initialize EGL: 0x%x", s_egl.getError());
+        s_egl.display = NULL;
+        destroyGL();
+        return false;
+    }
+
+    const int configAttributes[] = {
+        CC_EGL_SURFACE_TYPE, CC_EGL_PBUFFER_BIT,
+        CC_EGL_RENDERABLE_TYPE, CC_EGL_OPENGL_BIT,
+        CC_EGL_RED_SIZE, 8,
+        CC_EGL_GREEN_SIZE, 8,
+        CC_EGL_BLUE_SIZE, 8,
+        CC_EGL_ALPHA_SIZE, 8,
+        CC_EGL_DEPTH_SIZE, 24,
+        CC_EGL_STENCIL_SIZE, 8,
+        CC_EGL_NONE
+    };
+    const int surfaceAttributes[] = {
+        CC_EGL_WIDTH, width,
+        CC_EGL_HEIGHT, height,
+        CC_EGL_NONE
+    };
+    const int contextAttributes[] = {
+        CC_EGL_NONE
+    };
+
+    void *config = NULL;
+    int count = 0;
+    bool ok = s_egl.bindAPI(CC_EGL_OPENGL_API)
+        && s_egl.chooseConfig(s_egl.display, configAttributes, &config, 1, &count) && count > 0;
+    if (ok)
     {
-        // deselect rendering context and delete it
-        wglMakeCurrent(_DC, NULL);
-        wglDeleteContext(_RC);
+        s_egl.surface = s_egl.createPbufferSurface(s_egl.display, config, surfaceAttributes);
+        s_egl.context = s_egl.createContext(s_egl.display, config, NULL, contextAttributes);
+        ok = s_egl.surface && s_egl.context
+            && s_egl.makeCurrent(s_egl.display, s_egl.surface, s_egl.surface, s_egl.context);
     }
-	*/
+
+    if (!ok)
+    {
+        CCLOG("cocos2d: can't create the offscreen OpenGL context: 0x%x", s_egl.getError());
+        destroyGL();
+        return false;
+    }
+
+    CCLOG("cocos2d: offscreen OpenGL context, EGL %d.%d, %s", major, minor, (const char*)glGetString(GL_RENDERER));
+    return true;
 }
 
 CCEGLView* CCEGLView::sharedOpenGLView()
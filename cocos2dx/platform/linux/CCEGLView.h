@@ -16,6 +16,21 @@ bool initExtensions();
 
 NS_CC_BEGIN
 
+/** How the linux view renders the frames.
+ @since v3.0
+ */
+typedef enum
+{
+    /** In a GLFW window. */
+    kCCEGLViewBackendWindow,
+    /** In an offscreen EGL pbuffer, without any window nor display. Mesa renders it on the CPU
+     when there is no GPU, so the frames can be benchmarked on build servers. */
+    kCCEGLViewBackendOffscreen,
+    /** Like kCCEGLViewBackendOffscreen, but the draw calls and the clears are skipped: the frames
+     still visit the nodes and set the GL states, without the cost of the rasterization. */
+    kCCEGLViewBackendNull,
+} ccEGLViewBackend;
+
 class CCEGLView : public CCEGLViewProtocol{
 public:
 	CCEGLView();
@@ -40,6 +55,13 @@ public:
 	 */
 	void setFrameZoomFactor(float fZoomFactor);
 	float getFrameZoomFactor();
+
+	/** Sets the backend used by setFrameSize, kCCEGLViewBackendWindow by default.
+	 @since v3.0
+	 */
+	void setBackend(ccEGLViewBackend backend);
+	ccEGLViewBackend getBackend() const;
+
 	virtual bool isOpenGLReady();
 	virtual void end();
 	virtual void swapBuffers();
@@ -52,11 +74,13 @@ public:
 private:
 	bool initGL();
 	void destroyGL();
+	bool initOffscreen(int width, int height);
 private:
 	//store current mouse point for moving, valid if and only if the mouse pressed
 	CCPoint _mousePoint;
 	bool bIsInit;
 	float _frameZoomFactor;
+	ccEGLViewBackend _backend;
 };
 
 NS_CC_END
@@ -90,4 +90,10 @@ bool CCFileUtilsLinux::isFileExist(const std::string& strFilePath)
     return (stat(strPath.c_str(), &sts) != -1) ? true : false;
 }
 
+CCFileView* CCFileUtilsLinux::openMappedFileView(const std::string& fullPath)
+{
+    // the files are read from disk by getFileData, unless a derived class overrides it
+    return mapFileView(fullPath, typeid(CCFileUtilsLinux));
+}
+
 NS_CC_END
@@ -49,6 +49,9 @@ public:
     bool init();
     virtual std::string getWritablePath();
     virtual bool isFileExist(const std::string& strFilePath);
+
+protected:
+    virtual CCFileView* openMappedFileView(const std::string& fullPath);
 };
 
 // end of platform group
@@ -29,4 +29,18 @@ THE SOFTWARE.
 
 #define CC_GL_DEPTH24_STENCIL8		GL_DEPTH24_STENCIL8
 
+// The draw calls and the clears go through these pointers, so that the null backend
+// of CCEGLView can skip them. They point to the GL functions by default.
+typedef void (*CC_PFNGLDRAWARRAYSPROC)(GLenum mode, GLint first, GLsizei count);
+typedef void (*CC_PFNGLDRAWELEMENTSPROC)(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices);
+typedef void (*CC_PFNGLCLEARPROC)(GLbitfield mask);
+
+extern CC_PFNGLDRAWARRAYSPROC ccglDrawArrays;
+extern CC_PFNGLDRAWELEMENTSPROC ccglDrawElements;
+extern CC_PFNGLCLEARPROC ccglClear;
+
+#define glDrawArrays                ccglDrawArrays
+#define glDrawElements              ccglDrawElements
+#define glClear                     ccglClear
+
 #endif // __CCGL_H__
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include <stack>
 #include "cocoa/CCString.h"
 #include "CCFileUtils.h"
+#include "CCFileView.h"
 #include "CCDirector.h"
 #include "CCSAXParser.h"
 #include "CCDictionary.h"
@@ -308,6 +309,25 @@ CCDictionary* CCFileUtilsMac::createCCDictionaryWithContentsOfFile(const std::st
     return pRet;
 }
 
+CCDictionary* CCFileUtilsMac::createCCDictionaryWithFileView(CCFileView* pView)
+{
+    NSData* pData = [NSData dataWithBytesNoCopy:(void*)pView->getBytes() length:pView->getSize() freeWhenDone:NO];
+    id pList = [NSPropertyListSerialization propertyListWithData:pData options:NSPropertyListImmutable format:NULL error:NULL];
+    if (! [pList isKindOfClass:[NSDictionary class]])
+    {
+        return NULL;
+    }
+    
+    NSDictionary* pDict = (NSDictionary*)pList;
+    CCDictionary* pRet = new CCDictionary();
+    for (id key in [pDict allKeys]) {
+        id value = [pDict objectForKey:key];
+        addValueToCCDict(key, value, pRet);
+    }
+    
+    return pRet;
+}
+
 bool CCFileUtilsMac::writeToFile(CCDictionary *dict, const std::string &fullPath)
 {
     CCLOG("iOS||Mac CCDictionary %d write to file %s", dict->_ID, fullPath.c_str());
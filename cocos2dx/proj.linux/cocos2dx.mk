@@ -104,7 +104,7 @@ SHAREDLIBS += -lglfw -lGLEW -lfontconfig -lpthread -lGL
 SHAREDLIBS += -L$(FMOD_LIBDIR) -Wl,-rpath,$(abspath $(FMOD_LIBDIR))
 SHAREDLIBS += -L$(LIB_DIR) -Wl,-rpath,$(abspath $(LIB_DIR))
 
-LIBS = -lrt -lz -lX11
+LIBS = -lrt -lz -lX11 -ldl
 
 clean:
 	rm -rf $(OBJ_DIR)
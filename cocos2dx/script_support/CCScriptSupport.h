@@ -215,6 +215,25 @@ public:
     virtual int executeCallFuncActionEvent(CCCallFunc* pAction, CCObject* pTarget = NULL) = 0;
     /** execute a schedule function */
     virtual int executeSchedule(int nHandler, float dt, CCNode* pNode = NULL) = 0;
+
+    /** Queues the call of a schedule function, used when CCScheduler::isScriptBatchingEnabled() is true.
+     The queued calls are executed all at once by flushSchedules().
+     @param pTarget the object the call belongs to, used by cancelSchedules()
+     @return false if the engine doesn't batch calls, the function must then be executed with executeSchedule
+     @since v3.0
+     */
+    virtual bool queueSchedule(int nHandler, float dt, CCObject* pTarget) { return false; }
+
+    /** Executes the queued schedule functions.
+     @since v3.0
+     */
+    virtual void flushSchedules() {}
+
+    /** Cancels the queued calls of a target that is unscheduled or paused.
+     It may be called by a schedule function while the queued calls are executed.
+     @since v3.0
+     */
+    virtual void cancelSchedules(const CCObject* pTarget) {}
     
     /** functions for executing touch event */
     virtual int executeLayerTouchesEvent(CCLayer* pLayer, int eventType, CCSet *pTouches) = 0;
@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "platform/CCFileUtils.h"
 #include "support/data_support/uthash.h"
 #include "cocoa/CCString.h"
+#include "CCConfiguration.h"
 // extern
 #include "kazmath/GL/matrix.h"
 #include "kazmath/kazmath.h"
@@ -50,9 +51,12 @@ CCGLProgram::CCGLProgram()
 , _vertShader(0)
 , _fragShader(0)
 , _hashForUniforms(NULL)
+, _projectionRevision(0)
+, _modelviewRevision(0)
 , _usesTime(false)
 {
     memset(_uniforms, 0, sizeof(_uniforms));
+    memset(_uniformCache, 0, sizeof(_uniformCache));
 }
 
 CCGLProgram::~CCGLProgram()
@@ -68,15 +72,7 @@ CCGLProgram::~CCGLProgram()
         ccGLDeleteProgram(_program);
     }
 
-    tHashUniformEntry *current_element, *tmp;
-
-    // Purge uniform hash
-    HASH_ITER(hh, _hashForUniforms, current_element, tmp)
-    {
-        HASH_DEL(_hashForUniforms, current_element);
-        free(current_element->value);
-        free(current_element);
-    }
+    purgeUniformCache();
 }
 
 bool CCGLProgram::initWithVertexShaderByteArray(const GLchar* vShaderByteArray, const GLchar* fShaderByteArray)
@@ -113,7 +109,7 @@ bool CCGLProgram::initWithVertexShaderByteArray(const GLchar* vShaderByteArray,
     {
         glAttachShader(_program, _fragShader);
     }
-    _hashForUniforms = NULL;
+    purgeUniformCache();
     
     CHECK_GL_ERROR_DEBUG();
 
@@ -128,6 +124,78 @@ bool CCGLProgram::initWithVertexShaderFilename(const char* vShaderFilename, cons
     return initWithVertexShaderByteArray(vertexSource, fragmentSource);
 }
 
+bool CCGLProgram::initWithProgramBinary(GLenum format, const GLvoid* binary, GLsizei length)
+{
+#ifdef CC_GL_PROGRAM_BINARY_LENGTH
+    if (!CCConfiguration::sharedConfiguration()->supportsProgramBinary())
+    {
+        return false;
+    }
+
+    _program = glCreateProgram();
+    CHECK_GL_ERROR_DEBUG();
+
+    _vertShader = _fragShader = 0;
+
+    ccglProgramBinary(_program, format, binary, length);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(_program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE)
+    {
+        // the error of a rejected binary is expected, don't leave it to CHECK_GL_ERROR_DEBUG
+        glGetError();
+        ccGLDeleteProgram(_program);
+        _program = 0;
+        return false;
+    }
+    purgeUniformCache();
+
+    return true;
+#else
+    CC_UNUSED_PARAM(format);
+    CC_UNUSED_PARAM(binary);
+    CC_UNUSED_PARAM(length);
+    return false;
+#endif
+}
+
+bool CCGLProgram::getProgramBinary(GLenum* format, std::vector<unsigned char>* binary)
+{
+#ifdef CC_GL_PROGRAM_BINARY_LENGTH
+    if (!_program || !CCConfiguration::sharedConfiguration()->supportsProgramBinary())
+    {
+        return false;
+    }
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(_program, GL_LINK_STATUS, &status);
+    GLint length = 0;
+    glGetProgramiv(_program, CC_GL_PROGRAM_BINARY_LENGTH, &length);
+    if (status != GL_TRUE || length <= 0)
+    {
+        return false;
+    }
+
+    binary->resize(length);
+    GLsizei written = 0;
+    ccglGetProgramBinary(_program, length, &written, format, &(*binary)[0]);
+    CHECK_GL_ERROR_DEBUG();
+    if (written <= 0)
+    {
+        binary->clear();
+        return false;
+    }
+    binary->resize(written);
+
+    return true;
+#else
+    CC_UNUSED_PARAM(format);
+    CC_UNUSED_PARAM(binary);
+    return false;
+#endif
+}
+
 const char* CCGLProgram::description()
 {
     return CCString::createWithFormat("<CCGLProgram = "
@@ -226,6 +294,13 @@ bool CCGLProgram::link()
     CCAssert(_program != 0, "Cannot link invalid program");
     
     GLint status = GL_TRUE;
+
+#ifdef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    if (CCConfiguration::sharedConfiguration()->supportsProgramBinary())
+    {
+        glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+#endif
     
     glLinkProgram(_program);
 
@@ -300,6 +375,24 @@ bool CCGLProgram::updateUniformLocation(GLint location, GLvoid* data, unsigned i
     {
         return false;
     }
+
+    if (location < kCCUniformCacheSize)
+    {
+        if (_uniformCache[location].bytes == bytes && memcmp(_uniformCache[location].value, data, bytes) == 0)
+        {
+            ++g_glStateStats.redundantUniformUploads;
+            return false;
+        }
+
+        if (_uniformCache[location].bytes != bytes)
+        {
+            _uniformCache[location].value = realloc(_uniformCache[location].value, bytes);
+            _uniformCache[location].bytes = bytes;
+        }
+        memcpy(_uniformCache[location].value, data, bytes);
+        ++g_glStateStats.uniformUploads;
+        return true;
+    }
     
     bool updated = true;
     tHashUniformEntry *element = NULL;
@@ -330,9 +423,40 @@ bool CCGLProgram::updateUniformLocation(GLint location, GLvoid* data, unsigned i
         }
     }
 
+    if (updated)
+    {
+        ++g_glStateStats.uniformUploads;
+    }
+    else
+    {
+        ++g_glStateStats.redundantUniformUploads;
+    }
     return updated;
 }
 
+void CCGLProgram::purgeUniformCache()
+{
+    tHashUniformEntry *current_element, *tmp;
+
+    // Purge uniform hash
+    HASH_ITER(hh, _hashForUniforms, current_element, tmp)
+    {
+        HASH_DEL(_hashForUniforms, current_element);
+        free(current_element->value);
+        free(current_element);
+    }
+    _hashForUniforms = NULL;
+
+    for (int i = 0; i < kCCUniformCacheSize; ++i)
+    {
+        free(_uniformCache[i].value);
+    }
+    memset(_uniformCache, 0, sizeof(_uniformCache));
+
+    _projectionRevision = 0;
+    _modelviewRevision = 0;
+}
+
 GLint CCGLProgram::getUniformLocationForName(const char* name)
 {
     CCAssert(name != NULL, "Invalid uniform name" );
@@ -490,6 +614,13 @@ void CCGLProgram::setUniformLocationWith4fv(GLint location, GLfloat* floats, uns
 
 void CCGLProgram::setUniformLocationWithMatrix4fv(GLint location, GLfloat* matrixArray, unsigned int numberOfMatrices)
 {
+    // the builtin matrices may not be the ones of the matrix stacks anymore
+    if (location >= 0 && (location == _uniforms[kCCUniformPMatrix] || location == _uniforms[kCCUniformMVMatrix] || location == _uniforms[kCCUniformMVPMatrix]))
+    {
+        _projectionRevision = 0;
+        _modelviewRevision = 0;
+    }
+
     bool updated =  updateUniformLocation(location, matrixArray, sizeof(float)*16*numberOfMatrices);
 
     if( updated )
@@ -498,20 +629,49 @@ void CCGLProgram::setUniformLocationWithMatrix4fv(GLint location, GLfloat* matri
     }
 }
 
+void CCGLProgram::setBuiltinMatrix(GLint location, GLfloat* matrix)
+{
+    if (updateUniformLocation(location, matrix, sizeof(GLfloat) * 16))
+    {
+        glUniformMatrix4fv(location, 1, GL_FALSE, matrix);
+    }
+}
+
 void CCGLProgram::setUniformsForBuiltins()
 {
-    kmMat4 matrixP;
-	kmMat4 matrixMV;
-	kmMat4 matrixMVP;
-	
-	kmGLGetMatrix(KM_GL_PROJECTION, &matrixP);
-	kmGLGetMatrix(KM_GL_MODELVIEW, &matrixMV);
-	
-	kmMat4Multiply(&matrixMVP, &matrixP, &matrixMV);
-    
-    setUniformLocationWithMatrix4fv(_uniforms[kCCUniformPMatrix], matrixP.mat, 1);
-    setUniformLocationWithMatrix4fv(_uniforms[kCCUniformMVMatrix], matrixMV.mat, 1);
-    setUniformLocationWithMatrix4fv(_uniforms[kCCUniformMVPMatrix], matrixMVP.mat, 1);
+    unsigned int projectionRevision = kmGLGetMatrixRevision(KM_GL_PROJECTION);
+    unsigned int modelviewRevision = kmGLGetMatrixRevision(KM_GL_MODELVIEW);
+
+    if (projectionRevision != _projectionRevision || modelviewRevision != _modelviewRevision)
+    {
+        kmMat4 matrixP;
+        kmMat4 matrixMV;
+        kmMat4 matrixMVP;
+
+        kmGLGetMatrix(KM_GL_PROJECTION, &matrixP);
+        kmGLGetMatrix(KM_GL_MODELVIEW, &matrixMV);
+
+        if (projectionRevision != _projectionRevision)
+        {
+            setBuiltinMatrix(_uniforms[kCCUniformPMatrix], matrixP.mat);
+        }
+        if (modelviewRevision != _modelviewRevision)
+        {
+            setBuiltinMatrix(_uniforms[kCCUniformMVMatrix], matrixMV.mat);
+        }
+        if (_uniforms[kCCUniformMVPMatrix] != -1)
+        {
+            kmMat4Multiply(&matrixMVP, &matrixP, &matrixMV);
+            setBuiltinMatrix(_uniforms[kCCUniformMVPMatrix], matrixMVP.mat);
+        }
+
+        _projectionRevision = projectionRevision;
+        _modelviewRevision = modelviewRevision;
+    }
+    else
+    {
+        g_glStateStats.redundantUniformUploads += (_uniforms[kCCUniformPMatrix] != -1) + (_uniforms[kCCUniformMVMatrix] != -1) + (_uniforms[kCCUniformMVPMatrix] != -1);
+    }
 	
 	if(_usesTime)
     {
@@ -542,17 +702,7 @@ void CCGLProgram::reset()
     //ccGLDeleteProgram(_program);
     _program = 0;
 
-    
-    tHashUniformEntry *current_element, *tmp;
-    
-    // Purge uniform hash
-    HASH_ITER(hh, _hashForUniforms, current_element, tmp) 
-    {
-        HASH_DEL(_hashForUniforms, current_element);
-        free(current_element->value);
-        free(current_element);
-    }
-    _hashForUniforms = NULL;
+    purgeUniformCache();
 }
 
 NS_CC_END
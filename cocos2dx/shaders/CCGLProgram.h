@@ -32,6 +32,20 @@ THE SOFTWARE.
 #include "cocoa/CCObject.h"
 
 #include "CCGL.h"
+#include <vector>
+
+// Program binaries: GL_ARB_get_program_binary on desktop, GL_OES_get_program_binary on Android
+#if defined(GL_PROGRAM_BINARY_LENGTH)
+#define CC_GL_PROGRAM_BINARY_LENGTH         GL_PROGRAM_BINARY_LENGTH
+#define CC_GL_NUM_PROGRAM_BINARY_FORMATS    GL_NUM_PROGRAM_BINARY_FORMATS
+#define ccglGetProgramBinary                glGetProgramBinary
+#define ccglProgramBinary                   glProgramBinary
+#elif defined(GL_PROGRAM_BINARY_LENGTH_OES) && (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+#define CC_GL_PROGRAM_BINARY_LENGTH         GL_PROGRAM_BINARY_LENGTH_OES
+#define CC_GL_NUM_PROGRAM_BINARY_FORMATS    GL_NUM_PROGRAM_BINARY_FORMATS_OES
+#define ccglGetProgramBinary                glGetProgramBinaryOES
+#define ccglProgramBinary                   glProgramBinaryOES
+#endif
 
 NS_CC_BEGIN
 
@@ -69,6 +83,7 @@ enum {
 #define kCCShader_PositionTextureA8Color            "ShaderPositionTextureA8Color"
 #define kCCShader_Position_uColor                   "ShaderPosition_uColor"
 #define kCCShader_PositionLengthTexureColor         "ShaderPositionLengthTextureColor"
+#define kCCShader_PositionColor_uPointSize          "ShaderPositionColor_uPointSize"
 
 // uniform names
 #define kCCUniformPMatrix_s				"CC_PMatrix"
@@ -88,6 +103,11 @@ enum {
 
 struct _hashUniformEntry;
 
+/** Uniforms whose location is below this value are cached in an array instead of a hash.
+ @since v3.0
+ */
+#define kCCUniformCacheSize 32
+
 typedef void (*GLInfoFunction)(GLuint program, GLenum pname, GLint* params);
 typedef void (*GLLogFunction) (GLuint program, GLsizei bufsize, GLsizei* length, GLchar* infolog);
 
@@ -106,6 +126,17 @@ public:
     bool initWithVertexShaderByteArray(const GLchar* vShaderByteArray, const GLchar* fShaderByteArray);
     /** Initializes the CCGLProgram with a vertex and fragment with contents of filenames */
     bool initWithVertexShaderFilename(const char* vShaderFilename, const char* fShaderFilename);
+    /** Initializes the CCGLProgram with a binary returned by getProgramBinary, without compiling nor linking it.
+     The attributes keep the locations they had in the program the binary was retrieved from.
+     Returns false if program binaries are not supported or if the driver rejects the binary,
+     which happens after driver updates.
+     @since v3.0
+     */
+    bool initWithProgramBinary(GLenum format, const GLvoid* binary, GLsizei length);
+    /** Retrieves the binary of the linked program, for initWithProgramBinary.
+     @since v3.0
+     */
+    bool getProgramBinary(GLenum* format, std::vector<unsigned char>* binary);
     /**  It will add a new attribute to the shader */
     void addAttribute(const char* attributeName, GLuint index);
     /** links the glProgram */
@@ -172,7 +203,10 @@ public:
     /** calls glUniformMatrix4fv only if the values are different than the previous call for this same shader program. */
     void setUniformLocationWithMatrix4fv(GLint location, GLfloat* matrixArray, unsigned int numberOfMatrices);
     
-    /** will update the builtin uniforms if they are different than the previous call for this same shader program. */
+    /** will update the builtin uniforms if they are different than the previous call for this same shader program.
+     The matrices are neither computed nor compared when the projection and modelview matrices didn't change
+     since the previous call.
+     */
     void setUniformsForBuiltins();
 
     /** returns the vertexShader error log */
@@ -190,6 +224,8 @@ public:
 
 private:
     bool updateUniformLocation(GLint location, GLvoid* data, unsigned int bytes);
+    void setBuiltinMatrix(GLint location, GLfloat* matrix);
+    void purgeUniformCache();
     const char* description();
     bool compileShader(GLuint * shader, GLenum type, const GLchar* source);
     const char* logForOpenGLObject(GLuint object, GLInfoFunction infoFunc, GLLogFunction logFunc);
@@ -200,6 +236,14 @@ private:
     GLuint            _fragShader;
     GLint             _uniforms[kCCUniform_MAX];
     struct _hashUniformEntry* _hashForUniforms;
+    struct
+    {
+        GLvoid*       value;
+        unsigned int  bytes;
+    }                 _uniformCache[kCCUniformCacheSize];
+    // revisions of the matrices uploaded by setUniformsForBuiltins, 0 if unknown
+    unsigned int      _projectionRevision;
+    unsigned int      _modelviewRevision;
     bool              _usesTime;
 };
 
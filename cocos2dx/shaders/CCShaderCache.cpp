@@ -28,6 +28,10 @@ THE SOFTWARE.
 #include "CCGLProgram.h"
 #include "ccMacros.h"
 #include "ccShaders.h"
+#include "CCConfiguration.h"
+#include "platform/CCFileUtils.h"
+#include "platform/platform.h"
+#include <stdio.h>
 
 NS_CC_BEGIN
 
@@ -40,10 +44,95 @@ enum {
     kCCShaderType_PositionTextureA8Color,
     kCCShaderType_Position_uColor,
     kCCShaderType_PositionLengthTexureColor,
+    kCCShaderType_PositionColor_uPointSize,
     
     kCCShaderType_MAX,
 };
 
+// keys of the default programs, by shader type
+static const char* s_defaultShaderKeys[kCCShaderType_MAX] = {
+    kCCShader_PositionTextureColor,
+    kCCShader_PositionTextureColorAlphaTest,
+    kCCShader_PositionColor,
+    kCCShader_PositionTexture,
+    kCCShader_PositionTexture_uColor,
+    kCCShader_PositionTextureA8Color,
+    kCCShader_Position_uColor,
+    kCCShader_PositionLengthTexureColor,
+    kCCShader_PositionColor_uPointSize,
+};
+
+typedef struct
+{
+    const char* name;
+    GLuint      index;
+} ccShaderAttribute;
+
+static const ccShaderAttribute s_attributesPositionColorTexCoords[] = {
+    { kCCAttributeNamePosition, kCCVertexAttrib_Position },
+    { kCCAttributeNameColor, kCCVertexAttrib_Color },
+    { kCCAttributeNameTexCoord, kCCVertexAttrib_TexCoords },
+    { NULL, 0 },
+};
+
+static const ccShaderAttribute s_attributesPositionColor[] = {
+    { kCCAttributeNamePosition, kCCVertexAttrib_Position },
+    { kCCAttributeNameColor, kCCVertexAttrib_Color },
+    { NULL, 0 },
+};
+
+static const ccShaderAttribute s_attributesPositionTexCoords[] = {
+    { kCCAttributeNamePosition, kCCVertexAttrib_Position },
+    { kCCAttributeNameTexCoord, kCCVertexAttrib_TexCoords },
+    { NULL, 0 },
+};
+
+static const ccShaderAttribute s_attributesVertex[] = {
+    { "aVertex", kCCVertexAttrib_Position },
+    { NULL, 0 },
+};
+
+// Header of the program binary files. The binary is only used if the sources and the driver didn't change;
+// bump the version when CCGLProgram changes how it compiles the sources.
+static const char s_programBinaryMagic[4] = { 'C', 'C', 'P', 'B' };
+static const unsigned int s_programBinaryVersion = 1;
+
+typedef struct
+{
+    char                magic[4];
+    unsigned int        version;
+    unsigned long long  sourceHash;
+    unsigned int        format;
+    unsigned int        driverLength;
+    unsigned int        binaryLength;
+} ccProgramBinaryHeader;
+
+// 64 bits FNV-1a
+static unsigned long long hashBytes(unsigned long long hash, const void* data, size_t length)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static unsigned long long hashSources(const GLchar* vert, const GLchar* frag, const ccShaderAttribute* attributes)
+{
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    // the terminating zeros separate the strings
+    hash = hashBytes(hash, vert, strlen(vert) + 1);
+    hash = hashBytes(hash, frag, strlen(frag) + 1);
+    for (; attributes->name; ++attributes)
+    {
+        hash = hashBytes(hash, attributes->name, strlen(attributes->name) + 1);
+        hash = hashBytes(hash, &attributes->index, sizeof(attributes->index));
+    }
+    return hash;
+}
+
 static CCShaderCache *_sharedShaderCache = 0;
 
 CCShaderCache* CCShaderCache::sharedShaderCache()
@@ -65,6 +154,7 @@ void CCShaderCache::purgeSharedShaderCache()
 
 CCShaderCache::CCShaderCache()
 : _programs(0)
+, _programBinaryCacheEnabled(true)
 {
 
 }
@@ -77,215 +167,293 @@ CCShaderCache::~CCShaderCache()
 
 bool CCShaderCache::init()
 {
+    // the default programs are loaded by programForKey
     _programs = new CCDictionary();
-    loadDefaultShaders();
     return true;
 }
 
 void CCShaderCache::loadDefaultShaders()
 {
-    // Position Texture Color shader
-    CCGLProgram *p = new CCGLProgram();
-    loadDefaultShader(p, kCCShaderType_PositionTextureColor);
-
-    _programs->setObject(p, kCCShader_PositionTextureColor);
-    p->release();
-
-    // Position Texture Color alpha test
-    p = new CCGLProgram();
-    loadDefaultShader(p, kCCShaderType_PositionTextureColorAlphaTest);
-
-    _programs->setObject(p, kCCShader_PositionTextureColorAlphaTest);
-    p->release();
-
-    //
-    // Position, Color shader
-    //
-    p = new CCGLProgram();
-    loadDefaultShader(p, kCCShaderType_PositionColor);
-
-    _programs->setObject(p, kCCShader_PositionColor);
-    p->release();
-
-    //
-    // Position Texture shader
-    //
-    p = new CCGLProgram();
-    loadDefaultShader(p, kCCShaderType_PositionTexture);
-
-    _programs->setObject(p, kCCShader_PositionTexture);
-    p->release();
-
-    //
-    // Position, Texture attribs, 1 Color as uniform shader
-    //
-    p = new CCGLProgram();
-    loadDefaultShader(p, kCCShaderType_PositionTexture_uColor);
-
-    _programs->setObject(p ,kCCShader_PositionTexture_uColor);
-    p->release();
-
-    //
-    // Position Texture A8 Color shader
-    //
-    p = new CCGLProgram();
-    loadDefaultShader(p, kCCShaderType_PositionTextureA8Color);
-    
-    _programs->setObject(p, kCCShader_PositionTextureA8Color);
-    p->release();
-
-    //
-    // Position and 1 color passed as a uniform (to simulate glColor4ub )
-    //
-    p = new CCGLProgram();
-    loadDefaultShader(p, kCCShaderType_Position_uColor);
-    
-    _programs->setObject(p, kCCShader_Position_uColor);
-    p->release();
-    
-    //
-	// Position, Legth(TexCoords, Color (used by Draw Node basically )
-	//
-    p = new CCGLProgram();
-    loadDefaultShader(p, kCCShaderType_PositionLengthTexureColor);
-    
-    _programs->setObject(p, kCCShader_PositionLengthTexureColor);
-    p->release();
+    for (int type = 0; type < kCCShaderType_MAX; ++type)
+    {
+        programForKey(s_defaultShaderKeys[type]);
+    }
 }
 
 void CCShaderCache::reloadDefaultShaders()
 {
-    // reset all programs and reload them
-    
-    // Position Texture Color shader
-    CCGLProgram *p = programForKey(kCCShader_PositionTextureColor);    
-    p->reset();
-    loadDefaultShader(p, kCCShaderType_PositionTextureColor);
-
-    // Position Texture Color alpha test
-    p = programForKey(kCCShader_PositionTextureColorAlphaTest);
-    p->reset();    
-    loadDefaultShader(p, kCCShaderType_PositionTextureColorAlphaTest);
-    
-    //
-    // Position, Color shader
-    //
-    p = programForKey(kCCShader_PositionColor);
-    p->reset();
-    loadDefaultShader(p, kCCShaderType_PositionColor);
-    
-    //
-    // Position Texture shader
-    //
-    p = programForKey(kCCShader_PositionTexture);
-    p->reset();
-    loadDefaultShader(p, kCCShaderType_PositionTexture);
-    
-    //
-    // Position, Texture attribs, 1 Color as uniform shader
-    //
-    p = programForKey(kCCShader_PositionTexture_uColor);
-    p->reset();
-    loadDefaultShader(p, kCCShaderType_PositionTexture_uColor);
-    
-    //
-    // Position Texture A8 Color shader
-    //
-    p = programForKey(kCCShader_PositionTextureA8Color);
-    p->reset();
-    loadDefaultShader(p, kCCShaderType_PositionTextureA8Color);
-    
-    //
-    // Position and 1 color passed as a uniform (to simulate glColor4ub )
-    //
-    p = programForKey(kCCShader_Position_uColor);
-    p->reset();
-    loadDefaultShader(p, kCCShaderType_Position_uColor);
-    
-    //
-	// Position, Legth(TexCoords, Color (used by Draw Node basically )
-	//
-    p = programForKey(kCCShader_PositionLengthTexureColor);
-    p->reset();
-    loadDefaultShader(p, kCCShaderType_Position_uColor);
+    // reset the loaded programs and reload them, the other ones will be loaded when they are requested
+    for (int type = 0; type < kCCShaderType_MAX; ++type)
+    {
+        CCGLProgram *p = (CCGLProgram*)_programs->objectForKey(s_defaultShaderKeys[type]);
+        if (p)
+        {
+            p->reset();
+            loadDefaultShader(p, type);
+        }
+    }
 }
 
 void CCShaderCache::loadDefaultShader(CCGLProgram *p, int type)
 {
+    const GLchar *vert = NULL;
+    const GLchar *frag = NULL;
+    const ccShaderAttribute *attributes = NULL;
+
     switch (type) {
         case kCCShaderType_PositionTextureColor:
-            p->initWithVertexShaderByteArray(ccPositionTextureColor_vert, ccPositionTextureColor_frag);
-            
-            p->addAttribute(kCCAttributeNamePosition, kCCVertexAttrib_Position);
-            p->addAttribute(kCCAttributeNameColor, kCCVertexAttrib_Color);
-            p->addAttribute(kCCAttributeNameTexCoord, kCCVertexAttrib_TexCoords);
-            
+            vert = ccPositionTextureColor_vert;
+            frag = ccPositionTextureColor_frag;
+            attributes = s_attributesPositionColorTexCoords;
             break;
         case kCCShaderType_PositionTextureColorAlphaTest:
-            p->initWithVertexShaderByteArray(ccPositionTextureColor_vert, ccPositionTextureColorAlphaTest_frag);
-            
-            p->addAttribute(kCCAttributeNamePosition, kCCVertexAttrib_Position);
-            p->addAttribute(kCCAttributeNameColor, kCCVertexAttrib_Color);
-            p->addAttribute(kCCAttributeNameTexCoord, kCCVertexAttrib_TexCoords);
-
+            vert = ccPositionTextureColor_vert;
+            frag = ccPositionTextureColorAlphaTest_frag;
+            attributes = s_attributesPositionColorTexCoords;
             break;
         case kCCShaderType_PositionColor:  
-            p->initWithVertexShaderByteArray(ccPositionColor_vert ,ccPositionColor_frag);
-            
-            p->addAttribute(kCCAttributeNamePosition, kCCVertexAttrib_Position);
-            p->addAttribute(kCCAttributeNameColor, kCCVertexAttrib_Color);
-
+            vert = ccPositionColor_vert;
+            frag = ccPositionColor_frag;
+            attributes = s_attributesPositionColor;
             break;
         case kCCShaderType_PositionTexture:
-            p->initWithVertexShaderByteArray(ccPositionTexture_vert ,ccPositionTexture_frag);
-            
-            p->addAttribute(kCCAttributeNamePosition, kCCVertexAttrib_Position);
-            p->addAttribute(kCCAttributeNameTexCoord, kCCVertexAttrib_TexCoords);
-
+            vert = ccPositionTexture_vert;
+            frag = ccPositionTexture_frag;
+            attributes = s_attributesPositionTexCoords;
             break;
         case kCCShaderType_PositionTexture_uColor:
-            p->initWithVertexShaderByteArray(ccPositionTexture_uColor_vert, ccPositionTexture_uColor_frag);
-            
-            p->addAttribute(kCCAttributeNamePosition, kCCVertexAttrib_Position);
-            p->addAttribute(kCCAttributeNameTexCoord, kCCVertexAttrib_TexCoords);
-
+            vert = ccPositionTexture_uColor_vert;
+            frag = ccPositionTexture_uColor_frag;
+            attributes = s_attributesPositionTexCoords;
             break;
         case kCCShaderType_PositionTextureA8Color:
-            p->initWithVertexShaderByteArray(ccPositionTextureA8Color_vert, ccPositionTextureA8Color_frag);
-            
-            p->addAttribute(kCCAttributeNamePosition, kCCVertexAttrib_Position);
-            p->addAttribute(kCCAttributeNameColor, kCCVertexAttrib_Color);
-            p->addAttribute(kCCAttributeNameTexCoord, kCCVertexAttrib_TexCoords);
-
+            vert = ccPositionTextureA8Color_vert;
+            frag = ccPositionTextureA8Color_frag;
+            attributes = s_attributesPositionColorTexCoords;
             break;
         case kCCShaderType_Position_uColor:
-            p->initWithVertexShaderByteArray(ccPosition_uColor_vert, ccPosition_uColor_frag);    
-            
-            p->addAttribute("aVertex", kCCVertexAttrib_Position);    
-            
+            vert = ccPosition_uColor_vert;
+            frag = ccPosition_uColor_frag;
+            attributes = s_attributesVertex;
             break;
         case kCCShaderType_PositionLengthTexureColor:
-            p->initWithVertexShaderByteArray(ccPositionColorLengthTexture_vert, ccPositionColorLengthTexture_frag);
-            
-            p->addAttribute(kCCAttributeNamePosition, kCCVertexAttrib_Position);
-            p->addAttribute(kCCAttributeNameTexCoord, kCCVertexAttrib_TexCoords);
-            p->addAttribute(kCCAttributeNameColor, kCCVertexAttrib_Color);
-            
+            vert = ccPositionColorLengthTexture_vert;
+            frag = ccPositionColorLengthTexture_frag;
+            attributes = s_attributesPositionColorTexCoords;
+            break;
+        case kCCShaderType_PositionColor_uPointSize:
+            vert = ccPositionColor_uPointSize_vert;
+            frag = ccPositionColor_frag;
+            attributes = s_attributesPositionColor;
             break;
         default:
             CCLOG("cocos2d: %s:%d, error shader type", __FUNCTION__, __LINE__);
             return;
     }
-    
-    p->link();
+
+    struct cc_timeval start, end;
+    CCTime::gettimeofdayCocos2d(&start, NULL);
+
+    unsigned long long sourceHash = hashSources(vert, frag, attributes);
+    bool fromBinary = loadProgramBinary(p, type, sourceHash);
+    if (!fromBinary)
+    {
+        p->initWithVertexShaderByteArray(vert, frag);
+        for (const ccShaderAttribute *attribute = attributes; attribute->name; ++attribute)
+        {
+            p->addAttribute(attribute->name, attribute->index);
+        }
+        p->link();
+        saveProgramBinary(p, type, sourceHash);
+    }
     p->updateUniforms();
     
     CHECK_GL_ERROR_DEBUG();
+
+    CCTime::gettimeofdayCocos2d(&end, NULL);
+    LoadTime loadTime = { type, (float)CCTime::timersubCocos2d(&start, &end), fromBinary };
+    _loadTimes.push_back(loadTime);
+}
+
+bool CCShaderCache::loadProgramBinary(CCGLProgram *program, int type, unsigned long long sourceHash)
+{
+    if (!_programBinaryCacheEnabled || !CCConfiguration::sharedConfiguration()->supportsProgramBinary())
+    {
+        return false;
+    }
+
+    std::string path = getProgramBinaryPath(type);
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        return false;
+    }
+
+    const std::string& driverDescription = getDriverDescription();
+    ccProgramBinaryHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1
+        && memcmp(header.magic, s_programBinaryMagic, sizeof(header.magic)) == 0
+        && header.version == s_programBinaryVersion
+        && header.sourceHash == sourceHash
+        && header.driverLength == driverDescription.size()
+        && header.binaryLength > 0;
+
+    std::string driver;
+    if (ok && header.driverLength > 0)
+    {
+        driver.resize(header.driverLength);
+        ok = fread(&driver[0], 1, header.driverLength, file) == header.driverLength && driver == driverDescription;
+    }
+
+    std::vector<unsigned char> binary;
+    if (ok)
+    {
+        binary.resize(header.binaryLength);
+        ok = fread(&binary[0], 1, header.binaryLength, file) == header.binaryLength;
+    }
+    fclose(file);
+
+    if (ok)
+    {
+        ok = program->initWithProgramBinary(header.format, &binary[0], (GLsizei)binary.size());
+    }
+
+    if (!ok)
+    {
+        CCLOG("cocos2d: ShaderCache: binary of %s is outdated, compiling it", s_defaultShaderKeys[type]);
+        remove(path.c_str());
+    }
+    return ok;
+}
+
+void CCShaderCache::saveProgramBinary(CCGLProgram *program, int type, unsigned long long sourceHash)
+{
+    if (!_programBinaryCacheEnabled || !CCConfiguration::sharedConfiguration()->supportsProgramBinary())
+    {
+        return;
+    }
+
+    GLenum format = 0;
+    std::vector<unsigned char> binary;
+    if (!program->getProgramBinary(&format, &binary))
+    {
+        return;
+    }
+
+    const std::string& driverDescription = getDriverDescription();
+    ccProgramBinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, s_programBinaryMagic, sizeof(header.magic));
+    header.version = s_programBinaryVersion;
+    header.sourceHash = sourceHash;
+    header.format = format;
+    header.driverLength = driverDescription.size();
+    header.binaryLength = binary.size();
+
+    // write a temporary file so an interrupted write never leaves a truncated binary
+    std::string path = getProgramBinaryPath(type);
+    std::string temporaryPath = path + ".tmp";
+    FILE *file = fopen(temporaryPath.c_str(), "wb");
+    if (!file)
+    {
+        CCLOG("cocos2d: ShaderCache: can't write %s", temporaryPath.c_str());
+        return;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+        && fwrite(driverDescription.data(), 1, driverDescription.size(), file) == driverDescription.size()
+        && fwrite(&binary[0], 1, binary.size(), file) == binary.size();
+    ok = (fclose(file) == 0) && ok;
+
+    remove(path.c_str());
+    if (!ok || rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        CCLOG("cocos2d: ShaderCache: can't write %s", path.c_str());
+        remove(temporaryPath.c_str());
+    }
+}
+
+std::string CCShaderCache::getProgramBinaryPath(int type)
+{
+    return CCFileUtils::sharedFileUtils()->getWritablePath() + s_defaultShaderKeys[type] + ".glprogram";
+}
+
+const std::string& CCShaderCache::getDriverDescription()
+{
+    if (_driverDescription.empty())
+    {
+        const GLenum names[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+        for (unsigned int i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+        {
+            const char *value = (const char*)glGetString(names[i]);
+            _driverDescription += value ? value : "";
+            _driverDescription += '\n';
+        }
+    }
+    return _driverDescription;
+}
+
+void CCShaderCache::setProgramBinaryCacheEnabled(bool enabled)
+{
+    _programBinaryCacheEnabled = enabled;
+}
+
+bool CCShaderCache::isProgramBinaryCacheEnabled() const
+{
+    return _programBinaryCacheEnabled;
+}
+
+void CCShaderCache::removeProgramBinaryCache()
+{
+    for (int type = 0; type < kCCShaderType_MAX; ++type)
+    {
+        remove(getProgramBinaryPath(type).c_str());
+    }
+}
+
+void CCShaderCache::dumpShaderLoadTimes()
+{
+    unsigned int compiled = 0, fromBinary = 0;
+    float compileTime = 0, binaryTime = 0;
+
+    for (std::vector<LoadTime>::const_iterator it = _loadTimes.begin(); it != _loadTimes.end(); ++it)
+    {
+        CCLOG("cocos2d: \"%s\" %s in %.2f ms", s_defaultShaderKeys[it->type],
+              it->fromBinary ? "loaded from binary" : "compiled", it->milliseconds);
+        if (it->fromBinary)
+        {
+            ++fromBinary;
+            binaryTime += it->milliseconds;
+        }
+        else
+        {
+            ++compiled;
+            compileTime += it->milliseconds;
+        }
+    }
+
+    CCLOG("cocos2d: ShaderCache dumpShaderLoadTimes: %u programs compiled in %.2f ms, %u loaded from binaries in %.2f ms",
+          compiled, compileTime, fromBinary, binaryTime);
 }
 
 CCGLProgram* CCShaderCache::programForKey(const char* key)
 {
-    return (CCGLProgram*)_programs->objectForKey(key);
+    CCGLProgram *program = (CCGLProgram*)_programs->objectForKey(key);
+    if (!program)
+    {
+        for (int type = 0; type < kCCShaderType_MAX; ++type)
+        {
+            if (strcmp(key, s_defaultShaderKeys[type]) == 0)
+            {
+                program = new CCGLProgram();
+                loadDefaultShader(program, type);
+                _programs->setObject(program, key);
+                program->release();
+                break;
+            }
+        }
+    }
+    return program;
 }
 
 void CCShaderCache::addProgram(CCGLProgram* program, const char* key)
@@ -28,6 +28,8 @@ THE SOFTWARE.
 #define __CCSHADERCACHE_H__
 
 #include "cocoa/CCDictionary.h"
+#include <string>
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -40,6 +42,11 @@ class CCGLProgram;
 
 /** CCShaderCache
  Singleton that stores manages GL shaders
+
+ The default programs are compiled the first time they are requested with programForKey.
+ When the driver supports program binaries, their linked binaries are saved in the writable path
+ and loaded from there on the next runs and after a context loss, as long as the sources and the
+ GL driver don't change.
  @since v2.0
  */
 class CC_DLL CCShaderCache : public CCObject 
@@ -54,23 +61,54 @@ public:
     /** purges the cache. It releases the retained instance. */
     static void purgeSharedShaderCache();
 
-    /** loads the default shaders */
+    /** loads all the default shaders now instead of when they are first requested */
     void loadDefaultShaders();
     
-    /** reload the default shaders */
+    /** reload the default shaders that were loaded, after the GL context was lost */
     void reloadDefaultShaders();
 
-    /** returns a GL program for a given key */
+    /** returns a GL program for a given key, loading it if it is one of the default programs */
     CCGLProgram * programForKey(const char* key);
 
     /** adds a CCGLProgram to the cache for a given name */
     void addProgram(CCGLProgram* program, const char* key);
 
+    /** Enables saving and loading the binaries of the default programs. Enabled by default,
+     it has no effect when CCConfiguration::supportsProgramBinary() returns false.
+     @since v3.0
+     */
+    void setProgramBinaryCacheEnabled(bool enabled);
+    bool isProgramBinaryCacheEnabled() const;
+
+    /** Deletes the saved program binaries.
+     @since v3.0
+     */
+    void removeProgramBinaryCache();
+
+    /** Logs how long loading every default program took, and whether it was compiled or loaded from its binary.
+     @since v3.0
+     */
+    void dumpShaderLoadTimes();
+
 private:
+    struct LoadTime
+    {
+        int type;
+        float milliseconds;
+        bool fromBinary;
+    };
+
     bool init();
     void loadDefaultShader(CCGLProgram *program, int type);
+    bool loadProgramBinary(CCGLProgram *program, int type, unsigned long long sourceHash);
+    void saveProgramBinary(CCGLProgram *program, int type, unsigned long long sourceHash);
+    std::string getProgramBinaryPath(int type);
+    const std::string& getDriverDescription();
 
     CCDictionary* _programs;
+    bool _programBinaryCacheEnabled;
+    std::string _driverDescription;
+    std::vector<LoadTime> _loadTimes;
 
 };
 
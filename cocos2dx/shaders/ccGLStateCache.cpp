@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "CCGLProgram.h"
 #include "CCDirector.h"
 #include "ccConfig.h"
+#include "draw_nodes/CCDrawingPrimitives.h"
 
 // extern
 #include "kazmath/GL/matrix.h"
@@ -35,6 +36,8 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
+ccGLStateStats g_glStateStats = { 0, 0, 0, 0 };
+
 static GLuint      s_uCurrentProjectionMatrix = -1;
 static bool        s_bVertexAttribPosition = false;
 static bool        s_bVertexAttribColor = false;
@@ -50,6 +53,7 @@ static GLuint    s_uCurrentBoundTexture[kCCMaxActiveTexture] =  {(GLuint)-1,(GLu
 static GLenum    s_eBlendingSource = -1;
 static GLenum    s_eBlendingDest = -1;
 static int       s_eGLServerState = 0;
+static GLfloat   s_fLineWidth = -1.0f;
 #if CC_TEXTURE_ATLAS_USE_VAO
 static GLuint    s_uVAO = 0;
 #endif
@@ -76,6 +80,7 @@ void ccGLInvalidateStateCache( void )
     s_eBlendingSource = -1;
     s_eBlendingDest = -1;
     s_eGLServerState = 0;
+    s_fLineWidth = -1.0f;
 #endif
 }
 
@@ -93,10 +98,18 @@ void ccGLDeleteProgram( GLuint program )
 
 void ccGLUseProgram( GLuint program )
 {
+    // pending primitives are drawn with the state they were appended with
+    ccDrawFlush();
+
 #if CC_ENABLE_GL_STATE_CACHE
     if( program != s_uCurrentShaderProgram ) {
         s_uCurrentShaderProgram = program;
         glUseProgram(program);
+        ++g_glStateStats.stateChanges;
+    }
+    else
+    {
+        ++g_glStateStats.redundantStateChanges;
     }
 #else
     glUseProgram(program);
@@ -118,12 +131,19 @@ static void SetBlending(GLenum sfactor, GLenum dfactor)
 
 void ccGLBlendFunc(GLenum sfactor, GLenum dfactor)
 {
+    ccDrawFlush();
+
 #if CC_ENABLE_GL_STATE_CACHE
     if (sfactor != s_eBlendingSource || dfactor != s_eBlendingDest)
     {
         s_eBlendingSource = sfactor;
         s_eBlendingDest = dfactor;
         SetBlending(sfactor, dfactor);
+        ++g_glStateStats.stateChanges;
+    }
+    else
+    {
+        ++g_glStateStats.redundantStateChanges;
     }
 #else
     SetBlending( sfactor, dfactor );
@@ -154,6 +174,11 @@ void ccGLBindTexture2DN(GLuint textureUnit, GLuint textureId)
         s_uCurrentBoundTexture[textureUnit] = textureId;
         glActiveTexture(GL_TEXTURE0 + textureUnit);
         glBindTexture(GL_TEXTURE_2D, textureId);
+        ++g_glStateStats.stateChanges;
+    }
+    else
+    {
+        ++g_glStateStats.redundantStateChanges;
     }
 #else
     glActiveTexture(GL_TEXTURE0 + textureUnit);
@@ -188,6 +213,11 @@ void ccGLBindVAO(GLuint vaoId)
 	{
 		s_uVAO = vaoId;
 		glBindVertexArray(vaoId);
+		++g_glStateStats.stateChanges;
+	}
+	else
+	{
+		++g_glStateStats.redundantStateChanges;
 	}
 #else
 	glBindVertexArray(vaoId);
@@ -221,15 +251,60 @@ void ccGLEnable(ccGLServerState flags)
 #endif
 }
 
+//#pragma mark - GL Line Width functions
+
+void ccGLLineWidth(GLfloat width)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    if (width != s_fLineWidth)
+    {
+        s_fLineWidth = width;
+        glLineWidth(width);
+        ++g_glStateStats.stateChanges;
+    }
+    else
+    {
+        ++g_glStateStats.redundantStateChanges;
+    }
+#else
+    glLineWidth(width);
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
+GLfloat ccGLGetLineWidth(void)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    if (s_fLineWidth < 0)
+    {
+        glGetFloatv(GL_LINE_WIDTH, &s_fLineWidth);
+    }
+    return s_fLineWidth;
+#else
+    GLfloat width = 1.0f;
+    glGetFloatv(GL_LINE_WIDTH, &width);
+    return width;
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
 //#pragma mark - GL Vertex Attrib functions
 
 void ccGLEnableVertexAttribs( unsigned int flags )
 {
+    ccDrawFlush();
+
     ccGLBindVAO(0);
-    
-    /* Position */
-    bool enablePosition = flags & kCCVertexAttribFlag_Position;
 
+    bool enablePosition = (flags & kCCVertexAttribFlag_Position) != 0;
+    bool enableColor = (flags & kCCVertexAttribFlag_Color) != 0;
+    bool enableTexCoords = (flags & kCCVertexAttribFlag_TexCoords) != 0;
+
+    // most draws use the same attribs as the previous one
+    if( enablePosition == s_bVertexAttribPosition && enableColor == s_bVertexAttribColor && enableTexCoords == s_bVertexAttribTexCoords ) {
+        ++g_glStateStats.redundantStateChanges;
+        return;
+    }
+
+    /* Position */
     if( enablePosition != s_bVertexAttribPosition ) {
         if( enablePosition )
             glEnableVertexAttribArray( kCCVertexAttrib_Position );
@@ -237,11 +312,10 @@ void ccGLEnableVertexAttribs( unsigned int flags )
             glDisableVertexAttribArray( kCCVertexAttrib_Position );
 
         s_bVertexAttribPosition = enablePosition;
+        ++g_glStateStats.stateChanges;
     }
 
     /* Color */
-    bool enableColor = (flags & kCCVertexAttribFlag_Color) != 0 ? true : false;
-
     if( enableColor != s_bVertexAttribColor ) {
         if( enableColor )
             glEnableVertexAttribArray( kCCVertexAttrib_Color );
@@ -249,11 +323,10 @@ void ccGLEnableVertexAttribs( unsigned int flags )
             glDisableVertexAttribArray( kCCVertexAttrib_Color );
 
         s_bVertexAttribColor = enableColor;
+        ++g_glStateStats.stateChanges;
     }
 
     /* Tex Coords */
-    bool enableTexCoords = (flags & kCCVertexAttribFlag_TexCoords) != 0 ? true : false;
-
     if( enableTexCoords != s_bVertexAttribTexCoords ) {
         if( enableTexCoords )
             glEnableVertexAttribArray( kCCVertexAttrib_TexCoords );
@@ -261,6 +334,7 @@ void ccGLEnableVertexAttribs( unsigned int flags )
             glDisableVertexAttribArray( kCCVertexAttrib_TexCoords );
 
         s_bVertexAttribTexCoords = enableTexCoords;
+        ++g_glStateStats.stateChanges;
     }
 }
 
@@ -64,6 +64,27 @@ typedef enum {
 
 } ccGLServerState;
 
+/** GL calls made and avoided during a frame by the state cache and by the uniform cache of CCGLProgram.
+ @since v3.0
+ */
+typedef struct _ccGLStateStats
+{
+    /** programs, textures, VAOs, blend functions and vertex attribs changed */
+    unsigned int stateChanges;
+    /** state changes skipped because the state was already set */
+    unsigned int redundantStateChanges;
+    /** uniforms uploaded */
+    unsigned int uniformUploads;
+    /** uniform uploads skipped because the program already had the value */
+    unsigned int redundantUniformUploads;
+} ccGLStateStats;
+
+/** Counters of the current frame, reset by the CCDirector at the end of every frame.
+ The counters of the last frame are displayed with the CCDirector's stats, see CCDirector::getGLStateStats.
+ @since v3.0
+ */
+extern ccGLStateStats CC_DLL g_glStateStats;
+
 /** @file ccGLStateCache.h
 */
 
@@ -75,6 +96,7 @@ void CC_DLL ccGLInvalidateStateCache(void);
 
 /** Uses the GL program in case program is different than the current one.
  If CC_ENABLE_GL_STATE_CACHE is disabled, it will the glUseProgram() directly.
+ The pending drawing primitives are drawn first (see ccDrawFlush).
  @since v2.0.0
  */
 void CC_DLL ccGLUseProgram(GLuint program);
@@ -87,6 +109,7 @@ void CC_DLL ccGLDeleteProgram(GLuint program);
 
 /** Uses a blending function in case it not already used.
  If CC_ENABLE_GL_STATE_CACHE is disabled, it will the glBlendFunc() directly.
+ The pending drawing primitives are drawn first (see ccDrawFlush).
  @since v2.0.0
  */
 void CC_DLL ccGLBlendFunc(GLenum sfactor, GLenum dfactor);
@@ -110,6 +133,7 @@ void CC_DLL ccSetProjectionMatrixDirty(void);
     * kCCVertexAttribFlag_TexCoords
 
  These flags can be ORed. The flags that are not present, will be disabled.
+ The pending drawing primitives are drawn first (see ccDrawFlush).
 
  @since v2.0.0
  */
@@ -152,6 +176,20 @@ void CC_DLL ccGLBindVAO(GLuint vaoId);
  */
 void CC_DLL ccGLEnable( ccGLServerState flags );
 
+/** Sets the width of the lines in case it is different than the current one.
+ The drawing primitives are drawn with the width set when they were appended.
+ If CC_ENABLE_GL_STATE_CACHE is disabled, it will call glLineWidth() directly.
+ @since v3.0
+ */
+void CC_DLL ccGLLineWidth(GLfloat width);
+
+/** Returns the width of the lines.
+ The width is queried once from GL after the cache is invalidated, so set it with ccGLLineWidth() instead of glLineWidth().
+ If CC_ENABLE_GL_STATE_CACHE is disabled, it will call glGetFloatv() directly.
+ @since v3.0
+ */
+GLfloat CC_DLL ccGLGetLineWidth(void);
+
 // end of shaders group
 /// @}
 
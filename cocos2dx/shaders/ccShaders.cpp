@@ -37,6 +37,8 @@ const GLchar * ccPositionColor_frag =
 #include "ccShader_PositionColor_frag.h"
 const GLchar * ccPositionColor_vert =
 #include "ccShader_PositionColor_vert.h"
+const GLchar * ccPositionColor_uPointSize_vert =
+#include "ccShader_PositionColor_uPointSize_vert.h"
 
 //
 const GLchar * ccPositionTexture_frag =
@@ -116,11 +116,16 @@ bool CCSpriteBatchNode::initWithFile(const char* fileImage, unsigned int capacit
 CCSpriteBatchNode::CCSpriteBatchNode()
 : _textureAtlas(NULL)
 , _descendants(NULL)
+, _deferredAtlasUpdate(false)
+, _tombstoneCount(0)
 {
 }
 
 CCSpriteBatchNode::~CCSpriteBatchNode()
 {
+    // the descendants array can't release NULL entries
+    compactAtlas();
+
     CC_SAFE_RELEASE(_textureAtlas);
     CC_SAFE_RELEASE(_descendants);
 }
@@ -232,6 +237,8 @@ void CCSpriteBatchNode::removeChildAtIndex(unsigned int uIndex, bool bDoCleanup)
 
 void CCSpriteBatchNode::removeAllChildrenWithCleanup(bool bCleanup)
 {
+    compactAtlas();
+
     // Invalidate atlas index. issue #569
     // useSelfRender should be performed on all descendants. issue #1216
     arrayMakeObjectsPerformSelectorWithObject(_descendants, setBatchNode, NULL, CCSprite*);
@@ -245,6 +252,9 @@ void CCSpriteBatchNode::removeAllChildrenWithCleanup(bool bCleanup)
 //override sortAllChildren
 void CCSpriteBatchNode::sortAllChildren()
 {
+    // the atlas must be dense before the atlas indexes are updated
+    compactAtlas();
+
     if (_reorderChildDirty)
     {
         int i = 0,j = 0,length = _children->data->num;
@@ -384,6 +394,51 @@ void CCSpriteBatchNode::reorderBatch(bool reorder)
     _reorderChildDirty=reorder;
 }
 
+void CCSpriteBatchNode::setDeferredAtlasUpdate(bool deferred)
+{
+    if (! deferred)
+    {
+        compactAtlas();
+    }
+
+    _deferredAtlasUpdate = deferred;
+}
+
+void CCSpriteBatchNode::compactAtlas()
+{
+    if (_tombstoneCount == 0)
+    {
+        return;
+    }
+
+    ccArray *descendantsData = _descendants->data;
+    ccV3F_C4B_T2F_Quad* quads = _textureAtlas->getQuads();
+    unsigned int count = descendantsData->num;
+    unsigned int dst = 0;
+
+    // move the live sprites and their quads down over the tombstones, keeping their order
+    for (unsigned int src = 0; src < count; ++src)
+    {
+        CCSprite *pSprite = (CCSprite*)descendantsData->arr[src];
+        if (pSprite == NULL)
+        {
+            continue;
+        }
+
+        if (src != dst)
+        {
+            descendantsData->arr[dst] = pSprite;
+            quads[dst] = quads[src];
+            pSprite->setAtlasIndex(dst);
+        }
+        ++dst;
+    }
+
+    descendantsData->num = dst;
+    _textureAtlas->removeQuadsAtIndex(dst, count - dst);
+    _tombstoneCount = 0;
+}
+
 // draw
 void CCSpriteBatchNode::draw(void)
 {
@@ -557,6 +612,8 @@ unsigned int CCSpriteBatchNode::atlasIndexForChild(CCSprite *pobSprite, int nZ)
 
 void CCSpriteBatchNode::insertChild(CCSprite *pSprite, unsigned int uIndex)
 {
+    compactAtlas();
+
     pSprite->setBatchNode(this);
     pSprite->setAtlasIndex(uIndex);
     pSprite->setDirty(true);
@@ -626,6 +683,35 @@ void CCSpriteBatchNode::appendChild(CCSprite* sprite)
 
 void CCSpriteBatchNode::removeSpriteFromAtlas(CCSprite *pobSprite)
 {
+    if (_deferredAtlasUpdate)
+    {
+        unsigned int uAtlasIndex = pobSprite->getAtlasIndex();
+        ccArray *descendantsData = _descendants->data;
+
+        if (uAtlasIndex < descendantsData->num && descendantsData->arr[uAtlasIndex] == pobSprite)
+        {
+            // leave a tombstone, compactAtlas() removes it before the next draw
+            ccV3F_C4B_T2F_Quad tombstone;
+            memset(&tombstone, 0, sizeof(tombstone));
+            _textureAtlas->updateQuad(&tombstone, uAtlasIndex);
+
+            pobSprite->setBatchNode(NULL);
+            descendantsData->arr[uAtlasIndex] = NULL;
+            pobSprite->release();
+            ++_tombstoneCount;
+
+            CCObject* pObject = NULL;
+            CCARRAY_FOREACH(pobSprite->getChildren(), pObject)
+            {
+                removeSpriteFromAtlas((CCSprite*)pObject);
+            }
+            return;
+        }
+
+        // the atlas index is out of sync, remove it the slow way
+        compactAtlas();
+    }
+
     // remove from TextureAtlas
     _textureAtlas->removeQuadAtIndex(pobSprite->getAtlasIndex());
 
@@ -703,6 +789,8 @@ void CCSpriteBatchNode::insertQuadFromSprite(CCSprite *sprite, unsigned int inde
     CCAssert( sprite != NULL, "Argument must be non-NULL");
     CCAssert( dynamic_cast<CCSprite*>(sprite), "CCSpriteBatchNode only supports CCSprites as children");
 
+    compactAtlas();
+
     // make needed room
     while(index >= _textureAtlas->getCapacity() || _textureAtlas->getCapacity() == _textureAtlas->getTotalQuads())
     {
@@ -751,6 +839,8 @@ CCSpriteBatchNode * CCSpriteBatchNode::addSpriteWithoutQuad(CCSprite*child, unsi
     CCAssert( child != NULL, "Argument must be non-NULL");
     CCAssert( dynamic_cast<CCSprite*>(child), "CCSpriteBatchNode only supports CCSprites as children");
 
+    compactAtlas();
+
     // quad index is Z
     child->setAtlasIndex(z);
 
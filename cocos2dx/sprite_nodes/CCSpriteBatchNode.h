@@ -81,7 +81,7 @@ public:
         }
     }
 
-    inline CCArray* getDescendants(void) { return _descendants; }
+    inline CCArray* getDescendants(void) { compactAtlas(); return _descendants; }
 
     /** creates a CCSpriteBatchNode with a texture2d and capacity of children.
     The capacity will be increased in 33% in runtime if it run out of space.
@@ -128,6 +128,23 @@ public:
     unsigned int atlasIndexForChild(CCSprite *sprite, int z);
     /* Sprites use this to start sortChildren, don't call this manually */
     void reorderBatch(bool reorder);
+
+    /** Enables or disables the deferred atlas update mode. Disabled by default.
+    In this mode removing a sprite doesn't move the quads and the descendants behind it:
+    its quad is replaced by a degenerate, transparent quad (a tombstone), and all the
+    tombstones are removed at once by compactAtlas() before the next draw.
+    Added sprites are always appended, so spawning and despawning a sprite is O(1) amortised.
+    Use it for batches with a lot of short-lived sprites (bullets, debris, ...).
+    @since v3.0
+    */
+    void setDeferredAtlasUpdate(bool deferred);
+    inline bool isDeferredAtlasUpdate(void) { return _deferredAtlasUpdate; }
+
+    /** Removes the tombstone quads left by the deferred atlas update mode in a single linear pass.
+    It is called by sortAllChildren, so once per frame.
+    @since v3.0
+    */
+    void compactAtlas();
     // CCTextureProtocol
     virtual CCTexture2D* getTexture(void);
     virtual void setTexture(CCTexture2D *texture);
@@ -171,7 +188,11 @@ protected:
     ccBlendFunc _blendFunc;
 
     // all descendants: children, gran children, etc...
+    // In deferred atlas update mode, the removed sprites leave NULL entries until compactAtlas() is called.
     CCArray* _descendants;
+
+    bool _deferredAtlasUpdate;
+    unsigned int _tombstoneCount;
 };
 
 // end of sprite_nodes group
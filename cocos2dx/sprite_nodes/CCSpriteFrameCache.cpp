@@ -34,15 +34,302 @@ THE SOFTWARE.
 #include "CCSprite.h"
 #include "support/TransformUtils.h"
 #include "platform/CCFileUtils.h"
+#include "platform/CCFileView.h"
 #include "cocoa/CCString.h"
 #include "cocoa/CCArray.h"
 #include "cocoa/CCDictionary.h"
 #include <vector>
+#include <stdlib.h>
+#include <string.h>
 
 using namespace std;
 
 NS_CC_BEGIN
 
+/*
+ Precompiled sprite sheets (".ccsheet"), written by tools/sprite_sheet_compiler in little endian:
+
+ header      32 bytes, ccSpriteSheetHeader
+ frames      frameCount ccSpriteSheetFrame, in points like the plists
+ aliases     aliasCount ccSpriteSheetAlias
+ slots       slotCount (a power of two) indices of the frames, or frameCount + the indices of the
+             aliases, 0xffffffff for the empty slots; a name is in the slot of its FNV-1a hash,
+             or in the following ones
+ names       namesSize bytes of NUL terminated names, each one stored once
+ */
+static const unsigned int kSpriteSheetVersion = 1;
+static const unsigned int kSpriteSheetNone = 0xffffffff;
+
+struct ccSpriteSheetHeader
+{
+    char magic[4];          // "CCSF"
+    unsigned int version;
+    unsigned int frameCount;
+    unsigned int aliasCount;
+    unsigned int slotCount;
+    unsigned int namesSize;
+    unsigned int textureName;   // kSpriteSheetNone without texture
+    unsigned int reserved;
+};
+
+struct ccSpriteSheetFrame
+{
+    unsigned int name;
+    float x;
+    float y;
+    float width;
+    float height;
+    float offsetX;
+    float offsetY;
+    float sourceWidth;
+    float sourceHeight;
+    unsigned int flags;     // bit 0: rotated
+};
+
+struct ccSpriteSheetAlias
+{
+    unsigned int name;
+    unsigned int frame;
+};
+
+static unsigned int hashFrameName(const char* name)
+{
+    // FNV-1a, must match tools/sprite_sheet_compiler
+    unsigned int hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)name; *p; ++p)
+    {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
+struct CCSpriteFrameCache::FrameSheet
+{
+    FrameSheet()
+    : texture(NULL)
+    , view(NULL)
+    , frames(NULL)
+    , aliases(NULL)
+    , slots(NULL)
+    , names(NULL)
+    , frameCount(0)
+    , aliasCount(0)
+    , slotCount(0)
+    , namesSize(0)
+    , removedCount(0)
+    {
+    }
+
+    ~FrameSheet()
+    {
+        CC_SAFE_RELEASE(texture);
+        CC_SAFE_RELEASE(view);
+    }
+
+    /** Uses a mapped precompiled sheet, returns false if it is not one. The view is retained. */
+    bool initWithView(CCFileView* pView)
+    {
+        const unsigned char* bytes = pView->getBytes();
+        unsigned long size = pView->getSize();
+        if (size < sizeof(ccSpriteSheetHeader) || memcmp(bytes, "CCSF", 4) != 0)
+        {
+            return false;
+        }
+
+        const ccSpriteSheetHeader* header = (const ccSpriteSheetHeader*)bytes;
+        unsigned long long expectedSize = sizeof(ccSpriteSheetHeader)
+            + (unsigned long long)header->frameCount * sizeof(ccSpriteSheetFrame)
+            + (unsigned long long)header->aliasCount * sizeof(ccSpriteSheetAlias)
+            + (unsigned long long)header->slotCount * sizeof(unsigned int)
+            + header->namesSize;
+        if (header->version != kSpriteSheetVersion || expectedSize > size
+            || (header->slotCount & (header->slotCount - 1)) != 0
+            || (header->slotCount == 0 && header->frameCount + header->aliasCount > 0)
+            || header->namesSize == 0)
+        {
+            CCLOG("cocos2d: CCSpriteFrameCache: unsupported or corrupted precompiled sheet");
+            return false;
+        }
+
+        frameCount = header->frameCount;
+        aliasCount = header->aliasCount;
+        slotCount = header->slotCount;
+        namesSize = header->namesSize;
+        frames = (const ccSpriteSheetFrame*)(header + 1);
+        aliases = (const ccSpriteSheetAlias*)(frames + frameCount);
+        slots = (const unsigned int*)(aliases + aliasCount);
+        names = (const char*)(slots + slotCount);
+
+        // the names of the frames are checked when they are looked up
+        if (names[namesSize - 1] != '\0')
+        {
+            return false;
+        }
+        for (unsigned int i = 0; i < aliasCount; ++i)
+        {
+            if (aliases[i].frame >= frameCount)
+            {
+                return false;
+            }
+        }
+
+        view = pView;
+        view->retain();
+        return true;
+    }
+
+    /** Points to the owned arrays, once they are filled. */
+    void useOwnedArrays()
+    {
+        frameCount = ownedFrames.size();
+        aliasCount = ownedAliases.size();
+        slotCount = ownedSlots.size();
+        namesSize = ownedNames.size();
+        frames = ownedFrames.empty() ? NULL : &ownedFrames[0];
+        aliases = ownedAliases.empty() ? NULL : &ownedAliases[0];
+        slots = ownedSlots.empty() ? NULL : &ownedSlots[0];
+        names = ownedNames.empty() ? NULL : &ownedNames[0];
+    }
+
+    const char* getTextureName() const
+    {
+        const ccSpriteSheetHeader* header = (const ccSpriteSheetHeader*)view->getBytes();
+        return header->textureName < namesSize ? names + header->textureName : NULL;
+    }
+
+    /** Index of the frame of a name or alias, -1 if the sheet doesn't contain it or it was removed. */
+    int indexOfFrame(const char* name, unsigned int hash) const
+    {
+        unsigned int mask = slotCount - 1;
+        for (unsigned int i = 0; i < slotCount; ++i)
+        {
+            unsigned int entry = slots[(hash + i) & mask];
+            unsigned int frame;
+            unsigned int nameOffset;
+            if (entry < frameCount)
+            {
+                frame = entry;
+                nameOffset = frames[entry].name;
+            }
+            else if (entry != kSpriteSheetNone && entry - frameCount < aliasCount)
+            {
+                frame = aliases[entry - frameCount].frame;
+                nameOffset = aliases[entry - frameCount].name;
+            }
+            else
+            {
+                return -1;
+            }
+
+            if (nameOffset < namesSize && strcmp(names + nameOffset, name) == 0)
+            {
+                return removed.empty() || ! removed[frame] ? (int)frame : -1;
+            }
+        }
+        return -1;
+    }
+
+    /** The name of a frame, NULL if the sheet is corrupted. */
+    const char* getFrameName(unsigned int idx) const
+    {
+        return frames[idx].name < namesSize ? names + frames[idx].name : NULL;
+    }
+
+    void removeFrame(unsigned int idx)
+    {
+        if (removed.empty())
+        {
+            removed.resize(frameCount, false);
+        }
+        if (! removed[idx])
+        {
+            removed[idx] = true;
+            ++removedCount;
+        }
+    }
+
+    /** Adds a name or alias to the owned slots, returns false if it already exists. */
+    bool addOwnedSlot(unsigned int nameOffset, unsigned int entry)
+    {
+        const char* name = &ownedNames[nameOffset];
+        unsigned int mask = ownedSlots.size() - 1;
+        unsigned int i = hashFrameName(name) & mask;
+        while (ownedSlots[i] != kSpriteSheetNone)
+        {
+            unsigned int other = ownedSlots[i];
+            unsigned int otherName = other < ownedFrames.size() ? ownedFrames[other].name : ownedAliases[other - ownedFrames.size()].name;
+            if (strcmp(&ownedNames[otherName], name) == 0)
+            {
+                return false;
+            }
+            i = (i + 1) & mask;
+        }
+        ownedSlots[i] = entry;
+        return true;
+    }
+
+    CCTexture2D* texture;
+    // full path of the file of the sheet, empty for the dictionaries
+    std::string path;
+    // precompiled sheets point into their view, the plists into the owned arrays
+    CCFileView* view;
+    std::vector<ccSpriteSheetFrame> ownedFrames;
+    std::vector<ccSpriteSheetAlias> ownedAliases;
+    std::vector<unsigned int> ownedSlots;
+    std::vector<char> ownedNames;
+    const ccSpriteSheetFrame* frames;
+    const ccSpriteSheetAlias* aliases;
+    const unsigned int* slots;
+    const char* names;
+    unsigned int frameCount;
+    unsigned int aliasCount;
+    unsigned int slotCount;
+    unsigned int namesSize;
+    // frames removed from the cache, allocated by the first removal
+    std::vector<bool> removed;
+    unsigned int removedCount;
+};
+
+CCFileView* CCSpriteFrameCache::openSheetFile(const std::string& fullPath, CCDictionary** pDict)
+{
+    *pDict = NULL;
+    CCFileView* pView = CCFileUtils::sharedFileUtils()->openFileView(fullPath.c_str());
+    if (pView && (pView->getSize() < 4 || memcmp(pView->getBytes(), "CCSF", 4) != 0))
+    {
+        *pDict = CCFileUtils::sharedFileUtils()->createCCDictionaryWithFileView(pView);
+        CC_SAFE_RELEASE_NULL(pView);
+    }
+    return pView;
+}
+
+// reads the numbers of "{x,y}" and "{{x,y},{w,h}}", without the temporary strings of CCRectFromString
+static void parseFloats(const char* text, float* values, int count)
+{
+    int found = 0;
+    while (*text && found < count)
+    {
+        char c = *text;
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.')
+        {
+            char* end = NULL;
+            values[found++] = (float)strtod(text, &end);
+            if (end == text)
+            {
+                break;
+            }
+            text = end;
+        }
+        else
+        {
+            ++text;
+        }
+    }
+    for (; found < count; ++found)
+    {
+        values[found] = 0;
+    }
+}
+
 static CCSpriteFrameCache *pSharedSpriteFrameCache = NULL;
 
 CCSpriteFrameCache* CCSpriteFrameCache::sharedSpriteFrameCache(void)
@@ -71,12 +358,18 @@ bool CCSpriteFrameCache::init(void)
 
 CCSpriteFrameCache::~CCSpriteFrameCache(void)
 {
+    removeFrameSheets();
     CC_SAFE_RELEASE(_spriteFrames);
     CC_SAFE_RELEASE(_spriteFramesAliases);
     CC_SAFE_DELETE(_loadedFileNames);
 }
 
 void CCSpriteFrameCache::addSpriteFramesWithDictionary(CCDictionary* dictionary, CCTexture2D *pobTexture)
+{
+    addFrameSheetWithDictionary(dictionary, pobTexture, "");
+}
+
+void CCSpriteFrameCache::addFrameSheetWithDictionary(CCDictionary* dictionary, CCTexture2D *pobTexture, const std::string& path)
 {
     /*
     Supported Zwoptex Formats:
@@ -100,25 +393,30 @@ void CCSpriteFrameCache::addSpriteFramesWithDictionary(CCDictionary* dictionary,
     // check the format
     CCAssert(format >=0 && format <= 3, "format is not supported for CCSpriteFrameCache addSpriteFramesWithDictionary:textureFilename:");
 
+    // the frames are converted to the records of the precompiled sheets, created on demand
+    FrameSheet* sheet = new FrameSheet();
+    unsigned int frameCount = framesDict ? framesDict->count() : 0;
+    sheet->ownedFrames.reserve(frameCount);
+
     CCDictElement* pElement = NULL;
     CCDICT_FOREACH(framesDict, pElement)
     {
         CCDictionary* frameDict = (CCDictionary*)pElement->getObject();
-        std::string spriteFrameName = pElement->getStrKey();
-        CCSpriteFrame* spriteFrame = (CCSpriteFrame*)_spriteFrames->objectForKey(spriteFrameName);
-        if (spriteFrame)
-        {
-            continue;
-        }
-        
+        const char* spriteFrameName = pElement->getStrKey();
+
+        ccSpriteSheetFrame frame;
+        memset(&frame, 0, sizeof(frame));
+        frame.name = sheet->ownedNames.size();
+        sheet->ownedNames.insert(sheet->ownedNames.end(), spriteFrameName, spriteFrameName + strlen(spriteFrameName) + 1);
+
         if(format == 0) 
         {
-            float x = frameDict->valueForKey("x")->floatValue();
-            float y = frameDict->valueForKey("y")->floatValue();
-            float w = frameDict->valueForKey("width")->floatValue();
-            float h = frameDict->valueForKey("height")->floatValue();
-            float ox = frameDict->valueForKey("offsetX")->floatValue();
-            float oy = frameDict->valueForKey("offsetY")->floatValue();
+            frame.x = frameDict->valueForKey("x")->floatValue();
+            frame.y = frameDict->valueForKey("y")->floatValue();
+            frame.width = frameDict->valueForKey("width")->floatValue();
+            frame.height = frameDict->valueForKey("height")->floatValue();
+            frame.offsetX = frameDict->valueForKey("offsetX")->floatValue();
+            frame.offsetY = frameDict->valueForKey("offsetY")->floatValue();
             int ow = frameDict->valueForKey("originalWidth")->intValue();
             int oh = frameDict->valueForKey("originalHeight")->intValue();
             // check ow/oh
@@ -127,88 +425,158 @@ void CCSpriteFrameCache::addSpriteFramesWithDictionary(CCDictionary* dictionary,
                 CCLOGWARN("cocos2d: WARNING: originalWidth/Height not found on the CCSpriteFrame. AnchorPoint won't work as expected. Regenrate the .plist");
             }
             // abs ow/oh
-            ow = abs(ow);
-            oh = abs(oh);
-            // create frame
-            spriteFrame = new CCSpriteFrame();
-            spriteFrame->initWithTexture(pobTexture, 
-                                        CCRectMake(x, y, w, h), 
-                                        false,
-                                        CCPointMake(ox, oy),
-                                        CCSizeMake((float)ow, (float)oh)
-                                        );
+            frame.sourceWidth = (float)abs(ow);
+            frame.sourceHeight = (float)abs(oh);
         } 
         else if(format == 1 || format == 2) 
         {
-            CCRect frame = CCRectFromString(frameDict->valueForKey("frame")->getCString());
-            bool rotated = false;
+            parseFloats(frameDict->valueForKey("frame")->getCString(), &frame.x, 4);
 
             // rotation
-            if (format == 2)
+            if (format == 2 && frameDict->valueForKey("rotated")->boolValue())
             {
-                rotated = frameDict->valueForKey("rotated")->boolValue();
+                frame.flags = 1;
             }
 
-            CCPoint offset = CCPointFromString(frameDict->valueForKey("offset")->getCString());
-            CCSize sourceSize = CCSizeFromString(frameDict->valueForKey("sourceSize")->getCString());
-
-            // create frame
-            spriteFrame = new CCSpriteFrame();
-            spriteFrame->initWithTexture(pobTexture, 
-                frame,
-                rotated,
-                offset,
-                sourceSize
-                );
+            parseFloats(frameDict->valueForKey("offset")->getCString(), &frame.offsetX, 2);
+            parseFloats(frameDict->valueForKey("sourceSize")->getCString(), &frame.sourceWidth, 2);
         } 
         else if (format == 3)
         {
-            // get values
-            CCSize spriteSize = CCSizeFromString(frameDict->valueForKey("spriteSize")->getCString());
-            CCPoint spriteOffset = CCPointFromString(frameDict->valueForKey("spriteOffset")->getCString());
-            CCSize spriteSourceSize = CCSizeFromString(frameDict->valueForKey("spriteSourceSize")->getCString());
-            CCRect textureRect = CCRectFromString(frameDict->valueForKey("textureRect")->getCString());
-            bool textureRotated = frameDict->valueForKey("textureRotated")->boolValue();
+            // get values, the rect has the origin of textureRect and the size of spriteSize
+            float textureRect[4];
+            parseFloats(frameDict->valueForKey("textureRect")->getCString(), textureRect, 4);
+            frame.x = textureRect[0];
+            frame.y = textureRect[1];
+            parseFloats(frameDict->valueForKey("spriteSize")->getCString(), &frame.width, 2);
+            parseFloats(frameDict->valueForKey("spriteOffset")->getCString(), &frame.offsetX, 2);
+            parseFloats(frameDict->valueForKey("spriteSourceSize")->getCString(), &frame.sourceWidth, 2);
+            if (frameDict->valueForKey("textureRotated")->boolValue())
+            {
+                frame.flags = 1;
+            }
 
             // get aliases
             CCArray* aliases = (CCArray*) (frameDict->objectForKey("aliases"));
-            CCString * frameKey = new CCString(spriteFrameName);
-
             CCObject* pObj = NULL;
             CCARRAY_FOREACH(aliases, pObj)
             {
-                std::string oneAlias = ((CCString*)pObj)->getCString();
-                if (_spriteFramesAliases->objectForKey(oneAlias.c_str()))
+                const char* oneAlias = ((CCString*)pObj)->getCString();
+                ccSpriteSheetAlias alias;
+                alias.name = sheet->ownedNames.size();
+                alias.frame = sheet->ownedFrames.size();
+                sheet->ownedNames.insert(sheet->ownedNames.end(), oneAlias, oneAlias + strlen(oneAlias) + 1);
+                sheet->ownedAliases.push_back(alias);
+            }
+        }
+
+        sheet->ownedFrames.push_back(frame);
+    }
+
+    // at most half full
+    unsigned int slotCount = 1;
+    while (slotCount < (sheet->ownedFrames.size() + sheet->ownedAliases.size()) * 2)
+    {
+        slotCount *= 2;
+    }
+    sheet->ownedSlots.resize(slotCount, kSpriteSheetNone);
+    for (unsigned int i = 0; i < sheet->ownedFrames.size(); ++i)
+    {
+        sheet->addOwnedSlot(sheet->ownedFrames[i].name, i);
+    }
+    for (unsigned int i = 0; i < sheet->ownedAliases.size(); ++i)
+    {
+        if (! sheet->addOwnedSlot(sheet->ownedAliases[i].name, sheet->ownedFrames.size() + i))
+        {
+            CCLOGWARN("cocos2d: WARNING: an alias with name %s already exists", &sheet->ownedNames[sheet->ownedAliases[i].name]);
+        }
+    }
+
+    sheet->useOwnedArrays();
+    sheet->texture = pobTexture;
+    CC_SAFE_RETAIN(pobTexture);
+    sheet->path = path;
+    addFrameSheet(sheet);
+}
+
+void CCSpriteFrameCache::addFrameSheet(FrameSheet* sheet)
+{
+    if (sheet->frameCount == 0)
+    {
+        delete sheet;
+        return;
+    }
+
+    // a file loaded again replaces its sheet, and the frames created from it
+    for (unsigned int i = 0; ! sheet->path.empty() && i < _frameSheets.size(); ++i)
+    {
+        FrameSheet* old = _frameSheets[i];
+        if (old->path == sheet->path)
+        {
+            for (unsigned int j = 0; j < old->frameCount; ++j)
+            {
+                const char* name = old->getFrameName(j);
+                if (name)
                 {
-                    CCLOGWARN("cocos2d: WARNING: an alias with name %s already exists", oneAlias.c_str());
+                    _spriteFrames->removeObjectForKey(name);
                 }
-
-                _spriteFramesAliases->setObject(frameKey, oneAlias.c_str());
             }
-            frameKey->release();
-            // create frame
-            spriteFrame = new CCSpriteFrame();
-            spriteFrame->initWithTexture(pobTexture,
-                            CCRectMake(textureRect.origin.x, textureRect.origin.y, spriteSize.width, spriteSize.height),
-                            textureRotated,
-                            spriteOffset,
-                            spriteSourceSize);
+            delete old;
+            _frameSheets[i] = sheet;
+            return;
         }
+    }
+    _frameSheets.push_back(sheet);
+}
 
-        // add sprite frame
-        _spriteFrames->setObject(spriteFrame, spriteFrameName);
-        spriteFrame->release();
+CCSpriteFrameCache::FrameSheet* CCSpriteFrameCache::frameSheetForPath(const std::string& fullPath)
+{
+    for (unsigned int i = 0; i < _frameSheets.size(); ++i)
+    {
+        if (_frameSheets[i]->path == fullPath)
+        {
+            return _frameSheets[i];
+        }
     }
+    return NULL;
 }
 
 void CCSpriteFrameCache::addSpriteFramesWithFile(const char *pszPlist, CCTexture2D *pobTexture)
 {
     std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(pszPlist);
-    CCDictionary *dict = CCDictionary::createWithContentsOfFileThreadSafe(fullPath.c_str());
 
-    addSpriteFramesWithDictionary(dict, pobTexture);
+    // already loaded with this texture, and none of its frames was removed
+    FrameSheet* loaded = frameSheetForPath(fullPath);
+    if (loaded && loaded->texture == pobTexture && loaded->removedCount == 0)
+    {
+        return;
+    }
+
+    CCDictionary* dict = NULL;
+    CCFileView* pView = openSheetFile(fullPath, &dict);
+    if (pView)
+    {
+        FrameSheet* sheet = new FrameSheet();
+        if (sheet->initWithView(pView))
+        {
+            sheet->texture = pobTexture;
+            CC_SAFE_RETAIN(pobTexture);
+            sheet->path = fullPath;
+            addFrameSheet(sheet);
+        }
+        else
+        {
+            delete sheet;
+        }
+        pView->release();
+        return;
+    }
 
-    dict->release();
+    if (dict)
+    {
+        addFrameSheetWithDictionary(dict, pobTexture, fullPath);
+        dict->release();
+    }
 }
 
 void CCSpriteFrameCache::addSpriteFramesWithFile(const char* plist, const char* textureFileName)
@@ -233,15 +601,37 @@ void CCSpriteFrameCache::addSpriteFramesWithFile(const char *pszPlist)
     if (_loadedFileNames->find(pszPlist) == _loadedFileNames->end())
     {
         std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(pszPlist);
-        CCDictionary *dict = CCDictionary::createWithContentsOfFileThreadSafe(fullPath.c_str());
+        CCDictionary *dict = NULL;
+        FrameSheet *sheet = NULL;
 
         string texturePath("");
 
-        CCDictionary* metadataDict = (CCDictionary*)dict->objectForKey("metadata");
-        if (metadataDict)
+        CCFileView* pView = openSheetFile(fullPath, &dict);
+        if (pView)
         {
-            // try to read  texture file name from meta data
-            texturePath = metadataDict->valueForKey("textureFileName")->getCString();
+            sheet = new FrameSheet();
+            if (! sheet->initWithView(pView))
+            {
+                CC_SAFE_DELETE(sheet);
+            }
+            pView->release();
+            if (! sheet)
+            {
+                return;
+            }
+            if (sheet->getTextureName())
+            {
+                texturePath = sheet->getTextureName();
+            }
+        }
+        else if (dict)
+        {
+            CCDictionary* metadataDict = (CCDictionary*)dict->objectForKey("metadata");
+            if (metadataDict)
+            {
+                // try to read  texture file name from meta data
+                texturePath = metadataDict->valueForKey("textureFileName")->getCString();
+            }
         }
 
         if (! texturePath.empty())
@@ -268,7 +658,18 @@ void CCSpriteFrameCache::addSpriteFramesWithFile(const char *pszPlist)
 
         if (pTexture)
         {
-            addSpriteFramesWithDictionary(dict, pTexture);
+            if (sheet)
+            {
+                sheet->texture = pTexture;
+                pTexture->retain();
+                sheet->path = fullPath;
+                addFrameSheet(sheet);
+                sheet = NULL;
+            }
+            else if (dict)
+            {
+                addFrameSheetWithDictionary(dict, pTexture, fullPath);
+            }
             _loadedFileNames->insert(pszPlist);
         }
         else
@@ -276,7 +677,8 @@ void CCSpriteFrameCache::addSpriteFramesWithFile(const char *pszPlist)
             CCLOG("cocos2d: CCSpriteFrameCache: Couldn't load texture");
         }
 
-        dict->release();
+        CC_SAFE_DELETE(sheet);
+        CC_SAFE_RELEASE(dict);
     }
 
 }
@@ -291,11 +693,21 @@ void CCSpriteFrameCache::removeSpriteFrames(void)
     _spriteFrames->removeAllObjects();
     _spriteFramesAliases->removeAllObjects();
     _loadedFileNames->clear();
+    removeFrameSheets();
+}
+
+void CCSpriteFrameCache::removeFrameSheets()
+{
+    for (unsigned int i = 0; i < _frameSheets.size(); ++i)
+    {
+        delete _frameSheets[i];
+    }
+    _frameSheets.clear();
 }
 
 void CCSpriteFrameCache::removeUnusedSpriteFrames(void)
 {
-    bool bRemoved = false;
+    // the frames of the sheets are created again on demand, so their files stay loaded
     CCDictElement* pElement = NULL;
     CCDICT_FOREACH(_spriteFrames, pElement)
     {
@@ -304,15 +716,8 @@ void CCSpriteFrameCache::removeUnusedSpriteFrames(void)
         {
             CCLOG("cocos2d: CCSpriteFrameCache: removing unused frame: %s", pElement->getStrKey());
             _spriteFrames->removeObjectForElememt(pElement);
-            bRemoved = true;
         }
     }
-
-    // XXX. Since we don't know the .plist file that originated the frame, we must remove all .plist from the cache
-    if( bRemoved )
-    {
-        _loadedFileNames->clear();
-    }
 }
 
 
@@ -336,17 +741,67 @@ void CCSpriteFrameCache::removeSpriteFrameByName(const char *pszName)
     {
         _spriteFrames->removeObjectForKey(pszName);
     }
+    removeSheetFrameByName(pszName);
 
     // XXX. Since we don't know the .plist file that originated the frame, we must remove all .plist from the cache
     _loadedFileNames->clear();
 }
 
+void CCSpriteFrameCache::removeSheetFrameByName(const char* name)
+{
+    unsigned int hash = hashFrameName(name);
+    for (unsigned int i = 0; i < _frameSheets.size(); )
+    {
+        FrameSheet* sheet = _frameSheets[i];
+        int idx = sheet->indexOfFrame(name, hash);
+        if (idx >= 0)
+        {
+            // removing an alias removes its frame, like the plists
+            const char* frameName = sheet->getFrameName(idx);
+            if (frameName && strcmp(frameName, name) != 0)
+            {
+                _spriteFrames->removeObjectForKey(frameName);
+            }
+            sheet->removeFrame(idx);
+            if (sheet->removedCount == sheet->frameCount)
+            {
+                delete sheet;
+                _frameSheets.erase(_frameSheets.begin() + i);
+                continue;
+            }
+        }
+        ++i;
+    }
+}
+
 void CCSpriteFrameCache::removeSpriteFramesFromFile(const char* plist)
 {
     std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(plist);
-    CCDictionary* dict = CCDictionary::createWithContentsOfFileThreadSafe(fullPath.c_str());
 
-    removeSpriteFramesFromDictionary((CCDictionary*)dict);
+    CCDictionary* dict = NULL;
+    CCFileView* pView = openSheetFile(fullPath, &dict);
+    if (pView)
+    {
+        FrameSheet sheet;
+        if (sheet.initWithView(pView))
+        {
+            for (unsigned int i = 0; i < sheet.frameCount; ++i)
+            {
+                const char* name = sheet.getFrameName(i);
+                if (name)
+                {
+                    _spriteFrames->removeObjectForKey(name);
+                    removeSheetFrameByName(name);
+                }
+            }
+        }
+        pView->release();
+    }
+    else if (dict)
+    {
+        removeSpriteFramesFromDictionary(dict);
+        dict->release();
+    }
 
     // remove it from the cache
     set<string>::iterator ret = _loadedFileNames->find(plist);
@@ -354,8 +809,6 @@ void CCSpriteFrameCache::removeSpriteFramesFromFile(const char* plist)
     {
         _loadedFileNames->erase(ret);
     }
-
-    dict->release();
 }
 
 void CCSpriteFrameCache::removeSpriteFramesFromDictionary(CCDictionary* dictionary)
@@ -370,6 +823,7 @@ void CCSpriteFrameCache::removeSpriteFramesFromDictionary(CCDictionary* dictiona
         {
             keysToRemove->addObject(CCString::create(pElement->getStrKey()));
         }
+        removeSheetFrameByName(pElement->getStrKey());
     }
 
     _spriteFrames->removeObjectsForKeys(keysToRemove);
@@ -391,12 +845,65 @@ void CCSpriteFrameCache::removeSpriteFramesFromTexture(CCTexture2D* texture)
     }
 
     _spriteFrames->removeObjectsForKeys(keysToRemove);
+
+    for (unsigned int i = 0; i < _frameSheets.size(); )
+    {
+        if (_frameSheets[i]->texture == texture)
+        {
+            delete _frameSheets[i];
+            _frameSheets.erase(_frameSheets.begin() + i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+CCSpriteFrame* CCSpriteFrameCache::sheetFrameByName(const char* name)
+{
+    unsigned int hash = hashFrameName(name);
+    for (unsigned int i = 0; i < _frameSheets.size(); ++i)
+    {
+        FrameSheet* sheet = _frameSheets[i];
+        int idx = sheet->indexOfFrame(name, hash);
+        if (idx < 0)
+        {
+            continue;
+        }
+
+        const char* frameName = sheet->getFrameName(idx);
+        if (frameName == NULL)
+        {
+            return NULL;
+        }
+        // the frame of an alias may already exist
+        CCSpriteFrame* frame = strcmp(frameName, name) != 0 ? (CCSpriteFrame*)_spriteFrames->objectForKey(frameName) : NULL;
+        if (frame == NULL)
+        {
+            const ccSpriteSheetFrame& record = sheet->frames[idx];
+            frame = new CCSpriteFrame();
+            frame->initWithTexture(sheet->texture,
+                                   CCRectMake(record.x, record.y, record.width, record.height),
+                                   (record.flags & 1) != 0,
+                                   CCPointMake(record.offsetX, record.offsetY),
+                                   CCSizeMake(record.sourceWidth, record.sourceHeight));
+            _spriteFrames->setObject(frame, frameName);
+            frame->release();
+        }
+        return frame;
+    }
+    return NULL;
 }
 
 CCSpriteFrame* CCSpriteFrameCache::spriteFrameByName(const char *pszName)
 {
     CCSpriteFrame* frame = (CCSpriteFrame*)_spriteFrames->objectForKey(pszName);
     if (!frame)
+    {
+        frame = sheetFrameByName(pszName);
+    }
+    if (!frame)
     {
         // try alias dictionary
         CCString *key = (CCString*)_spriteFramesAliases->objectForKey(pszName);  
@@ -39,12 +39,14 @@ THE SOFTWARE.
 #include "cocoa/CCObject.h"
 #include <set>
 #include <string>
+#include <vector>
 
 NS_CC_BEGIN
 
 class CCDictionary;
 class CCArray;
 class CCSprite;
+class CCFileView;
 
 /**
  * @addtogroup sprite_nodes
@@ -53,13 +55,18 @@ class CCSprite;
 
 /** @brief Singleton that handles the loading of the sprite frames.
  It saves in a cache the sprite frames.
+
+ The sprite sheets can be xml or binary plists, or precompiled sheets made by
+ tools/sprite_sheet_compiler, which are mapped in memory and don't need any parsing.
+ The frames of the sheets are kept in a compact form, the CCSpriteFrame of a frame is only
+ created by the first spriteFrameByName call for it.
  @since v0.9
  */
 class CC_DLL CCSpriteFrameCache : public CCObject
 {
 protected:
     // MARMALADE: Made this protected not private, as deriving from this class is pretty useful
-    CCSpriteFrameCache(void) : _spriteFrames(NULL), _spriteFramesAliases(NULL){}
+    CCSpriteFrameCache(void) : _spriteFrames(NULL), _spriteFramesAliases(NULL), _loadedFileNames(NULL){}
 public:
     bool init(void);
     ~CCSpriteFrameCache(void);
@@ -69,7 +76,7 @@ private:
      */
     void addSpriteFramesWithDictionary(CCDictionary* pobDictionary, CCTexture2D *pobTexture);
 public:
-    /** Adds multiple Sprite Frames from a plist file.
+    /** Adds multiple Sprite Frames from a plist file or a precompiled sheet.
      * A texture will be loaded automatically. The texture name will composed by replacing the .plist suffix with .png
      * If you want to use another texture, you should use the addSpriteFramesWithFile:texture method.
      */
@@ -98,6 +105,7 @@ public:
 
     /** Removes unused sprite frames.
      * Sprite Frames that have a retain count of 1 will be deleted.
+     * The frames of the sheets are created again if they are requested later.
      * It is convenient to call this method after when starting a new Scene.
      */
     void removeUnusedSpriteFrames(void);
@@ -138,12 +146,32 @@ public:
     static void purgeSharedSpriteFrameCache(void);
 
 private:
+    struct FrameSheet;
+
+    /** Adds the frames of a sheet, takes its ownership. A sheet of the same file is replaced. */
+    void addFrameSheet(FrameSheet* sheet);
+    void addFrameSheetWithDictionary(CCDictionary* dictionary, CCTexture2D *pobTexture, const std::string& path);
+    /** Opens a sheet file once: returns the view of a precompiled sheet, or NULL and the dictionary of a plist
+        in pDict, which must be released. */
+    CCFileView* openSheetFile(const std::string& fullPath, CCDictionary** pDict);
+    /** Returns the sheet loaded from a file, or NULL. */
+    FrameSheet* frameSheetForPath(const std::string& fullPath);
+    /** Returns the frame of a name or alias of the sheets, created on the first call, or NULL. */
+    CCSpriteFrame* sheetFrameByName(const char* name);
+    /** Removes a name or alias from the sheets, and its frame from the cache. */
+    void removeSheetFrameByName(const char* name);
+    void removeFrameSheets();
+
     // MARMALADE: Made this protected not private, as deriving from this class is pretty useful
-//    CCSpriteFrameCache(void) : _spriteFrames(NULL), _spriteFramesAliases(NULL){}
+//    CCSpriteFrameCache(void) : _spriteFrames(NULL), _spriteFramesAliases(NULL), _loadedFileNames(NULL){}
 protected:
     CCDictionary* _spriteFrames;
     CCDictionary* _spriteFramesAliases;
     std::set<std::string>*  _loadedFileNames;
+
+private:
+    // searched in order after _spriteFrames, so the first sheet containing a name wins
+    std::vector<FrameSheet*> _frameSheets;
 };
 
 // end of sprite_nodes group
@@ -85,20 +85,11 @@ bool CCComponentContainer::remove(const char *pName)
     do 
     {        
         CC_BREAK_IF(!_components);
-        CCObject* pRetObject = NULL;
-        CCDictElement *pElement = NULL;
-        HASH_FIND_PTR(_components->_elements, pName, pElement);
-        if (pElement != NULL)
-        {
-           pRetObject = pElement->getObject();
-        }
-        CCComponent *com = dynamic_cast<CCComponent*>(pRetObject);
+        CCComponent *com = dynamic_cast<CCComponent*>(_components->objectForKey(pName));
         CC_BREAK_IF(!com);
         com->onExit();
         com->setOwner(NULL);
-        HASH_DEL(_components->_elements, pElement);
-        pElement->getObject()->release();
-        CC_SAFE_DELETE(pElement);
+        _components->removeObjectForKey(pName);
         bRet = true;
     } while(0);
     return bRet;
@@ -108,15 +99,13 @@ void CCComponentContainer::removeAll()
 {
     if (_components != NULL)
     {
-        CCDictElement *pElement, *tmp;
-        HASH_ITER(hh, _components->_elements, pElement, tmp)
+        CCDictElement *pElement = NULL;
+        CCDICT_FOREACH(_components, pElement)
         {
-            HASH_DEL(_components->_elements, pElement);
             ((CCComponent*)pElement->getObject())->onExit();
             ((CCComponent*)pElement->getObject())->setOwner(NULL);
-            pElement->getObject()->release();
-            CC_SAFE_DELETE(pElement);
         }
+        _components->removeAllObjects();
         _owner->unscheduleUpdate();
     }
 }
@@ -131,8 +120,8 @@ void CCComponentContainer::visit(float fDelta)
 {
     if (_components != NULL)
     {
-        CCDictElement *pElement, *tmp;
-        HASH_ITER(hh, _components->_elements, pElement, tmp)
+        CCDictElement *pElement = NULL;
+        CCDICT_FOREACH(_components, pElement)
         {
             ((CCComponent*)pElement->getObject())->update(fDelta);
         }
@@ -0,0 +1,892 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CCImageEncoder.h"
+#include "ccMacros.h"
+#include "CCDirector.h"
+#include "CCScheduler.h"
+#include <zlib.h>
+#include <string.h>
+#include <stdlib.h>
+#include <setjmp.h>
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_IOS) && (CC_TARGET_PLATFORM != CC_PLATFORM_MAC)
+#define CC_IMAGE_ENCODER_USE_JPEG 1
+#include "jpeglib.h"
+#else
+#define CC_IMAGE_ENCODER_USE_JPEG 0
+#endif
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
+#include <unistd.h>
+#endif
+
+NS_CC_BEGIN
+
+// Size of the deflate window, the tail of the previous strip that primes the dictionary of a strip
+#define CC_IMAGE_ENCODER_WINDOW_SIZE 32768
+
+struct CCImageEncoder::Task
+{
+    const void *group;
+    std::function<void()> run;
+    // set once run, under the mutex
+    bool *done;
+};
+
+struct CCImageEncoder::AsyncJob
+{
+    CCImage *image;
+    Options options;
+    std::string fullPath;
+    ccImageEncoderCallback callback;
+    std::vector<unsigned char> output;
+    bool succeeded;
+};
+
+CCImageEncoder::Options::Options()
+: format(CCImage::kFmtPng)
+, compressionLevel(Z_DEFAULT_COMPRESSION)
+, filter(CCImageEncoder::kFilterAdaptive)
+, quality(75)
+, keepAlpha(false)
+, stripRows(64)
+{
+}
+
+CCImageEncoder::Options CCImageEncoder::Options::fast()
+{
+    Options options;
+    options.compressionLevel = Z_BEST_SPEED;
+    options.filter = CCImageEncoder::kFilterNone;
+    return options;
+}
+
+//
+// PNG
+//
+
+static void writeUInt32(unsigned char *p, unsigned long value)
+{
+    p[0] = (unsigned char)(value >> 24);
+    p[1] = (unsigned char)(value >> 16);
+    p[2] = (unsigned char)(value >> 8);
+    p[3] = (unsigned char)value;
+}
+
+/* Writes the chunks of a PNG file to a file or to memory. */
+class PNGWriter
+{
+public:
+    PNGWriter(FILE *file, std::vector<unsigned char> *output)
+    : _file(file)
+    , _output(output)
+    {
+    }
+
+    bool write(const unsigned char *data, size_t len)
+    {
+        if (_file)
+        {
+            return fwrite(data, 1, len, _file) == len;
+        }
+        _output->insert(_output->end(), data, data + len);
+        return true;
+    }
+
+    bool writeChunk(const char *type, const unsigned char *data, size_t len)
+    {
+        unsigned char header[8];
+        writeUInt32(header, len);
+        memcpy(header + 4, type, 4);
+
+        unsigned long crc = crc32(0L, Z_NULL, 0);
+        crc = crc32(crc, header + 4, 4);
+        if (len > 0)
+        {
+            crc = crc32(crc, data, len);
+        }
+        unsigned char footer[4];
+        writeUInt32(footer, crc);
+
+        return write(header, 8) && (len == 0 || write(data, len)) && write(footer, 4);
+    }
+
+private:
+    FILE *_file;
+    std::vector<unsigned char> *_output;
+};
+
+static inline unsigned char paethPredictor(int a, int b, int c)
+{
+    int p = a + b - c;
+    int pa = abs(p - a);
+    int pb = abs(p - b);
+    int pc = abs(p - c);
+    if (pa <= pb && pa <= pc)
+    {
+        return (unsigned char)a;
+    }
+    return (unsigned char)(pb <= pc ? b : c);
+}
+
+/* Filters a row into out, the filter type first. prev is the previous row, or zeros for the first one. */
+static void filterRow(int filter, const unsigned char *row, const unsigned char *prev, size_t len, int bpp, unsigned char *out)
+{
+    out[0] = (unsigned char)filter;
+    unsigned char *dst = out + 1;
+    size_t i;
+
+    switch (filter)
+    {
+    case CCImageEncoder::kFilterNone:
+        memcpy(dst, row, len);
+        break;
+    case CCImageEncoder::kFilterSub:
+        for (i = 0; i < (size_t)bpp; ++i)
+        {
+            dst[i] = row[i];
+        }
+        for (; i < len; ++i)
+        {
+            dst[i] = row[i] - row[i - bpp];
+        }
+        break;
+    case CCImageEncoder::kFilterUp:
+        for (i = 0; i < len; ++i)
+        {
+            dst[i] = row[i] - prev[i];
+        }
+        break;
+    case CCImageEncoder::kFilterAverage:
+        for (i = 0; i < (size_t)bpp; ++i)
+        {
+            dst[i] = row[i] - (prev[i] >> 1);
+        }
+        for (; i < len; ++i)
+        {
+            dst[i] = row[i] - (unsigned char)((row[i - bpp] + prev[i]) >> 1);
+        }
+        break;
+    case CCImageEncoder::kFilterPaeth:
+        for (i = 0; i < (size_t)bpp; ++i)
+        {
+            dst[i] = row[i] - prev[i];
+        }
+        for (; i < len; ++i)
+        {
+            dst[i] = row[i] - paethPredictor(row[i - bpp], prev[i], prev[i - bpp]);
+        }
+        break;
+    }
+}
+
+/* Sum of the filtered bytes as signed values, the heuristic of libpng to choose a filter. */
+static unsigned long filterCost(const unsigned char *filtered, size_t len)
+{
+    unsigned long sum = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+        sum += filtered[i] < 128 ? filtered[i] : 256 - filtered[i];
+    }
+    return sum;
+}
+
+static void convertRow(const unsigned char *src, int width, int srcBpp, int dstBpp, unsigned char *dst)
+{
+    for (int i = 0; i < width; ++i)
+    {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        if (dstBpp == 4)
+        {
+            dst[3] = srcBpp == 4 ? src[3] : 0xff;
+        }
+        src += srcBpp;
+        dst += dstBpp;
+    }
+}
+
+struct PNGStrip
+{
+    int first;
+    int count;
+    // deflated rows, without the zlib header and checksum
+    std::vector<unsigned char> data;
+    // adler32 and size of the filtered rows
+    unsigned long adler;
+    unsigned long length;
+    bool ok;
+    bool done;
+};
+
+/* Filters and deflates the rows of a strip into a raw deflate stream ending on a byte boundary,
+ so the strips can be concatenated. The filtered tail of the previous strip primes the dictionary. */
+static void compressStrip(const unsigned char *pixels, int width, int height, int srcBpp, int dstBpp,
+                          int filter, int level, PNGStrip *strip)
+{
+    size_t rowLen = (size_t)width * dstBpp;
+    size_t srcRowLen = (size_t)width * srcBpp;
+    size_t filteredLen = rowLen + 1;
+
+    int dictRows = (int)((CC_IMAGE_ENCODER_WINDOW_SIZE + filteredLen - 1) / filteredLen);
+    if (dictRows > strip->first)
+    {
+        dictRows = strip->first;
+    }
+    int firstRow = strip->first - dictRows;
+    int rowCount = dictRows + strip->count;
+
+    std::vector<unsigned char> filtered(filteredLen * rowCount);
+    // converted rows, current and previous, when the pixels have to be converted
+    std::vector<unsigned char> rows(srcBpp != dstBpp ? rowLen * 2 : 0);
+    std::vector<unsigned char> zeros(rowLen, 0);
+    std::vector<unsigned char> candidate(filter == CCImageEncoder::kFilterAdaptive ? filteredLen : 0);
+
+    const unsigned char *prev = &zeros[0];
+    if (firstRow > 0)
+    {
+        prev = pixels + (firstRow - 1) * srcRowLen;
+        if (srcBpp != dstBpp)
+        {
+            convertRow(prev, width, srcBpp, dstBpp, &rows[rowLen]);
+            prev = &rows[rowLen];
+        }
+    }
+
+    for (int i = 0; i < rowCount; ++i)
+    {
+        const unsigned char *row = pixels + (firstRow + i) * srcRowLen;
+        if (srcBpp != dstBpp)
+        {
+            unsigned char *converted = &rows[(i & 1) * rowLen];
+            convertRow(row, width, srcBpp, dstBpp, converted);
+            row = converted;
+        }
+
+        unsigned char *out = &filtered[i * filteredLen];
+        if (filter == CCImageEncoder::kFilterAdaptive)
+        {
+            unsigned long bestCost = 0;
+            for (int f = CCImageEncoder::kFilterNone; f <= CCImageEncoder::kFilterPaeth; ++f)
+            {
+                filterRow(f, row, prev, rowLen, dstBpp, &candidate[0]);
+                unsigned long cost = filterCost(&candidate[1], rowLen);
+                if (f == CCImageEncoder::kFilterNone || cost < bestCost)
+                {
+                    bestCost = cost;
+                    memcpy(out, &candidate[0], filteredLen);
+                }
+            }
+        }
+        else
+        {
+            filterRow(filter, row, prev, rowLen, dstBpp, out);
+        }
+        prev = row;
+    }
+
+    unsigned char *rowsStart = &filtered[dictRows * filteredLen];
+    strip->length = strip->count * filteredLen;
+    strip->adler = adler32(adler32(0L, Z_NULL, 0), rowsStart, strip->length);
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    int strategy = filter == CCImageEncoder::kFilterNone ? Z_DEFAULT_STRATEGY : Z_FILTERED;
+    if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, strategy) != Z_OK)
+    {
+        strip->ok = false;
+        return;
+    }
+
+    if (dictRows > 0)
+    {
+        size_t dictLen = dictRows * filteredLen;
+        if (dictLen > CC_IMAGE_ENCODER_WINDOW_SIZE)
+        {
+            dictLen = CC_IMAGE_ENCODER_WINDOW_SIZE;
+        }
+        deflateSetDictionary(&stream, rowsStart - dictLen, dictLen);
+    }
+
+    bool last = strip->first + strip->count == height;
+    int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+
+    strip->data.resize(deflateBound(&stream, strip->length) + 16);
+    stream.next_in = rowsStart;
+    stream.avail_in = strip->length;
+    stream.next_out = &strip->data[0];
+    stream.avail_out = strip->data.size();
+
+    int ret = Z_OK;
+    while (true)
+    {
+        ret = deflate(&stream, flush);
+        if (ret == Z_STREAM_END || ret == Z_STREAM_ERROR
+            || (! last && stream.avail_in == 0 && stream.avail_out > 0))
+        {
+            break;
+        }
+        if (stream.avail_out == 0)
+        {
+            size_t used = strip->data.size();
+            strip->data.resize(used * 2);
+            stream.next_out = &strip->data[used];
+            stream.avail_out = strip->data.size() - used;
+        }
+    }
+
+    strip->data.resize(stream.total_out);
+    strip->ok = ret != Z_STREAM_ERROR;
+    deflateEnd(&stream);
+}
+
+bool CCImageEncoder::encodePNG(const unsigned char *pixels, int width, int height, bool hasAlpha, const Options& options,
+                               FILE *file, std::vector<unsigned char> *output)
+{
+    int srcBpp = hasAlpha ? 4 : 3;
+    int dstBpp = hasAlpha && options.keepAlpha ? 4 : 3;
+    int level = options.compressionLevel;
+
+    PNGWriter writer(file, output);
+
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    unsigned char header[13];
+    writeUInt32(header, width);
+    writeUInt32(header + 4, height);
+    header[8] = 8;                      // bit depth
+    header[9] = dstBpp == 4 ? 6 : 2;    // RGBA or RGB
+    header[10] = 0;                     // deflate
+    header[11] = 0;                     // adaptive filtering
+    header[12] = 0;                     // no interlace
+
+    bool ok = writer.write(signature, sizeof(signature)) && writer.writeChunk("IHDR", header, sizeof(header));
+
+    unsigned int stripRows = options.stripRows > 0 ? options.stripRows : height;
+    unsigned int stripCount = (height + stripRows - 1) / stripRows;
+    std::vector<PNGStrip> strips(stripCount);
+    for (unsigned int i = 0; i < stripCount; ++i)
+    {
+        PNGStrip& strip = strips[i];
+        strip.first = i * stripRows;
+        strip.count = i + 1 < stripCount ? stripRows : height - strip.first;
+        strip.adler = 0;
+        strip.length = 0;
+        strip.ok = false;
+        strip.done = false;
+    }
+
+    if (stripCount > 1)
+    {
+        for (unsigned int i = 0; i < stripCount; ++i)
+        {
+            PNGStrip *strip = &strips[i];
+            Task *task = new Task();
+            task->group = &strips;
+            task->done = &strip->done;
+            task->run = [=]() {
+                compressStrip(pixels, width, height, srcBpp, dstBpp, options.filter, level, strip);
+            };
+            addTask(task);
+        }
+    }
+    else if (stripCount == 1)
+    {
+        compressStrip(pixels, width, height, srcBpp, dstBpp, options.filter, level, &strips[0]);
+        strips[0].done = true;
+    }
+
+    // zlib header: deflate with a 32K window, and the level hint computed like zlib does
+    int levelFlag = level == Z_DEFAULT_COMPRESSION ? 2 : (level < 2 ? 0 : (level < 6 ? 1 : (level == 6 ? 2 : 3)));
+    unsigned int zlibHeader = (0x78 << 8) | (levelFlag << 6);
+    zlibHeader += 31 - zlibHeader % 31;
+
+    unsigned long adler = adler32(0L, Z_NULL, 0);
+    // the strips are written in order, as soon as they are compressed
+    for (unsigned int i = 0; i < stripCount; ++i)
+    {
+        PNGStrip& strip = strips[i];
+        if (stripCount > 1)
+        {
+            waitFor(&strips, [&strip]() { return strip.done; });
+        }
+
+        ok = ok && strip.ok;
+        if (! ok)
+        {
+            continue;
+        }
+
+        adler = adler32_combine(adler, strip.adler, strip.length);
+        if (i == 0)
+        {
+            unsigned char zlibHeaderBytes[2] = { (unsigned char)(zlibHeader >> 8), (unsigned char)zlibHeader };
+            strip.data.insert(strip.data.begin(), zlibHeaderBytes, zlibHeaderBytes + 2);
+        }
+        if (i + 1 == stripCount)
+        {
+            unsigned char adlerBytes[4];
+            writeUInt32(adlerBytes, adler);
+            strip.data.insert(strip.data.end(), adlerBytes, adlerBytes + 4);
+        }
+
+        ok = writer.writeChunk("IDAT", &strip.data[0], strip.data.size());
+        std::vector<unsigned char>().swap(strip.data);
+    }
+
+    return ok && writer.writeChunk("IEND", NULL, 0);
+}
+
+//
+// JPEG
+//
+
+#if CC_IMAGE_ENCODER_USE_JPEG
+
+struct JPGErrorManager
+{
+    struct jpeg_error_mgr pub;
+    jmp_buf setjmpBuffer;
+};
+
+static void jpgErrorExit(j_common_ptr cinfo)
+{
+    JPGErrorManager *err = (JPGErrorManager*)cinfo->err;
+    char buffer[JMSG_LENGTH_MAX];
+    (*cinfo->err->format_message)(cinfo, buffer);
+    CCLOG("cocos2d: CCImageEncoder: %s", buffer);
+    longjmp(err->setjmpBuffer, 1);
+}
+
+/* libjpeg destination appending to a vector. */
+struct JPGDestination
+{
+    struct jpeg_destination_mgr pub;
+    std::vector<unsigned char> *output;
+};
+
+static void jpgInitDestination(j_compress_ptr cinfo)
+{
+    JPGDestination *dest = (JPGDestination*)cinfo->dest;
+    dest->output->resize(64 * 1024);
+    dest->pub.next_output_byte = &(*dest->output)[0];
+    dest->pub.free_in_buffer = dest->output->size();
+}
+
+static boolean jpgEmptyOutputBuffer(j_compress_ptr cinfo)
+{
+    JPGDestination *dest = (JPGDestination*)cinfo->dest;
+    size_t used = dest->output->size();
+    dest->output->resize(used * 2);
+    dest->pub.next_output_byte = &(*dest->output)[used];
+    dest->pub.free_in_buffer = dest->output->size() - used;
+    return TRUE;
+}
+
+static void jpgTermDestination(j_compress_ptr cinfo)
+{
+    JPGDestination *dest = (JPGDestination*)cinfo->dest;
+    dest->output->resize(dest->output->size() - dest->pub.free_in_buffer);
+}
+
+#endif // CC_IMAGE_ENCODER_USE_JPEG
+
+bool CCImageEncoder::encodeJPG(const unsigned char *pixels, int width, int height, bool hasAlpha, const Options& options,
+                               FILE *file, std::vector<unsigned char> *output)
+{
+#if CC_IMAGE_ENCODER_USE_JPEG
+    struct jpeg_compress_struct cinfo;
+    JPGErrorManager err;
+    JPGDestination dest;
+    // only the rows of RGBA images are converted, one at a time
+    std::vector<unsigned char> row(hasAlpha ? width * 3 : 0);
+
+    cinfo.err = jpeg_std_error(&err.pub);
+    err.pub.error_exit = jpgErrorExit;
+    if (setjmp(err.setjmpBuffer))
+    {
+        jpeg_destroy_compress(&cinfo);
+        return false;
+    }
+
+    jpeg_create_compress(&cinfo);
+    if (file)
+    {
+        jpeg_stdio_dest(&cinfo, file);
+    }
+    else
+    {
+        dest.pub.init_destination = jpgInitDestination;
+        dest.pub.empty_output_buffer = jpgEmptyOutputBuffer;
+        dest.pub.term_destination = jpgTermDestination;
+        dest.output = output;
+        cinfo.dest = &dest.pub;
+    }
+
+    cinfo.image_width = width;
+    cinfo.image_height = height;
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, options.quality, TRUE);
+
+    jpeg_start_compress(&cinfo, TRUE);
+
+    while (cinfo.next_scanline < cinfo.image_height)
+    {
+        JSAMPROW rowPointer;
+        if (hasAlpha)
+        {
+            convertRow(pixels + cinfo.next_scanline * width * 4, width, 4, 3, &row[0]);
+            rowPointer = &row[0];
+        }
+        else
+        {
+            rowPointer = (JSAMPROW)pixels + cinfo.next_scanline * width * 3;
+        }
+        jpeg_write_scanlines(&cinfo, &rowPointer, 1);
+    }
+
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    return true;
+#else
+    CCLOG("cocos2d: CCImageEncoder: JPEG is not supported on this platform");
+    return false;
+#endif
+}
+
+//
+// CCImageEncoder
+//
+
+static CCImageEncoder *s_pSharedEncoder = NULL;
+static pthread_mutex_t s_sharedEncoderMutex = PTHREAD_MUTEX_INITIALIZER;
+
+CCImageEncoder* CCImageEncoder::sharedEncoder()
+{
+    // CCImage::saveToFile may be called from any thread
+    pthread_mutex_lock(&s_sharedEncoderMutex);
+    if (! s_pSharedEncoder)
+    {
+        s_pSharedEncoder = new CCImageEncoder();
+    }
+    pthread_mutex_unlock(&s_sharedEncoderMutex);
+    return s_pSharedEncoder;
+}
+
+void CCImageEncoder::purgeSharedEncoder()
+{
+    pthread_mutex_lock(&s_sharedEncoderMutex);
+    CCImageEncoder *encoder = s_pSharedEncoder;
+    s_pSharedEncoder = NULL;
+    pthread_mutex_unlock(&s_sharedEncoderMutex);
+
+    if (encoder)
+    {
+        encoder->stopThreads();
+        encoder->update(0);
+        encoder->release();
+    }
+}
+
+CCImageEncoder::CCImageEncoder()
+: _threadCount(1)
+, _pendingJobs(0)
+, _scheduled(false)
+, _quit(false)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores > 2)
+    {
+        _threadCount = cores - 1;
+    }
+#endif
+
+    pthread_mutex_init(&_mutex, NULL);
+    pthread_cond_init(&_taskCondition, NULL);
+    pthread_cond_init(&_doneCondition, NULL);
+}
+
+CCImageEncoder::~CCImageEncoder()
+{
+    stopThreads();
+    pthread_mutex_destroy(&_mutex);
+    pthread_cond_destroy(&_taskCondition);
+    pthread_cond_destroy(&_doneCondition);
+}
+
+unsigned int CCImageEncoder::getThreadCount() const
+{
+    return _threadCount;
+}
+
+void CCImageEncoder::setThreadCount(unsigned int count)
+{
+    CCAssert(count > 0, "At least one thread is needed");
+    stopThreads();
+    _threadCount = count;
+}
+
+void CCImageEncoder::startThreads()
+{
+    // called with the mutex locked
+    _threads.resize(_threadCount);
+    for (unsigned int i = 0; i < _threadCount; ++i)
+    {
+        pthread_create(&_threads[i], NULL, workerThread, this);
+    }
+}
+
+void CCImageEncoder::stopThreads()
+{
+    pthread_mutex_lock(&_mutex);
+    _quit = true;
+    pthread_cond_broadcast(&_taskCondition);
+    std::vector<pthread_t> threads;
+    threads.swap(_threads);
+    pthread_mutex_unlock(&_mutex);
+
+    // the threads finish the queued tasks before quitting
+    for (std::vector<pthread_t>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        pthread_join(*it, NULL);
+    }
+
+    pthread_mutex_lock(&_mutex);
+    _quit = false;
+    pthread_mutex_unlock(&_mutex);
+}
+
+void CCImageEncoder::addTask(Task *task)
+{
+    pthread_mutex_lock(&_mutex);
+    if (_threads.empty())
+    {
+        startThreads();
+    }
+    _tasks.push_back(task);
+    pthread_cond_signal(&_taskCondition);
+    pthread_mutex_unlock(&_mutex);
+}
+
+void CCImageEncoder::waitFor(const void *group, const std::function<bool()>& finished)
+{
+    pthread_mutex_lock(&_mutex);
+    while (! finished())
+    {
+        std::deque<Task*>::iterator it = _tasks.begin();
+        while (it != _tasks.end() && (*it)->group != group)
+        {
+            ++it;
+        }
+
+        if (it == _tasks.end())
+        {
+            pthread_cond_wait(&_doneCondition, &_mutex);
+            continue;
+        }
+
+        // help instead of waiting, this also avoids deadlocks when all the workers wait
+        Task *task = *it;
+        _tasks.erase(it);
+        pthread_mutex_unlock(&_mutex);
+
+        task->run();
+
+        pthread_mutex_lock(&_mutex);
+        if (task->done)
+        {
+            *task->done = true;
+        }
+        pthread_cond_broadcast(&_doneCondition);
+        delete task;
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+void* CCImageEncoder::workerThread(void *data)
+{
+    CCImageEncoder *encoder = (CCImageEncoder*)data;
+
+    pthread_mutex_lock(&encoder->_mutex);
+    while (true)
+    {
+        if (encoder->_tasks.empty())
+        {
+            if (encoder->_quit)
+            {
+                break;
+            }
+            pthread_cond_wait(&encoder->_taskCondition, &encoder->_mutex);
+            continue;
+        }
+
+        Task *task = encoder->_tasks.front();
+        encoder->_tasks.pop_front();
+        pthread_mutex_unlock(&encoder->_mutex);
+
+        task->run();
+
+        pthread_mutex_lock(&encoder->_mutex);
+        if (task->done)
+        {
+            *task->done = true;
+        }
+        pthread_cond_broadcast(&encoder->_doneCondition);
+        delete task;
+    }
+    pthread_mutex_unlock(&encoder->_mutex);
+
+    return NULL;
+}
+
+bool CCImageEncoder::encode(const unsigned char *pixels, int width, int height, bool hasAlpha, const Options& options,
+                            std::vector<unsigned char> *output)
+{
+    CCAssert(pixels && output, "Invalid parameters");
+    CCAssert(options.format == CCImage::kFmtPng || options.format == CCImage::kFmtJpg, "Only PNG and JPEG are supported");
+
+    output->clear();
+    if (width <= 0 || height <= 0)
+    {
+        return false;
+    }
+
+    bool ok = options.format == CCImage::kFmtPng
+        ? encodePNG(pixels, width, height, hasAlpha, options, NULL, output)
+        : encodeJPG(pixels, width, height, hasAlpha, options, NULL, output);
+    if (! ok)
+    {
+        output->clear();
+    }
+    return ok;
+}
+
+bool CCImageEncoder::encodeToFile(const unsigned char *pixels, int width, int height, bool hasAlpha, const Options& options,
+                                  const char *fullPath)
+{
+    CCAssert(pixels && fullPath, "Invalid parameters");
+    CCAssert(options.format == CCImage::kFmtPng || options.format == CCImage::kFmtJpg, "Only PNG and JPEG are supported");
+
+    if (width <= 0 || height <= 0)
+    {
+        return false;
+    }
+
+    FILE *file = fopen(fullPath, "wb");
+    if (! file)
+    {
+        CCLOG("cocos2d: CCImageEncoder: can't open %s", fullPath);
+        return false;
+    }
+
+    bool ok = options.format == CCImage::kFmtPng
+        ? encodePNG(pixels, width, height, hasAlpha, options, file, NULL)
+        : encodeJPG(pixels, width, height, hasAlpha, options, file, NULL);
+
+    ok = fclose(file) == 0 && ok;
+    return ok;
+}
+
+bool CCImageEncoder::encode(CCImage *image, const Options& options, std::vector<unsigned char> *output)
+{
+    CCAssert(image, "Invalid image");
+    return encode(image->getData(), image->getWidth(), image->getHeight(), image->hasAlpha(), options, output);
+}
+
+bool CCImageEncoder::encodeToFile(CCImage *image, const Options& options, const char *fullPath)
+{
+    CCAssert(image, "Invalid image");
+    return encodeToFile(image->getData(), image->getWidth(), image->getHeight(), image->hasAlpha(), options, fullPath);
+}
+
+void CCImageEncoder::encodeAsync(CCImage *image, const Options& options, const char *fullPath, const ccImageEncoderCallback& callback)
+{
+    CCAssert(image, "Invalid image");
+
+    AsyncJob *job = new AsyncJob();
+    job->image = image;
+    job->options = options;
+    job->fullPath = fullPath ? fullPath : "";
+    job->callback = callback;
+    job->succeeded = false;
+    image->retain();
+
+    ++_pendingJobs;
+    if (! _scheduled)
+    {
+        CCDirector::sharedDirector()->getScheduler()->scheduleUpdateForTarget(this, 0, false);
+        _scheduled = true;
+    }
+
+    Task *task = new Task();
+    task->group = job;
+    task->done = NULL;
+    task->run = [this, job]() {
+        if (job->fullPath.empty())
+        {
+            job->succeeded = encode(job->image, job->options, &job->output);
+        }
+        else
+        {
+            job->succeeded = encodeToFile(job->image, job->options, job->fullPath.c_str());
+        }
+
+        pthread_mutex_lock(&_mutex);
+        _doneJobs.push_back(job);
+        pthread_mutex_unlock(&_mutex);
+    };
+    addTask(task);
+}
+
+void CCImageEncoder::update(float dt)
+{
+    std::vector<AsyncJob*> doneJobs;
+    pthread_mutex_lock(&_mutex);
+    doneJobs.swap(_doneJobs);
+    pthread_mutex_unlock(&_mutex);
+
+    for (std::vector<AsyncJob*>::iterator it = doneJobs.begin(); it != doneJobs.end(); ++it)
+    {
+        AsyncJob *job = *it;
+        if (job->callback)
+        {
+            job->callback(job->succeeded, job->output);
+        }
+        job->image->release();
+        delete job;
+        --_pendingJobs;
+    }
+
+    if (_pendingJobs == 0 && _scheduled)
+    {
+        CCDirector::sharedDirector()->getScheduler()->unscheduleUpdateForTarget(this);
+        _scheduled = false;
+    }
+}
+
+NS_CC_END
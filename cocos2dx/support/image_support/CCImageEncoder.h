@@ -0,0 +1,166 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CCIMAGE_ENCODER_H__
+#define __CCIMAGE_ENCODER_H__
+
+#include "cocoa/CCObject.h"
+#include "platform/CCImage.h"
+#include <functional>
+#include <string>
+#include <vector>
+#include <deque>
+#include <stdio.h>
+#include <pthread.h>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/** Completion callback of CCImageEncoder::encodeAsync: whether the encoding succeeded and the
+ encoded bytes, which are empty when the image was written to a file.
+ @since v3.0
+ */
+typedef std::function<void(bool, const std::vector<unsigned char>&)> ccImageEncoderCallback;
+
+/** @brief Singleton that encodes RGB888 and RGBA8888 pixels to PNG or JPEG, in memory or to a file.
+
+ PNG images are split into strips of rows that are filtered and deflated in parallel by a pool of
+ worker threads, then concatenated into one zlib stream; the strips are written to the file as soon
+ as they are ready. JPEG images are encoded row by row on the calling thread.
+
+ The synchronous methods are thread safe and don't need a running director, so they can be used
+ by tools. The asynchronous ones run the whole encoding on the worker threads and call back on the
+ main thread.
+
+ JPEG is not available on iOS and Mac, which don't ship libjpeg.
+ @since v3.0
+ */
+class CC_DLL CCImageEncoder : public CCObject
+{
+public:
+    /** Filter applied to the rows of a PNG image before compressing them. */
+    typedef enum
+    {
+        kFilterNone = 0,
+        kFilterSub,
+        kFilterUp,
+        kFilterAverage,
+        kFilterPaeth,
+        /** Chooses the best filter of every row, like libpng. */
+        kFilterAdaptive,
+    } EFilter;
+
+    class CC_DLL Options
+    {
+    public:
+        /** PNG, adaptive filter and default zlib level, RGB only: what CCImage::saveToFile writes. */
+        Options();
+
+        /** Fastest PNG encoding, for debug dumps: no filter and zlib level 1. */
+        static Options fast();
+
+        /** kFmtPng or kFmtJpg. */
+        CCImage::EImageFormat format;
+        /** zlib level of PNG images, from 0 (stored) to 9. */
+        int compressionLevel;
+        EFilter filter;
+        /** Quality of JPEG images, from 1 to 100. */
+        int quality;
+        /** Whether RGBA pixels keep their alpha channel, PNG only. */
+        bool keepAlpha;
+        /** Rows of the strips of PNG images that are compressed in parallel, 0 disables the split. */
+        unsigned int stripRows;
+    };
+
+    virtual ~CCImageEncoder();
+
+    /** Returns the shared encoder. */
+    static CCImageEncoder* sharedEncoder();
+
+    /** Waits for the pending asynchronous encodings and releases the shared encoder. */
+    static void purgeSharedEncoder();
+
+    /** Number of worker threads, by default the number of cores minus one, at least one.
+     Changing it waits for the running encodings.
+     */
+    unsigned int getThreadCount() const;
+    void setThreadCount(unsigned int count);
+
+    /** Encodes width * height pixels, top row first, of 3 or 4 bytes depending on hasAlpha. */
+    bool encode(const unsigned char *pixels, int width, int height, bool hasAlpha, const Options& options,
+                std::vector<unsigned char> *output);
+    bool encodeToFile(const unsigned char *pixels, int width, int height, bool hasAlpha, const Options& options,
+                      const char *fullPath);
+
+    bool encode(CCImage *image, const Options& options, std::vector<unsigned char> *output);
+    bool encodeToFile(CCImage *image, const Options& options, const char *fullPath);
+
+    /** Encodes an image on the worker threads, to memory if fullPath is NULL or empty.
+     The image is retained until the callback, which may be empty, is called on the main thread.
+     */
+    void encodeAsync(CCImage *image, const Options& options, const char *fullPath, const ccImageEncoderCallback& callback);
+
+    /** Dispatches the finished asynchronous encodings. */
+    virtual void update(float dt);
+
+private:
+    struct Task;
+    struct AsyncJob;
+
+    CCImageEncoder();
+
+    bool encodePNG(const unsigned char *pixels, int width, int height, bool hasAlpha, const Options& options,
+                   FILE *file, std::vector<unsigned char> *output);
+    bool encodeJPG(const unsigned char *pixels, int width, int height, bool hasAlpha, const Options& options,
+                   FILE *file, std::vector<unsigned char> *output);
+
+    void startThreads();
+    void stopThreads();
+    void addTask(Task *task);
+    /** Runs the queued tasks of the group on the calling thread until finished() returns true. */
+    void waitFor(const void *group, const std::function<bool()>& finished);
+    static void* workerThread(void *data);
+
+    unsigned int _threadCount;
+    std::vector<pthread_t> _threads;
+    std::deque<Task*> _tasks;
+    std::vector<AsyncJob*> _doneJobs;
+    unsigned int _pendingJobs;
+    bool _scheduled;
+    bool _quit;
+    pthread_mutex_t _mutex;
+    pthread_cond_t _taskCondition;
+    pthread_cond_t _doneCondition;
+};
+
+// end of platform group
+/// @}
+
+NS_CC_END
+
+#endif // __CCIMAGE_ENCODER_H__
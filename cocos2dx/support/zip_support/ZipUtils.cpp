@@ -26,10 +26,19 @@
 #include <stdlib.h>
 
 #include "ZipUtils.h"
+#include "ccLZ4.h"
 #include "ccMacros.h"
 #include "platform/CCFileUtils.h"
-#include "unzip.h"
+#include "platform/CCFileView.h"
 #include <map>
+#include <vector>
+#include <string.h>
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 NS_CC_BEGIN
 
@@ -305,19 +314,36 @@ int ZipUtils::ccInflateCCZFile(const char *path, unsigned char **out)
     CCAssert(out, "");
     CCAssert(&*out, "");
     
-    // load file into memory
-    unsigned char* compressed = NULL;
+    // encrypted files are decrypted in place, in the view, which never modifies the file
+    CCFileView* pView = CCFileUtils::sharedFileUtils()->openFileView(path);
     
-    unsigned long fileLen = 0;
-    compressed = CCFileUtils::sharedFileUtils()->getFileData(path, "rb", &fileLen);
+    if(NULL == pView)
+    {
+        CCLOG("cocos2d: Error loading CCZ compressed file");
+        return -1;
+    }
+    
+    int len = ccInflateCCZBuffer(pView->getBytes(), pView->getSize(), out);
+    pView->release();
     
-    if(NULL == compressed || 0 == fileLen)
+    return len;
+}
+
+int ZipUtils::ccInflateCCZBuffer(unsigned char *buffer, unsigned long bufferLen, unsigned char **out)
+{
+    CCAssert(out, "");
+    CCAssert(&*out, "");
+    
+    *out = NULL;
+    
+    if(NULL == buffer || bufferLen < sizeof(struct CCZHeader))
     {
         CCLOG("cocos2d: Error loading CCZ compressed file");
         return -1;
     }
     
-    struct CCZHeader *header = (struct CCZHeader*) compressed;
+    struct CCZHeader *header = (struct CCZHeader*) buffer;
+    unsigned int compression = CC_SWAP_INT16_BIG_TO_HOST(header->compression_type);
     
     // verify header
     if( header->sig[0] == 'C' && header->sig[1] == 'C' && header->sig[2] == 'Z' && header->sig[3] == '!' )
@@ -327,43 +353,38 @@ int ZipUtils::ccInflateCCZFile(const char *path, unsigned char **out)
         if( version > 2 )
         {
             CCLOG("cocos2d: Unsupported CCZ header format");
-            delete [] compressed;
             return -1;
         }
         
         // verify compression format
-        if( CC_SWAP_INT16_BIG_TO_HOST(header->compression_type) != CCZ_COMPRESSION_ZLIB )
+        if( compression != CCZ_COMPRESSION_ZLIB && compression != CCZ_COMPRESSION_LZ4 )
         {
             CCLOG("cocos2d: CCZ Unsupported compression method");
-            delete [] compressed;
             return -1;
         }
     }
     else if( header->sig[0] == 'C' && header->sig[1] == 'C' && header->sig[2] == 'Z' && header->sig[3] == 'p' )
     {
         // encrypted ccz file
-        header = (struct CCZHeader*) compressed;
         
         // verify header version
         unsigned int version = CC_SWAP_INT16_BIG_TO_HOST( header->version );
         if( version > 0 )
         {
             CCLOG("cocos2d: Unsupported CCZ header format");
-            delete [] compressed;
             return -1;
         }
         
         // verify compression format
-        if( CC_SWAP_INT16_BIG_TO_HOST(header->compression_type) != CCZ_COMPRESSION_ZLIB )
+        if( compression != CCZ_COMPRESSION_ZLIB && compression != CCZ_COMPRESSION_LZ4 )
         {
             CCLOG("cocos2d: CCZ Unsupported compression method");
-            delete [] compressed;
             return -1;
         }
         
         // decrypt
-        unsigned int* ints = (unsigned int*)(compressed+12);
-        int enclen = (fileLen-12)/4;
+        unsigned int* ints = (unsigned int*)(buffer+12);
+        int enclen = (bufferLen-12)/4;
         
         ccDecodeEncodedPvr(ints, enclen);
                 
@@ -375,7 +396,6 @@ int ZipUtils::ccInflateCCZFile(const char *path, unsigned char **out)
         if(calculated != required)
         {
             CCLOG("cocos2d: Can't decrypt image file. Is the decryption key valid?");
-            delete [] compressed;
             return -1;
         }
 #endif
@@ -383,7 +403,6 @@ int ZipUtils::ccInflateCCZFile(const char *path, unsigned char **out)
     else
     {
         CCLOG("cocos2d: Invalid CCZ file");
-        delete [] compressed;
         return -1;
     }
     
@@ -393,17 +412,23 @@ int ZipUtils::ccInflateCCZFile(const char *path, unsigned char **out)
     if(! *out )
     {
         CCLOG("cocos2d: CCZ: Failed to allocate memory for texture");
-        delete [] compressed;
         return -1;
     }
     
-    unsigned long destlen = len;
-    unsigned long source = (unsigned long) compressed + sizeof(*header);
-    int ret = uncompress(*out, &destlen, (Bytef*)source, fileLen - sizeof(*header) );
-    
-    delete [] compressed;
+    unsigned char *source = buffer + sizeof(*header);
+    unsigned long sourceLen = bufferLen - sizeof(*header);
+    bool decoded = false;
+    if (compression == CCZ_COMPRESSION_LZ4)
+    {
+        decoded = ccLZ4Decompress(source, sourceLen, *out, len) == (int)len;
+    }
+    else
+    {
+        unsigned long destlen = len;
+        decoded = uncompress(*out, &destlen, (Bytef*)source, sourceLen) == Z_OK;
+    }
     
-    if( ret != Z_OK )
+    if( ! decoded )
     {
         CCLOG("cocos2d: CCZ: Failed to uncompress data");
         free( *out );
@@ -434,41 +459,526 @@ void ZipUtils::ccSetPvrEncryptionKey(unsigned int keyPart1, unsigned int keyPart
     ccSetPvrEncryptionKeyPart(3, keyPart4);
 }
 
-// --------------------- ZipFile ---------------------
-// from unzip.cpp
-#define UNZ_MAXFILENAMEINZIP 256
+// --------------------- ZipArchive ---------------------
 
-struct ZipEntryInfo
+#define ZIP_LOCAL_HEADER_SIGNATURE          0x04034b50
+#define ZIP_CENTRAL_HEADER_SIGNATURE        0x02014b50
+#define ZIP_END_OF_DIRECTORY_SIGNATURE      0x06054b50
+#define ZIP64_END_OF_DIRECTORY_SIGNATURE    0x06064b50
+#define ZIP64_LOCATOR_SIGNATURE             0x07064b50
+#define ZIP64_EXTRA_FIELD_ID                0x0001
+
+#define ZIP_LOCAL_HEADER_SIZE               30
+#define ZIP_CENTRAL_HEADER_SIZE             46
+#define ZIP_END_OF_DIRECTORY_SIZE           22
+#define ZIP64_END_OF_DIRECTORY_SIZE         56
+#define ZIP64_LOCATOR_SIZE                  20
+#define ZIP_MAX_COMMENT_SIZE                0xffff
+
+#define ZIP_METHOD_STORED                   0
+#define ZIP_METHOD_DEFLATED                 8
+#define ZIP_FLAG_ENCRYPTED                  0x1
+
+// zip files are little endian
+static inline unsigned int readUInt16(const unsigned char *p)
 {
-    unz_file_pos pos;
-    uLong uncompressed_size;
-};
+    return p[0] | (p[1] << 8);
+}
+
+static inline unsigned int readUInt32(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static inline unsigned long long readUInt64(const unsigned char *p)
+{
+    return readUInt32(p) | ((unsigned long long)readUInt32(p + 4) << 32);
+}
+
+// Every thread inflates with its own stream, reset between entries, so the window isn't allocated
+// again for every entry.
+static pthread_key_t s_inflateStreamKey;
+static pthread_once_t s_inflateStreamKeyOnce = PTHREAD_ONCE_INIT;
+
+static void deleteInflateStream(void *data)
+{
+    z_stream *stream = (z_stream*)data;
+    inflateEnd(stream);
+    delete stream;
+}
+
+static void createInflateStreamKey()
+{
+    pthread_key_create(&s_inflateStreamKey, deleteInflateStream);
+}
+
+static z_stream *getInflateStream()
+{
+    pthread_once(&s_inflateStreamKeyOnce, createInflateStreamKey);
+    z_stream *stream = (z_stream*)pthread_getspecific(s_inflateStreamKey);
+    if (stream)
+    {
+        inflateReset(stream);
+        return stream;
+    }
+
+    stream = new z_stream;
+    memset(stream, 0, sizeof(z_stream));
+    // raw deflate data, without zlib header
+    if (inflateInit2(stream, -MAX_WBITS) != Z_OK)
+    {
+        delete stream;
+        return NULL;
+    }
+    pthread_setspecific(s_inflateStreamKey, stream);
+    return stream;
+}
+
+ZipArchive::ZipArchive()
+: _fileSize(0)
+, _fd(-1)
+, _view(NULL)
+, _file(NULL)
+{
+    pthread_mutex_init(&_fileMutex, NULL);
+}
+
+ZipArchive::~ZipArchive()
+{
+    CC_SAFE_RELEASE(_view);
+    if (_file)
+    {
+        fclose(_file);
+    }
+#if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX
+    if (_fd >= 0)
+    {
+        close(_fd);
+    }
+#endif
+    pthread_mutex_destroy(&_fileMutex);
+}
+
+// fseek and ftell take a long, which is 32 bits on windows and 32 bits systems
+static int seekFile(FILE *file, unsigned long long offset, int origin)
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    return _fseeki64(file, (__int64)offset, origin);
+#else
+    return fseeko(file, (off_t)offset, origin);
+#endif
+}
+
+static unsigned long long tellFile(FILE *file)
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    return (unsigned long long)_ftelli64(file);
+#else
+    return (unsigned long long)ftello(file);
+#endif
+}
+
+ZipArchive* ZipArchive::create(const char *fullPath)
+{
+    ZipArchive *pRet = new ZipArchive();
+    if (pRet->initWithFile(fullPath))
+    {
+        pRet->autorelease();
+        return pRet;
+    }
+    CC_SAFE_DELETE(pRet);
+    return NULL;
+}
+
+bool ZipArchive::initWithFile(const char *fullPath)
+{
+    CCAssert(fullPath != NULL, "Invalid parameters.");
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX
+    _fd = open(fullPath, O_RDONLY);
+    struct stat info;
+    if (_fd >= 0 && fstat(_fd, &info) == 0 && info.st_size > 0)
+    {
+        CCFileView *pView = new CCFileView();
+        if (pView->initWithMappedRange(_fd, 0, info.st_size))
+        {
+            _view = pView;
+            _fileSize = info.st_size;
+        }
+        else
+        {
+            pView->release();
+        }
+    }
+#endif
+
+    if (! _view)
+    {
+        _file = fopen(fullPath, "rb");
+        if (! _file)
+        {
+            return false;
+        }
+        seekFile(_file, 0, SEEK_END);
+        _fileSize = tellFile(_file);
+    }
+
+    if (! readCentralDirectory())
+    {
+        CCLOG("cocos2d: ZipArchive: %s is not a valid zip file", fullPath);
+        return false;
+    }
+    return true;
+}
+
+bool ZipArchive::readRaw(unsigned long long offset, void *buffer, unsigned long size)
+{
+    if (offset > _fileSize || size > _fileSize - offset)
+    {
+        return false;
+    }
+
+    if (_view)
+    {
+        memcpy(buffer, _view->getBytes() + offset, size);
+        return true;
+    }
+
+    pthread_mutex_lock(&_fileMutex);
+    bool ret = seekFile(_file, offset, SEEK_SET) == 0 && fread(buffer, 1, size, _file) == size;
+    pthread_mutex_unlock(&_fileMutex);
+    return ret;
+}
+
+bool ZipArchive::readCentralDirectory()
+{
+    // the end of central directory record is followed by a comment of at most 64k
+    unsigned long tailSize = (unsigned long)MIN(_fileSize, (unsigned long long)(ZIP_END_OF_DIRECTORY_SIZE + ZIP_MAX_COMMENT_SIZE));
+    if (tailSize < ZIP_END_OF_DIRECTORY_SIZE)
+    {
+        return false;
+    }
+    unsigned long long tailOffset = _fileSize - tailSize;
+    std::vector<unsigned char> tail(tailSize);
+    if (! readRaw(tailOffset, &tail[0], tailSize))
+    {
+        return false;
+    }
+
+    long end = -1;
+    for (long i = tailSize - ZIP_END_OF_DIRECTORY_SIZE; i >= 0; --i)
+    {
+        if (readUInt32(&tail[i]) == ZIP_END_OF_DIRECTORY_SIGNATURE)
+        {
+            end = i;
+            break;
+        }
+    }
+    if (end < 0)
+    {
+        return false;
+    }
+
+    unsigned long long entryCount = readUInt16(&tail[end + 10]);
+    unsigned long long directorySize = readUInt32(&tail[end + 12]);
+    unsigned long long directoryOffset = readUInt32(&tail[end + 16]);
+
+    // zip64 archives have a second end of central directory record, found by a locator
+    if (end >= ZIP64_LOCATOR_SIZE && readUInt32(&tail[end - ZIP64_LOCATOR_SIZE]) == ZIP64_LOCATOR_SIGNATURE)
+    {
+        unsigned char record[ZIP64_END_OF_DIRECTORY_SIZE];
+        unsigned long long recordOffset = readUInt64(&tail[end - ZIP64_LOCATOR_SIZE + 8]);
+        if (! readRaw(recordOffset, record, sizeof(record)) || readUInt32(record) != ZIP64_END_OF_DIRECTORY_SIGNATURE)
+        {
+            return false;
+        }
+        entryCount = readUInt64(record + 32);
+        directorySize = readUInt64(record + 40);
+        directoryOffset = readUInt64(record + 48);
+    }
+
+    if (directorySize == 0)
+    {
+        return entryCount == 0;
+    }
+    if (directoryOffset > _fileSize || directorySize > _fileSize - directoryOffset)
+    {
+        return false;
+    }
+    std::vector<unsigned char> directory;
+    const unsigned char *p = NULL;
+    if (_view)
+    {
+        p = _view->getBytes() + directoryOffset;
+    }
+    else
+    {
+        directory.resize((size_t)directorySize);
+        if (! readRaw(directoryOffset, &directory[0], (unsigned long)directorySize))
+        {
+            return false;
+        }
+        p = &directory[0];
+    }
+    const unsigned char *pEnd = p + directorySize;
+
+    _entries.clear();
+    // the entry count comes from the archive: never reserve more entries than the directory can hold
+    _entries.rehash((size_t)MIN(entryCount, directorySize / ZIP_CENTRAL_HEADER_SIZE));
+    for (unsigned long long i = 0; i < entryCount; ++i)
+    {
+        if (pEnd - p < ZIP_CENTRAL_HEADER_SIZE || readUInt32(p) != ZIP_CENTRAL_HEADER_SIGNATURE)
+        {
+            return false;
+        }
+
+        unsigned int flags = readUInt16(p + 8);
+        unsigned int nameLength = readUInt16(p + 28);
+        unsigned int extraLength = readUInt16(p + 30);
+        unsigned int commentLength = readUInt16(p + 32);
+        const unsigned char *name = p + ZIP_CENTRAL_HEADER_SIZE;
+        const unsigned char *next = name + nameLength + extraLength + commentLength;
+        if (next > pEnd)
+        {
+            return false;
+        }
+
+        Entry entry;
+        entry.method = readUInt16(p + 10);
+        entry.crc = readUInt32(p + 16);
+        unsigned long long compressedSize = readUInt32(p + 20);
+        unsigned long long uncompressedSize = readUInt32(p + 24);
+        entry.localHeaderOffset = readUInt32(p + 42);
+
+        // the fields which don't fit in 32 bits are in the zip64 extra field, in this order
+        const unsigned char *extra = name + nameLength;
+        const unsigned char *extraEnd = extra + extraLength;
+        while (extraEnd - extra >= 4)
+        {
+            unsigned int fieldId = readUInt16(extra);
+            unsigned int fieldSize = readUInt16(extra + 2);
+            const unsigned char *field = extra + 4;
+            const unsigned char *fieldEnd = field + fieldSize;
+            if (fieldEnd > extraEnd)
+            {
+                break;
+            }
+            if (fieldId == ZIP64_EXTRA_FIELD_ID)
+            {
+                if (uncompressedSize == 0xffffffff && fieldEnd - field >= 8)
+                {
+                    uncompressedSize = readUInt64(field);
+                    field += 8;
+                }
+                if (compressedSize == 0xffffffff && fieldEnd - field >= 8)
+                {
+                    compressedSize = readUInt64(field);
+                    field += 8;
+                }
+                if (entry.localHeaderOffset == 0xffffffff && fieldEnd - field >= 8)
+                {
+                    entry.localHeaderOffset = readUInt64(field);
+                }
+                break;
+            }
+            extra = fieldEnd;
+        }
+
+        // entries are read in one piece, skip those which can't be addressed in memory
+        if ((flags & ZIP_FLAG_ENCRYPTED) == 0
+            && compressedSize == (unsigned long)compressedSize
+            && uncompressedSize == (unsigned long)uncompressedSize)
+        {
+            entry.compressedSize = (unsigned long)compressedSize;
+            entry.uncompressedSize = (unsigned long)uncompressedSize;
+            _entries[std::string((const char*)name, nameLength)] = entry;
+        }
+        p = next;
+    }
+
+    return true;
+}
+
+unsigned int ZipArchive::getEntryCount() const
+{
+    return (unsigned int)_entries.size();
+}
+
+const ZipArchive::Entry *ZipArchive::findEntry(const std::string &fileName) const
+{
+    std::unordered_map<std::string, Entry>::const_iterator it = _entries.find(fileName);
+    return it != _entries.end() ? &it->second : NULL;
+}
+
+bool ZipArchive::fileExists(const std::string &fileName) const
+{
+    return findEntry(fileName) != NULL;
+}
+
+unsigned long ZipArchive::getFileSize(const std::string &fileName) const
+{
+    const Entry *entry = findEntry(fileName);
+    return entry ? entry->uncompressedSize : 0;
+}
+
+bool ZipArchive::getDataOffset(const Entry &entry, unsigned long long *offset)
+{
+    // the local header may have a different extra field than the central directory
+    unsigned char header[ZIP_LOCAL_HEADER_SIZE];
+    if (! readRaw(entry.localHeaderOffset, header, sizeof(header)) || readUInt32(header) != ZIP_LOCAL_HEADER_SIGNATURE)
+    {
+        return false;
+    }
+    *offset = entry.localHeaderOffset + ZIP_LOCAL_HEADER_SIZE + readUInt16(header + 26) + readUInt16(header + 28);
+    return *offset <= _fileSize && entry.compressedSize <= _fileSize - *offset;
+}
+
+bool ZipArchive::readEntry(const Entry &entry, unsigned char *out)
+{
+    unsigned long long offset = 0;
+    if (! getDataOffset(entry, &offset))
+    {
+        return false;
+    }
+
+    bool ret = false;
+    if (entry.method == ZIP_METHOD_STORED)
+    {
+        ret = entry.compressedSize == entry.uncompressedSize && readRaw(offset, out, entry.uncompressedSize);
+    }
+    else if (entry.method == ZIP_METHOD_DEFLATED)
+    {
+        z_stream *stream = getInflateStream();
+        if (! stream)
+        {
+            return false;
+        }
+
+        // inflate directly from the mapping, the file is only locked while reading the compressed data
+        std::vector<unsigned char> compressed;
+        if (_view)
+        {
+            stream->next_in = (Bytef*)(_view->getBytes() + offset);
+        }
+        else
+        {
+            // one more byte, so the buffer is never empty
+            compressed.resize(entry.compressedSize + 1);
+            if (! readRaw(offset, &compressed[0], entry.compressedSize))
+            {
+                return false;
+            }
+            stream->next_in = &compressed[0];
+        }
+
+        stream->avail_in = entry.compressedSize;
+        stream->next_out = out;
+        stream->avail_out = entry.uncompressedSize;
+        ret = inflate(stream, Z_FINISH) == Z_STREAM_END && stream->total_out == entry.uncompressedSize;
+    }
+    else
+    {
+        CCLOG("cocos2d: ZipArchive: unsupported compression method %d", entry.method);
+        return false;
+    }
+
+#if COCOS2D_DEBUG > 0
+    if (ret && crc32(crc32(0L, Z_NULL, 0), out, entry.uncompressedSize) != entry.crc)
+    {
+        CCLOG("cocos2d: ZipArchive: corrupted entry, wrong crc");
+        ret = false;
+    }
+#endif
+    return ret;
+}
+
+unsigned char *ZipArchive::getFileData(const std::string &fileName, unsigned long *pSize)
+{
+    if (pSize)
+    {
+        *pSize = 0;
+    }
+
+    const Entry *entry = findEntry(fileName);
+    if (! entry)
+    {
+        return NULL;
+    }
+
+    unsigned char *pBuffer = new unsigned char[entry->uncompressedSize];
+    if (! readEntry(*entry, pBuffer))
+    {
+        delete [] pBuffer;
+        return NULL;
+    }
+
+    if (pSize)
+    {
+        *pSize = entry->uncompressedSize;
+    }
+    return pBuffer;
+}
+
+CCFileView *ZipArchive::openFileView(const std::string &fileName)
+{
+    const Entry *entry = findEntry(fileName);
+    if (! entry)
+    {
+        return NULL;
+    }
+
+    CCFileView *pView = new CCFileView();
+    unsigned long long offset = 0;
+    if (_view && entry->method == ZIP_METHOD_STORED && entry->uncompressedSize > 0
+        && getDataOffset(*entry, &offset)
+        && pView->initWithMappedRange(_fd, offset, entry->uncompressedSize))
+    {
+        return pView;
+    }
+
+    unsigned long size = 0;
+    unsigned char *pBuffer = getFileData(fileName, &size);
+    if (pBuffer && pView->initWithBuffer(pBuffer, size))
+    {
+        return pView;
+    }
+
+    CC_SAFE_DELETE_ARRAY(pBuffer);
+    pView->release();
+    return NULL;
+}
+
+// --------------------- ZipFile ---------------------
 
 class ZipFilePrivate
 {
 public:
-    unzFile zipFile;
-    
-    // std::unordered_map is faster if available on the platform
-    typedef std::map<std::string, struct ZipEntryInfo> FileListContainer;
-    FileListContainer fileList;
+    ZipArchive *archive;
+    // only the files starting with the filter are accessible
+    std::string filter;
+
+    bool isAccessible(const std::string &fileName) const
+    {
+        return archive && fileName.compare(0, filter.length(), filter) == 0;
+    }
 };
 
 ZipFile::ZipFile(const std::string &zipFile, const std::string &filter)
 : _data(new ZipFilePrivate)
 {
-    _data->zipFile = unzOpen(zipFile.c_str());
-    if (_data->zipFile)
+    _data->archive = new ZipArchive();
+    if (! _data->archive->initWithFile(zipFile.c_str()))
     {
-        setFilter(filter);
+        CC_SAFE_RELEASE_NULL(_data->archive);
     }
+    _data->filter = filter;
 }
 
 ZipFile::~ZipFile()
 {
-    if (_data && _data->zipFile)
+    if (_data)
     {
-        unzClose(_data->zipFile);
+        CC_SAFE_RELEASE(_data->archive);
     }
     CC_SAFE_DELETE(_data);
 }
@@ -479,39 +989,9 @@ bool ZipFile::setFilter(const std::string &filter)
     do
     {
         CC_BREAK_IF(!_data);
-        CC_BREAK_IF(!_data->zipFile);
-        
-        // clear existing file list
-        _data->fileList.clear();
+        CC_BREAK_IF(!_data->archive);
         
-        // UNZ_MAXFILENAMEINZIP + 1 - it is done so in unzLocateFile
-        char szCurrentFileName[UNZ_MAXFILENAMEINZIP + 1];
-        unz_file_info64 fileInfo;
-        
-        // go through all files and store position information about the required files
-        int err = unzGoToFirstFile64(_data->zipFile, &fileInfo,
-                                     szCurrentFileName, sizeof(szCurrentFileName) - 1);
-        while (err == UNZ_OK)
-        {
-            unz_file_pos posInfo;
-            int posErr = unzGetFilePos(_data->zipFile, &posInfo);
-            if (posErr == UNZ_OK)
-            {
-                std::string currentFileName = szCurrentFileName;
-                // cache info about filtered files only (like 'assets/')
-                if (filter.empty()
-                    || currentFileName.substr(0, filter.length()) == filter)
-                {
-                    ZipEntryInfo entry;
-                    entry.pos = posInfo;
-                    entry.uncompressed_size = (uLong)fileInfo.uncompressed_size;
-                    _data->fileList[currentFileName] = entry;
-                }
-            }
-            // next file - also get the information about it
-            err = unzGoToNextFile64(_data->zipFile, &fileInfo,
-                                    szCurrentFileName, sizeof(szCurrentFileName) - 1);
-        }
+        _data->filter = filter;
         ret = true;
         
     } while(false);
@@ -526,7 +1006,7 @@ bool ZipFile::fileExists(const std::string &fileName) const
     {
         CC_BREAK_IF(!_data);
         
-        ret = _data->fileList.find(fileName) != _data->fileList.end();
+        ret = _data->isAccessible(fileName) && _data->archive->fileExists(fileName);
     } while(false);
     
     return ret;
@@ -542,32 +1022,28 @@ unsigned char *ZipFile::getFileData(const std::string &fileName, unsigned long *
     
     do
     {
-        CC_BREAK_IF(!_data->zipFile);
         CC_BREAK_IF(fileName.empty());
+        CC_BREAK_IF(!_data->isAccessible(fileName));
         
-        ZipFilePrivate::FileListContainer::const_iterator it = _data->fileList.find(fileName);
-        CC_BREAK_IF(it ==  _data->fileList.end());
-        
-        ZipEntryInfo fileInfo = it->second;
-        
-        int nRet = unzGoToFilePos(_data->zipFile, &fileInfo.pos);
-        CC_BREAK_IF(UNZ_OK != nRet);
-        
-        nRet = unzOpenCurrentFile(_data->zipFile);
-        CC_BREAK_IF(UNZ_OK != nRet);
-        
-        pBuffer = new unsigned char[fileInfo.uncompressed_size];
-        int CC_UNUSED nSize = unzReadCurrentFile(_data->zipFile, pBuffer, fileInfo.uncompressed_size);
-        CCAssert(nSize == 0 || nSize == (int)fileInfo.uncompressed_size, "the file size is wrong");
-        
-        if (pSize)
-        {
-            *pSize = fileInfo.uncompressed_size;
-        }
-        unzCloseCurrentFile(_data->zipFile);
+        pBuffer = _data->archive->getFileData(fileName, pSize);
     } while (0);
     
     return pBuffer;
 }
 
+CCFileView *ZipFile::openFileView(const std::string &fileName)
+{
+    CCFileView *pView = NULL;
+    
+    do
+    {
+        CC_BREAK_IF(fileName.empty());
+        CC_BREAK_IF(!_data->isAccessible(fileName));
+        
+        pView = _data->archive->openFileView(fileName);
+    } while (0);
+    
+    return pView;
+}
+
 NS_CC_END
@@ -25,7 +25,11 @@ THE SOFTWARE.
 #define __SUPPORT_ZIPUTILS_H__
 
 #include <string>
+#include <unordered_map>
+#include <stdio.h>
+#include <pthread.h>
 #include "CCPlatformDefine.h"
+#include "cocoa/CCObject.h"
 
 namespace cocos2d
 {
@@ -45,6 +49,7 @@ namespace cocos2d
         CCZ_COMPRESSION_BZIP2,              // bzip2 format (not supported yet)
         CCZ_COMPRESSION_GZIP,               // gzip format (not supported yet)
         CCZ_COMPRESSION_NONE,               // plain (not supported yet)
+        CCZ_COMPRESSION_LZ4,                // LZ4 block format, much faster to decode than zlib. @since v3.0
     };
 
     class CC_DLL ZipUtils
@@ -89,6 +94,15 @@ namespace cocos2d
         */
         static int ccInflateCCZFile(const char *filename, unsigned char **out);
 
+        /** inflates a CCZ file loaded in memory, zlib or LZ4 compressed depending on its header.
+        * Encrypted buffers are decrypted in place. The inflated memory is expected to be freed by the caller.
+        *
+        * @returns the length of the deflated buffer
+        *
+        * @since v3.0
+        */
+        static int ccInflateCCZBuffer(unsigned char *buffer, unsigned long bufferLen, unsigned char **out);
+
         /** Sets the pvr.ccz encryption key parts separately for added
         * security.
         *
@@ -152,6 +166,78 @@ namespace cocos2d
         static bool s_bEncryptionKeyIsValid;
     };
 
+    class CCFileView;
+
+    /**
+    * Zip archive reader for many files and several threads.
+    *
+    * The central directory is read once, when the archive is opened, into a hash index, so looking up
+    * an entry doesn't scan the archive. The entries can be read from several threads at once: the
+    * archive is mapped in memory where the platform allows it, otherwise the raw entries are read
+    * under a lock, and each thread inflates with its own zlib stream.
+    *
+    * Only stored and deflated entries are supported, without encryption.
+    *
+    * @since v3.0
+    */
+    class CC_DLL ZipArchive : public CCObject
+    {
+    public:
+        ZipArchive();
+        virtual ~ZipArchive();
+
+        /** Opens an archive, returns NULL if it isn't a valid zip file. */
+        static ZipArchive* create(const char *fullPath);
+        bool initWithFile(const char *fullPath);
+
+        unsigned int getEntryCount() const;
+
+        /** Checks whether the archive has an entry, names are case sensitive. */
+        bool fileExists(const std::string &fileName) const;
+
+        /** Uncompressed size of an entry, 0 if it doesn't exist. */
+        unsigned long getFileSize(const std::string &fileName) const;
+
+        /**
+        * Reads an entry in a new buffer.
+        * @param[out] pSize If the read operation succeeds, it will be the data size, otherwise 0.
+        * @return Upon success, a pointer to the data is returned, otherwise NULL.
+        * @warning You are responsible for calling delete[] on any Non-NULL pointer returned.
+        */
+        unsigned char *getFileData(const std::string &fileName, unsigned long *pSize);
+
+        /**
+        * Reads an entry in a view. Stored entries of mapped archives are mapped directly, without copy.
+        * @warning The view is not autoreleased: call release() on any Non-NULL pointer returned.
+        */
+        CCFileView *openFileView(const std::string &fileName);
+
+    private:
+        struct Entry
+        {
+            unsigned long long localHeaderOffset;
+            unsigned long compressedSize;
+            unsigned long uncompressedSize;
+            unsigned int crc;
+            unsigned short method;
+        };
+
+        bool readCentralDirectory();
+        const Entry *findEntry(const std::string &fileName) const;
+        bool readRaw(unsigned long long offset, void *buffer, unsigned long size);
+        bool getDataOffset(const Entry &entry, unsigned long long *offset);
+        bool readEntry(const Entry &entry, unsigned char *out);
+
+        std::unordered_map<std::string, Entry> _entries;
+        unsigned long long _fileSize;
+        int _fd;
+        /** The whole archive, NULL when it can't be mapped. */
+        CCFileView *_view;
+        /** Used when the archive isn't mapped. */
+        FILE *_file;
+        pthread_mutex_t _fileMutex;
+    };
+
     // forward declaration
     class ZipFilePrivate;
 
@@ -160,6 +246,7 @@ namespace cocos2d
     *
     * It will cache the file list of a particular zip file with positions inside an archive,
     * so it would be much faster to read some particular files or to check their existance.
+    * It reads the archive with a ZipArchive, so files can be read from several threads.
     *
     * @since v2.0.5
     */
@@ -210,6 +297,14 @@ namespace cocos2d
         */
         unsigned char *getFileData(const std::string &fileName, unsigned long *pSize);
 
+        /**
+        * Get a view of a file of the zip file, see ZipArchive::openFileView.
+        * @warning The view is not autoreleased: call release() on any Non-NULL pointer returned.
+        *
+        * @since v3.0
+        */
+        CCFileView *openFileView(const std::string &fileName);
+
     private:
         /** Internal data like zip file pointer / file list array and so on */
         ZipFilePrivate *_data;
@@ -0,0 +1,294 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "ccLZ4.h"
+#include <string.h>
+#include <vector>
+
+namespace cocos2d
+{
+
+// format constants of LZ4 blocks
+#define LZ4_MIN_MATCH           4
+#define LZ4_LAST_LITERALS       5       // the last bytes are always literals
+#define LZ4_MATCH_FIND_LIMIT    12      // no match starts in the last bytes
+#define LZ4_MAX_OFFSET          65535
+#define LZ4_RUN_MASK            15
+
+#define LZ4_HASH_LOG            14
+// the search skips faster and faster in data which doesn't compress
+#define LZ4_SKIP_TRIGGER        6
+
+static inline unsigned int readUInt32(const unsigned char *p)
+{
+    unsigned int value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline unsigned int hashPosition(const unsigned char *p)
+{
+    return (readUInt32(p) * 2654435761U) >> (32 - LZ4_HASH_LOG);
+}
+
+static inline unsigned char *writeLength(unsigned char *op, unsigned int length)
+{
+    while (length >= 255)
+    {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (unsigned char)length;
+    return op;
+}
+
+static inline unsigned char *writeLiterals(unsigned char *op, unsigned char *token, const unsigned char *literals, unsigned int length)
+{
+    if (length >= LZ4_RUN_MASK)
+    {
+        *token = LZ4_RUN_MASK << 4;
+        op = writeLength(op, length - LZ4_RUN_MASK);
+    }
+    else
+    {
+        *token = (unsigned char)(length << 4);
+    }
+    if (length)
+    {
+        memcpy(op, literals, length);
+    }
+    return op + length;
+}
+
+unsigned int ccLZ4CompressBound(unsigned int length)
+{
+    return length + length / 255 + 16;
+}
+
+unsigned int ccLZ4Compress(const unsigned char *in, unsigned int length, unsigned char *out, unsigned int capacity)
+{
+    if (capacity < ccLZ4CompressBound(length))
+    {
+        return 0;
+    }
+
+    const unsigned char *ip = in;
+    const unsigned char *anchor = in;
+    const unsigned char *iend = in + length;
+    unsigned char *op = out;
+
+    if (length > LZ4_MATCH_FIND_LIMIT)
+    {
+        const unsigned char *matchLimit = iend - LZ4_LAST_LITERALS;
+        const unsigned char *findLimit = iend - LZ4_MATCH_FIND_LIMIT;
+        // positions of the last sequences of 4 bytes with each hash, stale entries are rejected by the comparison
+        std::vector<unsigned int> table(1 << LZ4_HASH_LOG, 0);
+
+        ++ip;
+        while (ip < findLimit)
+        {
+            // find a match
+            const unsigned char *match = NULL;
+            unsigned int attempts = 1 << LZ4_SKIP_TRIGGER;
+            while (ip < findLimit)
+            {
+                unsigned int h = hashPosition(ip);
+                match = in + table[h];
+                table[h] = (unsigned int)(ip - in);
+                if (match < ip && ip - match <= LZ4_MAX_OFFSET && readUInt32(match) == readUInt32(ip))
+                {
+                    break;
+                }
+                match = NULL;
+                ip += attempts++ >> LZ4_SKIP_TRIGGER;
+            }
+            if (! match)
+            {
+                break;
+            }
+
+            // extend it backwards, over the pending literals
+            while (ip > anchor && match > in && ip[-1] == match[-1])
+            {
+                --ip;
+                --match;
+            }
+
+            unsigned char *token = op++;
+            op = writeLiterals(op, token, anchor, (unsigned int)(ip - anchor));
+
+            unsigned int offset = (unsigned int)(ip - match);
+            *op++ = offset & 0xff;
+            *op++ = offset >> 8;
+
+            // and forwards
+            const unsigned char *matchEnd = ip + LZ4_MIN_MATCH;
+            match += LZ4_MIN_MATCH;
+            while (matchEnd < matchLimit && *matchEnd == *match)
+            {
+                ++matchEnd;
+                ++match;
+            }
+
+            unsigned int matchLength = (unsigned int)(matchEnd - ip) - LZ4_MIN_MATCH;
+            if (matchLength >= LZ4_RUN_MASK)
+            {
+                *token |= LZ4_RUN_MASK;
+                op = writeLength(op, matchLength - LZ4_RUN_MASK);
+            }
+            else
+            {
+                *token |= matchLength;
+            }
+
+            ip = anchor = matchEnd;
+            if (ip < findLimit)
+            {
+                table[hashPosition(ip - 2)] = (unsigned int)(ip - 2 - in);
+            }
+        }
+    }
+
+    unsigned char *token = op++;
+    op = writeLiterals(op, token, anchor, (unsigned int)(iend - anchor));
+    return (unsigned int)(op - out);
+}
+
+static inline bool readLength(const unsigned char **ip, const unsigned char *iend, unsigned int *length)
+{
+    unsigned int s;
+    do
+    {
+        if (*ip >= iend)
+        {
+            return false;
+        }
+        s = *(*ip)++;
+        *length += s;
+    } while (s == 255);
+    return true;
+}
+
+int ccLZ4Decompress(const unsigned char *in, unsigned int length, unsigned char *out, unsigned int outLength)
+{
+    const unsigned char *ip = in;
+    const unsigned char *iend = in + length;
+    unsigned char *op = out;
+    unsigned char *oend = out + outLength;
+
+    for (;;)
+    {
+        if (ip >= iend)
+        {
+            return -1;
+        }
+        unsigned int token = *ip++;
+
+        // literals
+        unsigned int literalLength = token >> 4;
+        if (literalLength == LZ4_RUN_MASK && ! readLength(&ip, iend, &literalLength))
+        {
+            return -1;
+        }
+        if ((unsigned int)(iend - ip) < literalLength || (unsigned int)(oend - op) < literalLength)
+        {
+            return -1;
+        }
+        if (literalLength <= 16 && iend - ip >= 16 && oend - op >= 16)
+        {
+            // most literal runs are short, copy them at once
+            memcpy(op, ip, 16);
+        }
+        else
+        {
+            memcpy(op, ip, literalLength);
+        }
+        op += literalLength;
+        ip += literalLength;
+
+        // the last sequence has no match
+        if (ip == iend)
+        {
+            break;
+        }
+
+        // match
+        if (iend - ip < 2)
+        {
+            return -1;
+        }
+        unsigned int offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (unsigned int)(op - out))
+        {
+            return -1;
+        }
+
+        unsigned int matchLength = token & LZ4_RUN_MASK;
+        if (matchLength == LZ4_RUN_MASK && ! readLength(&ip, iend, &matchLength))
+        {
+            return -1;
+        }
+        matchLength += LZ4_MIN_MATCH;
+        if ((unsigned int)(oend - op) < matchLength)
+        {
+            return -1;
+        }
+
+        const unsigned char *match = op - offset;
+        unsigned char *matchEnd = op + matchLength;
+        // 8 bytes at a time, which may write up to 7 bytes past the match, overwritten later
+        unsigned char *wildCopyLimit = oend - 8;
+        if (offset < 8 && op <= wildCopyLimit)
+        {
+            // the match overlaps its copy: repeat its pattern on 8 bytes, then copy it from a
+            // multiple of its period which is at least 8 bytes behind, like the transparent pixels
+            for (int i = 0; i < 8; ++i)
+            {
+                op[i] = match[i];
+            }
+            op += 8;
+            match = op - offset * ((8 + offset - 1) / offset);
+        }
+        if (offset >= 8 || match <= op - 8)
+        {
+            while (op < matchEnd && op <= wildCopyLimit)
+            {
+                memcpy(op, match, 8);
+                op += 8;
+                match += 8;
+            }
+        }
+        // at the end of the buffer
+        while (op < matchEnd)
+        {
+            *op++ = *match++;
+        }
+        op = matchEnd;
+    }
+
+    return (int)(op - out);
+}
+
+} // end of namespace cocos2d
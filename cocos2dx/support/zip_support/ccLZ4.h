@@ -0,0 +1,61 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __SUPPORT_CCLZ4_H__
+#define __SUPPORT_CCLZ4_H__
+
+#include "CCPlatformDefine.h"
+
+namespace cocos2d
+{
+    /**
+    * LZ4 block compression, used by the CCZ_COMPRESSION_LZ4 CCZ files.
+    *
+    * The data is compatible with the LZ4 block format (LZ4_compress_default / LZ4_decompress_safe),
+    * without the frame header: LZ4 decompresses several times faster than inflate, for a lower ratio.
+    * These functions don't depend on the rest of the engine, so tools can use them.
+    *
+    * @since v3.0
+    */
+
+    /** Largest possible size of the compression of length bytes. */
+    CC_DLL unsigned int ccLZ4CompressBound(unsigned int length);
+
+    /**
+    * Compresses a buffer.
+    * @param capacity size of out, at least ccLZ4CompressBound(length)
+    * @return the compressed length, 0 if out is too small
+    */
+    CC_DLL unsigned int ccLZ4Compress(const unsigned char *in, unsigned int length, unsigned char *out, unsigned int capacity);
+
+    /**
+    * Decompresses a buffer, checking every access so malformed data can't read or write out of the buffers.
+    * @param outLength the decompressed length, stored beside the compressed data
+    * @return the number of decompressed bytes, -1 if the data is malformed or longer than outLength
+    */
+    CC_DLL int ccLZ4Decompress(const unsigned char *in, unsigned int length, unsigned char *out, unsigned int outLength);
+
+} // end of namespace cocos2d
+
+#endif // __SUPPORT_CCLZ4_H__
@@ -768,7 +768,7 @@ void CCTMXMapInfo::textHandler(void *ctx, const char *ch, int len)
 {
     CC_UNUSED_PARAM(ctx);
     CCTMXMapInfo *pTMXMapInfo = this;
-    std::string pText((char*)ch,0,len);
+    std::string pText(ch, len);
 
     if (pTMXMapInfo->getStoringCharacters())
     {
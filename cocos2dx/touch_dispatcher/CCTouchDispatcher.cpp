@@ -31,10 +31,175 @@ THE SOFTWARE.
 #include "textures/CCTexture2D.h"
 #include "support/data_support/ccCArray.h"
 #include "ccMacros.h"
+#include "base_nodes/CCNode.h"
 #include <algorithm>
+#include <vector>
+#include <float.h>
+#include <math.h>
 
 NS_CC_BEGIN
 
+// the grid has at most kHitTestGridMaxSide * kHitTestGridMaxSide cells
+static const int kHitTestGridMaxSide = 64;
+
+/**
+ * Uniform grid over the world space bounds of the targeted handlers with a hit test node.
+ * The handlers are identified by their position in _targetedHandlers, so every list is in priority order.
+ */
+struct CCTouchDispatcher::HitTestIndex
+{
+    HitTestIndex()
+    : handlersDirty(true)
+    , gridDirty(true)
+    , columns(0)
+    , rows(0)
+    , cellWidth(0)
+    , cellHeight(0)
+    {
+    }
+
+    void build(CCObject **handlers);
+    void cellRange(const CCRect& rect, int *column0, int *row0, int *column1, int *row1) const;
+    const std::vector<CCTargetedTouchHandler*>& collect(const CCPoint& point, CCObject **handlers);
+
+    std::vector<unsigned int> bounded;
+    std::vector<unsigned int> unbounded;
+    bool handlersDirty;
+    bool gridDirty;
+
+    // union of the bounds
+    CCRect area;
+    int columns;
+    int rows;
+    float cellWidth;
+    float cellHeight;
+    // the handlers of cell i are cellEntries[cellStarts[i]] to cellEntries[cellStarts[i + 1] - 1]
+    std::vector<unsigned int> cellStarts;
+    std::vector<unsigned int> cellEntries;
+
+    std::vector<unsigned int> cursors;
+    std::vector<CCTargetedTouchHandler*> refreshed;
+    std::vector<CCTargetedTouchHandler*> candidates;
+};
+
+void CCTouchDispatcher::HitTestIndex::cellRange(const CCRect& rect, int *column0, int *row0, int *column1, int *row1) const
+{
+    *column0 = MAX(0, MIN(columns - 1, (int)((rect.getMinX() - area.origin.x) / cellWidth)));
+    *column1 = MAX(0, MIN(columns - 1, (int)((rect.getMaxX() - area.origin.x) / cellWidth)));
+    *row0 = MAX(0, MIN(rows - 1, (int)((rect.getMinY() - area.origin.y) / cellHeight)));
+    *row1 = MAX(0, MIN(rows - 1, (int)((rect.getMaxY() - area.origin.y) / cellHeight)));
+}
+
+void CCTouchDispatcher::HitTestIndex::build(CCObject **handlers)
+{
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (std::vector<unsigned int>::iterator it = bounded.begin(); it != bounded.end(); ++it)
+    {
+        const CCRect& bounds = ((CCTargetedTouchHandler*)handlers[*it])->_hitTestBounds;
+        minX = MIN(minX, bounds.getMinX());
+        minY = MIN(minY, bounds.getMinY());
+        maxX = MAX(maxX, bounds.getMaxX());
+        maxY = MAX(maxY, bounds.getMaxY());
+    }
+    area = CCRectMake(minX, minY, maxX - minX, maxY - minY);
+
+    // about one handler per cell when they don't overlap
+    int side = (int)ceilf(sqrtf((float)bounded.size()));
+    side = MAX(1, MIN(kHitTestGridMaxSide, side));
+    columns = area.size.width > 0 ? side : 1;
+    rows = area.size.height > 0 ? side : 1;
+    cellWidth = area.size.width > 0 ? area.size.width / columns : 1;
+    cellHeight = area.size.height > 0 ? area.size.height / rows : 1;
+
+    int column0, row0, column1, row1;
+    cellStarts.assign(columns * rows + 1, 0);
+    for (std::vector<unsigned int>::iterator it = bounded.begin(); it != bounded.end(); ++it)
+    {
+        cellRange(((CCTargetedTouchHandler*)handlers[*it])->_hitTestBounds, &column0, &row0, &column1, &row1);
+        for (int row = row0; row <= row1; ++row)
+        {
+            for (int column = column0; column <= column1; ++column)
+            {
+                ++cellStarts[row * columns + column + 1];
+            }
+        }
+    }
+    for (unsigned int i = 1; i < cellStarts.size(); ++i)
+    {
+        cellStarts[i] += cellStarts[i - 1];
+    }
+
+    cellEntries.resize(cellStarts.back());
+    cursors.assign(cellStarts.begin(), cellStarts.end() - 1);
+    for (std::vector<unsigned int>::iterator it = bounded.begin(); it != bounded.end(); ++it)
+    {
+        cellRange(((CCTargetedTouchHandler*)handlers[*it])->_hitTestBounds, &column0, &row0, &column1, &row1);
+        for (int row = row0; row <= row1; ++row)
+        {
+            for (int column = column0; column <= column1; ++column)
+            {
+                cellEntries[cursors[row * columns + column]++] = *it;
+            }
+        }
+    }
+
+    gridDirty = false;
+}
+
+const std::vector<CCTargetedTouchHandler*>& CCTouchDispatcher::HitTestIndex::collect(const CCPoint& point, CCObject **handlers)
+{
+    candidates.clear();
+
+    const unsigned int *cell = NULL;
+    const unsigned int *cellEnd = NULL;
+    if (area.containsPoint(point))
+    {
+        int column0, row0, column1, row1;
+        cellRange(CCRectMake(point.x, point.y, 0, 0), &column0, &row0, &column1, &row1);
+        unsigned int i = row0 * columns + column0;
+        if (cellStarts[i] < cellStarts[i + 1])
+        {
+            cell = &cellEntries[cellStarts[i]];
+            cellEnd = cell + (cellStarts[i + 1] - cellStarts[i]);
+        }
+    }
+
+    // merge the handlers without hit test node with the ones of the cell
+    std::vector<unsigned int>::const_iterator it = unbounded.begin();
+    while (it != unbounded.end() || cell != cellEnd)
+    {
+        if (cell == cellEnd || (it != unbounded.end() && *it < *cell))
+        {
+            candidates.push_back((CCTargetedTouchHandler*)handlers[*it++]);
+        }
+        else
+        {
+            CCTargetedTouchHandler *pHandler = (CCTargetedTouchHandler*)handlers[*cell++];
+            if (pHandler->_hitTestBounds.containsPoint(point))
+            {
+                candidates.push_back(pHandler);
+            }
+        }
+    }
+
+    return candidates;
+}
+
+/** World space bounds of the bounding box of a node, with some margin for the rounding errors. */
+static CCRect hitTestBoundsOfNode(CCNode *pNode)
+{
+    CCRect bounds = pNode->boundingBox();
+    if (pNode->getParent())
+    {
+        bounds = CCRectApplyAffineTransform(bounds, pNode->getParent()->nodeToWorldTransform());
+    }
+    bounds.origin.x -= 1;
+    bounds.origin.y -= 1;
+    bounds.size.width += 2;
+    bounds.size.height += 2;
+    return bounds;
+}
+
 /**
  * Used for sort
  */
@@ -67,6 +232,8 @@ void CCTouchDispatcher::setDispatchEvents(bool bDispatchEvents)
 bool CCTouchDispatcher::init(void)
 {
     _dispatchEvents = true;
+    _hitTestIndexEnabled = true;
+    _hitTestIndex = new HitTestIndex();
     _targetedHandlers = CCArray::createWithCapacity(8);
     _targetedHandlers->retain();
      _standardHandlers = CCArray::createWithCapacity(4);
@@ -96,6 +263,7 @@ CCTouchDispatcher::~CCTouchDispatcher(void)
  
      ccCArrayFree(_handlersToRemove);
     _handlersToRemove = NULL;    
+    CC_SAFE_DELETE(_hitTestIndex);
 }
 
 //
@@ -125,6 +293,7 @@ void CCTouchDispatcher::forceAddHandler(CCTouchHandler *pHandler, CCArray *pArra
      }
 
     pArray->insertObject(pHandler, u);
+    _hitTestIndex->handlersDirty = true;
 }
 
 void CCTouchDispatcher::addStandardDelegate(CCTouchDelegate *pDelegate, int nPriority)
@@ -201,6 +370,7 @@ void CCTouchDispatcher::forceRemoveDelegate(CCTouchDelegate *pDelegate)
             break;
         }
     }
+    _hitTestIndex->handlersDirty = true;
 }
 
 void CCTouchDispatcher::removeDelegate(CCTouchDelegate *pDelegate)
@@ -235,6 +405,7 @@ void CCTouchDispatcher::forceRemoveAllDelegates(void)
 {
      _standardHandlers->removeAllObjects();
      _targetedHandlers->removeAllObjects();
+    _hitTestIndex->handlersDirty = true;
 }
 
 void CCTouchDispatcher::removeAllDelegates(void)
@@ -293,6 +464,7 @@ CCTouchHandler* CCTouchDispatcher::findHandler(CCArray* pArray, CCTouchDelegate
 void CCTouchDispatcher::rearrangeHandlers(CCArray *pArray)
 {
     std::sort(pArray->data->arr, pArray->data->arr + pArray->data->num, less);
+    _hitTestIndex->handlersDirty = true;
 }
 
 void CCTouchDispatcher::setPriority(int nPriority, CCTouchDelegate *pDelegate)
@@ -313,6 +485,130 @@ void CCTouchDispatcher::setPriority(int nPriority, CCTouchDelegate *pDelegate)
     }
 }
 
+void CCTouchDispatcher::setHitTestNode(CCTouchDelegate *pDelegate, CCNode *pNode)
+{
+    CCAssert(pDelegate != NULL, "");
+
+    CCTargetedTouchHandler *pHandler = dynamic_cast<CCTargetedTouchHandler*>(findHandler(pDelegate));
+    if (! pHandler)
+    {
+        // added while dispatching
+        pHandler = dynamic_cast<CCTargetedTouchHandler*>(findHandler(_handlersToAdd, pDelegate));
+    }
+    CCAssert(pHandler != NULL, "The delegate must be a targeted delegate of the dispatcher");
+
+    if (pHandler)
+    {
+        pHandler->setHitTestNode(pNode);
+        _hitTestIndex->handlersDirty = true;
+    }
+}
+
+bool CCTouchDispatcher::isHitTestIndexEnabled(void)
+{
+    return _hitTestIndexEnabled;
+}
+
+void CCTouchDispatcher::setHitTestIndexEnabled(bool bEnabled)
+{
+    _hitTestIndexEnabled = bEnabled;
+}
+
+bool CCTouchDispatcher::updateHitTestIndex(void)
+{
+    HitTestIndex *pIndex = _hitTestIndex;
+    CCObject **handlers = _targetedHandlers->data->arr;
+
+    if (pIndex->handlersDirty)
+    {
+        pIndex->bounded.clear();
+        pIndex->unbounded.clear();
+        for (unsigned int i = 0; i < _targetedHandlers->count(); ++i)
+        {
+            if (((CCTargetedTouchHandler*)handlers[i])->_hitTestNode)
+            {
+                pIndex->bounded.push_back(i);
+            }
+            else
+            {
+                pIndex->unbounded.push_back(i);
+            }
+        }
+        pIndex->handlersDirty = false;
+        pIndex->gridDirty = true;
+    }
+
+    if (pIndex->bounded.empty())
+    {
+        return false;
+    }
+
+    pIndex->refreshed.clear();
+    for (std::vector<unsigned int>::iterator it = pIndex->bounded.begin(); it != pIndex->bounded.end(); ++it)
+    {
+        CCTargetedTouchHandler *pHandler = (CCTargetedTouchHandler*)handlers[*it];
+        if (pHandler->_hitTestEpoch == 0 || pHandler->_hitTestNode->isTransformChangedSince(pHandler->_hitTestEpoch))
+        {
+            pHandler->_hitTestBounds = hitTestBoundsOfNode(pHandler->_hitTestNode);
+            pIndex->refreshed.push_back(pHandler);
+        }
+    }
+
+    if (! pIndex->refreshed.empty())
+    {
+        // the epoch starts after the bounds were computed
+        unsigned int epoch = CCNode::newTransformEpoch();
+        for (std::vector<CCTargetedTouchHandler*>::iterator it = pIndex->refreshed.begin(); it != pIndex->refreshed.end(); ++it)
+        {
+            (*it)->_hitTestEpoch = epoch;
+        }
+        pIndex->gridDirty = true;
+    }
+
+    if (pIndex->gridDirty)
+    {
+        pIndex->build(handlers);
+    }
+
+    return true;
+}
+
+bool CCTouchDispatcher::dispatchTargetedTouch(CCTargetedTouchHandler *pHandler, CCTouch *pTouch, CCEvent *pEvent, unsigned int uIndex)
+{
+    bool bClaimed = false;
+    if (uIndex == CCTOUCHBEGAN)
+    {
+        bClaimed = pHandler->getDelegate()->ccTouchBegan(pTouch, pEvent);
+
+        if (bClaimed)
+        {
+            pHandler->getClaimedTouches()->addObject(pTouch);
+        }
+    } else
+    if (pHandler->getClaimedTouches()->containsObject(pTouch))
+    {
+        // moved ended canceled
+        bClaimed = true;
+
+        switch (_handlerHelperData[uIndex]._type)
+        {
+        case CCTOUCHMOVED:
+            pHandler->getDelegate()->ccTouchMoved(pTouch, pEvent);
+            break;
+        case CCTOUCHENDED:
+            pHandler->getDelegate()->ccTouchEnded(pTouch, pEvent);
+            pHandler->getClaimedTouches()->removeObject(pTouch);
+            break;
+        case CCTOUCHCANCELLED:
+            pHandler->getDelegate()->ccTouchCancelled(pTouch, pEvent);
+            pHandler->getClaimedTouches()->removeObject(pTouch);
+            break;
+        }
+    }
+
+    return bClaimed;
+}
+
 //
 // dispatch events
 //
@@ -342,6 +638,27 @@ void CCTouchDispatcher::touches(CCSet *pTouches, CCEvent *pEvent, unsigned int u
         {
             pTouch = (CCTouch *)(*setIter);
 
+            // only the began touches look for new handlers
+            if (uIndex == CCTOUCHBEGAN && _hitTestIndexEnabled && updateHitTestIndex())
+            {
+                const std::vector<CCTargetedTouchHandler*>& candidates =
+                    _hitTestIndex->collect(pTouch->getLocation(), _targetedHandlers->data->arr);
+                for (unsigned int i = 0; i < candidates.size(); ++i)
+                {
+                    CCTargetedTouchHandler *pHandler = candidates[i];
+                    if (dispatchTargetedTouch(pHandler, pTouch, pEvent, uIndex) && pHandler->isSwallowsTouches())
+                    {
+                        if (bNeedsMutableSet)
+                        {
+                            pMutableTouches->removeObject(pTouch);
+                        }
+
+                        break;
+                    }
+                }
+                continue;
+            }
+
             CCTargetedTouchHandler *pHandler = NULL;
             CCObject* pObj = NULL;
             CCARRAY_FOREACH(_targetedHandlers, pObj)
@@ -353,38 +670,7 @@ void CCTouchDispatcher::touches(CCSet *pTouches, CCEvent *pEvent, unsigned int u
                    break;
                 }
 
-                bool bClaimed = false;
-                if (uIndex == CCTOUCHBEGAN)
-                {
-                    bClaimed = pHandler->getDelegate()->ccTouchBegan(pTouch, pEvent);
-
-                    if (bClaimed)
-                    {
-                        pHandler->getClaimedTouches()->addObject(pTouch);
-                    }
-                } else
-                if (pHandler->getClaimedTouches()->containsObject(pTouch))
-                {
-                    // moved ended canceled
-                    bClaimed = true;
-
-                    switch (sHelper._type)
-                    {
-                    case CCTOUCHMOVED:
-                        pHandler->getDelegate()->ccTouchMoved(pTouch, pEvent);
-                        break;
-                    case CCTOUCHENDED:
-                        pHandler->getDelegate()->ccTouchEnded(pTouch, pEvent);
-                        pHandler->getClaimedTouches()->removeObject(pTouch);
-                        break;
-                    case CCTOUCHCANCELLED:
-                        pHandler->getDelegate()->ccTouchCancelled(pTouch, pEvent);
-                        pHandler->getClaimedTouches()->removeObject(pTouch);
-                        break;
-                    }
-                }
-
-                if (bClaimed && pHandler->isSwallowsTouches())
+                if (dispatchTargetedTouch(pHandler, pTouch, pEvent, uIndex) && pHandler->isSwallowsTouches())
                 {
                     if (bNeedsMutableSet)
                     {
@@ -58,6 +58,7 @@ enum {
 
 class CCSet;
 class CCEvent;
+class CCNode;
 
 struct ccTouchHandlerHelperData {
     // we only use the type
@@ -79,6 +80,7 @@ public:
 };
 
 class CCTouchHandler;
+class CCTargetedTouchHandler;
 struct _ccCArray;
 /** @brief CCTouchDispatcher.
  Singleton that handles all the touch events.
@@ -94,6 +96,10 @@ struct _ccCArray;
  These touches can be swallowed by the Targeted Touch Handlers. If there are still remaining touches, then the remaining touches will be sent
  to the Standard Touch Handlers.
 
+ Targeted handlers with a hit test node are kept in a uniform grid over their world space bounds, so a began touch
+ is only offered to the handlers whose bounds contain it, still in priority order. The bounds are refreshed when the
+ transform of the node or of one of its ancestors changes.
+
  @since v0.8.0
  */
 class CC_DLL CCTouchDispatcher : public CCObject, public EGLTouchDelegate
@@ -106,6 +112,7 @@ public:
         , _standardHandlers(NULL)
         , _handlersToAdd(NULL)
         , _handlersToRemove(NULL)
+        , _hitTestIndex(NULL)
         
     {}
 
@@ -138,6 +145,21 @@ public:
     the higher the priority */
     void setPriority(int nPriority, CCTouchDelegate *pDelegate);
 
+    /** Sets the node whose bounding box contains all the touches a targeted delegate claims, NULL to remove it.
+     The delegate is then only asked to claim the touches that begin inside the world space bounds of the
+     bounding box, so its ccTouchBegan must return false for the other ones and do nothing else.
+     The node is retained.
+     @since v3.0
+     */
+    void setHitTestNode(CCTouchDelegate *pDelegate, CCNode *pNode);
+
+    /** Whether the targeted handlers with a hit test node are looked up in the spatial index. Default: true.
+     When disabled, every targeted handler is asked about every touch.
+     @since v3.0
+     */
+    bool isHitTestIndexEnabled(void);
+    void setHitTestIndexEnabled(bool bEnabled);
+
     void touches(CCSet *pTouches, CCEvent *pEvent, unsigned int uIndex);
 
     virtual void touchesBegan(CCSet* touches, CCEvent* pEvent);
@@ -153,8 +175,14 @@ protected:
     void forceRemoveAllDelegates(void);
     void rearrangeHandlers(CCArray* pArray);
     CCTouchHandler* findHandler(CCArray* pArray, CCTouchDelegate *pDelegate);
+    /** Returns whether the handler claims the touch. */
+    bool dispatchTargetedTouch(CCTargetedTouchHandler *pHandler, CCTouch *pTouch, CCEvent *pEvent, unsigned int uIndex);
+    /** Refreshes the stale bounds and the grid, returns false if no handler has a hit test node. */
+    bool updateHitTestIndex(void);
 
 protected:
+    struct HitTestIndex;
+
      CCArray* _targetedHandlers;
      CCArray* _standardHandlers;
 
@@ -165,6 +193,8 @@ protected:
     struct _ccCArray *_handlersToRemove;
     bool _toQuit;
     bool _dispatchEvents;
+    bool _hitTestIndexEnabled;
+    HitTestIndex *_hitTestIndex;
 
     // 4, 1 for each type of event
     struct ccTouchHandlerHelperData _handlerHelperData[ccTouchMax];
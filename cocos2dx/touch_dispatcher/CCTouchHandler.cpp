@@ -25,6 +25,7 @@ THE SOFTWARE.
 
 #include "CCTouchHandler.h"
 #include "ccMacros.h"
+#include "base_nodes/CCNode.h"
 
 NS_CC_BEGIN
 
@@ -156,6 +157,22 @@ CCSet* CCTargetedTouchHandler::getClaimedTouches(void)
     return _claimedTouches;
 }
 
+CCNode* CCTargetedTouchHandler::getHitTestNode(void)
+{
+    return _hitTestNode;
+}
+
+void CCTargetedTouchHandler::setHitTestNode(CCNode *pNode)
+{
+    if (pNode != _hitTestNode)
+    {
+        CC_SAFE_RETAIN(pNode);
+        CC_SAFE_RELEASE(_hitTestNode);
+        _hitTestNode = pNode;
+        _hitTestEpoch = 0;
+    }
+}
+
 CCTargetedTouchHandler* CCTargetedTouchHandler::handlerWithDelegate(CCTouchDelegate *pDelegate, int nPriority, bool bSwallow)
 {
     CCTargetedTouchHandler *pHandler = new CCTargetedTouchHandler();
@@ -190,6 +207,7 @@ bool CCTargetedTouchHandler::initWithDelegate(CCTouchDelegate *pDelegate, int nP
 CCTargetedTouchHandler::~CCTargetedTouchHandler(void)
 {
     CC_SAFE_RELEASE(_claimedTouches);
+    CC_SAFE_RELEASE(_hitTestNode);
 }
 
 NS_CC_END
@@ -30,9 +30,12 @@ THE SOFTWARE.
 #include "CCTouchDispatcher.h"
 #include "cocoa/CCObject.h"
 #include "cocoa/CCSet.h"
+#include "cocoa/CCGeometry.h"
 
 NS_CC_BEGIN
 
+class CCNode;
+
 /**
  * @addtogroup input
  * @{
@@ -94,6 +97,12 @@ public:
 class CC_DLL  CCTargetedTouchHandler : public CCTouchHandler
 {
 public:
+    CCTargetedTouchHandler()
+        : _swallowsTouches(false)
+        , _claimedTouches(NULL)
+        , _hitTestNode(NULL)
+        , _hitTestEpoch(0)
+    {}
     ~CCTargetedTouchHandler(void);
 
     /** whether or not the touches are swallowed */
@@ -103,6 +112,13 @@ public:
     /** MutableSet that contains the claimed touches */
     CCSet* getClaimedTouches(void);
 
+    /** Node whose bounding box contains all the touches the delegate claims, NULL if unknown.
+     See CCTouchDispatcher::setHitTestNode.
+     @since v3.0
+     */
+    CCNode* getHitTestNode(void);
+    void setHitTestNode(CCNode *pNode);
+
     /** initializes a TargetedTouchHandler with a delegate, a priority and whether or not it swallows touches or not */
     bool initWithDelegate(CCTouchDelegate *pDelegate, int nPriority, bool bSwallow);
 
@@ -113,6 +129,13 @@ public:
 protected:
     bool _swallowsTouches;
     CCSet *_claimedTouches;
+
+    CCNode *_hitTestNode;
+    // world space bounds of the hit test node, valid until its transform changes after _hitTestEpoch
+    CCRect _hitTestBounds;
+    unsigned int _hitTestEpoch;
+
+    friend class CCTouchDispatcher;
 };
 
 // end of input group
@@ -6,6 +6,7 @@ LOCAL_MODULE    := cocos_extension_static
 LOCAL_MODULE_FILENAME := libextension
 
 LOCAL_SRC_FILES := AssetsManager/AssetsManager.cpp \
+AssetsManager/ZipStreamExtractor.cpp \
 CCArmature/CCArmature.cpp \
 CCArmature/CCBone.cpp \
 CCArmature/animation/CCArmatureAnimation.cpp \
@@ -74,12 +75,14 @@ GUI/CCScrollView/CCScrollView.cpp \
 GUI/CCScrollView/CCTableView.cpp \
 GUI/CCScrollView/CCTableViewCell.cpp \
 GUI/CCScrollView/CCSorting.cpp \
+GUI/CCScrollView/CCCellPositionTree.cpp \
 GUI/CCEditBox/CCEditBox.cpp \
 GUI/CCEditBox/CCEditBoxImplAndroid.cpp \
 network/HttpClient.cpp \
 network/WebSocket.cpp \
 physics_nodes/CCPhysicsDebugNode.cpp \
 physics_nodes/CCPhysicsSprite.cpp \
+physics_nodes/CCPhysicsStepper.cpp \
 LocalStorage/LocalStorageAndroid.cpp \
 spine/Animation.cpp \
 spine/AnimationState.cpp \
@@ -23,17 +23,21 @@
  ****************************************************************************/
 
 #include "AssetsManager.h"
+#include "ZipStreamExtractor.h"
 #include "cocos2d.h"
 
 #include <curl/curl.h>
 #include <curl/easy.h>
 #include <stdio.h>
+#include <zlib.h>
 #include <vector>
+#include <set>
 
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <errno.h>
+#include <unistd.h>
 #endif
 
 #include "support/zip_support/unzip.h"
@@ -45,7 +49,9 @@ NS_CC_EXT_BEGIN;
 
 #define KEY_OF_VERSION   "current-version-code"
 #define KEY_OF_DOWNLOADED_VERSION    "downloaded-version-code"
+#define KEY_OF_DOWNLOADING_VERSION   "downloading-version-code"
 #define TEMP_PACKAGE_FILE_NAME    "cocos2dx-update-temp-package.zip"
+#define STAGING_DIRECTORY_NAME    "cocos2dx-update-staging/"
 #define BUFFER_SIZE    8192
 #define MAX_FILENAME   512
 
@@ -80,6 +86,9 @@ AssetsManager::AssetsManager(const char* packageUrl/* =NULL */, const char* vers
 , _curl(NULL)
 , _tid(NULL)
 , _connectionTimeout(0)
+, _extractionThreads(4)
+, _resumeOffset(0)
+, _packageExtracted(false)
 , _delegate(NULL)
 {
     checkStoragePath();
@@ -161,22 +170,38 @@ void* assetsManagerDownloadAndUncompress(void *data)
     
     do
     {
-        if (self->_downloadedVersion != self->_version)
+        if (self->_manifestUrl.size() > 0)
         {
-            if (! self->downLoad()) break;
-            
-            // Record downloaded version.
-            AssetsManager::Message *msg1 = new AssetsManager::Message();
-            msg1->what = ASSETSMANAGER_MESSAGE_RECORD_DOWNLOADED_VERSION;
-            msg1->obj = self;
-            self->_schedule->sendMessage(msg1);
+            // Only download the files that changed.
+            if (! self->downLoadChangedFiles()) break;
         }
-        
-        // Uncompress zip file.
-        if (! self->uncompress())
+        else
         {
-            self->sendErrorMessage(AssetsManager::kUncompress);
-            break;
+            self->_packageExtracted = false;
+            if (self->_downloadedVersion != self->_version)
+            {
+                if (! self->downLoad()) break;
+                
+                // Record downloaded version.
+                AssetsManager::Message *msg1 = new AssetsManager::Message();
+                msg1->what = ASSETSMANAGER_MESSAGE_RECORD_DOWNLOADED_VERSION;
+                msg1->obj = self;
+                self->_schedule->sendMessage(msg1);
+            }
+            
+            // Uncompress zip file, unless it was done while downloading.
+            if (! self->_packageExtracted && ! self->uncompress())
+            {
+                self->sendErrorMessage(AssetsManager::kUncompress);
+                break;
+            }
+            
+            // The whole package is verified, replace the old resources.
+            if (! self->installStagedFiles())
+            {
+                self->sendErrorMessage(AssetsManager::kUncompress);
+                break;
+            }
         }
         
         // Record updated version and remove downloaded zip file
@@ -201,9 +226,10 @@ void AssetsManager::update()
     
     // 1. Urls of package and version should be valid;
     // 2. Package should be a zip file.
+    // The package isn't used when there is a manifest.
     if (_versionFileUrl.size() == 0 ||
-        _packageUrl.size() == 0 ||
-        std::string::npos == _packageUrl.find(".zip"))
+        (_manifestUrl.size() == 0 &&
+         (_packageUrl.size() == 0 || std::string::npos == _packageUrl.find(".zip"))))
     {
         CCLOG("no version file url, or no package url, or the package is not a zip file");
         return;
@@ -215,130 +241,82 @@ void AssetsManager::update()
     // Is package already downloaded?
     _downloadedVersion = CCUserDefault::sharedUserDefault()->getStringForKey(KEY_OF_DOWNLOADED_VERSION);
     
+    // A partially downloaded package can only be resumed if it is the same version.
+    string downloadingVersion = CCUserDefault::sharedUserDefault()->getStringForKey(KEY_OF_DOWNLOADING_VERSION);
+    if (downloadingVersion != _version && _downloadedVersion != _version)
+    {
+        remove((_storagePath + TEMP_PACKAGE_FILE_NAME).c_str());
+        CCUserDefault::sharedUserDefault()->setStringForKey(KEY_OF_DOWNLOADING_VERSION, _version.c_str());
+        CCUserDefault::sharedUserDefault()->flush();
+    }
+    
     _tid = new pthread_t();
     pthread_create(&(*_tid), NULL, assetsManagerDownloadAndUncompress, this);
 }
 
 bool AssetsManager::uncompress()
 {
-    // Open the zip file
     string outFileName = _storagePath + TEMP_PACKAGE_FILE_NAME;
-    unzFile zipfile = unzOpen(outFileName.c_str());
-    if (! zipfile)
-    {
-        CCLOG("can not open downloaded zip file %s", outFileName.c_str());
-        return false;
-    }
     
-    // Get info about the zip file
-    unz_global_info global_info;
-    if (unzGetGlobalInfo(zipfile, &global_info) != UNZ_OK)
+    CCLOG("start uncompressing");
+    
+    // Entries are independent, each thread extracts a share of them.
+    if (! ZipStreamExtractor::extractZipFile(outFileName, _storagePath + STAGING_DIRECTORY_NAME,
+                                             _extractionThreads, &_stagedFiles))
     {
-        CCLOG("can not read file global info of %s", outFileName.c_str());
-        unzClose(zipfile);
+        CCLOG("can not uncompress downloaded zip file %s", outFileName.c_str());
         return false;
     }
     
-    // Buffer to hold data read from the zip file
-    char readBuffer[BUFFER_SIZE];
+    CCLOG("end uncompressing");
     
-    CCLOG("start uncompressing");
+    return true;
+}
+
+static bool removeDirectory(const string& path)
+{
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
+    return rmdir(path.c_str()) == 0;
+#else
+    return RemoveDirectoryA(path.c_str()) != 0;
+#endif
+}
+
+bool AssetsManager::installStagedFiles()
+{
+    string stagingPath = _storagePath + STAGING_DIRECTORY_NAME;
+    set<string> directories;
     
-    // Loop to extract all files.
-    uLong i;
-    for (i = 0; i < global_info.number_entry; ++i)
+    for (vector<string>::iterator it = _stagedFiles.begin(); it != _stagedFiles.end(); ++it)
     {
-        // Get info about current file.
-        unz_file_info fileInfo;
-        char fileName[MAX_FILENAME];
-        if (unzGetCurrentFileInfo(zipfile,
-                                  &fileInfo,
-                                  fileName,
-                                  MAX_FILENAME,
-                                  NULL,
-                                  0,
-                                  NULL,
-                                  0) != UNZ_OK)
+        string stagedPath = stagingPath + *it;
+        string fullPath = _storagePath + *it;
+        if (! ZipStreamExtractor::createDirectories(fullPath))
         {
-            CCLOG("can not read file info");
-            unzClose(zipfile);
+            CCLOG("can not create directory for %s", fullPath.c_str());
             return false;
         }
         
-        string fullPath = _storagePath + fileName;
-        
-        // Check if this entry is a directory or a file.
-        const size_t filenameLength = strlen(fileName);
-        if (fileName[filenameLength-1] == '/')
-        {
-            // Entry is a direcotry, so create it.
-            // If the directory exists, it will failed scilently.
-            if (!createDirectory(fullPath.c_str()))
-            {
-                CCLOG("can not create directory %s", fullPath.c_str());
-                unzClose(zipfile);
-                return false;
-            }
-        }
-        else
+        remove(fullPath.c_str());
+        if (rename(stagedPath.c_str(), fullPath.c_str()) != 0)
         {
-            // Entry is a file, so extract it.
-            
-            // Open current file.
-            if (unzOpenCurrentFile(zipfile) != UNZ_OK)
-            {
-                CCLOG("can not open file %s", fileName);
-                unzClose(zipfile);
-                return false;
-            }
-            
-            // Create a file to store current file.
-            FILE *out = fopen(fullPath.c_str(), "wb");
-            if (! out)
-            {
-                CCLOG("can not open destination file %s", fullPath.c_str());
-                unzCloseCurrentFile(zipfile);
-                unzClose(zipfile);
-                return false;
-            }
-            
-            // Write current file content to destinate file.
-            int error = UNZ_OK;
-            do
-            {
-                error = unzReadCurrentFile(zipfile, readBuffer, BUFFER_SIZE);
-                if (error < 0)
-                {
-                    CCLOG("can not read zip file %s, error code is %d", fileName, error);
-                    unzCloseCurrentFile(zipfile);
-                    unzClose(zipfile);
-                    return false;
-                }
-                
-                if (error > 0)
-                {
-                    fwrite(readBuffer, error, 1, out);
-                }
-            } while(error > 0);
-            
-            fclose(out);
+            CCLOG("can not move %s to %s", stagedPath.c_str(), fullPath.c_str());
+            return false;
         }
         
-        unzCloseCurrentFile(zipfile);
-        
-        // Goto next entry listed in the zip file.
-        if ((i+1) < global_info.number_entry)
+        for (size_t pos = it->find('/'); pos != string::npos; pos = it->find('/', pos + 1))
         {
-            if (unzGoToNextFile(zipfile) != UNZ_OK)
-            {
-                CCLOG("can not read next file");
-                unzClose(zipfile);
-                return false;
-            }
+            directories.insert(it->substr(0, pos + 1));
         }
     }
+    _stagedFiles.clear();
     
-    CCLOG("end uncompressing");
+    // Subdirectories sort after their parents, remove them first.
+    for (set<string>::reverse_iterator it = directories.rbegin(); it != directories.rend(); ++it)
+    {
+        removeDirectory(stagingPath + *it);
+    }
+    removeDirectory(stagingPath);
     
     return true;
 }
@@ -376,36 +354,76 @@ void AssetsManager::setSearchPath()
     CCFileUtils::sharedFileUtils()->setSearchPaths(searchPaths);
 }
 
+struct DownloadContext
+{
+    FILE *fp;
+    CURL *curl;
+    ZipStreamExtractor *extractor;
+    long offset;
+    bool rangeChecked;
+};
+
+static void stopStreamingExtraction(DownloadContext *context)
+{
+    // The package will be extracted once it is downloaded.
+    CCLOG("can not extract package while downloading, it will be extracted after downloading");
+    delete context->extractor;
+    context->extractor = NULL;
+}
+
 static size_t downLoadPackage(void *ptr, size_t size, size_t nmemb, void *userdata)
 {
-    FILE *fp = (FILE*)userdata;
-    size_t written = fwrite(ptr, size, nmemb, fp);
-    return written;
+    DownloadContext *context = (DownloadContext*)userdata;
+    
+    if (! context->rangeChecked)
+    {
+        context->rangeChecked = true;
+        
+        long responseCode = 0;
+        curl_easy_getinfo(context->curl, CURLINFO_RESPONSE_CODE, &responseCode);
+        if (context->offset > 0 && responseCode != 206)
+        {
+            // The whole package is sent again, don't append it to the partial one.
+            // Aborting makes downLoad() restart without a range.
+            return 0;
+        }
+    }
+    
+    size_t written = fwrite(ptr, size, nmemb, context->fp);
+    
+    if (context->extractor && ! context->extractor->feed((const char*)ptr, size * nmemb))
+    {
+        stopStreamingExtraction(context);
+    }
+    
+    return written * size;
 }
 
 int assetsManagerProgressFunc(void *ptr, double totalToDownload, double nowDownloaded, double totalToUpLoad, double nowUpLoaded)
 {
     AssetsManager* manager = (AssetsManager*)ptr;
-    AssetsManager::Message *msg = new AssetsManager::Message();
-    msg->what = ASSETSMANAGER_MESSAGE_PROGRESS;
     
-    ProgressMessage *progressData = new ProgressMessage();
-    progressData->percent = (int)(nowDownloaded/totalToDownload*100);
-    progressData->manager = manager;
-    msg->obj = progressData;
+    if (totalToDownload <= 0)
+    {
+        return 0;
+    }
     
-    manager->_schedule->sendMessage(msg);
+    // Sizes given by curl don't include the part downloaded before resuming.
+    double offset = manager->_resumeOffset;
+    int percent = (int)((offset + nowDownloaded) / (offset + totalToDownload) * 100);
+    manager->sendProgressMessage(percent);
     
-    CCLOG("downloading... %d%%", (int)(nowDownloaded/totalToDownload*100));
+    CCLOG("downloading... %d%%", percent);
     
     return 0;
 }
 
 bool AssetsManager::downLoad()
 {
-    // Create a file to save package.
+    // Open the file to save package, keeping what was downloaded before.
     string outFileName = _storagePath + TEMP_PACKAGE_FILE_NAME;
-    FILE *fp = fopen(outFileName.c_str(), "wb");
+    string stagingPath = _storagePath + STAGING_DIRECTORY_NAME;
+    FILE *fp = fopen(outFileName.c_str(), "ab");
     if (! fp)
     {
         sendErrorMessage(kCreateFile);
@@ -413,27 +431,326 @@ bool AssetsManager::downLoad()
         return false;
     }
     
+    fseek(fp, 0, SEEK_END);
+    _resumeOffset = ftell(fp);
+    
+    DownloadContext context;
+    context.fp = fp;
+    context.curl = _curl;
+    context.extractor = new ZipStreamExtractor(stagingPath, _extractionThreads);
+    context.offset = _resumeOffset;
+    context.rangeChecked = false;
+    
+    if (_resumeOffset > 0)
+    {
+        CCLOG("resume downloading package from %ld bytes", _resumeOffset);
+        
+        // Extract the entries that were downloaded before.
+        FILE *previous = fopen(outFileName.c_str(), "rb");
+        char buffer[BUFFER_SIZE];
+        size_t read = 0;
+        while (previous && context.extractor && (read = fread(buffer, 1, BUFFER_SIZE, previous)) > 0)
+        {
+            if (! context.extractor->feed(buffer, read))
+            {
+                stopStreamingExtraction(&context);
+            }
+        }
+        if (previous) fclose(previous);
+    }
+    
     // Download pacakge
     CURLcode res;
     curl_easy_setopt(_curl, CURLOPT_URL, _packageUrl.c_str());
     curl_easy_setopt(_curl, CURLOPT_WRITEFUNCTION, downLoadPackage);
-    curl_easy_setopt(_curl, CURLOPT_WRITEDATA, fp);
+    curl_easy_setopt(_curl, CURLOPT_WRITEDATA, &context);
     curl_easy_setopt(_curl, CURLOPT_NOPROGRESS, false);
     curl_easy_setopt(_curl, CURLOPT_PROGRESSFUNCTION, assetsManagerProgressFunc);
     curl_easy_setopt(_curl, CURLOPT_PROGRESSDATA, this);
+    curl_easy_setopt(_curl, CURLOPT_RESUME_FROM_LARGE, (curl_off_t)_resumeOffset);
+    curl_easy_setopt(_curl, CURLOPT_FAILONERROR, 1L);
     res = curl_easy_perform(_curl);
+    
+    long responseCode = 0;
+    curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, &responseCode);
+    
+    // The server ignored the range: libcurl fails with CURLE_RANGE_ERROR, or the
+    // write callback aborted on a 200. Restart once from the beginning.
+    if (_resumeOffset > 0 && (res == CURLE_RANGE_ERROR || responseCode == 200))
+    {
+        CCLOG("can not resume downloading, restart from the beginning");
+        
+        fclose(context.fp);
+        context.fp = fopen(outFileName.c_str(), "wb");
+        if (! context.fp)
+        {
+            delete context.extractor;
+            curl_easy_cleanup(_curl);
+            sendErrorMessage(kCreateFile);
+            CCLOG("can not create file %s", outFileName.c_str());
+            return false;
+        }
+        
+        _resumeOffset = 0;
+        delete context.extractor;
+        context.extractor = new ZipStreamExtractor(stagingPath, _extractionThreads);
+        context.offset = 0;
+        context.rangeChecked = false;
+        
+        curl_easy_setopt(_curl, CURLOPT_RESUME_FROM_LARGE, (curl_off_t)0);
+        res = curl_easy_perform(_curl);
+        curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, &responseCode);
+    }
     curl_easy_cleanup(_curl);
-    if (res != 0)
+    
+    if (context.fp) fclose(context.fp);
+    
+    // 416: the package was completely downloaded before
+    if (res != 0 && ! (_resumeOffset > 0 && responseCode == 416))
     {
+        delete context.extractor;
         sendErrorMessage(kNetwork);
         CCLOG("error when download package");
-        fclose(fp);
         return false;
     }
     
+    if (context.extractor)
+    {
+        _packageExtracted = context.extractor->finish();
+        if (_packageExtracted)
+        {
+            _stagedFiles = context.extractor->getExtractedFiles();
+        }
+        CCLOG("extracted %u files while downloading", context.extractor->getExtractedCount());
+        delete context.extractor;
+    }
+    
     CCLOG("succeed downloading package %s", _packageUrl.c_str());
     
-    fclose(fp);
+    return true;
+}
+
+struct ManifestEntry
+{
+    string path;
+    unsigned long crc;
+    unsigned long size;
+    bool changed;
+};
+
+struct VerifyTask
+{
+    vector<ManifestEntry> *entries;
+    const string *storagePath;
+    unsigned int index;
+    unsigned int count;
+};
+
+// Marks the entries i with i % count == index whose local copy is missing or different
+static void* verifyManifestShare(void *data)
+{
+    VerifyTask *task = (VerifyTask*)data;
+    vector<char> buffer(BUFFER_SIZE);
+    
+    for (unsigned int i = task->index; i < task->entries->size(); i += task->count)
+    {
+        ManifestEntry& entry = (*task->entries)[i];
+        entry.changed = true;
+        
+        FILE *fp = fopen((*task->storagePath + entry.path).c_str(), "rb");
+        if (! fp)
+        {
+            continue;
+        }
+        
+        uLong crc = crc32(0L, Z_NULL, 0);
+        unsigned long size = 0;
+        size_t read = 0;
+        while ((read = fread(&buffer[0], 1, BUFFER_SIZE, fp)) > 0)
+        {
+            crc = crc32(crc, (const Bytef*)&buffer[0], read);
+            size += read;
+        }
+        fclose(fp);
+        
+        entry.changed = (crc != entry.crc || size != entry.size);
+    }
+    
+    return NULL;
+}
+
+static bool parseManifest(const string& content, vector<ManifestEntry>& entries)
+{
+    size_t start = 0;
+    while (start < content.size())
+    {
+        size_t end = content.find('\n', start);
+        if (end == string::npos) end = content.size();
+        string line = content.substr(start, end - start);
+        start = end + 1;
+        
+        if (line.size() > 0 && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        if (line.empty() || line[0] == '#') continue;
+        
+        ManifestEntry entry;
+        char path[MAX_FILENAME];
+        if (sscanf(line.c_str(), "%lx %lu %511[^\n]", &entry.crc, &entry.size, path) != 3
+            || path[0] == '/' || strstr(path, "..") != NULL)
+        {
+            CCLOG("invalid manifest line: %s", line.c_str());
+            return false;
+        }
+        entry.path = path;
+        entry.changed = true;
+        entries.push_back(entry);
+    }
+    
+    return true;
+}
+
+struct FileDownload
+{
+    FILE *fp;
+    uLong crc;
+    unsigned long size;
+};
+
+static size_t downLoadFile(void *ptr, size_t size, size_t nmemb, void *userdata)
+{
+    FileDownload *download = (FileDownload*)userdata;
+    size_t written = fwrite(ptr, size, nmemb, download->fp);
+    download->crc = crc32(download->crc, (const Bytef*)ptr, written * size);
+    download->size += written * size;
+    return written * size;
+}
+
+bool AssetsManager::downLoadChangedFiles()
+{
+    // Download manifest, the handle is reused for all files to keep the connection alive.
+    string manifest;
+    curl_easy_setopt(_curl, CURLOPT_URL, _manifestUrl.c_str());
+    curl_easy_setopt(_curl, CURLOPT_WRITEFUNCTION, getVersionCode);
+    curl_easy_setopt(_curl, CURLOPT_WRITEDATA, &manifest);
+    curl_easy_setopt(_curl, CURLOPT_FAILONERROR, 1L);
+    if (curl_easy_perform(_curl) != 0)
+    {
+        curl_easy_cleanup(_curl);
+        sendErrorMessage(kNetwork);
+        CCLOG("can not download manifest %s", _manifestUrl.c_str());
+        return false;
+    }
+    
+    vector<ManifestEntry> entries;
+    if (! parseManifest(manifest, entries))
+    {
+        curl_easy_cleanup(_curl);
+        sendErrorMessage(kVerify);
+        return false;
+    }
+    
+    // Verify local files in parallel.
+    unsigned int threads = _extractionThreads > 0 ? _extractionThreads : 1;
+    vector<VerifyTask> tasks(threads);
+    vector<pthread_t> tids(threads);
+    vector<bool> started(threads, false);
+    for (unsigned int i = 0; i < threads; ++i)
+    {
+        tasks[i].entries = &entries;
+        tasks[i].storagePath = &_storagePath;
+        tasks[i].index = i;
+        tasks[i].count = threads;
+        if (i > 0)
+        {
+            started[i] = (pthread_create(&tids[i], NULL, verifyManifestShare, &tasks[i]) == 0);
+            if (! started[i]) verifyManifestShare(&tasks[i]);
+        }
+    }
+    verifyManifestShare(&tasks[0]);
+    for (unsigned int i = 1; i < threads; ++i)
+    {
+        if (started[i]) pthread_join(tids[i], NULL);
+    }
+    
+    double totalSize = 0;
+    unsigned int changedCount = 0;
+    for (vector<ManifestEntry>::iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        if (it->changed)
+        {
+            totalSize += it->size;
+            ++changedCount;
+        }
+    }
+    CCLOG("%u of %u files changed", changedCount, (unsigned int)entries.size());
+    
+    // Files are relative to the directory of the manifest.
+    string baseUrl = _manifestUrl.substr(0, _manifestUrl.rfind('/') + 1);
+    double downloadedSize = 0;
+    
+    for (vector<ManifestEntry>::iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        if (! it->changed) continue;
+        
+        string fullPath = _storagePath + it->path;
+        string tempPath = fullPath + ".download";
+        if (! ZipStreamExtractor::createDirectories(fullPath))
+        {
+            curl_easy_cleanup(_curl);
+            sendErrorMessage(kCreateFile);
+            CCLOG("can not create directory for %s", fullPath.c_str());
+            return false;
+        }
+        
+        FileDownload download;
+        download.fp = fopen(tempPath.c_str(), "wb");
+        download.crc = crc32(0L, Z_NULL, 0);
+        download.size = 0;
+        if (! download.fp)
+        {
+            curl_easy_cleanup(_curl);
+            sendErrorMessage(kCreateFile);
+            CCLOG("can not create file %s", tempPath.c_str());
+            return false;
+        }
+        
+        curl_easy_setopt(_curl, CURLOPT_URL, (baseUrl + it->path).c_str());
+        curl_easy_setopt(_curl, CURLOPT_WRITEFUNCTION, downLoadFile);
+        curl_easy_setopt(_curl, CURLOPT_WRITEDATA, &download);
+        CURLcode res = curl_easy_perform(_curl);
+        fclose(download.fp);
+        
+        if (res != 0)
+        {
+            remove(tempPath.c_str());
+            curl_easy_cleanup(_curl);
+            sendErrorMessage(kNetwork);
+            CCLOG("can not download %s", it->path.c_str());
+            return false;
+        }
+        
+        if (download.crc != it->crc || download.size != it->size)
+        {
+            remove(tempPath.c_str());
+            curl_easy_cleanup(_curl);
+            sendErrorMessage(kVerify);
+            CCLOG("checksum mismatch for %s", it->path.c_str());
+            return false;
+        }
+        
+        remove(fullPath.c_str());
+        if (rename(tempPath.c_str(), fullPath.c_str()) != 0)
+        {
+            curl_easy_cleanup(_curl);
+            sendErrorMessage(kCreateFile);
+            CCLOG("can not replace %s", fullPath.c_str());
+            return false;
+        }
+        
+        downloadedSize += it->size;
+        sendProgressMessage(totalSize > 0 ? (int)(downloadedSize / totalSize * 100) : 100);
+    }
+    
+    curl_easy_cleanup(_curl);
     return true;
 }
 
@@ -483,6 +800,26 @@ void AssetsManager::setDelegate(AssetsManagerDelegateProtocol *delegate)
     _delegate = delegate;
 }
 
+void AssetsManager::setExtractionThreads(unsigned int threads)
+{
+    _extractionThreads = threads;
+}
+
+unsigned int AssetsManager::getExtractionThreads() const
+{
+    return _extractionThreads;
+}
+
+void AssetsManager::setManifestUrl(const char *manifestUrl)
+{
+    _manifestUrl = manifestUrl ? manifestUrl : "";
+}
+
+const char* AssetsManager::getManifestUrl() const
+{
+    return _manifestUrl.c_str();
+}
+
 void AssetsManager::setConnectionTimeout(unsigned int timeout)
 {
     _connectionTimeout = timeout;
@@ -506,6 +843,19 @@ void AssetsManager::sendErrorMessage(AssetsManager::ErrorCode code)
     _schedule->sendMessage(msg);
 }
 
+void AssetsManager::sendProgressMessage(int percent)
+{
+    Message *msg = new Message();
+    msg->what = ASSETSMANAGER_MESSAGE_PROGRESS;
+    
+    ProgressMessage *progressData = new ProgressMessage();
+    progressData->percent = percent;
+    progressData->manager = this;
+    msg->obj = progressData;
+    
+    _schedule->sendMessage(msg);
+}
+
 // Implementation of AssetsManagerHelper
 
 AssetsManager::Helper::Helper()
@@ -591,6 +941,7 @@ void AssetsManager::Helper::handleUpdateSucceed(Message *msg)
     
     // Unrecord downloaded version code.
     CCUserDefault::sharedUserDefault()->setStringForKey(KEY_OF_DOWNLOADED_VERSION, "");
+    CCUserDefault::sharedUserDefault()->setStringForKey(KEY_OF_DOWNLOADING_VERSION, "");
     CCUserDefault::sharedUserDefault()->flush();
     
     // Set resource search path.
@@ -598,7 +949,7 @@ void AssetsManager::Helper::handleUpdateSucceed(Message *msg)
     
     // Delete unloaded zip file.
     string zipfileName = manager->_storagePath + TEMP_PACKAGE_FILE_NAME;
-    if (remove(zipfileName.c_str()) != 0)
+    if (manager->_manifestUrl.size() == 0 && remove(zipfileName.c_str()) != 0)
     {
         CCLOG("can not remove downloaded zip file %s", zipfileName.c_str());
     }
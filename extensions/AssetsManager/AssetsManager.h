@@ -26,6 +26,7 @@
 #define __AssetsManager__
 
 #include <string>
+#include <vector>
 #include <curl/curl.h>
 #include <pthread.h>
 
@@ -40,6 +41,14 @@ class AssetsManagerDelegateProtocol;
  *  This class is used to auto update resources, such as pictures or scripts.
  *  The updated package should be a zip file. And there should be a file named
  *  version in the server, which contains version code.
+ *
+ *  An interrupted download is resumed with a HTTP range request, and the
+ *  entries of the package are extracted by several threads while it is
+ *  downloaded. They are extracted to a staging directory, and only moved to
+ *  the storage path once the whole package was extracted and verified.
+ *
+ *  Alternatively a manifest listing every file with its CRC32 can be used,
+ *  then only the files that differ from the local ones are downloaded.
  */
 class AssetsManager
 {
@@ -65,6 +74,10 @@ public:
          -- ...
          */
         kUncompress,
+        /** A file downloaded with the manifest doesn't match its checksum,
+            or the manifest can't be parsed
+         */
+        kVerify,
     };
     
     /* @brief Creates a AssetsManager with new package url, version code url and storage path.
@@ -135,6 +148,27 @@ public:
      */
     unsigned int getConnectionTimeout();
     
+    /** @brief Sets the number of threads used to extract the package and verify files, default is 4
+     */
+    void setExtractionThreads(unsigned int threads);
+    
+    /** @brief Gets the number of threads used to extract the package and verify files
+     */
+    unsigned int getExtractionThreads() const;
+    
+    /** @brief Sets the url of a manifest, which makes update() download only the changed files
+     *         instead of the package.
+     *
+     *  Each line of the manifest is "<crc32 in hex> <size> <relative path>", lines starting
+     *  with '#' are ignored. A file is downloaded from the directory of the manifest url
+     *  followed by its relative path, if the local copy is missing or has another checksum.
+     */
+    void setManifestUrl(const char* manifestUrl);
+    
+    /** @brief Gets manifest url.
+     */
+    const char* getManifestUrl() const;
+    
     /* downloadAndUncompress is the entry of a new thread 
      */
     friend void* assetsManagerDownloadAndUncompress(void*);
@@ -142,11 +176,14 @@ public:
     
 protected:
     bool downLoad();
+    bool downLoadChangedFiles();
     void checkStoragePath();
     bool uncompress();
+    bool installStagedFiles();
     bool createDirectory(const char *path);
     void setSearchPath();
     void sendErrorMessage(ErrorCode code);
+    void sendProgressMessage(int percent);
     
 private:
     typedef struct _Message
@@ -185,10 +222,20 @@ private:
     
     std::string _downloadedVersion;
     
+    std::string _manifestUrl;
+    
     CURL *_curl;
     Helper *_schedule;
     pthread_t *_tid;
     unsigned int _connectionTimeout;
+    unsigned int _extractionThreads;
+    
+    //! Size of the part of the package downloaded before, when resuming.
+    long _resumeOffset;
+    //! Set when the package was extracted while it was downloaded.
+    bool _packageExtracted;
+    //! Files of the package extracted to the staging directory.
+    std::vector<std::string> _stagedFiles;
     
     AssetsManagerDelegateProtocol *_delegate; // weak reference
 };
@@ -0,0 +1,780 @@
+/****************************************************************************
+ Copyright (c) 2013 cocos2d-x.org
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ZipStreamExtractor.h"
+
+#include <stdio.h>
+#include <zlib.h>
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <errno.h>
+#endif
+
+#include "support/zip_support/unzip.h"
+
+using namespace cocos2d;
+using namespace std;
+
+NS_CC_EXT_BEGIN;
+
+#define LOCAL_HEADER_SIGNATURE          0x04034b50
+#define CENTRAL_HEADER_SIGNATURE        0x02014b50
+#define END_OF_CENTRAL_DIR_SIGNATURE    0x06054b50
+#define ZIP64_END_OF_CENTRAL_DIR_SIGNATURE 0x06064b50
+#define LOCAL_HEADER_SIZE               30
+
+#define FLAG_ENCRYPTED                  0x0001
+#define FLAG_DATA_DESCRIPTOR            0x0008
+
+#define METHOD_STORED                   0
+#define METHOD_DEFLATED                 8
+
+// feed() blocks when more compressed bytes than this are waiting for the workers
+#define MAX_QUEUED_BYTES                (16 * 1024 * 1024)
+// larger entries are inflated and written while they arrive, on the feeding thread
+#define MAX_BUFFERED_ENTRY_SIZE         (256 * 1024)
+#define BUFFER_SIZE                     8192
+#define MAX_FILENAME                    512
+
+static inline unsigned int readUInt16(const char *p)
+{
+    const unsigned char *b = (const unsigned char*)p;
+    return b[0] | (b[1] << 8);
+}
+
+static inline unsigned long readUInt32(const char *p)
+{
+    const unsigned char *b = (const unsigned char*)p;
+    return (unsigned long)b[0] | ((unsigned long)b[1] << 8) | ((unsigned long)b[2] << 16) | ((unsigned long)b[3] << 24);
+}
+
+// Entry names must stay inside the destination directory
+static bool isSafeEntryName(const string& name)
+{
+    if (name.empty() || name[0] == '/' || name[0] == '\\')
+    {
+        return false;
+    }
+
+    return name != ".." && name.compare(0, 3, "../") != 0 && name.find("/../") == string::npos;
+}
+
+ZipStreamExtractor::ZipStreamExtractor(const string& destination, unsigned int threads)
+: _destination(destination)
+, _state(kLocalHeader)
+, _streamable(true)
+, _current(NULL)
+, _queuedBytes(0)
+, _extractedCount(0)
+, _quit(false)
+, _failed(false)
+, _busyWorkers(0)
+{
+    pthread_mutex_init(&_mutex, NULL);
+    pthread_cond_init(&_jobCondition, NULL);
+    pthread_cond_init(&_doneCondition, NULL);
+
+    for (unsigned int i = 0; i < threads; ++i)
+    {
+        pthread_t tid;
+        if (pthread_create(&tid, NULL, workerThread, this) == 0)
+        {
+            _threads.push_back(tid);
+        }
+    }
+}
+
+ZipStreamExtractor::~ZipStreamExtractor()
+{
+    pthread_mutex_lock(&_mutex);
+    _quit = true;
+    pthread_cond_broadcast(&_jobCondition);
+    pthread_mutex_unlock(&_mutex);
+
+    for (vector<pthread_t>::iterator it = _threads.begin(); it != _threads.end(); ++it)
+    {
+        pthread_join(*it, NULL);
+    }
+
+    for (list<Entry*>::iterator it = _jobs.begin(); it != _jobs.end(); ++it)
+    {
+        delete *it;
+    }
+    if (_current)
+    {
+        closeEntry(_current, false);
+        delete _current;
+    }
+
+    pthread_cond_destroy(&_doneCondition);
+    pthread_cond_destroy(&_jobCondition);
+    pthread_mutex_destroy(&_mutex);
+}
+
+bool ZipStreamExtractor::feed(const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        if (_state == kDone)
+        {
+            // the central directory isn't needed
+            return true;
+        }
+        if (_state == kError)
+        {
+            return false;
+        }
+
+        if (_state == kLocalHeader)
+        {
+            size_t needed = 4;
+            if (_header.size() >= 4)
+            {
+                unsigned long signature = readUInt32(&_header[0]);
+                if (signature != LOCAL_HEADER_SIGNATURE)
+                {
+                    if (signature == CENTRAL_HEADER_SIGNATURE
+                        || signature == END_OF_CENTRAL_DIR_SIGNATURE
+                        || signature == ZIP64_END_OF_CENTRAL_DIR_SIGNATURE)
+                    {
+                        _state = kDone;
+                    }
+                    else
+                    {
+                        CCLOG("unexpected zip signature 0x%08lx", signature);
+                        fail(false);
+                    }
+                    continue;
+                }
+
+                needed = LOCAL_HEADER_SIZE;
+                if (_header.size() >= LOCAL_HEADER_SIZE)
+                {
+                    needed += readUInt16(&_header[26]) + readUInt16(&_header[28]);
+                }
+            }
+
+            if (_header.size() < needed)
+            {
+                size_t count = min(size, needed - _header.size());
+                _header.insert(_header.end(), data, data + count);
+                data += count;
+                size -= count;
+            }
+
+            // the size may grow once the fixed part is known
+            if (_header.size() >= LOCAL_HEADER_SIZE
+                && _header.size() == LOCAL_HEADER_SIZE + readUInt16(&_header[26]) + readUInt16(&_header[28]))
+            {
+                if (! parseLocalHeader())
+                {
+                    continue;
+                }
+                _header.clear();
+            }
+        }
+        else if (_state == kFileData)
+        {
+            size_t count = min(size, (size_t)(_current->compressedSize - _current->received));
+            if (_current->streamed)
+            {
+                if (! writeEntry(_current, data, count))
+                {
+                    CCLOG("can not extract zip entry %s", _current->name.c_str());
+                    closeEntry(_current, false);
+                    delete _current;
+                    _current = NULL;
+                    fail(true);
+                    continue;
+                }
+            }
+            else
+            {
+                _current->data.insert(_current->data.end(), data, data + count);
+            }
+            _current->received += count;
+            data += count;
+            size -= count;
+
+            if (_current->received == _current->compressedSize)
+            {
+                Entry *entry = _current;
+                _current = NULL;
+                _state = kLocalHeader;
+                if (entry->streamed)
+                {
+                    entryDone(entry, closeEntry(entry, true));
+                    delete entry;
+                }
+                else
+                {
+                    submit(entry);
+                }
+            }
+        }
+    }
+
+    // an entry with no data has to be submitted without waiting for more bytes
+    if (_state == kFileData && _current->compressedSize == 0)
+    {
+        Entry *entry = _current;
+        _current = NULL;
+        _state = kLocalHeader;
+        submit(entry);
+    }
+
+    pthread_mutex_lock(&_mutex);
+    bool failed = _failed;
+    pthread_mutex_unlock(&_mutex);
+
+    return _state != kError && !failed;
+}
+
+bool ZipStreamExtractor::parseLocalHeader()
+{
+    const char *header = &_header[0];
+    unsigned int flags = readUInt16(header + 6);
+    unsigned int method = readUInt16(header + 8);
+    unsigned long compressedSize = readUInt32(header + 18);
+    unsigned long uncompressedSize = readUInt32(header + 22);
+    unsigned int nameLength = readUInt16(header + 26);
+
+    string name(header + LOCAL_HEADER_SIZE, nameLength);
+
+    if ((flags & (FLAG_ENCRYPTED | FLAG_DATA_DESCRIPTOR))
+        || (method != METHOD_STORED && method != METHOD_DEFLATED)
+        || compressedSize == 0xffffffff || uncompressedSize == 0xffffffff)
+    {
+        CCLOG("zip entry %s can't be extracted while downloading", name.c_str());
+        fail(false);
+        return false;
+    }
+
+    if (! isSafeEntryName(name))
+    {
+        CCLOG("invalid zip entry name %s", name.c_str());
+        fail(true);
+        return false;
+    }
+
+    if (name[name.size() - 1] == '/')
+    {
+        // Entry is a directory, so create it.
+        if (! createDirectories(_destination + name))
+        {
+            CCLOG("can not create directory %s", (_destination + name).c_str());
+            fail(true);
+            return false;
+        }
+        return true;
+    }
+
+    _current = new Entry();
+    _current->name = name;
+    _current->method = method;
+    _current->crc = readUInt32(header + 14);
+    _current->compressedSize = compressedSize;
+    _current->uncompressedSize = uncompressedSize;
+    _current->streamed = compressedSize > MAX_BUFFERED_ENTRY_SIZE;
+    _current->received = 0;
+    _current->out = NULL;
+    _current->inflating = false;
+    _state = kFileData;
+
+    if (! _current->streamed)
+    {
+        _current->data.reserve(compressedSize);
+    }
+    else if (! openEntry(_current))
+    {
+        delete _current;
+        _current = NULL;
+        fail(true);
+        return false;
+    }
+
+    return true;
+}
+
+void ZipStreamExtractor::submit(Entry *entry)
+{
+    if (_threads.empty())
+    {
+        entryDone(entry, extract(entry));
+        delete entry;
+        return;
+    }
+
+    pthread_mutex_lock(&_mutex);
+    // back pressure: don't keep more than MAX_QUEUED_BYTES waiting in memory
+    while (_queuedBytes > MAX_QUEUED_BYTES && !_failed)
+    {
+        pthread_cond_wait(&_doneCondition, &_mutex);
+    }
+    _queuedBytes += entry->compressedSize;
+    _jobs.push_back(entry);
+    pthread_cond_signal(&_jobCondition);
+    pthread_mutex_unlock(&_mutex);
+}
+
+bool ZipStreamExtractor::extract(Entry *entry)
+{
+    if (! openEntry(entry))
+    {
+        return false;
+    }
+
+    bool ok = entry->data.empty() || writeEntry(entry, &entry->data[0], entry->data.size());
+    return closeEntry(entry, ok);
+}
+
+bool ZipStreamExtractor::openEntry(Entry *entry)
+{
+    if (entry->method == METHOD_STORED && entry->compressedSize != entry->uncompressedSize)
+    {
+        CCLOG("invalid size of stored zip entry %s", entry->name.c_str());
+        return false;
+    }
+
+    string fullPath = _destination + entry->name;
+    if (! createDirectories(fullPath))
+    {
+        CCLOG("can not create directory for %s", fullPath.c_str());
+        return false;
+    }
+
+    entry->writtenCrc = crc32(0L, Z_NULL, 0);
+    entry->writtenSize = 0;
+    entry->inflated = false;
+    entry->inflating = false;
+    if (entry->method == METHOD_DEFLATED)
+    {
+        memset(&entry->stream, 0, sizeof(entry->stream));
+        // raw deflate data, no zlib header
+        if (inflateInit2(&entry->stream, -MAX_WBITS) != Z_OK)
+        {
+            return false;
+        }
+        entry->inflating = true;
+    }
+
+    entry->out = fopen(fullPath.c_str(), "wb");
+    if (! entry->out)
+    {
+        CCLOG("can not open destination file %s", fullPath.c_str());
+        closeEntry(entry, false);
+        return false;
+    }
+
+    return true;
+}
+
+bool ZipStreamExtractor::writeEntry(Entry *entry, const char *data, size_t size)
+{
+    if (entry->method == METHOD_STORED)
+    {
+        entry->writtenCrc = crc32(entry->writtenCrc, (const Bytef*)data, size);
+        entry->writtenSize += size;
+        return size == 0 || fwrite(data, size, 1, entry->out) == 1;
+    }
+
+    // inflate chunk by chunk, the entry is never held in memory
+    char buffer[BUFFER_SIZE];
+    entry->stream.next_in = (Bytef*)data;
+    entry->stream.avail_in = size;
+    while (entry->stream.avail_in > 0 && ! entry->inflated)
+    {
+        entry->stream.next_out = (Bytef*)buffer;
+        entry->stream.avail_out = BUFFER_SIZE;
+
+        int err = inflate(&entry->stream, Z_NO_FLUSH);
+        if (err != Z_OK && err != Z_STREAM_END)
+        {
+            CCLOG("can not inflate zip entry %s, error code is %d", entry->name.c_str(), err);
+            return false;
+        }
+        entry->inflated = (err == Z_STREAM_END);
+
+        size_t count = BUFFER_SIZE - entry->stream.avail_out;
+        entry->writtenSize += count;
+        if (entry->writtenSize > entry->uncompressedSize)
+        {
+            CCLOG("zip entry %s is larger than its declared size", entry->name.c_str());
+            return false;
+        }
+        entry->writtenCrc = crc32(entry->writtenCrc, (const Bytef*)buffer, count);
+        if (count > 0 && fwrite(buffer, count, 1, entry->out) != 1)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ZipStreamExtractor::closeEntry(Entry *entry, bool ok)
+{
+    if (entry->inflating)
+    {
+        inflateEnd(&entry->stream);
+        entry->inflating = false;
+        // an empty deflated entry may have no data at all
+        ok = ok && (entry->inflated || entry->uncompressedSize == 0);
+    }
+
+    if (entry->out)
+    {
+        ok = (fclose(entry->out) == 0) && ok;
+        entry->out = NULL;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (ok && entry->writtenSize != entry->uncompressedSize)
+    {
+        CCLOG("invalid size of zip entry %s", entry->name.c_str());
+        ok = false;
+    }
+    if (ok && entry->writtenCrc != entry->crc)
+    {
+        CCLOG("checksum mismatch for zip entry %s", entry->name.c_str());
+        ok = false;
+    }
+
+    if (! ok)
+    {
+        remove((_destination + entry->name).c_str());
+    }
+
+    return ok;
+}
+
+void ZipStreamExtractor::entryDone(Entry *entry, bool ok)
+{
+    pthread_mutex_lock(&_mutex);
+    if (ok)
+    {
+        ++_extractedCount;
+        _extractedFiles.push_back(entry->name);
+    }
+    else
+    {
+        _failed = true;
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+void ZipStreamExtractor::fail(bool streamable)
+{
+    _state = kError;
+    _streamable = _streamable && streamable;
+}
+
+bool ZipStreamExtractor::finish()
+{
+    // the stream may end right after the signature of the central directory
+    if (_state == kLocalHeader && _header.size() >= 4)
+    {
+        unsigned long signature = readUInt32(&_header[0]);
+        if (signature == CENTRAL_HEADER_SIGNATURE || signature == END_OF_CENTRAL_DIR_SIGNATURE)
+        {
+            _state = kDone;
+        }
+    }
+
+    pthread_mutex_lock(&_mutex);
+    while (!_jobs.empty() || _busyWorkers > 0)
+    {
+        pthread_cond_wait(&_doneCondition, &_mutex);
+    }
+    bool failed = _failed;
+    pthread_mutex_unlock(&_mutex);
+
+    return !failed && _state == kDone;
+}
+
+bool ZipStreamExtractor::isStreamable() const
+{
+    return _streamable;
+}
+
+unsigned int ZipStreamExtractor::getExtractedCount()
+{
+    pthread_mutex_lock(&_mutex);
+    unsigned int count = _extractedCount;
+    pthread_mutex_unlock(&_mutex);
+
+    return count;
+}
+
+vector<string> ZipStreamExtractor::getExtractedFiles()
+{
+    pthread_mutex_lock(&_mutex);
+    vector<string> files = _extractedFiles;
+    pthread_mutex_unlock(&_mutex);
+
+    return files;
+}
+
+void* ZipStreamExtractor::workerThread(void *data)
+{
+    ZipStreamExtractor *self = (ZipStreamExtractor*)data;
+
+    while (true)
+    {
+        pthread_mutex_lock(&self->_mutex);
+        while (self->_jobs.empty() && !self->_quit)
+        {
+            pthread_cond_wait(&self->_jobCondition, &self->_mutex);
+        }
+        if (self->_jobs.empty())
+        {
+            pthread_mutex_unlock(&self->_mutex);
+            break;
+        }
+
+        Entry *entry = self->_jobs.front();
+        self->_jobs.pop_front();
+        ++self->_busyWorkers;
+        bool skip = self->_failed;
+        pthread_mutex_unlock(&self->_mutex);
+
+        bool ok = skip || self->extract(entry);
+
+        pthread_mutex_lock(&self->_mutex);
+        --self->_busyWorkers;
+        self->_queuedBytes -= entry->compressedSize;
+        if (! ok)
+        {
+            self->_failed = true;
+        }
+        else if (! skip)
+        {
+            ++self->_extractedCount;
+            self->_extractedFiles.push_back(entry->name);
+        }
+        pthread_cond_broadcast(&self->_doneCondition);
+        pthread_mutex_unlock(&self->_mutex);
+
+        delete entry;
+    }
+
+    return NULL;
+}
+
+/*
+ * Create a direcotry is platform depended.
+ */
+static bool createDirectory(const char *path)
+{
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
+    mode_t processMask = umask(0);
+    int ret = mkdir(path, S_IRWXU | S_IRWXG | S_IRWXO);
+    umask(processMask);
+    if (ret != 0 && (errno != EEXIST))
+    {
+        return false;
+    }
+
+    return true;
+#else
+    BOOL ret = CreateDirectoryA(path, NULL);
+	if (!ret && ERROR_ALREADY_EXISTS != GetLastError())
+	{
+		return false;
+	}
+    return true;
+#endif
+}
+
+bool ZipStreamExtractor::createDirectories(const string& path)
+{
+    size_t pos = path.find('/', 1);
+    while (pos != string::npos)
+    {
+        if (! createDirectory(path.substr(0, pos).c_str()))
+        {
+            return false;
+        }
+        pos = path.find('/', pos + 1);
+    }
+
+    return true;
+}
+
+struct ExtractTask
+{
+    const string *zipFile;
+    const string *destination;
+    unsigned int index;
+    unsigned int count;
+    vector<string> files;
+    bool succeed;
+};
+
+// Extracts the entries i of the zip file with i % count == index
+static void* extractZipFileShare(void *data)
+{
+    ExtractTask *task = (ExtractTask*)data;
+    task->succeed = false;
+
+    unzFile zipfile = unzOpen(task->zipFile->c_str());
+    if (! zipfile)
+    {
+        CCLOG("can not open zip file %s", task->zipFile->c_str());
+        return NULL;
+    }
+
+    char readBuffer[BUFFER_SIZE];
+    bool ok = true;
+    unsigned int i = 0;
+    for (int err = unzGoToFirstFile(zipfile); ok && err == UNZ_OK; err = unzGoToNextFile(zipfile), ++i)
+    {
+        if (i % task->count != task->index)
+        {
+            continue;
+        }
+
+        unz_file_info fileInfo;
+        char fileName[MAX_FILENAME];
+        if (unzGetCurrentFileInfo(zipfile, &fileInfo, fileName, MAX_FILENAME, NULL, 0, NULL, 0) != UNZ_OK
+            || ! isSafeEntryName(fileName))
+        {
+            CCLOG("can not read file info");
+            ok = false;
+            break;
+        }
+
+        string fullPath = *task->destination + fileName;
+        if (! ZipStreamExtractor::createDirectories(fullPath))
+        {
+            CCLOG("can not create directory for %s", fullPath.c_str());
+            ok = false;
+            break;
+        }
+
+        if (fileName[strlen(fileName) - 1] == '/')
+        {
+            continue;
+        }
+
+        if (unzOpenCurrentFile(zipfile) != UNZ_OK)
+        {
+            CCLOG("can not open file %s", fileName);
+            ok = false;
+            break;
+        }
+
+        FILE *out = fopen(fullPath.c_str(), "wb");
+        if (! out)
+        {
+            CCLOG("can not open destination file %s", fullPath.c_str());
+            unzCloseCurrentFile(zipfile);
+            ok = false;
+            break;
+        }
+
+        int read = 0;
+        bool written = true;
+        while ((read = unzReadCurrentFile(zipfile, readBuffer, BUFFER_SIZE)) > 0)
+        {
+            written = written && fwrite(readBuffer, read, 1, out) == 1;
+        }
+        written = (fclose(out) == 0) && written;
+
+        // unzCloseCurrentFile checks the CRC32 of the entry
+        if (read < 0 || unzCloseCurrentFile(zipfile) != UNZ_OK || ! written)
+        {
+            CCLOG("can not read zip file %s, error code is %d", fileName, read);
+            ok = false;
+        }
+        else
+        {
+            task->files.push_back(fileName);
+        }
+    }
+
+    unzClose(zipfile);
+    task->succeed = ok;
+    return NULL;
+}
+
+bool ZipStreamExtractor::extractZipFile(const string& zipFile, const string& destination, unsigned int threads,
+                                        vector<string> *files)
+{
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+
+    vector<ExtractTask> tasks(threads);
+    vector<pthread_t> tids(threads);
+    for (unsigned int i = 0; i < threads; ++i)
+    {
+        tasks[i].zipFile = &zipFile;
+        tasks[i].destination = &destination;
+        tasks[i].index = i;
+        tasks[i].count = threads;
+        tasks[i].succeed = false;
+    }
+
+    // the calling thread extracts the first share
+    vector<bool> started(threads, false);
+    for (unsigned int i = 1; i < threads; ++i)
+    {
+        started[i] = (pthread_create(&tids[i], NULL, extractZipFileShare, &tasks[i]) == 0);
+        if (! started[i])
+        {
+            extractZipFileShare(&tasks[i]);
+        }
+    }
+    extractZipFileShare(&tasks[0]);
+
+    bool succeed = tasks[0].succeed;
+    for (unsigned int i = 1; i < threads; ++i)
+    {
+        if (started[i])
+        {
+            pthread_join(tids[i], NULL);
+        }
+        succeed = succeed && tasks[i].succeed;
+    }
+
+    if (files)
+    {
+        files->clear();
+        for (unsigned int i = 0; i < threads; ++i)
+        {
+            files->insert(files->end(), tasks[i].files.begin(), tasks[i].files.end());
+        }
+    }
+
+    return succeed;
+}
+
+NS_CC_EXT_END;
@@ -0,0 +1,162 @@
+/****************************************************************************
+ Copyright (c) 2013 cocos2d-x.org
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __ZipStreamExtractor__
+#define __ZipStreamExtractor__
+
+#include <string>
+#include <vector>
+#include <list>
+#include <pthread.h>
+#include <zlib.h>
+
+#include "cocos2d.h"
+#include "ExtensionMacros.h"
+
+NS_CC_EXT_BEGIN
+
+/*
+ *  Extracts a zip file while its bytes arrive, e.g. while it is downloaded.
+ *  The local headers of the zip file are parsed on the feeding thread, the
+ *  entries are inflated, checked against their CRC32 and written by a pool
+ *  of worker threads, so independent entries are extracted in parallel.
+ *  Large entries aren't kept in memory, they are inflated and written in
+ *  chunks on the feeding thread while their bytes arrive.
+ *
+ *  Entries using a data descriptor, encryption, zip64 or a compression
+ *  method other than stored/deflated can't be extracted on the fly; feed()
+ *  then returns false and isStreamable() is false, the caller should
+ *  extract the whole file once it is complete (see extractZipFile).
+ */
+class ZipStreamExtractor
+{
+public:
+    /* @param destination Directory to extract to, it should end with '/'.
+     * @param threads Number of worker threads.
+     */
+    ZipStreamExtractor(const std::string& destination, unsigned int threads);
+
+    /* Waits for the worker threads. */
+    ~ZipStreamExtractor();
+
+    /* @brief Feeds the next bytes of the zip file.
+     *        Blocks when too many entries are waiting to be written.
+     * @return false if the stream can't be extracted on the fly or failed.
+     */
+    bool feed(const char *data, size_t size);
+
+    /* @brief Waits until all entries are written.
+     * @return true if the whole zip file was received and extracted without error.
+     */
+    bool finish();
+
+    /* @brief Returns false if the zip file uses a feature that prevents extracting on the fly.
+     */
+    bool isStreamable() const;
+
+    /* @brief Number of files extracted so far.
+     */
+    unsigned int getExtractedCount();
+
+    /* @brief Relative paths of the files extracted so far.
+     */
+    std::vector<std::string> getExtractedFiles();
+
+    /* @brief Extracts a complete zip file with several threads.
+     *        Each thread opens its own handle and extracts a share of the entries.
+     * @param files If not NULL, receives the relative paths of the extracted files.
+     */
+    static bool extractZipFile(const std::string& zipFile, const std::string& destination, unsigned int threads,
+                               std::vector<std::string> *files = NULL);
+
+    /* @brief Creates the directories of a path, the last component is considered a file name
+     *        unless the path ends with '/'.
+     */
+    static bool createDirectories(const std::string& path);
+
+private:
+    enum State
+    {
+        kLocalHeader,
+        kFileData,
+        kDone,
+        kError,
+    };
+
+    struct Entry
+    {
+        std::string name;
+        unsigned int method;
+        unsigned long crc;
+        unsigned long compressedSize;
+        unsigned long uncompressedSize;
+        // compressed bytes, unless the entry is written while it arrives
+        std::vector<char> data;
+        bool streamed;
+        unsigned long received;
+
+        // state of the destination file
+        FILE *out;
+        z_stream stream;
+        bool inflating;
+        bool inflated;
+        uLong writtenCrc;
+        unsigned long writtenSize;
+    };
+
+    bool parseLocalHeader();
+    void submit(Entry *entry);
+    bool extract(Entry *entry);
+    bool openEntry(Entry *entry);
+    bool writeEntry(Entry *entry, const char *data, size_t size);
+    bool closeEntry(Entry *entry, bool ok);
+    void entryDone(Entry *entry, bool ok);
+    void fail(bool streamable);
+
+    static void* workerThread(void *data);
+
+    std::string _destination;
+    State _state;
+    bool _streamable;
+
+    // bytes of the current header that are not parsed yet
+    std::vector<char> _header;
+    Entry *_current;
+
+    std::vector<pthread_t> _threads;
+    std::list<Entry*> _jobs;
+    size_t _queuedBytes;
+    unsigned int _extractedCount;
+    std::vector<std::string> _extractedFiles;
+    bool _quit;
+    bool _failed;
+    pthread_mutex_t _mutex;
+    pthread_cond_t _jobCondition;
+    pthread_cond_t _doneCondition;
+    unsigned int _busyWorkers;
+};
+
+NS_CC_EXT_END;
+
+#endif /* defined(__ZipStreamExtractor__) */
@@ -51,6 +51,16 @@ namespace cs {
             cReader.parse(strValue, _value, false);
         }
     }
+
+    void CSJsonDictionary::initWithDescription(const char *pszDescription, size_t length)
+    {
+        CSJson::Reader cReader;
+        _value.clear();
+        if (pszDescription && length > 0)
+        {
+            cReader.parse(pszDescription, pszDescription + length, _value, false);
+        }
+    }
     
     
     void CSJsonDictionary::initWithValue(CSJson::Value& value)
@@ -54,6 +54,7 @@ namespace cs {
 
     public:
         void    initWithDescription(const char *pszDescription);
+        void    initWithDescription(const char *pszDescription, size_t length);
         void    insertItem(const char *pszKey, int nValue);
         void    insertItem(const char *pszKey, double fValue);
         void    insertItem(const char *pszKey, const char * pszValue);
@@ -188,12 +188,12 @@ void CCDataReaderHelper::addDataFromXML(const char *xmlPath)
     /*
     *  Need to read the tiny xml into memory first, or the Tiny XML can't find the xml at IOS
     */
-    unsigned long size;
-    const char *pFileContent = (char *)CCFileUtils::sharedFileUtils()->getFileData(fullPath.c_str() , "r", &size);
+    CCFileView *pView = CCFileUtils::sharedFileUtils()->openFileView(fullPath.c_str());
 
-    if (pFileContent)
+    if (pView)
     {
-        addDataFromCache(pFileContent);
+        addDataFromCache((const char *)pView->getBytes(), pView->getSize());
+        pView->release();
     }
 }
 
@@ -212,9 +212,14 @@ void CCDataReaderHelper::addDataFromXMLPak(const char *xmlPakPath)
 }
 
 void CCDataReaderHelper::addDataFromCache(const char *pFileContent)
+{
+    addDataFromCache(pFileContent, strlen(pFileContent));
+}
+
+void CCDataReaderHelper::addDataFromCache(const char *pFileContent, size_t length)
 {
     tinyxml2::XMLDocument document;
-    document.Parse(pFileContent);
+    document.Parse(pFileContent, length);
 
     tinyxml2::XMLElement *root = document.RootElement();
     CCAssert(root, "XML error  or  XML is empty.");
@@ -798,17 +803,25 @@ CCContourData *CCDataReaderHelper::decodeContour(tinyxml2::XMLElement *contourXM
 
 void CCDataReaderHelper::addDataFromJson(const char *filePath)
 {
-    unsigned long size;
     std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(filePath);
-    const char *pFileContent = (char *)CCFileUtils::sharedFileUtils()->getFileData(fullPath.c_str() , "r", &size);
+    CCFileView *pView = CCFileUtils::sharedFileUtils()->openFileView(fullPath.c_str());
 
-    addDataFromJsonCache(pFileContent);
+    if (pView)
+    {
+        addDataFromJsonCache((const char *)pView->getBytes(), pView->getSize());
+        pView->release();
+    }
 }
 
 void CCDataReaderHelper::addDataFromJsonCache(const char *fileContent)
+{
+    addDataFromJsonCache(fileContent, strlen(fileContent));
+}
+
+void CCDataReaderHelper::addDataFromJsonCache(const char *fileContent, size_t contentLength)
 {
     cs::CSJsonDictionary json;
-    json.initWithDescription(fileContent);
+    json.initWithDescription(fileContent, contentLength);
 
     // Decode armatures
     int length = json.getArrayItemCount(ARMATURE_DATA);
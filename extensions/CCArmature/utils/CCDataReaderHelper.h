@@ -75,6 +75,11 @@ public:
      * @param xmlPath The cache of the xml
      */
     static void addDataFromCache(const char *pFileContent);
+    /**
+     * @param length The length of the xml, which doesn't need to be NUL terminated
+     * @since v3.0
+     */
+    static void addDataFromCache(const char *pFileContent, size_t length);
 
 
 
@@ -109,6 +114,8 @@ public:
 
     static void addDataFromJson(const char *filePath);
     static void addDataFromJsonCache(const char *fileContent);
+    /** @since v3.0 */
+    static void addDataFromJsonCache(const char *fileContent, size_t contentLength);
 
     static CCArmatureData *decodeArmature(cs::CSJsonDictionary &json);
     static CCBoneData *decodeBone(cs::CSJsonDictionary &json);
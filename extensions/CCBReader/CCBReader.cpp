@@ -248,11 +248,13 @@ CCNode* CCBReader::readNodeGraphFromFile(const char *pCCBFileName, CCObject *pOw
     }
 
     std::string strPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(strCCBFileName.c_str());
-    unsigned long size = 0;
 
-    unsigned char * pBytes = CCFileUtils::sharedFileUtils()->getFileData(strPath.c_str(), "rb", &size);
-    CCData *data = new CCData(pBytes, size);
-    CC_SAFE_DELETE_ARRAY(pBytes);
+    // the reader keeps the view until it is released, the nodes are read directly from the mapped file
+    CCFileView *data = CCFileUtils::sharedFileUtils()->openFileView(strPath.c_str());
+    if (data == NULL)
+    {
+        return NULL;
+    }
 
     CCNode *ret =  this->readNodeGraphFromData(data, pOwner, parentSize);
     
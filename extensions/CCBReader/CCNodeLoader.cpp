@@ -866,15 +866,15 @@ CCNode * CCNodeLoader::parsePropTypeCCBFile(CCNode * pNode, CCNode * pParent, CC
     
     // Load sub file
     std::string path = CCFileUtils::sharedFileUtils()->fullPathForFilename(ccbFileName.c_str());
-    unsigned long size = 0;
-    unsigned char * pBytes = CCFileUtils::sharedFileUtils()->getFileData(path.c_str(), "rb", &size);
+    CCFileView *data = CCFileUtils::sharedFileUtils()->openFileView(path.c_str());
+    if (data == NULL)
+    {
+        return NULL;
+    }
 
     CCBReader * ccbReader = new CCBReader(pCCBReader);
     ccbReader->autorelease();
     ccbReader->getAnimationManager()->setRootContainerSize(pParent->getContentSize());
-    
-    CCData *data = new CCData(pBytes, size);
-    CC_SAFE_DELETE_ARRAY(pBytes);
 
     data->retain();
     ccbReader->mData = data;
@@ -97,7 +97,12 @@ CCControl::~CCControl()
     //Menu - Events
 void CCControl::registerWithTouchDispatcher()
 {
-    CCDirector::sharedDirector()->getTouchDispatcher()->addTargetedDelegate(this, getTouchPriority(), true);
+    CCTouchDispatcher* pDispatcher = CCDirector::sharedDirector()->getTouchDispatcher();
+    pDispatcher->addTargetedDelegate(this, getTouchPriority(), true);
+    if (hasBoundedTouchArea())
+    {
+        pDispatcher->setHitTestNode(this, this);
+    }
 }
 
 void CCControl::onEnter()
@@ -267,6 +272,11 @@ bool CCControl::isTouchInside(CCTouch* touch)
     return bBox.containsPoint(touchLocation);
 }
 
+bool CCControl::hasBoundedTouchArea()
+{
+    return false;
+}
+
 CCArray* CCControl::dispatchListforControlEvent(CCControlEvent controlEvent)
 {
     CCArray* invocationList = (CCArray*)_dispatchTable->objectForKey(controlEvent);
@@ -194,6 +194,15 @@ public:
     */
     virtual bool isTouchInside(CCTouch * touch);
 
+    /**
+    * Returns whether the control only claims the touches that begin inside its
+    * bounding box. The touch dispatcher then doesn't ask it about the other
+    * touches, see CCTouchDispatcher::setHitTestNode. Subclasses that accept
+    * touches outside of the bounding box must return false. Default: false.
+    * @since v3.0
+    */
+    virtual bool hasBoundedTouchArea();
+
 
 protected:
     /**
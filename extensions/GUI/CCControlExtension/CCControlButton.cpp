@@ -631,6 +631,12 @@ void CCControlButton::needsLayout()
 
 
 
+bool CCControlButton::hasBoundedTouchArea()
+{
+    // ccTouchBegan returns false when isTouchInside does
+    return true;
+}
+
 bool CCControlButton::ccTouchBegan(CCTouch *pTouch, CCEvent *pEvent)
 {
     if (!isTouchInside(pTouch) || !isEnabled() || !isVisible() || !hasVisibleParents() )
@@ -135,6 +135,7 @@ public:
     static CCControlButton* create(CCScale9Sprite* sprite);
     
     //events
+    virtual bool hasBoundedTouchArea();
     virtual bool ccTouchBegan(CCTouch *pTouch, CCEvent *pEvent);
     virtual void ccTouchMoved(CCTouch *pTouch, CCEvent *pEvent);
     virtual void ccTouchEnded(CCTouch *pTouch, CCEvent *pEvent);
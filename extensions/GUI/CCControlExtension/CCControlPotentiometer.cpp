@@ -177,6 +177,12 @@ bool CCControlPotentiometer::isTouchInside(CCTouch * touch)
     return distance < MIN(getContentSize().width / 2, getContentSize().height / 2);
 }
 
+bool CCControlPotentiometer::hasBoundedTouchArea()
+{
+    // ccTouchBegan returns false when isTouchInside does
+    return true;
+}
+
 bool CCControlPotentiometer::ccTouchBegan(CCTouch *pTouch, CCEvent *pEvent)
 {
     if (!this->isTouchInside(pTouch) || !this->isEnabled() || !isVisible())
@@ -69,6 +69,7 @@ public:
 
     virtual bool isTouchInside(CCTouch * touch);
 
+    virtual bool hasBoundedTouchArea();
     virtual bool ccTouchBegan(CCTouch *pTouch, CCEvent *pEvent);
     virtual void ccTouchMoved(CCTouch *pTouch, CCEvent *pEvent);
     virtual void ccTouchEnded(CCTouch *pTouch, CCEvent *pEvent);
@@ -274,6 +274,12 @@ void CCControlStepper::updateLayoutUsingTouchLocation(CCPoint location)
 }
 
 
+bool CCControlStepper::hasBoundedTouchArea()
+{
+    // ccTouchBegan returns false when isTouchInside does
+    return true;
+}
+
 bool CCControlStepper::ccTouchBegan(CCTouch *pTouch, CCEvent *pEvent)
 {
     if (!isTouchInside(pTouch) || !isEnabled() || !isVisible())
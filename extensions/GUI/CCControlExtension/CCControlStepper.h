@@ -65,6 +65,7 @@ public:
     void update(float dt);
 
     //events
+    virtual bool hasBoundedTouchArea();
     virtual bool ccTouchBegan(CCTouch *pTouch, CCEvent *pEvent);
     virtual void ccTouchMoved(CCTouch *pTouch, CCEvent *pEvent);
     virtual void ccTouchEnded(CCTouch *pTouch, CCEvent *pEvent);
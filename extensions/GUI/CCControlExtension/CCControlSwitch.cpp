@@ -387,6 +387,12 @@ CCPoint CCControlSwitch::locationFromTouch(CCTouch* pTouch)
     return touchLocation;
 }
 
+bool CCControlSwitch::hasBoundedTouchArea()
+{
+    // ccTouchBegan returns false when isTouchInside does
+    return true;
+}
+
 bool CCControlSwitch::ccTouchBegan(CCTouch *pTouch, CCEvent *pEvent)
 {
     if (!isTouchInside(pTouch) || !isEnabled() || !isVisible())
@@ -81,6 +81,7 @@ public:
 
     CCPoint locationFromTouch(CCTouch* touch);
     //events
+    virtual bool hasBoundedTouchArea();
     virtual bool ccTouchBegan(CCTouch *pTouch, CCEvent *pEvent);
     virtual void ccTouchMoved(CCTouch *pTouch, CCEvent *pEvent);
     virtual void ccTouchEnded(CCTouch *pTouch, CCEvent *pEvent);
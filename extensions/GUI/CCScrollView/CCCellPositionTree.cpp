@@ -0,0 +1,319 @@
+/****************************************************************************
+ Copyright (c) 2013 cocos2d-x.org
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "CCCellPositionTree.h"
+#include "ccMacros.h"
+
+NS_CC_EXT_BEGIN
+
+CCCellPositionTree::CCCellPositionTree()
+: _root(0)
+, _seed(0x9e3779b9)
+{
+    Node empty = { 0, 0, 0, 0, 0.0f, 0.0f, false };
+    _nodes.push_back(empty);
+}
+
+void CCCellPositionTree::reset(unsigned int count, float estimatedSize)
+{
+    _nodes.resize(1);
+    _freeNodes.clear();
+    _nodes.reserve(count + 1);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        newNode(estimatedSize, false);
+    }
+    build(count);
+}
+
+void CCCellPositionTree::reset(const std::vector<float>& sizes)
+{
+    _nodes.resize(1);
+    _freeNodes.clear();
+    _nodes.reserve(sizes.size() + 1);
+    for (std::vector<float>::const_iterator it = sizes.begin(); it != sizes.end(); ++it)
+    {
+        newNode(*it, true);
+    }
+    build(sizes.size());
+}
+
+void CCCellPositionTree::build(unsigned int count)
+{
+    // Nodes 1..count are in cell order: build the treap in one pass with the
+    // right spine on a stack. A node leaves the stack once its subtree is
+    // complete, so the sums are computed children first.
+    std::vector<unsigned int> spine;
+    for (unsigned int i = 1; i <= count; ++i)
+    {
+        unsigned int last = 0;
+        while (!spine.empty() && _nodes[spine.back()].priority < _nodes[i].priority)
+        {
+            last = spine.back();
+            spine.pop_back();
+            update(last);
+        }
+        _nodes[i].left = last;
+        if (!spine.empty())
+        {
+            _nodes[spine.back()].right = i;
+        }
+        spine.push_back(i);
+    }
+
+    for (std::vector<unsigned int>::reverse_iterator it = spine.rbegin(); it != spine.rend(); ++it)
+    {
+        update(*it);
+    }
+    _root = spine.empty() ? 0 : spine.front();
+}
+
+unsigned int CCCellPositionTree::newNode(float size, bool measured)
+{
+    Node node = { 0, 0, nextPriority(), 1, size, size, measured };
+    if (!_freeNodes.empty())
+    {
+        unsigned int index = _freeNodes.back();
+        _freeNodes.pop_back();
+        _nodes[index] = node;
+        return index;
+    }
+    _nodes.push_back(node);
+    return _nodes.size() - 1;
+}
+
+unsigned int CCCellPositionTree::nextPriority()
+{
+    // xorshift32
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+void CCCellPositionTree::update(unsigned int node)
+{
+    Node& n = _nodes[node];
+    const Node& left = _nodes[n.left];
+    const Node& right = _nodes[n.right];
+    n.count = left.count + right.count + 1;
+    n.sum = left.sum + n.size + right.sum;
+}
+
+unsigned int CCCellPositionTree::findNode(unsigned int idx) const
+{
+    CCAssert(idx < getCount(), "Invalid cell index");
+
+    unsigned int node = _root;
+    while (node)
+    {
+        const Node& n = _nodes[node];
+        unsigned int leftCount = _nodes[n.left].count;
+        if (idx < leftCount)
+        {
+            node = n.left;
+        }
+        else if (idx == leftCount)
+        {
+            break;
+        }
+        else
+        {
+            idx -= leftCount + 1;
+            node = n.right;
+        }
+    }
+    return node;
+}
+
+float CCCellPositionTree::getSize(unsigned int idx) const
+{
+    return _nodes[findNode(idx)].size;
+}
+
+bool CCCellPositionTree::isMeasured(unsigned int idx) const
+{
+    return _nodes[findNode(idx)].measured;
+}
+
+void CCCellPositionTree::setSize(unsigned int idx, float size)
+{
+    CCAssert(idx < getCount(), "Invalid cell index");
+    setSize(_root, idx, size);
+}
+
+void CCCellPositionTree::setSize(unsigned int node, unsigned int idx, float size)
+{
+    Node& n = _nodes[node];
+    unsigned int leftCount = _nodes[n.left].count;
+    if (idx < leftCount)
+    {
+        setSize(n.left, idx, size);
+    }
+    else if (idx == leftCount)
+    {
+        n.size = size;
+        n.measured = true;
+    }
+    else
+    {
+        setSize(n.right, idx - leftCount - 1, size);
+    }
+    update(node);
+}
+
+float CCCellPositionTree::getPosition(unsigned int idx) const
+{
+    CCAssert(idx <= getCount(), "Invalid cell index");
+
+    float position = 0.0f;
+    unsigned int node = _root;
+    while (node)
+    {
+        const Node& n = _nodes[node];
+        unsigned int leftCount = _nodes[n.left].count;
+        if (idx < leftCount)
+        {
+            node = n.left;
+        }
+        else if (idx == leftCount)
+        {
+            return position + _nodes[n.left].sum;
+        }
+        else
+        {
+            position += _nodes[n.left].sum + n.size;
+            idx -= leftCount + 1;
+            node = n.right;
+        }
+    }
+    return position;
+}
+
+int CCCellPositionTree::getIndex(float position) const
+{
+    if (_root == 0 || position > getTotalSize())
+    {
+        return -1;
+    }
+
+    unsigned int base = 0;
+    unsigned int node = _root;
+    while (true)
+    {
+        const Node& n = _nodes[node];
+        const Node& left = _nodes[n.left];
+        if (n.left && position <= left.sum)
+        {
+            node = n.left;
+            continue;
+        }
+
+        position -= left.sum;
+        base += left.count;
+        // the last test absorbs the rounding of the sums
+        if (position <= n.size || n.right == 0)
+        {
+            return base;
+        }
+        position -= n.size;
+        base += 1;
+        node = n.right;
+    }
+}
+
+void CCCellPositionTree::insert(unsigned int idx, float size, bool measured)
+{
+    CCAssert(idx <= getCount(), "Invalid cell index");
+
+    unsigned int node = newNode(size, measured);
+    unsigned int left, right;
+    split(_root, idx, &left, &right);
+    _root = merge(merge(left, node), right);
+}
+
+void CCCellPositionTree::remove(unsigned int idx)
+{
+    CCAssert(idx < getCount(), "Invalid cell index");
+
+    unsigned int left, middle, right;
+    split(_root, idx, &left, &right);
+    split(right, 1, &middle, &right);
+    _freeNodes.push_back(middle);
+    _root = merge(left, right);
+}
+
+void CCCellPositionTree::split(unsigned int node, unsigned int count, unsigned int* left, unsigned int* right)
+{
+    if (node == 0)
+    {
+        *left = *right = 0;
+        return;
+    }
+
+    unsigned int leftCount = _nodes[_nodes[node].left].count;
+    unsigned int a, b;
+    if (count <= leftCount)
+    {
+        split(_nodes[node].left, count, &a, &b);
+        _nodes[node].left = b;
+        update(node);
+        *left = a;
+        *right = node;
+    }
+    else
+    {
+        split(_nodes[node].right, count - leftCount - 1, &a, &b);
+        _nodes[node].right = a;
+        update(node);
+        *left = node;
+        *right = b;
+    }
+}
+
+unsigned int CCCellPositionTree::merge(unsigned int left, unsigned int right)
+{
+    if (left == 0 || right == 0)
+    {
+        return left ? left : right;
+    }
+
+    if (_nodes[left].priority > _nodes[right].priority)
+    {
+        unsigned int merged = merge(_nodes[left].right, right);
+        _nodes[left].right = merged;
+        update(left);
+        return left;
+    }
+    else
+    {
+        unsigned int merged = merge(left, _nodes[right].left);
+        _nodes[right].left = merged;
+        update(right);
+        return right;
+    }
+}
+
+NS_CC_EXT_END
@@ -0,0 +1,108 @@
+/****************************************************************************
+ Copyright (c) 2013 cocos2d-x.org
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CCCELLPOSITIONTREE_H__
+#define __CCCELLPOSITIONTREE_H__
+
+#include "ExtensionMacros.h"
+#include <vector>
+
+NS_CC_EXT_BEGIN
+
+/**
+ * Positions of the cells of a table view along its scroll direction.
+ *
+ * The cell extents are kept in a balanced tree (an implicit treap) whose nodes
+ * hold the sum of their subtree, so the position of a cell, the cell at a
+ * position, changing the extent of a cell and inserting or removing a cell
+ * all take O(log n).
+ *
+ * A cell may be unmeasured: it then uses an estimated extent until setSize()
+ * is called with its real one.
+ *
+ * @since v3.0
+ */
+class CCCellPositionTree
+{
+public:
+    CCCellPositionTree();
+
+    /** Replaces all the cells with count unmeasured cells of the given extent. O(n). */
+    void reset(unsigned int count, float estimatedSize);
+    /** Replaces all the cells with measured cells of the given extents. O(n). */
+    void reset(const std::vector<float>& sizes);
+
+    unsigned int getCount() const { return _nodes[_root].count; }
+    /** Sum of the extents of all the cells. */
+    float getTotalSize() const { return _nodes[_root].sum; }
+
+    float getSize(unsigned int idx) const;
+    bool isMeasured(unsigned int idx) const;
+    /** Changes the extent of a cell and marks it as measured. */
+    void setSize(unsigned int idx, float size);
+
+    /** Start of a cell. Passing getCount() returns getTotalSize(). */
+    float getPosition(unsigned int idx) const;
+    /**
+     * Index of the cell containing a position, the first one when the position
+     * is on the border of two cells. Positions before the first cell return 0.
+     *
+     * @return the index, or -1 if the position is after the last cell
+     */
+    int getIndex(float position) const;
+
+    void insert(unsigned int idx, float size, bool measured);
+    void remove(unsigned int idx);
+
+private:
+    struct Node
+    {
+        unsigned int left;
+        unsigned int right;
+        unsigned int priority;
+        unsigned int count;
+        float size;
+        float sum;
+        bool measured;
+    };
+
+    unsigned int newNode(float size, bool measured);
+    unsigned int nextPriority();
+    void update(unsigned int node);
+    void build(unsigned int count);
+    unsigned int findNode(unsigned int idx) const;
+    void setSize(unsigned int node, unsigned int idx, float size);
+    void split(unsigned int node, unsigned int count, unsigned int* left, unsigned int* right);
+    unsigned int merge(unsigned int left, unsigned int right);
+
+    // node 0 is the empty tree
+    std::vector<Node> _nodes;
+    std::vector<unsigned int> _freeNodes;
+    unsigned int _root;
+    unsigned int _seed;
+};
+
+NS_CC_EXT_END
+
+#endif /* __CCCELLPOSITIONTREE_H__ */
@@ -54,9 +54,7 @@ bool CCTableView::initWithViewSize(CCSize size, CCNode* container/* = NULL*/)
 {
     if (CCScrollView::initWithViewSize(size,container))
     {
-        _cellsUsed      = new CCArrayForObjectSorting();
         _cellsFreed     = new CCArrayForObjectSorting();
-        _indices        = new std::set<unsigned int>();
         _vordering      = kCCTableViewFillBottomUp;
         this->setDirection(kCCScrollViewDirectionVertical);
 
@@ -68,20 +66,29 @@ bool CCTableView::initWithViewSize(CCSize size, CCNode* container/* = NULL*/)
 
 CCTableView::CCTableView()
 : _touchedCell(NULL)
-, _indices(NULL)
-, _cellsUsed(NULL)
 , _cellsFreed(NULL)
 , _dataSource(NULL)
 , _tableViewDelegate(NULL)
 , _oldDirection(kCCScrollViewDirectionNone)
+, _estimatedCellSize(CCSizeZero)
+, _anchorIdx(0)
+, _anchorShift(0.0f)
+, _cellPositionsChanged(false)
+, _prefetchCount(0)
+, _lastStartIdx(0)
+, _prefetchForward(true)
+, _prefetchStartIdx(CC_INVALID_INDEX)
+, _prefetchEndIdx(CC_INVALID_INDEX)
 {
 
 }
 
 CCTableView::~CCTableView()
 {
-    CC_SAFE_DELETE(_indices);
-    CC_SAFE_RELEASE(_cellsUsed);
+    for (std::unordered_map<unsigned int, CCTableViewCell*>::iterator it = _cellsUsed.begin(); it != _cellsUsed.end(); ++it)
+    {
+        it->second->release();
+    }
     CC_SAFE_RELEASE(_cellsFreed);
 }
 
@@ -89,7 +96,7 @@ void CCTableView::setVerticalFillOrder(CCTableViewVerticalFillOrder fillOrder)
 {
     if (_vordering != fillOrder) {
         _vordering = fillOrder;
-        if (_cellsUsed->count() > 0) {
+        if (!_cellsUsed.empty()) {
             this->reloadData();
         }
     }
@@ -100,13 +107,33 @@ CCTableViewVerticalFillOrder CCTableView::getVerticalFillOrder()
     return _vordering;
 }
 
+void CCTableView::setEstimatedCellSize(const CCSize& size)
+{
+    _estimatedCellSize = size;
+}
+
+const CCSize& CCTableView::getEstimatedCellSize() const
+{
+    return _estimatedCellSize;
+}
+
+void CCTableView::setPrefetchCount(unsigned int count)
+{
+    _prefetchCount = count;
+    _prefetchStartIdx = _prefetchEndIdx = CC_INVALID_INDEX;
+}
+
+unsigned int CCTableView::getPrefetchCount() const
+{
+    return _prefetchCount;
+}
+
 void CCTableView::reloadData()
 {
     _oldDirection = kCCScrollViewDirectionNone;
-    CCObject* pObj = NULL;
-    CCARRAY_FOREACH(_cellsUsed, pObj)
+    for (std::unordered_map<unsigned int, CCTableViewCell*>::iterator it = _cellsUsed.begin(); it != _cellsUsed.end(); ++it)
     {
-        CCTableViewCell* cell = (CCTableViewCell*)pObj;
+        CCTableViewCell* cell = it->second;
 
         if(_tableViewDelegate != NULL) {
             _tableViewDelegate->tableCellWillRecycle(this, cell);
@@ -118,11 +145,12 @@ void CCTableView::reloadData()
         {
             this->getContainer()->removeChild(cell, true);
         }
+        cell->release();
     }
+    _cellsUsed.clear();
 
-    _indices->clear();
-    _cellsUsed->release();
-    _cellsUsed = new CCArrayForObjectSorting();
+    _lastStartIdx = 0;
+    _prefetchStartIdx = _prefetchEndIdx = CC_INVALID_INDEX;
 
     this->_updateCellPositions();
     this->_updateContentSize();
@@ -134,14 +162,8 @@ void CCTableView::reloadData()
 
 CCTableViewCell *CCTableView::cellAtIndex(unsigned int idx)
 {
-    CCTableViewCell *found = NULL;
-
-    if (_indices->find(idx) != _indices->end())
-    {
-        found = (CCTableViewCell *)_cellsUsed->objectWithObjectID(idx);
-    }
-
-    return found;
+    std::unordered_map<unsigned int, CCTableViewCell*>::iterator it = _cellsUsed.find(idx);
+    return it != _cellsUsed.end() ? it->second : NULL;
 }
 
 void CCTableView::updateCellAtIndex(unsigned int idx)
@@ -162,6 +184,7 @@ void CCTableView::updateCellAtIndex(unsigned int idx)
         this->_moveCellOutOfSight(cell);
     }
     cell = _dataSource->tableCellAtIndex(this, idx);
+    this->_measureCellIfNecessary(idx);
     this->_setIndexForCell(idx, cell);
     this->_addCellIfNecessary(cell);
 }
@@ -179,29 +202,27 @@ void CCTableView::insertCellAtIndex(unsigned  int idx)
         return;
     }
 
-    CCTableViewCell* cell = NULL;
-    int newIdx = 0;
+    this->_shiftCellIndices(idx, 1);
 
-    cell = (CCTableViewCell*)_cellsUsed->objectWithObjectID(idx);
-    if (cell)
+    if (_estimatedCellSize.equals(CCSizeZero))
     {
-        newIdx = _cellsUsed->indexOfSortedObject(cell);
-        for (unsigned int i=newIdx; i<_cellsUsed->count(); i++)
-        {
-            cell = (CCTableViewCell*)_cellsUsed->objectAtIndex(i);
-            this->_setIndexForCell(cell->getIdx()+1, cell);
-        }
+        _cellPositions.insert(idx, this->_measureCell(idx), true);
+    }
+    else
+    {
+        float estimate = (this->getDirection() == kCCScrollViewDirectionHorizontal) ? _estimatedCellSize.width : _estimatedCellSize.height;
+        _cellPositions.insert(idx, estimate, false);
     }
 
- //   [_indices shiftIndexesStartingAtIndex:idx by:1];
-
-    //insert a new cell
-    cell = _dataSource->tableCellAtIndex(this, idx);
-    this->_setIndexForCell(idx, cell);
-    this->_addCellIfNecessary(cell);
+    if (_cellPositions.getCount() != uCountOfItems)
+    {
+        // the data source was changed by more than this cell
+        this->_updateCellPositions();
+    }
 
-    this->_updateCellPositions();
     this->_updateContentSize();
+    this->_relayoutCells();
+    this->_updateVisibleCells();
 }
 
 void CCTableView::removeCellAtIndex(unsigned int idx)
@@ -211,33 +232,29 @@ void CCTableView::removeCellAtIndex(unsigned int idx)
         return;
     }
 
-    unsigned int uCountOfItems = _dataSource->numberOfCellsInTableView(this);
-    if (0 == uCountOfItems || idx > uCountOfItems-1)
+    if (idx >= _cellPositions.getCount())
     {
         return;
     }
 
-    unsigned int newIdx = 0;
-
     CCTableViewCell* cell = this->cellAtIndex(idx);
-    if (!cell)
+    if (cell)
     {
-        return;
+        this->_moveCellOutOfSight(cell);
     }
 
-    newIdx = _cellsUsed->indexOfSortedObject(cell);
-
-    //remove first
-    this->_moveCellOutOfSight(cell);
+    this->_shiftCellIndices(idx + 1, -1);
+    _cellPositions.remove(idx);
 
-    _indices->erase(idx);
-    this->_updateCellPositions();
-//    [_indices shiftIndexesStartingAtIndex:idx+1 by:-1];
-    for (unsigned int i=_cellsUsed->count()-1; i > newIdx; i--)
+    if (_cellPositions.getCount() != _dataSource->numberOfCellsInTableView(this))
     {
-        cell = (CCTableViewCell*)_cellsUsed->objectAtIndex(i);
-        this->_setIndexForCell(cell->getIdx()-1, cell);
+        // the data source was changed by more than this cell
+        this->_updateCellPositions();
     }
+
+    this->_updateContentSize();
+    this->_relayoutCells();
+    this->_updateVisibleCells();
 }
 
 CCTableViewCell *CCTableView::dequeueCell()
@@ -261,9 +278,45 @@ void CCTableView::_addCellIfNecessary(CCTableViewCell * cell)
     {
         this->getContainer()->addChild(cell);
     }
-    _cellsUsed->insertSortedObject(cell);
-    _indices->insert(cell->getIdx());
-    // [_indices addIndex:cell.idx];
+    CCTableViewCell*& used = _cellsUsed[cell->getIdx()];
+    if (used != cell)
+    {
+        cell->retain();
+        CC_SAFE_RELEASE(used);
+        used = cell;
+    }
+}
+
+void CCTableView::_shiftCellIndices(unsigned int fromIdx, int delta)
+{
+    std::vector<CCTableViewCell*> shifted;
+    for (std::unordered_map<unsigned int, CCTableViewCell*>::iterator it = _cellsUsed.begin(); it != _cellsUsed.end();)
+    {
+        if (it->first >= fromIdx)
+        {
+            shifted.push_back(it->second);
+            it = _cellsUsed.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (std::vector<CCTableViewCell*>::iterator it = shifted.begin(); it != shifted.end(); ++it)
+    {
+        CCTableViewCell* cell = *it;
+        cell->setIdx(cell->getIdx() + delta);
+        _cellsUsed[cell->getIdx()] = cell;
+    }
+}
+
+void CCTableView::_relayoutCells()
+{
+    for (std::unordered_map<unsigned int, CCTableViewCell*>::iterator it = _cellsUsed.begin(); it != _cellsUsed.end(); ++it)
+    {
+        this->_setIndexForCell(it->first, it->second);
+    }
 }
 
 void CCTableView::_updateContentSize()
@@ -273,7 +326,7 @@ void CCTableView::_updateContentSize()
 
     if (cellsCount > 0)
     {
-        float maxPosition = _vCellsPositions[cellsCount];
+        float maxPosition = _cellPositions.getTotalSize();
 
         switch (this->getDirection())
         {
@@ -307,10 +360,18 @@ CCPoint CCTableView::_offsetFromIndex(unsigned int index)
 {
     CCPoint offset = this->__offsetFromIndex(index);
 
-    const CCSize cellSize = _dataSource->tableCellSizeForIndex(this, index);
     if (_vordering == kCCTableViewFillTopDown)
     {
-        offset.y = this->getContainer()->getContentSize().height - offset.y - cellSize.height;
+        float cellHeight;
+        if (this->getDirection() == kCCScrollViewDirectionHorizontal)
+        {
+            cellHeight = _dataSource->tableCellSizeForIndex(this, index).height;
+        }
+        else
+        {
+            cellHeight = _cellPositions.getSize(index);
+        }
+        offset.y = this->getContainer()->getContentSize().height - offset.y - cellHeight;
     }
     return offset;
 }
@@ -318,15 +379,14 @@ CCPoint CCTableView::_offsetFromIndex(unsigned int index)
 CCPoint CCTableView::__offsetFromIndex(unsigned int index)
 {
     CCPoint offset;
-    CCSize  cellSize;
 
     switch (this->getDirection())
     {
         case kCCScrollViewDirectionHorizontal:
-            offset = ccp(_vCellsPositions[index], 0.0f);
+            offset = ccp(_cellPositions.getPosition(index), 0.0f);
             break;
         default:
-            offset = ccp(0.0f, _vCellsPositions[index]);
+            offset = ccp(0.0f, _cellPositions.getPosition(index));
             break;
     }
 
@@ -357,8 +417,6 @@ unsigned int CCTableView::_indexFromOffset(CCPoint offset)
 
 int CCTableView::__indexFromOffset(CCPoint offset)
 {
-    int low = 0;
-    int high = _dataSource->numberOfCellsInTableView(this) - 1;
     float search;
     switch (this->getDirection())
     {
@@ -370,31 +428,12 @@ int CCTableView::__indexFromOffset(CCPoint offset)
             break;
     }
 
-    while (high >= low)
+    if (_cellPositions.getCount() == 0)
     {
-        int index = low + (high - low) / 2;
-        float cellStart = _vCellsPositions[index];
-        float cellEnd = _vCellsPositions[index + 1];
-
-        if (search >= cellStart && search <= cellEnd)
-        {
-            return index;
-        }
-        else if (search < cellStart)
-        {
-            high = index - 1;
-        }
-        else
-        {
-            low = index + 1;
-        }
-    }
-
-    if (low <= 0) {
         return 0;
     }
 
-    return -1;
+    return _cellPositions.getIndex(search);
 }
 
 void CCTableView::_moveCellOutOfSight(CCTableViewCell *cell)
@@ -404,9 +443,12 @@ void CCTableView::_moveCellOutOfSight(CCTableViewCell *cell)
     }
 
     _cellsFreed->addObject(cell);
-    _cellsUsed->removeSortedObject(cell);
-    _indices->erase(cell->getIdx());
-    // [_indices removeIndex:cell.idx];
+    std::unordered_map<unsigned int, CCTableViewCell*>::iterator it = _cellsUsed.find(cell->getIdx());
+    if (it != _cellsUsed.end() && it->second == cell)
+    {
+        _cellsUsed.erase(it);
+        cell->release();
+    }
     cell->reset();
     if (cell->getParent() == this->getContainer()) {
         this->getContainer()->removeChild(cell, true);;
@@ -420,31 +462,54 @@ void CCTableView::_setIndexForCell(unsigned int index, CCTableViewCell *cell)
     cell->setIdx(index);
 }
 
-void CCTableView::_updateCellPositions() {
-    int cellsCount = _dataSource->numberOfCellsInTableView(this);
-    _vCellsPositions.resize(cellsCount + 1, 0.0);
+float CCTableView::_measureCell(unsigned int idx)
+{
+    CCSize cellSize = _dataSource->tableCellSizeForIndex(this, idx);
+    return (this->getDirection() == kCCScrollViewDirectionHorizontal) ? cellSize.width : cellSize.height;
+}
 
-    if (cellsCount > 0)
+void CCTableView::_measureCellIfNecessary(unsigned int idx)
+{
+    if (idx >= _cellPositions.getCount() || _cellPositions.isMeasured(idx))
+    {
+        return;
+    }
+
+    float oldSize = _cellPositions.getSize(idx);
+    float size = this->_measureCell(idx);
+    _cellPositions.setSize(idx, size);
+    if (size != oldSize)
     {
-        float currentPos = 0;
-        CCSize cellSize;
-        for (int i=0; i < cellsCount; i++)
+        _cellPositionsChanged = true;
+
+        // Does the start of the anchor cell move? Bottom-up and horizontal tables
+        // grow after the cell, top-down tables grow before it.
+        bool anchorMoves = (_vordering == kCCTableViewFillTopDown && this->getDirection() != kCCScrollViewDirectionHorizontal)
+            ? idx >= _anchorIdx
+            : idx < _anchorIdx;
+        if (anchorMoves)
         {
-            _vCellsPositions[i] = currentPos;
-            cellSize = _dataSource->tableCellSizeForIndex(this, i);
-            switch (this->getDirection())
-            {
-                case kCCScrollViewDirectionHorizontal:
-                    currentPos += cellSize.width;
-                    break;
-                default:
-                    currentPos += cellSize.height;
-                    break;
-            }
+            _anchorShift += size - oldSize;
         }
-        _vCellsPositions[cellsCount] = currentPos;//1 extra value allows us to get right/bottom of the last cell
+    }
+}
+
+void CCTableView::_updateCellPositions() {
+    unsigned int cellsCount = _dataSource->numberOfCellsInTableView(this);
+
+    if (!_estimatedCellSize.equals(CCSizeZero))
+    {
+        float estimate = (this->getDirection() == kCCScrollViewDirectionHorizontal) ? _estimatedCellSize.width : _estimatedCellSize.height;
+        _cellPositions.reset(cellsCount, estimate);
+        return;
     }
 
+    std::vector<float> sizes(cellsCount);
+    for (unsigned int i = 0; i < cellsCount; i++)
+    {
+        sizes[i] = this->_measureCell(i);
+    }
+    _cellPositions.reset(sizes);
 }
 
 void CCTableView::scrollViewDidScroll(CCScrollView* view)
@@ -459,7 +524,18 @@ void CCTableView::scrollViewDidScroll(CCScrollView* view)
         _tableViewDelegate->scrollViewDidScroll(this);
     }
 
-    unsigned int startIdx = 0, endIdx = 0, idx = 0, maxIdx = 0;
+    this->_updateVisibleCells();
+}
+
+void CCTableView::_updateVisibleCells()
+{
+    unsigned int uCountOfItems = _dataSource->numberOfCellsInTableView(this);
+    if (0 == uCountOfItems)
+    {
+        return;
+    }
+
+    unsigned int startIdx = 0, endIdx = 0, maxIdx = 0;
     CCPoint offset = ccpMult(this->getContentOffset(), -1);
     maxIdx = MAX(uCountOfItems-1, 0);
 
@@ -490,16 +566,13 @@ void CCTableView::scrollViewDidScroll(CCScrollView* view)
 	}
 
 #if 0 // For Testing.
-    CCObject* pObj;
-    int i = 0;
-    CCARRAY_FOREACH(_cellsUsed, pObj)
+    for (std::unordered_map<unsigned int, CCTableViewCell*>::iterator it = _cellsUsed.begin(); it != _cellsUsed.end(); ++it)
     {
-        CCTableViewCell* pCell = (CCTableViewCell*)pObj;
-        CCLog("cells Used index %d, value = %d", i, pCell->getIdx());
-        i++;
+        CCLog("cells Used index %d", it->first);
     }
     CCLog("---------------------------------------");
-    i = 0;
+    CCObject* pObj;
+    int i = 0;
     CCARRAY_FOREACH(_cellsFreed, pObj)
     {
         CCTableViewCell* pCell = (CCTableViewCell*)pObj;
@@ -509,54 +582,115 @@ void CCTableView::scrollViewDidScroll(CCScrollView* view)
     CCLog("~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~");
 #endif
 
-    if (_cellsUsed->count() > 0)
+    std::vector<CCTableViewCell*> hidden;
+    for (std::unordered_map<unsigned int, CCTableViewCell*>::iterator it = _cellsUsed.begin(); it != _cellsUsed.end(); ++it)
+    {
+        if (it->first < startIdx || (it->first <= maxIdx && it->first > endIdx))
+        {
+            hidden.push_back(it->second);
+        }
+    }
+    for (std::vector<CCTableViewCell*>::iterator it = hidden.begin(); it != hidden.end(); ++it)
     {
-        CCTableViewCell* cell = (CCTableViewCell*)_cellsUsed->objectAtIndex(0);
+        this->_moveCellOutOfSight(*it);
+    }
+
+    _anchorIdx = startIdx;
+    _anchorShift = 0.0f;
+    _cellPositionsChanged = false;
 
-        idx = cell->getIdx();
-        while(idx <startIdx)
+    for (unsigned int i=startIdx; i <= endIdx; i++)
+    {
+        if (_cellsUsed.find(i) != _cellsUsed.end())
         {
-            this->_moveCellOutOfSight(cell);
-            if (_cellsUsed->count() > 0)
-            {
-                cell = (CCTableViewCell*)_cellsUsed->objectAtIndex(0);
-                idx = cell->getIdx();
-            }
-            else
-            {
-                break;
-            }
+            continue;
         }
+        this->updateCellAtIndex(i);
     }
-    if (_cellsUsed->count() > 0)
+
+    this->_prefetchCells(startIdx, endIdx, uCountOfItems);
+
+    if (_cellPositionsChanged)
     {
-        CCTableViewCell *cell = (CCTableViewCell*)_cellsUsed->lastObject();
-        idx = cell->getIdx();
+        // Cells measured for the first time moved the others: fix the content size
+        // and the cells in place, keep the anchor cell still and fill the view again.
+        // Cells are measured only once, so this ends.
+        _cellPositionsChanged = false;
+        this->_updateContentSize();
+        this->_relayoutCells();
 
-        while(idx <= maxIdx && idx > endIdx)
+        if (_anchorShift != 0.0f)
         {
-            this->_moveCellOutOfSight(cell);
-            if (_cellsUsed->count() > 0)
+            CCPoint contentOffset = this->getContentOffset();
+            CCPoint minOffset = this->minContainerOffset();
+            CCPoint maxOffset = this->maxContainerOffset();
+            if (this->getDirection() == kCCScrollViewDirectionHorizontal)
             {
-                cell = (CCTableViewCell*)_cellsUsed->lastObject();
-                idx = cell->getIdx();
-
+                bool inside = contentOffset.x >= minOffset.x && contentOffset.x <= maxOffset.x;
+                contentOffset.x -= _anchorShift;
+                if (inside)
+                {
+                    contentOffset.x = clampf(contentOffset.x, minOffset.x, maxOffset.x);
+                }
             }
             else
             {
-                break;
+                bool inside = contentOffset.y >= minOffset.y && contentOffset.y <= maxOffset.y;
+                contentOffset.y -= _anchorShift;
+                if (inside)
+                {
+                    contentOffset.y = clampf(contentOffset.y, minOffset.y, maxOffset.y);
+                }
             }
+            _anchorShift = 0.0f;
+            // calls scrollViewDidScroll
+            this->setContentOffset(contentOffset);
+        }
+        else
+        {
+            this->_updateVisibleCells();
         }
     }
+}
 
-    for (unsigned int i=startIdx; i <= endIdx; i++)
+void CCTableView::_prefetchCells(unsigned int startIdx, unsigned int endIdx, unsigned int countOfItems)
+{
+    if (_prefetchCount == 0)
+    {
+        return;
+    }
+
+    if (startIdx != _lastStartIdx)
     {
-        //if ([_indices containsIndex:i])
-        if (_indices->find(i) != _indices->end())
+        _prefetchForward = startIdx > _lastStartIdx;
+        _lastStartIdx = startIdx;
+    }
+
+    unsigned int first, last;
+    if (_prefetchForward)
+    {
+        if (endIdx + 1 >= countOfItems)
         {
-            continue;
+            return;
         }
-        this->updateCellAtIndex(i);
+        first = endIdx + 1;
+        last = MIN(endIdx + _prefetchCount, countOfItems - 1);
+    }
+    else
+    {
+        if (startIdx == 0)
+        {
+            return;
+        }
+        first = startIdx > _prefetchCount ? startIdx - _prefetchCount : 0;
+        last = startIdx - 1;
+    }
+
+    if (first != _prefetchStartIdx || last != _prefetchEndIdx)
+    {
+        _prefetchStartIdx = first;
+        _prefetchEndIdx = last;
+        _dataSource->tablePrefetchCells(this, first, last);
     }
 }
 
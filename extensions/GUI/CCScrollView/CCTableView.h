@@ -28,9 +28,9 @@
 
 #include "CCScrollView.h"
 #include "CCTableViewCell.h"
+#include "CCCellPositionTree.h"
 
-#include <set>
-#include <vector>
+#include <unordered_map>
 
 NS_CC_EXT_BEGIN
 
@@ -124,6 +124,17 @@ public:
      * @return number of cells
      */
     virtual unsigned int numberOfCellsInTableView(CCTableView *table) = 0;
+    /**
+     * Called when the table scrolls with the cells that are about to appear in the
+     * scroll direction, when prefetching is enabled (see CCTableView::setPrefetchCount).
+     * Use it to prepare the data of these cells ahead, e.g. by starting to load their
+     * images on a background thread. It must return quickly, it is called on the main thread.
+     *
+     * @param startIdx first cell to prepare
+     * @param endIdx last cell to prepare
+     * @since v3.0
+     */
+    virtual void tablePrefetchCells(CCTableView *table, unsigned int startIdx, unsigned int endIdx) {};
 
 };
 
@@ -175,6 +186,29 @@ public:
     void setVerticalFillOrder(CCTableViewVerticalFillOrder order);
     CCTableViewVerticalFillOrder getVerticalFillOrder();
 
+    /**
+     * Enables the lazy measurement of the cells when the size is not zero.
+     *
+     * reloadData then doesn't ask the data source for the size of every cell: the cells
+     * use the estimated size until they become visible for the first time, and the
+     * content size is corrected as the cells are measured. The cell at the start of the
+     * view keeps its place on screen while this happens. Default is CCSizeZero: all
+     * the cells are measured on reloadData.
+     *
+     * @since v3.0
+     */
+    void setEstimatedCellSize(const CCSize& size);
+    const CCSize& getEstimatedCellSize() const;
+
+    /**
+     * Number of cells announced to CCTableViewDataSource::tablePrefetchCells ahead of
+     * the visible cells in the scroll direction. Default is 0, no prefetching.
+     *
+     * @since v3.0
+     */
+    void setPrefetchCount(unsigned int count);
+    unsigned int getPrefetchCount() const;
+
 
     bool initWithViewSize(CCSize size, CCNode* container = NULL);
     /**
@@ -232,19 +266,13 @@ protected:
     CCTableViewVerticalFillOrder _vordering;
 
     /**
-     * index set to query the indexes of the cells used.
-     */
-    std::set<unsigned int>* _indices;
-
-    /**
-     * vector with all cell positions
+     * positions of all the cells
      */
-    std::vector<float> _vCellsPositions;
-    //NSMutableIndexSet *indices_;
+    CCCellPositionTree _cellPositions;
     /**
-     * cells that are currently in the table
+     * cells that are currently in the table, retained, by index
      */
-    CCArrayForObjectSorting* _cellsUsed;
+    std::unordered_map<unsigned int, CCTableViewCell*> _cellsUsed;
     /**
      * free list of cells
      */
@@ -260,6 +288,21 @@ protected:
 
 	CCScrollViewDirection _oldDirection;
 
+    CCSize _estimatedCellSize;
+    /**
+     * first visible cell during the update of the visible cells, the shift of its
+     * position caused by the cells measured meanwhile
+     */
+    unsigned int _anchorIdx;
+    float _anchorShift;
+    bool _cellPositionsChanged;
+
+    unsigned int _prefetchCount;
+    unsigned int _lastStartIdx;
+    bool _prefetchForward;
+    unsigned int _prefetchStartIdx;
+    unsigned int _prefetchEndIdx;
+
     int __indexFromOffset(CCPoint offset);
     unsigned int _indexFromOffset(CCPoint offset);
     CCPoint __offsetFromIndex(unsigned int index);
@@ -268,8 +311,14 @@ protected:
     void _moveCellOutOfSight(CCTableViewCell *cell);
     void _setIndexForCell(unsigned int index, CCTableViewCell *cell);
     void _addCellIfNecessary(CCTableViewCell * cell);
+    void _shiftCellIndices(unsigned int fromIdx, int delta);
+    void _relayoutCells();
 
+    float _measureCell(unsigned int idx);
+    void _measureCellIfNecessary(unsigned int idx);
     void _updateCellPositions();
+    void _updateVisibleCells();
+    void _prefetchCells(unsigned int startIdx, unsigned int endIdx, unsigned int countOfItems);
 public:
     void _updateContentSize();
 
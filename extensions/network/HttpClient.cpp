@@ -27,8 +27,13 @@
 // #include "platform/CCThread.h"
 
 #include <queue>
+#include <algorithm>
 #include <pthread.h>
 #include <errno.h>
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
+#include <unistd.h>
+#include <sys/select.h>
+#endif
 
 #include "curl/curl.h"
 
@@ -49,12 +54,17 @@ typedef int int32_t;
 
 static bool need_quit = false;
 
+// guarded by s_requestQueueMutex
+static bool need_cancel_all = false;
+static int  s_maxConcurrentRequests = 4;
+
 static CCArray* s_requestQueue = NULL;
 static CCArray* s_responseQueue = NULL;
 
 static CCHttpClient *s_pHttpClient = NULL; // pointer to singleton
 
-static char s_errorBuffer[CURL_ERROR_SIZE];
+// upper bound of a single wait of the network thread, so new and cancelled requests are picked up quickly
+static const long kMaxWaitMillis = 20;
 
 typedef size_t (*write_callback)(void *ptr, size_t size, size_t nmemb, void *stream);
 
@@ -84,158 +94,15 @@ static size_t writeHeaderData(void *ptr, size_t size, size_t nmemb, void *stream
     return sizes;
 }
 
-
-static int processGetTask(CCHttpRequest *request, write_callback callback, void *stream, int32_t *errorCode, write_callback headerCallback, void *headerStream);
-static int processPostTask(CCHttpRequest *request, write_callback callback, void *stream, int32_t *errorCode, write_callback headerCallback, void *headerStream);
-static int processPutTask(CCHttpRequest *request, write_callback callback, void *stream, int32_t *errorCode, write_callback headerCallback, void *headerStream);
-static int processDeleteTask(CCHttpRequest *request, write_callback callback, void *stream, int32_t *errorCode, write_callback headerCallback, void *headerStream);
-// int processDownloadTask(HttpRequest *task, write_callback callback, void *stream, int32_t *errorCode);
-
-
-// Worker thread
-static void* networkThread(void *data)
-{    
-    CCHttpRequest *request = NULL;
-    
-    while (true) 
-    {
-        if (need_quit)
-        {
-            break;
-        }
-        
-        // step 1: send http request if the requestQueue isn't empty
-        request = NULL;
-        
-        pthread_mutex_lock(&s_requestQueueMutex); //Get request task from queue
-        if (0 != s_requestQueue->count())
-        {
-            request = dynamic_cast<CCHttpRequest*>(s_requestQueue->objectAtIndex(0));
-            s_requestQueue->removeObjectAtIndex(0);  
-            // request's refcount = 1 here
-        }
-        pthread_mutex_unlock(&s_requestQueueMutex);
-        
-        if (NULL == request)
-        {
-        	// Wait for http request tasks from main thread
-        	pthread_cond_wait(&s_SleepCondition, &s_SleepMutex);
-            continue;
-        }
-        
-        // step 2: libcurl sync access
-        
-        // Create a HttpResponse object, the default setting is http access failed
-        CCHttpResponse *response = new CCHttpResponse(request);
-        
-        // request's refcount = 2 here, it's retained by HttpRespose constructor
-        request->release();
-        // ok, refcount = 1 now, only HttpResponse hold it.
-        
-        int32_t responseCode = -1;
-        int retValue = 0;
-
-        // Process the request -> get response packet
-        switch (request->getRequestType())
-        {
-            case CCHttpRequest::kHttpGet: // HTTP GET
-                retValue = processGetTask(request,
-                                          writeData, 
-                                          response->getResponseData(), 
-                                          &responseCode,
-                                          writeHeaderData,
-                                          response->getResponseHeader());
-                break;
-            
-            case CCHttpRequest::kHttpPost: // HTTP POST
-                retValue = processPostTask(request,
-                                           writeData, 
-                                           response->getResponseData(), 
-                                           &responseCode,
-                                           writeHeaderData,
-                                           response->getResponseHeader());
-                break;
-
-            case CCHttpRequest::kHttpPut:
-                retValue = processPutTask(request,
-                                          writeData,
-                                          response->getResponseData(),
-                                          &responseCode,
-                                          writeHeaderData,
-                                          response->getResponseHeader());
-                break;
-
-            case CCHttpRequest::kHttpDelete:
-                retValue = processDeleteTask(request,
-                                             writeData,
-                                             response->getResponseData(),
-                                             &responseCode,
-                                             writeHeaderData,
-                                             response->getResponseHeader());
-                break;
-            
-            default:
-                CCAssert(true, "CCHttpClient: unkown request type, only GET and POSt are supported");
-                break;
-        }
-                
-        // write data to HttpResponse
-        response->setResponseCode(responseCode);
-        
-        if (retValue != 0) 
-        {
-            response->setSucceed(false);
-            response->setErrorBuffer(s_errorBuffer);
-        }
-        else
-        {
-            response->setSucceed(true);
-        }
-
-        
-        // add response packet into queue
-        pthread_mutex_lock(&s_responseQueueMutex);
-        s_responseQueue->addObject(response);
-        pthread_mutex_unlock(&s_responseQueueMutex);
-        
-        // resume dispatcher selector
-        CCDirector::sharedDirector()->getScheduler()->resumeTarget(CCHttpClient::getInstance());
-    }
-    
-    // cleanup: if worker thread received quit signal, clean up un-completed request queue
-    pthread_mutex_lock(&s_requestQueueMutex);
-    s_requestQueue->removeAllObjects();
-    pthread_mutex_unlock(&s_requestQueueMutex);
-    s_asyncRequestCount -= s_requestQueue->count();
-    
-    if (s_requestQueue != NULL) {
-        
-        pthread_mutex_destroy(&s_requestQueueMutex);
-        pthread_mutex_destroy(&s_responseQueueMutex);
-        
-        pthread_mutex_destroy(&s_SleepMutex);
-        pthread_cond_destroy(&s_SleepCondition);
-
-        s_requestQueue->release();
-        s_requestQueue = NULL;
-        s_responseQueue->release();
-        s_responseQueue = NULL;
-    }
-
-    pthread_exit(NULL);
-    
-    return 0;
-}
-
 //Configure curl's timeout property
-static bool configureCURL(CURL *handle)
+static bool configureCURL(CURL *handle, char *errorBuffer)
 {
     if (!handle) {
         return false;
     }
     
     int32_t code;
-    code = curl_easy_setopt(handle, CURLOPT_ERRORBUFFER, s_errorBuffer);
+    code = curl_easy_setopt(handle, CURLOPT_ERRORBUFFER, errorBuffer);
     if (code != CURLE_OK) {
         return false;
     }
@@ -250,128 +117,380 @@ static bool configureCURL(CURL *handle)
     curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, 0L);
     curl_easy_setopt(handle, CURLOPT_SSL_VERIFYHOST, 0L);
 
+    // signals can't be used for timeouts in a multi-threaded program
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+
     return true;
 }
 
-class CURLRaii
+/**
+ * A request being performed by the network thread.
+ * The easy handle comes from the handle pool and is given back once the transfer is done,
+ * so live connections, DNS and SSL session caches are reused by the next request.
+ */
+class CCHttpTransfer
 {
-    /// Instance of CURL
-    CURL *_curl;
-    /// Keeps custom header data
-    curl_slist *_headers;
 public:
-    CURLRaii()
-        : _curl(curl_easy_init())
-        , _headers(NULL)
+    CURL *handle;
+    /// Keeps custom header data
+    curl_slist *headers;
+    CCHttpResponse *response;
+    char errorBuffer[CURL_ERROR_SIZE];
+
+    CCHttpTransfer(CURL *curl, CCHttpResponse *pResponse)
+        : handle(curl)
+        , headers(NULL)
+        , response(pResponse)
     {
+        errorBuffer[0] = '\0';
     }
 
-    ~CURLRaii()
+    ~CCHttpTransfer()
     {
-        if (_curl)
-            curl_easy_cleanup(_curl);
         /* free the linked list for header data */
-        if (_headers)
-            curl_slist_free_all(_headers);
+        if (headers)
+            curl_slist_free_all(headers);
     }
 
     template <class T>
     bool setOption(CURLoption option, T data)
     {
-        return CURLE_OK == curl_easy_setopt(_curl, option, data);
+        return CURLE_OK == curl_easy_setopt(handle, option, data);
     }
 
     /**
-     * @brief Inits CURL instance for common usage
-     * @param request Null not allowed
-     * @param callback Response write callback
-     * @param stream Response write stream
+     * @brief Inits CURL instance for the request of the response
      */
-    bool init(CCHttpRequest *request, write_callback callback, void *stream, write_callback headerCallback, void *headerStream)
+    bool init()
     {
-        if (!_curl)
-            return false;
-        if (!configureCURL(_curl))
+        CCHttpRequest *request = response->getHttpRequest();
+
+        if (!configureCURL(handle, errorBuffer))
             return false;
 
         /* get custom header data (if set) */
-       	std::vector<std::string> headers=request->getHeaders();
-        if(!headers.empty())
+       	std::vector<std::string> customHeaders=request->getHeaders();
+        if(!customHeaders.empty())
         {
             /* append custom headers one by one */
-            for (std::vector<std::string>::iterator it = headers.begin(); it != headers.end(); ++it)
-                _headers = curl_slist_append(_headers,it->c_str());
+            for (std::vector<std::string>::iterator it = customHeaders.begin(); it != customHeaders.end(); ++it)
+                headers = curl_slist_append(headers,it->c_str());
             /* set custom headers for curl */
-            if (!setOption(CURLOPT_HTTPHEADER, _headers))
+            if (!setOption(CURLOPT_HTTPHEADER, headers))
                 return false;
         }
 
-        return setOption(CURLOPT_URL, request->getUrl())
-                && setOption(CURLOPT_WRITEFUNCTION, callback)
-                && setOption(CURLOPT_WRITEDATA, stream)
-                && setOption(CURLOPT_HEADERFUNCTION, headerCallback)
-                && setOption(CURLOPT_HEADERDATA, headerStream);
-        
+        bool ok = setOption(CURLOPT_URL, request->getUrl())
+                && setOption(CURLOPT_WRITEFUNCTION, writeData)
+                && setOption(CURLOPT_WRITEDATA, response->getResponseData())
+                && setOption(CURLOPT_HEADERFUNCTION, writeHeaderData)
+                && setOption(CURLOPT_HEADERDATA, response->getResponseHeader())
+                && setOption(CURLOPT_PRIVATE, this);
+        if (!ok)
+            return false;
+
+        switch (request->getRequestType())
+        {
+            case CCHttpRequest::kHttpGet: // HTTP GET
+                return setOption(CURLOPT_FOLLOWLOCATION, true);
+
+            case CCHttpRequest::kHttpPost: // HTTP POST
+                return setOption(CURLOPT_POST, 1)
+                        && setOption(CURLOPT_POSTFIELDS, request->getRequestData())
+                        && setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize());
+
+            case CCHttpRequest::kHttpPut:
+                return setOption(CURLOPT_CUSTOMREQUEST, "PUT")
+                        && setOption(CURLOPT_POSTFIELDS, request->getRequestData())
+                        && setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize());
+
+            case CCHttpRequest::kHttpDelete:
+                return setOption(CURLOPT_CUSTOMREQUEST, "DELETE")
+                        && setOption(CURLOPT_FOLLOWLOCATION, true);
+
+            default:
+                CCAssert(true, "CCHttpClient: unkown request type, only GET and POSt are supported");
+                return false;
+        }
     }
+};
 
-    /// @param responseCode Null not allowed
-    bool perform(int *responseCode)
+/**
+ * Keeps the idle easy handles of the network thread
+ */
+class CCHttpHandlePool
+{
+    std::vector<CURL*> _handles;
+public:
+    ~CCHttpHandlePool()
     {
-        if (CURLE_OK != curl_easy_perform(_curl))
-            return false;
-        CURLcode code = curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, responseCode);
-        if (code != CURLE_OK || *responseCode != 200)
-            return false;
-        
-        // Get some mor data.
-        
-        return true;
+        for (std::vector<CURL*>::iterator it = _handles.begin(); it != _handles.end(); ++it)
+            curl_easy_cleanup(*it);
+    }
+
+    CURL* obtain()
+    {
+        if (_handles.empty())
+            return curl_easy_init();
+
+        CURL *handle = _handles.back();
+        _handles.pop_back();
+        return handle;
+    }
+
+    void recycle(CURL *handle, unsigned int maxIdle)
+    {
+        if (_handles.size() >= maxIdle)
+        {
+            curl_easy_cleanup(handle);
+            return;
+        }
+
+        // reset options, but keep live connections and caches
+        curl_easy_reset(handle);
+        _handles.push_back(handle);
     }
 };
 
-//Process Get Request
-static int processGetTask(CCHttpRequest *request, write_callback callback, void *stream, int32_t *responseCode, write_callback headerCallback, void *headerStream)
+// Add the response to the response queue, and resume the dispatcher selector
+static void finishResponse(CCHttpResponse *response, bool succeed, int responseCode, const char *errorBuffer)
 {
-    CURLRaii curl;
-    bool ok = curl.init(request, callback, stream, headerCallback, headerStream)
-            && curl.setOption(CURLOPT_FOLLOWLOCATION, true)
-            && curl.perform(responseCode);
-    return ok ? 0 : 1;
+    response->setResponseCode(responseCode);
+    response->setSucceed(succeed);
+    if (!succeed)
+    {
+        response->setErrorBuffer(errorBuffer);
+    }
+
+    // add response packet into queue
+    pthread_mutex_lock(&s_responseQueueMutex);
+    s_responseQueue->addObject(response);
+    pthread_mutex_unlock(&s_responseQueueMutex);
+
+    // resume dispatcher selector
+    CCDirector::sharedDirector()->getScheduler()->resumeTarget(CCHttpClient::getInstance());
 }
 
-//Process POST Request
-static int processPostTask(CCHttpRequest *request, write_callback callback, void *stream, int32_t *responseCode, write_callback headerCallback, void *headerStream)
+// Remove a transfer from the multi handle and give its easy handle back to the pool
+static void releaseTransfer(CURLM *multi, CCHttpHandlePool& pool, CCHttpTransfer *transfer)
 {
-    CURLRaii curl;
-    bool ok = curl.init(request, callback, stream, headerCallback, headerStream)
-            && curl.setOption(CURLOPT_POST, 1)
-            && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData())
-            && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize())
-            && curl.perform(responseCode);
-    return ok ? 0 : 1;
+    curl_multi_remove_handle(multi, transfer->handle);
+    pool.recycle(transfer->handle, s_maxConcurrentRequests);
+    delete transfer;
 }
 
-//Process PUT Request
-static int processPutTask(CCHttpRequest *request, write_callback callback, void *stream, int32_t *responseCode, write_callback headerCallback, void *headerStream)
+// Wait until one of the sockets used by the running transfers is ready, or the timeout expires
+static void waitForTransfers(CURLM *multi)
 {
-    CURLRaii curl;
-    bool ok = curl.init(request, callback, stream, headerCallback, headerStream)
-            && curl.setOption(CURLOPT_CUSTOMREQUEST, "PUT")
-            && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData())
-            && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize())
-            && curl.perform(responseCode);
-    return ok ? 0 : 1;
+    long timeout = -1;
+    curl_multi_timeout(multi, &timeout);
+    if (timeout < 0 || timeout > kMaxWaitMillis)
+    {
+        timeout = kMaxWaitMillis;
+    }
+    if (timeout == 0)
+    {
+        return;
+    }
+
+    fd_set readSet, writeSet, errorSet;
+    FD_ZERO(&readSet);
+    FD_ZERO(&writeSet);
+    FD_ZERO(&errorSet);
+
+    int maxFd = -1;
+    curl_multi_fdset(multi, &readSet, &writeSet, &errorSet, &maxFd);
+
+    if (maxFd == -1)
+    {
+        // no socket yet (e.g. resolving), just sleep a bit
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+        Sleep(timeout);
+#else
+        usleep(timeout * 1000);
+#endif
+        return;
+    }
+
+    struct timeval tv;
+    tv.tv_sec = timeout / 1000;
+    tv.tv_usec = (timeout % 1000) * 1000;
+    select(maxFd + 1, &readSet, &writeSet, &errorSet, &tv);
 }
 
-//Process DELETE Request
-static int processDeleteTask(CCHttpRequest *request, write_callback callback, void *stream, int32_t *responseCode, write_callback headerCallback, void *headerStream)
-{
-    CURLRaii curl;
-    bool ok = curl.init(request, callback, stream, headerCallback, headerStream)
-            && curl.setOption(CURLOPT_CUSTOMREQUEST, "DELETE")
-            && curl.setOption(CURLOPT_FOLLOWLOCATION, true)
-            && curl.perform(responseCode);
-    return ok ? 0 : 1;
+// Worker thread
+static void* networkThread(void *data)
+{    
+    CURLM *multi = curl_multi_init();
+    CCHttpHandlePool pool;
+    std::vector<CCHttpTransfer*> running;
+    std::vector<CCHttpRequest*> pending;
+    
+    while (true) 
+    {
+        if (need_quit)
+        {
+            break;
+        }
+        
+        // step 1: abort cancelled transfers and take new requests if there is room for them
+        std::vector<CCHttpTransfer*> cancelled;
+        pending.clear();
+
+        pthread_mutex_lock(&s_requestQueueMutex);
+        curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, (long)s_maxConcurrentRequests);
+        for (std::vector<CCHttpTransfer*>::iterator it = running.begin(); it != running.end(); )
+        {
+            CCHttpRequest *request = (*it)->response->getHttpRequest();
+            if (need_cancel_all)
+            {
+                request->setCancelled(true);
+            }
+            if (request->isCancelled())
+            {
+                cancelled.push_back(*it);
+                it = running.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        need_cancel_all = false;
+
+        while (running.size() + pending.size() < (unsigned int)s_maxConcurrentRequests && 0 != s_requestQueue->count())
+        {
+            // the queue is sorted by priority in CCHttpClient::send
+            CCHttpRequest *request = static_cast<CCHttpRequest*>(s_requestQueue->objectAtIndex(0));
+            s_requestQueue->removeObjectAtIndex(0);
+            // request's refcount = 1 here
+            pending.push_back(request);
+        }
+        pthread_mutex_unlock(&s_requestQueueMutex);
+
+        for (std::vector<CCHttpTransfer*>::iterator it = cancelled.begin(); it != cancelled.end(); ++it)
+        {
+            CCHttpResponse *response = (*it)->response;
+            releaseTransfer(multi, pool, *it);
+            finishResponse(response, false, -1, "Request cancelled");
+        }
+
+        // step 2: start the new requests on pooled handles
+        for (std::vector<CCHttpRequest*>::iterator it = pending.begin(); it != pending.end(); ++it)
+        {
+            // Create a HttpResponse object, the default setting is http access failed
+            CCHttpResponse *response = new CCHttpResponse(*it);
+
+            // request's refcount = 2 here, it's retained by HttpRespose constructor
+            (*it)->release();
+            // ok, refcount = 1 now, only HttpResponse hold it.
+
+            CURL *handle = pool.obtain();
+            if (!handle)
+            {
+                finishResponse(response, false, -1, "Failed to create curl handle");
+                continue;
+            }
+
+            CCHttpTransfer *transfer = new CCHttpTransfer(handle, response);
+            if (!transfer->init() || CURLM_OK != curl_multi_add_handle(multi, handle))
+            {
+                std::string error = transfer->errorBuffer;
+                pool.recycle(handle, s_maxConcurrentRequests);
+                delete transfer;
+                finishResponse(response, false, -1, error.c_str());
+                continue;
+            }
+            running.push_back(transfer);
+        }
+
+        if (running.empty())
+        {
+        	// Wait for http request tasks from main thread
+            pthread_mutex_lock(&s_SleepMutex);
+            pthread_mutex_lock(&s_requestQueueMutex);
+            bool idle = (0 == s_requestQueue->count());
+            pthread_mutex_unlock(&s_requestQueueMutex);
+            if (idle && !need_quit)
+            {
+                pthread_cond_wait(&s_SleepCondition, &s_SleepMutex);
+            }
+            pthread_mutex_unlock(&s_SleepMutex);
+            continue;
+        }
+        
+        // step 3: libcurl async access
+        int stillRunning = 0;
+        while (CURLM_CALL_MULTI_PERFORM == curl_multi_perform(multi, &stillRunning))
+        {
+        }
+
+        // step 4: collect the completed transfers
+        CURLMsg *msg = NULL;
+        int msgsLeft = 0;
+        while ((msg = curl_multi_info_read(multi, &msgsLeft)) != NULL)
+        {
+            if (msg->msg != CURLMSG_DONE)
+            {
+                continue;
+            }
+
+            CCHttpTransfer *transfer = NULL;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&transfer);
+            running.erase(std::find(running.begin(), running.end(), transfer));
+
+            long responseCode = -1;
+            bool succeed = (CURLE_OK == msg->data.result)
+                && CURLE_OK == curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &responseCode)
+                && responseCode == 200;
+
+            CCHttpResponse *response = transfer->response;
+            std::string error = transfer->errorBuffer;
+            releaseTransfer(multi, pool, transfer);
+            finishResponse(response, succeed, (int)responseCode, error.c_str());
+        }
+
+        // step 5: wait for network activity
+        if (stillRunning > 0)
+        {
+            waitForTransfers(multi);
+        }
+    }
+
+    // cleanup: abort running transfers
+    for (std::vector<CCHttpTransfer*>::iterator it = running.begin(); it != running.end(); ++it)
+    {
+        CCHttpResponse *response = (*it)->response;
+        releaseTransfer(multi, pool, *it);
+        response->release();
+        --s_asyncRequestCount;
+    }
+    curl_multi_cleanup(multi);
+    
+    // cleanup: if worker thread received quit signal, clean up un-completed request queue
+    pthread_mutex_lock(&s_requestQueueMutex);
+    s_asyncRequestCount -= s_requestQueue->count();
+    s_requestQueue->removeAllObjects();
+    pthread_mutex_unlock(&s_requestQueueMutex);
+    
+    if (s_requestQueue != NULL) {
+        
+        pthread_mutex_destroy(&s_requestQueueMutex);
+        pthread_mutex_destroy(&s_responseQueueMutex);
+        
+        pthread_mutex_destroy(&s_SleepMutex);
+        pthread_cond_destroy(&s_SleepCondition);
+
+        s_requestQueue->release();
+        s_requestQueue = NULL;
+        s_responseQueue->release();
+        s_responseQueue = NULL;
+    }
+
+    pthread_exit(NULL);
+    
+    return 0;
 }
 
 // HttpClient implementation
@@ -405,7 +524,9 @@ CCHttpClient::~CCHttpClient()
     need_quit = true;
     
     if (s_requestQueue != NULL) {
+        pthread_mutex_lock(&s_SleepMutex);
     	pthread_cond_signal(&s_SleepCondition);
+        pthread_mutex_unlock(&s_SleepMutex);
     }
     
     s_pHttpClient = NULL;
@@ -457,11 +578,91 @@ void CCHttpClient::send(CCHttpRequest* request)
     request->retain();
         
     pthread_mutex_lock(&s_requestQueueMutex);
-    s_requestQueue->addObject(request);
+    request->setCancelled(false);
+    // keep the queue sorted by priority, FIFO for requests with the same priority
+    unsigned int index = s_requestQueue->count();
+    while (index > 0 && static_cast<CCHttpRequest*>(s_requestQueue->objectAtIndex(index - 1))->getPriority() < request->getPriority())
+    {
+        --index;
+    }
+    s_requestQueue->insertObject(request, index);
     pthread_mutex_unlock(&s_requestQueueMutex);
     
     // Notify thread start to work
+    pthread_mutex_lock(&s_SleepMutex);
     pthread_cond_signal(&s_SleepCondition);
+    pthread_mutex_unlock(&s_SleepMutex);
+}
+
+void CCHttpClient::cancel(CCHttpRequest* request)
+{
+    if (!request || s_requestQueue == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_requestQueueMutex);
+    request->setCancelled(true);
+    unsigned int index = s_requestQueue->indexOfObject(request);
+    if (index != CC_INVALID_INDEX)
+    {
+        // not started yet, just drop it
+        s_requestQueue->removeObjectAtIndex(index);
+        request->release();
+        --s_asyncRequestCount;
+    }
+    // otherwise the network thread aborts it, and the response is dropped in dispatchResponseCallbacks
+    pthread_mutex_unlock(&s_requestQueueMutex);
+}
+
+void CCHttpClient::cancelAll()
+{
+    if (s_requestQueue == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_requestQueueMutex);
+    CCObject *pObj = NULL;
+    CCARRAY_FOREACH(s_requestQueue, pObj)
+    {
+        CCHttpRequest *request = static_cast<CCHttpRequest*>(pObj);
+        request->setCancelled(true);
+        request->release();
+        --s_asyncRequestCount;
+    }
+    s_requestQueue->removeAllObjects();
+    need_cancel_all = true;
+    pthread_mutex_unlock(&s_requestQueueMutex);
+
+    // responses already in the queue are dropped too
+    pthread_mutex_lock(&s_responseQueueMutex);
+    CCARRAY_FOREACH(s_responseQueue, pObj)
+    {
+        static_cast<CCHttpResponse*>(pObj)->getHttpRequest()->setCancelled(true);
+    }
+    pthread_mutex_unlock(&s_responseQueueMutex);
+}
+
+void CCHttpClient::setMaxConcurrentRequests(int value)
+{
+    CCAssert(value > 0, "CCHttpClient: at least one request must be allowed");
+
+    if (s_requestQueue != NULL)
+    {
+        pthread_mutex_lock(&s_requestQueueMutex);
+        s_maxConcurrentRequests = value;
+        pthread_mutex_unlock(&s_requestQueueMutex);
+    }
+    else
+    {
+        s_maxConcurrentRequests = value;
+    }
+}
+
+int CCHttpClient::getMaxConcurrentRequests()
+{
+    return s_maxConcurrentRequests;
 }
 
 // Poll and notify main thread if responses exists in queue
@@ -469,30 +670,37 @@ void CCHttpClient::dispatchResponseCallbacks(float delta)
 {
     // CCLog("CCHttpClient::dispatchResponseCallbacks is running");
     
-    CCHttpResponse* response = NULL;
+    // several requests may complete in the same frame, dispatch all of them
+    CCArray *responses = NULL;
     
     pthread_mutex_lock(&s_responseQueueMutex);
     if (s_responseQueue->count())
     {
-        response = dynamic_cast<CCHttpResponse*>(s_responseQueue->objectAtIndex(0));
-        s_responseQueue->removeObjectAtIndex(0);
+        responses = CCArray::createWithArray(s_responseQueue);
+        s_responseQueue->removeAllObjects();
     }
     pthread_mutex_unlock(&s_responseQueueMutex);
     
-    if (response)
+    if (responses)
     {
-        --s_asyncRequestCount;
-        
-        CCHttpRequest *request = response->getHttpRequest();
-        CCObject *pTarget = request->getTarget();
-        SEL_HttpResponse pSelector = request->getSelector();
-
-        if (pTarget && pSelector) 
+        CCObject *pObj = NULL;
+        CCARRAY_FOREACH(responses, pObj)
         {
-            (pTarget->*pSelector)(this, response);
+            CCHttpResponse *response = static_cast<CCHttpResponse*>(pObj);
+            --s_asyncRequestCount;
+            
+            CCHttpRequest *request = response->getHttpRequest();
+            CCObject *pTarget = request->getTarget();
+            SEL_HttpResponse pSelector = request->getSelector();
+
+            if (pTarget && pSelector && !request->isCancelled()) 
+            {
+                (pTarget->*pSelector)(this, response);
+            }
+            
+            // released once by the array, once here to pair with new in the network thread
+            response->release();
         }
-        
-        response->release();
     }
     
     if (0 == s_asyncRequestCount) 
@@ -42,6 +42,8 @@ NS_CC_EXT_BEGIN
 
 /** @brief Singleton that handles asynchrounous http requests
  * Once the request completed, a callback will issued in main thread when it provided during make request
+ * Up to getMaxConcurrentRequests() requests are performed at the same time by the network thread,
+ * connections are kept alive and reused between requests to the same host.
  */
 class CCHttpClient : public CCObject
 {
@@ -59,6 +61,33 @@ public:
      * @return NULL
      */
     void send(CCHttpRequest* request);
+
+    /**
+     * Cancel a request sent with send(). The request is removed from the task queue,
+     * or aborted if it is already being performed. Its response callback won't be called.
+     * @param request a CCHttpRequest object previously passed to send
+     * @return NULL
+     */
+    void cancel(CCHttpRequest* request);
+
+    /**
+     * Cancel all pending and running requests
+     * @return NULL
+     */
+    void cancelAll();
+
+    /**
+     * Change the maximum number of requests performed at the same time, default is 4
+     * @param value
+     * @return NULL
+     */
+    void setMaxConcurrentRequests(int value);
+
+    /**
+     * Get the maximum number of requests performed at the same time
+     * @return int
+     */
+    int getMaxConcurrentRequests();
   
     
     /**
@@ -69,6 +69,8 @@ public:
         _pTarget = NULL;
         _pSelector = NULL;
         _pUserData = NULL;
+        _priority = 0;
+        _cancelled = false;
     };
     
     /** Destructor */
@@ -215,6 +217,33 @@ public:
    		return _headers;
    	}
 
+    /** Option field. Requests with a higher priority are started first,
+        requests with the same priority are started in the order they were sent.
+        Default is 0.
+     */
+    inline void setPriority(int priority)
+    {
+        _priority = priority;
+    }
+    /** Get the priority back */
+    inline int getPriority()
+    {
+        return _priority;
+    }
+
+    /** Returns true if the request was cancelled with CCHttpClient::cancel.
+        Cancelled requests don't invoke their response callback.
+     */
+    inline bool isCancelled()
+    {
+        return _cancelled;
+    }
+    /** Mainly used by CCHttpClient, call CCHttpClient::cancel instead */
+    inline void setCancelled(bool cancelled)
+    {
+        _cancelled = cancelled;
+    }
+
 
 protected:
     // properties
@@ -226,6 +255,8 @@ protected:
     SEL_HttpResponse            _pSelector;      /// callback function, e.g. MyLayer::onHttpResponse(CCHttpClient *sender, CCHttpResponse * response)
     void*                       _pUserData;      /// You can add your customed data here 
     std::vector<std::string>    _headers;		      /// custom http headers
+    int                         _priority;       /// higher priority requests are started first
+    bool                        _cancelled;      /// set by CCHttpClient::cancel
 };
 
 NS_CC_EXT_END
@@ -21,6 +21,7 @@
  */
 
 #include "CCPhysicsSprite.h"
+#include "CCPhysicsStepper.h"
 #include "support/CCPointExtension.h"
 
 #if CC_ENABLE_CHIPMUNK_INTEGRATION
@@ -33,6 +34,10 @@ NS_CC_EXT_BEGIN
 
 CCPhysicsSprite::CCPhysicsSprite()
 : _ignoreBodyRotation(false)
+, _stepper(NULL)
+, _stepperIndex(0)
+, _interpolatedPosition(CCPointZero)
+, _interpolatedAngle(0.0f)
 #if CC_ENABLE_CHIPMUNK_INTEGRATION
 , _CPBody(NULL)
 #elif CC_ENABLE_BOX2D_INTEGRATION
@@ -189,6 +194,36 @@ float CCPhysicsSprite::getPositionY()
     return _position.y;
 }
 
+CCPhysicsStepper* CCPhysicsSprite::getStepper() const
+{
+    return _stepper;
+}
+
+// returns the transform matrix according to the state interpolated by the stepper
+CCAffineTransform CCPhysicsSprite::interpolatedTransform()
+{
+#if CC_ENABLE_CHIPMUNK_INTEGRATION
+    float radians = (_ignoreBodyRotation ? -CC_DEGREES_TO_RADIANS(_rotationX) : _interpolatedAngle);
+#elif CC_ENABLE_BOX2D_INTEGRATION
+    float radians = (_ignoreBodyRotation ? CC_DEGREES_TO_RADIANS(_rotationX) : _interpolatedAngle);
+#endif
+    float c = cosf(radians);
+    float s = sinf(radians);
+
+    float x = _interpolatedPosition.x + c * -_anchorPointInPoints.x * _scaleX - s * -_anchorPointInPoints.y * _scaleY;
+    float y = _interpolatedPosition.y + s * -_anchorPointInPoints.x * _scaleX + c * -_anchorPointInPoints.y * _scaleY;
+
+    if (_ignoreAnchorPointForPosition)
+    {
+        x += _anchorPointInPoints.x;
+        y += _anchorPointInPoints.y;
+    }
+
+    return (_transform = CCAffineTransformMake(c * _scaleX, s * _scaleX,
+                                               -s * _scaleY, c * _scaleY,
+                                               x, y));
+}
+
 #if CC_ENABLE_CHIPMUNK_INTEGRATION
 
 cpBody* CCPhysicsSprite::getCPBody() const
@@ -211,6 +246,11 @@ void CCPhysicsSprite::setPosition(const CCPoint &pos)
 {
     cpVect cpPos = cpv(pos.x, pos.y);
     cpBodySetPos(_CPBody, cpPos);
+
+    if (_stepper)
+    {
+        _stepper->resetSprite(this);
+    }
 }
 
 float CCPhysicsSprite::getRotation()
@@ -227,12 +267,22 @@ void CCPhysicsSprite::setRotation(float fRotation)
     else
     {
         cpBodySetAngle(_CPBody, -CC_DEGREES_TO_RADIANS(fRotation));
+
+        if (_stepper)
+        {
+            _stepper->resetSprite(this);
+        }
     }
 }
 
 // returns the transform matrix according the Chipmunk Body values
 CCAffineTransform CCPhysicsSprite::nodeToParentTransform()
 {
+    if (_stepper)
+    {
+        return interpolatedTransform();
+    }
+
     // Although scale is not used by physics engines, it is calculated just in case
 	// the sprite is animated (scaled up/down) using actions.
 	// For more info see: http://www.cocos2d-iphone.org/forum/topic/68990
@@ -286,6 +336,11 @@ void CCPhysicsSprite::setPosition(const CCPoint &pos)
 {
     float angle = _pB2Body->GetAngle();
     _pB2Body->SetTransform(b2Vec2(pos.x / _PTMRatio, pos.y / _PTMRatio), angle);
+
+    if (_stepper)
+    {
+        _stepper->resetSprite(this);
+    }
 }
 
 float CCPhysicsSprite::getRotation()
@@ -305,12 +360,22 @@ void CCPhysicsSprite::setRotation(float fRotation)
         b2Vec2 p = _pB2Body->GetPosition();
         float radians = CC_DEGREES_TO_RADIANS(fRotation);
         _pB2Body->SetTransform(p, radians);
+
+        if (_stepper)
+        {
+            _stepper->resetSprite(this);
+        }
     }
 }
 
 // returns the transform matrix according the Box2D Body values
 CCAffineTransform CCPhysicsSprite::nodeToParentTransform()
 {
+    if (_stepper)
+    {
+        return interpolatedTransform();
+    }
+
     b2Vec2 pos  = _pB2Body->GetPosition();
 	
 	float x = pos.x * _PTMRatio;
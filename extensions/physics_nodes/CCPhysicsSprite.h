@@ -34,6 +34,9 @@ class b2Body;
 #endif
 
 NS_CC_EXT_BEGIN
+
+class CCPhysicsStepper;
+
 /** A CCSprite subclass that is bound to a physics body.
  It works with:
  - Chipmunk: Preprocessor macro CC_ENABLE_CHIPMUNK_INTEGRATION should be defined
@@ -45,11 +48,20 @@ NS_CC_EXT_BEGIN
  - Position and rotation are going to updated from the physics body
  - If you update the rotation or position manually, the physics body will be updated
  - You can't enble both Chipmunk support and Box2d support at the same time. Only one can be enabled at compile time
+ - When registered in a CCPhysicsStepper, the sprite is drawn with the body state interpolated by the stepper
  */
 class CCPhysicsSprite : public CCSprite
 {
+    friend class CCPhysicsStepper;
+
 protected:
     bool    _ignoreBodyRotation;
+
+    // Interpolated body state, written by the stepper
+    CCPhysicsStepper *_stepper;
+    unsigned int      _stepperIndex;
+    CCPoint           _interpolatedPosition;
+    float             _interpolatedAngle;
 #if CC_ENABLE_CHIPMUNK_INTEGRATION
     cpBody  *_CPBody;
 
@@ -110,6 +122,9 @@ public:
     virtual void setRotation(float fRotation);
     virtual CCAffineTransform nodeToParentTransform();
 
+    /** The stepper that interpolates this sprite, or NULL. */
+    CCPhysicsStepper* getStepper() const;
+
 #if CC_ENABLE_CHIPMUNK_INTEGRATION
     /** Body accessor when using regular Chipmunk */
     cpBody* getCPBody() const;
@@ -125,6 +140,7 @@ public:
 
 protected:
     void updatePosFromPhysics();
+    CCAffineTransform interpolatedTransform();
 };
 
 NS_CC_EXT_END
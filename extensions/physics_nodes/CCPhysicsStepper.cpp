@@ -0,0 +1,389 @@
+/* Copyright (c) 2013 cocos2d-x.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "CCPhysicsStepper.h"
+#include "CCPhysicsSprite.h"
+
+#if CC_ENABLE_CHIPMUNK_INTEGRATION
+#include "chipmunk.h"
+#elif CC_ENABLE_BOX2D_INTEGRATION
+#include "Box2D/Box2D.h"
+#endif
+
+NS_CC_EXT_BEGIN
+
+CCPhysicsStepper::CCPhysicsStepper()
+#if CC_ENABLE_CHIPMUNK_INTEGRATION
+: _space(NULL)
+#elif CC_ENABLE_BOX2D_INTEGRATION
+: _world(NULL)
+, _velocityIterations(8)
+, _positionIterations(3)
+#endif
+, _stepTarget(NULL)
+, _stepSelector(NULL)
+, _fixedTimeStep(1.0f / 60.0f)
+, _accumulator(0.0f)
+, _maxStepsPerFrame(5)
+, _interpolationEnabled(true)
+, _running(false)
+, _totalSteps(0)
+, _droppedSteps(0)
+{
+}
+
+CCPhysicsStepper::~CCPhysicsStepper()
+{
+    removeAllSprites();
+}
+
+#if CC_ENABLE_CHIPMUNK_INTEGRATION
+
+CCPhysicsStepper* CCPhysicsStepper::create(cpSpace *space, float fixedTimeStep)
+{
+    CCPhysicsStepper *pRet = new CCPhysicsStepper();
+    if (pRet && pRet->init(space, fixedTimeStep))
+    {
+        pRet->autorelease();
+    }
+    else
+    {
+        CC_SAFE_DELETE(pRet);
+    }
+
+    return pRet;
+}
+
+bool CCPhysicsStepper::init(cpSpace *space, float fixedTimeStep)
+{
+    CCAssert(space != NULL, "Invalid space");
+    CCAssert(fixedTimeStep > 0, "Invalid fixed time step");
+
+    _space = space;
+    _fixedTimeStep = fixedTimeStep;
+    return true;
+}
+
+cpSpace* CCPhysicsStepper::getSpace() const
+{
+    return _space;
+}
+
+void CCPhysicsStepper::stepWorld()
+{
+    cpSpaceStep(_space, _fixedTimeStep);
+}
+
+bool CCPhysicsStepper::readBodyState(CCPhysicsSprite *sprite, BodyState *state)
+{
+    cpBody *body = sprite->_CPBody;
+    if (! body)
+    {
+        return false;
+    }
+
+    state->x = body->p.x;
+    state->y = body->p.y;
+    state->angle = body->a;
+    return true;
+}
+
+#elif CC_ENABLE_BOX2D_INTEGRATION
+
+CCPhysicsStepper* CCPhysicsStepper::create(b2World *world, float fixedTimeStep, int velocityIterations, int positionIterations)
+{
+    CCPhysicsStepper *pRet = new CCPhysicsStepper();
+    if (pRet && pRet->init(world, fixedTimeStep, velocityIterations, positionIterations))
+    {
+        pRet->autorelease();
+    }
+    else
+    {
+        CC_SAFE_DELETE(pRet);
+    }
+
+    return pRet;
+}
+
+bool CCPhysicsStepper::init(b2World *world, float fixedTimeStep, int velocityIterations, int positionIterations)
+{
+    CCAssert(world != NULL, "Invalid world");
+    CCAssert(fixedTimeStep > 0, "Invalid fixed time step");
+
+    _world = world;
+    _fixedTimeStep = fixedTimeStep;
+    _velocityIterations = velocityIterations;
+    _positionIterations = positionIterations;
+    return true;
+}
+
+b2World* CCPhysicsStepper::getWorld() const
+{
+    return _world;
+}
+
+void CCPhysicsStepper::stepWorld()
+{
+    _world->Step(_fixedTimeStep, _velocityIterations, _positionIterations);
+}
+
+bool CCPhysicsStepper::readBodyState(CCPhysicsSprite *sprite, BodyState *state)
+{
+    b2Body *body = sprite->_pB2Body;
+    if (! body)
+    {
+        return false;
+    }
+
+    const b2Vec2& pos = body->GetPosition();
+    state->x = pos.x * sprite->_PTMRatio;
+    state->y = pos.y * sprite->_PTMRatio;
+    state->angle = body->GetAngle();
+    return true;
+}
+
+#endif // CC_ENABLE_BOX2D_INTEGRATION
+
+void CCPhysicsStepper::start(int priority)
+{
+    if (! _running)
+    {
+        CCDirector::sharedDirector()->getScheduler()->scheduleUpdateForTarget(this, priority, false);
+        _running = true;
+    }
+}
+
+void CCPhysicsStepper::stop()
+{
+    if (_running)
+    {
+        CCDirector::sharedDirector()->getScheduler()->unscheduleUpdateForTarget(this);
+        _running = false;
+    }
+}
+
+bool CCPhysicsStepper::isRunning() const
+{
+    return _running;
+}
+
+void CCPhysicsStepper::update(float dt)
+{
+    _accumulator += dt;
+
+    unsigned int steps = (unsigned int)(_accumulator / _fixedTimeStep);
+    if (steps > _maxStepsPerFrame)
+    {
+        // Too far behind: drop the extra time instead of spiralling.
+        _droppedSteps += steps - _maxStepsPerFrame;
+        _accumulator -= (steps - _maxStepsPerFrame) * _fixedTimeStep;
+        steps = _maxStepsPerFrame;
+    }
+
+    for (unsigned int i = 0; i < steps; ++i)
+    {
+        // Only the last two states are needed for interpolation
+        if (i + 1 == steps)
+        {
+            captureStates(true);
+        }
+
+        if (_stepTarget && _stepSelector)
+        {
+            (_stepTarget->*_stepSelector)(_fixedTimeStep);
+        }
+
+        stepWorld();
+        _accumulator -= _fixedTimeStep;
+        ++_totalSteps;
+    }
+
+    if (_accumulator < 0)
+    {
+        _accumulator = 0;
+    }
+
+    if (steps > 0)
+    {
+        captureStates(false);
+    }
+
+    syncSprites();
+}
+
+void CCPhysicsStepper::captureStates(bool previous)
+{
+    for (std::vector<Entry>::iterator it = _entries.begin(); it != _entries.end(); ++it)
+    {
+        readBodyState(it->sprite, previous ? &it->previous : &it->current);
+    }
+}
+
+void CCPhysicsStepper::syncSprites()
+{
+    float alpha = _interpolationEnabled ? getInterpolationAlpha() : 1.0f;
+    float beta = 1.0f - alpha;
+
+    for (std::vector<Entry>::iterator it = _entries.begin(); it != _entries.end(); ++it)
+    {
+        CCPhysicsSprite *sprite = it->sprite;
+        const BodyState& prev = it->previous;
+        const BodyState& cur = it->current;
+
+        sprite->_interpolatedPosition.x = prev.x * beta + cur.x * alpha;
+        sprite->_interpolatedPosition.y = prev.y * beta + cur.y * alpha;
+        sprite->_interpolatedAngle = prev.angle * beta + cur.angle * alpha;
+        sprite->_transformDirty = sprite->_inverseDirty = true;
+        // like the transform setters of CCSprite: the quads of the sprite and its children in a batch node
+        if (sprite->getBatchNode() && ! sprite->_recursiveDirty)
+        {
+            sprite->setDirtyRecursively(true);
+        }
+    }
+}
+
+void CCPhysicsStepper::addSprite(CCPhysicsSprite *sprite)
+{
+    CCAssert(sprite != NULL, "Invalid sprite");
+    CCAssert(sprite->_stepper == NULL, "Sprite is already registered in a stepper");
+
+    Entry entry;
+    entry.sprite = sprite;
+    if (! readBodyState(sprite, &entry.current))
+    {
+        entry.current.x = entry.current.y = entry.current.angle = 0;
+    }
+    entry.previous = entry.current;
+
+    sprite->retain();
+    sprite->_stepper = this;
+    sprite->_stepperIndex = _entries.size();
+    _entries.push_back(entry);
+
+    sprite->_interpolatedPosition = CCPoint(entry.current.x, entry.current.y);
+    sprite->_interpolatedAngle = entry.current.angle;
+}
+
+void CCPhysicsStepper::removeSprite(CCPhysicsSprite *sprite)
+{
+    if (! sprite || sprite->_stepper != this)
+    {
+        return;
+    }
+
+    // swap with the last entry to keep the array dense
+    unsigned int index = sprite->_stepperIndex;
+    if (index + 1 != _entries.size())
+    {
+        _entries[index] = _entries.back();
+        _entries[index].sprite->_stepperIndex = index;
+    }
+    _entries.pop_back();
+
+    sprite->_stepper = NULL;
+    sprite->release();
+}
+
+void CCPhysicsStepper::removeAllSprites()
+{
+    for (std::vector<Entry>::iterator it = _entries.begin(); it != _entries.end(); ++it)
+    {
+        it->sprite->_stepper = NULL;
+        it->sprite->release();
+    }
+    _entries.clear();
+}
+
+unsigned int CCPhysicsStepper::getSpriteCount() const
+{
+    return _entries.size();
+}
+
+void CCPhysicsStepper::resetSprite(CCPhysicsSprite *sprite)
+{
+    if (! sprite || sprite->_stepper != this)
+    {
+        return;
+    }
+
+    Entry& entry = _entries[sprite->_stepperIndex];
+    if (readBodyState(sprite, &entry.current))
+    {
+        entry.previous = entry.current;
+        sprite->_interpolatedPosition = CCPoint(entry.current.x, entry.current.y);
+        sprite->_interpolatedAngle = entry.current.angle;
+    }
+}
+
+void CCPhysicsStepper::setStepCallback(CCObject *target, SEL_SCHEDULE selector)
+{
+    _stepTarget = target;
+    _stepSelector = selector;
+}
+
+float CCPhysicsStepper::getFixedTimeStep() const
+{
+    return _fixedTimeStep;
+}
+
+void CCPhysicsStepper::setFixedTimeStep(float fixedTimeStep)
+{
+    CCAssert(fixedTimeStep > 0, "Invalid fixed time step");
+    _fixedTimeStep = fixedTimeStep;
+}
+
+unsigned int CCPhysicsStepper::getMaxStepsPerFrame() const
+{
+    return _maxStepsPerFrame;
+}
+
+void CCPhysicsStepper::setMaxStepsPerFrame(unsigned int maxSteps)
+{
+    _maxStepsPerFrame = maxSteps > 0 ? maxSteps : 1;
+}
+
+bool CCPhysicsStepper::isInterpolationEnabled() const
+{
+    return _interpolationEnabled;
+}
+
+void CCPhysicsStepper::setInterpolationEnabled(bool enabled)
+{
+    _interpolationEnabled = enabled;
+}
+
+float CCPhysicsStepper::getInterpolationAlpha() const
+{
+    float alpha = _accumulator / _fixedTimeStep;
+    return alpha > 1.0f ? 1.0f : alpha;
+}
+
+unsigned int CCPhysicsStepper::getTotalSteps() const
+{
+    return _totalSteps;
+}
+
+unsigned int CCPhysicsStepper::getDroppedSteps() const
+{
+    return _droppedSteps;
+}
+
+NS_CC_EXT_END
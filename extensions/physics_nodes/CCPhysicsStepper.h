@@ -0,0 +1,174 @@
+/* Copyright (c) 2013 cocos2d-x.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __PHYSICSNODES_CCPHYSICSSTEPPER_H__
+#define __PHYSICSNODES_CCPHYSICSSTEPPER_H__
+
+#include "cocos2d.h"
+#include "ExtensionMacros.h"
+#include <vector>
+
+#if CC_ENABLE_CHIPMUNK_INTEGRATION
+#include "chipmunk.h"
+#elif CC_ENABLE_BOX2D_INTEGRATION
+class b2World;
+#else // CC_ENABLE_BOX2D_INTEGRATION
+#error "You must define either CC_ENABLE_CHIPMUNK_INTEGRATION or CC_ENABLE_BOX2D_INTEGRATION to use CCPhysicsStepper.h"
+#endif
+
+NS_CC_EXT_BEGIN
+
+class CCPhysicsSprite;
+
+/** Steps a Chipmunk space or a Box2D world at a fixed rate.
+
+ The stepper is driven by the CCScheduler. Every frame the elapsed time is
+ added to an accumulator and the simulation is advanced in steps of exactly
+ getFixedTimeStep() seconds. At most getMaxStepsPerFrame() steps are run per
+ frame, the remaining time is dropped so a frame spike can't make the next
+ frame even slower.
+
+ The stepper keeps the previous and the current state of every registered
+ CCPhysicsSprite body. After stepping, all sprites are synced in a single
+ pass with a transform interpolated between those two states, so motion is
+ smooth at any display rate.
+
+ Registered sprites are retained until removeSprite() is called or the
+ stepper is destroyed.
+
+ @since v3.0
+ */
+class CCPhysicsStepper : public CCObject
+{
+public:
+#if CC_ENABLE_CHIPMUNK_INTEGRATION
+    /** Creates a stepper for a regular Chipmunk space. */
+    static CCPhysicsStepper* create(cpSpace *space, float fixedTimeStep = 1.0f / 60.0f);
+    bool init(cpSpace *space, float fixedTimeStep);
+
+    cpSpace* getSpace() const;
+#elif CC_ENABLE_BOX2D_INTEGRATION
+    /** Creates a stepper for a Box2D world. */
+    static CCPhysicsStepper* create(b2World *world, float fixedTimeStep = 1.0f / 60.0f, int velocityIterations = 8, int positionIterations = 3);
+    bool init(b2World *world, float fixedTimeStep, int velocityIterations, int positionIterations);
+
+    b2World* getWorld() const;
+#endif // CC_ENABLE_BOX2D_INTEGRATION
+
+    CCPhysicsStepper();
+    virtual ~CCPhysicsStepper();
+
+    /** Schedules the stepper in the shared scheduler with the given priority.
+     Use a priority lower than the one of the nodes that apply forces, so
+     the forces are in place before the world is stepped.
+     */
+    void start(int priority = 0);
+    /** Unschedules the stepper. The accumulated time is kept. */
+    void stop();
+    bool isRunning() const;
+
+    /** Called by the scheduler. Advances the simulation by dt seconds. */
+    virtual void update(float dt);
+
+    /** Registers a sprite. Its body state is captured right away. */
+    void addSprite(CCPhysicsSprite *sprite);
+    void removeSprite(CCPhysicsSprite *sprite);
+    void removeAllSprites();
+    unsigned int getSpriteCount() const;
+
+    /** Snaps the interpolation of a sprite to the current body state.
+     Called automatically when the sprite position or rotation is set.
+     */
+    void resetSprite(CCPhysicsSprite *sprite);
+
+    /** Sets a callback invoked once per fixed step, before the world is
+     stepped. Use it for deterministic game logic.
+     */
+    void setStepCallback(CCObject *target, SEL_SCHEDULE selector);
+
+    float getFixedTimeStep() const;
+    void setFixedTimeStep(float fixedTimeStep);
+
+    /** Maximum number of steps run in a single frame. Default is 5. */
+    unsigned int getMaxStepsPerFrame() const;
+    void setMaxStepsPerFrame(unsigned int maxSteps);
+
+    /** Enables or disables render interpolation. Default is enabled.
+     When disabled, sprites show the latest simulated state.
+     */
+    bool isInterpolationEnabled() const;
+    void setInterpolationEnabled(bool enabled);
+
+    /** Fraction of a step between the previous and the current state. */
+    float getInterpolationAlpha() const;
+
+    /** Total number of steps run since the stepper was created. */
+    unsigned int getTotalSteps() const;
+    /** Total number of steps skipped because of the catch-up cap. */
+    unsigned int getDroppedSteps() const;
+
+protected:
+    struct BodyState
+    {
+        float x;
+        float y;
+        float angle;
+    };
+
+    struct Entry
+    {
+        CCPhysicsSprite *sprite;
+        BodyState previous;
+        BodyState current;
+    };
+
+    void stepWorld();
+    void captureStates(bool previous);
+    void syncSprites();
+
+    static bool readBodyState(CCPhysicsSprite *sprite, BodyState *state);
+
+#if CC_ENABLE_CHIPMUNK_INTEGRATION
+    cpSpace *_space;
+#elif CC_ENABLE_BOX2D_INTEGRATION
+    b2World *_world;
+    int _velocityIterations;
+    int _positionIterations;
+#endif
+
+    std::vector<Entry> _entries;
+
+    CCObject *_stepTarget;
+    SEL_SCHEDULE _stepSelector;
+
+    float _fixedTimeStep;
+    float _accumulator;
+    unsigned int _maxStepsPerFrame;
+    bool _interpolationEnabled;
+    bool _running;
+
+    unsigned int _totalSteps;
+    unsigned int _droppedSteps;
+};
+
+NS_CC_EXT_END
+
+#endif // __PHYSICSNODES_CCPHYSICSSTEPPER_H__
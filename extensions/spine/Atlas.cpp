@@ -287,6 +287,7 @@ Atlas* Atlas_readAtlasFile (const char* path) {
 	char *dir;
 	int length;
 	const char* data;
+	void* handle;
 
 	Atlas* atlas = 0;
 
@@ -300,10 +301,12 @@ Atlas* Atlas_readAtlasFile (const char* path) {
 	memcpy(dir, path, dirLength);
 	dir[dirLength] = '\0';
 
-	data = _Util_readFile(path, &length);
-	if (data) atlas = Atlas_readAtlas(data, length, dir);
+	data = _Util_openFile(path, &length, &handle);
+	if (data) {
+		atlas = Atlas_readAtlas(data, length, dir);
+		_Util_closeFile(handle);
+	}
 
-	FREE(data);
 	FREE(dir);
 	return atlas;
 }
@@ -163,7 +163,7 @@ void CCSkeleton::draw () {
 	if (debugSlots) {
 		// Slots.
 		ccDrawColor4B(0, 0, 255, 255);
-		glLineWidth(1);
+		ccGLLineWidth(1);
 		CCPoint points[4];
 		ccV3F_C4B_T2F_Quad quad;
 		for (int i = 0, n = skeleton->slotCount; i < n; i++) {
@@ -180,7 +180,7 @@ void CCSkeleton::draw () {
 	}
 	if (debugBones) {
 		// Bone lengths.
-		glLineWidth(2);
+		ccGLLineWidth(2);
 		ccDrawColor4B(255, 0, 0, 255);
 		for (int i = 0, n = skeleton->boneCount; i < n; i++) {
 			Bone *bone = skeleton->bones[i];
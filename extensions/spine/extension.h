@@ -97,6 +97,9 @@ namespace cocos2d { namespace extension {
 void _AtlasPage_createTexture (AtlasPage* self, const char* path);
 void _AtlasPage_disposeTexture (AtlasPage* self);
 char* _Util_readFile (const char* path, int* length);
+/* Read only contents of a file, which may be mapped in memory, released with _Util_closeFile. */
+const char* _Util_openFile (const char* path, int* length, void** handle);
+void _Util_closeFile (void* handle);
 
 /*
  * Internal API available for extension:
@@ -54,6 +54,22 @@ char* _Util_readFile (const char* path, int* length) {
 	return data;
 }
 
+const char* _Util_openFile (const char* path, int* length, void** handle) {
+	CCFileView* view = CCFileUtils::sharedFileUtils()->openFileView(
+		CCFileUtils::sharedFileUtils()->fullPathForFilename(path).c_str());
+	*handle = view;
+	if (!view) {
+		*length = 0;
+		return 0;
+	}
+	*length = view->getSize();
+	return reinterpret_cast<const char*>(view->getBytes());
+}
+
+void _Util_closeFile (void* handle) {
+	static_cast<CCFileView*>(handle)->release();
+}
+
 /**/
 
 void RegionAttachment_updateQuad (RegionAttachment* self, Slot* slot, ccV3F_C4B_T2F_Quad* quad, bool premultipliedAlpha) {
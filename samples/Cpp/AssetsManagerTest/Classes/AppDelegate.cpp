@@ -20,6 +20,11 @@ USING_NS_CC;
 USING_NS_CC_EXT;
 using namespace CocosDenshion;
 
+// Define it to test with a local server, e.g. -DASSETS_SERVER_URL="\"http://127.0.0.1:8000/\""
+#ifndef ASSETS_SERVER_URL
+#define ASSETS_SERVER_URL "https://raw.github.com/minggo/AssetsManagerTest/master/"
+#endif
+
 AppDelegate::AppDelegate()
 {
 
@@ -170,8 +175,8 @@ AssetsManager* UpdateLayer::getAssetsManager()
     
     if (! pAssetsManager)
     {
-        pAssetsManager = new AssetsManager("https://raw.github.com/minggo/AssetsManagerTest/master/package.zip",
-                                           "https://raw.github.com/minggo/AssetsManagerTest/master/version",
+        pAssetsManager = new AssetsManager(ASSETS_SERVER_URL "package.zip",
+                                           ASSETS_SERVER_URL "version",
                                            pathToSave.c_str());
         pAssetsManager->setDelegate(this);
         pAssetsManager->setConnectionTimeout(3);
@@ -213,6 +218,16 @@ void UpdateLayer::onError(AssetsManager::ErrorCode errorCode)
     {
         pProgressLabel->setString("network error");
     }
+    
+    if (errorCode == AssetsManager::kUncompress)
+    {
+        pProgressLabel->setString("uncompress error");
+    }
+    
+    if (errorCode == AssetsManager::kVerify)
+    {
+        pProgressLabel->setString("checksum error");
+    }
 }
 
 void UpdateLayer::onProgress(int percent)
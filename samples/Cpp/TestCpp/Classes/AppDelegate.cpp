@@ -48,12 +48,24 @@ bool AppDelegate::applicationDidFinishLaunching()
     CCEGLView::sharedOpenGLView()->setDesignResolutionSize(designSize.width, designSize.height, kResolutionNoBorder);
 
     CCScene * pScene = CCScene::create();
-    CCLayer * pLayer = new TestController();
+    TestController * pLayer = new TestController();
     pLayer->autorelease();
 
     pScene->addChild(pLayer);
     pDirector->runWithScene(pScene);
 
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    // "--test NAME" starts a test directly, to benchmark it with --benchmark FRAMES
+    const std::vector<std::string>& arguments = CCApplication::sharedApplication()->getArguments();
+    for (size_t i = 0; i + 1 < arguments.size(); ++i)
+    {
+        if (arguments[i] == "--test" && !pLayer->runTest(arguments[i + 1].c_str()))
+        {
+            CCLog("Unknown test %s", arguments[i + 1].c_str());
+        }
+    }
+#endif
+
     return true;
 }
 
@@ -55,8 +55,6 @@ ChipmunkTestLayer::ChipmunkTestLayer()
     CCMenu *menu = CCMenu::create(item, NULL);
     this->addChild(menu);
     menu->setPosition(ccp(VisibleRect::right().x-100, VisibleRect::top().y-60));
-
-    scheduleUpdate();
 #else
     CCLabelTTF *pLabel = CCLabelTTF::create("Should define CC_ENABLE_CHIPMUNK_INTEGRATION=1\n to run this test case",
                                             "Arial",
@@ -79,6 +77,10 @@ void ChipmunkTestLayer::toggleDebugCallback(CCObject* pSender)
 
 ChipmunkTestLayer::~ChipmunkTestLayer()
 {
+#if CC_ENABLE_CHIPMUNK_INTEGRATION
+    CC_SAFE_RELEASE(_stepper);
+#endif
+
     // manually Free rogue shapes
     for( int i=0;i<4;i++) {
         cpShapeFree( _walls[i] );
@@ -131,18 +133,11 @@ void ChipmunkTestLayer::initPhysics()
     // Physics debug layer
     _debugLayer = CCPhysicsDebugNode::create(_space);
     this->addChild(_debugLayer, Z_PHYSICS_DEBUG);
-#endif
-}
-
-void ChipmunkTestLayer::update(float delta)
-{
-    // Should use a fixed size step based on the animation interval.
-    int steps = 2;
-    float dt = CCDirector::sharedDirector()->getAnimationInterval()/(float)steps;
 
-    for(int i=0; i<steps; i++){
-        cpSpaceStep(_space, dt);
-    }
+    // Steps the space at a fixed rate and interpolates the sprites
+    _stepper = CCPhysicsStepper::create(_space, 1.0f/120.0f);
+    _stepper->retain();
+#endif
 }
 
 void ChipmunkTestLayer::createResetButton()
@@ -201,12 +196,27 @@ void ChipmunkTestLayer::addNewSpriteAtPosition(CCPoint pos)
 
     sprite->setCPBody(body);
     sprite->setPosition(pos);
+
+    _stepper->addSprite(sprite);
 #endif
 }
 
 void ChipmunkTestLayer::onEnter()
 {
     CCLayer::onEnter();
+
+#if CC_ENABLE_CHIPMUNK_INTEGRATION
+    _stepper->start();
+#endif
+}
+
+void ChipmunkTestLayer::onExit()
+{
+#if CC_ENABLE_CHIPMUNK_INTEGRATION
+    _stepper->stop();
+#endif
+
+    CCLayer::onExit();
 }
 
 void ChipmunkTestLayer::ccTouchesEnded(CCSet* touches, CCEvent* event)
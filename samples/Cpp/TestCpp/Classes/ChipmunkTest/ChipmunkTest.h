@@ -17,12 +17,12 @@ public:
     ChipmunkTestLayer();
     ~ChipmunkTestLayer();
     void onEnter();
+    void onExit();
     void initPhysics();
     void createResetButton();
     void reset(CCObject* sender);
 
     void addNewSpriteAtPosition(CCPoint p);
-    void update(float dt);
     void toggleDebugCallback(CCObject* pSender);
     virtual void ccTouchesEnded(CCSet* touches, CCEvent* event);
     virtual void didAccelerate(CCAcceleration* pAccelerationValue);
@@ -31,6 +31,7 @@ private:
     CCTexture2D* _spriteTexture; // weak ref
 #if CC_ENABLE_CHIPMUNK_INTEGRATION    
     CCPhysicsDebugNode* _debugLayer; // weak ref
+    CCPhysicsStepper* _stepper; // strong ref
 #endif
     cpSpace* _space; // strong ref
     cpShape* _walls[4];
@@ -628,6 +628,7 @@ void RawStencilBufferTest::draw()
         CHECK_GL_ERROR_DEBUG();
 
         ccDrawSolidRect(CCPointZero, stencilPoint, ccc4f(1, 1, 1, 1));
+        ccDrawFlush();
         
         kmGLPushMatrix();
         this->transform();
@@ -638,6 +639,7 @@ void RawStencilBufferTest::draw()
         CHECK_GL_ERROR_DEBUG();
         
         ccDrawSolidRect(CCPointZero, winPoint, _planeColor[i]);
+        ccDrawFlush();
         
         kmGLPushMatrix();
         this->transform();
@@ -814,6 +816,7 @@ void RawStencilBufferTest6::setupStencilForClippingOnPlane(GLint plane)
     glStencilFunc(GL_NEVER, 0, planeMask);
     glStencilOp(GL_REPLACE, GL_KEEP, GL_KEEP);
     ccDrawSolidRect(CCPointZero, ccpFromSize(CCDirector::sharedDirector()->getWinSize()), ccc4f(1, 1, 1, 1));
+    ccDrawFlush();
     glStencilFunc(GL_NEVER, planeMask, planeMask);
     glStencilOp(GL_REPLACE, GL_KEEP, GL_KEEP);
     glDisable(GL_DEPTH_TEST);
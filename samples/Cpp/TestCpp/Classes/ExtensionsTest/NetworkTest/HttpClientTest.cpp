@@ -5,8 +5,14 @@
 USING_NS_CC;
 USING_NS_CC_EXT;
 
+// Server used by the concurrent test, point it to a loopback server
+// (e.g. "python -m SimpleHTTPServer 8000" => "http://127.0.0.1:8000/") to test without internet access
+#define CONCURRENT_TEST_URL "http://httpbin.org/get"
+#define CONCURRENT_TEST_COUNT 12
+
 HttpClientTest::HttpClientTest() 
 : _labelStatusCode(NULL)
+, _concurrentPending(0)
 {
     CCSize winSize = CCDirector::sharedDirector()->getWinSize();
 
@@ -50,10 +56,16 @@ HttpClientTest::HttpClientTest()
     CCMenuItemLabel *itemDelete = CCMenuItemLabel::create(labelDelete, CC_CALLBACK_1(HttpClientTest::onMenuDeleteTestClicked, this));
     itemDelete->setPosition(ccp(winSize.width / 2, winSize.height - MARGIN - 5 * SPACE));
     menuRequest->addChild(itemDelete);
+
+    // Concurrent
+    CCLabelTTF *labelConcurrent = CCLabelTTF::create("Test Concurrent", "Arial", 22);
+    CCMenuItemLabel *itemConcurrent = CCMenuItemLabel::create(labelConcurrent, CC_CALLBACK_1(HttpClientTest::onMenuConcurrentTestClicked, this));
+    itemConcurrent->setPosition(ccp(winSize.width / 2, winSize.height - MARGIN - 6 * SPACE));
+    menuRequest->addChild(itemConcurrent);
     
     // Response Code Label
     _labelStatusCode = CCLabelTTF::create("HTTP Status Code", "Marker Felt", 20);
-    _labelStatusCode->setPosition(ccp(winSize.width / 2,  winSize.height - MARGIN - 6 * SPACE));
+    _labelStatusCode->setPosition(ccp(winSize.width / 2,  winSize.height - MARGIN - 7 * SPACE));
     addChild(_labelStatusCode);
     
     // Back Menu
@@ -245,12 +257,62 @@ void HttpClientTest::onMenuDeleteTestClicked(CCObject *sender)
     _labelStatusCode->setString("waiting...");
 }
 
+void HttpClientTest::onMenuConcurrentTestClicked(CCObject *sender)
+{
+    CCHttpClient::getInstance()->setMaxConcurrentRequests(4);
+
+    CCTime::gettimeofdayCocos2d(&_concurrentStart, NULL);
+    _concurrentPending = 0;
+
+    CCHttpRequest* cancelled = NULL;
+    for (int i = 0; i < CONCURRENT_TEST_COUNT; ++i)
+    {
+        char tag[32];
+        sprintf(tag, "CONCURRENT test%d", i);
+
+        CCHttpRequest* request = new CCHttpRequest();
+        request->setUrl(CONCURRENT_TEST_URL);
+        request->setRequestType(CCHttpRequest::kHttpGet);
+        request->setResponseCallback(this, httpresponse_selector(HttpClientTest::onHttpRequestCompleted));
+        request->setTag(tag);
+        // the last requests are started first
+        request->setPriority(i / 4);
+        CCHttpClient::getInstance()->send(request);
+        ++_concurrentPending;
+
+        if (i == CONCURRENT_TEST_COUNT - 1)
+        {
+            cancelled = request;
+        }
+        request->release();
+    }
+
+    // the callback of a cancelled request is never called
+    cancelled->retain();
+    CCHttpClient::getInstance()->cancel(cancelled);
+    cancelled->release();
+    --_concurrentPending;
+
+    // waiting
+    _labelStatusCode->setString("waiting...");
+}
+
 void HttpClientTest::onHttpRequestCompleted(CCHttpClient *sender, CCHttpResponse *response)
 {
     if (!response)
     {
         return;
     }
+
+    if (_concurrentPending > 0 && 0 == strncmp(response->getHttpRequest()->getTag(), "CONCURRENT", 10))
+    {
+        if (--_concurrentPending == 0)
+        {
+            struct cc_timeval now;
+            CCTime::gettimeofdayCocos2d(&now, NULL);
+            CCLog("Concurrent test: %d requests completed in %.1f ms", CONCURRENT_TEST_COUNT - 1, CCTime::timersubCocos2d(&_concurrentStart, &now));
+        }
+    }
     
     // You can get original request type from: response->request->reqType
     if (0 != strlen(response->getHttpRequest()->getTag())) 
@@ -17,12 +17,15 @@ public:
     void onMenuPostBinaryTestClicked(cocos2d::CCObject *sender);
     void onMenuPutTestClicked(cocos2d::CCObject *sender);
     void onMenuDeleteTestClicked(cocos2d::CCObject *sender);
+    void onMenuConcurrentTestClicked(cocos2d::CCObject *sender);
     
     //Http Response Callback
     void onHttpRequestCompleted(cocos2d::extension::CCHttpClient *sender, cocos2d::extension::CCHttpResponse *response);
 
 private:
     cocos2d::CCLabelTTF* _labelStatusCode;
+    cocos2d::cc_timeval _concurrentStart;
+    int _concurrentPending;
 };
 
 void runHttpClientTest();
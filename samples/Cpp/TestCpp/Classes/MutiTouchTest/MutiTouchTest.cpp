@@ -20,10 +20,10 @@ public:
     virtual void draw()
     {
         ccDrawColor4B(_touchColor.r, _touchColor.g, _touchColor.b, 255);
-        glLineWidth(10);
+        ccGLLineWidth(10);
         ccDrawLine( ccp(0, _touchPoint.y), ccp(getContentSize().width, _touchPoint.y) );
         ccDrawLine( ccp(_touchPoint.x, 0), ccp(_touchPoint.x, getContentSize().height) );
-        glLineWidth(1);
+        ccGLLineWidth(1);
         ccPointSize(30);
         ccDrawPoint(_touchPoint);
     }
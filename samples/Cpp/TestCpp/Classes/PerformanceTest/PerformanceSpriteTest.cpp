@@ -4,17 +4,22 @@ enum {
     kMaxNodes = 50000,
     kNodesIncrease = 250,
 
-    TEST_COUNT = 7,
+    TEST_COUNT = 9,
 };
 
 enum {
     kTagInfoLayer = 1,
     kTagMainLayer = 2,
+    kTagChurnLabel = 3,
     kTagMenuLayer = (kMaxNodes + 1000),
 };
 
 static int s_nSpriteCurCase = 0;
 
+// percentage of the sprites removed and added again each frame by the churn tests
+static const int s_churnRates[] = { 1, 5, 10, 25, 50 };
+static int s_nChurnRateIndex = 2;
+
 ////////////////////////////////////////////////////////
 //
 // SubTest
@@ -257,6 +262,12 @@ void SpriteMenuLayer::showCurrentTest()
     case 6:
         pScene = new SpritePerformTest7;
         break;
+    case 7:
+        pScene = new SpritePerformTest8;
+        break;
+    case 8:
+        pScene = new SpritePerformTest9;
+        break;
     }
     s_nSpriteCurCase = _curCase;
 
@@ -607,6 +618,139 @@ void SpritePerformTest7::doTest(CCSprite* sprite)
     performanceActions20(sprite);
 }
 
+////////////////////////////////////////////////////////
+//
+// SpriteChurnTest
+//
+////////////////////////////////////////////////////////
+SpriteChurnTest::SpriteChurnTest(bool bDeferred)
+: _deferred(bDeferred)
+, _churnTime(0)
+, _churnFrames(0)
+{
+}
+
+std::string SpriteChurnTest::title()
+{
+    char str[40] = {0};
+    sprintf(str, _deferred ? "I (%d) churn, deferred" : "H (%d) churn", subtestNumber);
+    std::string strRet = str;
+    return strRet;
+}
+
+void SpriteChurnTest::doTest(CCSprite* sprite)
+{
+    performancePosition(sprite);
+}
+
+void SpriteChurnTest::onEnter()
+{
+    SpriteMainScene::onEnter();
+
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+
+    CCMenuItemFont::setFontSize(24);
+    CCMenuItemFont *rate = CCMenuItemFont::create("change churn rate", CC_CALLBACK_1(SpriteChurnTest::onChangeRate, this));
+    rate->setColor(ccc3(0,200,20));
+    CCMenu *menu = CCMenu::create(rate, NULL);
+    menu->setPosition(ccp(s.width/2, s.height-150));
+    addChild(menu, 1);
+
+    CCLabelTTF *churnLabel = CCLabelTTF::create("", "Arial", 24);
+    churnLabel->setColor(ccc3(0,200,20));
+    churnLabel->setPosition(ccp(s.width/2, s.height-120));
+    addChild(churnLabel, 1, kTagChurnLabel);
+
+    CCSpriteBatchNode *batchNode = _subTest->getBatchNode();
+    if (batchNode)
+    {
+        batchNode->setDeferredAtlasUpdate(_deferred);
+    }
+
+    updateChurnLabel();
+    scheduleUpdate();
+}
+
+void SpriteChurnTest::onChangeRate(CCObject* pSender)
+{
+    s_nChurnRateIndex = (s_nChurnRateIndex + 1) % (sizeof(s_churnRates) / sizeof(s_churnRates[0]));
+    _churnTime = 0;
+    _churnFrames = 0;
+    updateChurnLabel();
+}
+
+void SpriteChurnTest::updateChurnLabel()
+{
+    CCLabelTTF *churnLabel = (CCLabelTTF *) getChildByTag(kTagChurnLabel);
+    char str[64] = {0};
+
+    if (! _subTest->getBatchNode())
+    {
+        sprintf(str, "churn needs a batch node subtest");
+    }
+    else if (_churnFrames == 0)
+    {
+        sprintf(str, "churn %d%% per frame", s_churnRates[s_nChurnRateIndex]);
+    }
+    else
+    {
+        sprintf(str, "churn %d%% per frame: %.3f ms", s_churnRates[s_nChurnRateIndex], _churnTime * 1000 / _churnFrames);
+    }
+    churnLabel->setString(str);
+}
+
+void SpriteChurnTest::update(float dt)
+{
+    CCSpriteBatchNode *batchNode = _subTest->getBatchNode();
+    if (! batchNode || batchNode->getChildrenCount() == 0)
+    {
+        return;
+    }
+
+    unsigned int count = batchNode->getChildrenCount();
+    unsigned int churn = count * s_churnRates[s_nChurnRateIndex] / 100;
+    if (churn == 0)
+    {
+        churn = 1;
+    }
+
+    // the removed sprites are added back, so the sprite creation isn't measured
+    CCArray *sprites = CCArray::createWithCapacity(churn);
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    for (unsigned int i = 0; i < churn; ++i)
+    {
+        CCNode *sprite = (CCNode*) batchNode->getChildren()->objectAtIndex(rand() % batchNode->getChildrenCount());
+        sprites->addObject(sprite);
+        batchNode->removeChild(sprite, false);
+    }
+
+    CCObject *pObj = NULL;
+    CCARRAY_FOREACH(sprites, pObj)
+    {
+        CCNode *sprite = (CCNode*) pObj;
+        batchNode->addChild(sprite, sprite->getZOrder(), sprite->getTag());
+    }
+
+    // the deferred mode pays its atlas compaction here
+    batchNode->sortAllChildren();
+
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    _churnTime += (now.tv_sec - start.tv_sec) + (now.tv_usec - start.tv_usec) / 1000000.0f;
+    _churnFrames++;
+
+    if (_churnFrames == 60)
+    {
+        updateChurnLabel();
+        CCLOG("%s, %u sprites, churn %d%%: %.3f ms per frame", title().c_str(), count, s_churnRates[s_nChurnRateIndex], _churnTime * 1000 / _churnFrames);
+        _churnTime = 0;
+        _churnFrames = 0;
+    }
+}
+
 void runSpriteTest()
 {
     SpriteMainScene* pScene = new SpritePerformTest1;
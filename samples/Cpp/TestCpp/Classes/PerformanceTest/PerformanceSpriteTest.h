@@ -10,6 +10,7 @@ public:
     void removeByTag(int tag);
     CCSprite* createSpriteWithTag(int tag);
     void initWithSubTest(int nSubTest, CCNode* parent);
+    CCSpriteBatchNode* getBatchNode() { return batchNode; }
 
 protected:
     int                    subtestNumber;
@@ -102,6 +103,38 @@ public:
     virtual std::string title();
 };
 
+class SpriteChurnTest : public SpriteMainScene
+{
+public:
+    SpriteChurnTest(bool bDeferred);
+
+    virtual void onEnter();
+    virtual void update(float dt);
+    virtual void doTest(CCSprite* sprite);
+    virtual std::string title();
+
+    void onChangeRate(CCObject* pSender);
+
+protected:
+    void updateChurnLabel();
+
+    bool            _deferred;
+    float           _churnTime;
+    int             _churnFrames;
+};
+
+class SpritePerformTest8 : public SpriteChurnTest
+{
+public:
+    SpritePerformTest8() : SpriteChurnTest(false) {}
+};
+
+class SpritePerformTest9 : public SpriteChurnTest
+{
+public:
+    SpritePerformTest9() : SpriteChurnTest(true) {}
+};
+
 void runSpriteTest();
 
 #endif
@@ -5,6 +5,7 @@
 #include "PerformanceSpriteTest.h"
 #include "PerformanceTextureTest.h"
 #include "PerformanceTouchesTest.h"
+#include "PerformanceZipTest.h"
 
 enum
 {
@@ -22,6 +23,7 @@ struct {
 	{ "PerformanceSpriteTest",[](CCObject*sender){runSpriteTest();} },
 	{ "PerformanceTextureTest",[](CCObject*sender){runTextureTest();} },
 	{ "PerformanceTouchesTest",[](CCObject*sender){runTouchesTest();} },
+	{ "PerformanceZipTest",[](CCObject*sender){runZipTest();} },
 };
 
 static const int g_testMax = sizeof(g_testsName)/sizeof(g_testsName[0]);
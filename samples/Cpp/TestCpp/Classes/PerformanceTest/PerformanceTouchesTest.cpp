@@ -2,9 +2,14 @@
 
 enum
 {
-    TEST_COUNT = 2,
+    TEST_COUNT = 3,
 };
 
+// a grid of kHitTestTargetColumns * kHitTestTargetRows targets
+static const int kHitTestTargetColumns = 20;
+static const int kHitTestTargetRows = 20;
+static const int kHitTestTouchesPerFrame = 100;
+
 static int s_nTouchCurCase = 0;
 
 ////////////////////////////////////////////////////////
@@ -23,6 +28,9 @@ void TouchesMainScene::showCurrentTest()
     case 1:
         pLayer = new TouchesPerformTest2(true, TEST_COUNT, _curCase);
         break;
+    case 2:
+        pLayer = new TouchesPerformTest3(true, TEST_COUNT, _curCase);
+        break;
     }
     s_nTouchCurCase = _curCase;
 
@@ -165,6 +173,167 @@ void TouchesPerformTest2::ccTouchesCancelled(CCSet* touches, CCEvent* event)
     numberOfTouchesC += touches->count();
 }
 
+////////////////////////////////////////////////////////
+//
+// HitTestTarget
+//
+////////////////////////////////////////////////////////
+HitTestTarget* HitTestTarget::create(const ccColor4B& color, float width, float height)
+{
+    HitTestTarget* pRet = new HitTestTarget();
+    if (pRet && pRet->initWithColor(color, width, height))
+    {
+        pRet->_claims = NULL;
+        pRet->autorelease();
+        return pRet;
+    }
+    CC_SAFE_DELETE(pRet);
+    return NULL;
+}
+
+void HitTestTarget::registerWithTouchDispatcher()
+{
+    CCTouchDispatcher* pDispatcher = CCDirector::sharedDirector()->getTouchDispatcher();
+    pDispatcher->addTargetedDelegate(this, 0, true);
+    pDispatcher->setHitTestNode(this, this);
+}
+
+bool HitTestTarget::ccTouchBegan(CCTouch* touch, CCEvent* event)
+{
+    // the same test as CCControl::isTouchInside
+    CCPoint location = getParent()->convertToNodeSpace(touch->getLocation());
+    if (!boundingBox().containsPoint(location))
+    {
+        return false;
+    }
+    ++*_claims;
+    return true;
+}
+
+////////////////////////////////////////////////////////
+//
+// TouchesPerformTest3
+//
+////////////////////////////////////////////////////////
+void TouchesPerformTest3::onEnter()
+{
+    TouchesMainScene::onEnter();
+
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+    _area = CCRectMake(s.width * 0.1f, s.height * 0.25f, s.width * 0.8f, s.height * 0.5f);
+    _moving = false;
+    _indexedClaims = _linearClaims = _touchCount = 0;
+    _indexedTime = _linearTime = 0;
+
+    _targets = CCNode::create();
+    _targets->setContentSize(_area.size);
+    _targets->setAnchorPoint(ccp(0.5f, 0.5f));
+    _targets->setPosition(ccp(_area.getMidX(), _area.getMidY()));
+    addChild(_targets);
+
+    float width = _area.size.width / kHitTestTargetColumns;
+    float height = _area.size.height / kHitTestTargetRows;
+    for (int row = 0; row < kHitTestTargetRows; ++row)
+    {
+        for (int column = 0; column < kHitTestTargetColumns; ++column)
+        {
+            GLubyte shade = (GLubyte)(((row + column) % 2) ? 160 : 96);
+            HitTestTarget* pTarget = HitTestTarget::create(ccc4(shade, shade, 255, 255), width * 0.8f, height * 0.8f);
+            pTarget->setPosition(ccp(column * width + width * 0.1f, row * height + height * 0.1f));
+            _targets->addChild(pTarget);
+            pTarget->setTouchEnabled(true);
+        }
+    }
+
+    CCMenuItemFont::setFontSize(18);
+    CCMenuItemFont* pToggle = CCMenuItemFont::create("Toggle moving targets", this, menu_selector(TouchesPerformTest3::toggleMoving));
+    CCMenu* pMenu = CCMenu::create(pToggle, NULL);
+    pMenu->setPosition(ccp(s.width / 2, s.height - 90));
+    addChild(pMenu, 1);
+}
+
+void TouchesPerformTest3::onExit()
+{
+    CCDirector::sharedDirector()->getTouchDispatcher()->setHitTestIndexEnabled(true);
+    TouchesMainScene::onExit();
+}
+
+std::string TouchesPerformTest3::title()
+{
+    return "Hit test index";
+}
+
+void TouchesPerformTest3::toggleMoving(CCObject* pSender)
+{
+    _moving = !_moving;
+}
+
+float TouchesPerformTest3::dispatchTouches(const std::vector<CCPoint>& points, bool bIndexEnabled, int* pClaims)
+{
+    CCDirector* pDirector = CCDirector::sharedDirector();
+    CCTouchDispatcher* pDispatcher = pDirector->getTouchDispatcher();
+    pDispatcher->setHitTestIndexEnabled(bIndexEnabled);
+
+    CCTouch* pTouch = new CCTouch();
+    CCSet* pTouches = new CCSet();
+    pTouches->addObject(pTouch);
+
+    CCObject* pObject = NULL;
+    CCARRAY_FOREACH(_targets->getChildren(), pObject)
+    {
+        ((HitTestTarget*)pObject)->setClaimCounter(pClaims);
+    }
+
+    struct timeval start, now;
+    gettimeofday(&start, NULL);
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+        CCPoint location = pDirector->convertToUI(points[i]);
+        pTouch->setTouchInfo(0, location.x, location.y);
+        pDispatcher->touchesBegan(pTouches, NULL);
+        pDispatcher->touchesEnded(pTouches, NULL);
+    }
+    gettimeofday(&now, NULL);
+
+    pTouches->release();
+    pTouch->release();
+    pDispatcher->setHitTestIndexEnabled(true);
+
+    return (now.tv_sec - start.tv_sec) + (now.tv_usec - start.tv_usec) / 1000000.0f;
+}
+
+void TouchesPerformTest3::update(float dt)
+{
+    if (_moving)
+    {
+        // every bounds has to be refreshed
+        _targets->setRotation(_targets->getRotation() + dt * 10);
+    }
+
+    std::vector<CCPoint> points(kHitTestTouchesPerFrame);
+    for (int i = 0; i < kHitTestTouchesPerFrame; ++i)
+    {
+        points[i] = ccp(_area.origin.x + CCRANDOM_0_1() * _area.size.width, _area.origin.y + CCRANDOM_0_1() * _area.size.height);
+    }
+
+    _indexedTime += dispatchTouches(points, true, &_indexedClaims);
+    _linearTime += dispatchTouches(points, false, &_linearClaims);
+    _touchCount += kHitTestTouchesPerFrame;
+
+    elapsedTime += dt;
+    if (elapsedTime > 1.0f)
+    {
+        char str[96] = {0};
+        sprintf(str, "indexed %.2f us, linear %.2f us per touch\nclaimed %d / %d", _indexedTime * 1000000 / _touchCount,
+                _linearTime * 1000000 / _touchCount, _indexedClaims, _linearClaims);
+        _plabel->setString(str);
+
+        elapsedTime = 0;
+        _indexedClaims = _linearClaims = _touchCount = 0;
+        _indexedTime = _linearTime = 0;
+    }
+}
+
 void runTouchesTest()
 {
     s_nTouchCurCase = 0;
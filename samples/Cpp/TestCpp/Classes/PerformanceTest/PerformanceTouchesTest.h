@@ -2,6 +2,7 @@
 #define __PERFORMANCE_TOUCHES_TEST_H__
 
 #include "PerformanceTest.h"
+#include <vector>
 
 class TouchesMainScene : public PerformBasicLayer
 {
@@ -61,6 +62,50 @@ public:
     virtual void ccTouchesCancelled(CCSet* touches, CCEvent* event);
 };
 
+class HitTestTarget : public CCLayerColor
+{
+public:
+    static HitTestTarget* create(const ccColor4B& color, float width, float height);
+
+    /** Counter incremented by the claimed touches. */
+    void setClaimCounter(int* pClaims) { _claims = pClaims; }
+
+    virtual void registerWithTouchDispatcher();
+    virtual bool ccTouchBegan(CCTouch* touch, CCEvent* event);
+
+protected:
+    int* _claims;
+};
+
+class TouchesPerformTest3 : public TouchesMainScene
+{
+public:
+    TouchesPerformTest3(bool bControlMenuVisible, int nMaxCases = 0, int nCurCase = 0)
+        : TouchesMainScene(bControlMenuVisible, nMaxCases, nCurCase)
+    {
+    }
+
+    virtual void onEnter();
+    virtual void onExit();
+    virtual std::string title();
+    virtual void update(float dt);
+
+    void toggleMoving(CCObject* pSender);
+
+protected:
+    /** Sends the touches to the dispatcher and returns the elapsed time. */
+    float dispatchTouches(const std::vector<CCPoint>& points, bool bIndexEnabled, int* pClaims);
+
+    CCNode*         _targets;
+    CCRect          _area;
+    bool            _moving;
+    int             _indexedClaims;
+    int             _linearClaims;
+    int             _touchCount;
+    float           _indexedTime;
+    float           _linearTime;
+};
+
 void runTouchesTest();
 
 #endif
@@ -0,0 +1,462 @@
+#include "PerformanceZipTest.h"
+#include "support/zip_support/ZipUtils.h"
+#include "support/zip_support/ccLZ4.h"
+#include "support/zip_support/unzip.h"
+#include <zlib.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+enum
+{
+    TEST_COUNT = 3,
+    kThreadCount = 4,
+};
+
+static int s_nZipCurCase = 0;
+
+struct TestZipEntry
+{
+    std::string name;
+    std::vector<unsigned char> data;
+    bool deflated;
+};
+
+static double millisecondsSince(const struct timeval& start)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (now.tv_sec - start.tv_sec) * 1000.0 + (now.tv_usec - start.tv_usec) / 1000.0;
+}
+
+// text made of random words, which deflates about as well as game data
+static void fillTestData(std::vector<unsigned char>& data, unsigned int size, unsigned int seed)
+{
+    static const char* words[] = { "sprite", "frame", "texture", "rect", "offset", "rotated", "0", "1", "32", "128", "<key>", "</key>", "\n" };
+    data.clear();
+    data.reserve(size);
+    while (data.size() < size)
+    {
+        seed = seed * 1103515245 + 12345;
+        const char* word = words[(seed >> 16) % (sizeof(words) / sizeof(words[0]))];
+        data.insert(data.end(), word, word + strlen(word));
+        data.push_back(' ');
+    }
+    data.resize(size);
+}
+
+static void writeUInt16(std::vector<unsigned char>& out, unsigned int value)
+{
+    out.push_back(value & 0xff);
+    out.push_back((value >> 8) & 0xff);
+}
+
+static void writeUInt32(std::vector<unsigned char>& out, unsigned int value)
+{
+    writeUInt16(out, value & 0xffff);
+    writeUInt16(out, value >> 16);
+}
+
+static bool writeTestZip(const std::string& path, const std::vector<TestZipEntry>& entries)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (! file)
+    {
+        return false;
+    }
+
+    std::vector<unsigned char> directory;
+    unsigned int offset = 0;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const TestZipEntry& entry = entries[i];
+        unsigned int crc = crc32(crc32(0L, Z_NULL, 0), &entry.data[0], entry.data.size());
+
+        std::vector<unsigned char> compressed;
+        if (entry.deflated)
+        {
+            z_stream stream;
+            memset(&stream, 0, sizeof(stream));
+            deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+            compressed.resize(deflateBound(&stream, entry.data.size()));
+            stream.next_in = (Bytef*)&entry.data[0];
+            stream.avail_in = entry.data.size();
+            stream.next_out = &compressed[0];
+            stream.avail_out = compressed.size();
+            deflate(&stream, Z_FINISH);
+            compressed.resize(stream.total_out);
+            deflateEnd(&stream);
+        }
+        const std::vector<unsigned char>& stored = entry.deflated ? compressed : entry.data;
+
+        std::vector<unsigned char> header;
+        writeUInt32(header, 0x04034b50);
+        writeUInt16(header, 20);
+        writeUInt16(header, 0);
+        writeUInt16(header, entry.deflated ? 8 : 0);
+        writeUInt16(header, 0);
+        writeUInt16(header, 0x21);
+        writeUInt32(header, crc);
+        writeUInt32(header, stored.size());
+        writeUInt32(header, entry.data.size());
+        writeUInt16(header, entry.name.length());
+        writeUInt16(header, 0);
+        header.insert(header.end(), entry.name.begin(), entry.name.end());
+        fwrite(&header[0], 1, header.size(), file);
+        fwrite(&stored[0], 1, stored.size(), file);
+
+        writeUInt32(directory, 0x02014b50);
+        writeUInt16(directory, 20);
+        directory.insert(directory.end(), header.begin() + 4, header.begin() + 30);
+        writeUInt16(directory, 0);
+        writeUInt16(directory, 0);
+        writeUInt16(directory, 0);
+        writeUInt32(directory, 0);
+        writeUInt32(directory, offset);
+        directory.insert(directory.end(), entry.name.begin(), entry.name.end());
+
+        offset += header.size() + stored.size();
+    }
+
+    unsigned int directorySize = directory.size();
+    writeUInt32(directory, 0x06054b50);
+    writeUInt16(directory, 0);
+    writeUInt16(directory, 0);
+    writeUInt16(directory, entries.size());
+    writeUInt16(directory, entries.size());
+    writeUInt32(directory, directorySize);
+    writeUInt32(directory, offset);
+    writeUInt16(directory, 0);
+    fwrite(&directory[0], 1, directory.size(), file);
+
+    return fclose(file) == 0;
+}
+
+static void writeUInt16BigEndian(unsigned char* out, unsigned int value)
+{
+    out[0] = (value >> 8) & 0xff;
+    out[1] = value & 0xff;
+}
+
+static void writeUInt32BigEndian(unsigned char* out, unsigned int value)
+{
+    writeUInt16BigEndian(out, value >> 16);
+    writeUInt16BigEndian(out + 2, value & 0xffff);
+}
+
+// packs data like tools/ccz_packer
+static bool packCCZ(const unsigned char* data, unsigned int length, int compression, std::vector<unsigned char>& out)
+{
+    const unsigned int headerSize = sizeof(struct CCZHeader);
+    unsigned long packedLength = 0;
+    if (compression == CCZ_COMPRESSION_LZ4)
+    {
+        out.resize(headerSize + ccLZ4CompressBound(length));
+        packedLength = ccLZ4Compress(data, length, &out[headerSize], out.size() - headerSize);
+    }
+    else
+    {
+        uLongf bound = compressBound(length);
+        out.resize(headerSize + bound);
+        if (compress2(&out[headerSize], &bound, data, length, Z_BEST_COMPRESSION) == Z_OK)
+        {
+            packedLength = bound;
+        }
+    }
+    if (packedLength == 0)
+    {
+        return false;
+    }
+
+    memcpy(&out[0], "CCZ!", 4);
+    writeUInt16BigEndian(&out[4], compression);
+    writeUInt16BigEndian(&out[6], 2);
+    writeUInt32BigEndian(&out[8], 0);
+    writeUInt32BigEndian(&out[12], length);
+    out.resize(headerSize + packedLength);
+    return true;
+}
+
+struct ZipReadJob
+{
+    std::string zipPath;
+    const std::vector<std::string>* names;
+    unsigned int first;
+    unsigned int step;
+    unsigned long long bytes;
+};
+
+static void* readZipFiles(void* data)
+{
+    ZipReadJob* job = (ZipReadJob*)data;
+    for (unsigned int i = job->first; i < job->names->size(); i += job->step)
+    {
+        unsigned long size = 0;
+        unsigned char* buffer = CCFileUtils::sharedFileUtils()->getFileDataFromZip(job->zipPath.c_str(), (*job->names)[i].c_str(), &size);
+        job->bytes += size;
+        CC_SAFE_DELETE_ARRAY(buffer);
+    }
+    return NULL;
+}
+
+////////////////////////////////////////////////////////
+//
+// ZipTest
+//
+////////////////////////////////////////////////////////
+void ZipTest::showCurrentTest()
+{
+    s_nZipCurCase = _curCase;
+    CCDirector::sharedDirector()->replaceScene(ZipTest::scene());
+}
+
+void ZipTest::onEnter()
+{
+    PerformBasicLayer::onEnter();
+
+    CCSize s = CCDirector::sharedDirector()->getWinSize();
+
+    CCLabelTTF *label = CCLabelTTF::create(title().c_str(), "Arial", 40);
+    addChild(label, 1);
+    label->setPosition(ccp(s.width/2, s.height-32));
+    label->setColor(ccc3(255,255,40));
+
+    CCLabelTTF *l = CCLabelTTF::create(subtitle().c_str(), "Thonburi", 16);
+    addChild(l, 1);
+    l->setPosition(ccp(s.width/2, s.height-80));
+
+    performTests();
+
+    CCLabelTTF *results = CCLabelTTF::create(_results.c_str(), "Arial", 16);
+    addChild(results, 1);
+    results->setPosition(ccp(s.width/2, s.height/2));
+}
+
+void ZipTest::addResult(const char* name, double ms, unsigned long long bytes, unsigned int files)
+{
+    char line[256];
+    snprintf(line, sizeof(line), "%s: %.1f ms, %.0f files/s, %.1f MB/s", name, ms,
+             files * 1000.0 / ms, bytes / (ms * 1000.0));
+    CCLog("%s", line);
+    _results.append(line).append("\n");
+}
+
+void ZipTest::addCodecResult(const char* name, double ms, unsigned long long bytes, unsigned long packedSize, unsigned long size)
+{
+    char line[256];
+    snprintf(line, sizeof(line), "%s: %.1f ms, %.1f MB/s, %.1f%% of %lu bytes", name, ms,
+             bytes / (ms * 1000.0), packedSize * 100.0 / size, size);
+    CCLog("%s", line);
+    _results.append(line).append("\n");
+}
+
+void ZipTest::performCodecTests()
+{
+    static const char* files[] = {
+        "Images/test_image_rgba4444.pvr.ccz",
+        "Images/nonencryptedAtlas.pvr.ccz",
+        "hd/Images/only_in_hd.pvr.ccz",
+    };
+    // decode the small files often enough to measure them
+    static const unsigned int kMinDecodedBytes = 64 * 1024 * 1024;
+
+    for (unsigned int i = 0; i < sizeof(files) / sizeof(files[0]); ++i)
+    {
+        std::string path = CCFileUtils::sharedFileUtils()->fullPathForFilename(files[i]);
+        unsigned char* data = NULL;
+        int length = ZipUtils::ccInflateCCZFile(path.c_str(), &data);
+        if (length <= 0)
+        {
+            _results.append("Can't read ").append(files[i]).append("\n");
+            continue;
+        }
+
+        // the resources are zlib files, re-encode them with both codecs
+        std::vector<unsigned char> packed[2];
+        bool packedZlib = packCCZ(data, length, CCZ_COMPRESSION_ZLIB, packed[0]);
+        bool packedLZ4 = packCCZ(data, length, CCZ_COMPRESSION_LZ4, packed[1]);
+        free(data);
+        if (! packedZlib || ! packedLZ4)
+        {
+            _results.append("Can't pack ").append(files[i]).append("\n");
+            continue;
+        }
+
+        CCLog("--- %s ---", files[i]);
+        _results.append(files[i]).append("\n");
+        unsigned int rounds = kMinDecodedBytes / length + 1;
+        for (unsigned int codec = 0; codec < 2; ++codec)
+        {
+            struct timeval start;
+            unsigned long long bytes = 0;
+            gettimeofday(&start, NULL);
+            for (unsigned int round = 0; round < rounds; ++round)
+            {
+                unsigned char* out = NULL;
+                int decoded = ZipUtils::ccInflateCCZBuffer(&packed[codec][0], packed[codec].size(), &out);
+                CCAssert(decoded == length, "ZipTest: CCZ decoding failed");
+                bytes += decoded;
+                free(out);
+            }
+            addCodecResult(codec == 0 ? "  zlib" : "  lz4", millisecondsSince(start), bytes, packed[codec].size(), length);
+        }
+    }
+}
+
+void ZipTest::performTests()
+{
+    if (s_nZipCurCase == 2)
+    {
+        performCodecTests();
+        return;
+    }
+
+    // small files: many entries, dominated by the lookups; large files: dominated by inflate and copies
+    bool small = s_nZipCurCase == 0;
+    unsigned int fileCount = small ? 2000 : 8;
+    unsigned int fileSize = small ? 4 * 1024 : 8 * 1024 * 1024;
+
+    std::string zipPath = CCFileUtils::sharedFileUtils()->getWritablePath() + (small ? "zip_test_small.zip" : "zip_test_large.zip");
+    std::vector<std::string> names;
+    unsigned long long totalSize = 0;
+    for (unsigned int i = 0; i < fileCount; ++i)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "assets/data/file%04u.txt", i);
+        names.push_back(name);
+        totalSize += fileSize;
+    }
+
+    if (! CCFileUtils::sharedFileUtils()->isFileExist(zipPath))
+    {
+        // half of the large files are stored, like the already compressed files of a game
+        std::vector<TestZipEntry> entries(fileCount);
+        for (unsigned int i = 0; i < fileCount; ++i)
+        {
+            entries[i].name = names[i];
+            entries[i].deflated = small || i % 2 == 0;
+            fillTestData(entries[i].data, fileSize, i);
+        }
+        if (! writeTestZip(zipPath, entries))
+        {
+            _results = "Can't write " + zipPath;
+            return;
+        }
+    }
+
+    CCLog("--- %s: %u files of %u bytes ---", small ? "small files" : "large files", fileCount, fileSize);
+    CCFileUtils::sharedFileUtils()->purgeCachedEntries();
+
+    struct timeval start;
+    unsigned long long bytes = 0;
+
+    // what reading a zip used to cost: minizip opens the zip and searches the file for every file
+    gettimeofday(&start, NULL);
+    for (unsigned int i = 0; i < fileCount; ++i)
+    {
+        unzFile file = unzOpen(zipPath.c_str());
+        unz_file_info info;
+        if (file && unzLocateFile(file, names[i].c_str(), 1) == UNZ_OK
+            && unzGetCurrentFileInfo(file, &info, NULL, 0, NULL, 0, NULL, 0) == UNZ_OK
+            && unzOpenCurrentFile(file) == UNZ_OK)
+        {
+            unsigned char* buffer = new unsigned char[info.uncompressed_size];
+            int size = unzReadCurrentFile(file, buffer, info.uncompressed_size);
+            bytes += size > 0 ? size : 0;
+            delete [] buffer;
+            unzCloseCurrentFile(file);
+        }
+        if (file)
+        {
+            unzClose(file);
+        }
+    }
+    addResult("minizip, reopened", millisecondsSince(start), bytes, fileCount);
+
+    // the directory parsed again for every file, the archive is released at once to close its file
+    gettimeofday(&start, NULL);
+    bytes = 0;
+    for (unsigned int i = 0; i < fileCount; ++i)
+    {
+        ZipArchive* archive = new ZipArchive();
+        unsigned long size = 0;
+        unsigned char* buffer = archive->initWithFile(zipPath.c_str()) ? archive->getFileData(names[i], &size) : NULL;
+        bytes += size;
+        CC_SAFE_DELETE_ARRAY(buffer);
+        archive->release();
+    }
+    addResult("reopened archive", millisecondsSince(start), bytes, fileCount);
+
+    ZipReadJob job = { zipPath, &names, 0, 1, 0 };
+    gettimeofday(&start, NULL);
+    readZipFiles(&job);
+    addResult("indexed archive", millisecondsSince(start), job.bytes, fileCount);
+
+    ZipReadJob jobs[kThreadCount];
+    pthread_t threads[kThreadCount];
+    gettimeofday(&start, NULL);
+    for (unsigned int i = 0; i < kThreadCount; ++i)
+    {
+        ZipReadJob threadJob = { zipPath, &names, i, kThreadCount, 0 };
+        jobs[i] = threadJob;
+        pthread_create(&threads[i], NULL, readZipFiles, &jobs[i]);
+    }
+    bytes = 0;
+    for (unsigned int i = 0; i < kThreadCount; ++i)
+    {
+        pthread_join(threads[i], NULL);
+        bytes += jobs[i].bytes;
+    }
+    addResult("indexed archive, 4 threads", millisecondsSince(start), bytes, fileCount);
+
+    // stored files of mapped archives are not copied
+    gettimeofday(&start, NULL);
+    bytes = 0;
+    for (unsigned int i = 0; i < fileCount; ++i)
+    {
+        CCFileView* view = CCFileUtils::sharedFileUtils()->openFileViewFromZip(zipPath.c_str(), names[i].c_str());
+        if (view)
+        {
+            bytes += view->getSize();
+            view->release();
+        }
+    }
+    addResult("file views", millisecondsSince(start), bytes, fileCount);
+    CCAssert(bytes == totalSize, "ZipTest: files missing from the archive");
+
+    CCFileUtils::sharedFileUtils()->purgeCachedEntries();
+}
+
+std::string ZipTest::title()
+{
+    switch (s_nZipCurCase)
+    {
+    case 0:
+        return "Zip Performance Test: 2000 small files";
+    case 1:
+        return "Zip Performance Test: 8 large files";
+    default:
+        return "Zip Performance Test: CCZ codecs";
+    }
+}
+
+std::string ZipTest::subtitle()
+{
+    return "See console for results";
+}
+
+CCScene* ZipTest::scene()
+{
+    CCScene *pScene = CCScene::create();
+    ZipTest *layer = new ZipTest(true, TEST_COUNT, s_nZipCurCase);
+    pScene->addChild(layer);
+    layer->release();
+
+    return pScene;
+}
+
+void runZipTest()
+{
+    s_nZipCurCase = 0;
+    CCScene* pScene = ZipTest::scene();
+    CCDirector::sharedDirector()->replaceScene(pScene);
+}
@@ -0,0 +1,33 @@
+#ifndef __PERFORMANCE_ZIP_TEST_H__
+#define __PERFORMANCE_ZIP_TEST_H__
+
+#include "PerformanceTest.h"
+
+class ZipTest : public PerformBasicLayer
+{
+public:
+    ZipTest(bool bControlMenuVisible, int nMaxCases = 0, int nCurCase = 0)
+        :PerformBasicLayer(bControlMenuVisible, nMaxCases, nCurCase)
+    {
+    }
+
+    virtual void showCurrentTest();
+    virtual void onEnter();
+    virtual std::string title();
+    virtual std::string subtitle();
+
+    void performTests();
+    void performCodecTests();
+
+    static CCScene* scene();
+
+private:
+    void addResult(const char* name, double ms, unsigned long long bytes, unsigned int files);
+    void addCodecResult(const char* name, double ms, unsigned long long bytes, unsigned long packedSize, unsigned long size);
+
+    std::string _results;
+};
+
+void runZipTest();
+
+#endif
@@ -146,6 +146,24 @@ void TestController::menuCallback(CCObject * pSender)
     }
 }
 
+bool TestController::runTest(const char* name)
+{
+    for (int i = 0; i < g_testCount; ++i)
+    {
+        if (strcmp(g_aTestNames[i].test_name, name) == 0)
+        {
+            TestScene* pScene = g_aTestNames[i].callback();
+            if (pScene)
+            {
+                pScene->runThisTest();
+                pScene->release();
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
 void TestController::closeCallback(CCObject * pSender)
 {
     CCDirector::sharedDirector()->end();
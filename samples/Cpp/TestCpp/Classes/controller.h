@@ -12,6 +12,8 @@ public:
     ~TestController();
 
     void menuCallback(CCObject * pSender);
+    /** Runs the test of the given name, returns false if there is none. */
+    bool runTest(const char* name);
     void closeCallback(CCObject * pSender);
 
     virtual void ccTouchesBegan(CCSet *pTouches, CCEvent *pEvent);
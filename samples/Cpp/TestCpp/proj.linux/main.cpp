@@ -13,6 +13,8 @@ int main(int argc, char **argv)
 {
     // create the application instance
     AppDelegate app;
+    // --headless, --null-renderer, --benchmark FRAMES... see CCApplication::parseCommandLine
+    CCApplication::sharedApplication()->parseCommandLine(argc, argv);
     CCEGLView* eglView = CCEGLView::sharedOpenGLView();
     eglView->setFrameSize(800, 480);
     return CCApplication::sharedApplication()->run();
@@ -37,7 +37,7 @@ local function drawPrimitivesTest()
     local layer = getBaseLayer()
     
     ccDrawLine( ccp(0, s.height),  ccp(s.width, 0) );
-	glLineWidth( 5.0);
+	ccGLLineWidth( 5.0);
 	ccDrawColor4B(255,0,0,255);
     ccDrawLine(ccp(0, 0), ccp(s.width, s.height) );
     
@@ -56,14 +56,14 @@ local function drawPrimitivesTest()
 --  CHECK_GL_ERROR_DEBUG();
 --
 --  // draw a green circle with 10 segments
---  glLineWidth(16);
+--  ccGLLineWidth(16);
 --  ccDrawColor4B(0, 255, 0, 255);
 --  ccDrawCircle( VisibleRect::center(), 100, 0, 10, false);
 --
 --  CHECK_GL_ERROR_DEBUG();
 --
 --  // draw a green circle with 50 segments with line to center
---  glLineWidth(2);
+--  ccGLLineWidth(2);
 --  ccDrawColor4B(0, 255, 255, 255);
 --  ccDrawCircle( VisibleRect::center(), 50, CC_DEGREES_TO_RADIANS(90), 50, true);
 --
@@ -71,21 +71,21 @@ local function drawPrimitivesTest()
 --
 --  // open yellow poly
 --  ccDrawColor4B(255, 255, 0, 255);
---  glLineWidth(10);
+--  ccGLLineWidth(10);
 --  CCPoint vertices[] = { ccp(0,0), ccp(50,50), ccp(100,50), ccp(100,100), ccp(50,100) };
 --  ccDrawPoly( vertices, 5, false);
 --
 --  CHECK_GL_ERROR_DEBUG();
 --
 --  // filled poly
---  glLineWidth(1);
+--  ccGLLineWidth(1);
 --  CCPoint filledVertices[] = { ccp(0,120), ccp(50,120), ccp(50,170), ccp(25,200), ccp(0,170) };
 --  ccDrawSolidPoly(filledVertices, 5, ccc4f(0.5f, 0.5f, 1, 1 ) );
 --
 --
 --  // closed purble poly
 --  ccDrawColor4B(255, 0, 255, 255);
---  glLineWidth(2);
+--  ccGLLineWidth(2);
 --  CCPoint vertices2[] = { ccp(30,130), ccp(30,230), ccp(50,200) };
 --  ccDrawPoly( vertices2, 3, true);
 --
@@ -106,7 +106,7 @@ local function drawPrimitivesTest()
 --  ccDrawSolidPoly( vertices3, 4, ccc4f(1,1,0,1) );
 --
 --  // restore original values
---  glLineWidth(1);
+--  ccGLLineWidth(1);
 --  ccDrawColor4B(255,255,255,255);
 --  ccPointSize(1);
 --
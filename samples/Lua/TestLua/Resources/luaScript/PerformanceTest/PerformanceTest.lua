@@ -1,6 +1,6 @@
 require "luaScript/PerformanceTest/PerformanceSpriteTest"
 
-local MAX_COUNT     = 5
+local MAX_COUNT     = 7
 local LINE_SPACE    = 40
 local kItemTagBasic = 1000
 
@@ -10,7 +10,9 @@ local testsName =
     "PerformanceParticleTest",
     "PerformanceSpriteTest",
     "PerformanceTextureTest",
-    "PerformanceTouchesTest"
+    "PerformanceTouchesTest",
+    "PerformanceScheduleTest",
+    "PerformanceValueTypeTest"
 }
 
 local s = CCDirector:sharedDirector():getWinSize()
@@ -1655,6 +1657,232 @@ local function runTouchesTest()
 end
 
 
+----------------------------------
+--PerformanceScheduleTest
+----------------------------------
+local ScheduleTestParam =
+{
+    kNodesCount = 1000,
+    kSampleFrames = 60,
+}
+
+local function runScheduleTest()
+    local pNewscene = CCScene:create()
+    local pLayer    = CCLayer:create()
+    local pScheduler = CCDirector:sharedDirector():getScheduler()
+    local bBatchingWasEnabled = pScheduler:isScriptBatchingEnabled()
+
+    local pInfoLabel = nil
+    local pToggleItem = nil
+    local fBucketStart = 0
+    local fBucketTime  = 0
+    local nFrames = 0
+    local nCounter = 0
+
+    local function GetBatchingText()
+        if pScheduler:isScriptBatchingEnabled() then
+            return "Batching: on"
+        end
+        return "Batching: off"
+    end
+
+    -- the update functions of priority 0 run between these two probes
+    local function onBucketStart(dt)
+        fBucketStart = os.clock()
+    end
+
+    local function onBucketEnd(dt)
+        fBucketTime = fBucketTime + (os.clock() - fBucketStart)
+        nFrames = nFrames + 1
+        if nFrames >= ScheduleTestParam.kSampleFrames then
+            local strInfo = string.format("%d updates: %.3f ms/frame", ScheduleTestParam.kNodesCount, fBucketTime * 1000 / nFrames)
+            pInfoLabel:setString(strInfo)
+            print(GetBatchingText() .. ", " .. strInfo)
+            fBucketTime = 0
+            nFrames = 0
+        end
+    end
+
+    local function onNodeUpdate(dt)
+        nCounter = nCounter + 1
+    end
+
+    local function toggleBatching()
+        pScheduler:setScriptBatchingEnabled(not pScheduler:isScriptBatchingEnabled())
+        pToggleItem:setString(GetBatchingText())
+        fBucketTime = 0
+        nFrames = 0
+    end
+
+    local function onNodeEvent(event)
+        if event == "exit" then
+            pScheduler:setScriptBatchingEnabled(bBatchingWasEnabled)
+        end
+    end
+
+    local pTitle = CCLabelTTF:create("Batched Lua schedule", "Arial", 40)
+    pTitle:setPosition(ccp(s.width/2, s.height-32))
+    pTitle:setColor(ccc3(255,255,40))
+    pLayer:addChild(pTitle, 1)
+
+    local pSubTitle = CCLabelTTF:create("Update functions of priority 0, see console", "Thonburi", 16)
+    pSubTitle:setPosition(ccp(s.width/2, s.height-80))
+    pLayer:addChild(pSubTitle, 1)
+
+    pInfoLabel = CCLabelTTF:create("", "Arial", 24)
+    pInfoLabel:setPosition(ccp(s.width/2, s.height/2))
+    pLayer:addChild(pInfoLabel, 1)
+
+    local pMenu = CCMenu:create()
+    pMenu:setPosition(ccp(0, 0))
+    CreatePerfomBasicLayerMenu(pMenu)
+    pToggleItem = CCMenuItemFont:create(GetBatchingText())
+    pToggleItem:registerScriptTapHandler(toggleBatching)
+    pToggleItem:setPosition(ccp(s.width/2, s.height/2 - 50))
+    pMenu:addChild(pToggleItem)
+    pLayer:addChild(pMenu, 1)
+
+    for i = 1, ScheduleTestParam.kNodesCount do
+        local pNode = CCNode:create()
+        pLayer:addChild(pNode)
+        pNode:scheduleUpdateWithPriorityLua(onNodeUpdate, 0)
+    end
+
+    local pStartProbe = CCNode:create()
+    pLayer:addChild(pStartProbe)
+    pStartProbe:scheduleUpdateWithPriorityLua(onBucketStart, -1)
+    local pEndProbe = CCNode:create()
+    pLayer:addChild(pEndProbe)
+    pEndProbe:scheduleUpdateWithPriorityLua(onBucketEnd, 1)
+
+    pLayer:registerScriptHandler(onNodeEvent)
+    pNewscene:addChild(pLayer)
+    return pNewscene
+end
+
+----------------------------------
+--PerformanceValueTypeTest
+----------------------------------
+local ValueTypeTestParam =
+{
+    kSpritesCount = 500,
+    kSampleFrames = 60,
+    kPoolSize = 64,
+}
+
+local function runValueTypeTest()
+    local pNewscene = CCScene:create()
+    local pLayer    = CCLayer:create()
+
+    local pInfoLabel = nil
+    local pToggleItem = nil
+    local bPoolEnabled = false
+    local fGarbage = 0
+    local fTime = 0
+    local nFrames = 0
+    local pSprites = {}
+
+    local function GetPoolText()
+        if bPoolEnabled then
+            return "Value pool: " .. ValueTypeTestParam.kPoolSize
+        end
+        return "Value pool: off"
+    end
+
+    -- typical movement code, every call returns a CCPoint, CCSize or CCRect
+    local function moveSprites(dt)
+        local visibleSize = CCDirector:sharedDirector():getVisibleSize()
+        for i = 1, #pSprites do
+            local pSprite = pSprites[i]
+            local anchor = pSprite:getAnchorPointInPoints()
+            local world = pSprite:convertToWorldSpace(anchor)
+            local box = pSprite:boundingBox()
+            local x = world.x + 60 * dt
+            if box:getMinX() > visibleSize.width then
+                x = -box.size.width / 2
+            end
+            pSprite:setPosition(ccp(x, world.y))
+        end
+    end
+
+    local function update(dt)
+        -- count the bytes allocated by the frame with the collector stopped
+        collectgarbage("stop")
+        local fStart = os.clock()
+        local fBefore = collectgarbage("count")
+        moveSprites(dt)
+        fGarbage = fGarbage + (collectgarbage("count") - fBefore)
+        fTime = fTime + (os.clock() - fStart)
+        collectgarbage("restart")
+
+        nFrames = nFrames + 1
+        if nFrames >= ValueTypeTestParam.kSampleFrames then
+            local strInfo = string.format("%.2f KB/frame, %.3f ms/frame", fGarbage / nFrames, fTime * 1000 / nFrames)
+            pInfoLabel:setString(strInfo)
+            print(GetPoolText() .. ", " .. strInfo)
+            fGarbage = 0
+            fTime = 0
+            nFrames = 0
+        end
+    end
+
+    local function togglePool()
+        bPoolEnabled = not bPoolEnabled
+        if bPoolEnabled then
+            ccSetValueTypePoolSize(ValueTypeTestParam.kPoolSize)
+        else
+            ccSetValueTypePoolSize(0)
+        end
+        pToggleItem:setString(GetPoolText())
+        fGarbage = 0
+        fTime = 0
+        nFrames = 0
+    end
+
+    local function onNodeEvent(event)
+        if event == "exit" then
+            pLayer:unscheduleUpdate()
+            ccSetValueTypePoolSize(0)
+        end
+    end
+
+    local pBatchNode = CCSpriteBatchNode:create("Images/grossini_dance_atlas.png", ValueTypeTestParam.kSpritesCount)
+    pLayer:addChild(pBatchNode)
+    for i = 1, ValueTypeTestParam.kSpritesCount do
+        local pSprite = CCSprite:createWithTexture(pBatchNode:getTexture(), CCRectMake(0, 0, 85, 121))
+        pSprite:setPosition(ccp(math.random() * s.width, math.random() * s.height))
+        pBatchNode:addChild(pSprite)
+        pSprites[i] = pSprite
+    end
+
+    local pTitle = CCLabelTTF:create("Value type garbage", "Arial", 40)
+    pTitle:setPosition(ccp(s.width/2, s.height-32))
+    pTitle:setColor(ccc3(255,255,40))
+    pLayer:addChild(pTitle, 1)
+
+    local pSubTitle = CCLabelTTF:create("CCPoint/CCSize/CCRect values returned per frame, see console", "Thonburi", 16)
+    pSubTitle:setPosition(ccp(s.width/2, s.height-80))
+    pLayer:addChild(pSubTitle, 1)
+
+    pInfoLabel = CCLabelTTF:create("", "Arial", 24)
+    pInfoLabel:setPosition(ccp(s.width/2, s.height/2))
+    pLayer:addChild(pInfoLabel, 1)
+
+    local pMenu = CCMenu:create()
+    pMenu:setPosition(ccp(0, 0))
+    CreatePerfomBasicLayerMenu(pMenu)
+    pToggleItem = CCMenuItemFont:create(GetPoolText())
+    pToggleItem:registerScriptTapHandler(togglePool)
+    pToggleItem:setPosition(ccp(s.width/2, s.height/2 - 50))
+    pMenu:addChild(pToggleItem)
+    pLayer:addChild(pMenu, 1)
+
+    pLayer:scheduleUpdateWithPriorityLua(update, 0)
+    pLayer:registerScriptHandler(onNodeEvent)
+    pNewscene:addChild(pLayer)
+    return pNewscene
+end
+
 ------------------------
 --
 ------------------------
@@ -1664,7 +1892,9 @@ local CreatePerformancesTestTable =
 	runParticleTest,
 	runSpriteTest,
 	runTextureTest,
-	runTouchesTest	
+	runTouchesTest,
+	runScheduleTest,
+	runValueTypeTest
 }
 
 local function CreatePerformancesTestScene(nPerformanceNo)
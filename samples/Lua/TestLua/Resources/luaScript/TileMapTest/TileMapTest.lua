@@ -691,14 +691,14 @@ local function draw()
         key = "height"
         local height = (tolua.cast(dict:objectForKey(key), "CCString")):intValue()--dynamic_cast<NSNumber*>(dict:objectForKey("height")):getNumber()
 
-        glLineWidth(3)
+        ccGLLineWidth(3)
 
         ccDrawLine( ccp(x, y), ccp((x+width), y) )
         ccDrawLine( ccp((x+width), y), ccp((x+width), (y+height)) )
         ccDrawLine( ccp((x+width), (y+height)), ccp(x, (y+height)) )
         ccDrawLine( ccp(x, (y+height)), ccp(x, y) )
 
-        glLineWidth(1)
+        ccGLLineWidth(1)
     end
 end
 
@@ -760,14 +760,14 @@ local function draw()
         key = "height"
         local height = (tolua.cast(dict:objectForKey(key), "CCString")):intValue()--dynamic_cast<NSNumber*>(dict:objectForKey("height")):getNumber()
 
-        glLineWidth(3)
+        ccGLLineWidth(3)
 
         ccDrawLine( ccp(x,y), ccp(x+width,y) )
         ccDrawLine( ccp(x+width,y), ccp(x+width,y+height) )
         ccDrawLine( ccp(x+width,y+height), ccp(x,y+height) )
         ccDrawLine( ccp(x,y+height), ccp(x,y) )
 
-        glLineWidth(1)
+        ccGLLineWidth(1)
     end
 end
 
@@ -993,22 +993,6 @@ JSBool JSB_glIsTexture(JSContext *cx, uint32_t argc, jsval *vp) {
 	return JS_TRUE;
 }
 
-// Arguments: GLfloat
-// Ret value: void
-JSBool JSB_glLineWidth(JSContext *cx, uint32_t argc, jsval *vp) {
-	JSB_PRECONDITION2( argc == 1, cx, JS_FALSE, "Invalid number of arguments" );
-	jsval *argvp = JS_ARGV(cx,vp);
-	JSBool ok = JS_TRUE;
-	int32_t arg0; 
-
-	ok &= JSB_jsval_to_int32( cx, *argvp++, &arg0 );
-	JSB_PRECONDITION2(ok, cx, JS_FALSE, "Error processing arguments");
-
-	glLineWidth((GLfloat)arg0  );
-	JS_SET_RVAL(cx, vp, JSVAL_VOID);
-	return JS_TRUE;
-}
-
 // Arguments: GLuint
 // Ret value: void
 JSBool JSB_glLinkProgram(JSContext *cx, uint32_t argc, jsval *vp) {
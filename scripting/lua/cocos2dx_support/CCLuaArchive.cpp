@@ -0,0 +1,261 @@
+/****************************************************************************
+ Copyright (c) 2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CCLuaArchive.h"
+#include "cocos2d.h"
+
+extern "C" {
+#include "lauxlib.h"
+}
+
+#include <string.h>
+
+NS_CC_BEGIN
+
+static const unsigned int kArchiveVersion = 1;
+static const unsigned int kHeaderSize = 16;
+static const unsigned int kSlotSize = 24;
+// longest module name normalized without allocation
+static const size_t kMaxInlineName = 256;
+
+static unsigned int readUInt(const unsigned char* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+// LuaJIT registers its "jit" module when the libraries are opened
+static bool isLuaJIT(lua_State* L)
+{
+    lua_getfield(L, LUA_REGISTRYINDEX, "_LOADED");
+    lua_getfield(L, -1, "jit");
+    bool ret = !lua_isnil(L, -1);
+    lua_pop(L, 2);
+    return ret;
+}
+
+CCLuaArchive* CCLuaArchive::create(const char* filename)
+{
+    CCLuaArchive* pRet = new CCLuaArchive();
+    if (pRet && pRet->initWithFile(filename))
+    {
+        pRet->autorelease();
+    }
+    else
+    {
+        CC_SAFE_DELETE(pRet);
+    }
+    return pRet;
+}
+
+CCLuaArchive::CCLuaArchive(void)
+: _data(NULL)
+, _size(0)
+, _slotCount(0)
+, _moduleCount(0)
+{
+}
+
+CCLuaArchive::~CCLuaArchive(void)
+{
+    CC_SAFE_DELETE_ARRAY(_data);
+}
+
+bool CCLuaArchive::initWithFile(const char* filename)
+{
+    unsigned long size = 0;
+    unsigned char* data = CCFileUtils::sharedFileUtils()->getFileData(filename, "rb", &size);
+    if (!data)
+    {
+        return false;
+    }
+    return initWithData(data, size, filename);
+}
+
+bool CCLuaArchive::initWithData(unsigned char* data, unsigned long size, const char* filename)
+{
+    CC_SAFE_DELETE_ARRAY(_data);
+    _data = data;
+    _size = size;
+    _filename = filename ? filename : "";
+
+    if (size < kHeaderSize || memcmp(data, "CLBA", 4) != 0 || readUInt(data + 4) != kArchiveVersion)
+    {
+        CCLOG("CCLuaArchive: %s is not a Lua archive", _filename.c_str());
+        return false;
+    }
+
+    _slotCount = readUInt(data + 8);
+    _moduleCount = readUInt(data + 12);
+    if (_slotCount == 0 || (_slotCount & (_slotCount - 1)) != 0
+        || _moduleCount > _slotCount
+        || (size - kHeaderSize) / kSlotSize < _slotCount)
+    {
+        CCLOG("CCLuaArchive: %s has an invalid table", _filename.c_str());
+        return false;
+    }
+
+    // check the ranges once, so lookups don't have to
+    for (unsigned int i = 0; i < _slotCount; ++i)
+    {
+        const unsigned char* slot = _data + kHeaderSize + i * kSlotSize;
+        unsigned int nameOffset = readUInt(slot + 8);
+        unsigned int nameLength = readUInt(slot + 12);
+        unsigned int chunkOffset = readUInt(slot + 16);
+        unsigned int chunkSize = readUInt(slot + 20);
+        if (nameLength != 0
+            && (nameOffset > size || nameLength > size - nameOffset
+                || chunkOffset > size || chunkSize > size - chunkOffset))
+        {
+            CCLOG("CCLuaArchive: %s is truncated", _filename.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+unsigned int CCLuaArchive::hashModuleName(const char* name, size_t length)
+{
+    // FNV-1a
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool CCLuaArchive::findChunks(const char* name, size_t length, bool bJIT, Chunk* bytecode, Chunk* source)
+{
+    unsigned int wanted = bJIT ? kChunkLuaJIT : kChunkLua51;
+    unsigned int hash = hashModuleName(name, length);
+    unsigned int mask = _slotCount - 1;
+    bytecode->data = source->data = NULL;
+    bytecode->size = source->size = 0;
+
+    for (unsigned int i = 0; i < _slotCount; ++i)
+    {
+        const unsigned char* slot = _data + kHeaderSize + ((hash + i) & mask) * kSlotSize;
+        unsigned int nameLength = readUInt(slot + 12);
+        if (nameLength == 0)
+        {
+            break;
+        }
+
+        if (readUInt(slot) == hash && nameLength == length
+            && memcmp(_data + readUInt(slot + 8), name, length) == 0)
+        {
+            unsigned int kind = readUInt(slot + 4);
+            Chunk* chunk = (kind == wanted) ? bytecode : (kind == kChunkSource ? source : NULL);
+            if (chunk)
+            {
+                chunk->data = _data + readUInt(slot + 16);
+                chunk->size = readUInt(slot + 20);
+            }
+        }
+    }
+
+    return bytecode->data != NULL || source->data != NULL;
+}
+
+// "a/b.lua" and "a.b" both become "a.b"
+static size_t normalizeModuleName(const char* moduleName, char* buffer, std::string& longName, const char** name)
+{
+    size_t length = strlen(moduleName);
+    if (length > 4 && strcmp(moduleName + length - 4, ".lua") == 0)
+    {
+        length -= 4;
+    }
+
+    char* out = buffer;
+    if (length > kMaxInlineName)
+    {
+        longName.resize(length);
+        out = &longName[0];
+    }
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        char c = moduleName[i];
+        out[i] = (c == '/' || c == '\\') ? '.' : c;
+    }
+    *name = out;
+    return length;
+}
+
+bool CCLuaArchive::hasModule(const char* moduleName)
+{
+    char buffer[kMaxInlineName];
+    std::string longName;
+    const char* name = NULL;
+    size_t length = normalizeModuleName(moduleName, buffer, longName, &name);
+
+    Chunk bytecode, source;
+    return findChunks(name, length, false, &bytecode, &source) || findChunks(name, length, true, &bytecode, &source);
+}
+
+int CCLuaArchive::loadModule(lua_State* L, const char* moduleName)
+{
+    char buffer[kMaxInlineName];
+    std::string longName;
+    const char* name = NULL;
+    size_t length = normalizeModuleName(moduleName, buffer, longName, &name);
+
+    Chunk bytecode, source;
+    if (!findChunks(name, length, isLuaJIT(L), &bytecode, &source))
+    {
+        return -1;
+    }
+
+    // same chunk name as the file loader, so error messages are unchanged
+    lua_pushlstring(L, name, length);                                   /* L: ... name */
+    luaL_gsub(L, lua_tostring(L, -1), ".", "/");                        /* L: ... name path */
+    lua_pushliteral(L, ".lua");
+    lua_concat(L, 2);                                                   /* L: ... name path.lua */
+    const char* chunkName = lua_tostring(L, -1);
+
+    int ret = -1;
+    if (bytecode.data)
+    {
+        ret = luaL_loadbuffer(L, (const char*)bytecode.data, bytecode.size, chunkName);
+        if (ret != 0 && source.data)
+        {
+            // Lua 5.1 bytecode depends on the word size of the VM that compiled it
+            CCLOG("CCLuaArchive: bytecode of %s rejected (%s), loading its source", chunkName, lua_tostring(L, -1));
+            lua_pop(L, 1);
+            ret = -1;
+        }
+    }
+    if (ret < 0)
+    {
+        ret = luaL_loadbuffer(L, (const char*)source.data, source.size, chunkName);
+    }
+
+    lua_remove(L, -2);
+    lua_remove(L, -2);                                                  /* L: ... chunk|error */
+    return ret;
+}
+
+NS_CC_END
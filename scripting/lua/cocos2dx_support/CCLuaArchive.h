@@ -0,0 +1,111 @@
+/****************************************************************************
+ Copyright (c) 2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_LUA_ARCHIVE_H_
+#define __CC_LUA_ARCHIVE_H_
+
+extern "C" {
+#include "lua.h"
+}
+
+#include <string>
+#include "cocoa/CCObject.h"
+
+NS_CC_BEGIN
+
+/**
+ @brief An archive of precompiled Lua modules, built by tools/lua_archive_packer.
+
+ The modules of an archive are resolved by CCLuaStack::addLuaArchive without any file access:
+ the archive is read once and require() looks the module up in its hash table.
+
+ File layout, all integers are 32 bits little endian:
+ - header: "CLBA", version, slot count (a power of 2), module count
+ - slots: slot count x {hash, kind, name offset, name length, chunk offset, chunk size},
+   empty slots have a name length of 0
+ - names and chunks, offsets are relative to the start of the file
+
+ The slots are an open addressing table (FNV-1a hash of the module name, linear probing)
+ used in place, so the table of contents can be memory mapped and needs no parsing.
+ A module may be stored several times: as Lua 5.1 bytecode, as LuaJIT bytecode and as
+ source. The bytecode of the running VM is preferred, the source is used when there is no
+ such bytecode or when the VM rejects it.
+
+ @since v3.0
+ */
+class CCLuaArchive : public CCObject
+{
+public:
+    enum ChunkKind
+    {
+        kChunkSource = 0,
+        kChunkLua51 = 1,
+        kChunkLuaJIT = 2,
+    };
+
+    static CCLuaArchive* create(const char* filename);
+
+    CCLuaArchive(void);
+    virtual ~CCLuaArchive(void);
+
+    /** Reads the archive with CCFileUtils. */
+    bool initWithFile(const char* filename);
+    /** Uses the archive in data, which is released with delete[]. */
+    bool initWithData(unsigned char* data, unsigned long size, const char* filename);
+
+    /**
+     @brief Loads a module and pushes its function.
+     @param moduleName The name given to require(), '/' are accepted as separators.
+     @return 0 on success, -1 if the archive doesn't contain the module (nothing is pushed),
+     a luaL_loadbuffer error code otherwise (the error message is pushed).
+     */
+    int loadModule(lua_State* L, const char* moduleName);
+
+    bool hasModule(const char* moduleName);
+    unsigned int getModuleCount(void) const { return _moduleCount; }
+    const char* getFilename(void) const { return _filename.c_str(); }
+
+    /** The hash of the archive table, the name must be normalized (dotted, without extension). */
+    static unsigned int hashModuleName(const char* name, size_t length);
+
+private:
+    struct Chunk
+    {
+        const unsigned char* data;
+        unsigned int size;
+    };
+
+    // finds the bytecode for the VM and the source of a module, returns false if neither exists
+    bool findChunks(const char* name, size_t length, bool bJIT, Chunk* bytecode, Chunk* source);
+
+    unsigned char* _data;
+    unsigned long _size;
+    unsigned int _slotCount;
+    unsigned int _moduleCount;
+    std::string _filename;
+};
+
+NS_CC_END
+
+#endif // __CC_LUA_ARCHIVE_H_
@@ -27,8 +27,31 @@
 #include "cocoa/CCArray.h"
 #include "CCScheduler.h"
 
+extern "C" {
+#include "tolua_fix.h"
+}
+
 NS_CC_BEGIN
 
+// Calls the queued schedule functions. The functions are looked up in the
+// refid mapping table at call time, so a handler removed by a previous call
+// is skipped. Cancelled calls have their id set to false.
+static const char *s_scheduleDispatcher =
+    "local functions = ...\n"
+    "local cursor = 0\n"
+    "local function dispatch(ids, dts, n, first)\n"
+    "    for i = first, n do\n"
+    "        local id = ids[i]\n"
+    "        if id then\n"
+    "            cursor = i\n"
+    "            local f = functions[id]\n"
+    "            if f then f(dts[i]) end\n"
+    "        end\n"
+    "    end\n"
+    "    return true\n"
+    "end\n"
+    "return dispatch, function() return cursor end\n";
+
 CCLuaEngine* CCLuaEngine::_defaultEngine = NULL;
 
 CCLuaEngine* CCLuaEngine::defaultEngine(void)
@@ -64,6 +87,11 @@ void CCLuaEngine::addLuaLoader(lua_CFunction func)
     _stack->addLuaLoader(func);
 }
 
+bool CCLuaEngine::addLuaArchive(const char* filename)
+{
+    return _stack->addLuaArchive(filename);
+}
+
 void CCLuaEngine::removeScriptObjectByCCObject(CCObject* pObj)
 {
     _stack->removeScriptObjectByCCObject(pObj);
@@ -176,6 +204,122 @@ int CCLuaEngine::executeSchedule(int nHandler, float dt, CCNode* pNode/* = NULL*
     return ret;
 }
 
+bool CCLuaEngine::initScheduleDispatcher(void)
+{
+    lua_State *L = _stack->getLuaState();
+    if (luaL_loadbuffer(L, s_scheduleDispatcher, strlen(s_scheduleDispatcher), "schedule dispatcher") != 0)
+    {
+        CCLOG("[LUA ERROR] %s", lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return false;
+    }
+
+    lua_pushstring(L, TOLUA_REFID_FUNCTION_MAPPING);
+    lua_rawget(L, LUA_REGISTRYINDEX);                                   /* L: chunk refid_fun */
+    if (lua_pcall(L, 1, 2, 0) != 0)
+    {
+        CCLOG("[LUA ERROR] %s", lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return false;
+    }
+    _cursorRef = luaL_ref(L, LUA_REGISTRYINDEX);                        /* L: dispatch */
+    _dispatcherRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+    lua_newtable(L);
+    _scheduleIdsRef = luaL_ref(L, LUA_REGISTRYINDEX);
+    lua_newtable(L);
+    _scheduleDtsRef = luaL_ref(L, LUA_REGISTRYINDEX);
+    return true;
+}
+
+bool CCLuaEngine::queueSchedule(int nHandler, float dt, CCObject* pTarget)
+{
+    // calls made from a dispatched function are not queued
+    if (!nHandler || _scheduleFlushing) return false;
+    if (_dispatcherRef == LUA_NOREF && !initScheduleDispatcher()) return false;
+
+    ScheduleCall call;
+    call.handler = nHandler;
+    call.dt = dt;
+    call.target = pTarget;
+    _scheduleCalls.push_back(call);
+    return true;
+}
+
+void CCLuaEngine::flushSchedules()
+{
+    if (_scheduleCalls.empty() || _scheduleFlushing) return;
+
+    lua_State *L = _stack->getLuaState();
+    int count = (int)_scheduleCalls.size();
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, _scheduleIdsRef);                 /* L: ids */
+    lua_rawgeti(L, LUA_REGISTRYINDEX, _scheduleDtsRef);                 /* L: ids dts */
+    for (int i = 0; i < count; ++i)
+    {
+        const ScheduleCall& call = _scheduleCalls[i];
+        if (call.handler)
+        {
+            lua_pushinteger(L, call.handler);
+        }
+        else
+        {
+            lua_pushboolean(L, 0);
+        }
+        lua_rawseti(L, -3, i + 1);
+        lua_pushnumber(L, call.dt);
+        lua_rawseti(L, -2, i + 1);
+    }
+    lua_pop(L, 2);
+
+    _scheduleFlushing = true;
+    int first = 1;
+    while (first <= count)
+    {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, _dispatcherRef);              /* L: dispatch */
+        lua_rawgeti(L, LUA_REGISTRYINDEX, _scheduleIdsRef);             /* L: dispatch ids */
+        lua_rawgeti(L, LUA_REGISTRYINDEX, _scheduleDtsRef);             /* L: dispatch ids dts */
+        lua_pushinteger(L, count);
+        lua_pushinteger(L, first);
+        if (_stack->executeFunction(4))
+        {
+            break;
+        }
+
+        // a function raised an error, it was reported by executeFunction, go on with the next one
+        lua_rawgeti(L, LUA_REGISTRYINDEX, _cursorRef);
+        lua_call(L, 0, 1);
+        first = lua_tointeger(L, -1) + 1;
+        lua_pop(L, 1);
+    }
+    _scheduleFlushing = false;
+
+    _scheduleCalls.clear();
+    _stack->clean();
+}
+
+void CCLuaEngine::cancelSchedules(const CCObject* pTarget)
+{
+    lua_State *L = _stack->getLuaState();
+    int count = (int)_scheduleCalls.size();
+    for (int i = 0; i < count; ++i)
+    {
+        ScheduleCall& call = _scheduleCalls[i];
+        if (call.target == pTarget && call.handler)
+        {
+            call.handler = 0;
+            if (_scheduleFlushing)
+            {
+                // the ids were already handed to the dispatcher
+                lua_rawgeti(L, LUA_REGISTRYINDEX, _scheduleIdsRef);
+                lua_pushboolean(L, 0);
+                lua_rawseti(L, -2, i + 1);
+                lua_pop(L, 1);
+            }
+        }
+    }
+}
+
 int CCLuaEngine::executeLayerTouchEvent(CCLayer* pLayer, int eventType, CCTouch *pTouch)
 {
     CCTouchScriptHandlerEntry* pScriptHandlerEntry = pLayer->getScriptTouchHandlerEntry();
@@ -27,6 +27,7 @@
 
 extern "C" {
 #include "lua.h"
+#include "lauxlib.h"
 }
 
 #include "ccTypes.h"
@@ -37,6 +38,7 @@ extern "C" {
 #include "script_support/CCScriptSupport.h"
 #include "CCLuaStack.h"
 #include "CCLuaValue.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -66,6 +68,11 @@ public:
      */
     virtual void addLuaLoader(lua_CFunction func);
     
+    /**
+     @brief Add an archive of precompiled modules, see CCLuaStack::addLuaArchive
+     */
+    virtual bool addLuaArchive(const char* filename);
+    
     /**
      @brief Remove CCObject from lua state
      @param object to remove
@@ -109,6 +116,14 @@ public:
     virtual int executeNotificationEvent(CCNotificationCenter* pNotificationCenter, const char* pszName);
     virtual int executeCallFuncActionEvent(CCCallFunc* pAction, CCObject* pTarget = NULL);
     virtual int executeSchedule(int nHandler, float dt, CCNode* pNode = NULL);
+
+    /** Batched schedule calls, see CCScheduler::setScriptBatchingEnabled.
+     The queued functions are called by a single Lua dispatcher loop. A function that
+     raises an error is reported and the dispatch goes on with the next one.
+     */
+    virtual bool queueSchedule(int nHandler, float dt, CCObject* pTarget);
+    virtual void flushSchedules();
+    virtual void cancelSchedules(const CCObject* pTarget);
     virtual int executeLayerTouchesEvent(CCLayer* pLayer, int eventType, CCSet *pTouches);
     virtual int executeLayerTouchEvent(CCLayer* pLayer, int eventType, CCTouch *pTouch);
     virtual int executeLayerKeypadEvent(CCLayer* pLayer, int eventType);
@@ -121,13 +136,34 @@ public:
 private:
     CCLuaEngine(void)
     : _stack(NULL)
+    , _scheduleFlushing(false)
+    , _scheduleIdsRef(LUA_NOREF)
+    , _scheduleDtsRef(LUA_NOREF)
+    , _dispatcherRef(LUA_NOREF)
+    , _cursorRef(LUA_NOREF)
     {
     }
     
     bool init(void);
+    bool initScheduleDispatcher(void);
     
     static CCLuaEngine* _defaultEngine;
     CCLuaStack *_stack;
+
+    struct ScheduleCall
+    {
+        int handler;
+        float dt;
+        const CCObject *target;
+    };
+    std::vector<ScheduleCall> _scheduleCalls;
+    bool _scheduleFlushing;
+    // registry references of the id and dt tables passed to the dispatcher,
+    // of the dispatcher and of the function returning the index it is running
+    int _scheduleIdsRef;
+    int _scheduleDtsRef;
+    int _dispatcherRef;
+    int _cursorRef;
 };
 
 NS_CC_END
@@ -34,6 +34,8 @@ extern "C" {
 
 #include "LuaCocos2d.h"
 #include "Cocos2dxLuaLoader.h"
+#include "LuaBasicConversions.h"
+#include "CCLuaArchive.h"
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS || CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
 #include "platform/ios/CCLuaObjcBridge.h"
@@ -107,6 +109,7 @@ bool CCLuaStack::init(void)
     luaL_openlibs(_state);
     tolua_Cocos2d_open(_state);
     toluafix_open(_state);
+    luaval_open(_state);
 
     // Register our version of the global "print" function
     const luaL_reg global_functions [] = {
@@ -145,13 +148,54 @@ void CCLuaStack::addLuaLoader(lua_CFunction func)
 {
     if (!func) return;
     
+    lua_pushcfunction(_state, func);                                   /* L: func */
+    insertLuaLoader();
+}
+
+static int lua_archive_gc(lua_State *L)
+{
+    CCLuaArchive* archive = *(CCLuaArchive**)lua_touserdata(L, 1);
+    archive->release();
+    return 0;
+}
+
+bool CCLuaStack::addLuaArchive(const char* filename)
+{
+    struct cc_timeval start, end;
+    CCTime::gettimeofdayCocos2d(&start, NULL);
+    CCLuaArchive* archive = CCLuaArchive::create(filename);
+    if (!archive)
+    {
+        CCLOG("can not load Lua archive %s", filename);
+        return false;
+    }
+    CCTime::gettimeofdayCocos2d(&end, NULL);
+    CCLOG("Lua archive %s: %u modules, opened in %.2f ms", filename, archive->getModuleCount(), CCTime::timersubCocos2d(&start, &end));
+
+    // the archive lives as long as its loader
+    archive->retain();
+    CCLuaArchive** ud = (CCLuaArchive**)lua_newuserdata(_state, sizeof(CCLuaArchive*));
+    *ud = archive;                                                     /* L: archive */
+    if (luaL_newmetatable(_state, "CCLuaArchive"))                     /* L: archive mt */
+    {
+        lua_pushcfunction(_state, lua_archive_gc);
+        lua_setfield(_state, -2, "__gc");
+    }
+    lua_setmetatable(_state, -2);                                      /* L: archive */
+    lua_pushcclosure(_state, cocos2dx_lua_archive_loader, 1);          /* L: loader */
+    insertLuaLoader();
+    return true;
+}
+
+void CCLuaStack::insertLuaLoader(void)
+{
     // stack content after the invoking of the function
     // get loader table
-    lua_getglobal(_state, "package");                                  /* L: package */
-    lua_getfield(_state, -1, "loaders");                               /* L: package, loaders */
+    lua_getglobal(_state, "package");                                  /* L: func, package */
+    lua_getfield(_state, -1, "loaders");                               /* L: func, package, loaders */
     
     // insert loader into index 2
-    lua_pushcfunction(_state, func);                                   /* L: package, loaders, func */
+    lua_pushvalue(_state, -3);                                         /* L: func, package, loaders, func */
     for (int i = lua_objlen(_state, -2) + 1; i > 2; --i)
     {
         lua_rawgeti(_state, -2, i - 1);                                /* L: package, loaders, func, function */
@@ -161,9 +205,9 @@ void CCLuaStack::addLuaLoader(lua_CFunction func)
     lua_rawseti(_state, -2, 2);                                        /* L: package, loaders */
     
     // set loaders into package
-    lua_setfield(_state, -2, "loaders");                               /* L: package */
+    lua_setfield(_state, -2, "loaders");                               /* L: func, package */
     
-    lua_pop(_state, 1);
+    lua_pop(_state, 2);
 }
 
 
@@ -189,7 +233,9 @@ int CCLuaStack::executeScriptFile(const char* filename)
     std::string code("require \"");
     code.append(filename);
     code.append("\"");
-    return executeString(code.c_str());
+    int nRet = executeString(code.c_str());
+    reportLoaderStats(filename);
+    return nRet;
 #else
     std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(filename);
     ++_callFromLua;
@@ -204,10 +250,18 @@ int CCLuaStack::executeScriptFile(const char* filename)
         lua_pop(_state, 1);
         return nRet;
     }
+    reportLoaderStats(filename);
     return 0;
 #endif
 }
 
+void CCLuaStack::reportLoaderStats(const char* filename)
+{
+    const CCLuaLoaderStats& stats = cocos2dx_lua_loader_stats();
+    CCLOG("Lua modules after %s: %u from archives in %.2f ms, %u from files in %.2f ms",
+          filename, stats.archiveModules, stats.archiveTime, stats.fileModules, stats.fileTime);
+}
+
 int CCLuaStack::executeGlobalFunction(const char* functionName)
 {
     lua_getglobal(_state, functionName);       /* query function by name, stack: function */
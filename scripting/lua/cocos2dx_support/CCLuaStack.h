@@ -59,6 +59,15 @@ public:
      @brief Add lua loader, now it is used on android
      */
     virtual void addLuaLoader(lua_CFunction func);
+
+    /**
+     @brief Resolves require() from an archive of precompiled modules before the other loaders.
+     Modules missing from the archive are still loaded from files.
+     @param filename archive built by tools/lua_archive_packer
+     @return false if the archive can't be read
+     @since v3.0
+     */
+    virtual bool addLuaArchive(const char* filename);
     
     /**
      @brief Remove CCObject from lua state
@@ -125,6 +134,10 @@ protected:
     
     bool init(void);
     bool initWithLuaState(lua_State *L);
+    // inserts the loader function on the top of the stack before the default loaders
+    void insertLuaLoader(void);
+    // logs the time spent by the loaders, the modules required at startup are loaded by the main script
+    void reportLoaderStats(const char* filename);
     
     lua_State *_state;
     int _callFromLua;
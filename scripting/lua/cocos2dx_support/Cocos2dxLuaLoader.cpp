@@ -22,15 +22,52 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "Cocos2dxLuaLoader.h"
+#include "CCLuaArchive.h"
 #include <string>
 #include <algorithm>
 
 using namespace cocos2d;
 
+static CCLuaLoaderStats s_stats = { 0, 0.0, 0, 0.0 };
+
+const CCLuaLoaderStats& cocos2dx_lua_loader_stats(void)
+{
+    return s_stats;
+}
+
 extern "C"
 {
+    int cocos2dx_lua_archive_loader(lua_State *L)
+    {
+        CCLuaArchive* archive = *(CCLuaArchive**)lua_touserdata(L, lua_upvalueindex(1));
+        const char* moduleName = luaL_checkstring(L, 1);
+
+        struct cc_timeval start, end;
+        CCTime::gettimeofdayCocos2d(&start, NULL);
+        int ret = archive->loadModule(L, moduleName);
+        if (ret < 0)
+        {
+            // let the next loaders find it
+            lua_pushfstring(L, "\n\tno module '%s' in archive %s", moduleName, archive->getFilename());
+            return 1;
+        }
+        else if (ret != 0)
+        {
+            luaL_error(L, "error loading module %s from archive %s :\n\t%s",
+                moduleName, archive->getFilename(), lua_tostring(L, -1));
+        }
+        CCTime::gettimeofdayCocos2d(&end, NULL);
+
+        ++s_stats.archiveModules;
+        s_stats.archiveTime += CCTime::timersubCocos2d(&start, &end);
+        return 1;
+    }
+
     int cocos2dx_lua_loader(lua_State *L)
     {
+        struct cc_timeval start, end;
+        CCTime::gettimeofdayCocos2d(&start, NULL);
+
         std::string filename(luaL_checkstring(L, 1));
         size_t pos = filename.rfind(".lua");
         if (pos != std::string::npos)
@@ -57,6 +94,10 @@ extern "C"
                     lua_tostring(L, 1), filename.c_str(), lua_tostring(L, -1));
             }
             delete []codeBuffer;
+
+            CCTime::gettimeofdayCocos2d(&end, NULL);
+            ++s_stats.fileModules;
+            s_stats.fileTime += CCTime::timersubCocos2d(&start, &end);
         }
         else
         {
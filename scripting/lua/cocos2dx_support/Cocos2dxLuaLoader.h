@@ -33,6 +33,20 @@ extern "C"
 #include "lauxlib.h"
 
 extern int cocos2dx_lua_loader(lua_State *L);
+
+/** Loads a module from the CCLuaArchive held by the first upvalue, see CCLuaStack::addLuaArchive */
+extern int cocos2dx_lua_archive_loader(lua_State *L);
 }
 
+/** Number of modules loaded by the loaders and time spent, in milliseconds. */
+struct CCLuaLoaderStats
+{
+    unsigned int archiveModules;
+    double archiveTime;
+    unsigned int fileModules;
+    double fileTime;
+};
+
+const CCLuaLoaderStats& cocos2dx_lua_loader_stats(void);
+
 #endif // __COCOS2DX_LUA_LOADER_H__
\ No newline at end of file
@@ -0,0 +1,361 @@
+/****************************************************************************
+ Copyright (c) 2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "LuaBasicConversions.h"
+#include "cocos2d.h"
+
+extern "C" {
+#include "lauxlib.h"
+}
+
+#include <stdlib.h>
+#include <string.h>
+
+USING_NS_CC;
+
+// registry keys
+static char s_pointMetatableKey;
+static char s_sizeMetatableKey;
+static char s_rectMetatableKey;
+static char s_pointPoolKey;
+static char s_sizePoolKey;
+static char s_rectPoolKey;
+
+// methods of the value tables, same behaviour as the CCGeometry methods
+static const char *s_valueTypeMethods =
+    "local FLT_EPSILON = 1.192092896e-07\n"
+    "local abs = math.abs\n"
+    "local point, size, rect = {}, {}, {}\n"
+    "function point.equals(a, b) return abs(a.x - b.x) < FLT_EPSILON and abs(a.y - b.y) < FLT_EPSILON end\n"
+    "function size.equals(a, b) return abs(a.width - b.width) < FLT_EPSILON and abs(a.height - b.height) < FLT_EPSILON end\n"
+    "function rect.getMinX(r) return r.origin.x end\n"
+    "function rect.getMidX(r) return r.origin.x + r.size.width / 2 end\n"
+    "function rect.getMaxX(r) return r.origin.x + r.size.width end\n"
+    "function rect.getMinY(r) return r.origin.y end\n"
+    "function rect.getMidY(r) return r.origin.y + r.size.height / 2 end\n"
+    "function rect.getMaxY(r) return r.origin.y + r.size.height end\n"
+    "function rect.equals(a, b) return point.equals(a.origin, b.origin) and size.equals(a.size, b.size) end\n"
+    "function rect.containsPoint(r, p)\n"
+    "    local o, s = r.origin, r.size\n"
+    "    return p.x >= o.x and p.x <= o.x + s.width and p.y >= o.y and p.y <= o.y + s.height\n"
+    "end\n"
+    "function rect.intersectsRect(a, b)\n"
+    "    local ao, as, bo, bs = a.origin, a.size, b.origin, b.size\n"
+    "    return not (ao.x + as.width < bo.x or bo.x + bs.width < ao.x or\n"
+    "                ao.y + as.height < bo.y or bo.y + bs.height < ao.y)\n"
+    "end\n"
+    "return {__index = point}, {__index = size}, {__index = rect}\n";
+
+static int absoluteIndex(lua_State* L, int lo)
+{
+    return (lo > 0 || lo <= LUA_REGISTRYINDEX) ? lo : lua_gettop(L) + lo + 1;
+}
+
+static bool hasNumberField(lua_State* L, int lo, const char* name)
+{
+    lua_getfield(L, lo, name);
+    bool ret = lua_isnumber(L, -1) != 0;
+    lua_pop(L, 1);
+    return ret;
+}
+
+static float getNumberField(lua_State* L, int lo, const char* name)
+{
+    lua_getfield(L, lo, name);
+    float ret = (float)lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    return ret;
+}
+
+static void setNumberField(lua_State* L, const char* name, float value)
+{
+    lua_pushnumber(L, value);
+    lua_setfield(L, -2, name);
+}
+
+// a field of a rect table may be a table or a userdata
+static bool hasValueField(lua_State* L, int lo, const char* name, const char* first, const char* second)
+{
+    lua_getfield(L, lo, name);
+    int top = lua_gettop(L);
+    bool ret = (lua_istable(L, top) || lua_isuserdata(L, top))
+        && hasNumberField(L, top, first)
+        && hasNumberField(L, top, second);
+    lua_pop(L, 1);
+    return ret;
+}
+
+static bool isPointTable(lua_State* L, int lo)
+{
+    return hasNumberField(L, lo, "x") && hasNumberField(L, lo, "y");
+}
+
+static bool isSizeTable(lua_State* L, int lo)
+{
+    return hasNumberField(L, lo, "width") && hasNumberField(L, lo, "height");
+}
+
+static bool isRectTable(lua_State* L, int lo)
+{
+    return hasValueField(L, lo, "origin", "x", "y") && hasValueField(L, lo, "size", "width", "height");
+}
+
+static bool isValue(lua_State* L, int lo, const char* type, int def, tolua_Error* err, bool (*isTable)(lua_State*, int))
+{
+    if (lua_istable(L, lo))
+    {
+        if (isTable(L, absoluteIndex(L, lo)))
+        {
+            return true;
+        }
+        err->index = lo;
+        err->array = 0;
+        err->type = type;
+        return false;
+    }
+    return tolua_isusertype(L, lo, type, def, err) != 0;
+}
+
+bool luaval_is_ccpoint(lua_State* L, int lo, const char* type, int def, tolua_Error* err)
+{
+    return isValue(L, lo, type, def, err, isPointTable);
+}
+
+bool luaval_is_ccsize(lua_State* L, int lo, const char* type, int def, tolua_Error* err)
+{
+    return isValue(L, lo, type, def, err, isSizeTable);
+}
+
+bool luaval_is_ccrect(lua_State* L, int lo, const char* type, int def, tolua_Error* err)
+{
+    return isValue(L, lo, type, def, err, isRectTable);
+}
+
+static void readPoint(lua_State* L, int lo, CCPoint* pt)
+{
+    pt->x = getNumberField(L, lo, "x");
+    pt->y = getNumberField(L, lo, "y");
+}
+
+static void readSize(lua_State* L, int lo, CCSize* sz)
+{
+    sz->width = getNumberField(L, lo, "width");
+    sz->height = getNumberField(L, lo, "height");
+}
+
+void* luaval_to_ccpoint(lua_State* L, int lo, void* def, CCPoint* value)
+{
+    if (!lua_istable(L, lo))
+    {
+        return tolua_tousertype(L, lo, def);
+    }
+
+    readPoint(L, absoluteIndex(L, lo), value);
+    return value;
+}
+
+void* luaval_to_ccsize(lua_State* L, int lo, void* def, CCSize* value)
+{
+    if (!lua_istable(L, lo))
+    {
+        return tolua_tousertype(L, lo, def);
+    }
+
+    readSize(L, absoluteIndex(L, lo), value);
+    return value;
+}
+
+void* luaval_to_ccrect(lua_State* L, int lo, void* def, CCRect* value)
+{
+    if (!lua_istable(L, lo))
+    {
+        return tolua_tousertype(L, lo, def);
+    }
+
+    lo = absoluteIndex(L, lo);
+    lua_getfield(L, lo, "origin");                                      /* L: ... origin */
+    readPoint(L, lua_gettop(L), &value->origin);
+    lua_getfield(L, lo, "size");                                        /* L: ... origin size */
+    readSize(L, lua_gettop(L), &value->size);
+    lua_pop(L, 2);
+    return value;
+}
+
+static void pushNewTable(lua_State* L, void* metatableKey)
+{
+    lua_createtable(L, 0, 2);
+    lua_pushlightuserdata(L, metatableKey);
+    lua_rawget(L, LUA_REGISTRYINDEX);
+    lua_setmetatable(L, -2);
+}
+
+static void pushNewPoint(lua_State* L)
+{
+    pushNewTable(L, &s_pointMetatableKey);
+}
+
+static void pushNewSize(lua_State* L)
+{
+    pushNewTable(L, &s_sizeMetatableKey);
+}
+
+static void pushNewRect(lua_State* L)
+{
+    pushNewTable(L, &s_rectMetatableKey);
+    pushNewPoint(L);
+    lua_setfield(L, -2, "origin");
+    pushNewSize(L);
+    lua_setfield(L, -2, "size");
+}
+
+// Pushes the next table of a pool, returns false if the pool is disabled.
+static bool pushPooledTable(lua_State* L, void* poolKey)
+{
+    lua_pushlightuserdata(L, poolKey);
+    lua_rawget(L, LUA_REGISTRYINDEX);                                   /* L: pool */
+    if (!lua_istable(L, -1))
+    {
+        lua_pop(L, 1);
+        return false;
+    }
+
+    // the cursor is stored at index 0
+    lua_rawgeti(L, -1, 0);
+    int cursor = (int)lua_tointeger(L, -1) % (int)lua_objlen(L, -2) + 1;
+    lua_pop(L, 1);
+    lua_pushinteger(L, cursor);
+    lua_rawseti(L, -2, 0);
+
+    lua_rawgeti(L, -1, cursor);                                         /* L: pool value */
+    lua_remove(L, -2);                                                  /* L: value */
+    return true;
+}
+
+// Pushes the field of a pooled rect, a new table if the field was replaced.
+static void pushRectField(lua_State* L, const char* name, void (*pushNew)(lua_State*))
+{
+    lua_getfield(L, -1, name);                                          /* L: rect field */
+    if (!lua_istable(L, -1))
+    {
+        lua_pop(L, 1);
+        pushNew(L);
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -3, name);
+    }
+}
+
+void ccpoint_to_luaval(lua_State* L, const CCPoint& pt)
+{
+    if (!pushPooledTable(L, &s_pointPoolKey))
+    {
+        pushNewPoint(L);
+    }
+    setNumberField(L, "x", pt.x);
+    setNumberField(L, "y", pt.y);
+}
+
+void ccsize_to_luaval(lua_State* L, const CCSize& sz)
+{
+    if (!pushPooledTable(L, &s_sizePoolKey))
+    {
+        pushNewSize(L);
+    }
+    setNumberField(L, "width", sz.width);
+    setNumberField(L, "height", sz.height);
+}
+
+void ccrect_to_luaval(lua_State* L, const CCRect& rt)
+{
+    if (!pushPooledTable(L, &s_rectPoolKey))
+    {
+        pushNewRect(L);
+    }
+
+    pushRectField(L, "origin", pushNewPoint);                           /* L: rect origin */
+    setNumberField(L, "x", rt.origin.x);
+    setNumberField(L, "y", rt.origin.y);
+    lua_pop(L, 1);
+
+    pushRectField(L, "size", pushNewSize);                              /* L: rect size */
+    setNumberField(L, "width", rt.size.width);
+    setNumberField(L, "height", rt.size.height);
+    lua_pop(L, 1);
+}
+
+static void setPool(lua_State* L, void* poolKey, int size, void (*pushNew)(lua_State*))
+{
+    lua_pushlightuserdata(L, poolKey);
+    if (size > 0)
+    {
+        lua_createtable(L, size, 1);
+        for (int i = 1; i <= size; ++i)
+        {
+            pushNew(L);
+            lua_rawseti(L, -2, i);
+        }
+        lua_pushinteger(L, 0);
+        lua_rawseti(L, -2, 0);
+    }
+    else
+    {
+        lua_pushnil(L);
+    }
+    lua_rawset(L, LUA_REGISTRYINDEX);
+}
+
+void luaval_set_pool_size(lua_State* L, int size)
+{
+    setPool(L, &s_pointPoolKey, size, pushNewPoint);
+    setPool(L, &s_sizePoolKey, size, pushNewSize);
+    setPool(L, &s_rectPoolKey, size, pushNewRect);
+}
+
+static int lua_ccSetValueTypePoolSize(lua_State* L)
+{
+    luaval_set_pool_size(L, (int)luaL_checkinteger(L, 1));
+    return 0;
+}
+
+void luaval_open(lua_State* L)
+{
+    if (luaL_loadbuffer(L, s_valueTypeMethods, strlen(s_valueTypeMethods), "value types") != 0
+        || lua_pcall(L, 0, 3, 0) != 0)
+    {
+        CCLOG("[LUA ERROR] %s", lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return;
+    }
+                                                                        /* L: point size rect */
+    lua_pushlightuserdata(L, &s_rectMetatableKey);
+    lua_insert(L, -2);
+    lua_rawset(L, LUA_REGISTRYINDEX);
+    lua_pushlightuserdata(L, &s_sizeMetatableKey);
+    lua_insert(L, -2);
+    lua_rawset(L, LUA_REGISTRYINDEX);
+    lua_pushlightuserdata(L, &s_pointMetatableKey);
+    lua_insert(L, -2);
+    lua_rawset(L, LUA_REGISTRYINDEX);
+
+    lua_register(L, "ccSetValueTypePoolSize", lua_ccSetValueTypePoolSize);
+}
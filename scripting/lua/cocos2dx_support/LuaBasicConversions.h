@@ -0,0 +1,74 @@
+/****************************************************************************
+ Copyright (c) 2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __LUA_BASIC_CONVERSIONS_H__
+#define __LUA_BASIC_CONVERSIONS_H__
+
+extern "C" {
+#include "lua.h"
+#include "tolua++.h"
+}
+
+#include "cocoa/CCGeometry.h"
+
+/**
+ Conversions of the CCPoint, CCSize and CCRect value types between C++ and Lua.
+
+ The bindings return these values as plain Lua tables instead of garbage collected
+ userdata: {x = , y = }, {width = , height = } and {origin = {x = , y = }, size = {width = , height = }}.
+ The tables share a metatable per type providing the methods of the former userdata
+ (equals, getMinX, containsPoint...).
+
+ Arguments are accepted either as such tables or as CCPoint/CCSize/CCRect userdata,
+ e.g. created with CCPoint:new().
+
+ The is/to functions are used by the tolua++ generated code, see tools/tolua++/basic.lua.
+ */
+
+bool luaval_is_ccpoint(lua_State* L, int lo, const char* type, int def, tolua_Error* err);
+bool luaval_is_ccsize(lua_State* L, int lo, const char* type, int def, tolua_Error* err);
+bool luaval_is_ccrect(lua_State* L, int lo, const char* type, int def, tolua_Error* err);
+
+/** Returns a pointer to the value of the argument lo.
+ For a table the value is converted in value, usually a local of the caller, and value is returned.
+ */
+void* luaval_to_ccpoint(lua_State* L, int lo, void* def, cocos2d::CCPoint* value);
+void* luaval_to_ccsize(lua_State* L, int lo, void* def, cocos2d::CCSize* value);
+void* luaval_to_ccrect(lua_State* L, int lo, void* def, cocos2d::CCRect* value);
+
+void ccpoint_to_luaval(lua_State* L, const cocos2d::CCPoint& pt);
+void ccsize_to_luaval(lua_State* L, const cocos2d::CCSize& sz);
+void ccrect_to_luaval(lua_State* L, const cocos2d::CCRect& rt);
+
+/** Registers the metatables of the value tables and the global function ccSetValueTypePoolSize(size). */
+void luaval_open(lua_State* L);
+
+/** Sets the number of tables recycled for each value type, 0 (the default) disables the pool.
+ With a pool, returning a value doesn't create any garbage but the returned tables are temporary:
+ a table is overwritten after size other values of the same type were returned. Copy the fields
+ of a value that must be kept.
+ */
+void luaval_set_pool_size(lua_State* L, int size);
+
+#endif // __LUA_BASIC_CONVERSIONS_H__
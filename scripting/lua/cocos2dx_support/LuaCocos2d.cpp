@@ -35,6 +35,7 @@ extern "C" {
 #include <string>
 #include "cocos2d.h"
 #include "CCLuaEngine.h"
+#include "LuaBasicConversions.h"
 #include "SimpleAudioEngine.h"
 #include "cocos-ext.h"
 
@@ -4147,10 +4148,11 @@ static int tolua_set_ccAnimationFrameData_size(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
   tolua_Error tolua_err;
   if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'size'",NULL);
-  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)))
+  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)))
    tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
 #endif
-  self->size = *((CCSize*)  tolua_tousertype(tolua_S,2,0))
+  CCSize tolua_value2;
+  self->size = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2))
 ;
  return 0;
 }
@@ -4622,7 +4624,7 @@ static int tolua_Cocos2d_CCPoint_equals00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -4630,7 +4632,8 @@ static int tolua_Cocos2d_CCPoint_equals00(lua_State* tolua_S)
 #endif
  {
   const CCPoint* self = (const CCPoint*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* target = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* target = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'equals'", NULL);
 #endif
@@ -4828,7 +4831,7 @@ static int tolua_Cocos2d_CCSize_equals00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"const CCSize",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"const CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -4836,7 +4839,8 @@ static int tolua_Cocos2d_CCSize_equals00(lua_State* tolua_S)
 #endif
  {
   const CCSize* self = (const CCSize*)  tolua_tousertype(tolua_S,1,0);
-  const CCSize* target = ((const CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  const CCSize* target = ((const CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'equals'", NULL);
 #endif
@@ -4875,10 +4879,11 @@ static int tolua_set_CCRect_origin(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
   tolua_Error tolua_err;
   if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'origin'",NULL);
-  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)))
+  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)))
    tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
 #endif
-  self->origin = *((CCPoint*)  tolua_tousertype(tolua_S,2,0))
+  CCPoint tolua_value2;
+  self->origin = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2))
 ;
  return 0;
 }
@@ -4905,10 +4910,11 @@ static int tolua_set_CCRect_size(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
   tolua_Error tolua_err;
   if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'size'",NULL);
-  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)))
+  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)))
    tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
 #endif
-  self->size = *((CCSize*)  tolua_tousertype(tolua_S,2,0))
+  CCSize tolua_value2;
+  self->size = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2))
 ;
  return 0;
 }
@@ -5234,7 +5240,7 @@ static int tolua_Cocos2d_CCRect_equals00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"const CCRect",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"const CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -5242,7 +5248,8 @@ static int tolua_Cocos2d_CCRect_equals00(lua_State* tolua_S)
 #endif
  {
   const CCRect* self = (const CCRect*)  tolua_tousertype(tolua_S,1,0);
-  const CCRect* rect = ((const CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  const CCRect* rect = ((const CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'equals'", NULL);
 #endif
@@ -5268,7 +5275,7 @@ static int tolua_Cocos2d_CCRect_containsPoint00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"const CCRect",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -5276,7 +5283,8 @@ static int tolua_Cocos2d_CCRect_containsPoint00(lua_State* tolua_S)
 #endif
  {
   const CCRect* self = (const CCRect*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* point = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* point = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'containsPoint'", NULL);
 #endif
@@ -5302,7 +5310,7 @@ static int tolua_Cocos2d_CCRect_intersectsRect00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"const CCRect",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"const CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -5310,7 +5318,8 @@ static int tolua_Cocos2d_CCRect_intersectsRect00(lua_State* tolua_S)
 #endif
  {
   const CCRect* self = (const CCRect*)  tolua_tousertype(tolua_S,1,0);
-  const CCRect* rect = ((const CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  const CCRect* rect = ((const CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'intersectsRect'", NULL);
 #endif
@@ -5348,15 +5357,7 @@ static int tolua_Cocos2d_CCPointMake00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  CCPointMake(x,y);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -5389,15 +5390,7 @@ static int tolua_Cocos2d_ccp00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  CCPointMake(x,y);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -5430,15 +5423,7 @@ static int tolua_Cocos2d_CCSizeMake00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  CCSizeMake(width,height);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -5475,15 +5460,7 @@ static int tolua_Cocos2d_CCRectMake00(lua_State* tolua_S)
   {
    CCRect tolua_ret = (CCRect)  CCRectMake(x,y,width,height);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCRect)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCRect));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccrect_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7344,26 +7321,19 @@ static int tolua_Cocos2d_ccpNeg00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,2,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* v = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   {
    CCPoint tolua_ret = (CCPoint)  ccpNeg(*v);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7383,28 +7353,22 @@ static int tolua_Cocos2d_ccpAdd00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v1 = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* v2 = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* v1 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* v2 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    CCPoint tolua_ret = (CCPoint)  ccpAdd(*v1,*v2);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7424,28 +7388,22 @@ static int tolua_Cocos2d_ccpSub00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v1 = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* v2 = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* v1 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* v2 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    CCPoint tolua_ret = (CCPoint)  ccpSub(*v1,*v2);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7465,7 +7423,7 @@ static int tolua_Cocos2d_ccpMult00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
@@ -7473,20 +7431,13 @@ static int tolua_Cocos2d_ccpMult00(lua_State* tolua_S)
  else
 #endif
  {
-  const CCPoint* v = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* v = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   const float s = ((const float)  tolua_tonumber(tolua_S,2,0));
   {
    CCPoint tolua_ret = (CCPoint)  ccpMult(*v,s);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7506,28 +7457,22 @@ static int tolua_Cocos2d_ccpMidpoint00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v1 = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* v2 = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* v1 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* v2 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    CCPoint tolua_ret = (CCPoint)  ccpMidpoint(*v1,*v2);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7547,16 +7492,18 @@ static int tolua_Cocos2d_ccpDot00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v1 = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* v2 = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* v1 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* v2 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    float tolua_ret = (float)  ccpDot(*v1,*v2);
    tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
@@ -7578,16 +7525,18 @@ static int tolua_Cocos2d_ccpCross00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v1 = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* v2 = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* v1 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* v2 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    float tolua_ret = (float)  ccpCross(*v1,*v2);
    tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
@@ -7609,26 +7558,19 @@ static int tolua_Cocos2d_ccpPerp00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,2,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* v = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   {
    CCPoint tolua_ret = (CCPoint)  ccpPerp(*v);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7648,26 +7590,19 @@ static int tolua_Cocos2d_ccpRPerp00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,2,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* v = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   {
    CCPoint tolua_ret = (CCPoint)  ccpRPerp(*v);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7687,28 +7622,22 @@ static int tolua_Cocos2d_ccpProject00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v1 = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* v2 = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* v1 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* v2 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    CCPoint tolua_ret = (CCPoint)  ccpProject(*v1,*v2);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7728,28 +7657,22 @@ static int tolua_Cocos2d_ccpRotate00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v1 = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* v2 = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* v1 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* v2 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    CCPoint tolua_ret = (CCPoint)  ccpRotate(*v1,*v2);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7769,28 +7692,22 @@ static int tolua_Cocos2d_ccpUnrotate00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v1 = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* v2 = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* v1 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* v2 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    CCPoint tolua_ret = (CCPoint)  ccpUnrotate(*v1,*v2);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7810,14 +7727,15 @@ static int tolua_Cocos2d_ccpLengthSQ00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,2,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* v = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   {
    float tolua_ret = (float)  ccpLengthSQ(*v);
    tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
@@ -7839,16 +7757,18 @@ static int tolua_Cocos2d_ccpDistanceSQ00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint p1 = *((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint p2 = *((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint p1 = *((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint p2 = *((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    float tolua_ret = (float)  ccpDistanceSQ(p1,p2);
    tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
@@ -7870,14 +7790,15 @@ static int tolua_Cocos2d_ccpLength00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,2,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* v = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   {
    float tolua_ret = (float)  ccpLength(*v);
    tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
@@ -7899,16 +7820,18 @@ static int tolua_Cocos2d_ccpDistance00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v1 = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* v2 = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* v1 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* v2 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    float tolua_ret = (float)  ccpDistance(*v1,*v2);
    tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
@@ -7930,26 +7853,19 @@ static int tolua_Cocos2d_ccpNormalize00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,2,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* v = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   {
    CCPoint tolua_ret = (CCPoint)  ccpNormalize(*v);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -7980,15 +7896,7 @@ static int tolua_Cocos2d_ccpForAngle00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  ccpForAngle(a);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -8008,14 +7916,15 @@ static int tolua_Cocos2d_ccpToAngle00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,2,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* v = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* v = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   {
    float tolua_ret = (float)  ccpToAngle(*v);
    tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
@@ -8070,30 +7979,25 @@ static int tolua_Cocos2d_ccpClamp00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* p = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* from = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
-  const CCPoint* to = ((const CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value1;
+  const CCPoint* p = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* from = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
+  CCPoint tolua_value3;
+  const CCPoint* to = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
   {
    CCPoint tolua_ret = (CCPoint)  ccpClamp(*p,*from,*to);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -8113,26 +8017,19 @@ static int tolua_Cocos2d_ccpFromSize00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccsize(tolua_S,1,"const CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,2,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCSize* s = ((const CCSize*)  tolua_tousertype(tolua_S,1,0));
+  CCSize tolua_value1;
+  const CCSize* s = ((const CCSize*)  luaval_to_ccsize(tolua_S,1,0,&tolua_value1));
   {
    CCPoint tolua_ret = (CCPoint)  ccpFromSize(*s);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -8152,8 +8049,8 @@ static int tolua_Cocos2d_ccpLerp00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -8161,21 +8058,15 @@ static int tolua_Cocos2d_ccpLerp00(lua_State* tolua_S)
  else
 #endif
  {
-  const CCPoint* a = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* b = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* a = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* b = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   float alpha = ((float)  tolua_tonumber(tolua_S,3,0));
   {
    CCPoint tolua_ret = (CCPoint)  ccpLerp(*a,*b,alpha);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -8195,8 +8086,8 @@ static int tolua_Cocos2d_ccpFuzzyEqual00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -8204,8 +8095,10 @@ static int tolua_Cocos2d_ccpFuzzyEqual00(lua_State* tolua_S)
  else
 #endif
  {
-  const CCPoint* a = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* b = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* a = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* b = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   float variance = ((float)  tolua_tonumber(tolua_S,3,0));
   {
    bool tolua_ret = (bool)  ccpFuzzyEqual(*a,*b,variance);
@@ -8228,28 +8121,22 @@ static int tolua_Cocos2d_ccpCompMult00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* a = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* b = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* a = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* b = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    CCPoint tolua_ret = (CCPoint)  ccpCompMult(*a,*b);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -8269,16 +8156,18 @@ static int tolua_Cocos2d_ccpAngleSigned00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* a = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* b = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* a = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* b = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    float tolua_ret = (float)  ccpAngleSigned(*a,*b);
    tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
@@ -8300,16 +8189,18 @@ static int tolua_Cocos2d_ccpAngle00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* a = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* b = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* a = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* b = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    float tolua_ret = (float)  ccpAngle(*a,*b);
    tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
@@ -8331,8 +8222,8 @@ static int tolua_Cocos2d_ccpRotateByAngle00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -8340,21 +8231,15 @@ static int tolua_Cocos2d_ccpRotateByAngle00(lua_State* tolua_S)
  else
 #endif
  {
-  const CCPoint* v = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* pivot = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  const CCPoint* v = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* pivot = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   float angle = ((float)  tolua_tonumber(tolua_S,3,0));
   {
    CCPoint tolua_ret = (CCPoint)  ccpRotateByAngle(*v,*pivot,angle);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -8374,10 +8259,10 @@ static int tolua_Cocos2d_ccpLineIntersect00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccpoint(tolua_S,4,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,6,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,7,&tolua_err)
@@ -8386,10 +8271,14 @@ static int tolua_Cocos2d_ccpLineIntersect00(lua_State* tolua_S)
  else
 #endif
  {
-  const CCPoint* p1 = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* p2 = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
-  const CCPoint* p3 = ((const CCPoint*)  tolua_tousertype(tolua_S,3,0));
-  const CCPoint* p4 = ((const CCPoint*)  tolua_tousertype(tolua_S,4,0));
+  CCPoint tolua_value1;
+  const CCPoint* p1 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* p2 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
+  CCPoint tolua_value3;
+  const CCPoint* p3 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
+  CCPoint tolua_value4;
+  const CCPoint* p4 = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,4,0,&tolua_value4));
   float s = ((float)  tolua_tonumber(tolua_S,5,0));
   float t = ((float)  tolua_tonumber(tolua_S,6,0));
   {
@@ -8415,20 +8304,24 @@ static int tolua_Cocos2d_ccpSegmentIntersect00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccpoint(tolua_S,4,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,5,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* A = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* B = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
-  const CCPoint* C = ((const CCPoint*)  tolua_tousertype(tolua_S,3,0));
-  const CCPoint* D = ((const CCPoint*)  tolua_tousertype(tolua_S,4,0));
+  CCPoint tolua_value1;
+  const CCPoint* A = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* B = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
+  CCPoint tolua_value3;
+  const CCPoint* C = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
+  CCPoint tolua_value4;
+  const CCPoint* D = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,4,0,&tolua_value4));
   {
    bool tolua_ret = (bool)  ccpSegmentIntersect(*A,*B,*C,*D);
    tolua_pushboolean(tolua_S,(bool)tolua_ret);
@@ -8450,32 +8343,28 @@ static int tolua_Cocos2d_ccpIntersectPoint00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccpoint(tolua_S,4,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,5,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  const CCPoint* A = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  const CCPoint* B = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
-  const CCPoint* C = ((const CCPoint*)  tolua_tousertype(tolua_S,3,0));
-  const CCPoint* D = ((const CCPoint*)  tolua_tousertype(tolua_S,4,0));
+  CCPoint tolua_value1;
+  const CCPoint* A = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  const CCPoint* B = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
+  CCPoint tolua_value3;
+  const CCPoint* C = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
+  CCPoint tolua_value4;
+  const CCPoint* D = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,4,0,&tolua_value4));
   {
    CCPoint tolua_ret = (CCPoint)  ccpIntersectPoint(*A,*B,*C,*D);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -8508,7 +8397,7 @@ static int tolua_Cocos2d_CCEGLViewProtocol_getFrameSize00(lua_State* tolua_S)
 #endif
   {
    const CCSize& tolua_ret = (const CCSize&)  self->getFrameSize();
-    tolua_pushusertype(tolua_S,(void*)&tolua_ret,"const CCSize");
+    ccsize_to_luaval(tolua_S,tolua_ret);
   }
  }
  return 1;
@@ -8576,15 +8465,7 @@ static int tolua_Cocos2d_CCEGLViewProtocol_getVisibleSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getVisibleSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -8618,15 +8499,7 @@ static int tolua_Cocos2d_CCEGLViewProtocol_getVisibleOrigin00(lua_State* tolua_S
   {
    CCPoint tolua_ret = (CCPoint)  self->getVisibleOrigin();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -8696,7 +8569,7 @@ static int tolua_Cocos2d_CCEGLViewProtocol_getDesignResolutionSize00(lua_State*
 #endif
   {
    const CCSize& tolua_ret = (const CCSize&)  self->getDesignResolutionSize();
-    tolua_pushusertype(tolua_S,(void*)&tolua_ret,"const CCSize");
+    ccsize_to_luaval(tolua_S,tolua_ret);
   }
  }
  return 1;
@@ -8839,7 +8712,7 @@ static int tolua_Cocos2d_CCEGLViewProtocol_getViewPortRect00(lua_State* tolua_S)
 #endif
   {
    const CCRect& tolua_ret = (const CCRect&)  self->getViewPortRect();
-    tolua_pushusertype(tolua_S,(void*)&tolua_ret,"const CCRect");
+    ccrect_to_luaval(tolua_S,tolua_ret);
   }
  }
  return 1;
@@ -9757,14 +9630,15 @@ static int tolua_Cocos2d_ccDrawPoint00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,2,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  CCPoint point = *((CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  CCPoint point = *((CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   {
    ccDrawPoint(point);
   }
@@ -9785,7 +9659,7 @@ static int tolua_Cocos2d_ccDrawPoints00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err) ||
+     !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
@@ -9793,7 +9667,8 @@ static int tolua_Cocos2d_ccDrawPoints00(lua_State* tolua_S)
  else
 #endif
  {
-  const CCPoint* points = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* points = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   unsigned int numberOfPoints = ((unsigned int)  tolua_tonumber(tolua_S,2,0));
   {
    ccDrawPoints(points,numberOfPoints);
@@ -9815,16 +9690,18 @@ static int tolua_Cocos2d_ccDrawLine00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  CCPoint origin = *((CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  CCPoint destination = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  CCPoint origin = *((CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  CCPoint destination = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    ccDrawLine(origin,destination);
   }
@@ -9845,16 +9722,18 @@ static int tolua_Cocos2d_ccDrawRect00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  CCPoint origin = *((CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  CCPoint destination = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  CCPoint origin = *((CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  CCPoint destination = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    ccDrawRect(origin,destination);
   }
@@ -9875,8 +9754,8 @@ static int tolua_Cocos2d_ccDrawSolidRect00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"ccColor4F",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -9884,8 +9763,10 @@ static int tolua_Cocos2d_ccDrawSolidRect00(lua_State* tolua_S)
  else
 #endif
  {
-  CCPoint origin = *((CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  CCPoint destination = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value1;
+  CCPoint origin = *((CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  CCPoint destination = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   ccColor4F color = *((ccColor4F*)  tolua_tousertype(tolua_S,3,0));
   {
    ccDrawSolidRect(origin,destination,color);
@@ -9907,7 +9788,7 @@ static int tolua_Cocos2d_ccDrawPoly00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err) ||
+     !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
      !tolua_isboolean(tolua_S,3,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
@@ -9916,7 +9797,8 @@ static int tolua_Cocos2d_ccDrawPoly00(lua_State* tolua_S)
  else
 #endif
  {
-  const CCPoint* vertices = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* vertices = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   unsigned int numOfVertices = ((unsigned int)  tolua_tonumber(tolua_S,2,0));
   bool closePolygon = ((bool)  tolua_toboolean(tolua_S,3,0));
   {
@@ -9939,7 +9821,7 @@ static int tolua_Cocos2d_ccDrawSolidPoly00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err) ||
+     !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
      (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"ccColor4F",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
@@ -9948,7 +9830,8 @@ static int tolua_Cocos2d_ccDrawSolidPoly00(lua_State* tolua_S)
  else
 #endif
  {
-  const CCPoint* poli = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* poli = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   unsigned int numberOfPoints = ((unsigned int)  tolua_tonumber(tolua_S,2,0));
   ccColor4F color = *((ccColor4F*)  tolua_tousertype(tolua_S,3,0));
   {
@@ -9971,7 +9854,7 @@ static int tolua_Cocos2d_ccDrawCircle00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
@@ -9984,7 +9867,8 @@ static int tolua_Cocos2d_ccDrawCircle00(lua_State* tolua_S)
  else
 #endif
  {
-  const CCPoint* center = ((const CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  const CCPoint* center = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   float radius = ((float)  tolua_tonumber(tolua_S,2,0));
   float angle = ((float)  tolua_tonumber(tolua_S,3,0));
   unsigned int segments = ((unsigned int)  tolua_tonumber(tolua_S,4,0));
@@ -10011,9 +9895,9 @@ static int tolua_Cocos2d_ccDrawQuadBezier00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,5,&tolua_err)
  )
@@ -10021,9 +9905,12 @@ static int tolua_Cocos2d_ccDrawQuadBezier00(lua_State* tolua_S)
  else
 #endif
  {
-  CCPoint origin = *((CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  CCPoint control = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
-  CCPoint destination = *((CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value1;
+  CCPoint origin = *((CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  CCPoint control = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
+  CCPoint tolua_value3;
+  CCPoint destination = *((CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
   unsigned int segments = ((unsigned int)  tolua_tonumber(tolua_S,4,0));
   {
    ccDrawQuadBezier(origin,control,destination,segments);
@@ -10045,10 +9932,10 @@ static int tolua_Cocos2d_ccDrawCubicBezier00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccpoint(tolua_S,4,"CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
  )
@@ -10056,10 +9943,14 @@ static int tolua_Cocos2d_ccDrawCubicBezier00(lua_State* tolua_S)
  else
 #endif
  {
-  CCPoint origin = *((CCPoint*)  tolua_tousertype(tolua_S,1,0));
-  CCPoint control1 = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
-  CCPoint control2 = *((CCPoint*)  tolua_tousertype(tolua_S,3,0));
-  CCPoint destination = *((CCPoint*)  tolua_tousertype(tolua_S,4,0));
+  CCPoint tolua_value1;
+  CCPoint origin = *((CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
+  CCPoint tolua_value2;
+  CCPoint control1 = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
+  CCPoint tolua_value3;
+  CCPoint control2 = *((CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
+  CCPoint tolua_value4;
+  CCPoint destination = *((CCPoint*)  luaval_to_ccpoint(tolua_S,4,0,&tolua_value4));
   unsigned int segments = ((unsigned int)  tolua_tonumber(tolua_S,5,0));
   {
    ccDrawCubicBezier(origin,control1,control2,destination,segments);
@@ -10232,6 +10123,34 @@ static int tolua_Cocos2d_ccPointSize00(lua_State* tolua_S)
 }
 #endif //#ifndef TOLUA_DISABLE
 
+/* function: ccGLLineWidth */
+#ifndef TOLUA_DISABLE_tolua_Cocos2d_ccGLLineWidth00
+static int tolua_Cocos2d_ccGLLineWidth00(lua_State* tolua_S)
+{
+#ifndef TOLUA_RELEASE
+ tolua_Error tolua_err;
+ if (
+     !tolua_isnumber(tolua_S,1,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,2,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+   float width = ((  float)  tolua_tonumber(tolua_S,1,0));
+  {
+   ccGLLineWidth(width);
+  }
+ }
+ return 0;
+#ifndef TOLUA_RELEASE
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'ccGLLineWidth'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
 /* get function: a of class  CCAffineTransform */
 #ifndef TOLUA_DISABLE_tolua_get_CCAffineTransform_a
 static int tolua_get_CCAffineTransform_a(lua_State* tolua_S)
@@ -10517,7 +10436,7 @@ static int tolua_Cocos2d___CCPointApplyAffineTransform00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"CCPoint",0,&tolua_err)) ||
      (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCAffineTransform",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
@@ -10525,20 +10444,13 @@ static int tolua_Cocos2d___CCPointApplyAffineTransform00(lua_State* tolua_S)
  else
 #endif
  {
-  CCPoint point = *((CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  CCPoint point = *((CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   CCAffineTransform t = *((CCAffineTransform*)  tolua_tousertype(tolua_S,2,0));
   {
    CCPoint tolua_ret = (CCPoint)  __CCPointApplyAffineTransform(point,t);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -10558,7 +10470,7 @@ static int tolua_Cocos2d_CCPointApplyAffineTransform00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccpoint(tolua_S,1,"CCPoint",0,&tolua_err)) ||
      (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCAffineTransform",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
@@ -10566,20 +10478,13 @@ static int tolua_Cocos2d_CCPointApplyAffineTransform00(lua_State* tolua_S)
  else
 #endif
  {
-  CCPoint point = *((CCPoint*)  tolua_tousertype(tolua_S,1,0));
+  CCPoint tolua_value1;
+  CCPoint point = *((CCPoint*)  luaval_to_ccpoint(tolua_S,1,0,&tolua_value1));
   CCAffineTransform t = *((CCAffineTransform*)  tolua_tousertype(tolua_S,2,0));
   {
    CCPoint tolua_ret = (CCPoint)  CCPointApplyAffineTransform(point,t);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -10599,7 +10504,7 @@ static int tolua_Cocos2d_CCSizeApplyAffineTransform00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccsize(tolua_S,1,"CCSize",0,&tolua_err)) ||
      (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCAffineTransform",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
@@ -10607,20 +10512,13 @@ static int tolua_Cocos2d_CCSizeApplyAffineTransform00(lua_State* tolua_S)
  else
 #endif
  {
-  CCSize size = *((CCSize*)  tolua_tousertype(tolua_S,1,0));
+  CCSize tolua_value1;
+  CCSize size = *((CCSize*)  luaval_to_ccsize(tolua_S,1,0,&tolua_value1));
   CCAffineTransform t = *((CCAffineTransform*)  tolua_tousertype(tolua_S,2,0));
   {
    CCSize tolua_ret = (CCSize)  CCSizeApplyAffineTransform(size,t);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -10640,7 +10538,7 @@ static int tolua_Cocos2d___CCSizeApplyAffineTransform00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccsize(tolua_S,1,"CCSize",0,&tolua_err)) ||
      (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCAffineTransform",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
@@ -10648,20 +10546,13 @@ static int tolua_Cocos2d___CCSizeApplyAffineTransform00(lua_State* tolua_S)
  else
 #endif
  {
-  CCSize size = *((CCSize*)  tolua_tousertype(tolua_S,1,0));
+  CCSize tolua_value1;
+  CCSize size = *((CCSize*)  luaval_to_ccsize(tolua_S,1,0,&tolua_value1));
   CCAffineTransform t = *((CCAffineTransform*)  tolua_tousertype(tolua_S,2,0));
   {
    CCSize tolua_ret = (CCSize)  __CCSizeApplyAffineTransform(size,t);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -10718,7 +10609,7 @@ static int tolua_Cocos2d_CCRectApplyAffineTransform00(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
  tolua_Error tolua_err;
  if (
-     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !tolua_isusertype(tolua_S,1,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,1,&tolua_err) || !luaval_is_ccrect(tolua_S,1,"CCRect",0,&tolua_err)) ||
      (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCAffineTransform",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
@@ -10726,20 +10617,13 @@ static int tolua_Cocos2d_CCRectApplyAffineTransform00(lua_State* tolua_S)
  else
 #endif
  {
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,1,0));
+  CCRect tolua_value1;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,1,0,&tolua_value1));
   CCAffineTransform anAffineTransform = *((CCAffineTransform*)  tolua_tousertype(tolua_S,2,0));
   {
    CCRect tolua_ret = (CCRect)  CCRectApplyAffineTransform(rect,anAffineTransform);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCRect)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCRect));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccrect_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -11424,15 +11308,7 @@ static int tolua_Cocos2d_CCDirector_getWinSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getWinSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -11466,15 +11342,7 @@ static int tolua_Cocos2d_CCDirector_getWinSizeInPixels00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getWinSizeInPixels();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -11495,7 +11363,7 @@ static int tolua_Cocos2d_CCDirector_convertToGL00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCDirector",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -11503,22 +11371,15 @@ static int tolua_Cocos2d_CCDirector_convertToGL00(lua_State* tolua_S)
 #endif
  {
   CCDirector* self = (CCDirector*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint obPoint = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint obPoint = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'convertToGL'", NULL);
 #endif
   {
    CCPoint tolua_ret = (CCPoint)  self->convertToGL(obPoint);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -11539,7 +11400,7 @@ static int tolua_Cocos2d_CCDirector_convertToUI00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCDirector",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -11547,22 +11408,15 @@ static int tolua_Cocos2d_CCDirector_convertToUI00(lua_State* tolua_S)
 #endif
  {
   CCDirector* self = (CCDirector*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint obPoint = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint obPoint = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'convertToUI'", NULL);
 #endif
   {
    CCPoint tolua_ret = (CCPoint)  self->convertToUI(obPoint);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -12245,15 +12099,7 @@ static int tolua_Cocos2d_CCDirector_getVisibleSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getVisibleSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -12287,15 +12133,7 @@ static int tolua_Cocos2d_CCDirector_getVisibleOrigin00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getVisibleOrigin();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -14183,14 +14021,15 @@ static int tolua_Cocos2d_CCNode_setPosition01(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCNode",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
  {
   CCNode* self = (CCNode*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setPosition'", NULL);
 #endif
@@ -14486,15 +14325,7 @@ static int tolua_Cocos2d_CCNode_getAnchorPoint00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getAnchorPoint();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -14515,7 +14346,7 @@ static int tolua_Cocos2d_CCNode_setAnchorPoint00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCNode",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -14523,7 +14354,8 @@ static int tolua_Cocos2d_CCNode_setAnchorPoint00(lua_State* tolua_S)
 #endif
  {
   CCNode* self = (CCNode*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint point = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint point = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setAnchorPoint'", NULL);
 #endif
@@ -14561,15 +14393,7 @@ static int tolua_Cocos2d_CCNode_getContentSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getContentSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -14590,7 +14414,7 @@ static int tolua_Cocos2d_CCNode_setContentSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCNode",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"const CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -14598,7 +14422,8 @@ static int tolua_Cocos2d_CCNode_setContentSize00(lua_State* tolua_S)
 #endif
  {
   CCNode* self = (CCNode*)  tolua_tousertype(tolua_S,1,0);
-  const CCSize* size = ((const CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  const CCSize* size = ((const CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setContentSize'", NULL);
 #endif
@@ -14866,15 +14691,7 @@ static int tolua_Cocos2d_CCNode_getAnchorPointInPoints00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getAnchorPointInPoints();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -15941,15 +15758,7 @@ static int tolua_Cocos2d_CCNode_boundingBox00(lua_State* tolua_S)
   {
    CCRect tolua_ret = (CCRect)  self->boundingBox();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCRect)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCRect));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccrect_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -16407,7 +16216,7 @@ static int tolua_Cocos2d_CCNode_convertToNodeSpace00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCNode",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -16415,22 +16224,15 @@ static int tolua_Cocos2d_CCNode_convertToNodeSpace00(lua_State* tolua_S)
 #endif
  {
   CCNode* self = (CCNode*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint worldPoint = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint worldPoint = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'convertToNodeSpace'", NULL);
 #endif
   {
    CCPoint tolua_ret = (CCPoint)  self->convertToNodeSpace(worldPoint);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -16451,7 +16253,7 @@ static int tolua_Cocos2d_CCNode_convertToWorldSpace00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCNode",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -16459,22 +16261,15 @@ static int tolua_Cocos2d_CCNode_convertToWorldSpace00(lua_State* tolua_S)
 #endif
  {
   CCNode* self = (CCNode*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint nodePoint = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint nodePoint = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'convertToWorldSpace'", NULL);
 #endif
   {
    CCPoint tolua_ret = (CCPoint)  self->convertToWorldSpace(nodePoint);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -16495,7 +16290,7 @@ static int tolua_Cocos2d_CCNode_convertToNodeSpaceAR00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCNode",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -16503,22 +16298,15 @@ static int tolua_Cocos2d_CCNode_convertToNodeSpaceAR00(lua_State* tolua_S)
 #endif
  {
   CCNode* self = (CCNode*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint worldPoint = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint worldPoint = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'convertToNodeSpaceAR'", NULL);
 #endif
   {
    CCPoint tolua_ret = (CCPoint)  self->convertToNodeSpaceAR(worldPoint);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -16539,7 +16327,7 @@ static int tolua_Cocos2d_CCNode_convertToWorldSpaceAR00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCNode",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -16547,22 +16335,15 @@ static int tolua_Cocos2d_CCNode_convertToWorldSpaceAR00(lua_State* tolua_S)
 #endif
  {
   CCNode* self = (CCNode*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint nodePoint = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint nodePoint = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'convertToWorldSpaceAR'", NULL);
 #endif
   {
    CCPoint tolua_ret = (CCPoint)  self->convertToWorldSpaceAR(nodePoint);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -16598,15 +16379,7 @@ static int tolua_Cocos2d_CCNode_convertTouchToNodeSpace00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->convertTouchToNodeSpace(touch);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -16642,15 +16415,7 @@ static int tolua_Cocos2d_CCNode_convertTouchToNodeSpaceAR00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->convertTouchToNodeSpaceAR(touch);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -17876,15 +17641,7 @@ static int tolua_Cocos2d_CCTexture2D_getContentSizeInPixels00(lua_State* tolua_S
   {
    CCSize tolua_ret = (CCSize)  self->getContentSizeInPixels();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -18099,7 +17856,7 @@ static int tolua_Cocos2d_CCTexture2D_drawAtPoint00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTexture2D",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -18107,7 +17864,8 @@ static int tolua_Cocos2d_CCTexture2D_drawAtPoint00(lua_State* tolua_S)
 #endif
  {
   CCTexture2D* self = (CCTexture2D*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint point = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint point = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'drawAtPoint'", NULL);
 #endif
@@ -18132,7 +17890,7 @@ static int tolua_Cocos2d_CCTexture2D_drawInRect00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTexture2D",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -18140,7 +17898,8 @@ static int tolua_Cocos2d_CCTexture2D_drawInRect00(lua_State* tolua_S)
 #endif
  {
   CCTexture2D* self = (CCTexture2D*)  tolua_tousertype(tolua_S,1,0);
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'drawInRect'", NULL);
 #endif
@@ -18178,15 +17937,7 @@ static int tolua_Cocos2d_CCTexture2D_getContentSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getContentSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -20232,15 +19983,7 @@ static int tolua_Cocos2d_CCSprite_getTextureRect00(lua_State* tolua_S)
   {
    CCRect tolua_ret = (CCRect)  self->getTextureRect();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCRect)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCRect));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccrect_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -20513,15 +20256,7 @@ static int tolua_Cocos2d_CCSprite_getOffsetPosition00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getOffsetPosition();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -21165,7 +20900,7 @@ static int tolua_Cocos2d_CCSprite_setAnchorPoint00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCSprite",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -21173,7 +20908,8 @@ static int tolua_Cocos2d_CCSprite_setAnchorPoint00(lua_State* tolua_S)
 #endif
  {
   CCSprite* self = (CCSprite*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* anchor = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* anchor = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setAnchorPoint'", NULL);
 #endif
@@ -21534,7 +21270,7 @@ static int tolua_Cocos2d_CCSprite_setTextureRect00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCSprite",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -21542,7 +21278,8 @@ static int tolua_Cocos2d_CCSprite_setTextureRect00(lua_State* tolua_S)
 #endif
  {
   CCSprite* self = (CCSprite*)  tolua_tousertype(tolua_S,1,0);
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setTextureRect'", NULL);
 #endif
@@ -21566,18 +21303,20 @@ static int tolua_Cocos2d_CCSprite_setTextureRect01(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCSprite",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"CCRect",0,&tolua_err)) ||
      !tolua_isboolean(tolua_S,3,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccsize(tolua_S,4,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,5,&tolua_err)
  )
   goto tolua_lerror;
  else
  {
   CCSprite* self = (CCSprite*)  tolua_tousertype(tolua_S,1,0);
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
   bool rotated = ((bool)  tolua_toboolean(tolua_S,3,0));
-  CCSize size = *((CCSize*)  tolua_tousertype(tolua_S,4,0));
+  CCSize tolua_value4;
+  CCSize size = *((CCSize*)  luaval_to_ccsize(tolua_S,4,0,&tolua_value4));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setTextureRect'", NULL);
 #endif
@@ -21599,7 +21338,7 @@ static int tolua_Cocos2d_CCSprite_setVertexRect00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCSprite",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -21607,7 +21346,8 @@ static int tolua_Cocos2d_CCSprite_setVertexRect00(lua_State* tolua_S)
 #endif
  {
   CCSprite* self = (CCSprite*)  tolua_tousertype(tolua_S,1,0);
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setVertexRect'", NULL);
 #endif
@@ -21867,14 +21607,15 @@ static int tolua_Cocos2d_CCSprite_createWithTexture01(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCSprite",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCTexture2D",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
  else
  {
   CCTexture2D* pTexture = ((CCTexture2D*)  tolua_tousertype(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   {
    CCSprite* tolua_ret = (CCSprite*)  CCSprite::createWithTexture(pTexture,rect);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -21961,7 +21702,7 @@ static int tolua_Cocos2d_CCSprite_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCSprite",0,&tolua_err) ||
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -21969,7 +21710,8 @@ static int tolua_Cocos2d_CCSprite_create00(lua_State* tolua_S)
 #endif
  {
   const char* pszFileName = ((const char*)  tolua_tostring(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   {
    CCSprite* tolua_ret = (CCSprite*)  CCSprite::create(pszFileName,rect);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -22993,15 +22735,7 @@ static int tolua_Cocos2d_CCSpriteFrame_getRectInPixels00(lua_State* tolua_S)
   {
    CCRect tolua_ret = (CCRect)  self->getRectInPixels();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCRect)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCRect));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccrect_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -23022,7 +22756,7 @@ static int tolua_Cocos2d_CCSpriteFrame_setRectInPixels00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCSpriteFrame",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -23030,7 +22764,8 @@ static int tolua_Cocos2d_CCSpriteFrame_setRectInPixels00(lua_State* tolua_S)
 #endif
  {
   CCSpriteFrame* self = (CCSpriteFrame*)  tolua_tousertype(tolua_S,1,0);
-  CCRect rectInPixels = *((CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  CCRect rectInPixels = *((CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setRectInPixels'", NULL);
 #endif
@@ -23133,15 +22868,7 @@ static int tolua_Cocos2d_CCSpriteFrame_getRect00(lua_State* tolua_S)
   {
    CCRect tolua_ret = (CCRect)  self->getRect();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCRect)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCRect));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccrect_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -23162,7 +22889,7 @@ static int tolua_Cocos2d_CCSpriteFrame_setRect00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCSpriteFrame",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -23170,7 +22897,8 @@ static int tolua_Cocos2d_CCSpriteFrame_setRect00(lua_State* tolua_S)
 #endif
  {
   CCSpriteFrame* self = (CCSpriteFrame*)  tolua_tousertype(tolua_S,1,0);
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setRect'", NULL);
 #endif
@@ -23208,15 +22936,7 @@ static int tolua_Cocos2d_CCSpriteFrame_getOffsetInPixels00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getOffsetInPixels();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -23237,7 +22957,7 @@ static int tolua_Cocos2d_CCSpriteFrame_setOffsetInPixels00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCSpriteFrame",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -23245,7 +22965,8 @@ static int tolua_Cocos2d_CCSpriteFrame_setOffsetInPixels00(lua_State* tolua_S)
 #endif
  {
   CCSpriteFrame* self = (CCSpriteFrame*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint offsetInPixels = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint offsetInPixels = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setOffsetInPixels'", NULL);
 #endif
@@ -23283,15 +23004,7 @@ static int tolua_Cocos2d_CCSpriteFrame_getOriginalSizeInPixels00(lua_State* tolu
   {
    CCSize tolua_ret = (CCSize)  self->getOriginalSizeInPixels();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -23312,7 +23025,7 @@ static int tolua_Cocos2d_CCSpriteFrame_setOriginalSizeInPixels00(lua_State* tolu
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCSpriteFrame",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -23320,7 +23033,8 @@ static int tolua_Cocos2d_CCSpriteFrame_setOriginalSizeInPixels00(lua_State* tolu
 #endif
  {
   CCSpriteFrame* self = (CCSpriteFrame*)  tolua_tousertype(tolua_S,1,0);
-  CCSize sizeInPixels = *((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize sizeInPixels = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setOriginalSizeInPixels'", NULL);
 #endif
@@ -23357,7 +23071,7 @@ static int tolua_Cocos2d_CCSpriteFrame_getOriginalSize00(lua_State* tolua_S)
 #endif
   {
    const CCSize& tolua_ret = (const CCSize&)  self->getOriginalSize();
-    tolua_pushusertype(tolua_S,(void*)&tolua_ret,"const CCSize");
+    ccsize_to_luaval(tolua_S,tolua_ret);
   }
  }
  return 1;
@@ -23377,7 +23091,7 @@ static int tolua_Cocos2d_CCSpriteFrame_setOriginalSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCSpriteFrame",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"const CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -23385,7 +23099,8 @@ static int tolua_Cocos2d_CCSpriteFrame_setOriginalSize00(lua_State* tolua_S)
 #endif
  {
   CCSpriteFrame* self = (CCSpriteFrame*)  tolua_tousertype(tolua_S,1,0);
-  const CCSize* size = ((const CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  const CCSize* size = ((const CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setOriginalSize'", NULL);
 #endif
@@ -23489,7 +23204,7 @@ static int tolua_Cocos2d_CCSpriteFrame_getOffset00(lua_State* tolua_S)
 #endif
   {
    const CCPoint& tolua_ret = (const CCPoint&)  self->getOffset();
-    tolua_pushusertype(tolua_S,(void*)&tolua_ret,"const CCPoint");
+    ccpoint_to_luaval(tolua_S,tolua_ret);
   }
  }
  return 1;
@@ -23509,7 +23224,7 @@ static int tolua_Cocos2d_CCSpriteFrame_setOffset00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCSpriteFrame",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -23517,7 +23232,8 @@ static int tolua_Cocos2d_CCSpriteFrame_setOffset00(lua_State* tolua_S)
 #endif
  {
   CCSpriteFrame* self = (CCSpriteFrame*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* offsets = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* offsets = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setOffset'", NULL);
 #endif
@@ -23543,10 +23259,10 @@ static int tolua_Cocos2d_CCSpriteFrame_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCSpriteFrame",0,&tolua_err) ||
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isboolean(tolua_S,4,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !tolua_isusertype(tolua_S,5,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,6,&tolua_err) || !tolua_isusertype(tolua_S,6,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !luaval_is_ccpoint(tolua_S,5,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,6,&tolua_err) || !luaval_is_ccsize(tolua_S,6,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,7,&tolua_err)
  )
   goto tolua_lerror;
@@ -23554,10 +23270,13 @@ static int tolua_Cocos2d_CCSpriteFrame_create00(lua_State* tolua_S)
 #endif
  {
   const char* filename = ((const char*)  tolua_tostring(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   bool rotated = ((bool)  tolua_toboolean(tolua_S,4,0));
-  CCPoint offset = *((CCPoint*)  tolua_tousertype(tolua_S,5,0));
-  CCSize originalSize = *((CCSize*)  tolua_tousertype(tolua_S,6,0));
+  CCPoint tolua_value5;
+  CCPoint offset = *((CCPoint*)  luaval_to_ccpoint(tolua_S,5,0,&tolua_value5));
+  CCSize tolua_value6;
+  CCSize originalSize = *((CCSize*)  luaval_to_ccsize(tolua_S,6,0,&tolua_value6));
   {
    CCSpriteFrame* tolua_ret = (CCSpriteFrame*)  CCSpriteFrame::create(filename,rect,rotated,offset,originalSize);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -23582,14 +23301,15 @@ static int tolua_Cocos2d_CCSpriteFrame_create01(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCSpriteFrame",0,&tolua_err) ||
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
  else
  {
   const char* filename = ((const char*)  tolua_tostring(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   {
    CCSpriteFrame* tolua_ret = (CCSpriteFrame*)  CCSpriteFrame::create(filename,rect);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -23612,10 +23332,10 @@ static int tolua_Cocos2d_CCSpriteFrame_createWithTexture00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCSpriteFrame",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCTexture2D",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isboolean(tolua_S,4,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !tolua_isusertype(tolua_S,5,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,6,&tolua_err) || !tolua_isusertype(tolua_S,6,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !luaval_is_ccpoint(tolua_S,5,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,6,&tolua_err) || !luaval_is_ccsize(tolua_S,6,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,7,&tolua_err)
  )
   goto tolua_lerror;
@@ -23623,10 +23343,13 @@ static int tolua_Cocos2d_CCSpriteFrame_createWithTexture00(lua_State* tolua_S)
 #endif
  {
   CCTexture2D* pobTexture = ((CCTexture2D*)  tolua_tousertype(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   bool rotated = ((bool)  tolua_toboolean(tolua_S,4,0));
-  CCPoint offset = *((CCPoint*)  tolua_tousertype(tolua_S,5,0));
-  CCSize originalSize = *((CCSize*)  tolua_tousertype(tolua_S,6,0));
+  CCPoint tolua_value5;
+  CCPoint offset = *((CCPoint*)  luaval_to_ccpoint(tolua_S,5,0,&tolua_value5));
+  CCSize tolua_value6;
+  CCSize originalSize = *((CCSize*)  luaval_to_ccsize(tolua_S,6,0,&tolua_value6));
   {
    CCSpriteFrame* tolua_ret = (CCSpriteFrame*)  CCSpriteFrame::createWithTexture(pobTexture,rect,rotated,offset,originalSize);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -23651,14 +23374,15 @@ static int tolua_Cocos2d_CCSpriteFrame_createWithTexture01(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCSpriteFrame",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCTexture2D",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
  else
  {
   CCTexture2D* pobTexture = ((CCTexture2D*)  tolua_tousertype(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   {
    CCSpriteFrame* tolua_ret = (CCSpriteFrame*)  CCSpriteFrame::createWithTexture(pobTexture,rect);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -25334,7 +25058,7 @@ static int tolua_Cocos2d_CCLayerColor_setContentSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCLayerColor",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"const CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -25342,7 +25066,8 @@ static int tolua_Cocos2d_CCLayerColor_setContentSize00(lua_State* tolua_S)
 #endif
  {
   CCLayerColor* self = (CCLayerColor*)  tolua_tousertype(tolua_S,1,0);
-  const CCSize* var = ((const CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  const CCSize* var = ((const CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setContentSize'", NULL);
 #endif
@@ -25990,7 +25715,7 @@ static int tolua_Cocos2d_CCLayerGradient_setVector00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCLayerGradient",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -25998,7 +25723,8 @@ static int tolua_Cocos2d_CCLayerGradient_setVector00(lua_State* tolua_S)
 #endif
  {
   CCLayerGradient* self = (CCLayerGradient*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint Value = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint Value = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setVector'", NULL);
 #endif
@@ -26036,15 +25762,7 @@ static int tolua_Cocos2d_CCLayerGradient_getVector00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getVector();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -26132,7 +25850,7 @@ static int tolua_Cocos2d_CCLayerGradient_create00(lua_State* tolua_S)
      !tolua_isusertable(tolua_S,1,"CCLayerGradient",0,&tolua_err) ||
      (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"ccColor4B",0,&tolua_err)) ||
      (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"ccColor4B",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccpoint(tolua_S,4,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,5,&tolua_err)
  )
   goto tolua_lerror;
@@ -26141,7 +25859,8 @@ static int tolua_Cocos2d_CCLayerGradient_create00(lua_State* tolua_S)
  {
   ccColor4B start = *((ccColor4B*)  tolua_tousertype(tolua_S,2,0));
   ccColor4B end = *((ccColor4B*)  tolua_tousertype(tolua_S,3,0));
-  CCPoint v = *((CCPoint*)  tolua_tousertype(tolua_S,4,0));
+  CCPoint tolua_value4;
+  CCPoint v = *((CCPoint*)  luaval_to_ccpoint(tolua_S,4,0,&tolua_value4));
   {
    CCLayerGradient* tolua_ret = (CCLayerGradient*)  CCLayerGradient::create(start,end,v);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -27538,7 +27257,7 @@ static int tolua_Cocos2d_CCTransitionPageTurn_actionWithSize00(lua_State* tolua_
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTransitionPageTurn",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -27546,7 +27265,8 @@ static int tolua_Cocos2d_CCTransitionPageTurn_actionWithSize00(lua_State* tolua_
 #endif
  {
   CCTransitionPageTurn* self = (CCTransitionPageTurn*)  tolua_tousertype(tolua_S,1,0);
-  CCSize vector = *((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize vector = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'actionWithSize'", NULL);
 #endif
@@ -28040,6 +27760,71 @@ static int tolua_Cocos2d_CCScheduler_unscheduleScriptEntry00(lua_State* tolua_S)
 }
 #endif //#ifndef TOLUA_DISABLE
 
+/* method: setScriptBatchingEnabled of class  CCScheduler */
+#ifndef TOLUA_DISABLE_tolua_Cocos2d_CCScheduler_setScriptBatchingEnabled00
+static int tolua_Cocos2d_CCScheduler_setScriptBatchingEnabled00(lua_State* tolua_S)
+{
+#ifndef TOLUA_RELEASE
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"CCScheduler",0,&tolua_err) ||
+     !tolua_isboolean(tolua_S,2,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  CCScheduler* self = (CCScheduler*)  tolua_tousertype(tolua_S,1,0);
+  bool bEnabled = ((bool)  tolua_toboolean(tolua_S,2,0));
+#ifndef TOLUA_RELEASE
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setScriptBatchingEnabled'", NULL);
+#endif
+  {
+   self->setScriptBatchingEnabled(bEnabled);
+  }
+ }
+ return 0;
+#ifndef TOLUA_RELEASE
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'setScriptBatchingEnabled'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* method: isScriptBatchingEnabled of class  CCScheduler */
+#ifndef TOLUA_DISABLE_tolua_Cocos2d_CCScheduler_isScriptBatchingEnabled00
+static int tolua_Cocos2d_CCScheduler_isScriptBatchingEnabled00(lua_State* tolua_S)
+{
+#ifndef TOLUA_RELEASE
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"CCScheduler",0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,2,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  CCScheduler* self = (CCScheduler*)  tolua_tousertype(tolua_S,1,0);
+#ifndef TOLUA_RELEASE
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'isScriptBatchingEnabled'", NULL);
+#endif
+  {
+   bool tolua_ret = (bool)  self->isScriptBatchingEnabled();
+   tolua_pushboolean(tolua_S,(bool)tolua_ret);
+  }
+ }
+ return 1;
+#ifndef TOLUA_RELEASE
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'isScriptBatchingEnabled'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
 /* method: isDone of class  CCAction */
 #ifndef TOLUA_DISABLE_tolua_Cocos2d_CCAction_isDone00
 static int tolua_Cocos2d_CCAction_isDone00(lua_State* tolua_S)
@@ -28772,7 +28557,7 @@ static int tolua_Cocos2d_CCFollow_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCFollow",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCNode",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -28780,7 +28565,8 @@ static int tolua_Cocos2d_CCFollow_create00(lua_State* tolua_S)
 #endif
  {
   CCNode* pFollowedNode = ((CCNode*)  tolua_tousertype(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   {
    CCFollow* tolua_ret = (CCFollow*)  CCFollow::create(pFollowedNode,rect);
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"CCFollow");
@@ -29360,7 +29146,7 @@ static int tolua_Cocos2d_CCMoveTo_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCMoveTo",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -29368,7 +29154,8 @@ static int tolua_Cocos2d_CCMoveTo_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCPoint position = *((CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value3;
+  CCPoint position = *((CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
   {
    CCMoveTo* tolua_ret = (CCMoveTo*)  CCMoveTo::create(duration,position);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -29428,7 +29215,7 @@ static int tolua_Cocos2d_CCMoveBy_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCMoveBy",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -29436,7 +29223,8 @@ static int tolua_Cocos2d_CCMoveBy_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCPoint deltaPosition = *((CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value3;
+  CCPoint deltaPosition = *((CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
   {
    CCMoveBy* tolua_ret = (CCMoveBy*)  CCMoveBy::create(duration,deltaPosition);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -29602,7 +29390,7 @@ static int tolua_Cocos2d_CCJumpBy_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCJumpBy",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
@@ -29612,7 +29400,8 @@ static int tolua_Cocos2d_CCJumpBy_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCPoint position = *((CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value3;
+  CCPoint position = *((CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
   float height = ((float)  tolua_tonumber(tolua_S,4,0));
   int jumps = ((int)  tolua_tonumber(tolua_S,5,0));
   {
@@ -29640,7 +29429,7 @@ static int tolua_Cocos2d_CCJumpTo_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCJumpTo",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
@@ -29650,7 +29439,8 @@ static int tolua_Cocos2d_CCJumpTo_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCPoint position = *((CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value3;
+  CCPoint position = *((CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
   float height = ((float)  tolua_tonumber(tolua_S,4,0));
   int jumps = ((int)  tolua_tonumber(tolua_S,5,0));
   {
@@ -29747,10 +29537,11 @@ static int tolua_set_ccBezierConfig_endPosition(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
   tolua_Error tolua_err;
   if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'endPosition'",NULL);
-  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)))
+  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)))
    tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
 #endif
-  self->endPosition = *((CCPoint*)  tolua_tousertype(tolua_S,2,0))
+  CCPoint tolua_value2;
+  self->endPosition = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2))
 ;
  return 0;
 }
@@ -29777,10 +29568,11 @@ static int tolua_set_ccBezierConfig_controlPoint_1(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
   tolua_Error tolua_err;
   if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'controlPoint_1'",NULL);
-  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)))
+  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)))
    tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
 #endif
-  self->controlPoint_1 = *((CCPoint*)  tolua_tousertype(tolua_S,2,0))
+  CCPoint tolua_value2;
+  self->controlPoint_1 = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2))
 ;
  return 0;
 }
@@ -29807,10 +29599,11 @@ static int tolua_set_ccBezierConfig_controlPoint_2(lua_State* tolua_S)
 #ifndef TOLUA_RELEASE
   tolua_Error tolua_err;
   if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'controlPoint_2'",NULL);
-  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)))
+  if ((tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)))
    tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
 #endif
-  self->controlPoint_2 = *((CCPoint*)  tolua_tousertype(tolua_S,2,0))
+  CCPoint tolua_value2;
+  self->controlPoint_2 = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2))
 ;
  return 0;
 }
@@ -31154,14 +30947,15 @@ static int tolua_Cocos2d_CCPlace_create00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertable(tolua_S,1,"CCPlace",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
  else
 #endif
  {
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   {
    CCPlace* tolua_ret = (CCPlace*)  CCPlace::create(pos);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -31435,7 +31229,7 @@ static int tolua_Cocos2d_CCPointArray_addControlPoint00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCPointArray",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -31443,7 +31237,8 @@ static int tolua_Cocos2d_CCPointArray_addControlPoint00(lua_State* tolua_S)
 #endif
  {
   CCPointArray* self = (CCPointArray*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint controlPoint = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint controlPoint = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'addControlPoint'", NULL);
 #endif
@@ -31468,7 +31263,7 @@ static int tolua_Cocos2d_CCPointArray_insertControlPoint00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCPointArray",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -31477,7 +31272,8 @@ static int tolua_Cocos2d_CCPointArray_insertControlPoint00(lua_State* tolua_S)
 #endif
  {
   CCPointArray* self = (CCPointArray*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint* controlPoint = ((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint* controlPoint = ((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   unsigned int index = ((unsigned int)  tolua_tonumber(tolua_S,3,0));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'insertControlPoint'", NULL);
@@ -31503,7 +31299,7 @@ static int tolua_Cocos2d_CCPointArray_replaceControlPoint00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCPointArray",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -31512,7 +31308,8 @@ static int tolua_Cocos2d_CCPointArray_replaceControlPoint00(lua_State* tolua_S)
 #endif
  {
   CCPointArray* self = (CCPointArray*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint* controlPoint = ((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint* controlPoint = ((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   unsigned int index = ((unsigned int)  tolua_tonumber(tolua_S,3,0));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'replaceControlPoint'", NULL);
@@ -31553,15 +31350,7 @@ static int tolua_Cocos2d_CCPointArray_getControlPointAtIndex00(lua_State* tolua_
   {
    CCPoint tolua_ret = (CCPoint)  self->getControlPointAtIndex(index);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -33660,7 +33449,7 @@ static int tolua_Cocos2d_CCGridAction_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCGridAction",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -33668,7 +33457,8 @@ static int tolua_Cocos2d_CCGridAction_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   {
    CCGridAction* tolua_ret = (CCGridAction*)  CCGridAction::create(duration,gridSize);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -33858,7 +33648,7 @@ static int tolua_Cocos2d_CCGrid3DAction_vertex00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCGrid3DAction",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -33866,7 +33656,8 @@ static int tolua_Cocos2d_CCGrid3DAction_vertex00(lua_State* tolua_S)
 #endif
  {
   CCGrid3DAction* self = (CCGrid3DAction*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* pos = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* pos = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'vertex'", NULL);
 #endif
@@ -33902,7 +33693,7 @@ static int tolua_Cocos2d_CCGrid3DAction_originalVertex00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCGrid3DAction",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -33910,7 +33701,8 @@ static int tolua_Cocos2d_CCGrid3DAction_originalVertex00(lua_State* tolua_S)
 #endif
  {
   CCGrid3DAction* self = (CCGrid3DAction*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* pos = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* pos = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'originalVertex'", NULL);
 #endif
@@ -33946,7 +33738,7 @@ static int tolua_Cocos2d_CCGrid3DAction_setVertex00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCGrid3DAction",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"const ccVertex3F",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -33955,7 +33747,8 @@ static int tolua_Cocos2d_CCGrid3DAction_setVertex00(lua_State* tolua_S)
 #endif
  {
   CCGrid3DAction* self = (CCGrid3DAction*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* pos = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* pos = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   const ccVertex3F* vertex = ((const ccVertex3F*)  tolua_tousertype(tolua_S,3,0));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setVertex'", NULL);
@@ -33981,7 +33774,7 @@ static int tolua_Cocos2d_CCTiledGrid3DAction_tile00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTiledGrid3DAction",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -33989,7 +33782,8 @@ static int tolua_Cocos2d_CCTiledGrid3DAction_tile00(lua_State* tolua_S)
 #endif
  {
   CCTiledGrid3DAction* self = (CCTiledGrid3DAction*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'tile'", NULL);
 #endif
@@ -34025,7 +33819,7 @@ static int tolua_Cocos2d_CCTiledGrid3DAction_originalTile00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTiledGrid3DAction",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -34033,7 +33827,8 @@ static int tolua_Cocos2d_CCTiledGrid3DAction_originalTile00(lua_State* tolua_S)
 #endif
  {
   CCTiledGrid3DAction* self = (CCTiledGrid3DAction*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'originalTile'", NULL);
 #endif
@@ -34069,7 +33864,7 @@ static int tolua_Cocos2d_CCTiledGrid3DAction_setTile00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTiledGrid3DAction",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"ccQuad3",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -34078,7 +33873,8 @@ static int tolua_Cocos2d_CCTiledGrid3DAction_setTile00(lua_State* tolua_S)
 #endif
  {
   CCTiledGrid3DAction* self = (CCTiledGrid3DAction*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   ccQuad3 coords = *((ccQuad3*)  tolua_tousertype(tolua_S,3,0));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setTile'", NULL);
@@ -34595,7 +34391,7 @@ static int tolua_Cocos2d_CCWaves3D_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCWaves3D",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
@@ -34605,7 +34401,8 @@ static int tolua_Cocos2d_CCWaves3D_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   unsigned int waves = ((unsigned int)  tolua_tonumber(tolua_S,4,0));
   float amplitude = ((float)  tolua_tonumber(tolua_S,5,0));
   {
@@ -34768,15 +34565,7 @@ static int tolua_Cocos2d_CCLens3D_getPosition00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getPosition();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -34797,7 +34586,7 @@ static int tolua_Cocos2d_CCLens3D_setPosition00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCLens3D",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -34805,7 +34594,8 @@ static int tolua_Cocos2d_CCLens3D_setPosition00(lua_State* tolua_S)
 #endif
  {
   CCLens3D* self = (CCLens3D*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint position = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint position = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setPosition'", NULL);
 #endif
@@ -34831,8 +34621,8 @@ static int tolua_Cocos2d_CCLens3D_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCLens3D",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccpoint(tolua_S,4,"CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
  )
@@ -34841,8 +34631,10 @@ static int tolua_Cocos2d_CCLens3D_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
-  CCPoint position = *((CCPoint*)  tolua_tousertype(tolua_S,4,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
+  CCPoint tolua_value4;
+  CCPoint position = *((CCPoint*)  luaval_to_ccpoint(tolua_S,4,0,&tolua_value4));
   float radius = ((float)  tolua_tonumber(tolua_S,5,0));
   {
    CCLens3D* tolua_ret = (CCLens3D*)  CCLens3D::create(duration,gridSize,position,radius);
@@ -34879,15 +34671,7 @@ static int tolua_Cocos2d_CCRipple3D_getPosition00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getPosition();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -34908,7 +34692,7 @@ static int tolua_Cocos2d_CCRipple3D_setPosition00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCRipple3D",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -34916,7 +34700,8 @@ static int tolua_Cocos2d_CCRipple3D_setPosition00(lua_State* tolua_S)
 #endif
  {
   CCRipple3D* self = (CCRipple3D*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint position = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint position = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setPosition'", NULL);
 #endif
@@ -35072,8 +34857,8 @@ static int tolua_Cocos2d_CCRipple3D_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCRipple3D",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccpoint(tolua_S,4,"CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,6,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,7,0,&tolua_err) ||
@@ -35084,8 +34869,10 @@ static int tolua_Cocos2d_CCRipple3D_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
-  CCPoint position = *((CCPoint*)  tolua_tousertype(tolua_S,4,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
+  CCPoint tolua_value4;
+  CCPoint position = *((CCPoint*)  luaval_to_ccpoint(tolua_S,4,0,&tolua_value4));
   float radius = ((float)  tolua_tonumber(tolua_S,5,0));
   unsigned int waves = ((unsigned int)  tolua_tonumber(tolua_S,6,0));
   float amplitude = ((float)  tolua_tonumber(tolua_S,7,0));
@@ -35112,7 +34899,7 @@ static int tolua_Cocos2d_CCShaky3D_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCShaky3D",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isboolean(tolua_S,5,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
@@ -35122,7 +34909,8 @@ static int tolua_Cocos2d_CCShaky3D_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   int range = ((int)  tolua_tonumber(tolua_S,4,0));
   bool shakeZ = ((bool)  tolua_toboolean(tolua_S,5,0));
   {
@@ -35278,7 +35066,7 @@ static int tolua_Cocos2d_CCLiquid_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCLiquid",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
@@ -35288,7 +35076,8 @@ static int tolua_Cocos2d_CCLiquid_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   unsigned int waves = ((unsigned int)  tolua_tonumber(tolua_S,4,0));
   float amplitude = ((float)  tolua_tonumber(tolua_S,5,0));
   {
@@ -35444,7 +35233,7 @@ static int tolua_Cocos2d_CCWaves_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCWaves",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isboolean(tolua_S,6,0,&tolua_err) ||
@@ -35456,7 +35245,8 @@ static int tolua_Cocos2d_CCWaves_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   unsigned int waves = ((unsigned int)  tolua_tonumber(tolua_S,4,0));
   float amplitude = ((float)  tolua_tonumber(tolua_S,5,0));
   bool horizontal = ((bool)  tolua_toboolean(tolua_S,6,0));
@@ -35496,15 +35286,7 @@ static int tolua_Cocos2d_CCTwirl_getPosition00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getPosition();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -35525,7 +35307,7 @@ static int tolua_Cocos2d_CCTwirl_setPosition00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTwirl",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -35533,7 +35315,8 @@ static int tolua_Cocos2d_CCTwirl_setPosition00(lua_State* tolua_S)
 #endif
  {
   CCTwirl* self = (CCTwirl*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint position = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint position = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setPosition'", NULL);
 #endif
@@ -35689,8 +35472,8 @@ static int tolua_Cocos2d_CCTwirl_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCTwirl",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccpoint(tolua_S,4,"CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,6,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,7,&tolua_err)
@@ -35700,8 +35483,10 @@ static int tolua_Cocos2d_CCTwirl_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
-  CCPoint position = *((CCPoint*)  tolua_tousertype(tolua_S,4,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
+  CCPoint tolua_value4;
+  CCPoint position = *((CCPoint*)  luaval_to_ccpoint(tolua_S,4,0,&tolua_value4));
   unsigned int twirls = ((unsigned int)  tolua_tonumber(tolua_S,5,0));
   float amplitude = ((float)  tolua_tonumber(tolua_S,6,0));
   {
@@ -35727,7 +35512,7 @@ static int tolua_Cocos2d_CCPageTurn3D_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCPageTurn3D",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -35735,7 +35520,8 @@ static int tolua_Cocos2d_CCPageTurn3D_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   {
    CCPageTurn3D* tolua_ret = (CCPageTurn3D*)  CCPageTurn3D::create(duration,gridSize);
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"CCPageTurn3D");
@@ -35829,7 +35615,7 @@ static int tolua_Cocos2d_CCShakyTiles3D_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCShakyTiles3D",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isboolean(tolua_S,5,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
@@ -35839,7 +35625,8 @@ static int tolua_Cocos2d_CCShakyTiles3D_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   int nRange = ((int)  tolua_tonumber(tolua_S,4,0));
   bool bShakeZ = ((bool)  tolua_toboolean(tolua_S,5,0));
   {
@@ -35865,7 +35652,7 @@ static int tolua_Cocos2d_CCShatteredTiles3D_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCShatteredTiles3D",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isboolean(tolua_S,5,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
@@ -35875,7 +35662,8 @@ static int tolua_Cocos2d_CCShatteredTiles3D_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   int nRange = ((int)  tolua_tonumber(tolua_S,4,0));
   bool bShatterZ = ((bool)  tolua_toboolean(tolua_S,5,0));
   {
@@ -35936,7 +35724,7 @@ static int tolua_Cocos2d_CCShuffleTiles_getDelta00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCShuffleTiles",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -35944,22 +35732,15 @@ static int tolua_Cocos2d_CCShuffleTiles_getDelta00(lua_State* tolua_S)
 #endif
  {
   CCShuffleTiles* self = (CCShuffleTiles*)  tolua_tousertype(tolua_S,1,0);
-  CCSize pos = *((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize pos = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'getDelta'", NULL);
 #endif
   {
    CCSize tolua_ret = (CCSize)  self->getDelta(pos);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -35980,7 +35761,7 @@ static int tolua_Cocos2d_CCShuffleTiles_placeTile00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCShuffleTiles",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isusertype(tolua_S,3,"Tile",0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -35989,7 +35770,8 @@ static int tolua_Cocos2d_CCShuffleTiles_placeTile00(lua_State* tolua_S)
 #endif
  {
   CCShuffleTiles* self = (CCShuffleTiles*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   Tile* t = ((Tile*)  tolua_tousertype(tolua_S,3,0));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'placeTile'", NULL);
@@ -36016,7 +35798,7 @@ static int tolua_Cocos2d_CCShuffleTiles_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCShuffleTiles",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,5,&tolua_err)
  )
@@ -36025,7 +35807,8 @@ static int tolua_Cocos2d_CCShuffleTiles_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   unsigned int seed = ((unsigned int)  tolua_tonumber(tolua_S,4,0));
   {
    CCShuffleTiles* tolua_ret = (CCShuffleTiles*)  CCShuffleTiles::create(duration,gridSize,seed);
@@ -36049,7 +35832,7 @@ static int tolua_Cocos2d_CCFadeOutTRTiles_turnOnTile00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCFadeOutTRTiles",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -36057,7 +35840,8 @@ static int tolua_Cocos2d_CCFadeOutTRTiles_turnOnTile00(lua_State* tolua_S)
 #endif
  {
   CCFadeOutTRTiles* self = (CCFadeOutTRTiles*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'turnOnTile'", NULL);
 #endif
@@ -36082,7 +35866,7 @@ static int tolua_Cocos2d_CCFadeOutTRTiles_turnOffTile00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCFadeOutTRTiles",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -36090,7 +35874,8 @@ static int tolua_Cocos2d_CCFadeOutTRTiles_turnOffTile00(lua_State* tolua_S)
 #endif
  {
   CCFadeOutTRTiles* self = (CCFadeOutTRTiles*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'turnOffTile'", NULL);
 #endif
@@ -36115,7 +35900,7 @@ static int tolua_Cocos2d_CCFadeOutTRTiles_transformTile00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCFadeOutTRTiles",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -36124,7 +35909,8 @@ static int tolua_Cocos2d_CCFadeOutTRTiles_transformTile00(lua_State* tolua_S)
 #endif
  {
   CCFadeOutTRTiles* self = (CCFadeOutTRTiles*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   float distance = ((float)  tolua_tonumber(tolua_S,3,0));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'transformTile'", NULL);
@@ -36151,7 +35937,7 @@ static int tolua_Cocos2d_CCFadeOutTRTiles_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCFadeOutTRTiles",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -36159,7 +35945,8 @@ static int tolua_Cocos2d_CCFadeOutTRTiles_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   {
    CCFadeOutTRTiles* tolua_ret = (CCFadeOutTRTiles*)  CCFadeOutTRTiles::create(duration,gridSize);
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"CCFadeOutTRTiles");
@@ -36183,7 +35970,7 @@ static int tolua_Cocos2d_CCFadeOutBLTiles_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCFadeOutBLTiles",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -36191,7 +35978,8 @@ static int tolua_Cocos2d_CCFadeOutBLTiles_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   {
    CCFadeOutBLTiles* tolua_ret = (CCFadeOutBLTiles*)  CCFadeOutBLTiles::create(duration,gridSize);
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"CCFadeOutBLTiles");
@@ -36214,7 +36002,7 @@ static int tolua_Cocos2d_CCFadeOutUpTiles_transformTile00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCFadeOutUpTiles",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -36223,7 +36011,8 @@ static int tolua_Cocos2d_CCFadeOutUpTiles_transformTile00(lua_State* tolua_S)
 #endif
  {
   CCFadeOutUpTiles* self = (CCFadeOutUpTiles*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
   float distance = ((float)  tolua_tonumber(tolua_S,3,0));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'transformTile'", NULL);
@@ -36250,7 +36039,7 @@ static int tolua_Cocos2d_CCFadeOutUpTiles_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCFadeOutUpTiles",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -36258,7 +36047,8 @@ static int tolua_Cocos2d_CCFadeOutUpTiles_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   {
    CCFadeOutUpTiles* tolua_ret = (CCFadeOutUpTiles*)  CCFadeOutUpTiles::create(duration,gridSize);
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"CCFadeOutUpTiles");
@@ -36282,7 +36072,7 @@ static int tolua_Cocos2d_CCFadeOutDownTiles_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCFadeOutDownTiles",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -36290,7 +36080,8 @@ static int tolua_Cocos2d_CCFadeOutDownTiles_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   {
    CCFadeOutDownTiles* tolua_ret = (CCFadeOutDownTiles*)  CCFadeOutDownTiles::create(duration,gridSize);
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"CCFadeOutDownTiles");
@@ -36349,7 +36140,7 @@ static int tolua_Cocos2d_CCTurnOffTiles_turnOnTile00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTurnOffTiles",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -36357,7 +36148,8 @@ static int tolua_Cocos2d_CCTurnOffTiles_turnOnTile00(lua_State* tolua_S)
 #endif
  {
   CCTurnOffTiles* self = (CCTurnOffTiles*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'turnOnTile'", NULL);
 #endif
@@ -36382,7 +36174,7 @@ static int tolua_Cocos2d_CCTurnOffTiles_turnOffTile00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTurnOffTiles",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -36390,7 +36182,8 @@ static int tolua_Cocos2d_CCTurnOffTiles_turnOffTile00(lua_State* tolua_S)
 #endif
  {
   CCTurnOffTiles* self = (CCTurnOffTiles*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'turnOffTile'", NULL);
 #endif
@@ -36416,7 +36209,7 @@ static int tolua_Cocos2d_CCTurnOffTiles_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCTurnOffTiles",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -36424,7 +36217,8 @@ static int tolua_Cocos2d_CCTurnOffTiles_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   {
    CCTurnOffTiles* tolua_ret = (CCTurnOffTiles*)  CCTurnOffTiles::create(duration,gridSize);
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"CCTurnOffTiles");
@@ -36447,7 +36241,7 @@ static int tolua_Cocos2d_CCTurnOffTiles_create01(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCTurnOffTiles",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,5,&tolua_err)
  )
@@ -36455,7 +36249,8 @@ static int tolua_Cocos2d_CCTurnOffTiles_create01(lua_State* tolua_S)
  else
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   unsigned int seed = ((unsigned int)  tolua_tonumber(tolua_S,4,0));
   {
    CCTurnOffTiles* tolua_ret = (CCTurnOffTiles*)  CCTurnOffTiles::create(duration,gridSize,seed);
@@ -36607,7 +36402,7 @@ static int tolua_Cocos2d_CCWavesTiles3D_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCWavesTiles3D",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
@@ -36617,7 +36412,8 @@ static int tolua_Cocos2d_CCWavesTiles3D_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   unsigned int waves = ((unsigned int)  tolua_tonumber(tolua_S,4,0));
   float amplitude = ((float)  tolua_tonumber(tolua_S,5,0));
   {
@@ -36773,7 +36569,7 @@ static int tolua_Cocos2d_CCJumpTiles3D_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCJumpTiles3D",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
@@ -36783,7 +36579,8 @@ static int tolua_Cocos2d_CCJumpTiles3D_create00(lua_State* tolua_S)
 #endif
  {
   float duration = ((float)  tolua_tonumber(tolua_S,2,0));
-  CCSize gridSize = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize gridSize = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   unsigned int numberOfJumps = ((unsigned int)  tolua_tonumber(tolua_S,4,0));
   float amplitude = ((float)  tolua_tonumber(tolua_S,5,0));
   {
@@ -37385,7 +37182,7 @@ static int tolua_Cocos2d_CCMotionStreak_setPosition00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCMotionStreak",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -37393,7 +37190,8 @@ static int tolua_Cocos2d_CCMotionStreak_setPosition00(lua_State* tolua_S)
 #endif
  {
   CCMotionStreak* self = (CCMotionStreak*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint* position = ((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint* position = ((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setPosition'", NULL);
 #endif
@@ -38397,7 +38195,7 @@ static int tolua_Cocos2d_CCAnimation_addSpriteFrameWithTexture00(lua_State* tolu
  if (
      !tolua_isusertype(tolua_S,1,"CCAnimation",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCTexture2D",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"const CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"const CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -38406,7 +38204,8 @@ static int tolua_Cocos2d_CCAnimation_addSpriteFrameWithTexture00(lua_State* tolu
  {
   CCAnimation* self = (CCAnimation*)  tolua_tousertype(tolua_S,1,0);
   CCTexture2D* pobTexture = ((CCTexture2D*)  tolua_tousertype(tolua_S,2,0));
-  const CCRect* rect = ((const CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  const CCRect* rect = ((const CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'addSpriteFrameWithTexture'", NULL);
 #endif
@@ -40483,7 +40282,7 @@ static int tolua_Cocos2d_CCLabelBMFont_setAnchorPoint00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCLabelBMFont",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -40491,7 +40290,8 @@ static int tolua_Cocos2d_CCLabelBMFont_setAnchorPoint00(lua_State* tolua_S)
 #endif
  {
   CCLabelBMFont* self = (CCLabelBMFont*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* var = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* var = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setAnchorPoint'", NULL);
 #endif
@@ -41042,7 +40842,7 @@ static int tolua_Cocos2d_CCLabelBMFont_create01(lua_State* tolua_S)
      !tolua_isstring(tolua_S,3,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,6,&tolua_err) || !tolua_isusertype(tolua_S,6,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,6,&tolua_err) || !luaval_is_ccpoint(tolua_S,6,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,7,&tolua_err)
  )
   goto tolua_lerror;
@@ -41052,7 +40852,8 @@ static int tolua_Cocos2d_CCLabelBMFont_create01(lua_State* tolua_S)
   const char* fntFile = ((const char*)  tolua_tostring(tolua_S,3,0));
   float width = ((float)  tolua_tonumber(tolua_S,4,0));
   CCTextAlignment alignment = ((CCTextAlignment) (int)  tolua_tonumber(tolua_S,5,0));
-  CCPoint imageOffset = *((CCPoint*)  tolua_tousertype(tolua_S,6,0));
+  CCPoint tolua_value6;
+  CCPoint imageOffset = *((CCPoint*)  luaval_to_ccpoint(tolua_S,6,0,&tolua_value6));
   {
    CCLabelBMFont* tolua_ret = (CCLabelBMFont*)  CCLabelBMFont::create(str,fntFile,width,alignment,imageOffset);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -41429,15 +41230,7 @@ static int tolua_Cocos2d_CCLabelTTF_getDimensions00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getDimensions();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -41458,7 +41251,7 @@ static int tolua_Cocos2d_CCLabelTTF_setDimensions00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCLabelTTF",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -41466,7 +41259,8 @@ static int tolua_Cocos2d_CCLabelTTF_setDimensions00(lua_State* tolua_S)
 #endif
  {
   CCLabelTTF* self = (CCLabelTTF*)  tolua_tousertype(tolua_S,1,0);
-  CCSize* dim = ((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize* dim = ((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setDimensions'", NULL);
 #endif
@@ -41624,7 +41418,7 @@ static int tolua_Cocos2d_CCLabelTTF_create00(lua_State* tolua_S)
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
      !tolua_isstring(tolua_S,3,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !tolua_isusertype(tolua_S,5,"const CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !luaval_is_ccsize(tolua_S,5,"const CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,6,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,7,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,8,&tolua_err)
@@ -41636,7 +41430,8 @@ static int tolua_Cocos2d_CCLabelTTF_create00(lua_State* tolua_S)
   const char* str = ((const char*)  tolua_tostring(tolua_S,2,0));
   const char* fontName = ((const char*)  tolua_tostring(tolua_S,3,0));
   float fontSize = ((float)  tolua_tonumber(tolua_S,4,0));
-  const CCSize* dimensions = ((const CCSize*)  tolua_tousertype(tolua_S,5,0));
+  CCSize tolua_value5;
+  const CCSize* dimensions = ((const CCSize*)  luaval_to_ccsize(tolua_S,5,0,&tolua_value5));
   CCTextAlignment hAlignment = ((CCTextAlignment) (int)  tolua_tonumber(tolua_S,6,0));
   CCVerticalTextAlignment vAlignment = ((CCVerticalTextAlignment) (int)  tolua_tonumber(tolua_S,7,0));
   {
@@ -41665,7 +41460,7 @@ static int tolua_Cocos2d_CCLabelTTF_create01(lua_State* tolua_S)
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
      !tolua_isstring(tolua_S,3,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !tolua_isusertype(tolua_S,5,"const CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !luaval_is_ccsize(tolua_S,5,"const CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,6,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,7,&tolua_err)
  )
@@ -41675,7 +41470,8 @@ static int tolua_Cocos2d_CCLabelTTF_create01(lua_State* tolua_S)
   const char* str = ((const char*)  tolua_tostring(tolua_S,2,0));
   const char* fontName = ((const char*)  tolua_tostring(tolua_S,3,0));
   float fontSize = ((float)  tolua_tonumber(tolua_S,4,0));
-  const CCSize* dimensions = ((const CCSize*)  tolua_tousertype(tolua_S,5,0));
+  CCSize tolua_value5;
+  const CCSize* dimensions = ((const CCSize*)  luaval_to_ccsize(tolua_S,5,0,&tolua_value5));
   CCTextAlignment hAlignment = ((CCTextAlignment) (int)  tolua_tonumber(tolua_S,6,0));
   {
    CCLabelTTF* tolua_ret = (CCLabelTTF*)  CCLabelTTF::create(str,fontName,fontSize,*dimensions,hAlignment);
@@ -42395,15 +42191,7 @@ static int tolua_Cocos2d_CCMenuItem_rect00(lua_State* tolua_S)
   {
    CCRect tolua_ret = (CCRect)  self->rect();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCRect)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCRect));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccrect_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -44981,8 +44769,8 @@ static int tolua_Cocos2d_CCParallaxNode_addChild00(lua_State* tolua_S)
      !tolua_isusertype(tolua_S,1,"CCParallaxNode",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCNode",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !tolua_isusertype(tolua_S,5,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccpoint(tolua_S,4,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !luaval_is_ccpoint(tolua_S,5,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
  )
   goto tolua_lerror;
@@ -44992,8 +44780,10 @@ static int tolua_Cocos2d_CCParallaxNode_addChild00(lua_State* tolua_S)
   CCParallaxNode* self = (CCParallaxNode*)  tolua_tousertype(tolua_S,1,0);
   CCNode* child = ((CCNode*)  tolua_tousertype(tolua_S,2,0));
   unsigned int z = ((unsigned int)  tolua_tonumber(tolua_S,3,0));
-  CCPoint parallaxRatio = *((CCPoint*)  tolua_tousertype(tolua_S,4,0));
-  CCPoint positionOffset = *((CCPoint*)  tolua_tousertype(tolua_S,5,0));
+  CCPoint tolua_value4;
+  CCPoint parallaxRatio = *((CCPoint*)  luaval_to_ccpoint(tolua_S,4,0,&tolua_value4));
+  CCPoint tolua_value5;
+  CCPoint positionOffset = *((CCPoint*)  luaval_to_ccpoint(tolua_S,5,0,&tolua_value5));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'addChild'", NULL);
 #endif
@@ -45191,7 +44981,7 @@ static int tolua_Cocos2d_CCParticleSystem_getGravity00(lua_State* tolua_S)
 #endif
   {
    const CCPoint& tolua_ret = (const CCPoint&)  self->getGravity();
-    tolua_pushusertype(tolua_S,(void*)&tolua_ret,"const CCPoint");
+    ccpoint_to_luaval(tolua_S,tolua_ret);
   }
  }
  return 1;
@@ -45211,7 +45001,7 @@ static int tolua_Cocos2d_CCParticleSystem_setGravity00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCParticleSystem",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -45219,7 +45009,8 @@ static int tolua_Cocos2d_CCParticleSystem_setGravity00(lua_State* tolua_S)
 #endif
  {
   CCParticleSystem* self = (CCParticleSystem*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* g = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* g = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setGravity'", NULL);
 #endif
@@ -46184,7 +45975,7 @@ static int tolua_Cocos2d_CCParticleSystem_updateQuadWithParticle00(lua_State* to
  if (
      !tolua_isusertype(tolua_S,1,"CCParticleSystem",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"tCCParticle",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -46193,7 +45984,8 @@ static int tolua_Cocos2d_CCParticleSystem_updateQuadWithParticle00(lua_State* to
  {
   CCParticleSystem* self = (CCParticleSystem*)  tolua_tousertype(tolua_S,1,0);
   tCCParticle* particle = ((tCCParticle*)  tolua_tousertype(tolua_S,2,0));
-  const CCPoint* newPosition = ((const CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value3;
+  const CCPoint* newPosition = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'updateQuadWithParticle'", NULL);
 #endif
@@ -46359,15 +46151,7 @@ static int tolua_Cocos2d_CCParticleSystem_getSourcePosition00(lua_State* tolua_S
   {
    CCPoint tolua_ret = (CCPoint)  self->getSourcePosition();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -46388,7 +46172,7 @@ static int tolua_Cocos2d_CCParticleSystem_setSourcePosition00(lua_State* tolua_S
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCParticleSystem",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -46396,7 +46180,8 @@ static int tolua_Cocos2d_CCParticleSystem_setSourcePosition00(lua_State* tolua_S
 #endif
  {
   CCParticleSystem* self = (CCParticleSystem*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setSourcePosition'", NULL);
 #endif
@@ -46434,15 +46219,7 @@ static int tolua_Cocos2d_CCParticleSystem_getPosVar00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getPosVar();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -46463,7 +46240,7 @@ static int tolua_Cocos2d_CCParticleSystem_setPosVar00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCParticleSystem",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -46471,7 +46248,8 @@ static int tolua_Cocos2d_CCParticleSystem_setPosVar00(lua_State* tolua_S)
 #endif
  {
   CCParticleSystem* self = (CCParticleSystem*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pos = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pos = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setPosVar'", NULL);
 #endif
@@ -48525,7 +48303,7 @@ static int tolua_Cocos2d_CCParticleSystemQuad_setTextureWithRect00(lua_State* to
  if (
      !tolua_isusertype(tolua_S,1,"CCParticleSystemQuad",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCTexture2D",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"const CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"const CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -48534,7 +48312,8 @@ static int tolua_Cocos2d_CCParticleSystemQuad_setTextureWithRect00(lua_State* to
  {
   CCParticleSystemQuad* self = (CCParticleSystemQuad*)  tolua_tousertype(tolua_S,1,0);
   CCTexture2D* texture = ((CCTexture2D*)  tolua_tousertype(tolua_S,2,0));
-  const CCRect* rect = ((const CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  const CCRect* rect = ((const CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setTextureWithRect'", NULL);
 #endif
@@ -48626,7 +48405,7 @@ static int tolua_Cocos2d_CCParticleSystemQuad_updateQuadWithParticle00(lua_State
  if (
      !tolua_isusertype(tolua_S,1,"CCParticleSystemQuad",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"tCCParticle",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -48635,7 +48414,8 @@ static int tolua_Cocos2d_CCParticleSystemQuad_updateQuadWithParticle00(lua_State
  {
   CCParticleSystemQuad* self = (CCParticleSystemQuad*)  tolua_tousertype(tolua_S,1,0);
   tCCParticle* particle = ((tCCParticle*)  tolua_tousertype(tolua_S,2,0));
-  const CCPoint* newPosition = ((const CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value3;
+  const CCPoint* newPosition = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'updateQuadWithParticle'", NULL);
 #endif
@@ -49859,7 +49639,7 @@ static int tolua_Cocos2d_CCProgressTimer_setAnchorPoint00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCProgressTimer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -49867,7 +49647,8 @@ static int tolua_Cocos2d_CCProgressTimer_setAnchorPoint00(lua_State* tolua_S)
 #endif
  {
   CCProgressTimer* self = (CCProgressTimer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint anchorPoint = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint anchorPoint = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setAnchorPoint'", NULL);
 #endif
@@ -50132,15 +49913,7 @@ static int tolua_Cocos2d_CCProgressTimer_getMidpoint00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getMidpoint();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -50161,7 +49934,7 @@ static int tolua_Cocos2d_CCProgressTimer_setMidpoint00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCProgressTimer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -50169,7 +49942,8 @@ static int tolua_Cocos2d_CCProgressTimer_setMidpoint00(lua_State* tolua_S)
 #endif
  {
   CCProgressTimer* self = (CCProgressTimer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pt = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pt = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setMidpoint'", NULL);
 #endif
@@ -50207,15 +49981,7 @@ static int tolua_Cocos2d_CCProgressTimer_getBarChangeRate00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getBarChangeRate();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -50236,7 +50002,7 @@ static int tolua_Cocos2d_CCProgressTimer_setBarChangeRate00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCProgressTimer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -50244,7 +50010,8 @@ static int tolua_Cocos2d_CCProgressTimer_setBarChangeRate00(lua_State* tolua_S)
 #endif
  {
   CCProgressTimer* self = (CCProgressTimer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint rate = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint rate = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setBarChangeRate'", NULL);
 #endif
@@ -50636,7 +50403,7 @@ static int tolua_Cocos2d_CCTextFieldTTF_textFieldWithPlaceHolder00(lua_State* to
  if (
      !tolua_isusertable(tolua_S,1,"CCTextFieldTTF",0,&tolua_err) ||
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccsize(tolua_S,3,"CCSize",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isstring(tolua_S,5,0,&tolua_err) ||
      !tolua_isnumber(tolua_S,6,0,&tolua_err) ||
@@ -50647,7 +50414,8 @@ static int tolua_Cocos2d_CCTextFieldTTF_textFieldWithPlaceHolder00(lua_State* to
 #endif
  {
   const char* placeholder = ((const char*)  tolua_tostring(tolua_S,2,0));
-  CCSize dimensions = *((CCSize*)  tolua_tousertype(tolua_S,3,0));
+  CCSize tolua_value3;
+  CCSize dimensions = *((CCSize*)  luaval_to_ccsize(tolua_S,3,0,&tolua_value3));
   CCTextAlignment alignment = ((CCTextAlignment) (int)  tolua_tonumber(tolua_S,4,0));
   const char* fontName = ((const char*)  tolua_tostring(tolua_S,5,0));
   float fontSize = ((float)  tolua_tonumber(tolua_S,6,0));
@@ -50707,7 +50475,7 @@ static int tolua_Cocos2d_CCTileMapAtlas_setTile00(lua_State* tolua_S)
  if (
      !tolua_isusertype(tolua_S,1,"CCTileMapAtlas",0,&tolua_err) ||
      (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"ccColor3B",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -50716,7 +50484,8 @@ static int tolua_Cocos2d_CCTileMapAtlas_setTile00(lua_State* tolua_S)
  {
   CCTileMapAtlas* self = (CCTileMapAtlas*)  tolua_tousertype(tolua_S,1,0);
   ccColor3B tile = *((ccColor3B*)  tolua_tousertype(tolua_S,2,0));
-  CCPoint position = *((CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value3;
+  CCPoint position = *((CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setTile'", NULL);
 #endif
@@ -50772,7 +50541,7 @@ static int tolua_Cocos2d_CCTileMapAtlas_tileAt00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTileMapAtlas",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -50780,7 +50549,8 @@ static int tolua_Cocos2d_CCTileMapAtlas_tileAt00(lua_State* tolua_S)
 #endif
  {
   CCTileMapAtlas* self = (CCTileMapAtlas*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* pos = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* pos = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'tileAt'", NULL);
 #endif
@@ -50854,7 +50624,7 @@ static int tolua_Cocos2d_CCTMXLayer_setLayerSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXLayer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -50862,7 +50632,8 @@ static int tolua_Cocos2d_CCTMXLayer_setLayerSize00(lua_State* tolua_S)
 #endif
  {
   CCTMXLayer* self = (CCTMXLayer*)  tolua_tousertype(tolua_S,1,0);
-  CCSize val = *((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize val = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setLayerSize'", NULL);
 #endif
@@ -50900,15 +50671,7 @@ static int tolua_Cocos2d_CCTMXLayer_getLayerSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getLayerSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -50929,7 +50692,7 @@ static int tolua_Cocos2d_CCTMXLayer_setMapTileSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXLayer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -50937,7 +50700,8 @@ static int tolua_Cocos2d_CCTMXLayer_setMapTileSize00(lua_State* tolua_S)
 #endif
  {
   CCTMXLayer* self = (CCTMXLayer*)  tolua_tousertype(tolua_S,1,0);
-  CCSize val = *((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize val = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setMapTileSize'", NULL);
 #endif
@@ -50975,15 +50739,7 @@ static int tolua_Cocos2d_CCTMXLayer_getMapTileSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getMapTileSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -51300,7 +51056,7 @@ static int tolua_Cocos2d_CCTMXLayer_tileAt00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXLayer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -51308,7 +51064,8 @@ static int tolua_Cocos2d_CCTMXLayer_tileAt00(lua_State* tolua_S)
 #endif
  {
   CCTMXLayer* self = (CCTMXLayer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint tileCoordinate = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint tileCoordinate = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'tileAt'", NULL);
 #endif
@@ -51336,7 +51093,7 @@ static int tolua_Cocos2d_CCTMXLayer_tileGIDAt00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXLayer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -51344,7 +51101,8 @@ static int tolua_Cocos2d_CCTMXLayer_tileGIDAt00(lua_State* tolua_S)
 #endif
  {
   CCTMXLayer* self = (CCTMXLayer*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* tileCoordinate = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* tileCoordinate = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'tileGIDAt'", NULL);
 #endif
@@ -51371,7 +51129,7 @@ static int tolua_Cocos2d_CCTMXLayer_setTileGID00(lua_State* tolua_S)
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXLayer",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -51380,7 +51138,8 @@ static int tolua_Cocos2d_CCTMXLayer_setTileGID00(lua_State* tolua_S)
  {
   CCTMXLayer* self = (CCTMXLayer*)  tolua_tousertype(tolua_S,1,0);
   unsigned int gid = ((unsigned int)  tolua_tonumber(tolua_S,2,0));
-  const CCPoint* tileCoordinate = ((const CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value3;
+  const CCPoint* tileCoordinate = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setTileGID'", NULL);
 #endif
@@ -51405,7 +51164,7 @@ static int tolua_Cocos2d_CCTMXLayer_setTileGID01(lua_State* tolua_S)
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXLayer",0,&tolua_err) ||
      !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,5,&tolua_err)
  )
@@ -51414,7 +51173,8 @@ static int tolua_Cocos2d_CCTMXLayer_setTileGID01(lua_State* tolua_S)
  {
   CCTMXLayer* self = (CCTMXLayer*)  tolua_tousertype(tolua_S,1,0);
   unsigned int gid = ((unsigned int)  tolua_tonumber(tolua_S,2,0));
-  const CCPoint* tileCoordinate = ((const CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value3;
+  const CCPoint* tileCoordinate = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
   ccTMXTileFlags flags = ((ccTMXTileFlags) (int)  tolua_tonumber(tolua_S,4,0));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setTileGID'", NULL);
@@ -51437,7 +51197,7 @@ static int tolua_Cocos2d_CCTMXLayer_removeTileAt00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXLayer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -51445,7 +51205,8 @@ static int tolua_Cocos2d_CCTMXLayer_removeTileAt00(lua_State* tolua_S)
 #endif
  {
   CCTMXLayer* self = (CCTMXLayer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint tileCoordinate = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint tileCoordinate = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'removeTileAt'", NULL);
 #endif
@@ -51470,7 +51231,7 @@ static int tolua_Cocos2d_CCTMXLayer_positionAt00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXLayer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -51478,22 +51239,15 @@ static int tolua_Cocos2d_CCTMXLayer_positionAt00(lua_State* tolua_S)
 #endif
  {
   CCTMXLayer* self = (CCTMXLayer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint tileCoordinate = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint tileCoordinate = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'positionAt'", NULL);
 #endif
   {
    CCPoint tolua_ret = (CCPoint)  self->positionAt(tileCoordinate);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -51682,7 +51436,7 @@ static int tolua_Cocos2d_CCTMXObjectGroup_setPositionOffset00(lua_State* tolua_S
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXObjectGroup",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -51690,7 +51444,8 @@ static int tolua_Cocos2d_CCTMXObjectGroup_setPositionOffset00(lua_State* tolua_S
 #endif
  {
   CCTMXObjectGroup* self = (CCTMXObjectGroup*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint pt = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint pt = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setPositionOffset'", NULL);
 #endif
@@ -51728,15 +51483,7 @@ static int tolua_Cocos2d_CCTMXObjectGroup_getPositionOffset00(lua_State* tolua_S
   {
    CCPoint tolua_ret = (CCPoint)  self->getPositionOffset();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -52028,7 +51775,7 @@ static int tolua_Cocos2d_CCTMXTiledMap_setMapSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXTiledMap",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -52036,7 +51783,8 @@ static int tolua_Cocos2d_CCTMXTiledMap_setMapSize00(lua_State* tolua_S)
 #endif
  {
   CCTMXTiledMap* self = (CCTMXTiledMap*)  tolua_tousertype(tolua_S,1,0);
-  CCSize sz = *((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize sz = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setMapSize'", NULL);
 #endif
@@ -52074,15 +51822,7 @@ static int tolua_Cocos2d_CCTMXTiledMap_getMapSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getMapSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -52103,7 +51843,7 @@ static int tolua_Cocos2d_CCTMXTiledMap_setTileSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXTiledMap",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -52111,7 +51851,8 @@ static int tolua_Cocos2d_CCTMXTiledMap_setTileSize00(lua_State* tolua_S)
 #endif
  {
   CCTMXTiledMap* self = (CCTMXTiledMap*)  tolua_tousertype(tolua_S,1,0);
-  CCSize sz = *((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize sz = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setTileSize'", NULL);
 #endif
@@ -52149,15 +51890,7 @@ static int tolua_Cocos2d_CCTMXTiledMap_getTileSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getTileSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -52669,15 +52402,7 @@ static int tolua_Cocos2d_CCTMXTilesetInfo_rectForGID00(lua_State* tolua_S)
   {
    CCRect tolua_ret = (CCRect)  self->rectForGID(gid);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCRect)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCRect));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccrect_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -52763,7 +52488,7 @@ static int tolua_Cocos2d_CCTMXMapInfo_setMapSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXMapInfo",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -52771,7 +52496,8 @@ static int tolua_Cocos2d_CCTMXMapInfo_setMapSize00(lua_State* tolua_S)
 #endif
  {
   CCTMXMapInfo* self = (CCTMXMapInfo*)  tolua_tousertype(tolua_S,1,0);
-  CCSize sz = *((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize sz = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setMapSize'", NULL);
 #endif
@@ -52809,15 +52535,7 @@ static int tolua_Cocos2d_CCTMXMapInfo_getMapSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getMapSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -52838,7 +52556,7 @@ static int tolua_Cocos2d_CCTMXMapInfo_setTileSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCTMXMapInfo",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -52846,7 +52564,8 @@ static int tolua_Cocos2d_CCTMXMapInfo_setTileSize00(lua_State* tolua_S)
 #endif
  {
   CCTMXMapInfo* self = (CCTMXMapInfo*)  tolua_tousertype(tolua_S,1,0);
-  CCSize sz = *((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize sz = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setTileSize'", NULL);
 #endif
@@ -52884,15 +52603,7 @@ static int tolua_Cocos2d_CCTMXMapInfo_getTileSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getTileSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -53895,15 +53606,7 @@ static int tolua_Cocos2d_CCTouch_getLocation00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getLocation();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -53937,15 +53640,7 @@ static int tolua_Cocos2d_CCTouch_getPreviousLocation00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getPreviousLocation();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -53979,15 +53674,7 @@ static int tolua_Cocos2d_CCTouch_getDelta00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getDelta();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -54021,15 +53708,7 @@ static int tolua_Cocos2d_CCTouch_getLocationInView00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getLocationInView();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -54063,15 +53742,7 @@ static int tolua_Cocos2d_CCTouch_getPreviousLocationInView00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getPreviousLocationInView();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -55205,15 +54876,7 @@ static int tolua_Cocos2d_CCScale9Sprite_getOriginalSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getOriginalSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -55247,15 +54910,7 @@ static int tolua_Cocos2d_CCScale9Sprite_getPreferredSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getPreferredSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -55276,7 +54931,7 @@ static int tolua_Cocos2d_CCScale9Sprite_setPreferredSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -55284,7 +54939,8 @@ static int tolua_Cocos2d_CCScale9Sprite_setPreferredSize00(lua_State* tolua_S)
 #endif
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
-  CCSize sz = *((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize sz = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setPreferredSize'", NULL);
 #endif
@@ -55322,15 +54978,7 @@ static int tolua_Cocos2d_CCScale9Sprite_getCapInsets00(lua_State* tolua_S)
   {
    CCRect tolua_ret = (CCRect)  self->getCapInsets();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCRect)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCRect));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCRect");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccrect_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -55351,7 +54999,7 @@ static int tolua_Cocos2d_CCScale9Sprite_setCapInsets00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -55359,7 +55007,8 @@ static int tolua_Cocos2d_CCScale9Sprite_setCapInsets00(lua_State* tolua_S)
 #endif
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
-  CCRect rt = *((CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  CCRect rt = *((CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setCapInsets'", NULL);
 #endif
@@ -55644,7 +55293,7 @@ static int tolua_Cocos2d_CCScale9Sprite_setContentSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"const CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -55652,7 +55301,8 @@ static int tolua_Cocos2d_CCScale9Sprite_setContentSize00(lua_State* tolua_S)
 #endif
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
-  const CCSize* size = ((const CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  const CCSize* size = ((const CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setContentSize'", NULL);
 #endif
@@ -55741,9 +55391,9 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithBatchNode00(lua_State* tolua_S)
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCSpriteBatchNode",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isboolean(tolua_S,4,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !tolua_isusertype(tolua_S,5,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !luaval_is_ccrect(tolua_S,5,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
  )
   goto tolua_lerror;
@@ -55752,9 +55402,11 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithBatchNode00(lua_State* tolua_S)
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
   CCSpriteBatchNode* batchnode = ((CCSpriteBatchNode*)  tolua_tousertype(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   bool rotated = ((bool)  tolua_toboolean(tolua_S,4,0));
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,5,0));
+  CCRect tolua_value5;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,5,0,&tolua_value5));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'initWithBatchNode'", NULL);
 #endif
@@ -55780,8 +55432,8 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithBatchNode01(lua_State* tolua_S)
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCSpriteBatchNode",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccrect(tolua_S,4,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,5,&tolua_err)
  )
   goto tolua_lerror;
@@ -55789,8 +55441,10 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithBatchNode01(lua_State* tolua_S)
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
   CCSpriteBatchNode* batchnode = ((CCSpriteBatchNode*)  tolua_tousertype(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,4,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
+  CCRect tolua_value4;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,4,0,&tolua_value4));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'initWithBatchNode'", NULL);
 #endif
@@ -55814,8 +55468,8 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithFile00(lua_State* tolua_S)
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccrect(tolua_S,4,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,5,&tolua_err)
  )
   goto tolua_lerror;
@@ -55824,8 +55478,10 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithFile00(lua_State* tolua_S)
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
   const char* file = ((const char*)  tolua_tostring(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,4,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
+  CCRect tolua_value4;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,4,0,&tolua_value4));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'initWithFile'", NULL);
 #endif
@@ -55852,8 +55508,8 @@ static int tolua_Cocos2d_CCScale9Sprite_create00(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccrect(tolua_S,4,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,5,&tolua_err)
  )
   goto tolua_lerror;
@@ -55861,8 +55517,10 @@ static int tolua_Cocos2d_CCScale9Sprite_create00(lua_State* tolua_S)
 #endif
  {
   const char* file = ((const char*)  tolua_tostring(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,4,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
+  CCRect tolua_value4;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,4,0,&tolua_value4));
   {
    CCScale9Sprite* tolua_ret = (CCScale9Sprite*)  CCScale9Sprite::create(file,rect,capInsets);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -55887,7 +55545,7 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithFile01(lua_State* tolua_S)
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -55895,7 +55553,8 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithFile01(lua_State* tolua_S)
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
   const char* file = ((const char*)  tolua_tostring(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'initWithFile'", NULL);
 #endif
@@ -55918,14 +55577,15 @@ static int tolua_Cocos2d_CCScale9Sprite_create01(lua_State* tolua_S)
  if (
      !tolua_isusertable(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
  else
  {
   const char* file = ((const char*)  tolua_tostring(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   {
    CCScale9Sprite* tolua_ret = (CCScale9Sprite*)  CCScale9Sprite::create(file,rect);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -55946,7 +55606,7 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithFile02(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"CCRect",0,&tolua_err)) ||
      !tolua_isstring(tolua_S,3,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -55954,7 +55614,8 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithFile02(lua_State* tolua_S)
  else
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
   const char* file = ((const char*)  tolua_tostring(tolua_S,3,0));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'initWithFile'", NULL);
@@ -55977,14 +55638,15 @@ static int tolua_Cocos2d_CCScale9Sprite_create02(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertable(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"CCRect",0,&tolua_err)) ||
      !tolua_isstring(tolua_S,3,0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
  else
  {
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
   const char* file = ((const char*)  tolua_tostring(tolua_S,3,0));
   {
    CCScale9Sprite* tolua_ret = (CCScale9Sprite*)  CCScale9Sprite::create(capInsets,file);
@@ -56064,7 +55726,7 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithSpriteFrame00(lua_State* tolua_S
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCSpriteFrame",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -56073,7 +55735,8 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithSpriteFrame00(lua_State* tolua_S
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
   CCSpriteFrame* spriteFrame = ((CCSpriteFrame*)  tolua_tousertype(tolua_S,2,0));
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'initWithSpriteFrame'", NULL);
 #endif
@@ -56100,7 +55763,7 @@ static int tolua_Cocos2d_CCScale9Sprite_createWithSpriteFrame00(lua_State* tolua
  if (
      !tolua_isusertable(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCSpriteFrame",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -56108,7 +55771,8 @@ static int tolua_Cocos2d_CCScale9Sprite_createWithSpriteFrame00(lua_State* tolua
 #endif
  {
   CCSpriteFrame* spriteFrame = ((CCSpriteFrame*)  tolua_tousertype(tolua_S,2,0));
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   {
    CCScale9Sprite* tolua_ret = (CCScale9Sprite*)  CCScale9Sprite::createWithSpriteFrame(spriteFrame,capInsets);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -56190,7 +55854,7 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithSpriteFrameName00(lua_State* tol
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -56199,7 +55863,8 @@ static int tolua_Cocos2d_CCScale9Sprite_initWithSpriteFrameName00(lua_State* tol
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
   const char* spriteFrameName = ((const char*)  tolua_tostring(tolua_S,2,0));
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'initWithSpriteFrameName'", NULL);
 #endif
@@ -56226,7 +55891,7 @@ static int tolua_Cocos2d_CCScale9Sprite_createWithSpriteFrameName00(lua_State* t
  if (
      !tolua_isusertable(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isstring(tolua_S,2,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -56234,7 +55899,8 @@ static int tolua_Cocos2d_CCScale9Sprite_createWithSpriteFrameName00(lua_State* t
 #endif
  {
   const char* spriteFrameName = ((const char*)  tolua_tostring(tolua_S,2,0));
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   {
    CCScale9Sprite* tolua_ret = (CCScale9Sprite*)  CCScale9Sprite::createWithSpriteFrameName(spriteFrameName,capInsets);
     int nID = (tolua_ret) ? (int)tolua_ret->_ID : -1;
@@ -56315,7 +55981,7 @@ static int tolua_Cocos2d_CCScale9Sprite_resizableSpriteWithCapInsets00(lua_State
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccrect(tolua_S,2,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -56323,7 +55989,8 @@ static int tolua_Cocos2d_CCScale9Sprite_resizableSpriteWithCapInsets00(lua_State
 #endif
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,2,0));
+  CCRect tolua_value2;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'resizableSpriteWithCapInsets'", NULL);
 #endif
@@ -56508,9 +56175,9 @@ static int tolua_Cocos2d_CCScale9Sprite_updateWithBatchNode00(lua_State* tolua_S
  if (
      !tolua_isusertype(tolua_S,1,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,2,"CCSpriteBatchNode",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccrect(tolua_S,3,"CCRect",0,&tolua_err)) ||
      !tolua_isboolean(tolua_S,4,0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !tolua_isusertype(tolua_S,5,"CCRect",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !luaval_is_ccrect(tolua_S,5,"CCRect",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
  )
   goto tolua_lerror;
@@ -56519,9 +56186,11 @@ static int tolua_Cocos2d_CCScale9Sprite_updateWithBatchNode00(lua_State* tolua_S
  {
   CCScale9Sprite* self = (CCScale9Sprite*)  tolua_tousertype(tolua_S,1,0);
   CCSpriteBatchNode* batchnode = ((CCSpriteBatchNode*)  tolua_tousertype(tolua_S,2,0));
-  CCRect rect = *((CCRect*)  tolua_tousertype(tolua_S,3,0));
+  CCRect tolua_value3;
+  CCRect rect = *((CCRect*)  luaval_to_ccrect(tolua_S,3,0,&tolua_value3));
   bool rotated = ((bool)  tolua_toboolean(tolua_S,4,0));
-  CCRect capInsets = *((CCRect*)  tolua_tousertype(tolua_S,5,0));
+  CCRect tolua_value5;
+  CCRect capInsets = *((CCRect*)  luaval_to_ccrect(tolua_S,5,0,&tolua_value5));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'updateWithBatchNode'", NULL);
 #endif
@@ -57272,15 +56941,7 @@ static int tolua_Cocos2d_CCControl_getTouchLocation00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->getTouchLocation(touch);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -57901,15 +57562,7 @@ static int tolua_Cocos2d_CCControlButton_getPreferredSize00(lua_State* tolua_S)
   {
    CCSize tolua_ret = (CCSize)  self->getPreferredSize();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCSize)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCSize));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCSize");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccsize_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -57930,7 +57583,7 @@ static int tolua_Cocos2d_CCControlButton_setPreferredSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCControlButton",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -57938,7 +57591,8 @@ static int tolua_Cocos2d_CCControlButton_setPreferredSize00(lua_State* tolua_S)
 #endif
  {
   CCControlButton* self = (CCControlButton*)  tolua_tousertype(tolua_S,1,0);
-  CCSize var = *((CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  CCSize var = *((CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setPreferredSize'", NULL);
 #endif
@@ -58041,15 +57695,7 @@ static int tolua_Cocos2d_CCControlButton_getLabelAnchorPoint00(lua_State* tolua_
   {
    CCPoint tolua_ret = (CCPoint)  self->getLabelAnchorPoint();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -58070,7 +57716,7 @@ static int tolua_Cocos2d_CCControlButton_setLabelAnchorPoint00(lua_State* tolua_
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCControlButton",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -58078,7 +57724,8 @@ static int tolua_Cocos2d_CCControlButton_setLabelAnchorPoint00(lua_State* tolua_
 #endif
  {
   CCControlButton* self = (CCControlButton*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint var = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint var = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setLabelAnchorPoint'", NULL);
 #endif
@@ -59804,15 +59451,7 @@ static int tolua_Cocos2d_CCControlSlider_locationFromTouch00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->locationFromTouch(touch);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -61294,15 +60933,7 @@ static int tolua_Cocos2d_CCControlSwitch_locationFromTouch00(lua_State* tolua_S)
   {
    CCPoint tolua_ret = (CCPoint)  self->locationFromTouch(touch);
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -62143,15 +61774,7 @@ static int tolua_Cocos2d_CCControlPotentiometer_getPreviousLocation00(lua_State*
   {
    CCPoint tolua_ret = (CCPoint)  self->getPreviousLocation();
    {
-#ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((CCPoint)(tolua_ret));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#else
-    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(CCPoint));
-     tolua_pushusertype(tolua_S,tolua_obj,"CCPoint");
-    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
-#endif
+    ccpoint_to_luaval(tolua_S,tolua_ret);
    }
   }
  }
@@ -62172,7 +61795,7 @@ static int tolua_Cocos2d_CCControlPotentiometer_setPreviousLocation00(lua_State*
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCControlPotentiometer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -62180,7 +61803,8 @@ static int tolua_Cocos2d_CCControlPotentiometer_setPreviousLocation00(lua_State*
 #endif
  {
   CCControlPotentiometer* self = (CCControlPotentiometer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint var = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint var = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setPreviousLocation'", NULL);
 #endif
@@ -62205,7 +61829,7 @@ static int tolua_Cocos2d_CCControlPotentiometer_potentiometerBegan00(lua_State*
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCControlPotentiometer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -62213,7 +61837,8 @@ static int tolua_Cocos2d_CCControlPotentiometer_potentiometerBegan00(lua_State*
 #endif
  {
   CCControlPotentiometer* self = (CCControlPotentiometer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint location = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint location = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'potentiometerBegan'", NULL);
 #endif
@@ -62238,7 +61863,7 @@ static int tolua_Cocos2d_CCControlPotentiometer_potentiometerMoved00(lua_State*
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCControlPotentiometer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -62246,7 +61871,8 @@ static int tolua_Cocos2d_CCControlPotentiometer_potentiometerMoved00(lua_State*
 #endif
  {
   CCControlPotentiometer* self = (CCControlPotentiometer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint location = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint location = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'potentiometerMoved'", NULL);
 #endif
@@ -62271,7 +61897,7 @@ static int tolua_Cocos2d_CCControlPotentiometer_potentiometerEnded00(lua_State*
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCControlPotentiometer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -62279,7 +61905,8 @@ static int tolua_Cocos2d_CCControlPotentiometer_potentiometerEnded00(lua_State*
 #endif
  {
   CCControlPotentiometer* self = (CCControlPotentiometer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint location = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint location = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'potentiometerEnded'", NULL);
 #endif
@@ -62304,8 +61931,8 @@ static int tolua_Cocos2d_CCControlPotentiometer_distanceBetweenPointAndPoint00(l
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCControlPotentiometer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
   goto tolua_lerror;
@@ -62313,8 +61940,10 @@ static int tolua_Cocos2d_CCControlPotentiometer_distanceBetweenPointAndPoint00(l
 #endif
  {
   CCControlPotentiometer* self = (CCControlPotentiometer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint point1 = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
-  CCPoint point2 = *((CCPoint*)  tolua_tousertype(tolua_S,3,0));
+  CCPoint tolua_value2;
+  CCPoint point1 = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
+  CCPoint tolua_value3;
+  CCPoint point2 = *((CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'distanceBetweenPointAndPoint'", NULL);
 #endif
@@ -62340,10 +61969,10 @@ static int tolua_Cocos2d_CCControlPotentiometer_angleInDegreesBetweenLineFromPoi
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCControlPotentiometer",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !tolua_isusertype(tolua_S,3,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !tolua_isusertype(tolua_S,4,"CCPoint",0,&tolua_err)) ||
-     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !tolua_isusertype(tolua_S,5,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,3,&tolua_err) || !luaval_is_ccpoint(tolua_S,3,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,4,&tolua_err) || !luaval_is_ccpoint(tolua_S,4,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,5,&tolua_err) || !luaval_is_ccpoint(tolua_S,5,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,6,&tolua_err)
  )
   goto tolua_lerror;
@@ -62351,10 +61980,14 @@ static int tolua_Cocos2d_CCControlPotentiometer_angleInDegreesBetweenLineFromPoi
 #endif
  {
   CCControlPotentiometer* self = (CCControlPotentiometer*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint beginLineA = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
-  CCPoint endLineA = *((CCPoint*)  tolua_tousertype(tolua_S,3,0));
-  CCPoint beginLineB = *((CCPoint*)  tolua_tousertype(tolua_S,4,0));
-  CCPoint endLineB = *((CCPoint*)  tolua_tousertype(tolua_S,5,0));
+  CCPoint tolua_value2;
+  CCPoint beginLineA = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
+  CCPoint tolua_value3;
+  CCPoint endLineA = *((CCPoint*)  luaval_to_ccpoint(tolua_S,3,0,&tolua_value3));
+  CCPoint tolua_value4;
+  CCPoint beginLineB = *((CCPoint*)  luaval_to_ccpoint(tolua_S,4,0,&tolua_value4));
+  CCPoint tolua_value5;
+  CCPoint endLineB = *((CCPoint*)  luaval_to_ccpoint(tolua_S,5,0,&tolua_value5));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'angleInDegreesBetweenLineFromPoint_toPoint_toLineFromPoint_toPoint'", NULL);
 #endif
@@ -63211,7 +62844,7 @@ static int tolua_Cocos2d_CCControlStepper_updateLayoutUsingTouchLocation00(lua_S
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCControlStepper",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -63219,7 +62852,8 @@ static int tolua_Cocos2d_CCControlStepper_updateLayoutUsingTouchLocation00(lua_S
 #endif
  {
   CCControlStepper* self = (CCControlStepper*)  tolua_tousertype(tolua_S,1,0);
-  CCPoint location = *((CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  CCPoint location = *((CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'updateLayoutUsingTouchLocation'", NULL);
 #endif
@@ -63396,7 +63030,7 @@ static int tolua_Cocos2d_CCEditBox_create00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertable(tolua_S,1,"CCEditBox",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"const CCSize",0,&tolua_err)) ||
      !tolua_isusertype(tolua_S,3,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isusertype(tolua_S,4,"CCScale9Sprite",1,&tolua_err) ||
      !tolua_isusertype(tolua_S,5,"CCScale9Sprite",1,&tolua_err) ||
@@ -63406,7 +63040,8 @@ static int tolua_Cocos2d_CCEditBox_create00(lua_State* tolua_S)
  else
 #endif
  {
-  const CCSize* size = ((const CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  const CCSize* size = ((const CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
   CCScale9Sprite* pNormal9SpriteBg = ((CCScale9Sprite*)  tolua_tousertype(tolua_S,3,0));
   CCScale9Sprite* pPressed9SpriteBg = ((CCScale9Sprite*)  tolua_tousertype(tolua_S,4,NULL));
   CCScale9Sprite* pDisabled9SpriteBg = ((CCScale9Sprite*)  tolua_tousertype(tolua_S,5,NULL));
@@ -63434,7 +63069,7 @@ static int tolua_Cocos2d_CCEditBox_initWithSizeAndBackgroundSprite00(lua_State*
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCEditBox",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"const CCSize",0,&tolua_err)) ||
      !tolua_isusertype(tolua_S,3,"CCScale9Sprite",0,&tolua_err) ||
      !tolua_isnoobj(tolua_S,4,&tolua_err)
  )
@@ -63443,7 +63078,8 @@ static int tolua_Cocos2d_CCEditBox_initWithSizeAndBackgroundSprite00(lua_State*
 #endif
  {
   CCEditBox* self = (CCEditBox*)  tolua_tousertype(tolua_S,1,0);
-  const CCSize* size = ((const CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  const CCSize* size = ((const CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
   CCScale9Sprite* pNormal9SpriteBg = ((CCScale9Sprite*)  tolua_tousertype(tolua_S,3,0));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'initWithSizeAndBackgroundSprite'", NULL);
@@ -64128,7 +63764,7 @@ static int tolua_Cocos2d_CCEditBox_setPosition00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCEditBox",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -64136,7 +63772,8 @@ static int tolua_Cocos2d_CCEditBox_setPosition00(lua_State* tolua_S)
 #endif
  {
   CCEditBox* self = (CCEditBox*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* pos = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* pos = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setPosition'", NULL);
 #endif
@@ -64194,7 +63831,7 @@ static int tolua_Cocos2d_CCEditBox_setContentSize00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCEditBox",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCSize",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"const CCSize",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -64202,7 +63839,8 @@ static int tolua_Cocos2d_CCEditBox_setContentSize00(lua_State* tolua_S)
 #endif
  {
   CCEditBox* self = (CCEditBox*)  tolua_tousertype(tolua_S,1,0);
-  const CCSize* size = ((const CCSize*)  tolua_tousertype(tolua_S,2,0));
+  CCSize tolua_value2;
+  const CCSize* size = ((const CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setContentSize'", NULL);
 #endif
@@ -64227,7 +63865,7 @@ static int tolua_Cocos2d_CCEditBox_setAnchorPoint00(lua_State* tolua_S)
  tolua_Error tolua_err;
  if (
      !tolua_isusertype(tolua_S,1,"CCEditBox",0,&tolua_err) ||
-     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccpoint(tolua_S,2,"const CCPoint",0,&tolua_err)) ||
      !tolua_isnoobj(tolua_S,3,&tolua_err)
  )
   goto tolua_lerror;
@@ -64235,7 +63873,8 @@ static int tolua_Cocos2d_CCEditBox_setAnchorPoint00(lua_State* tolua_S)
 #endif
  {
   CCEditBox* self = (CCEditBox*)  tolua_tousertype(tolua_S,1,0);
-  const CCPoint* anchorPoint = ((const CCPoint*)  tolua_tousertype(tolua_S,2,0));
+  CCPoint tolua_value2;
+  const CCPoint* anchorPoint = ((const CCPoint*)  luaval_to_ccpoint(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setAnchorPoint'", NULL);
 #endif
@@ -65032,6 +64671,7 @@ TOLUA_API int tolua_Cocos2d_open (lua_State* tolua_S)
   tolua_function(tolua_S,"ccDrawColor4B",tolua_Cocos2d_ccDrawColor4B00);
   tolua_function(tolua_S,"ccDrawColor4F",tolua_Cocos2d_ccDrawColor4F00);
   tolua_function(tolua_S,"ccPointSize",tolua_Cocos2d_ccPointSize00);
+  tolua_function(tolua_S,"ccGLLineWidth",tolua_Cocos2d_ccGLLineWidth00);
   #ifdef __cplusplus
   tolua_cclass(tolua_S,"CCAffineTransform","CCAffineTransform","",tolua_collect_CCAffineTransform);
   #else
@@ -66152,6 +65792,8 @@ TOLUA_API int tolua_Cocos2d_open (lua_State* tolua_S)
    tolua_function(tolua_S,"setTimeScale",tolua_Cocos2d_CCScheduler_setTimeScale00);
    tolua_function(tolua_S,"scheduleScriptFunc",tolua_Cocos2d_CCScheduler_scheduleScriptFunc00);
    tolua_function(tolua_S,"unscheduleScriptEntry",tolua_Cocos2d_CCScheduler_unscheduleScriptEntry00);
+   tolua_function(tolua_S,"setScriptBatchingEnabled",tolua_Cocos2d_CCScheduler_setScriptBatchingEnabled00);
+   tolua_function(tolua_S,"isScriptBatchingEnabled",tolua_Cocos2d_CCScheduler_isScriptBatchingEnabled00);
   tolua_endmodule(tolua_S);
   tolua_constant(tolua_S,"kCCActionTagInvalid",kCCActionTagInvalid);
   tolua_cclass(tolua_S,"CCAction","CCAction","CCObject",NULL);
@@ -12,6 +12,7 @@ extern "C" {
 #include "cocos2d.h"
 #include "cocos-ext.h"
 #include "CCBProxy.h"
+#include "LuaBasicConversions.h"
 
 using namespace cocos2d;
 using namespace cocos2d::extension;
@@ -1068,7 +1069,7 @@ static int tolua_Cocos2d_CCBAnimationManager_getRootContainerSize00(lua_State* t
 #endif
         {
             const CCSize& tolua_ret = (const CCSize&)  self->getRootContainerSize();
-            tolua_pushusertype(tolua_S,(void*)&tolua_ret,"const CCSize");
+            ccsize_to_luaval(tolua_S,tolua_ret);
         }
     }
     return 1;
@@ -1136,7 +1137,7 @@ static int tolua_Cocos2d_CCBAnimationManager_getContainerSize00(lua_State* tolua
 #endif
         {
             const CCSize& tolua_ret = (const CCSize&)  self->getContainerSize(pNode);
-            tolua_pushusertype(tolua_S,(void*)&tolua_ret,"const CCSize");
+            ccsize_to_luaval(tolua_S,tolua_ret);
         }
     }
     return 1;
@@ -1291,7 +1292,7 @@ static int tolua_Cocos2d_CCBAnimationManager_setRootContainerSize00(lua_State* t
     tolua_Error tolua_err;
     if (
         !tolua_isusertype(tolua_S,1,"CCBAnimationManager",0,&tolua_err) ||
-        (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const CCSize",0,&tolua_err)) ||
+        (tolua_isvaluenil(tolua_S,2,&tolua_err) || !luaval_is_ccsize(tolua_S,2,"const CCSize",0,&tolua_err)) ||
         !tolua_isnoobj(tolua_S,3,&tolua_err)
         )
         goto tolua_lerror;
@@ -1299,7 +1300,8 @@ static int tolua_Cocos2d_CCBAnimationManager_setRootContainerSize00(lua_State* t
 #endif
     {
         CCBAnimationManager* self = (CCBAnimationManager*)  tolua_tousertype(tolua_S,1,0);
-        const CCSize* rootContainerSize = ((const CCSize*)  tolua_tousertype(tolua_S,2,0));
+        CCSize tolua_value2;
+        const CCSize* rootContainerSize = ((const CCSize*)  luaval_to_ccsize(tolua_S,2,0,&tolua_value2));
 #ifndef TOLUA_RELEASE
         if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setRootContainerSize'", NULL);
 #endif
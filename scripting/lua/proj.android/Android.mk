@@ -9,6 +9,8 @@ LOCAL_SRC_FILES := ../cocos2dx_support/CCLuaBridge.cpp \
           ../cocos2dx_support/CCLuaEngine.cpp \
           ../cocos2dx_support/CCLuaStack.cpp \
           ../cocos2dx_support/CCLuaValue.cpp \
+          ../cocos2dx_support/CCLuaArchive.cpp \
+          ../cocos2dx_support/LuaBasicConversions.cpp \
           ../cocos2dx_support/Cocos2dxLuaLoader.cpp \
           ../cocos2dx_support/LuaCocos2d.cpp \
           ../cocos2dx_support/CCBProxy.cpp \
@@ -0,0 +1,257 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+// ccz_packer: packs files into CCZ files loaded by ZipUtils::ccInflateCCZFile, or unpacks them.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <zlib.h>
+#include "../../cocos2dx/support/zip_support/ccLZ4.h"
+
+using namespace cocos2d;
+
+// must match ZipUtils.h
+enum
+{
+    CCZ_COMPRESSION_ZLIB = 0,
+    CCZ_COMPRESSION_LZ4 = 4,
+};
+
+static const unsigned int HEADER_SIZE = 16;
+
+static void usage()
+{
+    fprintf(stderr,
+            "usage: ccz_packer [-c zlib|lz4] [-l LEVEL] INPUT OUTPUT.ccz\n"
+            "       ccz_packer -d INPUT.ccz OUTPUT\n"
+            "\n"
+            "  -c  compression of the packed file, zlib by default\n"
+            "  -l  zlib level, from 1 to 9 (default)\n"
+            "  -d  unpacks a zlib or LZ4 CCZ file, not encrypted\n");
+}
+
+static bool readFile(const char *path, std::vector<unsigned char> *data)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "ccz_packer: can't open %s\n", path);
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data->resize(size);
+    bool ok = size == 0 || fread(&(*data)[0], 1, size, file) == (size_t)size;
+    fclose(file);
+    if (!ok)
+    {
+        fprintf(stderr, "ccz_packer: can't read %s\n", path);
+    }
+    return ok;
+}
+
+static bool writeFile(const char *path, const unsigned char *data, size_t size)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        fprintf(stderr, "ccz_packer: can't create %s\n", path);
+        return false;
+    }
+    bool ok = fwrite(data, 1, size, file) == size;
+    ok = fclose(file) == 0 && ok;
+    if (!ok)
+    {
+        fprintf(stderr, "ccz_packer: can't write %s\n", path);
+    }
+    return ok;
+}
+
+static void writeBigEndian(unsigned char *out, unsigned int value, int bytes)
+{
+    for (int i = bytes - 1; i >= 0; --i)
+    {
+        out[i] = value & 0xff;
+        value >>= 8;
+    }
+}
+
+static unsigned int readBigEndian(const unsigned char *in, int bytes)
+{
+    unsigned int value = 0;
+    for (int i = 0; i < bytes; ++i)
+    {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+static int pack(const char *input, const char *output, int compression, int level)
+{
+    std::vector<unsigned char> data;
+    if (!readFile(input, &data))
+    {
+        return 1;
+    }
+
+    unsigned int length = (unsigned int)data.size();
+    std::vector<unsigned char> packed;
+    unsigned long packedLength = 0;
+    if (compression == CCZ_COMPRESSION_LZ4)
+    {
+        packed.resize(HEADER_SIZE + ccLZ4CompressBound(length));
+        packedLength = ccLZ4Compress(data.empty() ? NULL : &data[0], length, &packed[HEADER_SIZE], packed.size() - HEADER_SIZE);
+    }
+    else
+    {
+        uLongf bound = compressBound(length);
+        packed.resize(HEADER_SIZE + bound);
+        if (compress2(&packed[HEADER_SIZE], &bound, data.empty() ? NULL : &data[0], length, level) == Z_OK)
+        {
+            packedLength = bound;
+        }
+    }
+    if (packedLength == 0 && length != 0)
+    {
+        fprintf(stderr, "ccz_packer: can't compress %s\n", input);
+        return 1;
+    }
+
+    // 'CCZ!', compression, version 2, reserved, uncompressed length
+    memcpy(&packed[0], "CCZ!", 4);
+    writeBigEndian(&packed[4], compression, 2);
+    writeBigEndian(&packed[6], 2, 2);
+    writeBigEndian(&packed[8], 0, 4);
+    writeBigEndian(&packed[12], length, 4);
+
+    if (!writeFile(output, &packed[0], HEADER_SIZE + packedLength))
+    {
+        return 1;
+    }
+    printf("%s: %u -> %lu bytes (%.1f%%)\n", output, length, HEADER_SIZE + packedLength,
+           length ? 100.0 * (HEADER_SIZE + packedLength) / length : 100.0);
+    return 0;
+}
+
+static int unpack(const char *input, const char *output)
+{
+    std::vector<unsigned char> packed;
+    if (!readFile(input, &packed))
+    {
+        return 1;
+    }
+    if (packed.size() < HEADER_SIZE || memcmp(&packed[0], "CCZ!", 4) != 0)
+    {
+        fprintf(stderr, "ccz_packer: %s is not an unencrypted CCZ file\n", input);
+        return 1;
+    }
+
+    unsigned int compression = readBigEndian(&packed[4], 2);
+    unsigned int length = readBigEndian(&packed[12], 4);
+    unsigned long packedLength = packed.size() - HEADER_SIZE;
+    std::vector<unsigned char> data(length + 1);
+    bool ok = false;
+    if (compression == CCZ_COMPRESSION_LZ4)
+    {
+        ok = ccLZ4Decompress(&packed[HEADER_SIZE], packedLength, &data[0], length) == (int)length;
+    }
+    else if (compression == CCZ_COMPRESSION_ZLIB)
+    {
+        uLongf dataLength = length;
+        ok = uncompress(&data[0], &dataLength, &packed[HEADER_SIZE], packedLength) == Z_OK && dataLength == length;
+    }
+    else
+    {
+        fprintf(stderr, "ccz_packer: unsupported compression %u in %s\n", compression, input);
+        return 1;
+    }
+    if (!ok)
+    {
+        fprintf(stderr, "ccz_packer: %s is corrupted\n", input);
+        return 1;
+    }
+    return writeFile(output, &data[0], length) ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    int compression = CCZ_COMPRESSION_ZLIB;
+    int level = 9;
+    bool unpacking = false;
+    std::vector<const char*> files;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+        {
+            const char *name = argv[++i];
+            if (strcmp(name, "lz4") == 0)
+            {
+                compression = CCZ_COMPRESSION_LZ4;
+            }
+            else if (strcmp(name, "zlib") == 0)
+            {
+                compression = CCZ_COMPRESSION_ZLIB;
+            }
+            else
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+        {
+            level = atoi(argv[++i]);
+            if (level < 1 || level > 9)
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-d") == 0)
+        {
+            unpacking = true;
+        }
+        else if (argv[i][0] == '-')
+        {
+            usage();
+            return 1;
+        }
+        else
+        {
+            files.push_back(argv[i]);
+        }
+    }
+
+    if (files.size() != 2)
+    {
+        usage();
+        return 1;
+    }
+
+    return unpacking ? unpack(files[0], files[1]) : pack(files[0], files[1], compression, level);
+}
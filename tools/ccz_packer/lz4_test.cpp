@@ -0,0 +1,224 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+// lz4_test: round trip and malformed data tests of the LZ4 codec of the CCZ files.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "../../cocos2dx/support/zip_support/ccLZ4.h"
+
+using namespace cocos2d;
+
+static int s_failures = 0;
+
+#define CHECK(condition, ...) \
+    do { \
+        if (! (condition)) \
+        { \
+            printf("FAILED %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+            ++s_failures; \
+        } \
+    } while (0)
+
+// deterministic, so failures can be reproduced
+static unsigned int s_seed = 1;
+
+static unsigned int nextRandom()
+{
+    s_seed = s_seed * 1103515245 + 12345;
+    return s_seed >> 8;
+}
+
+typedef std::vector<unsigned char> Bytes;
+
+static Bytes compress(const Bytes& data)
+{
+    Bytes packed(ccLZ4CompressBound((unsigned int)data.size()));
+    unsigned int length = ccLZ4Compress(data.empty() ? NULL : &data[0], (unsigned int)data.size(), &packed[0], (unsigned int)packed.size());
+    packed.resize(length);
+    return packed;
+}
+
+// decompresses into a buffer of exactly outLength bytes, so a memory checker catches overruns
+static int decompress(const Bytes& packed, unsigned int outLength, Bytes *out)
+{
+    unsigned char *buffer = (unsigned char*)malloc(outLength ? outLength : 1);
+    int length = ccLZ4Decompress(packed.empty() ? NULL : &packed[0], (unsigned int)packed.size(), buffer, outLength);
+    if (out && length >= 0)
+    {
+        out->assign(buffer, buffer + length);
+    }
+    free(buffer);
+    return length;
+}
+
+static void roundTrip(const char *name, const Bytes& data)
+{
+    Bytes packed = compress(data);
+    CHECK(! packed.empty(), "%s: compression failed", name);
+    CHECK(packed.size() <= ccLZ4CompressBound((unsigned int)data.size()), "%s: %u bytes above the bound", name, (unsigned int)packed.size());
+
+    Bytes unpacked;
+    int length = decompress(packed, (unsigned int)data.size(), &unpacked);
+    CHECK(length == (int)data.size() && unpacked == data, "%s: %u bytes decompressed to %d", name, (unsigned int)data.size(), length);
+
+    // a buffer one byte too short
+    if (! data.empty())
+    {
+        CHECK(decompress(packed, (unsigned int)data.size() - 1, NULL) < 0, "%s: decompressed into a short buffer", name);
+    }
+}
+
+static Bytes randomBytes(unsigned int length)
+{
+    Bytes data(length);
+    for (unsigned int i = 0; i < length; ++i)
+    {
+        data[i] = (unsigned char)nextRandom();
+    }
+    return data;
+}
+
+// words from a small dictionary, with matches up to far behind
+static Bytes text(unsigned int length)
+{
+    static const char *words[] = { "sprite", "frame", "texture", "node", "action", "scene", "layer", " ", "\n", "<key>", "</key>" };
+    Bytes data;
+    while (data.size() < length)
+    {
+        const char *word = words[nextRandom() % (sizeof(words) / sizeof(words[0]))];
+        data.insert(data.end(), word, word + strlen(word));
+    }
+    data.resize(length);
+    return data;
+}
+
+static void testRoundTrips()
+{
+    roundTrip("empty", Bytes());
+
+    // sizes around the limits of the match search
+    for (unsigned int length = 1; length <= 40; ++length)
+    {
+        char name[64];
+        sprintf(name, "random %u", length);
+        roundTrip(name, randomBytes(length));
+        sprintf(name, "zeros %u", length);
+        roundTrip(name, Bytes(length, 0));
+    }
+
+    roundTrip("random 64 KiB", randomBytes(65536));
+    roundTrip("random 1 MiB", randomBytes(1 << 20));
+    roundTrip("zeros 1 MiB", Bytes(1 << 20, 0));
+    roundTrip("text 64 KiB + 1", text(65537));
+    roundTrip("text 3 MiB", text(3 << 20));
+
+    // overlapping matches of every short period
+    for (unsigned int period = 1; period <= 20; ++period)
+    {
+        Bytes pattern = randomBytes(period);
+        Bytes data;
+        for (unsigned int length = 0; length < 100000 + period; ++length)
+        {
+            data.push_back(pattern[length % period]);
+        }
+        char name[64];
+        sprintf(name, "period %u", period);
+        roundTrip(name, data);
+    }
+
+    // repeats beyond the 64 KiB window, which can't be matched
+    Bytes block = randomBytes(70000);
+    Bytes repeated(block);
+    repeated.insert(repeated.end(), block.begin(), block.end());
+    roundTrip("repeat after 70000", repeated);
+
+    // incompressible data grows by less than the bound
+    Bytes noise = randomBytes(100000);
+    CHECK(compress(noise).size() <= 100000 + 100000 / 255 + 16, "random data grew too much");
+
+    // a buffer below the bound is refused
+    Bytes small(10);
+    CHECK(ccLZ4Compress(&noise[0], 100, &small[0], (unsigned int)small.size()) == 0, "compressed into a buffer below the bound");
+}
+
+static void testMalformed()
+{
+    Bytes data = text(200000);
+    Bytes packed = compress(data);
+
+    // every truncation is rejected
+    for (unsigned int length = 0; length < packed.size(); length += (length < 4096 ? 1 : 97))
+    {
+        Bytes truncated(packed.begin(), packed.begin() + length);
+        Bytes out;
+        int result = decompress(truncated, (unsigned int)data.size(), &out);
+        CHECK(result < 0 || (result < (int)data.size() && memcmp(&out[0], &data[0], result) == 0),
+              "truncated to %u bytes: returned %d", length, result);
+    }
+
+    // handmade blocks
+    const unsigned char zeroOffset[] = { 0x14, 'a', 0x00, 0x00, 0x00 };
+    CHECK(decompress(Bytes(zeroOffset, zeroOffset + sizeof(zeroOffset)), 100, NULL) < 0, "offset 0 accepted");
+    const unsigned char offsetBeforeStart[] = { 0x14, 'a', 0x02, 0x00, 0x00 };
+    CHECK(decompress(Bytes(offsetBeforeStart, offsetBeforeStart + sizeof(offsetBeforeStart)), 100, NULL) < 0, "offset before the start accepted");
+    const unsigned char literalsPastInput[] = { 0xf0, 0x40, 'a', 'b' };
+    CHECK(decompress(Bytes(literalsPastInput, literalsPastInput + sizeof(literalsPastInput)), 1000, NULL) < 0, "literals past the input accepted");
+    const unsigned char unfinishedLength[] = { 0xf0, 0xff, 0xff };
+    CHECK(decompress(Bytes(unfinishedLength, unfinishedLength + sizeof(unfinishedLength)), 1000, NULL) < 0, "unfinished length accepted");
+    const unsigned char longMatch[] = { 0x1f, 'a', 0x01, 0x00, 0xff, 0xff, 0x10, 0x00 };
+    CHECK(decompress(Bytes(longMatch, longMatch + sizeof(longMatch)), 100, NULL) < 0, "match past the output accepted");
+
+    // random corruptions never read or write out of the buffers, which a memory checker verifies
+    Bytes small = compress(text(5000));
+    for (int i = 0; i < 200000; ++i)
+    {
+        Bytes corrupted(small);
+        unsigned int changes = 1 + nextRandom() % 4;
+        for (unsigned int c = 0; c < changes; ++c)
+        {
+            corrupted[nextRandom() % corrupted.size()] = (unsigned char)nextRandom();
+        }
+        int result = decompress(corrupted, 5000, NULL);
+        CHECK(result <= 5000, "corrupted block decompressed to %d bytes", result);
+    }
+}
+
+int main()
+{
+    testRoundTrips();
+    testMalformed();
+
+    if (s_failures)
+    {
+        printf("%d failures\n", s_failures);
+        return 1;
+    }
+    printf("all LZ4 tests passed\n");
+    return 0;
+}
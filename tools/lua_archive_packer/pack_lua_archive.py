@@ -0,0 +1,146 @@
+#!/usr/bin/python
+# pack_lua_archive.py
+# Pack the Lua modules of a project into one archive loaded by CCLuaStack::addLuaArchive
+# Copyright (c) 2013 cocos2d-x.org
+
+import sys
+import os, os.path
+import struct
+import subprocess
+import tempfile
+from optparse import OptionParser
+
+MAGIC = b'CLBA'
+VERSION = 1
+HEADER_SIZE = 16
+SLOT_SIZE = 24
+
+KIND_SOURCE = 0
+KIND_LUA51 = 1
+KIND_LUAJIT = 2
+
+def hashModuleName(name):
+    # FNV-1a, must match CCLuaArchive::hashModuleName
+    h = 2166136261
+    for c in bytearray(name):
+        h ^= c
+        h = (h * 16777619) & 0xffffffff
+    return h
+
+def collectModules(roots):
+    modules = {}
+    for root in roots:
+        root = os.path.normpath(root)
+        for dirpath, dirnames, filenames in os.walk(root):
+            dirnames.sort()
+            for filename in sorted(filenames):
+                if not filename.endswith(".lua"):
+                    continue
+                path = os.path.join(dirpath, filename)
+                relative = os.path.relpath(path, root)[:-len(".lua")]
+                name = relative.replace(os.sep, ".").replace("/", ".")
+                if name in modules:
+                    print("warning: %s hides %s" % (modules[name], path))
+                    continue
+                modules[name] = path
+    return modules
+
+def readFile(path):
+    f = open(path, "rb")
+    try:
+        return f.read()
+    finally:
+        f.close()
+
+def compileModule(command, path):
+    fd, output = tempfile.mkstemp(suffix = ".luac")
+    os.close(fd)
+    try:
+        args = [arg.replace("$IN", path).replace("$OUT", output) for arg in command]
+        if subprocess.call(args) != 0:
+            raise RuntimeError("failed to compile %s" % path)
+        return readFile(output)
+    finally:
+        os.remove(output)
+
+def writeArchive(filename, entries, moduleCount):
+    slotCount = 2
+    while slotCount < len(entries) * 2:
+        slotCount *= 2
+    mask = slotCount - 1
+
+    slots = [None] * slotCount
+    blob = bytearray()
+    blobOffset = HEADER_SIZE + slotCount * SLOT_SIZE
+    names = {}
+
+    for name, kind, chunk in entries:
+        if name not in names:
+            names[name] = (blobOffset + len(blob), len(name))
+            blob += name
+        nameOffset, nameLength = names[name]
+
+        chunkOffset = blobOffset + len(blob)
+        blob += chunk
+        # keep the chunks aligned, the archive may be used in place
+        while len(blob) % 4:
+            blob += b'\0'
+
+        h = hashModuleName(name)
+        i = 0
+        while slots[(h + i) & mask] is not None:
+            i += 1
+        slots[(h + i) & mask] = struct.pack("<IIIIII", h, kind, nameOffset, nameLength, chunkOffset, len(chunk))
+
+    out = open(filename, "wb")
+    try:
+        out.write(struct.pack("<4sIII", MAGIC, VERSION, slotCount, moduleCount))
+        for slot in slots:
+            out.write(slot or b'\0' * SLOT_SIZE)
+        out.write(bytes(blob))
+    finally:
+        out.close()
+
+def main():
+    parser = OptionParser(usage = "usage: %prog -o OUTPUT [options] SCRIPT_DIR...")
+    parser.add_option("-o", "--output", dest = "output", help = "archive to write")
+    parser.add_option("--luac", dest = "luac", help = "Lua 5.1 compiler, stores Lua 5.1 bytecode")
+    parser.add_option("--luajit", dest = "luajit", help = "LuaJIT executable, stores LuaJIT bytecode")
+    parser.add_option("--source", dest = "source", action = "store_true", default = False,
+                      help = "also store the sources, always done when no compiler is given")
+    parser.add_option("--strip", dest = "strip", action = "store_true", default = False,
+                      help = "strip the debug information from the bytecode")
+    (options, roots) = parser.parse_args()
+
+    if not options.output or not roots:
+        parser.print_help()
+        return 1
+
+    compilers = []
+    if options.luac:
+        command = [options.luac]
+        if options.strip:
+            command.append("-s")
+        compilers.append((KIND_LUA51, command + ["-o", "$OUT", "$IN"]))
+    if options.luajit:
+        command = [options.luajit, "-b"]
+        if not options.strip:
+            command.append("-g")
+        compilers.append((KIND_LUAJIT, command + ["$IN", "$OUT"]))
+
+    modules = collectModules(roots)
+    entries = []
+    for name in sorted(modules.keys()):
+        path = modules[name]
+        key = name.encode("utf-8")
+        for kind, command in compilers:
+            entries.append((key, kind, compileModule(command, path)))
+        if options.source or not compilers:
+            entries.append((key, KIND_SOURCE, readFile(path)))
+
+    writeArchive(options.output, entries, len(modules))
+    print("%s: %d modules, %d chunks" % (options.output, len(modules), len(entries)))
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,160 @@
+#!/usr/bin/python
+# compile_sprite_sheet.py
+# Compile the plist of a sprite sheet into a precompiled sheet loaded by CCSpriteFrameCache
+# Copyright (c) 2013 cocos2d-x.org
+
+import sys
+import os, os.path
+import re
+import struct
+import plistlib
+from optparse import OptionParser
+
+MAGIC = b'CCSF'
+VERSION = 1
+NONE = 0xffffffff
+FLAG_ROTATED = 1
+
+NUMBER = re.compile(r'[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?')
+
+def hashFrameName(name):
+    # FNV-1a, must match hashFrameName of CCSpriteFrameCache.cpp
+    h = 2166136261
+    for c in bytearray(name):
+        h ^= c
+        h = (h * 16777619) & 0xffffffff
+    return h
+
+def readPlist(path):
+    f = open(path, "rb")
+    try:
+        if hasattr(plistlib, "load"):
+            return plistlib.load(f)
+        return plistlib.readPlist(f)
+    finally:
+        f.close()
+
+def numbers(value, count):
+    # "{x,y}" and "{{x,y},{w,h}}", like CCRectFromString
+    values = [float(n) for n in NUMBER.findall(str(value))][:count]
+    return values + [0.0] * (count - len(values))
+
+def toBool(value):
+    if isinstance(value, bool):
+        return value
+    return str(value).strip().lower() in ("1", "true", "yes")
+
+def readFrames(plist):
+    """Returns the texture file name and the (name, rect, rotated, offset, source size, aliases) of the frames."""
+    metadata = plist.get("metadata", {})
+    frames = plist.get("frames", {})
+    format = int(metadata.get("format", 0))
+    if format < 0 or format > 3:
+        raise RuntimeError("unsupported format %d" % format)
+
+    result = []
+    for name in sorted(frames.keys()):
+        frame = frames[name]
+        aliases = []
+        rotated = False
+        if format == 0:
+            rect = [float(frame.get(key, 0)) for key in ("x", "y", "width", "height")]
+            offset = [float(frame.get("offsetX", 0)), float(frame.get("offsetY", 0))]
+            size = [float(abs(int(frame.get("originalWidth", 0)))), float(abs(int(frame.get("originalHeight", 0))))]
+        elif format == 1 or format == 2:
+            rect = numbers(frame.get("frame"), 4)
+            rotated = format == 2 and toBool(frame.get("rotated", False))
+            offset = numbers(frame.get("offset"), 2)
+            size = numbers(frame.get("sourceSize"), 2)
+        else:
+            textureRect = numbers(frame.get("textureRect"), 4)
+            rect = textureRect[:2] + numbers(frame.get("spriteSize"), 2)
+            rotated = toBool(frame.get("textureRotated", False))
+            offset = numbers(frame.get("spriteOffset"), 2)
+            size = numbers(frame.get("spriteSourceSize"), 2)
+            aliases = list(frame.get("aliases", []))
+        result.append((name, rect, rotated, offset, size, aliases))
+    return metadata.get("textureFileName"), result
+
+class NamePool:
+    """NUL terminated names, each one stored once."""
+    def __init__(self):
+        self.data = bytearray()
+        self.offsets = {}
+
+    def add(self, name):
+        key = name.encode("utf-8")
+        if key not in self.offsets:
+            self.offsets[key] = len(self.data)
+            self.data += key + b'\0'
+        return self.offsets[key]
+
+def writeSheet(filename, textureName, frames):
+    names = NamePool()
+    textureOffset = names.add(textureName) if textureName else NONE
+
+    # entries of the hash table: frames, then aliases
+    frameRecords = []
+    aliasRecords = []
+    entries = []
+    for index, (name, rect, rotated, offset, size, aliases) in enumerate(frames):
+        nameOffset = names.add(name)
+        frameRecords.append(struct.pack("<I8fI", nameOffset, rect[0], rect[1], rect[2], rect[3],
+                                        offset[0], offset[1], size[0], size[1], FLAG_ROTATED if rotated else 0))
+        entries.append((name.encode("utf-8"), index))
+        for alias in aliases:
+            aliasRecords.append(struct.pack("<II", names.add(alias), index))
+            entries.append((alias.encode("utf-8"), len(frames) + len(aliasRecords) - 1))
+
+    slotCount = 1
+    while slotCount < len(entries) * 2:
+        slotCount *= 2
+    mask = slotCount - 1
+    slots = [NONE] * slotCount
+    used = set()
+    for name, entry in entries:
+        if name in used:
+            print("warning: %s is used by several frames or aliases, the first one is kept" % name.decode("utf-8"))
+            continue
+        used.add(name)
+        i = hashFrameName(name) & mask
+        while slots[i] != NONE:
+            i = (i + 1) & mask
+        slots[i] = entry
+
+    out = open(filename, "wb")
+    try:
+        out.write(struct.pack("<4sIIIIIII", MAGIC, VERSION, len(frameRecords), len(aliasRecords),
+                              slotCount, len(names.data), textureOffset, 0))
+        for record in frameRecords:
+            out.write(record)
+        for record in aliasRecords:
+            out.write(record)
+        out.write(struct.pack("<%dI" % slotCount, *slots))
+        out.write(bytes(names.data))
+    finally:
+        out.close()
+    return len(frameRecords), len(aliasRecords)
+
+def main():
+    parser = OptionParser(usage = "usage: %prog [-o OUTPUT] [-t TEXTURE] PLIST")
+    parser.add_option("-o", "--output", dest = "output", help = "sheet to write, PLIST with the .ccsheet extension by default")
+    parser.add_option("-t", "--texture", dest = "texture", help = "texture file name stored in the sheet, relative to it")
+    (options, args) = parser.parse_args()
+
+    if len(args) != 1:
+        parser.print_help()
+        return 1
+
+    path = args[0]
+    output = options.output or os.path.splitext(path)[0] + ".ccsheet"
+    textureName, frames = readFrames(readPlist(path))
+    if options.texture:
+        textureName = options.texture
+
+    frameCount, aliasCount = writeSheet(output, textureName, frames)
+    print("%s: %d frames, %d aliases, %d bytes" % (output, frameCount, aliasCount, os.path.getsize(output)))
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -213,6 +213,18 @@ _is_functions["LUA_FUNCTION"] = "toluafix_isfunction"
 _to_functions["LUA_TABLE"] = "toluafix_totable"
 _is_functions["LUA_TABLE"] = "toluafix_istable"
 
+-- CCPoint, CCSize and CCRect are passed to Lua as plain tables, see LuaBasicConversions.h
+local ValueTypes = {
+    CCPoint = "ccpoint",
+    CCSize = "ccsize",
+    CCRect = "ccrect",
+}
+
+for t, name in pairs(ValueTypes) do
+    _is_functions[t] = "luaval_is_" .. name
+    _to_functions[t] = "luaval_to_" .. name
+end
+
 local toWrite = {}
 local currentString = ''
 local out
@@ -291,6 +303,7 @@ extern "C" {
 #include <string>
 #include "cocos2d.h"
 #include "CCLuaEngine.h"
+#include "LuaBasicConversions.h"
 #include "SimpleAudioEngine.h"
 #include "cocos-ext.h"
 
@@ -317,6 +330,37 @@ TOLUA_API int  tolua_Cocos2d_open (lua_State* tolua_S);]], [[]])
     int* pLuaID = (tolua_ret) ? &tolua_ret->_luaID : NULL;
     toluafix_pushusertype_ccobject(tolua_S, nID, pLuaID, (void*)tolua_ret]])
 
+      -- return CCPoint, CCSize and CCRect values as tables
+      for t, name in pairs(ValueTypes) do
+          replace([[#ifdef __cplusplus
+    void* tolua_obj = Mtolua_new((]] .. t .. [[)(tolua_ret));
+     tolua_pushusertype(tolua_S,tolua_obj,"]] .. t .. [[");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#else
+    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(]] .. t .. [[));
+     tolua_pushusertype(tolua_S,tolua_obj,"]] .. t .. [[");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#endif
+]], '    ' .. name .. '_to_luaval(tolua_S,tolua_ret);\n')
+          replace('tolua_pushusertype(tolua_S,(void*)&tolua_ret,"const ' .. t .. '");', name .. '_to_luaval(tolua_S,tolua_ret);')
+      end
+
+      -- self is still a userdata, read with tolua_tousertype: keep tolua_isusertype for argument 1 of the methods
+      result = string.gsub(result, '(/%* method: [^\n]*\n[^\n]*\n[^\n]*\n{\n#ifndef TOLUA_RELEASE\n tolua_Error tolua_err;\n if %(\n     !)luaval_is_%a+%(tolua_S,1,',
+          '%1tolua_isusertype(tolua_S,1,')
+
+      -- convert the table arguments in locals, see luaval_to_ccpoint
+      local typeNames = {}
+      for t, name in pairs(ValueTypes) do
+          typeNames[name] = t
+      end
+      result = string.gsub(result, '\n( *)([^\n]-)luaval_to_(%a+)%(tolua_S,(%d+),([^%)]-)%)',
+          function(indent, before, name, lo, def)
+              local value = 'tolua_value' .. lo
+              return '\n' .. indent .. typeNames[name] .. ' ' .. value .. ';\n' ..
+                  indent .. before .. 'luaval_to_' .. name .. '(tolua_S,' .. lo .. ',' .. def .. ',&' .. value .. ')'
+          end)
+
       replace('\t', '    ')
 
     WRITE(result)